@@ -31,6 +31,11 @@
 
 #define LAL_H5_FILE_MODE_READ  H5F_ACC_RDONLY
 #define LAL_H5_FILE_MODE_WRITE H5F_ACC_TRUNC
+#define LAL_H5_FILE_MODE_APPEND H5F_ACC_RDWR
+
+/* files open for appending can be both read and written */
+#define LAL_H5_FILE_MODE_IS_WRITABLE(mode) ((mode) == LAL_H5_FILE_MODE_WRITE || (mode) == LAL_H5_FILE_MODE_APPEND)
+#define LAL_H5_FILE_MODE_IS_READABLE(mode) ((mode) == LAL_H5_FILE_MODE_READ || (mode) == LAL_H5_FILE_MODE_APPEND)
 
 struct tagLALH5Object {
 	hid_t object_id; /* this object's id must be first */
@@ -335,6 +340,29 @@ static LALH5File * XLALH5FileOpenRead(const char *path)
 	return file;
 }
 
+/* opens a HDF5 file for appending, creating it if it does not exist */
+static LALH5File * XLALH5FileOpenAppend(const char *path)
+{
+	LALH5File *file;
+	FILE *fp;
+	file = LALCalloc(1, sizeof(*file));
+	if (!file)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	XLALStringCopy(file->fname, path, sizeof(file->fname));
+	/* no temporary file: data must be visible at path while appending */
+	if ((fp = fopen(path, "r")) != NULL) {
+		fclose(fp);
+		file->file_id = threadsafe_H5Fopen(path, H5F_ACC_RDWR, H5P_DEFAULT);
+	} else
+		file->file_id = threadsafe_H5Fcreate(path, H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT);
+	if (file->file_id < 0) {
+		LALFree(file);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not open HDF5 file `%s' for appending", path);
+	}
+	file->mode = LAL_H5_FILE_MODE_APPEND;
+	return file;
+}
+
 #if 0
 static hid_t XLALGetObjectIdentifier(const void *ptr)
 {
@@ -424,14 +452,18 @@ void XLALH5FileClose(LALH5File UNUSED *file)
  * <dl>
  * <dt>r</dt><dd>Open file for reading.</dd>
  * <dt>w</dt><dd>Truncate to zero length or create file for writing.</dd>
+ * <dt>a</dt><dd>Open file for reading and appending, creating it if it does
+ * not exist.</dd>
  * </dl>
  *
  * If a file is opened for writing then data is initially written to a
  * temporary file, and this file is renamed once the #LALH5File structure
- * is closed with XLALH5FileClose().
+ * is closed with XLALH5FileClose().  Files opened for appending are
+ * modified in place, so that data flushed with XLALH5FileFlush() is
+ * readable from @p path while the file remains open.
  *
  * @param path Pointer to a string containing the path of the file to open.
- * @param mode Mode to open the file, either "r" or "w".
+ * @param mode Mode to open the file, either "r", "w", or "a".
  * @returns A pointer to a #LALH5File structure associated with the
  * specified HDF5 file.
  * @retval NULL An error occurred opening the file.
@@ -447,7 +479,37 @@ LALH5File * XLALH5FileOpen(const char UNUSED *path, const char UNUSED *mode)
 		return XLALH5FileOpenRead(path);
 	else if (strcmp(mode, "w") == 0)
 		return XLALH5FileCreate(path);
-	XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid mode \"%s\": must be either \"r\" or \"w\"", mode);
+	else if (strcmp(mode, "a") == 0)
+		return XLALH5FileOpenAppend(path);
+	XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid mode \"%s\": must be \"r\", \"w\", or \"a\"", mode);
+#endif
+}
+
+/**
+ * @brief Flushes a #LALH5File to disk
+ * @details
+ * Flushes all buffers associated with the HDF5 file containing the
+ * #LALH5File @p file (which may be a group) to disk.  For files opened
+ * for appending this leaves a consistent, readable file at its path,
+ * which allows long-running writers to checkpoint without closing the
+ * file.
+ *
+ * @param file Pointer to a #LALH5File structure to flush.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5FileFlush(LALH5File UNUSED *file)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	if (file == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+	if (file->mode == LAL_H5_FILE_MODE_READ)
+		return 0;
+	if (threadsafe_H5Fflush(file->file_id, H5F_SCOPE_GLOBAL) < 0)
+		XLAL_ERROR(XLAL_EIO, "Failed to flush HDF5 file");
+	return 0;
 #endif
 }
 
@@ -458,7 +520,8 @@ LALH5File * XLALH5FileOpen(const char UNUSED *path, const char UNUSED *mode)
  * associated with the #LALH5File @p file.  If the HDF5 file is
  * being read, the specified group must exist in that file.  If
  * the HDF5 file is being written, the specified group is created
- * within the file.
+ * within the file.  If the HDF5 file is being appended to, the
+ * specified group is opened if it exists and is created otherwise.
  *
  * @param file Pointer to a #LALH5File structure in which to open the group.
  * @param name Pointer to a string with the name of the group to open.
@@ -483,7 +546,9 @@ LALH5File * XLALH5GroupOpen(LALH5File UNUSED *file, const char UNUSED *name)
 		group->file_id = file->file_id;
 	else if (group->mode == LAL_H5_FILE_MODE_READ)
 		group->file_id = threadsafe_H5Gopen2(file->file_id, name, H5P_DEFAULT);
-	else if (group->mode == LAL_H5_FILE_MODE_WRITE) {
+	else if (group->mode == LAL_H5_FILE_MODE_APPEND && XLALH5FileCheckGroupExists(file, name))
+		group->file_id = threadsafe_H5Gopen2(file->file_id, name, H5P_DEFAULT);
+	else if (LAL_H5_FILE_MODE_IS_WRITABLE(group->mode)) {
 		hid_t gcpl; /* property list to allow intermediate groups to be created */
 		gcpl = threadsafe_H5Pcreate(H5P_LINK_CREATE);
 		if (gcpl < 0 || threadsafe_H5Pset_create_intermediate_group(gcpl, 1) < 0) {
@@ -959,7 +1024,7 @@ LALH5Dataset * XLALH5DatasetAlloc(LALH5File UNUSED *file, const char UNUSED *nam
 
 	if (name == NULL || file == NULL || dimLength == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (!LAL_H5_FILE_MODE_IS_WRITABLE(file->mode))
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1042,7 +1107,7 @@ LALH5Dataset * XLALH5DatasetAlloc1D(LALH5File UNUSED *file, const char UNUSED *n
 
 	if (name == NULL || file == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (!LAL_H5_FILE_MODE_IS_WRITABLE(file->mode))
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1132,7 +1197,7 @@ LALH5Dataset * XLALH5DatasetRead(LALH5File UNUSED *file, const char UNUSED *name
 	size_t namelen;
 	if (name == NULL || file == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_READ)
+	if (!LAL_H5_FILE_MODE_IS_READABLE(file->mode))
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to read a write-only HDF5 file");
 
 	namelen = strlen(name);
@@ -3088,11 +3153,42 @@ LIGOTimeGPS * XLALH5DatasetQueryLIGOTimeGPSAttributeValue(LIGOTimeGPS UNUSED *va
  * @retval NULL An error occurred creating the dataset.
  */
 LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name, size_t UNUSED ncols, const char UNUSED **cols, const LALTYPECODE UNUSED *types, const size_t UNUSED *offsets, size_t UNUSED rowsz)
+{
+	return XLALH5TableAllocChunked(file, name, ncols, cols, types, offsets, rowsz, 32, 0);
+}
+
+/**
+ * @brief Allocates a #LALH5Dataset dataset to hold a table with a given
+ * chunk size and optional compression.
+ * @details
+ * This routine is identical to XLALH5TableAlloc() except that the number
+ * of rows in each HDF5 storage chunk is @p chunk_nrows, and the chunks are
+ * deflate-compressed if @p compress is non-zero.  Tables that are filled
+ * incrementally with XLALH5TableAppend() are extended one chunk at a time,
+ * so @p chunk_nrows should be matched to the number of rows in a typical
+ * append.
+ *
+ * @param file Pointer to a #LALH5File in which to create the dataset.
+ * @param name Pointer to a string with the name of the dataset to create (also
+ * the table name).
+ * @param ncols Number of columns in each row.
+ * @param cols Pointer to an array of strings giving the column names.
+ * @param types Pointer to an array of #LALTYPECODE values specifying the data
+ * type of each column.
+ * @param offsets Pointer to an array of offsets for each column.
+ * @param rowsz Size of each row of data.
+ * @param chunk_nrows Number of rows in each storage chunk.
+ * @param compress Compress the chunks if non-zero.
+ * @returns A pointer to a #LALH5Dataset structure associated with the specified
+ * dataset within a HDF5 file.
+ * @retval NULL An error occurred creating the dataset.
+ */
+LALH5Dataset * XLALH5TableAllocChunked(LALH5File UNUSED *file, const char UNUSED *name, size_t UNUSED ncols, const char UNUSED **cols, const LALTYPECODE UNUSED *types, const size_t UNUSED *offsets, size_t UNUSED rowsz, size_t UNUSED chunk_nrows, int UNUSED compress)
 {
 #ifndef HAVE_HDF5
 	XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 support not implemented");
 #else
-	const size_t chunk_size = 32;
+	const size_t chunk_size = chunk_nrows > 0 ? chunk_nrows : 32;
 	hid_t dtype_id[ncols];
 	hid_t tdtype_id;
 	size_t col;
@@ -3103,7 +3199,7 @@ LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name,
 	if (file == NULL || cols == NULL || types == NULL || offsets == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
 
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (!LAL_H5_FILE_MODE_IS_WRITABLE(file->mode))
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	/* map the LAL types to HDF5 types */
@@ -3115,7 +3211,7 @@ LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name,
 
 	/* make empty table */
 	/* note: table title and dataset name are the same */
-	status = threadsafe_H5TBmake_table(name, file->file_id, name, ncols, 0, rowsz, cols, offsets, dtype_id, chunk_size, NULL, 0, NULL);
+	status = threadsafe_H5TBmake_table(name, file->file_id, name, ncols, 0, rowsz, cols, offsets, dtype_id, chunk_size, NULL, compress ? 1 : 0, NULL);
 	for (col = 0; col < ncols; ++col)
 		threadsafe_H5Tclose(dtype_id[col]);
 
@@ -3227,6 +3323,53 @@ int XLALH5TableAppend(LALH5Dataset UNUSED *dset, const size_t UNUSED *offsets, c
 #endif
 }
 
+/**
+ * @brief Truncates a #LALH5Dataset dataset holding a table.
+ * @details
+ * This routine discards all but the first @p nrows rows of the HDF5 table
+ * dataset associated with the #LALH5Dataset structure @p dset.  The
+ * table must be in a file opened for writing or appending.  This allows
+ * rows that were appended after the last checkpoint of an incrementally
+ * written table to be discarded when resuming.
+ *
+ * @param dset Pointer to a #LALH5Dataset containing the table to truncate.
+ * @param nrows Number of rows to keep; this must not exceed the number of
+ * rows in the table.
+ * @retval 0 Success.
+ * @retval -1 Failure.
+ */
+int XLALH5TableTruncate(LALH5Dataset UNUSED *dset, size_t UNUSED nrows)
+{
+#ifndef HAVE_HDF5
+	XLAL_ERROR(XLAL_EFAILED, "HDF5 support not implemented");
+#else
+	hsize_t dims[1] = {nrows};
+	size_t nrows_old;
+
+	if (dset == NULL)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	nrows_old = XLALH5TableQueryNRows(dset);
+	if (nrows_old == (size_t)(-1))
+		XLAL_ERROR(XLAL_EFUNC);
+	if (nrows > nrows_old)
+		XLAL_ERROR(XLAL_EINVAL, "Cannot truncate table `%s' with %zu rows to %zu rows", dset->name, nrows_old, nrows);
+	if (nrows == nrows_old)
+		return 0;
+
+	if (threadsafe_H5Dset_extent(dset->dataset_id, dims) < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not truncate table `%s'", dset->name);
+
+	/* the cached dataspace no longer describes the dataset */
+	threadsafe_H5Sclose(dset->space_id);
+	dset->space_id = threadsafe_H5Dget_space(dset->dataset_id);
+	if (dset->space_id < 0)
+		XLAL_ERROR(XLAL_EIO, "Could not read dataspace of dataset `%s'", dset->name);
+
+	return 0;
+#endif
+}
+
 /**
  * @brief Reads table data from a #LALH5Dataset
  * @details
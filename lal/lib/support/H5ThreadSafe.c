@@ -139,6 +139,14 @@ static inline herr_t threadsafe_H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t
 	return retval;
 }
 
+static inline herr_t threadsafe_H5Dset_extent(hid_t dset_id, const hsize_t size[])
+{
+	LAL_HDF5_MUTEX_LOCK
+	herr_t retval = H5Dset_extent(dset_id, size);
+	LAL_HDF5_MUTEX_UNLOCK
+	return retval;
+}
+
 static inline herr_t threadsafe_H5Dvlen_reclaim(hid_t type_id, hid_t space_id, hid_t plist_id, void *buf)
 {
 	LAL_HDF5_MUTEX_LOCK
@@ -642,6 +650,7 @@ static inline herr_t threadsafe_H5open(void)
 #define threadsafe_H5Dget_type H5Dget_type
 #define threadsafe_H5Dopen2 H5Dopen2
 #define threadsafe_H5Dread H5Dread
+#define threadsafe_H5Dset_extent H5Dset_extent
 #define threadsafe_H5Dvlen_reclaim H5Dvlen_reclaim
 #define threadsafe_H5Dwrite H5Dwrite
 #define threadsafe_H5Fclose H5Fclose
@@ -51,39 +51,94 @@
 #define NAME_MAX FILENAME_MAX
 #endif
 
-static int XLALCacheFileReadRow(char *s, size_t len, LALFILE * fp,
-                                int *line)
-{
-    while (1) {
-        if (!XLALFileGets(s, len, fp))
-            return 0;   /* finished code */
-        ++(*line);
-        if (!strchr(s, '\n')) {
-            if (XLALFileEOF(fp)) {      /* missing final newline */
-                XLAL_PRINT_WARNING("Missing newline on line %d", *line);
-                return 0;
+/* entries are parsed in parallel if LAL is configured with --enable-openmp,
+ * and only if the LAL memory and error handling they use is thread-safe */
+#ifndef _OPENMP
+#define omp ignore
+#endif
+#ifdef LAL_PTHREAD_LOCK
+#define LALCACHE_PARALLEL 1
+#else
+#define LALCACHE_PARALLEL 0
+#endif
+
+/* longest line of a cache file, including the newline */
+#define LALCACHE_MAX_LINE (PATH_MAX + 4 * (NAME_MAX + 1) - 1)
+
+/* reads the rest of the file into memory; the result is nul-terminated */
+static char *XLALCacheFileLoadContents(LALFILE * fp, size_t *size)
+{
+    char *buf = NULL;
+    size_t nalloc = 0;
+    size_t n = 0;
+    size_t c;
+    do {
+        if (n == nalloc) {
+            char *tmp;
+            nalloc = nalloc ? 2 * nalloc : 65536;
+            tmp = XLALRealloc(buf, nalloc + 1);
+            if (!tmp) {
+                XLALFree(buf);
+                XLAL_ERROR_NULL(XLAL_ENOMEM);
             }
-            /* line is too long */
-            XLAL_ERROR(XLAL_EIO, "Line %d too long", *line);
+            buf = tmp;
         }
-        if (*s != '#')
-            break;
-    }
-    return 1;   /* continue code */
+        c = XLALFileRead(buf + n, 1, nalloc - n, fp);
+        n += c;
+    } while (c > 0);
+    buf[n] = 0;
+    *size = n;
+    return buf;
 }
 
-/* counts the rows of the file */
-static int XLALCacheFileCountRows(LALFILE * fp)
+/* finds the rows of the file contents, skipping comments; each row ends
+ * with a newline within LALCACHE_MAX_LINE characters */
+static int XLALCacheFileFindRows(char ***prow, int **pline, char *buf,
+                                 size_t size)
 {
-    char s[PATH_MAX + 4 * (NAME_MAX + 1)];
-    int line = 0;
+    char **row = NULL;
+    int *line = NULL;
+    size_t nalloc = 0;
     int n = 0;
-    int c;
-    while ((c = XLALCacheFileReadRow(s, sizeof(s), fp, &line)))
-        if (c < 0)
-            return -1;
-        else
+    int l = 0;
+    char *end = buf + size;
+    char *s;
+    for (s = buf; s < end; ++l) {
+        char *nl = memchr(s, '\n', end - s);
+        if (!nl) {      /* missing final newline */
+            XLAL_PRINT_WARNING("Missing newline on line %d", l + 1);
+            break;
+        }
+        if (nl - s + 1 > LALCACHE_MAX_LINE) {
+            XLALFree(row);
+            XLALFree(line);
+            XLAL_ERROR(XLAL_EIO, "Line %d too long", l + 1);
+        }
+        if (*s != '#') {
+            if ((size_t) n == nalloc) {
+                char **tmprow;
+                int *tmpline;
+                nalloc = nalloc ? 2 * nalloc : 1024;
+                tmprow = XLALRealloc(row, nalloc * sizeof(*row));
+                if (tmprow)
+                    row = tmprow;
+                tmpline = XLALRealloc(line, nalloc * sizeof(*line));
+                if (tmpline)
+                    line = tmpline;
+                if (!tmprow || !tmpline) {
+                    XLALFree(row);
+                    XLALFree(line);
+                    XLAL_ERROR(XLAL_ENOMEM);
+                }
+            }
+            row[n] = s;
+            line[n] = l + 1;
             ++n;
+        }
+        s = nl + 1;
+    }
+    *prow = row;
+    *pline = line;
     return n;
 }
 
@@ -225,26 +280,58 @@ LALCache *XLALCacheMerge(const LALCache * cache1, const LALCache * cache2)
 LALCache *XLALCacheFileRead(LALFILE * fp)
 {
     LALCache *cache;
-    char s[PATH_MAX + 4*(NAME_MAX + 1)];
-    int line = 0;
+    char *buf;
+    char **row = NULL;
+    int *line = NULL;
+    size_t size;
     int n;
     int i;
+    int failed;
     if (!fp)
         XLAL_ERROR_NULL(XLAL_EFAULT);
-    n = XLALCacheFileCountRows(fp);
-    if (n < 0)
+    buf = XLALCacheFileLoadContents(fp, &size);
+    if (!buf)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    n = XLALCacheFileFindRows(&row, &line, buf, size);
+    if (n < 0) {
+        XLALFree(buf);
         XLAL_ERROR_NULL(XLAL_EFUNC);
-    XLALFileRewind(fp);
+    }
     cache = XLALCreateCache(n);
-    if (!cache)
+    if (!cache) {
+        XLALFree(row);
+        XLALFree(line);
+        XLALFree(buf);
         XLAL_ERROR_NULL(XLAL_EFUNC);
-    for (i = 0; i < n; ++i)
-        if (XLALCacheFileReadRow(s, sizeof(s), fp, &line) != 1
-            || XLALCacheFileParseEntry(&cache->list[i], s) < 0) {
-            XLALDestroyCache(cache);
-            XLAL_ERROR_NULL(XLAL_EFUNC, "Error reading row %i on line %i",
-                            i + 1, line);
+    }
+
+    /* the rows are independent, so they are parsed in parallel; failed is
+     * the first row that could not be parsed */
+    failed = n;
+#pragma omp parallel for schedule(dynamic, 1024) if(LALCACHE_PARALLEL)
+    for (i = 0; i < n; ++i) {
+        char s[LALCACHE_MAX_LINE + 1];
+        size_t len = (char *) memchr(row[i], '\n', LALCACHE_MAX_LINE)
+            - row[i] + 1;
+        memcpy(s, row[i], len);
+        s[len] = 0;
+        if (XLALCacheFileParseEntry(&cache->list[i], s) < 0) {
+#pragma omp critical(XLALCacheFileRead)
+            if (i < failed)
+                failed = i;
         }
+    }
+
+    XLALFree(buf);
+    XLALFree(row);
+    if (failed < n) {
+        int failedline = line[failed];
+        XLALFree(line);
+        XLALDestroyCache(cache);
+        XLAL_ERROR_NULL(XLAL_EFUNC, "Error reading row %i on line %i",
+                        failed + 1, failedline);
+    }
+    XLALFree(line);
     XLALCacheSort(cache);
     return cache;
 }
@@ -258,7 +345,7 @@ LALCache *XLALCacheImport(const char *fname)
         XLAL_ERROR_NULL(XLAL_EIO);
     cache = XLALCacheFileRead(fp);
     XLALFileClose(fp);
-    if (!fp)
+    if (!cache)
         XLAL_ERROR_NULL(XLAL_EFUNC);
     return cache;
 }
@@ -318,6 +405,7 @@ LALCache *XLALCacheGlob(const char *dirstr, const char *fnptrn)
     int globflags = 0;
     glob_t g;
     size_t i;
+    int failed = 0;
 
     fnptrn = fnptrn ? fnptrn : "*";
     dirstr = dirstr ? dirstr : ".";
@@ -358,15 +446,21 @@ LALCache *XLALCacheGlob(const char *dirstr, const char *fnptrn)
         globfree(&g);
         XLAL_ERROR_NULL(XLAL_EFUNC);
     }
-    /* copy file names */
+    /* copy file names; resolving the paths costs a few system calls per
+     * file, so the files are done in parallel */
+#pragma omp parallel for schedule(dynamic, 256) if(LALCACHE_PARALLEL)
     for (i = 0; i < g.gl_pathc; ++i) {
         LALCacheEntry *entry = cache->list + i;
         if (0 > XLALCacheFilenameParseEntry(entry, g.gl_pathv[i])) {
-            globfree(&g);
-            XLALDestroyCache(cache);
-            XLAL_ERROR_NULL(XLAL_EFUNC);
+#pragma omp atomic write
+            failed = 1;
         }
     }
+    if (failed) {
+        globfree(&g);
+        XLALDestroyCache(cache);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
 
     globfree(&g);
     XLALCacheSort(cache);
@@ -463,15 +557,51 @@ static int XLALCacheCompareEntryMetadata(void *p, const void *p1,
 }
 
 
+/* stable merge sort of n entries using workspace for n / 2 entries; this
+ * is linear for a cache that is already sorted, like the insertion sort,
+ * but does not become quadratic for a large cache that is not */
+static void XLALCacheMergeSort(LALCacheEntry * list, LALCacheEntry * tmp,
+                               size_t n)
+{
+    size_t h = n / 2;
+    size_t i, j, k;
+    if (n < 16) {
+        XLALInsertionSort(list, n, sizeof(*list), NULL,
+                          XLALCacheCompareEntryMetadata);
+        return;
+    }
+    XLALCacheMergeSort(list, tmp, h);
+    XLALCacheMergeSort(list + h, tmp, n - h);
+    if (XLALCacheCompareEntryMetadata(NULL, list + h - 1, list + h) <= 0)
+        return; /* halves are already in order */
+    memcpy(tmp, list, h * sizeof(*list));
+    /* on a tie take the entry from the first half */
+    for (i = 0, j = h, k = 0; i < h && j < n; ++k)
+        if (XLALCacheCompareEntryMetadata(NULL, list + j, tmp + i) < 0)
+            list[k] = list[j++];
+        else
+            list[k] = tmp[i++];
+    memcpy(list + k, tmp + i, (h - i) * sizeof(*list));
+}
+
 int XLALCacheSort(LALCache * cache)
 {
+    LALCacheEntry *tmp;
     if (!cache)
         XLAL_ERROR(XLAL_EFAULT);
-    /* insertion sort preserves original order in the event of a tie,
+    /* a stable sort preserves original order in the event of a tie,
      * allowing fail-over copies in the cache to be listed in order of
      * preference */
-    return XLALInsertionSort(cache->list, cache->length, sizeof(*cache->list),
-                             NULL, XLALCacheCompareEntryMetadata);
+    if (cache->length < 16)
+        return XLALInsertionSort(cache->list, cache->length,
+                                 sizeof(*cache->list), NULL,
+                                 XLALCacheCompareEntryMetadata);
+    tmp = XLALMalloc((cache->length / 2) * sizeof(*tmp));
+    if (!tmp)
+        XLAL_ERROR(XLAL_ENOMEM);
+    XLALCacheMergeSort(cache->list, tmp, cache->length);
+    XLALFree(tmp);
+    return 0;
 }
 
 int XLALCacheUniq(LALCache * cache)
@@ -660,6 +790,150 @@ LALCacheEntry *XLALCacheEntrySeek(const LALCache * cache, double t)
                    XLALCacheEntryBsearchCompare);
 }
 
+/* a run of entries with the same source and description */
+struct LALCacheIndexGroup {
+    const char *src;
+    const char *dsc;
+    UINT4 first;
+    UINT4 length;
+};
+
+struct tagLALCacheIndex {
+    LALCacheEntry *list;        /* entries of the indexed cache */
+    UINT4 ngroup;
+    struct LALCacheIndexGroup *group;
+    INT8 *maxend;       /* latest end time of the entries of the group up
+                         * to and including this one */
+};
+
+static int XLALCacheCompareGroup(const char *src1, const char *dsc1,
+                                 const char *src2, const char *dsc2)
+{
+    int c;
+    if ((c = strcmp(src1 ? src1 : "", src2 ? src2 : "")))
+        return c;
+    return strcmp(dsc1 ? dsc1 : "", dsc2 ? dsc2 : "");
+}
+
+LALCacheIndex *XLALCreateCacheIndex(const LALCache * cache)
+{
+    LALCacheIndex *index;
+    UINT4 i;
+    if (!cache)
+        XLAL_ERROR_NULL(XLAL_EFAULT);
+    for (i = 1; i < cache->length; ++i)
+        if (XLALCacheCompareEntryMetadata(NULL, cache->list + i - 1,
+                                          cache->list + i) > 0)
+            XLAL_ERROR_NULL(XLAL_EINVAL,
+                            "Cache is not sorted; use XLALCacheSort()");
+    index = XLALCalloc(1, sizeof(*index));
+    if (!index)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    index->list = cache->list;
+    if (cache->length) {
+        index->group = XLALMalloc(cache->length * sizeof(*index->group));
+        index->maxend = XLALMalloc(cache->length * sizeof(*index->maxend));
+        if (!index->group || !index->maxend) {
+            XLALDestroyCacheIndex(index);
+            XLAL_ERROR_NULL(XLAL_ENOMEM);
+        }
+    }
+    for (i = 0; i < cache->length; ++i) {
+        const LALCacheEntry *entry = cache->list + i;
+        struct LALCacheIndexGroup *group = index->group + index->ngroup;
+        INT8 end = (INT8) entry->t0 + entry->dt;
+        if (i > 0
+            && !XLALCacheCompareGroup(group[-1].src, group[-1].dsc,
+                                      entry->src, entry->dsc)) {
+            --group;
+            if (index->maxend[i - 1] > end)
+                end = index->maxend[i - 1];
+        } else {
+            ++index->ngroup;
+            group->src = entry->src;
+            group->dsc = entry->dsc;
+            group->first = i;
+            group->length = 0;
+        }
+        ++group->length;
+        index->maxend[i] = end;
+    }
+    return index;
+}
+
+void XLALDestroyCacheIndex(LALCacheIndex * index)
+{
+    if (index) {
+        XLALFree(index->group);
+        XLALFree(index->maxend);
+        XLALFree(index);
+    }
+    return;
+}
+
+LALCacheEntry *XLALCacheIndexFind(const LALCacheIndex * index,
+                                  const char *src, const char *dsc,
+                                  INT4 t0, INT4 t1, UINT4 * length)
+{
+    const struct LALCacheIndexGroup *group = NULL;
+    UINT4 lo, hi, first, last;
+    if (!index || !length)
+        XLAL_ERROR_NULL(XLAL_EFAULT);
+    *length = 0;
+
+    /* find the group of entries with this source and description */
+    lo = 0;
+    hi = index->ngroup;
+    while (lo < hi) {
+        UINT4 mid = lo + (hi - lo) / 2;
+        int c = XLALCacheCompareGroup(index->group[mid].src,
+                                      index->group[mid].dsc, src, dsc);
+        if (c < 0)
+            lo = mid + 1;
+        else if (c > 0)
+            hi = mid;
+        else {
+            group = index->group + mid;
+            break;
+        }
+    }
+    if (!group)
+        return NULL;
+
+    /* first entry ending after t0: the running latest end time is in
+     * order even where the start times of entries are not enough */
+    lo = group->first;
+    hi = group->first + group->length;
+    if (t0 > 0)
+        while (lo < hi) {
+            UINT4 mid = lo + (hi - lo) / 2;
+            if (index->maxend[mid] > t0)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+    first = lo;
+
+    /* first entry starting at or after t1 */
+    last = group->first + group->length;
+    if (t1 > 0) {
+        hi = last;
+        while (lo < hi) {
+            UINT4 mid = lo + (hi - lo) / 2;
+            if (index->list[mid].t0 < t1)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        last = lo;
+    }
+
+    if (first == last)
+        return NULL;
+    *length = last - first;
+    return index->list + first;
+}
+
 LALFILE *XLALCacheEntryOpen(const LALCacheEntry * entry)
 {
     char *nextslash;
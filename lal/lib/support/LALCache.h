@@ -132,6 +132,44 @@ LALCacheEntry *XLALCacheEntrySeek(const LALCache * cache, double t);
 /** Open a file identified by an entry in a LALCache structure. */
 LALFILE *XLALCacheEntryOpen(const LALCacheEntry * entry);
 
+/**
+ * An index of the entries of a sorted LALCache structure, grouped by
+ * source and description, for finding the entries of a group in a time
+ * range without copying them.
+ */
+typedef struct tagLALCacheIndex LALCacheIndex;
+
+#ifndef SWIG    /* exclude from SWIG interface */
+
+/**
+ * Creates an index of a LALCache structure, which must be sorted (see
+ * XLALCacheSort()).  The index refers to the entries of the cache, which
+ * must not be modified or destroyed while the index is in use.  Creating
+ * the index is linear in the length of the cache.
+ */
+LALCacheIndex *XLALCreateCacheIndex(const LALCache * cache);
+
+/** Destroys a LALCacheIndex structure. */
+void XLALDestroyCacheIndex(LALCacheIndex * index);
+
+/**
+ * Finds the entries with source \a src and description \a dsc (NULL
+ * matching entries without one) that overlap the time range [t0, t1), in
+ * a time logarithmic in the length of the cache.  The entries are
+ * returned as a view of the indexed cache: the return value points to the
+ * first of \a length consecutive entries of the cache, or is NULL if there
+ * are none.  The view holds every entry of the group that
+ * XLALCacheSieve() would keep for t0 and t1 (either 0 to disable), and
+ * nothing else unless some entries of the group overlap each other, in
+ * which case it can also hold entries, contained in the span of others,
+ * which end before t0.
+ */
+LALCacheEntry *XLALCacheIndexFind(const LALCacheIndex * index,
+                                  const char *src, const char *dsc,
+                                  INT4 t0, INT4 t1, UINT4 * length);
+
+#endif /* SWIG */
+
 /** @} */
 
 #if 0
@@ -39,6 +39,13 @@
  * XLALSegListInit(), XLALSegListClear(), XLALSegListAppend(), XLALSegListSort()
  * XLALSegListCoalesce(), XLALSegListSearch()
  *
+ * XLALSegListUnion(), XLALSegListIntersection() and XLALSegListDifference()
+ * combine two sorted segment lists in a single merge pass, and
+ * XLALSegListSearchSorted() looks up a sorted array of GPS times in one
+ * sweep through a disjoint list.  For lists which are not disjoint,
+ * XLALSegTreeCreate() builds an interval tree which XLALSegTreeOverlaps()
+ * searches for the segments overlapping a time interval.
+ *
  * ### Error codes and return values ###
  *
  * Each XLAL function listed above, if it fails invokes the current XLAL error
@@ -49,14 +56,19 @@
  * <li>
  * Functions which return an integer status code (XLALSegSet(),
  * XLALSegListInit(), XLALSegListClear(), XLALSegListAppend(), XLALSegListSort(),
- * XLALSegListCoalesce() return XLAL_SUCCESS if successful
+ * XLALSegListCoalesce(), XLALSegListUnion(), XLALSegListIntersection(),
+ * XLALSegListDifference(), XLALSegListSearchSorted()) return XLAL_SUCCESS if successful
  * or XLAL_FAILURE if an error occurs.</li>
  * <li>
  * XLALGPSInSeg() and XLALSegCmp() normally return a
  * comparison value (negative, 0, or positive).</li>
  * <li>
  * XLALSegCreate() normally returns a pointer to the created
- * segment.  If an error occurs, it returns NULL.</li>
+ * segment.  If an error occurs, it returns NULL.  The same holds for
+ * XLALSegTreeCreate().</li>
+ * <li>
+ * XLALSegTreeOverlaps() returns the number of segments found, or a negative
+ * value if an error occurs.</li>
  * <li>
  * XLALSegListSearch() returns a pointer to a segment in the list which
  * contains the time being searched for, or NULL if there is no such segment.
@@ -1150,3 +1162,433 @@ XLALSegListGet( LALSegList *seglist, UINT4 indx )
         return tmp;
 
 }  /* XLALSegListGet() */
+
+
+/*---------------------------------------------------------------------------*/
+
+/* Reads the run of touching or overlapping segments starting at segment *i
+   of a sorted segment list into run, as XLALSegListCoalesce() would join
+   them, and advances *i past it.  Returns 0 when the list is exhausted. */
+static int
+SegListNextRun( const LALSegList *seglist, UINT4 *i, LALSeg *run )
+{
+  if ( *i >= seglist->length ) {
+    return 0;
+  }
+  *run = seglist->segs[(*i)++];
+  while ( *i < seglist->length
+          && XLALGPSCmp( &seglist->segs[*i].start, &run->end ) <= 0 ) {
+    if ( XLALGPSCmp( &run->end, &seglist->segs[*i].end ) < 0 ) {
+      run->end = seglist->segs[*i].end;
+    }
+    (*i)++;
+  }
+  return 1;
+}
+
+
+/* Checks the arguments of the segment list set operations and clears the
+   result list. */
+static int
+SegListSetOpInit( LALSegList *result, const LALSegList *a, const LALSegList *b )
+{
+  XLAL_CHECK( result != NULL && a != NULL && b != NULL, XLAL_EFAULT );
+  XLAL_CHECK( result->initMagic == SEGMENTSH_INITMAGICVAL
+              && a->initMagic == SEGMENTSH_INITMAGICVAL
+              && b->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL,
+              "Passed unintialized LALSegList structure" );
+  XLAL_CHECK( result != a && result != b, XLAL_EINVAL,
+              "Result segment list must not be one of the operands" );
+  XLAL_CHECK( a->sorted && b->sorted, XLAL_EINVAL,
+              "Operand segment lists must be sorted" );
+  XLAL_CHECK( XLALSegListClear( result ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * The function XLALSegListUnion() replaces the contents of \a result with
+ * the segments covering every time which is in segment list \a a or in
+ * segment list \a b.  Both lists must be sorted (see XLALSegListSort()) but
+ * need not be disjoint, and neither is modified.  The two lists are merged
+ * in a single pass, so the cost is linear in their total length.  The result
+ * is coalesced, exactly as if the two lists had been concatenated and passed
+ * to XLALSegListCoalesce(), and each of its segments takes the \c id of the
+ * earliest segment it was made from.  \a result must have been initialized
+ * and must not be one of the operands.
+ */
+int
+XLALSegListUnion( LALSegList *result, const LALSegList *a, const LALSegList *b )
+{
+  UINT4 ia = 0, ib = 0;
+  LALSeg ra, rb, next, cur;
+  int havea, haveb, havecur = 0;
+
+  XLAL_CHECK( SegListSetOpInit( result, a, b ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  havea = SegListNextRun( a, &ia, &ra );
+  haveb = SegListNextRun( b, &ib, &rb );
+  while ( havea || haveb ) {
+    /* Take whichever of the two current runs starts first */
+    if ( havea && ( ! haveb || XLALGPSCmp( &ra.start, &rb.start ) <= 0 ) ) {
+      next = ra;
+      havea = SegListNextRun( a, &ia, &ra );
+    } else {
+      next = rb;
+      haveb = SegListNextRun( b, &ib, &rb );
+    }
+
+    if ( havecur && XLALGPSCmp( &next.start, &cur.end ) <= 0 ) {
+      /* Touches or overlaps the segment being built, so extend it */
+      if ( XLALGPSCmp( &cur.end, &next.end ) < 0 ) {
+        cur.end = next.end;
+      }
+    } else {
+      if ( havecur ) {
+        XLAL_CHECK( XLALSegListAppend( result, &cur ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+      cur = next;
+      havecur = 1;
+    }
+  }
+  if ( havecur ) {
+    XLAL_CHECK( XLALSegListAppend( result, &cur ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * The function XLALSegListIntersection() replaces the contents of \a result
+ * with the segments covering every time which is both in segment list \a a
+ * and in segment list \a b.  The requirements on the arguments, the linear
+ * cost and the form of the result are as for XLALSegListUnion(); each segment
+ * of the result takes the \c id of the segment of \a a it lies in.  Since a
+ * time is in a segment only if it is before the segment's end time,
+ * zero-length segments contain no times and never appear in the result.
+ */
+int
+XLALSegListIntersection( LALSegList *result, const LALSegList *a, const LALSegList *b )
+{
+  UINT4 ia = 0, ib = 0;
+  LALSeg ra, rb, seg;
+  int havea, haveb;
+
+  XLAL_CHECK( SegListSetOpInit( result, a, b ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  havea = SegListNextRun( a, &ia, &ra );
+  haveb = SegListNextRun( b, &ib, &rb );
+  while ( havea && haveb ) {
+    seg.start = XLALGPSCmp( &ra.start, &rb.start ) < 0 ? rb.start : ra.start;
+    seg.end = XLALGPSCmp( &ra.end, &rb.end ) < 0 ? ra.end : rb.end;
+    seg.id = ra.id;
+    if ( XLALGPSCmp( &seg.start, &seg.end ) < 0 ) {
+      XLAL_CHECK( XLALSegListAppend( result, &seg ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+    /* Move past whichever run ends first */
+    if ( XLALGPSCmp( &ra.end, &rb.end ) < 0 ) {
+      havea = SegListNextRun( a, &ia, &ra );
+    } else {
+      haveb = SegListNextRun( b, &ib, &rb );
+    }
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/**
+ * The function XLALSegListDifference() replaces the contents of \a result
+ * with the segments covering every time which is in segment list \a a but
+ * not in segment list \a b.  The requirements on the arguments, the linear
+ * cost and the form of the result are as for XLALSegListIntersection().
+ */
+int
+XLALSegListDifference( LALSegList *result, const LALSegList *a, const LALSegList *b )
+{
+  UINT4 ia = 0, ib = 0;
+  LALSeg ra, rb, seg;
+  int haveb;
+
+  XLAL_CHECK( SegListSetOpInit( result, a, b ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  haveb = SegListNextRun( b, &ib, &rb );
+  while ( SegListNextRun( a, &ia, &ra ) ) {
+    /* Skip the runs of b which end before this run of a starts, and those
+       which contain no times */
+    while ( haveb && ( XLALGPSCmp( &rb.end, &ra.start ) <= 0
+                       || XLALGPSCmp( &rb.start, &rb.end ) == 0 ) ) {
+      haveb = SegListNextRun( b, &ib, &rb );
+    }
+
+    /* Cut each run of b which overlaps it out of this run of a */
+    while ( haveb && XLALGPSCmp( &rb.start, &ra.end ) < 0 ) {
+      if ( XLALGPSCmp( &ra.start, &rb.start ) < 0 ) {
+        seg.start = ra.start;
+        seg.end = rb.start;
+        seg.id = ra.id;
+        XLAL_CHECK( XLALSegListAppend( result, &seg ) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+      if ( XLALGPSCmp( &ra.end, &rb.end ) <= 0 ) {
+        /* The rest of the run of a is covered; the run of b may also
+           overlap the next run of a, so keep it */
+        ra.start = ra.end;
+        break;
+      }
+      ra.start = rb.end;
+      do {
+        haveb = SegListNextRun( b, &ib, &rb );
+      } while ( haveb && XLALGPSCmp( &rb.start, &rb.end ) == 0 );
+    }
+
+    if ( XLALGPSCmp( &ra.start, &ra.end ) < 0 ) {
+      XLAL_CHECK( XLALSegListAppend( result, &ra ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * The function XLALSegListSearchSorted() looks up many GPS times at once.
+ * For each of the \a n times in the array \a gps, which must be in
+ * non-decreasing order, it sets the corresponding element of \a found to the
+ * segment of \a seglist which contains the time, or to NULL if there is none.
+ * The segment list must be disjoint (see XLALSegListCoalesce()).  The list is
+ * swept once from the beginning, with an exponential search to skip over
+ * segments falling between consecutive times, so the cost is at most linear
+ * in the number of times plus the number of segments, and is logarithmic per
+ * time when the times are sparse compared with the segments.
+ */
+int
+XLALSegListSearchSorted( LALSegList *seglist, const LIGOTimeGPS *gps, size_t n, LALSeg **found )
+{
+  UINT4 j = 0;
+
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( n == 0 || ( gps != NULL && found != NULL ), XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL,
+              "Passed unintialized LALSegList structure" );
+  XLAL_CHECK( seglist->disjoint, XLAL_EINVAL, "Segment list must be disjoint" );
+
+  for ( size_t i = 0; i < n; i++ ) {
+    XLAL_CHECK( i == 0 || XLALGPSCmp( &gps[i-1], &gps[i] ) <= 0, XLAL_EINVAL,
+                "GPS times are not in order at element %zu", i );
+
+    /* Find the first segment at or after j which ends after this time; the
+       end times of a disjoint list are in order */
+    if ( j < seglist->length && XLALGPSCmp( &seglist->segs[j].end, &gps[i] ) <= 0 ) {
+      UINT4 lo = j, hi, step = 1;
+      /* segs[lo] ends at or before the time: double the step until past it */
+      while ( step < seglist->length - lo
+              && XLALGPSCmp( &seglist->segs[lo + step].end, &gps[i] ) <= 0 ) {
+        lo += step;
+        step *= 2;
+      }
+      hi = step < seglist->length - lo ? lo + step : seglist->length;
+      /* segs[lo] ends at or before the time, segs[hi] (if any) after it */
+      while ( hi - lo > 1 ) {
+        UINT4 mid = lo + ( hi - lo ) / 2;
+        if ( XLALGPSCmp( &seglist->segs[mid].end, &gps[i] ) <= 0 ) {
+          lo = mid;
+        } else {
+          hi = mid;
+        }
+      }
+      j = hi;
+    }
+
+    if ( j < seglist->length && XLALGPSCmp( &seglist->segs[j].start, &gps[i] ) <= 0 ) {
+      found[i] = &seglist->segs[j];
+    } else {
+      found[i] = NULL;
+    }
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/* A node of an interval tree.  The nodes are stored in order of start time,
+   and the node in the middle of any range of the array is the root of the
+   subtree holding that range, so that no links need to be stored. */
+typedef struct tagLALSegTreeNode {
+  INT8 start;   /* start time of the segment in ns */
+  INT8 end;     /* end time of the segment in ns */
+  INT8 maxend;  /* latest end time in the subtree rooted here, in ns */
+  UINT4 indx;   /* index of the segment in the segment list */
+} LALSegTreeNode;
+
+struct tagLALSegTree {
+  size_t length;
+  LALSegTreeNode *node;
+};
+
+
+static int
+SegTreeNodeCmp( const void *pnode0, const void *pnode1 )
+{
+  const LALSegTreeNode *node0 = pnode0;
+  const LALSegTreeNode *node1 = pnode1;
+  return ( node0->start > node1->start ) - ( node0->start < node1->start );
+}
+
+
+/* Sets the maxend values of the subtree holding nodes [lo, hi) and returns
+   the largest of them. */
+static INT8
+SegTreeBuild( LALSegTreeNode *node, size_t lo, size_t hi )
+{
+  size_t mid;
+  INT8 maxend, sub;
+
+  if ( lo >= hi ) {
+    return INT64_MIN;
+  }
+  mid = lo + ( hi - lo ) / 2;
+  maxend = node[mid].end;
+  sub = SegTreeBuild( node, lo, mid );
+  if ( sub > maxend ) {
+    maxend = sub;
+  }
+  sub = SegTreeBuild( node, mid + 1, hi );
+  if ( sub > maxend ) {
+    maxend = sub;
+  }
+  node[mid].maxend = maxend;
+  return maxend;
+}
+
+
+/* Counts the segments of the subtree holding nodes [lo, hi) which overlap
+   [start, end), storing the indices of the first size of them. */
+static void
+SegTreeQuery( const LALSegTreeNode *node, size_t lo, size_t hi, INT8 start,
+              INT8 end, UINT4 *indx, size_t size, long *count )
+{
+  while ( lo < hi ) {
+    size_t mid = lo + ( hi - lo ) / 2;
+    /* No segment in this subtree ends after the interval starts */
+    if ( node[mid].maxend <= start ) {
+      return;
+    }
+    SegTreeQuery( node, lo, mid, start, end, indx, size, count );
+    /* This segment, and all those after it, start after the interval */
+    if ( node[mid].start >= end ) {
+      return;
+    }
+    if ( start < node[mid].end ) {
+      if ( (size_t) *count < size ) {
+        indx[*count] = node[mid].indx;
+      }
+      (*count)++;
+    }
+    lo = mid + 1;
+  }
+}
+
+
+/**
+ * The function XLALSegTreeCreate() builds an interval tree over the segments
+ * of a segment list, for finding the segments which overlap a time interval
+ * with XLALSegTreeOverlaps() when the list is not disjoint, or not even
+ * sorted.  Building the tree costs \f$O(n \log n)\f$ for \f$n\f$ segments
+ * (\f$O(n)\f$ if the list is sorted).  The tree holds a copy of the segment
+ * times and refers to the segments by their index in the list, so it remains
+ * valid only as long as the list is not modified.  Zero-length segments
+ * contain no times, and are left out of the tree.  The tree must be freed
+ * with XLALSegTreeDestroy().
+ */
+LALSegTree *
+XLALSegTreeCreate( const LALSegList *seglist )
+{
+  LALSegTree *tree;
+
+  XLAL_CHECK_NULL( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL,
+                   "Passed unintialized LALSegList structure" );
+
+  tree = LALMalloc( sizeof(*tree) );
+  XLAL_CHECK_NULL( tree != NULL, XLAL_ENOMEM );
+  tree->length = 0;
+  tree->node = LALMalloc( ( seglist->length ? seglist->length : 1 ) * sizeof(*tree->node) );
+  if ( ! tree->node ) {
+    LALFree( tree );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+
+  for ( UINT4 i = 0; i < seglist->length; i++ ) {
+    LALSegTreeNode *node = &tree->node[tree->length];
+    node->start = XLALGPSToINT8NS( &seglist->segs[i].start );
+    node->end = XLALGPSToINT8NS( &seglist->segs[i].end );
+    node->indx = i;
+    if ( node->start < node->end ) {
+      tree->length++;
+    }
+  }
+  if ( ! seglist->sorted ) {
+    qsort( tree->node, tree->length, sizeof(*tree->node), SegTreeNodeCmp );
+  }
+  SegTreeBuild( tree->node, 0, tree->length );
+
+  return tree;
+}
+
+
+/**
+ * This function frees an interval tree created with XLALSegTreeCreate().
+ */
+void
+XLALSegTreeDestroy( LALSegTree *tree )
+{
+  if ( tree ) {
+    LALFree( tree->node );
+    LALFree( tree );
+  }
+}
+
+
+/**
+ * The function XLALSegTreeOverlaps() finds the segments which overlap the
+ * half-open interval [\a start, \a end), that is those which contain at
+ * least one of its times.  If \a start equals \a end, it finds instead the
+ * segments which contain the time \a start, like XLALSegListSearch() but
+ * returning all of them.  The indices in the segment list of the first \a size
+ * segments found, in order of start time, are stored in \a indx (which may be
+ * NULL if \a size is 0), and the total number of segments found is returned,
+ * so that a caller can count the segments first and then allocate an array
+ * large enough to hold them.  The search descends into every subtree holding
+ * a segment which ends after \a start, so the cost is
+ * \f$O(\min(n, (k + 1) \log n))\f$ for \f$k\f$ segments found, rather than
+ * the \f$O(\log n + k)\f$ of a centred interval tree.  Returns a negative
+ * value on failure.
+ */
+long
+XLALSegTreeOverlaps( const LALSegTree *tree, const LIGOTimeGPS *start, const LIGOTimeGPS *end, UINT4 *indx, size_t size )
+{
+  INT8 startNS, endNS;
+  long count = 0;
+
+  XLAL_CHECK( tree != NULL && start != NULL && end != NULL, XLAL_EFAULT );
+  XLAL_CHECK( size == 0 || indx != NULL, XLAL_EFAULT );
+
+  startNS = XLALGPSToINT8NS( start );
+  endNS = XLALGPSToINT8NS( end );
+  XLAL_CHECK( startNS <= endNS, XLAL_EDOM, "Invalid interval (end before start)" );
+  if ( startNS == endNS ) {
+    /* The segments containing a time are those overlapping the nanosecond
+       beginning at it */
+    endNS++;
+  }
+
+  SegTreeQuery( tree->node, 0, tree->length, startNS, endNS, indx, size, &count );
+
+  return count;
+}
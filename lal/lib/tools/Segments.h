@@ -187,6 +187,9 @@ tagLALSegList
 }
 LALSegList;
 
+/** Opaque interval tree over the segments of a segment list */
+typedef struct tagLALSegTree LALSegTree;
+
 /*----------------------- Function prototypes ----------------------*/
 int
 XLALSegSet( LALSeg *seg, const LIGOTimeGPS *start, const LIGOTimeGPS *end,
@@ -238,6 +241,31 @@ XLALSegListKeep(  LALSegList *seglist, const LIGOTimeGPS *start, const LIGOTimeG
 LALSeg *
 XLALSegListGet( LALSegList *seglist, UINT4 indx );
 
+int
+XLALSegListUnion( LALSegList *result, const LALSegList *a, const LALSegList *b );
+
+int
+XLALSegListIntersection( LALSegList *result, const LALSegList *a, const LALSegList *b );
+
+int
+XLALSegListDifference( LALSegList *result, const LALSegList *a, const LALSegList *b );
+
+#ifndef SWIG /* exclude from SWIG interface */
+
+int
+XLALSegListSearchSorted( LALSegList *seglist, const LIGOTimeGPS *gps, size_t n, LALSeg **found );
+
+LALSegTree *
+XLALSegTreeCreate( const LALSegList *seglist );
+
+void
+XLALSegTreeDestroy( LALSegTree *tree );
+
+long
+XLALSegTreeOverlaps( const LALSegTree *tree, const LIGOTimeGPS *start, const LIGOTimeGPS *end, UINT4 *indx, size_t size );
+
+#endif /* SWIG */
+
 
 int XLALSegListIsInitialized ( const LALSegList *seglist );
 int XLALSegListInitSimpleSegments ( LALSegList *seglist, LIGOTimeGPS startTime, UINT4 Nseg, REAL8 Tseg );
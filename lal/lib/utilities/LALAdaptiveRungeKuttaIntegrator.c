@@ -17,6 +17,9 @@
 *  MA  02111-1307  USA
 */
 
+#include <math.h>
+#include <float.h>
+
 #include <lal/LALAdaptiveRungeKuttaIntegrator.h>
 
 #define XLAL_BEGINGSL \
@@ -105,6 +108,30 @@ LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4InitEighthOrderInstead(i
     return integrator;
 }
 
+LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKuttaDormandPrinceInit(int dim, int (*dydt) (double t, const double y[], double dydt[], void *params),   /* These are XLAL functions! */
+    int (*stop) (double t, const double y[], double dydt[], void *params), double eps_abs, double eps_rel)
+{
+    LALAdaptiveRungeKuttaIntegrator *integrator;
+
+    /* set up the GSL components as well, so that the integrator can also
+     * be passed to the other integration routines */
+    if (!(integrator = XLALAdaptiveRungeKutta4Init(dim, dydt, stop, eps_abs, eps_rel))) {
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    /* allocate the work space of the Dormand-Prince stepper */
+    if (!(integrator->dpwork = (double *) LALCalloc(15 * dim, sizeof(double)))) {
+        XLALAdaptiveRungeKuttaFree(integrator);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    integrator->eps_abs = eps_abs;
+    integrator->eps_rel = eps_rel;
+    integrator->hlast = 0.0;
+
+    return integrator;
+}
+
 void XLALAdaptiveRungeKuttaFree(LALAdaptiveRungeKuttaIntegrator * integrator)
 {
     if (!integrator)
@@ -118,6 +145,7 @@ void XLALAdaptiveRungeKuttaFree(LALAdaptiveRungeKuttaIntegrator * integrator)
         XLAL_CALLGSL(gsl_odeiv_step_free(integrator->step));
 
     LALFree(integrator->sys);
+    LALFree(integrator->dpwork);
     LALFree(integrator);
 
     return;
@@ -1098,6 +1126,313 @@ int XLALAdaptiveRungeKutta4(LALAdaptiveRungeKuttaIntegrator * integrator,
     return outputlen;
 }
 
+/* Dormand-Prince 5(4) coefficients and the coefficients of its continuous
+ * extension; see Hairer, Norsett & Wanner, Solving Ordinary Differential
+ * Equations I, 2nd ed. (Springer, 1993), Table II.5.2 and Sec. II.6 */
+static const REAL8 dp_c2 = 1.0 / 5.0, dp_c3 = 3.0 / 10.0, dp_c4 = 4.0 / 5.0, dp_c5 = 8.0 / 9.0;
+static const REAL8 dp_a21 = 1.0 / 5.0;
+static const REAL8 dp_a31 = 3.0 / 40.0, dp_a32 = 9.0 / 40.0;
+static const REAL8 dp_a41 = 44.0 / 45.0, dp_a42 = -56.0 / 15.0, dp_a43 = 32.0 / 9.0;
+static const REAL8 dp_a51 = 19372.0 / 6561.0, dp_a52 = -25360.0 / 2187.0, dp_a53 = 64448.0 / 6561.0, dp_a54 = -212.0 / 729.0;
+static const REAL8 dp_a61 = 9017.0 / 3168.0, dp_a62 = -355.0 / 33.0, dp_a63 = 46732.0 / 5247.0, dp_a64 = 49.0 / 176.0, dp_a65 = -5103.0 / 18656.0;
+static const REAL8 dp_b1 = 35.0 / 384.0, dp_b3 = 500.0 / 1113.0, dp_b4 = 125.0 / 192.0, dp_b5 = -2187.0 / 6784.0, dp_b6 = 11.0 / 84.0;
+static const REAL8 dp_e1 = 71.0 / 57600.0, dp_e3 = -71.0 / 16695.0, dp_e4 = 71.0 / 1920.0, dp_e5 = -17253.0 / 339200.0, dp_e6 = 22.0 / 525.0, dp_e7 = -1.0 / 40.0;
+static const REAL8 dp_d1 = -12715105075.0 / 11282082432.0, dp_d3 = 87487479700.0 / 32700410799.0, dp_d4 = -10690763975.0 / 1880347072.0,
+    dp_d5 = 701980252875.0 / 199316789632.0, dp_d6 = -1453857185.0 / 822651844.0, dp_d7 = 69997945.0 / 29380423.0;
+
+/* Local function taking a single Dormand-Prince step of size h from (t, y);
+ * k[0] must hold dydt at (t, y) on input.  On success ynew, yerr and
+ * k[1]...k[6] are filled in, and k[6] holds dydt at (t + h, ynew). */
+static int dormandPrinceStep(LALAdaptiveRungeKuttaIntegrator * integrator, void *params, REAL8 t, REAL8 h, const REAL8 * y, REAL8 ** k,
+    REAL8 * ytmp, REAL8 * ynew, REAL8 * yerr)
+{
+    const size_t dim = integrator->sys->dimension;
+    int status;
+    size_t i;
+
+    for (i = 0; i < dim; i++)
+        ytmp[i] = y[i] + h * dp_a21 * k[0][i];
+    if ((status = integrator->dydt(t + dp_c2 * h, ytmp, k[1], params)) != GSL_SUCCESS)
+        return status;
+
+    for (i = 0; i < dim; i++)
+        ytmp[i] = y[i] + h * (dp_a31 * k[0][i] + dp_a32 * k[1][i]);
+    if ((status = integrator->dydt(t + dp_c3 * h, ytmp, k[2], params)) != GSL_SUCCESS)
+        return status;
+
+    for (i = 0; i < dim; i++)
+        ytmp[i] = y[i] + h * (dp_a41 * k[0][i] + dp_a42 * k[1][i] + dp_a43 * k[2][i]);
+    if ((status = integrator->dydt(t + dp_c4 * h, ytmp, k[3], params)) != GSL_SUCCESS)
+        return status;
+
+    for (i = 0; i < dim; i++)
+        ytmp[i] = y[i] + h * (dp_a51 * k[0][i] + dp_a52 * k[1][i] + dp_a53 * k[2][i] + dp_a54 * k[3][i]);
+    if ((status = integrator->dydt(t + dp_c5 * h, ytmp, k[4], params)) != GSL_SUCCESS)
+        return status;
+
+    for (i = 0; i < dim; i++)
+        ytmp[i] = y[i] + h * (dp_a61 * k[0][i] + dp_a62 * k[1][i] + dp_a63 * k[2][i] + dp_a64 * k[3][i] + dp_a65 * k[4][i]);
+    if ((status = integrator->dydt(t + h, ytmp, k[5], params)) != GSL_SUCCESS)
+        return status;
+
+    /* the fifth-order solution is also the last stage (first same as last) */
+    for (i = 0; i < dim; i++)
+        ynew[i] = y[i] + h * (dp_b1 * k[0][i] + dp_b3 * k[2][i] + dp_b4 * k[3][i] + dp_b5 * k[4][i] + dp_b6 * k[5][i]);
+    if ((status = integrator->dydt(t + h, ynew, k[6], params)) != GSL_SUCCESS)
+        return status;
+
+    for (i = 0; i < dim; i++)
+        yerr[i] = h * (dp_e1 * k[0][i] + dp_e3 * k[2][i] + dp_e4 * k[3][i] + dp_e5 * k[4][i] + dp_e6 * k[5][i] + dp_e7 * k[6][i]);
+
+    return GSL_SUCCESS;
+}
+
+/* Local function adjusting the step size from the error estimate; this is
+ * the standard GSL control (gsl_odeiv_control_y_new) for a fifth-order
+ * stepper, so that eps_abs and eps_rel have the same meaning as for the
+ * other integration routines */
+static int dormandPrinceAdjust(const LALAdaptiveRungeKuttaIntegrator * integrator, const REAL8 * y, const REAL8 * yerr, REAL8 * h)
+{
+    const size_t dim = integrator->sys->dimension;
+    REAL8 rmax = DBL_MIN;
+    size_t i;
+
+    for (i = 0; i < dim; i++) {
+        const REAL8 D = integrator->eps_abs + integrator->eps_rel * fabs(y[i]);
+        const REAL8 r = fabs(yerr[i]) / fabs(D);
+        if (r > rmax)
+            rmax = r;
+    }
+
+    if (rmax > 1.1) {
+        /* decrease step, no more than factor of 5 */
+        REAL8 r = 0.9 / pow(rmax, 1.0 / 5.0);
+        if (r < 0.2)
+            r = 0.2;
+        *h *= r;
+        return GSL_ODEIV_HADJ_DEC;
+    } else if (rmax < 0.5) {
+        /* increase step, no more than factor of 5 */
+        REAL8 r = 0.9 / pow(rmax, 1.0 / 6.0);
+        if (r > 5.0)
+            r = 5.0;
+        else if (r < 1.0)
+            r = 1.0;
+        *h *= r;
+        return GSL_ODEIV_HADJ_INC;
+    }
+
+    return GSL_ODEIV_HADJ_NIL;
+}
+
+/**
+ * Fifth-order Runge-Kutta ODE integrator using Dormand-Prince 5(4) steps
+ * with adaptive step size control, producing evenly sampled output through
+ * the continuous extension of the method (Hairer, Norsett & Wanner, Solving
+ * Ordinary Differential Equations I, Sec. II.6).  The samples are
+ * evaluated as each step is taken, so unlike XLALAdaptiveRungeKutta4 no
+ * trajectory is stored and no spline is fit afterwards, and the derivative
+ * at the end of each step is reused as the first stage of the next.
+ *
+ * The integrator must be created with XLALAdaptiveRungeKuttaDormandPrinceInit().
+ * It keeps its work space and the last accepted step size between calls,
+ * the latter being used as the first trial step of the next integration.
+ *
+ * If *yout is NULL, an output array of (tend - tinit) / deltat + 2 samples
+ * is allocated.  Otherwise *yout must be a (dim + 1) x N array, which is
+ * filled in place and only replaced by a larger one if more than N samples
+ * are produced.  On return the array holds the times in its first row and
+ * the variables in the following rows, exactly as for XLALAdaptiveRungeKutta4,
+ * and its second dimension is set to the number of samples, which is also
+ * the return value.  The final state of the integration (not the final
+ * sample) is returned in yinit.  On failure an array allocated here is
+ * destroyed, while an array passed in is left for the caller to destroy.
+ *
+ * Only forward integration, with deltat > 0, is supported.
+ */
+int XLALAdaptiveRungeKuttaDenseOutput(LALAdaptiveRungeKuttaIntegrator * integrator,    /**< integrator created by XLALAdaptiveRungeKuttaDormandPrinceInit() */
+    void *params,                                                               /**< params struct used to compute dydt and stopping test */
+    REAL8 * yinit,                                                              /**< pass in initial values of all variables - overwritten to final values */
+    REAL8 tinit,                                                                /**< integration start time */
+    REAL8 tend_in,                                                              /**< maximum integration time */
+    REAL8 deltat,                                                               /**< step size for evenly sampled output */
+    REAL8Array ** yout                                                          /**< array holding the evenly sampled output */
+    )
+{
+    int errnum = 0;
+    int status;
+    size_t dim, retries, i;
+    int outputlen = 0, count = 0;
+    int allocated = 0;
+
+    REAL8Array *output = NULL;
+
+    REAL8 t, h, hstep, tend, tintp;
+    REAL8 *k[7], *ytmp, *ynew, *yerr, *y, *r2, *r3, *r4, *r5;
+
+    if (!integrator || !integrator->dpwork || !yinit || !yout)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!(deltat > 0.0) || tend_in < tinit)
+        XLAL_ERROR(XLAL_EINVAL, "deltat must be positive and tend_in no earlier than tinit\ntend_in: %f, tinit: %f, deltat: %f\n", tend_in, tinit, deltat);
+
+    dim = integrator->sys->dimension;
+
+    /* Set up the output array. */
+    output = *yout;
+    if (output) {
+        if (output->dimLength->length != 2 || output->dimLength->data[0] != dim + 1 || output->dimLength->data[1] < 1)
+            XLAL_ERROR(XLAL_EBADLEN, "output array must be (%zu x N)", dim + 1);
+        outputlen = output->dimLength->data[1];
+    } else {
+        outputlen = (int)((tend_in - tinit) / deltat) + 2;
+        if (!(output = XLALCreateREAL8ArrayL(2, dim + 1, outputlen)))
+            XLAL_ERROR(XLAL_ENOMEM);
+        allocated = 1;
+    }
+
+    /* Aliases into the work space. */
+    for (i = 0; i < 7; i++)
+        k[i] = integrator->dpwork + i * dim;
+    ytmp = integrator->dpwork + 7 * dim;
+    ynew = integrator->dpwork + 8 * dim;
+    yerr = integrator->dpwork + 9 * dim;
+    y = integrator->dpwork + 10 * dim;
+    r2 = integrator->dpwork + 11 * dim;
+    r3 = integrator->dpwork + 12 * dim;
+    r4 = integrator->dpwork + 13 * dim;
+    r5 = integrator->dpwork + 14 * dim;
+
+    XLAL_BEGINGSL;
+
+    /* If want to stop only on test, then tend = +infinity; otherwise
+     * tend_in */
+    tend = integrator->stopontestonly ? 1.0 / 0.0 : tend_in;
+
+    /* Setup. */
+    integrator->sys->params = params;
+    integrator->returncode = 0;
+    retries = integrator->retries;
+    t = tinit;
+    h = integrator->hlast > 0.0 ? integrator->hlast : deltat;
+    memcpy(y, yinit, dim * sizeof(REAL8));
+
+    /* Copy over first sample. */
+    output->data[0] = tinit;
+    for (i = 1; i <= dim; i++)
+        output->data[i * outputlen] = y[i - 1];
+    count = 1;
+    tintp = tinit + deltat;
+
+    /* Compute derivatives at the initial time, bail out if impossible. */
+    if ((status = integrator->dydt(t, y, k[0], params)) != GSL_SUCCESS) {
+        integrator->returncode = status;
+        errnum = XLAL_EFAILED;
+        goto bail_out;
+    }
+
+    while (1) {
+
+        if (!integrator->stopontestonly && t >= tend)
+            break;
+
+        if (integrator->stop) {
+            if ((status = integrator->stop(t, y, k[0], params)) != GSL_SUCCESS) {
+                integrator->returncode = status;
+                break;
+            }
+        }
+
+        /* Take a step, reducing it until the error estimate is acceptable. */
+        while (1) {
+            hstep = (t + h > tend) ? tend - t : h;
+
+            status = dormandPrinceStep(integrator, params, t, hstep, y, k, ytmp, ynew, yerr);
+
+            /* Check for failure, retry if haven't retried too many times
+             * already. */
+            if (status != GSL_SUCCESS) {
+                if (retries--) {
+                    /* Retries to spare; reduce h, try again. */
+                    h = hstep / 10.0;
+                    continue;
+                } else {
+                    /* Out of retries, bail with status code. */
+                    integrator->returncode = status;
+                    break;
+                }
+            } else {
+                /* Successful step, reset retry counter. */
+                retries = integrator->retries;
+            }
+
+            h = hstep;
+            if (dormandPrinceAdjust(integrator, ynew, yerr, &h) != GSL_ODEIV_HADJ_DEC)
+                break;
+        }
+        if (status != GSL_SUCCESS)
+            break;
+
+        /* Evaluate the continuous extension at all sample times within
+         * the step, y(t + theta*hstep) = y + theta*(r2 + (1-theta)*(r3 +
+         * theta*(r4 + (1-theta)*r5))). */
+        if (tintp <= t + hstep) {
+            for (i = 0; i < dim; i++) {
+                r2[i] = ynew[i] - y[i];
+                r3[i] = hstep * k[0][i] - r2[i];
+                r4[i] = r2[i] - hstep * k[6][i] - r3[i];
+                r5[i] = hstep * (dp_d1 * k[0][i] + dp_d3 * k[2][i] + dp_d4 * k[3][i] + dp_d5 * k[4][i] + dp_d6 * k[5][i] + dp_d7 * k[6][i]);
+            }
+
+            while (tintp <= t + hstep) {
+                const REAL8 theta = (tintp - t) / hstep;
+                const REAL8 theta1 = 1.0 - theta;
+
+                for (i = 0; i < dim; i++)
+                    ytmp[i] = y[i] + theta * (r2[i] + theta1 * (r3[i] + theta * (r4[i] + theta1 * r5[i])));
+
+                /* Store the interpolated value in the output array. */
+                count++;
+                if ((status = storeStateInOutput(&output, tintp, ytmp, dim, &outputlen, count)) == XLAL_ENOMEM) {
+                    errnum = XLAL_ENOMEM;
+                    goto bail_out;
+                }
+                tintp = tinit + count * deltat;
+            }
+        }
+
+        /* Accept the step; the last stage is the derivative at its end. */
+        t += hstep;
+        memcpy(y, ynew, dim * sizeof(REAL8));
+        memcpy(k[0], k[6], dim * sizeof(REAL8));
+        integrator->hlast = h;
+    }
+
+    /* Copy the final state into yinit. */
+    memcpy(yinit, y, dim * sizeof(REAL8));
+
+    /* Close up the rows of the output array, in place, to exactly count
+     * samples. */
+    for (i = 1; i <= dim; i++)
+        memmove(&output->data[i * count], &output->data[i * outputlen], count * sizeof(REAL8));
+    output->dimLength->data[1] = count;
+
+  bail_out:
+
+    XLAL_ENDGSL;
+
+    if (errnum) {
+        if (allocated) {
+            XLALDestroyREAL8Array(output);
+            output = NULL;
+        }
+        *yout = output;
+        XLAL_ERROR(errnum);
+    }
+
+    *yout = output;
+    return count;
+}
+
 /**
  * Fourth-order Runge-Kutta ODE integrator using Runge-Kutta-Fehlberg (RKF45)
  * steps with adaptive step size control.  Intended for use in Fourier domain
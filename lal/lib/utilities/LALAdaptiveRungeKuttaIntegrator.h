@@ -63,6 +63,12 @@ typedef struct tagLALAdaptiveRungeKuttaIntegrator
   int stopontestonly;	/* stop only on test, use tend to size buffers only */
 
   int returncode;
+
+  /* Dormand-Prince stepper used by XLALAdaptiveRungeKuttaDenseOutput();
+   * only set up by XLALAdaptiveRungeKuttaDormandPrinceInit() */
+  double *dpwork;	/* stages and dense-output coefficients, 15*dim */
+  double eps_abs, eps_rel;	/* error tolerances of the step control */
+  double hlast;		/* last accepted step, used as first trial step of the next call */
 } LALAdaptiveRungeKuttaIntegrator;
 
 LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4Init( int dim,
@@ -85,6 +91,20 @@ LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4InitEighthOrderInstead(
                              );
 /* END OPTIMIZED */
 
+/**
+ * Fifth-order Runge-Kutta ODE integrator using Dormand-Prince steps with
+ * adaptive step size control and a native continuous extension.  Intended
+ * for use with XLALAdaptiveRungeKuttaDenseOutput() in time domain waveform
+ * generation routines based on SEOBNR models.  The integrator carries its
+ * own work space and may be reused for any number of integrations of
+ * systems of the same dimension.
+ */
+LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKuttaDormandPrinceInit( int dim,
+                             int (* dydt) (double t, const double y[], double dydt[], void * params),
+                             int (* stop) (double t, const double y[], double dydt[], void * params),
+                             double eps_abs, double eps_rel
+                             );
+
 void XLALAdaptiveRungeKuttaFree( LALAdaptiveRungeKuttaIntegrator *integrator );
 
 int XLALAdaptiveRungeKutta4( LALAdaptiveRungeKuttaIntegrator *integrator,
@@ -119,6 +139,15 @@ int XLALAdaptiveRungeKutta4Hermite( LALAdaptiveRungeKuttaIntegrator *integrator,
                                     REAL8Array **yout
                                     );
 
+int XLALAdaptiveRungeKuttaDenseOutput( LALAdaptiveRungeKuttaIntegrator *integrator,
+                                       void *params,
+                                       REAL8 *yinit,
+                                       REAL8 tinit,
+                                       REAL8 tend,
+                                       REAL8 deltat,
+                                       REAL8Array **yout
+                                       );
+
 /**
  * Fourth-order Runge-Kutta ODE integrator using Runge-Kutta-Fehlberg (RKF45)
  * steps with adaptive step size control.  Intended for use in Fourier domain
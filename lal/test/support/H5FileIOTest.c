@@ -5,6 +5,7 @@ int main(void) { return 77; /* don't do any testing */ }
 #else
 
 #include <limits.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <lal/LALStdlib.h>
@@ -291,6 +292,99 @@ DEFINE_FREQUENCY_SERIES_FUNCTIONS(COMPLEX8FrequencySeries)
 DEFINE_FREQUENCY_SERIES_FUNCTIONS(COMPLEX16FrequencySeries)
 #undef GENERATE_DATA
 
+/* TABLE ROUTINES */
+
+#define TABLE "testtable"
+
+struct table_row {
+	INT4 index;
+	REAL8 value;
+};
+
+static const char *table_cols[] = { "index", "value" };
+static const LALTYPECODE table_types[] = { LAL_I4_TYPE_CODE, LAL_D_TYPE_CODE };
+static const size_t table_offsets[] = { offsetof(struct table_row, index), offsetof(struct table_row, value) };
+static const size_t table_sizes[] = { sizeof(INT4), sizeof(REAL8) };
+
+static void fill_table_rows(struct table_row *rows, size_t first, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; ++i) {
+		rows[i].index = first + i;
+		rows[i].value = 0.25 * (first + i);
+	}
+}
+
+static int check_table(LALH5Dataset *dset, size_t nrows)
+{
+	struct table_row rows[16];
+	size_t i;
+	if (XLALH5TableQueryNRows(dset) != nrows || nrows > 16)
+		return 1;
+	XLALH5TableRead(rows, dset, table_offsets, table_sizes, sizeof(*rows));
+	for (i = 0; i < nrows; ++i)
+		if (rows[i].index != (INT4)i || rows[i].value != 0.25 * i)
+			return 1;
+	return 0;
+}
+
+static void test_table_append(void)
+{
+	struct table_row rows[16];
+	LALH5File *file;
+	LALH5File *group;
+	LALH5Dataset *dset;
+
+	fprintf(stderr, "Testing Append/Flush/Truncate of tables...");
+
+	/* create a chunked, compressed table and append in several pieces,
+	 * flushing the file in between */
+	file = XLALH5FileOpen(FNAME, "w");
+	group = XLALH5GroupOpen(file, GROUP);
+	dset = XLALH5TableAllocChunked(group, TABLE, 2, table_cols, table_types, table_offsets, sizeof(*rows), 4, 1);
+	fill_table_rows(rows, 0, 6);
+	XLALH5TableAppend(dset, table_offsets, table_sizes, 6, sizeof(*rows), rows);
+	if (XLALH5FileFlush(file) != XLAL_SUCCESS || check_table(dset, 6)) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+	fill_table_rows(rows, 6, 5);
+	XLALH5TableAppend(dset, table_offsets, table_sizes, 5, sizeof(*rows), rows);
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(group);
+	XLALH5FileClose(file);
+
+	/* reopen for appending, discard the last rows and write new ones */
+	file = XLALH5FileOpen(FNAME, "a");
+	dset = XLALH5DatasetRead(file, GROUP "/" TABLE);
+	if (check_table(dset, 11)) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+	XLALH5TableTruncate(dset, 7);
+	if (check_table(dset, 7)) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+	fill_table_rows(rows, 7, 3);
+	XLALH5TableAppend(dset, table_offsets, table_sizes, 3, sizeof(*rows), rows);
+	XLALH5FileFlush(file);
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(file);
+
+	/* read back; flushing a read-only file does nothing */
+	file = XLALH5FileOpen(FNAME, "r");
+	dset = XLALH5DatasetRead(file, GROUP "/" TABLE);
+	if (XLALH5FileFlush(file) != XLAL_SUCCESS || check_table(dset, 10)) {
+		fprintf(stderr, " FAIL\n");
+		exit(1); /* fail */
+	}
+	XLALH5DatasetFree(dset);
+	XLALH5FileClose(file);
+
+	fprintf(stderr, " PASS\n");
+}
+
 int main(void)
 {
 	XLALSetErrorHandler(XLALAbortErrorHandler);
@@ -334,6 +428,8 @@ int main(void)
 	test_COMPLEX8FrequencySeries();
 	test_COMPLEX16FrequencySeries();
 
+	test_table_append();
+
 	LALCheckMemoryLeaks();
 	return 0;
 }
@@ -0,0 +1,255 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALString.h>
+#include <lal/FileIO.h>
+#include <lal/LALCache.h>
+
+#define FNAME "LALCacheTest.cache"
+
+/* a cache of n entries with few distinct sources, descriptions and start
+ * times, so that there are many ties; the url records the original
+ * position of each entry, and the same seed gives the same cache */
+static LALCache *make_cache(UINT4 n, int overlap, unsigned seed)
+{
+    const char *src[] = { "H", "L", "V" };
+    const char *dsc[] = { "R", "C00", NULL };
+    LALCache *cache;
+    UINT4 i;
+
+    srand(seed);
+    cache = XLALCreateCache(n);
+    XLAL_CHECK_NULL(cache, XLAL_EFUNC);
+    for (i = 0; i < n; ++i) {
+        LALCacheEntry *entry = cache->list + i;
+        const char *d = dsc[rand() % 3];
+        entry->src = XLALStringDuplicate(src[rand() % 3]);
+        entry->dsc = d ? XLALStringDuplicate(d) : NULL;
+        entry->t0 = 1000000000 + 16 * (rand() % 200);
+        entry->dt = overlap ? 16 * (1 + rand() % 8) : 16;
+        entry->url = XLALStringAppendFmt(NULL, "file://localhost/data/%u.gwf", i);
+        XLAL_CHECK_NULL(entry->src && (entry->dsc || !d) && entry->url, XLAL_EFUNC);
+    }
+    return cache;
+}
+
+/* position of an entry in the unsorted cache, from its url */
+static UINT4 position(const LALCacheEntry *entry)
+{
+    return strtoul(strrchr(entry->url, '/') + 1, NULL, 10);
+}
+
+static int compare_metadata(const LALCacheEntry *a, const LALCacheEntry *b)
+{
+    int c;
+    if ((c = strcmp(a->src ? a->src : "", b->src ? b->src : "")))
+        return c;
+    if ((c = strcmp(a->dsc ? a->dsc : "", b->dsc ? b->dsc : "")))
+        return c;
+    if (a->t0 != b->t0)
+        return a->t0 < b->t0 ? -1 : 1;
+    if (a->dt != b->dt)
+        return a->dt < b->dt ? -1 : 1;
+    return 0;
+}
+
+/* a stable order: ties are broken by the original position */
+static int compare_stable(const void *p1, const void *p2)
+{
+    const LALCacheEntry *a = p1;
+    const LALCacheEntry *b = p2;
+    int c = compare_metadata(a, b);
+    if (c)
+        return c;
+    return (position(a) > position(b)) - (position(a) < position(b));
+}
+
+static int compare_caches(const LALCache *cache1, const LALCache *cache2)
+{
+    UINT4 i;
+    XLAL_CHECK(cache1->length == cache2->length, XLAL_EFAILED, "caches have %u and %u entries", cache1->length, cache2->length);
+    for (i = 0; i < cache1->length; ++i) {
+        const LALCacheEntry *a = cache1->list + i;
+        const LALCacheEntry *b = cache2->list + i;
+        XLAL_CHECK(compare_metadata(a, b) == 0 && strcmp(a->url, b->url) == 0, XLAL_EFAILED, "caches differ at entry %u: %s and %s", i, a->url, b->url);
+    }
+    return 0;
+}
+
+/* XLALCacheSort() gives the order of a stable qsort() */
+static int test_sort(UINT4 n)
+{
+    LALCache *cache;
+    LALCache *ref;
+
+    cache = make_cache(n, 1, n);
+    XLAL_CHECK(cache, XLAL_EFUNC);
+    ref = XLALCacheDuplicate(cache);
+    XLAL_CHECK(ref, XLAL_EFUNC);
+    qsort(ref->list, ref->length, sizeof(*ref->list), compare_stable);
+
+    XLAL_CHECK(XLALCacheSort(cache) == 0, XLAL_EFUNC);
+    XLAL_CHECK(compare_caches(cache, ref) == 0, XLAL_EFUNC, "sort of %u entries", n);
+
+    /* sorting again changes nothing */
+    XLAL_CHECK(XLALCacheSort(cache) == 0, XLAL_EFUNC);
+    XLAL_CHECK(compare_caches(cache, ref) == 0, XLAL_EFUNC, "second sort of %u entries", n);
+
+    /* the export of an unsorted cache is read back sorted */
+    XLALDestroyCache(cache);
+    cache = make_cache(n, 1, n);
+    XLAL_CHECK(cache, XLAL_EFUNC);
+    XLAL_CHECK(XLALCacheExport(cache, FNAME) == 0, XLAL_EFUNC);
+    XLALDestroyCache(cache);
+    cache = XLALCacheImport(FNAME);
+    XLAL_CHECK(cache, XLAL_EFUNC);
+    XLAL_CHECK(compare_caches(cache, ref) == 0, XLAL_EFUNC, "import of %u entries", n);
+
+    XLALDestroyCache(ref);
+    XLALDestroyCache(cache);
+    return 0;
+}
+
+/* comments are skipped; bad rows are errors */
+static int test_read(void)
+{
+    LALCache *cache;
+    LALFILE *fp;
+    int errnum;
+
+    fp = XLALFileOpen(FNAME, "w");
+    XLAL_CHECK(fp, XLAL_EIO);
+    XLALFilePrintf(fp, "# a comment\n");
+    XLALFilePrintf(fp, "L R 1000000016 16 file://localhost/data/1.gwf\n");
+    XLALFilePrintf(fp, "H - - - file://localhost/data/0.gwf\n");
+    XLALFileClose(fp);
+    cache = XLALCacheImport(FNAME);
+    XLAL_CHECK(cache, XLAL_EFUNC);
+    XLAL_CHECK(cache->length == 2, XLAL_EFAILED, "read %u entries, expected 2", cache->length);
+    XLAL_CHECK(strcmp(cache->list[0].src, "H") == 0 && cache->list[0].dsc == NULL && cache->list[0].t0 == 0 && cache->list[0].dt == 0, XLAL_EFAILED, "wrong first entry");
+    XLAL_CHECK(strcmp(cache->list[1].src, "L") == 0 && cache->list[1].t0 == 1000000016 && cache->list[1].dt == 16, XLAL_EFAILED, "wrong second entry");
+    XLALDestroyCache(cache);
+
+    fp = XLALFileOpen(FNAME, "w");
+    XLAL_CHECK(fp, XLAL_EIO);
+    XLALFilePrintf(fp, "L R 1000000016 16 file://localhost/data/1.gwf\n");
+    XLALFilePrintf(fp, "L R 1000000032\n");
+    XLALFileClose(fp);
+    XLAL_TRY_SILENT(cache = XLALCacheImport(FNAME), errnum);
+    XLAL_CHECK(cache == NULL && errnum, XLAL_EFAILED, "malformed cache file was read");
+    return 0;
+}
+
+/* XLALCacheIndexFind() agrees with a linear scan of the cache */
+static int test_index(UINT4 n, int overlap)
+{
+    const char *src[] = { "H", "L", "V", "X" };
+    const char *dsc[] = { "R", "C00", NULL };
+    LALCacheIndex *index;
+    LALCache *cache;
+    LALCache *unsorted;
+    int errnum;
+    UINT4 q;
+
+    cache = make_cache(n, overlap, n);
+    XLAL_CHECK(cache, XLAL_EFUNC);
+
+    /* the cache must be sorted */
+    if (n > 1) {
+        unsorted = make_cache(n, overlap, n + 1);
+        XLAL_CHECK(unsorted, XLAL_EFUNC);
+        XLAL_TRY_SILENT(index = XLALCreateCacheIndex(unsorted), errnum);
+        XLAL_CHECK(index == NULL && errnum == XLAL_EINVAL, XLAL_EFAILED, "unsorted cache was indexed");
+        XLALDestroyCache(unsorted);
+    }
+
+    XLAL_CHECK(XLALCacheSort(cache) == 0, XLAL_EFUNC);
+    index = XLALCreateCacheIndex(cache);
+    XLAL_CHECK(index, XLAL_EFUNC);
+
+    for (q = 0; q < 2000; ++q) {
+        const char *s = src[rand() % 4];
+        const char *d = dsc[rand() % 3];
+        INT4 t0 = rand() % 8 ? 1000000000 + rand() % 3400 - 50 : 0;
+        INT4 t1 = rand() % 8 ? t0 + rand() % 400 : 0;
+        LALCacheEntry *view;
+        UINT4 length;
+        UINT4 nmatch = 0;
+        UINT4 i;
+
+        view = XLALCacheIndexFind(index, s, d, t0, t1, &length);
+        XLAL_CHECK(view || length == 0, XLAL_EFAILED, "no view but %u entries", length);
+        XLAL_CHECK(!view || (view >= cache->list && view + length <= cache->list + cache->length), XLAL_EFAILED, "view outside the cache");
+
+        for (i = 0; i < cache->length; ++i) {
+            const LALCacheEntry *entry = cache->list + i;
+            int group = strcmp(entry->src, s) == 0 && strcmp(entry->dsc ? entry->dsc : "", d ? d : "") == 0;
+            int match = group && (t1 <= 0 || entry->t0 < t1) && (t0 <= 0 || entry->t0 + entry->dt > t0);
+            int inview = view && entry >= view && entry < view + length;
+            if (match) {
+                XLAL_CHECK(inview, XLAL_EFAILED, "query %s-%s [%d, %d): matching entry %s is not in the view", s, d ? d : "-", t0, t1, entry->url);
+                ++nmatch;
+            } else if (inview) {
+                /* only entries nested in earlier entries of the group and
+                 * ending before t0 may be in the view without matching */
+                XLAL_CHECK(group && overlap && t0 > 0 && entry->t0 + entry->dt <= t0 && (t1 <= 0 || entry->t0 < t1), XLAL_EFAILED, "query %s-%s [%d, %d): entry %s is in the view", s, d ? d : "-", t0, t1, entry->url);
+            }
+        }
+        if (!overlap)
+            XLAL_CHECK(length == nmatch, XLAL_EFAILED, "query %s-%s [%d, %d): view of %u entries, %u match", s, d ? d : "-", t0, t1, length, nmatch);
+    }
+
+    /* missing arguments */
+    {
+        UINT4 length;
+        LALCacheEntry *view;
+        XLAL_TRY_SILENT(view = XLALCacheIndexFind(index, "H", "R", 0, 0, NULL), errnum);
+        XLAL_CHECK(view == NULL && errnum == XLAL_EFAULT, XLAL_EFAILED, "missing length accepted");
+        XLAL_TRY_SILENT(view = XLALCacheIndexFind(NULL, "H", "R", 0, 0, &length), errnum);
+        XLAL_CHECK(view == NULL && errnum == XLAL_EFAULT, XLAL_EFAILED, "missing index accepted");
+    }
+
+    XLALDestroyCacheIndex(index);
+    XLALDestroyCache(cache);
+    return 0;
+}
+
+int main(void)
+{
+    /* both the insertion sort of short caches and the merge sort */
+    XLAL_CHECK_MAIN(test_sort(1) == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_sort(15) == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_sort(16) == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_sort(1000) == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_sort(20011) == 0, XLAL_EFUNC);
+
+    XLAL_CHECK_MAIN(test_read() == 0, XLAL_EFUNC);
+
+    XLAL_CHECK_MAIN(test_index(0, 1) == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_index(1, 1) == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_index(500, 0) == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_index(500, 1) == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_index(5000, 1) == 0, XLAL_EFUNC);
+
+    remove(FNAME);
+    LALCheckMemoryLeaks();
+    return 0;
+}
@@ -54,6 +54,7 @@
 #include <lal/LALStdlib.h>
 #include <lal/Segments.h>
 #include <lal/Date.h>
+#include <lal/LogPrintf.h>
 
 /** \cond DONT_DOXYGEN */
 
@@ -1230,6 +1231,169 @@ int main( int argc, char *argv[] )
   XLALPrintInfo("Passed XLALSegListRange tests\n");
 
 
+  /*-------------------------------------------------------------------------*/
+  XLALPrintInfo("\n========== Segment list set operation tests \n");
+  /*-------------------------------------------------------------------------*/
+
+  {
+    /* a = { [0,2) [2,4) [6,9) [12,12) }, b = { [1,3) [5,7) [7,8) [10,13) } */
+    const INT4 sa[][2] = { {0,2}, {2,4}, {6,9}, {12,12} };
+    const INT4 sb[][2] = { {1,3}, {5,7}, {7,8}, {10,13} };
+    const INT4 sunion[][2] = { {0,4}, {5,9}, {10,13} };
+    const INT4 sinter[][2] = { {1,3}, {6,8} };
+    const INT4 sdiff[][2] = { {0,1}, {3,4}, {8,9} };
+    LALSegList a, b, result;
+    LIGOTimeGPS start, end;
+
+    XLAL_CHECK( XLALSegListInit(&a) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListInit(&b) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListInit(&result) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( UINT4 i = 0; i < 4; ++i ) {
+      XLALGPSSet( &start, 800000000 + sa[i][0], 0 );
+      XLALGPSSet( &end, 800000000 + sa[i][1], 0 );
+      XLAL_CHECK( XLALSegSet(&seg, &start, &end, i) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALSegListAppend(&a, &seg) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALGPSSet( &start, 800000000 + sb[i][0], 0 );
+      XLALGPSSet( &end, 800000000 + sb[i][1], 0 );
+      XLAL_CHECK( XLALSegSet(&seg, &start, &end, i) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALSegListAppend(&b, &seg) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+
+#define CHECK_SEGLIST(l, expect) do { \
+      XLAL_CHECK( (l).length == XLAL_NUM_ELEM(expect) && (l).sorted && (l).disjoint, XLAL_EFAILED ); \
+      for ( UINT4 k = 0; k < (l).length; ++k ) { \
+        XLAL_CHECK( (l).segs[k].start.gpsSeconds == 800000000 + (expect)[k][0], XLAL_EFAILED ); \
+        XLAL_CHECK( (l).segs[k].end.gpsSeconds == 800000000 + (expect)[k][1], XLAL_EFAILED ); \
+      } \
+    } while (0)
+
+    XLALPrintInfo("Check XLALSegListUnion() ...\n");
+    XLAL_CHECK( XLALSegListUnion(&result, &a, &b) == XLAL_SUCCESS, XLAL_EFUNC );
+    CHECK_SEGLIST( result, sunion );
+    XLALPrintInfo("Check XLALSegListIntersection() ...\n");
+    XLAL_CHECK( XLALSegListIntersection(&result, &a, &b) == XLAL_SUCCESS, XLAL_EFUNC );
+    CHECK_SEGLIST( result, sinter );
+    XLALPrintInfo("Check XLALSegListDifference() ...\n");
+    XLAL_CHECK( XLALSegListDifference(&result, &a, &b) == XLAL_SUCCESS, XLAL_EFUNC );
+    CHECK_SEGLIST( result, sdiff );
+
+#undef CHECK_SEGLIST
+
+    XLALPrintInfo("Check that set operations fail for unsorted or aliased lists ...\n");
+    XLAL_CHECK( XLALSegListAppend(&b, &a.segs[0]) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_TRY( XLALSegListUnion(&result, &a, &b), status );
+    XLAL_CHECK( status != 0, XLAL_EFAILED );
+    XLAL_TRY( XLALSegListUnion(&a, &a, &result), status );
+    XLAL_CHECK( status != 0, XLAL_EFAILED );
+
+    XLALPrintInfo("Check XLALSegListSearchSorted() and XLALSegTreeOverlaps() against XLALSegListSearch() ...\n");
+    XLAL_CHECK( XLALSegListCoalesce(&a) == XLAL_SUCCESS, XLAL_EFUNC );
+    {
+      LIGOTimeGPS times[64];
+      LALSeg *found[64];
+      UINT4 indx[8];
+      LALSegTree *tree;
+      for ( UINT4 i = 0; i < 64; ++i ) {
+        XLALGPSSet( &times[i], 800000000 - 1 + i / 4, 250000000 * (i % 4) );
+      }
+      XLAL_CHECK( XLALSegListSearchSorted(&a, times, 64, found) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( (tree = XLALSegTreeCreate(&b)) != NULL, XLAL_EFUNC );
+      for ( UINT4 i = 0; i < 64; ++i ) {
+        long n, nexpect = 0;
+        XLAL_CHECK( found[i] == XLALSegListSearch(&a, &times[i]), XLAL_EFAILED );
+        n = XLALSegTreeOverlaps(tree, &times[i], &times[i], indx, XLAL_NUM_ELEM(indx));
+        XLAL_CHECK( n >= 0, XLAL_EFUNC );
+        for ( UINT4 j = 0; j < b.length; ++j ) {
+          if ( XLALGPSInSeg(&times[i], &b.segs[j]) == 0 ) {
+            long k = 0;
+            while ( k < n && indx[k] != j ) {
+              ++k;
+            }
+            XLAL_CHECK( k < n, XLAL_EFAILED );
+            ++nexpect;
+          }
+        }
+        XLAL_CHECK( n == nexpect, XLAL_EFAILED );
+      }
+      XLALSegTreeDestroy(tree);
+    }
+
+    XLAL_CHECK( XLALSegListClear(&a) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListClear(&b) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListClear(&result) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  }
+  XLALPrintInfo("Passed segment list set operation tests\n");
+
+  /* Time the set operations and searches on big segment lists */
+  {
+    LALSegList a, b, result;
+    LIGOTimeGPS *times;
+    LALSeg **found;
+    LALSegTree *tree;
+    REAL8 tic;
+    long n = 0;
+
+    XLALPrintInfo( "\nTiming set operations on segment lists with %d segments...\n",
+		   nbigsize );
+    XLAL_CHECK( XLALSegListInit(&a) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListInit(&b) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListInit(&result) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( (times = XLALMalloc(nbigsize * sizeof(*times))) != NULL, XLAL_ENOMEM );
+    XLAL_CHECK( (found = XLALMalloc(nbigsize * sizeof(*found))) != NULL, XLAL_ENOMEM );
+    for ( iseg = 0; iseg < nbigsize; iseg++ ) {
+      /* a = { [2i, 2i+1) }, b = { [2i+0.5, 2i+1.5) } */
+      XLALGPSSet( &time1, 800000000 + 2*iseg, 0 );
+      XLALGPSSet( &time2, 800000000 + 2*iseg + 1, 0 );
+      XLAL_CHECK( XLALSegSet(&seg, &time1, &time2, iseg) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALSegListAppend(&a, &seg) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALGPSSet( &time1, 800000000 + 2*iseg, 500000000 );
+      XLALGPSSet( &time2, 800000000 + 2*iseg + 1, 500000000 );
+      XLAL_CHECK( XLALSegSet(&seg, &time1, &time2, iseg) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALSegListAppend(&b, &seg) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLALGPSSet( &times[iseg], 800000000 + 2*iseg, 250000000 );
+    }
+
+    tic = XLALGetTimeOfDay();
+    XLAL_CHECK( XLALSegListUnion(&result, &a, &b) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( result.length == (UINT4) nbigsize, XLAL_EFAILED );
+    XLALPrintInfo( "XLALSegListUnion(): %g s\n", XLALGetTimeOfDay() - tic );
+    tic = XLALGetTimeOfDay();
+    XLAL_CHECK( XLALSegListIntersection(&result, &a, &b) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( result.length == (UINT4) nbigsize, XLAL_EFAILED );
+    XLALPrintInfo( "XLALSegListIntersection(): %g s\n", XLALGetTimeOfDay() - tic );
+    tic = XLALGetTimeOfDay();
+    XLAL_CHECK( XLALSegListDifference(&result, &a, &b) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( result.length == (UINT4) nbigsize, XLAL_EFAILED );
+    XLALPrintInfo( "XLALSegListDifference(): %g s\n", XLALGetTimeOfDay() - tic );
+
+    tic = XLALGetTimeOfDay();
+    XLAL_CHECK( XLALSegListSearchSorted(&a, times, nbigsize, found) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALPrintInfo( "XLALSegListSearchSorted() of %d times: %g s\n", nbigsize, XLALGetTimeOfDay() - tic );
+    tic = XLALGetTimeOfDay();
+    for ( iseg = 0; iseg < nbigsize; iseg++ ) {
+      a.lastFound = NULL;
+      XLAL_CHECK( XLALSegListSearch(&a, &times[iseg]) == found[iseg], XLAL_EFAILED );
+    }
+    XLALPrintInfo( "XLALSegListSearch() of %d times: %g s\n", nbigsize, XLALGetTimeOfDay() - tic );
+
+    tic = XLALGetTimeOfDay();
+    XLAL_CHECK( (tree = XLALSegTreeCreate(&a)) != NULL, XLAL_EFUNC );
+    for ( iseg = 0; iseg < nbigsize; iseg++ ) {
+      n += XLALSegTreeOverlaps(tree, &times[iseg], &times[iseg], NULL, 0);
+    }
+    XLAL_CHECK( n == nbigsize, XLAL_EFAILED );
+    XLALPrintInfo( "XLALSegTreeCreate() and XLALSegTreeOverlaps() of %d times: %g s\n", nbigsize, XLALGetTimeOfDay() - tic );
+    XLALSegTreeDestroy(tree);
+
+    XLALFree(times);
+    XLALFree(found);
+    XLAL_CHECK( XLALSegListClear(&a) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListClear(&b) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListClear(&result) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+
   /*-------------------------------------------------------------------------*/
   /* Clean up leftover seg lists */
   if ( seglist1.segs ) { XLALSegListClear( &seglist1 ); }
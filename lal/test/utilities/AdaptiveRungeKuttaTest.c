@@ -0,0 +1,151 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <lal/XLALError.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/LALAdaptiveRungeKuttaIntegrator.h>
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+/* harmonic oscillator, y0' = y1, y1' = -y0, with solution (cos t, -sin t) */
+static int dydt( double UNUSED t, const double y[], double dy[], void UNUSED *params )
+{
+  dy[0] = y[1];
+  dy[1] = -y[0];
+  return GSL_SUCCESS;
+}
+
+/* stop once the time passed in params has been reached */
+static int stop( double t, const double UNUSED y[], double UNUSED dy[], void *params )
+{
+  return t >= *( ( double * ) params ) ? 1 : GSL_SUCCESS;
+}
+
+/* largest deviation of an output array from the exact solution */
+static double max_error( const REAL8Array *out, int len )
+{
+  double err = 0.0;
+  for ( int j = 0; j < len; ++j ) {
+    const double t = out->data[j];
+    err = fmax( err, fabs( out->data[len + j] - cos( t ) ) );
+    err = fmax( err, fabs( out->data[2 * len + j] + sin( t ) ) );
+  }
+  return err;
+}
+
+int main( void )
+{
+  const double tinit = 0.0, tend = 20.0, deltat = 0.01;
+  const double eps = 1e-10;
+  double tstop = 1.0 / 0.0;
+  LALAdaptiveRungeKuttaIntegrator *integrator = NULL, *rk4 = NULL;
+  REAL8Array *dense = NULL, *ref = NULL, *again = NULL, *supplied = NULL;
+  double y[2];
+  int len, reflen, againlen, supplen, errnum;
+
+  /* Dormand-Prince dense output against the exact solution */
+  integrator = XLALAdaptiveRungeKuttaDormandPrinceInit( 2, dydt, stop, eps, eps );
+  XLAL_CHECK_MAIN( integrator != NULL, XLAL_EFUNC );
+  y[0] = 1.0;
+  y[1] = 0.0;
+  len = XLALAdaptiveRungeKuttaDenseOutput( integrator, &tstop, y, tinit, tend, deltat, &dense );
+  XLAL_CHECK_MAIN( len > 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( len == ( int ) dense->dimLength->data[1], XLAL_EFAILED, "output has %u columns, returned %i", dense->dimLength->data[1], len );
+  XLAL_CHECK_MAIN( len == ( int ) round( ( tend - tinit ) / deltat ) + 1, XLAL_EFAILED, "got %i samples", len );
+  for ( int j = 0; j < len; ++j ) {
+    XLAL_CHECK_MAIN( fabs( dense->data[j] - ( tinit + j * deltat ) ) < 1e-9, XLAL_EFAILED, "sample %i is at t=%g", j, dense->data[j] );
+  }
+  XLAL_CHECK_MAIN( max_error( dense, len ) < 1e-7, XLAL_EFAILED, "dense output error %g", max_error( dense, len ) );
+  printf( "Dormand-Prince dense output: %i samples, max error %g\n", len, max_error( dense, len ) );
+
+  /* same sample times and comparable accuracy as the interpolating RK4 integrator */
+  rk4 = XLALAdaptiveRungeKutta4Init( 2, dydt, stop, eps, eps );
+  XLAL_CHECK_MAIN( rk4 != NULL, XLAL_EFUNC );
+  y[0] = 1.0;
+  y[1] = 0.0;
+  reflen = XLALAdaptiveRungeKutta4( rk4, &tstop, y, tinit, tend, deltat, &ref );
+  XLAL_CHECK_MAIN( reflen > 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( reflen == len, XLAL_EFAILED, "RK4 gave %i samples, dense output %i", reflen, len );
+  for ( int j = 0; j < len; ++j ) {
+    XLAL_CHECK_MAIN( fabs( ref->data[j] - dense->data[j] ) < 1e-9, XLAL_EFAILED, "sample %i: t=%g vs %g", j, ref->data[j], dense->data[j] );
+    for ( int i = 1; i <= 2; ++i ) {
+      XLAL_CHECK_MAIN( fabs( ref->data[i * len + j] - dense->data[i * len + j] ) < 1e-6, XLAL_EFAILED,
+                       "sample %i, variable %i: %g vs %g", j, i, ref->data[i * len + j], dense->data[i * len + j] );
+    }
+  }
+  printf( "RK4 interpolated output: max error %g\n", max_error( ref, reflen ) );
+
+  /* the integrator can be reused and gives the same result */
+  y[0] = 1.0;
+  y[1] = 0.0;
+  againlen = XLALAdaptiveRungeKuttaDenseOutput( integrator, &tstop, y, tinit, tend, deltat, &again );
+  XLAL_CHECK_MAIN( againlen == len, XLAL_EFAILED, "reuse gave %i samples, first call %i", againlen, len );
+  XLAL_CHECK_MAIN( max_error( again, againlen ) < 1e-7, XLAL_EFAILED, "reused integrator error %g", max_error( again, againlen ) );
+
+  /* a caller-supplied array is filled and closed up in place */
+  supplied = XLALCreateREAL8ArrayL( 2, 3, len + 100 );
+  XLAL_CHECK_MAIN( supplied != NULL, XLAL_EFUNC );
+  REAL8 *supplied_data = supplied->data;
+  y[0] = 1.0;
+  y[1] = 0.0;
+  supplen = XLALAdaptiveRungeKuttaDenseOutput( integrator, &tstop, y, tinit, tend, deltat, &supplied );
+  XLAL_CHECK_MAIN( supplen == len, XLAL_EFAILED, "supplied array gave %i samples, expected %i", supplen, len );
+  XLAL_CHECK_MAIN( supplied->data == supplied_data, XLAL_EFAILED, "supplied array was reallocated" );
+  XLAL_CHECK_MAIN( supplied->dimLength->data[1] == ( UINT4 ) len, XLAL_EFAILED );
+  XLAL_CHECK_MAIN( max_error( supplied, supplen ) < 1e-7, XLAL_EFAILED, "supplied array error %g", max_error( supplied, supplen ) );
+
+  /* stopping on the test only */
+  XLALDestroyREAL8Array( dense );
+  dense = NULL;
+  tstop = 3.0;
+  integrator->stopontestonly = 1;
+  y[0] = 1.0;
+  y[1] = 0.0;
+  len = XLALAdaptiveRungeKuttaDenseOutput( integrator, &tstop, y, tinit, tend, deltat, &dense );
+  XLAL_CHECK_MAIN( len > 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( integrator->returncode == 1, XLAL_EFAILED, "return code %i", integrator->returncode );
+  XLAL_CHECK_MAIN( dense->data[len - 1] >= tstop - deltat && dense->data[len - 1] < tstop + 1.0, XLAL_EFAILED,
+                   "last sample at t=%g, stop at t=%g", dense->data[len - 1], tstop );
+  XLAL_CHECK_MAIN( max_error( dense, len ) < 1e-7, XLAL_EFAILED, "stopped output error %g", max_error( dense, len ) );
+  printf( "Stop test: %i samples, last at t=%g\n", len, dense->data[len - 1] );
+
+  /* invalid arguments */
+  XLAL_TRY_SILENT( XLALAdaptiveRungeKuttaDenseOutput( integrator, &tstop, y, tinit, tend, -deltat, &again ), errnum );
+  XLAL_CHECK_MAIN( errnum == XLAL_EINVAL, XLAL_EFAILED, "negative step size accepted" );
+  XLAL_TRY_SILENT( XLALAdaptiveRungeKuttaDenseOutput( rk4, &tstop, y, tinit, tend, deltat, &again ), errnum );
+  XLAL_CHECK_MAIN( errnum == XLAL_EFAULT, XLAL_EFAILED, "integrator without Dormand-Prince work space accepted" );
+
+  XLALDestroyREAL8Array( dense );
+  XLALDestroyREAL8Array( ref );
+  XLALDestroyREAL8Array( again );
+  XLALDestroyREAL8Array( supplied );
+  XLALAdaptiveRungeKuttaFree( integrator );
+  XLALAdaptiveRungeKuttaFree( rk4 );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
@@ -121,50 +121,74 @@ int copychannels(LALFrameUFrameH * frame, LALFrameUFrFile * frfile,
     size_t pos, const char *match)
 {
     LALFrameUFrTOC *toc;
+    LALFrameUFrChan **channels;
+    LALFrameUFrChan **work;
+    int *chantypes;
     size_t nadc, adc;
     size_t nproc, proc;
     size_t nsim, sim;
+    size_t nchan = 0;
+    size_t nwork = 0;
+    size_t chan;
 
     toc = XLALFrameUFrTOCRead(frfile);
+    nadc = XLALFrameUFrTOCQueryAdcN(toc);
+    nproc = XLALFrameUFrTOCQueryProcN(toc);
+    nsim = XLALFrameUFrTOCQuerySimN(toc);
 
-    /* loop over channels in input file */
+    channels = calloc(nadc + nproc + nsim + 1, sizeof(*channels));
+    work = calloc(nadc + nproc + nsim + 1, sizeof(*work));
+    chantypes = calloc(nadc + nproc + nsim + 1, sizeof(*chantypes));
+    if (!channels || !work || !chantypes)
+        abort();
+
+    /* loop over channels in input file; the file cannot be shared
+     * between threads, so the channels are read one after another */
 
-    nadc = XLALFrameUFrTOCQueryAdcN(toc);
     for (adc = 0; adc < nadc; ++adc) {
         const char *name;
-        LALFrameUFrChan *channel;
         name = XLALFrameUFrTOCQueryAdcName(toc, adc);
         if (match && strcmp(name, match))
             continue;   /*does not match */
-        channel = XLALFrameUFrChanRead(frfile, name, pos);
-        copychannel(frame, channel, ADC_CHAN_TYPE);
-        XLALFrameUFrChanFree(channel);
+        chantypes[nchan] = ADC_CHAN_TYPE;
+        channels[nchan++] = XLALFrameUFrChanRead(frfile, name, pos);
     }
 
-    nproc = XLALFrameUFrTOCQueryProcN(toc);
     for (proc = 0; proc < nproc; ++proc) {
         const char *name;
-        LALFrameUFrChan *channel;
         name = XLALFrameUFrTOCQueryProcName(toc, proc);
         if (match && strcmp(name, match))
             continue;   /*does not match */
-        channel = XLALFrameUFrChanRead(frfile, name, pos);
-        copychannel(frame, channel, PROC_CHAN_TYPE);
-        XLALFrameUFrChanFree(channel);
+        chantypes[nchan] = PROC_CHAN_TYPE;
+        channels[nchan++] = XLALFrameUFrChanRead(frfile, name, pos);
     }
 
-    nsim = XLALFrameUFrTOCQuerySimN(toc);
     for (sim = 0; sim < nsim; ++sim) {
         const char *name;
-        LALFrameUFrChan *channel;
         name = XLALFrameUFrTOCQuerySimName(toc, sim);
         if (match && strcmp(name, match))
             continue;   /*does not match */
-        channel = XLALFrameUFrChanRead(frfile, name, pos);
-        copychannel(frame, channel, SIM_CHAN_TYPE);
-        XLALFrameUFrChanFree(channel);
+        chantypes[nchan] = SIM_CHAN_TYPE;
+        channels[nchan++] = XLALFrameUFrChanRead(frfile, name, pos);
     }
 
+    /* decompress the channels in parallel; the copies are written
+     * uncompressed, as they always have been */
+    for (chan = 0; chan < nchan; ++chan)
+        if (channels[chan])
+            work[nwork++] = channels[chan];
+    XLALFrameUFrChanVectorExpandMulti(work, nwork);
+
+    /* add copies to the frame in their input order */
+    for (chan = 0; chan < nchan; ++chan)
+        if (channels[chan]) {
+            copychannel(frame, channels[chan], chantypes[chan]);
+            XLALFrameUFrChanFree(channels[chan]);
+        }
+
+    free(chantypes);
+    free(work);
+    free(channels);
     XLALFrameUFrTOCFree(toc);
     return 0;
 }
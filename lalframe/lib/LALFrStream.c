@@ -91,6 +91,21 @@
  * current frame stream position.  The frame stream can later be restored to
  * this position using XLALFrStreamSetpos().
  *
+ * If the #LAL_FR_STREAM_READAHEAD_MODE bit is set in the stream mode, a
+ * background thread opens the next few frame files of the stream (reading
+ * their tables of contents) and reads and decompresses the channels that
+ * have been read from the stream so far, so that the reader does not have
+ * to wait for I/O at file boundaries.  The number of files opened in
+ * advance is set with XLALFrStreamSetReadAheadDepth().  The time the reader
+ * has spent waiting for files to be opened is returned by
+ * XLALFrStreamGetStats().  Read-ahead needs a frame library that can be
+ * used from two threads at once (see XLALFrameUThreadSafe()); otherwise, or
+ * without pthread support, files are opened on demand as usual.
+ *
+ * A stream opened with XLALFrStreamCacheOpenIndex() keeps the times of all
+ * its frames in an index file, so that seeks do not need to open the frame
+ * files to find the requested time.
+ *
  * @{
  */
 
@@ -104,16 +119,262 @@ int gethostname(char *name, int len);
 #include <stdlib.h>
 #include <string.h>
 #include <lal/Date.h>
+#include <lal/LALConfig.h>
 #include <lal/LALStdio.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALString.h>
 #include <lal/LALCache.h>
 #include <lal/LALFrameIO.h>
 #include <lal/LALFrStream.h>
+#include <lal/LogPrintf.h>
+#include "LALFrStreamIndex_private.h"
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
 
 /* INTERNAL ROUTINES */
 /** @cond */
 
+/* default number of files opened in advance in read-ahead mode */
+#define LAL_FR_STREAM_READAHEAD_DEPTH 2
+
+/* Read-ahead state.  The queue holds the files fnum = head, ...,
+ * head + count - 1 of the stream cache; when busy is set the thread is
+ * opening file head + count.  Discarding the queue increments generation
+ * so that a file being opened at the time is thrown away.  All fields
+ * are protected by lock. */
+struct tagLALFrStreamReadAhead {
+    size_t depth;
+    size_t nchan;
+    char **chan;        /* channels to preload; never removed */
+#ifdef LAL_PTHREAD_LOCK
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int running;
+    int quit;
+    int busy;
+    int checksum;
+    UINT8 generation;
+    const LALCache *cache;
+    UINT4 head;
+    size_t count;
+    LALFrFile **files;
+#endif
+};
+
+static LALFrStreamReadAhead *XLALFrStreamReadAheadAlloc(void)
+{
+    LALFrStreamReadAhead *readahead;
+    readahead = LALCalloc(1, sizeof(*readahead));
+    if (!readahead)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    readahead->depth = LAL_FR_STREAM_READAHEAD_DEPTH;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_init(&readahead->lock, NULL);
+    pthread_cond_init(&readahead->cond, NULL);
+#endif
+    return readahead;
+}
+
+#ifdef LAL_PTHREAD_LOCK
+
+/* discard the queued files; called with the lock held */
+static void XLALFrStreamReadAheadDiscard(LALFrStreamReadAhead * readahead,
+    UINT4 head)
+{
+    while (readahead->count > 0)
+        XLALFrFileClose(readahead->files[--readahead->count]);
+    readahead->head = head;
+    ++readahead->generation;
+    pthread_cond_broadcast(&readahead->cond);
+    return;
+}
+
+/* open a frame file and preload the channels; called without the lock */
+static LALFrFile *XLALFrStreamReadAheadOpen(LALFrStreamReadAhead *
+    readahead, const char *url, int checksum)
+{
+    LALFrFile *file = NULL;
+    size_t nframe;
+    size_t pos;
+    size_t i;
+    int errnum;
+
+    XLAL_TRY(file = XLALFrFileOpenURL(url), errnum);
+    if (!file)
+        return NULL;    /* the reader will report the error */
+    if (checksum && !XLALFrFileCksumValid(file)) {
+        XLALFrFileClose(file);
+        return NULL;    /* the reader will report the error */
+    }
+
+    nframe = XLALFrFileQueryNFrame(file);
+    for (i = 0;; ++i) {
+        const char *chname;
+        pthread_mutex_lock(&readahead->lock);
+        chname = readahead->quit || i >= readahead->nchan ? NULL :
+            readahead->chan[i];
+        pthread_mutex_unlock(&readahead->lock);
+        if (!chname)
+            break;
+        /* failures are benign: the channel is then read on demand */
+        for (pos = 0; pos < nframe; ++pos) {
+            XLAL_TRY(XLALFrFilePreloadChan(file, chname, pos), errnum);
+            if (errnum)
+                break;
+        }
+    }
+    return file;
+}
+
+static void *XLALFrStreamReadAheadThread(void *arg)
+{
+    LALFrStreamReadAhead *readahead = arg;
+    XLALSetSilentErrorHandler();
+    pthread_mutex_lock(&readahead->lock);
+    while (!readahead->quit) {
+        UINT4 fnum = readahead->head + readahead->count;
+        if (readahead->count < readahead->depth
+            && fnum < readahead->cache->length) {
+            UINT8 generation = readahead->generation;
+            int checksum = readahead->checksum;
+            const char *url = readahead->cache->list[fnum].url;
+            LALFrFile *file;
+            readahead->busy = 1;
+            pthread_mutex_unlock(&readahead->lock);
+            file = XLALFrStreamReadAheadOpen(readahead, url, checksum);
+            pthread_mutex_lock(&readahead->lock);
+            readahead->busy = 0;
+            /* a failed open is queued as NULL so the reader retries it */
+            if (generation == readahead->generation && !readahead->quit)
+                readahead->files[readahead->count++] = file;
+            else
+                XLALFrFileClose(file);
+            pthread_cond_broadcast(&readahead->cond);
+        } else
+            pthread_cond_wait(&readahead->cond, &readahead->lock);
+    }
+    pthread_mutex_unlock(&readahead->lock);
+    return NULL;
+}
+
+#endif /* LAL_PTHREAD_LOCK */
+
+static void XLALFrStreamReadAheadStop(LALFrStreamReadAhead * readahead)
+{
+#ifdef LAL_PTHREAD_LOCK
+    if (readahead && readahead->running) {
+        pthread_mutex_lock(&readahead->lock);
+        readahead->quit = 1;
+        pthread_cond_broadcast(&readahead->cond);
+        pthread_mutex_unlock(&readahead->lock);
+        pthread_join(readahead->thread, NULL);
+        XLALFrStreamReadAheadDiscard(readahead, 0);
+        LALFree(readahead->files);
+        readahead->files = NULL;
+        readahead->running = 0;
+        readahead->quit = 0;
+    }
+#else
+    (void)readahead;
+#endif
+    return;
+}
+
+static int XLALFrStreamReadAheadStart(LALFrStream * stream)
+{
+#ifdef LAL_PTHREAD_LOCK
+    LALFrStreamReadAhead *readahead = stream->readahead;
+    if (readahead->running)
+        return 0;
+    if (!XLALFrameUThreadSafe()) {
+        XLAL_PRINT_WARNING("Read-ahead mode requires a thread-safe frame "
+            "library; frame files will be opened on demand");
+        return 0;
+    }
+    readahead->files = LALCalloc(readahead->depth, sizeof(*readahead->files));
+    if (!readahead->files)
+        XLAL_ERROR(XLAL_ENOMEM);
+    readahead->cache = stream->cache;
+    readahead->head = stream->file ? stream->fnum + 1 : stream->fnum;
+    readahead->count = 0;
+    readahead->busy = 0;
+    readahead->checksum = stream->mode & LAL_FR_STREAM_CHECKSUM_MODE;
+    if (pthread_create(&readahead->thread, NULL,
+            XLALFrStreamReadAheadThread, readahead)) {
+        LALFree(readahead->files);
+        readahead->files = NULL;
+        XLAL_ERROR(XLAL_ESYS, "Could not create read-ahead thread");
+    }
+    readahead->running = 1;
+    return 0;
+#else
+    XLAL_PRINT_WARNING("Read-ahead mode requires pthread support; "
+        "frame files will be opened on demand");
+    (void)stream;
+    return 0;
+#endif
+}
+
+static void XLALFrStreamReadAheadFree(LALFrStreamReadAhead * readahead)
+{
+    if (readahead) {
+        XLALFrStreamReadAheadStop(readahead);
+        while (readahead->nchan > 0)
+            LALFree(readahead->chan[--readahead->nchan]);
+        XLALFree(readahead->chan);
+#ifdef LAL_PTHREAD_LOCK
+        pthread_cond_destroy(&readahead->cond);
+        pthread_mutex_destroy(&readahead->lock);
+#endif
+        LALFree(readahead);
+    }
+    return;
+}
+
+/* Take file fnum from the read-ahead queue, waiting for it if it is being
+ * opened.  Returns NULL if read-ahead is not running or the file is not
+ * the next one to be read, in which case the queue is restarted after
+ * fnum; *waited is set if the reader had to wait. */
+static LALFrFile *XLALFrStreamReadAheadTake(LALFrStreamReadAhead *
+    readahead, UINT4 fnum, int *waited)
+{
+    LALFrFile *file = NULL;
+    *waited = 0;
+#ifdef LAL_PTHREAD_LOCK
+    if (!readahead || !readahead->running)
+        return NULL;
+    pthread_mutex_lock(&readahead->lock);
+    if (fnum >= readahead->head && (fnum < readahead->head + readahead->count
+            || (fnum == readahead->head + readahead->count
+                && readahead->busy))) {
+        size_t skip = fnum - readahead->head;
+        size_t i;
+        while (fnum >= readahead->head + readahead->count) {
+            *waited = 1;
+            pthread_cond_wait(&readahead->cond, &readahead->lock);
+        }
+        /* files skipped over are not going to be read */
+        for (i = 0; i < skip; ++i)
+            XLALFrFileClose(readahead->files[i]);
+        file = readahead->files[skip];
+        readahead->count -= skip + 1;
+        memmove(readahead->files, readahead->files + skip + 1,
+            readahead->count * sizeof(*readahead->files));
+        readahead->head = fnum + 1;
+        pthread_cond_broadcast(&readahead->cond);
+    } else
+        XLALFrStreamReadAheadDiscard(readahead, fnum + 1);
+    pthread_mutex_unlock(&readahead->lock);
+#else
+    (void)readahead;
+    (void)fnum;
+#endif
+    return file;
+}
+
 static int XLALFrStreamFileClose(LALFrStream * stream)
 {
     XLALFrFileClose(stream->file);
@@ -124,6 +385,11 @@ static int XLALFrStreamFileClose(LALFrStream * stream)
 
 static int XLALFrStreamFileOpen(LALFrStream * stream, UINT4 fnum)
 {
+    REAL8 t0;
+    REAL8 stall;
+    int waited;
+    int ready;
+
     if (!stream->cache || !stream->cache->list)
         XLAL_ERROR(XLAL_EINVAL, "No files in stream file cache");
     if (fnum >= stream->cache->length)
@@ -132,12 +398,24 @@ static int XLALFrStreamFileOpen(LALFrStream * stream, UINT4 fnum)
         XLALFrStreamFileClose(stream);
     stream->pos = 0;
     stream->fnum = fnum;
-    stream->file = XLALFrFileOpenURL(stream->cache->list[fnum].url);
+    t0 = XLALGetTimeOfDay();
+    stream->file = XLALFrStreamReadAheadTake(stream->readahead, fnum, &waited);
+    ready = stream->file != NULL;
+    if (!stream->file)
+        stream->file = XLALFrFileOpenURL(stream->cache->list[fnum].url);
+    stall = XLALGetTimeOfDay() - t0;
+    stream->stats.stall += stall;
+    if (stall > stream->stats.maxstall)
+        stream->stats.maxstall = stall;
+    ++stream->stats.nopen;
+    if (ready && !waited)
+        ++stream->stats.nready;
     if (!stream->file) {
         stream->state |= LAL_FR_STREAM_ERR | LAL_FR_STREAM_URL;
         XLAL_ERROR(XLAL_EFUNC);
     }
-    if (stream->mode & LAL_FR_STREAM_CHECKSUM_MODE) {
+    /* files from the read-ahead queue have already been checked */
+    if (!ready && (stream->mode & LAL_FR_STREAM_CHECKSUM_MODE)) {
         if (!XLALFrFileCksumValid(stream->file)) {
             stream->state |= LAL_FR_STREAM_ERR;
             XLALFrStreamFileClose(stream);
@@ -170,6 +448,8 @@ static int XLALFrStreamFileOpen(LALFrStream * stream, UINT4 fnum)
 int XLALFrStreamClose(LALFrStream * stream)
 {
     if (stream) {
+        XLALFrStreamReadAheadFree(stream->readahead);
+        XLALFrStreamIndexFree(stream->index);
         XLALDestroyCache(stream->cache);
         XLALFrStreamFileClose(stream);
         LALFree(stream);
@@ -235,6 +515,77 @@ LALFrStream *XLALFrStreamCacheOpen(LALCache * cache)
     return stream;
 }
 
+/**
+ * @brief Opens a LALFrStream associated with a LALCache and a frame index
+ * @details
+ * This routine is like XLALFrStreamCacheOpen() except that the start
+ * times and durations of all the frames in the cache, and the channels
+ * each file contains, are kept in the index file @p fname.  Files that are
+ * not in the index, or whose size or modification time have changed since
+ * they were indexed, are read and added to the index, and the index file
+ * is rewritten if it has changed.  Seeks on the stream then locate the
+ * frame containing the requested time without opening any files, and
+ * XLALFrStreamIndexQueryChan() tells whether a channel is available at a
+ * given time.  A failure to write the index file is reported as a
+ * warning only.
+ * @param cache Pointer to a LALCache structure describing the frame files to stream.
+ * @param fname Name of the index file.
+ * @returns Pointer to a newly created #LALFrStream structure.
+ * @retval NULL Failure.
+ */
+LALFrStream *XLALFrStreamCacheOpenIndex(LALCache * cache, const char *fname)
+{
+    LALFrStream *stream;
+    int errnum;
+    int status;
+
+    if (!cache || !fname)
+        XLAL_ERROR_NULL(XLAL_EFAULT);
+
+    stream = LALCalloc(1, sizeof(*stream));
+    if (!stream)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    stream->cache = XLALCacheDuplicate(cache);
+    stream->index = XLALFrStreamIndexRead(fname);
+    if (!stream->cache || !stream->index) {
+        XLALFrStreamClose(stream);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    /* index new or changed files; this also sets t0 and dt of the cache
+     * entries that do not have them */
+    if (XLALFrStreamIndexUpdate(stream->index, stream->cache) < 0) {
+        XLALFrStreamClose(stream);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    /* sort and uniqify the cache */
+    if (XLALCacheSort(stream->cache) || XLALCacheUniq(stream->cache)) {
+        XLALFrStreamClose(stream);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    if (XLALFrStreamIndexBind(stream->index, stream->cache) < 0) {
+        XLALFrStreamClose(stream);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+
+    /* the index is only a cache: failing to save it is not fatal */
+    XLAL_TRY(status = XLALFrStreamIndexWrite(stream->index, fname), errnum);
+    if (status < 0)
+        XLAL_PRINT_WARNING("Could not write frame index %s: %s", fname,
+            XLALErrorString(errnum));
+
+    stream->mode = LAL_FR_STREAM_DEFAULT_MODE;
+
+    /* open up the first file */
+    if (XLALFrStreamFileOpen(stream, 0) < 0) {
+        XLALFrStreamClose(stream);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    return stream;
+}
+
 /**
  * @brief Opens a LALFrStream for specified frame files.
  * @details
@@ -313,7 +664,8 @@ int XLALFrStreamGetMode(LALFrStream * stream)
  * #LAL_FR_STREAM_SILENT_MODE to suppress the warning and info messages but
  * still cause routines to fail when data is not available.
  * To enable frame file checksum checking, set the #LAL_FR_STREAM_CHECKSUM_MODE
- * bit.
+ * bit.  To open and decode upcoming frame files in a background thread, set
+ * the #LAL_FR_STREAM_READAHEAD_MODE bit.
  *
  * @note The default value  #LAL_FR_STREAM_DEFAULT_MODE is assumed initially,
  * but this is not necessarily the recommended mode --- it is adopted for
@@ -326,13 +678,139 @@ int XLALFrStreamGetMode(LALFrStream * stream)
  */
 int XLALFrStreamSetMode(LALFrStream * stream, int mode)
 {
+    int oldmode = stream->mode;
     stream->mode = mode;
+    if (mode & LAL_FR_STREAM_READAHEAD_MODE) {
+        if (!stream->readahead
+            && !(stream->readahead = XLALFrStreamReadAheadAlloc()))
+            XLAL_ERROR(XLAL_EFUNC);
+#ifdef LAL_PTHREAD_LOCK
+        /* files in the queue were checked according to the old mode */
+        if (stream->readahead->running
+            && ((mode ^ oldmode) & LAL_FR_STREAM_CHECKSUM_MODE)) {
+            pthread_mutex_lock(&stream->readahead->lock);
+            stream->readahead->checksum = mode & LAL_FR_STREAM_CHECKSUM_MODE;
+            XLALFrStreamReadAheadDiscard(stream->readahead,
+                stream->readahead->head);
+            pthread_mutex_unlock(&stream->readahead->lock);
+        }
+#endif
+        if (!(oldmode & LAL_FR_STREAM_READAHEAD_MODE)
+            && XLALFrStreamReadAheadStart(stream) < 0)
+            XLAL_ERROR(XLAL_EFUNC);
+    } else
+        XLALFrStreamReadAheadStop(stream->readahead);
     /* if checksum mode is turned on, do checksum on current file */
     if ((mode & LAL_FR_STREAM_CHECKSUM_MODE) && (stream->file))
         return XLALFrFileCksumValid(stream->file) ? 0 : -1;
     return 0;
 }
 
+/**
+ * @brief Sets the number of frame files opened in advance in read-ahead mode
+ * @details
+ * In #LAL_FR_STREAM_READAHEAD_MODE a background thread keeps up to
+ * @p depth frame files beyond the current one open and decoded.  The
+ * default depth is 2.  Larger values hide longer I/O latencies at the cost
+ * of memory for the decoded channels.
+ * @param stream Pointer to a #LALFrStream structure.
+ * @param depth Number of frame files to open in advance (at least 1).
+ * @retval 0 Success.
+ * @retval <0 Failure.
+ */
+int XLALFrStreamSetReadAheadDepth(LALFrStream * stream, size_t depth)
+{
+    int running = 0;
+    XLAL_CHECK(stream, XLAL_EFAULT);
+    XLAL_CHECK(depth > 0, XLAL_EINVAL, "Read-ahead depth must be positive");
+    if (!stream->readahead
+        && !(stream->readahead = XLALFrStreamReadAheadAlloc()))
+        XLAL_ERROR(XLAL_EFUNC);
+#ifdef LAL_PTHREAD_LOCK
+    running = stream->readahead->running;
+#endif
+    /* the queue is reallocated, so restart the thread */
+    XLALFrStreamReadAheadStop(stream->readahead);
+    stream->readahead->depth = depth;
+    if (running && XLALFrStreamReadAheadStart(stream) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    return 0;
+}
+
+/**
+ * @brief Adds a channel to be decoded in advance in read-ahead mode
+ * @details
+ * In #LAL_FR_STREAM_READAHEAD_MODE the background thread reads and
+ * decompresses the listed channels from each frame file it opens.  Channels
+ * read with the XLALFrStreamGet and XLALFrStreamRead routines are added
+ * automatically; this routine can be used to have them preloaded from the
+ * first file on.  Channels that do not exist in a file are ignored.
+ * @param stream Pointer to a #LALFrStream structure.
+ * @param chname String containing the name of the channel.
+ * @retval 0 Success.
+ * @retval <0 Failure.
+ */
+int XLALFrStreamReadAheadAddChan(LALFrStream * stream, const char *chname)
+{
+    LALFrStreamReadAhead *readahead;
+    char **chan;
+    char *name;
+    size_t i;
+
+    XLAL_CHECK(stream, XLAL_EFAULT);
+    XLAL_CHECK(chname, XLAL_EFAULT);
+    if (!stream->readahead
+        && !(stream->readahead = XLALFrStreamReadAheadAlloc()))
+        XLAL_ERROR(XLAL_EFUNC);
+    readahead = stream->readahead;
+
+    /* only the reader modifies the list, so it can be searched unlocked */
+    for (i = 0; i < readahead->nchan; ++i)
+        if (strcmp(readahead->chan[i], chname) == 0)
+            return 0;
+
+    name = XLALStringDuplicate(chname);
+    if (!name)
+        XLAL_ERROR(XLAL_EFUNC);
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&readahead->lock);
+#endif
+    chan = XLALRealloc(readahead->chan,
+        (readahead->nchan + 1) * sizeof(*readahead->chan));
+    if (chan) {
+        chan[readahead->nchan++] = name;
+        readahead->chan = chan;
+    }
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_unlock(&readahead->lock);
+#endif
+    if (!chan) {
+        LALFree(name);
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+    return 0;
+}
+
+/**
+ * @brief Gets the I/O wait counters of a LALFrStream
+ * @details
+ * Returns the total and longest time the reader of the stream has waited
+ * for frame files to be opened, the number of files opened, and the number
+ * of those that the read-ahead thread had already opened and decoded, see
+ * #LALFrStreamStats.  The counters are kept in all modes, so they can be
+ * used to compare reading with and without #LAL_FR_STREAM_READAHEAD_MODE.
+ * @param[out] stats Pointer to a #LALFrStreamStats structure.
+ * @param[in] stream Pointer to a #LALFrStream structure.
+ * @retval 0 Success.
+ */
+int XLALFrStreamGetStats(LALFrStreamStats * stats, LALFrStream * stream)
+{
+    XLAL_CHECK(stats, XLAL_EFAULT);
+    XLAL_CHECK(stream, XLAL_EFAULT);
+    *stats = stream->stats;
+    return 0;
+}
+
 /** @} */
 
 /**
@@ -588,38 +1066,56 @@ int XLALFrStreamSeek(LALFrStream * stream, const LIGOTimeGPS * epoch)
     }
 
     /* now we must find the position within the frame file */
-    for (stream->fnum = entry - stream->cache->list;
-        stream->fnum < stream->cache->length; ++stream->fnum) {
-        /* check the file contents to determine the position that matches */
-        size_t nFrame;
-        if (XLALFrStreamFileOpen(stream, stream->fnum) < 0)
+    if (stream->index) {
+        /* the index knows the start time of every frame */
+        UINT4 fnum;
+        INT4 pos;
+        int code = XLALFrStreamIndexLocate(&fnum, &pos, stream->index, epoch);
+        if (code < 0)
             XLAL_ERROR(XLAL_EFUNC);
-        if (epoch->gpsSeconds < stream->cache->list[stream->fnum].t0) {
-            /* detect a gap between files */
-            stream->state |= LAL_FR_STREAM_GAP;
-            break;
+        if (code == 2)  /* past the last frame */
+            stream->fnum = stream->cache->length;
+        else {
+            if (XLALFrStreamFileOpen(stream, fnum) < 0)
+                XLAL_ERROR(XLAL_EFUNC);
+            stream->pos = pos;
+            if (code == 1)
+                stream->state |= LAL_FR_STREAM_GAP;
         }
-        nFrame = XLALFrFileQueryNFrame(stream->file);
-        for (stream->pos = 0; stream->pos < (int)nFrame; ++stream->pos) {
-            LIGOTimeGPS start;
-            int cmp;
-            XLALFrFileQueryGTime(&start, stream->file, stream->pos);
-            cmp = XLALGPSCmp(epoch, &start);
-            if (cmp >= 0
-                && XLALGPSDiff(epoch,
-                    &start) < XLALFrFileQueryDt(stream->file, stream->pos))
-                break;  /* this is the frame! */
-            if (cmp < 0) {
-                /* detect a gap between frames within a file */
+    } else {
+        for (stream->fnum = entry - stream->cache->list;
+            stream->fnum < stream->cache->length; ++stream->fnum) {
+            /* check the file contents to determine the position that matches */
+            size_t nFrame;
+            if (XLALFrStreamFileOpen(stream, stream->fnum) < 0)
+                XLAL_ERROR(XLAL_EFUNC);
+            if (epoch->gpsSeconds < stream->cache->list[stream->fnum].t0) {
+                /* detect a gap between files */
                 stream->state |= LAL_FR_STREAM_GAP;
                 break;
             }
+            nFrame = XLALFrFileQueryNFrame(stream->file);
+            for (stream->pos = 0; stream->pos < (int)nFrame; ++stream->pos) {
+                LIGOTimeGPS start;
+                int cmp;
+                XLALFrFileQueryGTime(&start, stream->file, stream->pos);
+                cmp = XLALGPSCmp(epoch, &start);
+                if (cmp >= 0
+                    && XLALGPSDiff(epoch,
+                        &start) < XLALFrFileQueryDt(stream->file, stream->pos))
+                    break;  /* this is the frame! */
+                if (cmp < 0) {
+                    /* detect a gap between frames within a file */
+                    stream->state |= LAL_FR_STREAM_GAP;
+                    break;
+                }
+            }
+            if (stream->pos < (int)nFrame)  /* we've found the frame */
+                break;
+            /* oops... not in this frame file, go on to the next one */
+            /* probably the frame file was mis-named.... */
+            XLALFrStreamFileClose(stream);
         }
-        if (stream->pos < (int)nFrame)  /* we've found the frame */
-            break;
-        /* oops... not in this frame file, go on to the next one */
-        /* probably the frame file was mis-named.... */
-        XLALFrStreamFileClose(stream);
     }
 
     if (stream->fnum >= stream->cache->length) {
@@ -60,6 +60,7 @@ extern "C" {
  * @{
  * @defgroup LALFrStream_c     Module LALFrStream.c
  * @defgroup LALFrStreamRead_c Module LALFrStreamRead.c
+ * @defgroup LALFrStreamIndex_c Module LALFrStreamIndex.c
  * @}
  *
  * @addtogroup LALFrStream_c
@@ -85,9 +86,27 @@ typedef enum tagLALFrStreamMode {
     LAL_FR_STREAM_IGNOREGAP_MODE = 4,   /**< ignore gaps in data */
     LAL_FR_STREAM_IGNORETIME_MODE = 8,  /**< ignore invalid times requested */
     LAL_FR_STREAM_DEFAULT_MODE = 15,    /**< ignore time/gaps but report warnings & info */
-    LAL_FR_STREAM_CHECKSUM_MODE = 16    /**< ensure that file checksums are OK */
+    LAL_FR_STREAM_CHECKSUM_MODE = 16,   /**< ensure that file checksums are OK */
+    LAL_FR_STREAM_READAHEAD_MODE = 32   /**< open and decode upcoming files in a background thread */
 } LALFrStreamMode;
 
+/** Incomplete type for the state of the read-ahead thread of a stream */
+typedef struct tagLALFrStreamReadAhead LALFrStreamReadAhead;
+
+/** Incomplete type for the on-disk frame index of a stream */
+typedef struct tagLALFrStreamIndex LALFrStreamIndex;
+
+/**
+ * This structure contains counters of the time a frame stream has spent
+ * waiting for frame files to be opened.
+ */
+typedef struct tagLALFrStreamStats {
+    REAL8 stall;        /**< total time in seconds the reader waited for frame files to be opened */
+    REAL8 maxstall;     /**< longest single such wait in seconds */
+    UINT8 nopen;        /**< number of frame files opened for the reader */
+    UINT8 nready;       /**< number of those that the read-ahead thread had already opened */
+} LALFrStreamStats;
+
 /**
  * This structure details the state of the frame stream.  The contents are
  * private; you should not tamper with them!
@@ -100,6 +119,9 @@ typedef struct tagLALFrStream {
     UINT4 fnum;
     LALFrFile *file;
     INT4 pos;
+    LALFrStreamReadAhead *readahead;
+    LALFrStreamStats stats;
+    LALFrStreamIndex *index;
 } LALFrStream;
 
 /**
@@ -116,10 +138,16 @@ typedef struct tagLALFrStreamPos {
 /** @} */
 
 LALFrStream *XLALFrStreamCacheOpen(LALCache * cache);
+LALFrStream *XLALFrStreamCacheOpenIndex(LALCache * cache, const char *fname);
 LALFrStream *XLALFrStreamOpen(const char *dirname, const char *pattern);
 int XLALFrStreamClose(LALFrStream * stream);
 int XLALFrStreamGetMode(LALFrStream * stream);
 int XLALFrStreamSetMode(LALFrStream * stream, int mode);
+int XLALFrStreamSetReadAheadDepth(LALFrStream * stream, size_t depth);
+int XLALFrStreamReadAheadAddChan(LALFrStream * stream, const char *chname);
+int XLALFrStreamGetStats(LALFrStreamStats * stats, LALFrStream * stream);
+int XLALFrStreamIndexQueryChan(LALFrStream * stream, const char *chname,
+    const LIGOTimeGPS * epoch);
 
 int XLALFrStreamState(LALFrStream * stream);
 int XLALFrStreamEnd(LALFrStream * stream);
@@ -234,6 +262,9 @@ REAL8TimeSeries *XLALFrStreamInputREAL8TimeSeries(LALFrStream * stream,
 COMPLEX16TimeSeries *XLALFrStreamInputCOMPLEX16TimeSeries(LALFrStream *
     stream, const char *channel, const LIGOTimeGPS * start, REAL8 duration,
     size_t lengthlimit);
+int XLALFrStreamInputREAL8TimeSeriesMulti(REAL8TimeSeries ** series,
+    LALFrStream * stream, const char *const *chnames, size_t nchan,
+    const LIGOTimeGPS * start, REAL8 duration, size_t lengthlimit);
 
 REAL8FrequencySeries *XLALFrStreamInputREAL8FrequencySeries(LALFrStream *
     stream, const char *chname, const LIGOTimeGPS * epoch);
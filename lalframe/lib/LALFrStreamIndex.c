@@ -0,0 +1,782 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+/**
+ * @addtogroup LALFrStreamIndex_c
+ * @brief Provides a persistent index of the frame files of a #LALFrStream.
+ * @details
+ * A #LALFrStream opened with XLALFrStreamCacheOpenIndex() keeps a record of
+ * the start time and duration of every frame of every file in its cache,
+ * and of the channels each file contains, in an index file.  The stream
+ * then finds the file and frame for a seek by a binary search of the index
+ * instead of opening files, and XLALFrStreamIndexQueryChan() tells whether
+ * a channel is present at a given time without opening any file.
+ *
+ * The index is read when the stream is opened.  Files of the cache that are
+ * not in the index, or whose size or modification time has changed since
+ * they were indexed, are opened and indexed again, and the index file is
+ * rewritten if anything changed; files that are no longer in the cache are
+ * dropped from it.  Each file's channel list is stored once per distinct
+ * list, so the index of a long run of files written by the same process
+ * stays small.
+ *
+ * The index is a text file with the following format:
+ * @code
+ * # LALFrStreamIndex 1
+ * C nchan
+ * channel name (nchan lines)
+ * ...
+ * F size mtime chanset nframe url
+ * frame start time in GPS nanoseconds and duration in seconds (nframe lines)
+ * ...
+ * @endcode
+ * where each @c C record describes a channel list and @c chanset is the
+ * index of the @c C record of the channels in the file.
+ * @{
+ */
+
+#include <config.h>
+
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALStdio.h>
+#include <lal/LALString.h>
+#include <lal/LALHashFunc.h>
+#include <lal/FileIO.h>
+#include <lal/Date.h>
+#include <lal/LALCache.h>
+#include <lal/LALFrameIO.h>
+#include <lal/LALFrStream.h>
+
+#include "LALFrStreamIndex_private.h"
+
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+/** @cond */
+
+#define LAL_FR_STREAM_INDEX_VERSION 1
+
+/* a distinct list of channel names, sorted */
+struct tagLALFrStreamIndexChanSet {
+    UINT8 hash;
+    size_t nchan;
+    char **chan;
+};
+
+/* the frames of a frame file */
+struct tagLALFrStreamIndexFile {
+    char *url;
+    INT8 size;
+    INT8 mtime;
+    size_t chanset;
+    size_t nframe;
+    INT8 *start;        /* frame start times in nanoseconds */
+    REAL8 *dt;          /* frame durations in seconds */
+    int keep;
+};
+
+/* a frame of a file in the stream cache */
+struct tagLALFrStreamIndexFrame {
+    INT8 start;
+    REAL8 dt;
+    UINT4 fnum;
+    INT4 pos;
+};
+
+struct tagLALFrStreamIndex {
+    size_t nfile;
+    struct tagLALFrStreamIndexFile *file;       /* sorted by url */
+    size_t nchanset;
+    struct tagLALFrStreamIndexChanSet *chanset;
+    size_t nframe;
+    struct tagLALFrStreamIndexFrame *frame;     /* sorted by start time */
+    size_t nbind;
+    size_t *bind;       /* index of file in file list for each cache entry */
+    int modified;
+};
+
+static int XLALFrStreamIndexStrCmp(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static int XLALFrStreamIndexFileCmp(const void *a, const void *b)
+{
+    const struct tagLALFrStreamIndexFile *fa = a;
+    const struct tagLALFrStreamIndexFile *fb = b;
+    return strcmp(fa->url, fb->url);
+}
+
+static int XLALFrStreamIndexUrlCmp(const void *key, const void *b)
+{
+    const struct tagLALFrStreamIndexFile *fb = b;
+    return strcmp(key, fb->url);
+}
+
+static int XLALFrStreamIndexFrameCmp(const void *a, const void *b)
+{
+    const struct tagLALFrStreamIndexFrame *fa = a;
+    const struct tagLALFrStreamIndexFrame *fb = b;
+    if (fa->start != fb->start)
+        return fa->start < fb->start ? -1 : 1;
+    if (fa->fnum != fb->fnum)
+        return fa->fnum < fb->fnum ? -1 : 1;
+    return (fa->pos > fb->pos) - (fa->pos < fb->pos);
+}
+
+static void XLALFrStreamIndexFileClear(struct tagLALFrStreamIndexFile *file)
+{
+    LALFree(file->url);
+    LALFree(file->start);
+    LALFree(file->dt);
+    memset(file, 0, sizeof(*file));
+    return;
+}
+
+static void XLALFrStreamIndexFreeChan(char **chan, size_t nchan)
+{
+    while (nchan > 0)
+        LALFree(chan[--nchan]);
+    LALFree(chan);
+    return;
+}
+
+static void XLALFrStreamIndexClear(LALFrStreamIndex * index)
+{
+    size_t i;
+    for (i = 0; i < index->nfile; ++i)
+        XLALFrStreamIndexFileClear(&index->file[i]);
+    for (i = 0; i < index->nchanset; ++i)
+        XLALFrStreamIndexFreeChan(index->chanset[i].chan,
+            index->chanset[i].nchan);
+    LALFree(index->file);
+    LALFree(index->chanset);
+    LALFree(index->frame);
+    LALFree(index->bind);
+    memset(index, 0, sizeof(*index));
+    return;
+}
+
+/* size and modification time of the file at url, or -1 if unknown */
+static void XLALFrStreamIndexStat(INT8 * size, INT8 * mtime, const char *url)
+{
+    *size = *mtime = -1;
+#ifdef HAVE_SYS_STAT_H
+    {
+        struct stat st;
+        const char *path = url;
+        if (strncmp(path, "file://", 7) == 0) {
+            path = strchr(path + 7, '/');       /* skip the host */
+            if (!path)
+                return;
+        }
+        if (stat(path, &st) == 0) {
+            *size = st.st_size;
+            *mtime = st.st_mtime;
+        }
+    }
+#else
+    (void)url;
+#endif
+    return;
+}
+
+/* adds the sorted channel list chan to the index, taking ownership of it,
+ * and returns its index; an identical list already present is reused */
+static size_t XLALFrStreamIndexAddChanSet(LALFrStreamIndex * index,
+    char **chan, size_t nchan)
+{
+    struct tagLALFrStreamIndexChanSet *chanset;
+    UINT8 hash = nchan;
+    size_t i;
+
+    for (i = 0; i < nchan; ++i)
+        hash = XLALCityHash64WithSeed(chan[i], strlen(chan[i]), hash);
+    for (i = 0; i < index->nchanset; ++i) {
+        size_t j;
+        chanset = &index->chanset[i];
+        if (chanset->hash != hash || chanset->nchan != nchan)
+            continue;
+        for (j = 0; j < nchan; ++j)
+            if (strcmp(chanset->chan[j], chan[j]))
+                break;
+        if (j == nchan) {
+            XLALFrStreamIndexFreeChan(chan, nchan);
+            return i;
+        }
+    }
+
+    chanset = LALRealloc(index->chanset,
+        (index->nchanset + 1) * sizeof(*index->chanset));
+    if (!chanset) {
+        XLALFrStreamIndexFreeChan(chan, nchan);
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+    index->chanset = chanset;
+    chanset = &index->chanset[index->nchanset];
+    chanset->hash = hash;
+    chanset->nchan = nchan;
+    chanset->chan = chan;
+    return index->nchanset++;
+}
+
+/* opens the frame file url and records its frames; its sorted channel list
+ * is returned in chan and nchan to be added to the index by the caller, so
+ * that several files can be scanned at once */
+static int XLALFrStreamIndexScan(struct tagLALFrStreamIndexFile *file,
+    char ***chan, size_t *nchan, const char *url)
+{
+    LALFrFile *frfile;
+    size_t i;
+    int errnum = XLAL_EFUNC;
+
+    memset(file, 0, sizeof(*file));
+    *chan = NULL;
+    *nchan = 0;
+    frfile = XLALFrFileOpenURL(url);
+    if (!frfile)
+        XLAL_ERROR(XLAL_EIO, "Could not index frame file %s", url);
+
+    if (!(file->url = XLALStringDuplicate(url)))
+        goto failure;
+    XLALFrStreamIndexStat(&file->size, &file->mtime, url);
+
+    file->nframe = XLALFrFileQueryNFrame(frfile);
+    if (file->nframe == (size_t)(-1))
+        goto failure;
+    file->start = LALMalloc(file->nframe * sizeof(*file->start));
+    file->dt = LALMalloc(file->nframe * sizeof(*file->dt));
+    if (file->nframe && (!file->start || !file->dt)) {
+        errnum = XLAL_ENOMEM;
+        goto failure;
+    }
+    for (i = 0; i < file->nframe; ++i) {
+        LIGOTimeGPS start;
+        XLALFrFileQueryGTime(&start, frfile, i);
+        file->start[i] = XLALGPSToINT8NS(&start);
+        file->dt[i] = XLALFrFileQueryDt(frfile, i);
+    }
+
+    *nchan = XLALFrFileQueryChanN(frfile);
+    if (*nchan == (size_t)(-1)) {
+        *nchan = 0;
+        goto failure;
+    }
+    *chan = LALCalloc(*nchan ? *nchan : 1, sizeof(**chan));
+    if (!*chan) {
+        errnum = XLAL_ENOMEM;
+        goto failure;
+    }
+    for (i = 0; i < *nchan; ++i) {
+        const char *name = XLALFrFileQueryChanName(frfile, i);
+        if (!name || !((*chan)[i] = XLALStringDuplicate(name)))
+            goto failure;
+    }
+    qsort(*chan, *nchan, sizeof(**chan), XLALFrStreamIndexStrCmp);
+
+    XLALFrFileClose(frfile);
+    return 0;
+
+  failure:
+    if (*chan)
+        XLALFrStreamIndexFreeChan(*chan, *nchan);
+    *chan = NULL;
+    *nchan = 0;
+    XLALFrStreamIndexFileClear(file);
+    XLALFrFileClose(frfile);
+    XLAL_ERROR(errnum, "Could not index frame file %s", url);
+}
+
+/* reads a line, removing the trailing newline; returns NULL at end of file */
+static char *XLALFrStreamIndexGets(char *line, int size, LALFILE * fp)
+{
+    size_t len;
+    if (!XLALFileGets(line, size, fp))
+        return NULL;
+    len = strlen(line);
+    if (len && line[len - 1] == '\n')
+        line[--len] = '\0';
+    return line;
+}
+
+/* parses the contents of an index file; returns non-zero if malformed */
+static int XLALFrStreamIndexParse(LALFrStreamIndex * index, LALFILE * fp)
+{
+    char line[FILENAME_MAX + 128];
+    size_t capacity = 0;
+    int version;
+
+    if (!XLALFrStreamIndexGets(line, sizeof(line), fp)
+        || sscanf(line, "# LALFrStreamIndex %d", &version) != 1
+        || version != LAL_FR_STREAM_INDEX_VERSION)
+        return 1;
+
+    while (XLALFrStreamIndexGets(line, sizeof(line), fp)) {
+        if (line[0] == 'C') {
+            char **chan;
+            size_t nchan;
+            size_t i;
+            if (sscanf(line, "C %zu", &nchan) != 1)
+                return 1;
+            chan = LALCalloc(nchan ? nchan : 1, sizeof(*chan));
+            if (!chan)
+                return 1;
+            for (i = 0; i < nchan; ++i)
+                if (!XLALFrStreamIndexGets(line, sizeof(line), fp)
+                    || !(chan[i] = XLALStringDuplicate(line)))
+                    break;
+            if (i < nchan) {
+                XLALFrStreamIndexFreeChan(chan, i);
+                return 1;
+            }
+            /* the lists are stored sorted and distinct */
+            if (XLALFrStreamIndexAddChanSet(index, chan,
+                    nchan) != index->nchanset - 1)
+                return 1;
+        } else if (line[0] == 'F') {
+            struct tagLALFrStreamIndexFile *file;
+            int n = 0;
+            size_t i;
+            if (index->nfile == capacity) {
+                capacity = capacity ? 2 * capacity : 1024;
+                file = LALRealloc(index->file, capacity * sizeof(*file));
+                if (!file)
+                    return 1;
+                index->file = file;
+            }
+            file = &index->file[index->nfile];
+            memset(file, 0, sizeof(*file));
+            if (sscanf(line,
+                    "F %" LAL_INT8_FORMAT " %" LAL_INT8_FORMAT " %zu %zu %n",
+                    &file->size, &file->mtime, &file->chanset,
+                    &file->nframe, &n) != 4 || !line[n]
+                || file->chanset >= index->nchanset)
+                return 1;
+            ++index->nfile;
+            file->url = XLALStringDuplicate(line + n);
+            file->start = LALMalloc(file->nframe * sizeof(*file->start));
+            file->dt = LALMalloc(file->nframe * sizeof(*file->dt));
+            if (!file->url || (file->nframe && (!file->start || !file->dt)))
+                return 1;
+            for (i = 0; i < file->nframe; ++i)
+                if (!XLALFrStreamIndexGets(line, sizeof(line), fp)
+                    || sscanf(line, "%" LAL_INT8_FORMAT " %lf",
+                        &file->start[i], &file->dt[i]) != 2)
+                    return 1;
+        } else
+            return 1;
+    }
+    return 0;
+}
+
+/** @endcond */
+
+LALFrStreamIndex *XLALFrStreamIndexRead(const char *fname)
+{
+    LALFrStreamIndex *index;
+    LALFILE *fp;
+    INT8 size;
+    INT8 mtime;
+
+    index = LALCalloc(1, sizeof(*index));
+    if (!index)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+    /* no index yet: it will be created */
+    XLALFrStreamIndexStat(&size, &mtime, fname);
+    if (size < 0) {
+        index->modified = 1;
+        return index;
+    }
+
+    fp = XLALFileOpenRead(fname);
+    if (!fp) {
+        LALFree(index);
+        XLAL_ERROR_NULL(XLAL_EIO, "Could not open frame index file %s",
+            fname);
+    }
+    if (XLALFrStreamIndexParse(index, fp)) {
+        /* an unusable index is simply rebuilt */
+        XLAL_PRINT_WARNING("Ignoring malformed frame index file %s", fname);
+        XLALFrStreamIndexClear(index);
+        index->modified = 1;
+    }
+    XLALFileClose(fp);
+
+    if (index->nfile)
+        qsort(index->file, index->nfile, sizeof(*index->file),
+            XLALFrStreamIndexFileCmp);
+    return index;
+}
+
+int XLALFrStreamIndexUpdate(LALFrStreamIndex * index, LALCache * cache)
+{
+    const size_t n = cache->length ? cache->length : 1;
+    struct tagLALFrStreamIndexFile *file;
+    struct tagLALFrStreamIndexFile **found;
+    size_t *scan;
+    char ***chan;
+    size_t *nchan;
+    size_t nscan = 0;
+    size_t nfile;
+    size_t i;
+    int failed = 0;
+
+    for (i = 0; i < index->nfile; ++i)
+        index->file[i].keep = 0;
+
+    /* new files are collected separately so that the search of the files
+     * already indexed keeps working */
+    file = LALCalloc(n, sizeof(*file));
+    found = LALCalloc(n, sizeof(*found));
+    scan = LALCalloc(n, sizeof(*scan));
+    chan = LALCalloc(n, sizeof(*chan));
+    nchan = LALCalloc(n, sizeof(*nchan));
+    if (!file || !found || !scan || !chan || !nchan) {
+        LALFree(nchan);
+        LALFree(chan);
+        LALFree(scan);
+        LALFree(found);
+        LALFree(file);
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+
+    /* find the files that are indexed and unchanged */
+    for (i = 0; i < cache->length; ++i) {
+        const char *url = cache->list[i].url;
+        INT8 size;
+        INT8 mtime;
+        found[i] = index->nfile ? bsearch(url, index->file, index->nfile,
+            sizeof(*index->file), XLALFrStreamIndexUrlCmp) : NULL;
+        XLALFrStreamIndexStat(&size, &mtime, url);
+        if (found[i] && found[i]->size == size && found[i]->mtime == mtime)
+            found[i]->keep = 1;
+        else {
+            found[i] = &file[nscan];
+            scan[nscan++] = i;
+        }
+    }
+
+    /* read the others; when a cache is indexed for the first time this is
+     * every file, so they are read in parallel if the frame library
+     * allows it */
+#pragma omp parallel for schedule(dynamic) if(nscan > 1 && XLALFrameUThreadSafe())
+    for (i = 0; i < nscan; ++i)
+        if (XLALFrStreamIndexScan(&file[i], &chan[i], &nchan[i],
+                cache->list[scan[i]].url) < 0) {
+#pragma omp atomic write
+            failed = 1;
+        }
+
+    /* channel lists are shared between files, so they are added in turn */
+    for (i = 0; i < nscan; ++i) {
+        file[i].keep = 1;
+        if (!failed) {
+            file[i].chanset =
+                XLALFrStreamIndexAddChanSet(index, chan[i], nchan[i]);
+            if (file[i].chanset == (size_t)(XLAL_FAILURE))
+                failed = 1;
+        } else if (chan[i])
+            XLALFrStreamIndexFreeChan(chan[i], nchan[i]);
+    }
+    LALFree(nchan);
+    LALFree(chan);
+    LALFree(scan);
+    if (failed) {
+        for (i = 0; i < nscan; ++i)
+            XLALFrStreamIndexFileClear(&file[i]);
+        LALFree(found);
+        LALFree(file);
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+    if (nscan)
+        index->modified = 1;
+
+    /* as XLALFrStreamCacheOpen() does when reading the file */
+    for (i = 0; i < cache->length; ++i) {
+        LALCacheEntry *entry = &cache->list[i];
+        if (found[i]->nframe && (entry->t0 == 0 || entry->dt == 0)) {
+            const size_t last = found[i]->nframe - 1;
+            INT8 end = found[i]->start[last] +
+                (INT8) floor(1e9 * found[i]->dt[last] + 0.5);
+            entry->t0 = found[i]->start[0] / XLAL_BILLION_INT8;
+            entry->dt = (end + XLAL_BILLION_INT8 - 1) / XLAL_BILLION_INT8 -
+                entry->t0;
+        }
+    }
+    LALFree(found);
+    nfile = nscan;
+
+    /* merge the new files into the list and drop those not kept */
+    if (nfile) {
+        struct tagLALFrStreamIndexFile *merged;
+        merged = LALRealloc(index->file,
+            (index->nfile + nfile) * sizeof(*index->file));
+        if (!merged) {
+            while (nfile > 0)
+                XLALFrStreamIndexFileClear(&file[--nfile]);
+            LALFree(file);
+            XLAL_ERROR(XLAL_ENOMEM);
+        }
+        index->file = merged;
+        memcpy(index->file + index->nfile, file, nfile * sizeof(*file));
+        index->nfile += nfile;
+    }
+    LALFree(file);
+    for (i = nfile = 0; i < index->nfile; ++i)
+        if (index->file[i].keep)
+            index->file[nfile++] = index->file[i];
+        else {
+            XLALFrStreamIndexFileClear(&index->file[i]);
+            index->modified = 1;
+        }
+    index->nfile = nfile;
+    if (index->nfile)
+        qsort(index->file, index->nfile, sizeof(*index->file),
+            XLALFrStreamIndexFileCmp);
+
+    /* a file listed twice in the cache has been indexed twice */
+    for (i = nfile = 0; i < index->nfile; ++i) {
+        if (nfile && !strcmp(index->file[nfile - 1].url, index->file[i].url)) {
+            XLALFrStreamIndexFileClear(&index->file[nfile - 1]);
+            index->file[nfile - 1] = index->file[i];
+        } else
+            index->file[nfile++] = index->file[i];
+    }
+    index->nfile = nfile;
+    return 0;
+}
+
+int XLALFrStreamIndexBind(LALFrStreamIndex * index, const LALCache * cache)
+{
+    size_t nframe = 0;
+    UINT4 fnum;
+
+    LALFree(index->frame);
+    LALFree(index->bind);
+    index->frame = NULL;
+    index->nframe = 0;
+    index->bind = LALMalloc((cache->length ? cache->length : 1) *
+        sizeof(*index->bind));
+    index->nbind = cache->length;
+    if (!index->bind)
+        XLAL_ERROR(XLAL_ENOMEM);
+
+    for (fnum = 0; fnum < cache->length; ++fnum) {
+        const struct tagLALFrStreamIndexFile *found;
+        found = bsearch(cache->list[fnum].url, index->file, index->nfile,
+            sizeof(*index->file), XLALFrStreamIndexUrlCmp);
+        if (!found)
+            XLAL_ERROR(XLAL_EINVAL, "Frame file %s is not indexed",
+                cache->list[fnum].url);
+        index->bind[fnum] = found - index->file;
+        nframe += found->nframe;
+    }
+
+    index->frame = LALMalloc((nframe ? nframe : 1) * sizeof(*index->frame));
+    if (!index->frame)
+        XLAL_ERROR(XLAL_ENOMEM);
+    for (fnum = 0; fnum < cache->length; ++fnum) {
+        const struct tagLALFrStreamIndexFile *file;
+        size_t pos;
+        file = &index->file[index->bind[fnum]];
+        for (pos = 0; pos < file->nframe; ++pos) {
+            struct tagLALFrStreamIndexFrame *frame;
+            frame = &index->frame[index->nframe++];
+            frame->start = file->start[pos];
+            frame->dt = file->dt[pos];
+            frame->fnum = fnum;
+            frame->pos = pos;
+        }
+    }
+    qsort(index->frame, index->nframe, sizeof(*index->frame),
+        XLALFrStreamIndexFrameCmp);
+    return 0;
+}
+
+int XLALFrStreamIndexWrite(LALFrStreamIndex * index, const char *fname)
+{
+    size_t *renumber;
+    size_t nchanset = 0;
+    LALFILE *fp;
+    char *tmpname;
+    size_t i;
+    int errnum = XLAL_EIO;
+
+    if (!index->modified)
+        return 0;
+
+    /* only the channel lists still referred to are written */
+    renumber = LALMalloc((index->nchanset ? index->nchanset : 1) *
+        sizeof(*renumber));
+    if (!renumber)
+        XLAL_ERROR(XLAL_ENOMEM);
+    for (i = 0; i < index->nchanset; ++i)
+        renumber[i] = (size_t)(-1);
+    for (i = 0; i < index->nfile; ++i)
+        renumber[index->file[i].chanset] = 0;
+
+    /* write to a temporary file so that a reader never sees a partial index */
+    tmpname = XLALStringDuplicate(fname);
+    if (!tmpname || !(tmpname = XLALStringAppend(tmpname, ".tmp"))) {
+        LALFree(renumber);
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+    fp = XLALFileOpenWrite(tmpname, 0);
+    if (!fp)
+        goto failure;
+
+    XLALFilePrintf(fp, "# LALFrStreamIndex %d\n",
+        LAL_FR_STREAM_INDEX_VERSION);
+    for (i = 0; i < index->nchanset; ++i)
+        if (renumber[i] == 0) {
+            const struct tagLALFrStreamIndexChanSet *chanset;
+            size_t j;
+            chanset = &index->chanset[i];
+            renumber[i] = nchanset++;
+            XLALFilePrintf(fp, "C %zu\n", chanset->nchan);
+            for (j = 0; j < chanset->nchan; ++j)
+                XLALFilePrintf(fp, "%s\n", chanset->chan[j]);
+        }
+    for (i = 0; i < index->nfile; ++i) {
+        const struct tagLALFrStreamIndexFile *file = &index->file[i];
+        size_t pos;
+        XLALFilePrintf(fp, "F %" LAL_INT8_FORMAT " %" LAL_INT8_FORMAT
+            " %zu %zu %s\n", file->size, file->mtime,
+            renumber[file->chanset], file->nframe, file->url);
+        for (pos = 0; pos < file->nframe; ++pos)
+            XLALFilePrintf(fp, "%" LAL_INT8_FORMAT " %.17g\n",
+                file->start[pos], file->dt[pos]);
+    }
+    if (XLALFileClose(fp) < 0)
+        goto failure;
+    if (rename(tmpname, fname)) {
+        XLAL_PRINT_ERROR("Could not rename %s to %s", tmpname, fname);
+        goto failure;
+    }
+
+    LALFree(tmpname);
+    LALFree(renumber);
+    index->modified = 0;
+    return 0;
+
+  failure:
+    remove(tmpname);
+    LALFree(tmpname);
+    LALFree(renumber);
+    XLAL_ERROR(errnum, "Could not write frame index file %s", fname);
+}
+
+int XLALFrStreamIndexLocate(UINT4 * fnum, INT4 * pos,
+    const LALFrStreamIndex * index, const LIGOTimeGPS * epoch)
+{
+    const INT8 t = XLALGPSToINT8NS(epoch);
+    size_t lo = 0;
+    size_t hi = index->nframe;
+    const struct tagLALFrStreamIndexFrame *frame;
+
+    if (!index->nframe)
+        return 2;
+
+    /* find the first frame starting after t */
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index->frame[mid].start <= t)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    /* the frame before it contains t unless t is in a gap */
+    if (lo > 0) {
+        frame = &index->frame[lo - 1];
+        if (t < frame->start + (INT8) floor(1e9 * frame->dt + 0.5)) {
+            *fnum = frame->fnum;
+            *pos = frame->pos;
+            return 0;
+        }
+    }
+    if (lo == index->nframe)
+        return 2;
+    frame = &index->frame[lo];
+    *fnum = frame->fnum;
+    *pos = frame->pos;
+    return 1;
+}
+
+void XLALFrStreamIndexFree(LALFrStreamIndex * index)
+{
+    if (index) {
+        XLALFrStreamIndexClear(index);
+        LALFree(index);
+    }
+    return;
+}
+
+/**
+ * @brief Checks whether a channel is present in the frame data of an
+ * indexed #LALFrStream at a given time.
+ * @details
+ * The answer is found from the index of a stream opened with
+ * XLALFrStreamCacheOpenIndex() by binary searches of the frames and of the
+ * channel list of the file containing @p epoch; no frame file is opened and
+ * the position of the stream is not changed.
+ * @param stream Pointer to a #LALFrStream opened with
+ * XLALFrStreamCacheOpenIndex().
+ * @param chname String containing the name of the channel.
+ * @param epoch The LIGOTimeGPS time at which the channel is wanted.
+ * @retval 1 The channel is in the frame file containing @p epoch.
+ * @retval 0 The channel is not in that file, or there is no data at
+ * @p epoch.
+ * @retval <0 Failure, e.g., the stream has no index.
+ */
+int XLALFrStreamIndexQueryChan(LALFrStream * stream, const char *chname,
+    const LIGOTimeGPS * epoch)
+{
+    const struct tagLALFrStreamIndexChanSet *chanset;
+    const LALFrStreamIndex *index;
+    UINT4 fnum;
+    INT4 pos;
+
+    XLAL_CHECK(stream, XLAL_EFAULT);
+    XLAL_CHECK(chname, XLAL_EFAULT);
+    XLAL_CHECK(epoch, XLAL_EFAULT);
+    XLAL_CHECK(stream->index, XLAL_EINVAL,
+        "Frame stream was not opened with an index");
+
+    index = stream->index;
+    if (XLALFrStreamIndexLocate(&fnum, &pos, index, epoch) != 0)
+        return 0;
+    chanset = &index->chanset[index->file[index->bind[fnum]].chanset];
+    return bsearch(&chname, chanset->chan, chanset->nchan,
+        sizeof(*chanset->chan), XLALFrStreamIndexStrCmp) != NULL;
+}
+
+/** @} */
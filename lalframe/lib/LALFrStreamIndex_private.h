@@ -0,0 +1,50 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#ifndef _LALFRSTREAMINDEX_PRIVATE_H
+#define _LALFRSTREAMINDEX_PRIVATE_H
+
+#include <lal/LALDatatypes.h>
+#include <lal/LALCache.h>
+#include <lal/LALFrStream.h>
+
+/* routines shared by LALFrStream.c and LALFrStreamIndex.c */
+
+/* reads the index file fname; an empty index is returned if it does not
+ * exist */
+LALFrStreamIndex *XLALFrStreamIndexRead(const char *fname);
+
+/* indexes the files of cache that are not in the index or have changed
+ * since they were indexed, and sets unset t0 and dt of the cache entries;
+ * files not in cache are dropped from the index */
+int XLALFrStreamIndexUpdate(LALFrStreamIndex * index, LALCache * cache);
+
+/* associates the index with the file numbers of the (sorted) cache */
+int XLALFrStreamIndexBind(LALFrStreamIndex * index, const LALCache * cache);
+
+/* writes the index to fname if it has changed since it was read */
+int XLALFrStreamIndexWrite(LALFrStreamIndex * index, const char *fname);
+
+/* finds file number fnum and frame pos containing time epoch: returns 0 if
+ * found, 1 if epoch is in a gap (the next frame is returned), 2 if epoch
+ * is after the last frame */
+int XLALFrStreamIndexLocate(UINT4 * fnum, INT4 * pos,
+    const LALFrStreamIndex * index, const LIGOTimeGPS * epoch);
+
+void XLALFrStreamIndexFree(LALFrStreamIndex * index);
+
+#endif /* _LALFRSTREAMINDEX_PRIVATE_H */
@@ -26,6 +26,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include <lal/LALStdlib.h>
 #include <lal/Date.h>
@@ -171,6 +172,66 @@ LALTYPECODE XLALFrStreamGetTimeSeriesType(const char *chname, LALFrStream * stre
         XLALDestroy##origtype##FrequencySeries(origin); \
     } while(0)
 
+/* reads a channel from one frame of a frame file as a REAL8 time series,
+ * converting from the stored type as XLALFrStreamInputREAL8TimeSeries()
+ * does */
+#define INPUTFRTS(series, origtype, frfile, chname, pos) \
+    do { \
+        origtype ## TimeSeries *origin; \
+        origin = XLALFrFileRead##origtype##TimeSeries((frfile),(chname),(pos)); \
+        if (!origin) \
+            XLAL_ERROR_NULL(XLAL_EFUNC); \
+        series = XLALCreateREAL8TimeSeries((chname),&origin->epoch,origin->f0,origin->deltaT,&origin->sampleUnits,origin->data->length); \
+        if (series) \
+            COPY_S2S(series->data->data, origin->data->data, origin->data->length); \
+        XLALDestroy##origtype##TimeSeries(origin); \
+        if (!series) \
+            XLAL_ERROR_NULL(XLAL_EFUNC); \
+    } while(0)
+
+static REAL8TimeSeries *XLALFrFileInputREAL8TimeSeries(LALFrFile * frfile,
+    const char *chname, size_t pos)
+{
+    REAL8TimeSeries *series;
+    switch (XLALFrFileQueryChanType(frfile, chname, pos)) {
+    case LAL_I2_TYPE_CODE:
+        INPUTFRTS(series, INT2, frfile, chname, pos);
+        break;
+    case LAL_I4_TYPE_CODE:
+        INPUTFRTS(series, INT4, frfile, chname, pos);
+        break;
+    case LAL_I8_TYPE_CODE:
+        INPUTFRTS(series, INT8, frfile, chname, pos);
+        break;
+    case LAL_U2_TYPE_CODE:
+        INPUTFRTS(series, UINT2, frfile, chname, pos);
+        break;
+    case LAL_U4_TYPE_CODE:
+        INPUTFRTS(series, UINT4, frfile, chname, pos);
+        break;
+    case LAL_U8_TYPE_CODE:
+        INPUTFRTS(series, UINT8, frfile, chname, pos);
+        break;
+    case LAL_S_TYPE_CODE:
+        INPUTFRTS(series, REAL4, frfile, chname, pos);
+        break;
+    case LAL_D_TYPE_CODE:
+        series = XLALFrFileReadREAL8TimeSeries(frfile, chname, pos);
+        if (!series)
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        break;
+    case LAL_C_TYPE_CODE:
+    case LAL_Z_TYPE_CODE:
+        XLAL_PRINT_ERROR("Cannot convert complex type to float type");
+#if __GNUC__ >= 7 && !defined __INTEL_COMPILER
+	__attribute__ ((fallthrough));
+#endif
+    default:
+        XLAL_ERROR_NULL(XLAL_ETYPE);
+    }
+    return series;
+}
+
 /** @endcond */
 
 
@@ -556,6 +617,218 @@ COMPLEX16TimeSeries *XLALFrStreamInputCOMPLEX16TimeSeries(LALFrStream *
     return series;
 }
 
+/**
+ * @brief Reads several time series channels from a #LALFrStream stream
+ * with a specified start time and duration in a single pass, converting
+ * them to REAL8.
+ * @details
+ * This routine is equivalent to calling XLALFrStreamInputREAL8TimeSeries()
+ * for each of the @p nchan channels in @p chnames, but each frame of the
+ * stream is visited only once: all of the channels that are still needed
+ * are read from it together and are decompressed in parallel (see
+ * XLALFrFilePreloadChans()).  Reading @c k channels one at a time opens
+ * every frame file and looks up every frame @c k times; here each is done
+ * once, which is where most of the time goes when many auxiliary channels
+ * are read.
+ *
+ * The channels may have different sample rates; each series starts at the
+ * first sample of its channel at or after @p start.  If there is a gap in
+ * the data, all channels are read again from the next contiguous set of
+ * data of the required duration.  After the call the stream is positioned
+ * at the end of the shortest series returned.
+ * @param[out] series Array of @p nchan pointers which are set to new
+ * REAL8TimeSeries containing the data of each channel.  On failure all
+ * are set to NULL.
+ * @param stream Pointer to the #LALFrStream stream.
+ * @param chnames Array of @p nchan strings with the channel names to read.
+ * @param nchan The number of channels to read.
+ * @param start Pointer to a LIGOTimeGPS structure specifying the start time.
+ * @param duration The duration of the data to read, in seconds.
+ * @param lengthlimit The maximum number of points to read for each channel
+ * or 0 for unlimited.
+ * @retval 0 Success.
+ * @retval <0 Failure.
+ */
+int XLALFrStreamInputREAL8TimeSeriesMulti(REAL8TimeSeries ** series,
+    LALFrStream * stream, const char *const *chnames, size_t nchan,
+    const LIGOTimeGPS * start, double duration, size_t lengthlimit)
+{
+    const REAL8 fuzz = 0.1 / 16384.0;   /* smallest discernable time */
+    const char **pending = NULL;
+    size_t *have = NULL;
+    size_t npending;
+    size_t i;
+    LIGOTimeGPS tend;
+    INT8 tnow;
+    int errnum = XLAL_EFUNC;
+    int gap = 0;
+
+    XLAL_CHECK(series, XLAL_EFAULT);
+    XLAL_CHECK(chnames || !nchan, XLAL_EFAULT);
+    for (i = 0; i < nchan; ++i)
+        series[i] = NULL;
+    if (!nchan)
+        return 0;
+
+    if (XLALFrStreamSeek(stream, start))
+        XLAL_ERROR(XLAL_EFUNC);
+
+    pending = LALMalloc(nchan * sizeof(*pending));
+    have = LALCalloc(nchan, sizeof(*have));
+    if (!pending || !have) {
+        errnum = XLAL_ENOMEM;
+        goto failure;
+    }
+
+    /* get the metadata and the first part of the data of all channels
+     * from the current frame */
+    if (XLALFrFilePreloadChans(stream->file, chnames, nchan, stream->pos))
+        goto failure;
+    tnow = XLALGPSToINT8NS(&stream->epoch);
+    for (i = 0; i < nchan; ++i) {
+        REAL8TimeSeries *buffer;
+        LIGOTimeGPS epoch;
+        size_t length;
+        size_t noff;
+        INT8 tbeg;
+
+        buffer = XLALFrFileInputREAL8TimeSeries(stream->file, chnames[i],
+            stream->pos);
+        if (!buffer)
+            goto failure;
+        tbeg = XLALGPSToINT8NS(&buffer->epoch);
+
+        /* compute the number of points offset as in the single channel
+         * routines, allowing 1 millisecond of padding */
+        noff = ceil((1e-9 * (tnow - tbeg) - fuzz) / buffer->deltaT);
+        if (tnow + 1000 < tbeg || noff > buffer->data->length) {
+            XLALDestroyREAL8TimeSeries(buffer);
+            errnum = XLAL_ETIME;
+            goto failure;
+        }
+        XLALINT8NSToGPS(&epoch,
+            tbeg + floor(1e9 * noff * buffer->deltaT + 0.5));
+
+        length = duration / buffer->deltaT;
+        if (lengthlimit && (lengthlimit < length))
+            length = lengthlimit;
+        series[i] = XLALCreateREAL8TimeSeries(chnames[i], &epoch, 0.0,
+            buffer->deltaT, &buffer->sampleUnits, length);
+        if (!series[i]) {
+            XLALDestroyREAL8TimeSeries(buffer);
+            goto failure;
+        }
+
+        have[i] = buffer->data->length - noff < length ?
+            buffer->data->length - noff : length;
+        memcpy(series[i]->data->data, buffer->data->data + noff,
+            have[i] * sizeof(*buffer->data->data));
+        XLALDestroyREAL8TimeSeries(buffer);
+    }
+
+    /* continue while data is required by any channel */
+    while (1) {
+        int restart;
+
+        for (i = npending = 0; i < nchan; ++i)
+            if (have[i] < series[i]->data->length)
+                pending[npending++] = chnames[i];
+        if (!npending)
+            break;
+
+        /* goto next frame */
+        if (XLALFrStreamNext(stream) < 0)
+            goto failure;
+        if (stream->state & LAL_FR_STREAM_END) {
+            XLAL_PRINT_ERROR("End of frame stream while %zu channels remain to be read", npending);
+            errnum = XLAL_EIO;
+            goto failure;
+        }
+
+        /* gap in data: all channels start again here */
+        restart = stream->state & LAL_FR_STREAM_GAP;
+        if (restart) {
+            for (i = 0; i < nchan; ++i) {
+                pending[i] = chnames[i];
+                have[i] = 0;
+            }
+            npending = nchan;
+            gap = 1;
+        }
+
+        /* load more data */
+        if (XLALFrFilePreloadChans(stream->file, pending, npending,
+                stream->pos))
+            goto failure;
+        for (i = 0; i < nchan; ++i) {
+            REAL8TimeSeries *buffer;
+            size_t ncpy;
+            if (!restart && have[i] == series[i]->data->length)
+                continue;
+            buffer = XLALFrFileInputREAL8TimeSeries(stream->file,
+                chnames[i], stream->pos);
+            if (!buffer)
+                goto failure;
+            if (restart)
+                series[i]->epoch = buffer->epoch;
+            ncpy = series[i]->data->length - have[i];
+            if (buffer->data->length < ncpy)
+                ncpy = buffer->data->length;
+            memcpy(series[i]->data->data + have[i], buffer->data->data,
+                ncpy * sizeof(*buffer->data->data));
+            have[i] += ncpy;
+            XLALDestroyREAL8TimeSeries(buffer);
+        }
+    }
+
+    /* update stream start time so that it corresponds to the end of the
+     * shortest series */
+    for (i = 0; i < nchan; ++i) {
+        LIGOTimeGPS end = series[i]->epoch;
+        XLALGPSAdd(&end, series[i]->data->length * series[i]->deltaT);
+        if (i == 0 || XLALGPSCmp(&end, &stream->epoch) < 0)
+            stream->epoch = end;
+    }
+
+    /* are we still within the current frame? */
+    XLALFrFileQueryGTime(&tend, stream->file, stream->pos);
+    XLALGPSAdd(&tend, XLALFrFileQueryDt(stream->file, stream->pos));
+    if (XLALGPSCmp(&tend, &stream->epoch) <= 0) {
+        /* advance a frame, suppressing gap warnings as the single
+         * channel routines do */
+        int savemode = stream->mode;
+        LIGOTimeGPS saveepoch = stream->epoch;
+        stream->mode |= LAL_FR_STREAM_IGNOREGAP_MODE;
+        if (XLALFrStreamNext(stream) < 0) {
+            stream->mode = savemode;
+            goto failure;
+        }
+        if (!(stream->state & LAL_FR_STREAM_GAP))
+            stream->epoch = saveepoch;
+        stream->mode = savemode;
+    }
+
+    if (gap)
+        stream->state |= LAL_FR_STREAM_GAP;
+    if (stream->state & LAL_FR_STREAM_ERR) {
+        errnum = XLAL_EIO;
+        goto failure;
+    }
+
+    LALFree(pending);
+    LALFree(have);
+    return 0;
+
+  failure:
+    for (i = 0; i < nchan; ++i) {
+        XLALDestroyREAL8TimeSeries(series[i]);
+        series[i] = NULL;
+    }
+    LALFree(pending);
+    LALFree(have);
+    XLAL_ERROR(errnum);
+}
+
 /** @} */
 
 /**
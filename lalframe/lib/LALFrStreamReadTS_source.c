@@ -52,6 +52,11 @@ int STREAMGETSERIES(STYPE * series, LALFrStream * stream)
     XLAL_CHECK(!(stream->state & LAL_FR_STREAM_END), XLAL_EIO);
     XLAL_CHECK(!(stream->state & LAL_FR_STREAM_ERR), XLAL_EIO);
 
+    /* have the read-ahead thread decode this channel from now on */
+    if ((stream->mode & LAL_FR_STREAM_READAHEAD_MODE)
+        && XLALFrStreamReadAheadAddChan(stream, series->name) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+
     /* if series does not have allocation for data,
      * we are to return metadata only, so we don't
      * need to load data in the next call */
@@ -45,15 +45,80 @@
 #endif
 
 /** @cond */
+
+/* a channel that has been read (and expanded) ahead of time */
+struct tagLALFrFilePreload {
+    char *name;
+    size_t pos;
+    LALFrameUFrChan *channel;
+    struct tagLALFrFilePreload *next;
+};
+
 struct tagLALFrFile {
     LALFrameUFrFile *file;
     LALFrameUFrTOC *toc;
+    struct tagLALFrFilePreload *preload;
 };
+
+/* Returns the preloaded channel name at position pos, or NULL. */
+static LALFrameUFrChan *XLALFrFilePreloadFind(const LALFrFile * frfile,
+    const char *name, size_t pos)
+{
+    const struct tagLALFrFilePreload *preload;
+    for (preload = frfile->preload; preload; preload = preload->next)
+        if (preload->pos == pos && strcmp(preload->name, name) == 0)
+            return preload->channel;
+    return NULL;
+}
+
+/* Reads channel name at position pos in a frame file.  If the channel has
+ * been preloaded it is used instead: it is handed over to the caller if
+ * take is set, otherwise it is only lent and *borrowed is set, in which case
+ * the caller must not free it (see XLALFrFileChanRelease). */
+static LALFrameUFrChan *XLALFrFileChanRead(LALFrFile * frfile,
+    const char *name, size_t pos, int take, int *borrowed)
+{
+    struct tagLALFrFilePreload **link;
+    *borrowed = 0;
+    if (!take) {
+        LALFrameUFrChan *channel = XLALFrFilePreloadFind(frfile, name, pos);
+        if (channel) {
+            *borrowed = 1;
+            return channel;
+        }
+    } else
+        for (link = &frfile->preload; *link; link = &(*link)->next) {
+            struct tagLALFrFilePreload *preload = *link;
+            if (preload->pos == pos && strcmp(preload->name, name) == 0) {
+                LALFrameUFrChan *channel = preload->channel;
+                *link = preload->next;
+                LALFree(preload->name);
+                LALFree(preload);
+                return channel;
+            }
+        }
+    return XLALFrameUFrChanRead(frfile->file, name, pos);
+}
+
+static void XLALFrFileChanRelease(LALFrameUFrChan * channel, int borrowed)
+{
+    if (!borrowed)
+        XLALFrameUFrChanFree(channel);
+    return;
+}
+
 /** @endcond */
 
 int XLALFrFileClose(LALFrFile * frfile)
 {
     if (frfile) {
+        while (frfile->preload) {
+            struct tagLALFrFilePreload *next = frfile->preload->next;
+            XLALFrameUFrChanFree(frfile->preload->channel);
+            LALFree(frfile->preload->name);
+            LALFree(frfile->preload);
+            frfile->preload = next;
+        }
         if (frfile->file) {
             XLALFrameUFrFileClose(frfile->file);
             frfile->file = NULL;
@@ -111,6 +176,7 @@ LALFrFile *XLALFrFileOpenURL(const char *url)
     frfile = LALMalloc(sizeof(*frfile));
     if (!frfile)
         XLAL_ERROR_NULL(XLAL_ENOMEM);
+    frfile->preload = NULL;
     frfile->file = XLALFrameUFrFileOpen(path, "r");
     if (!frfile->file) {
         LALFree(frfile);
@@ -127,6 +193,75 @@ LALFrFile *XLALFrFileOpenURL(const char *url)
     return frfile;
 }
 
+int XLALFrFilePreloadChan(LALFrFile * frfile, const char *chname, size_t pos)
+{
+    XLAL_CHECK(chname, XLAL_EFAULT);
+    if (XLALFrFilePreloadChans(frfile, &chname, 1, pos) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    return 0;
+}
+
+int XLALFrFilePreloadChans(LALFrFile * frfile, const char *const *chnames,
+    size_t nchan, size_t pos)
+{
+    LALFrameUFrChan **expand;
+    size_t nexpand = 0;
+    size_t i;
+    int status;
+
+    XLAL_CHECK(frfile, XLAL_EFAULT);
+    XLAL_CHECK(chnames || !nchan, XLAL_EFAULT);
+    if (!nchan)
+        return 0;
+
+    expand = LALMalloc(nchan * sizeof(*expand));
+    if (!expand)
+        XLAL_ERROR(XLAL_ENOMEM);
+
+    /* the frame file cannot be shared between threads, so the channels
+     * are read one after another and stored still compressed; anything
+     * already preloaded (including repeated names) is skipped */
+    for (i = 0; i < nchan; ++i) {
+        struct tagLALFrFilePreload *preload;
+        LALFrameUFrChan *channel;
+        int borrowed;
+
+        if (!chnames[i]) {
+            LALFree(expand);
+            XLAL_ERROR(XLAL_EFAULT);
+        }
+        channel = XLALFrFileChanRead(frfile, chnames[i], pos, 0, &borrowed);
+        if (borrowed)
+            continue;
+        if (!channel) {
+            LALFree(expand);
+            XLAL_ERROR(XLAL_ENAME, "Could not read channel %s", chnames[i]);
+        }
+        preload = LALMalloc(sizeof(*preload));
+        if (!preload || !(preload->name = XLALStringDuplicate(chnames[i]))) {
+            LALFree(preload);
+            XLALFrameUFrChanFree(channel);
+            LALFree(expand);
+            XLAL_ERROR(XLAL_ENOMEM);
+        }
+        preload->pos = pos;
+        preload->channel = channel;
+        preload->next = frfile->preload;
+        frfile->preload = preload;
+        expand[nexpand++] = channel;
+    }
+
+    /* decompression only touches the channel itself so it is done in
+     * parallel; a channel that fails here stays on the list and the error
+     * is raised again when it is read */
+    status = XLALFrameUFrChanVectorExpandMulti(expand, nexpand);
+
+    LALFree(expand);
+    if (status < 0)
+        XLAL_ERROR(XLAL_EFUNC, "Could not expand channel data");
+    return 0;
+}
+
 size_t XLALFrFileQueryNFrame(const LALFrFile * frfile)
 {
     return XLALFrameUFrTOCQueryNFrame(frfile->toc);
@@ -150,11 +285,17 @@ LALTYPECODE XLALFrFileQueryChanType(const LALFrFile * frfile,
 {
     LALFrameUFrChan *channel;
     int type;
-    channel = XLALFrameUFrChanRead(frfile->file, chname, pos);
-    if (!channel)
-        XLAL_ERROR(XLAL_ENAME);
-    type = XLALFrameUFrChanVectorQueryType(channel);
-    XLALFrameUFrChanFree(channel);
+    /* preloaded channels need not be read again */
+    channel = XLALFrFilePreloadFind(frfile, chname, pos);
+    if (channel)
+        type = XLALFrameUFrChanVectorQueryType(channel);
+    else {
+        channel = XLALFrameUFrChanRead(frfile->file, chname, pos);
+        if (!channel)
+            XLAL_ERROR(XLAL_ENAME);
+        type = XLALFrameUFrChanVectorQueryType(channel);
+        XLALFrameUFrChanFree(channel);
+    }
     switch (type) {
     case LAL_FRAMEU_FR_VECT_C:
         return LAL_CHAR_TYPE_CODE;
@@ -194,6 +335,9 @@ size_t XLALFrFileQueryChanVectorLength(const LALFrFile * frfile,
 {
     LALFrameUFrChan *channel;
     size_t length;
+    channel = XLALFrFilePreloadFind(frfile, chname, pos);
+    if (channel)
+        return XLALFrameUFrChanVectorQueryNData(channel);
     channel = XLALFrameUFrChanRead(frfile->file, chname, pos);
     if (!channel)
         XLAL_ERROR(XLAL_ENAME);
@@ -202,6 +346,33 @@ size_t XLALFrFileQueryChanVectorLength(const LALFrFile * frfile,
     return length;
 }
 
+size_t XLALFrFileQueryChanN(const LALFrFile * frfile)
+{
+    size_t nadc, nsim, nproc;
+    nadc = XLALFrameUFrTOCQueryAdcN(frfile->toc);
+    nsim = XLALFrameUFrTOCQuerySimN(frfile->toc);
+    nproc = XLALFrameUFrTOCQueryProcN(frfile->toc);
+    if (nadc == (size_t)(-1) || nsim == (size_t)(-1) || nproc == (size_t)(-1))
+        XLAL_ERROR(XLAL_EFUNC);
+    return nadc + nsim + nproc;
+}
+
+const char *XLALFrFileQueryChanName(const LALFrFile * frfile, size_t chan)
+{
+    size_t nadc, nsim;
+    nadc = XLALFrameUFrTOCQueryAdcN(frfile->toc);
+    if (chan < nadc)
+        return XLALFrameUFrTOCQueryAdcName(frfile->toc, chan);
+    chan -= nadc;
+    nsim = XLALFrameUFrTOCQuerySimN(frfile->toc);
+    if (chan < nsim)
+        return XLALFrameUFrTOCQuerySimName(frfile->toc, chan);
+    chan -= nsim;
+    if (chan < XLALFrameUFrTOCQueryProcN(frfile->toc))
+        return XLALFrameUFrTOCQueryProcName(frfile->toc, chan);
+    XLAL_ERROR_NULL(XLAL_EINVAL, "Channel index out of range");
+}
+
 int XLALFrFileCksumValid(LALFrFile * frfile)
 {
     int result;
@@ -94,6 +94,38 @@ LALFrFile *XLALFrFileOpenURL(const char *url);
  */
 int XLALFrFileCksumValid(LALFrFile * frfile);
 
+/**
+ * @brief Read and decompress a channel ahead of time.
+ * @details
+ * The channel @p chname of frame @p pos is read from the file and expanded
+ * now, and kept with the #LALFrFile so that a later read of the same
+ * channel and frame, e.g. with XLALFrFileReadREAL8TimeSeries(), does not
+ * need to access the file.  This is used by the read-ahead mode of
+ * #LALFrStream.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame within the file.
+ * @retval 0 Success.
+ * @retval <0 Failure, e.g. the channel does not exist.
+ */
+int XLALFrFilePreloadChan(LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Read and decompress several channels ahead of time.
+ * @details
+ * As XLALFrFilePreloadChan(), but for the @p nchan channels listed in
+ * @p chnames.  The channels are read from the file in turn and are then
+ * decompressed in parallel when OpenMP is enabled.  Channels that have
+ * already been preloaded are skipped.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chnames Array of strings containing the names of the channels.
+ * @param nchan The number of channels in @p chnames.
+ * @param pos The index of the frame within the file.
+ * @retval 0 Success.
+ * @retval <0 Failure, e.g. one of the channels does not exist.
+ */
+int XLALFrFilePreloadChans(LALFrFile * frfile, const char *const *chnames, size_t nchan, size_t pos);
+
 /** @} */
 
 /**
@@ -160,6 +192,30 @@ LALTYPECODE XLALFrFileQueryChanType(const LALFrFile * frfile, const char *chname
  */
 size_t XLALFrFileQueryChanVectorLength(const LALFrFile * frfile, const char *chname, size_t pos);
 
+/**
+ * @brief Query a frame file for the number of channels listed in its table
+ * of contents.
+ * @details
+ * The channels counted are the ADC, simulated, and processed data channels,
+ * in that order.
+ * @param[in] frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @returns The number of channels.
+ * @retval (size_t)(-1) Failure.
+ */
+size_t XLALFrFileQueryChanN(const LALFrFile * frfile);
+
+/**
+ * @brief Query a frame file for the name of a channel listed in its table
+ * of contents.
+ * @param[in] frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param[in] chan The index of the channel, less than XLALFrFileQueryChanN().
+ * @returns Pointer to a string containing the channel name.
+ * @retval NULL Failure.
+ * @warning The pointer returned is shallow and will be left dangling
+ * when the frame file is closed.
+ */
+const char *XLALFrFileQueryChanName(const LALFrFile * frfile, size_t chan);
+
 /** @} */
 
 /**
@@ -498,6 +554,206 @@ COMPLEX16FrequencySeries *XLALFrFileReadCOMPLEX16FrequencySeries(LALFrFile * frf
 
 /** @} */
 
+/**
+ * @name Routines to Read Channel Data into Existing Series
+ * @details
+ * These routines are like the routines above except that the data are
+ * copied straight from the frame library's decoded vector into the data
+ * of an existing series, so no series is allocated for each frame.  This
+ * allows a caller to keep a single, suitably sized and aligned buffer.
+ * Sample @c k of the channel is stored at index
+ * <tt>(offset + k * stride) % series->data->length</tt>: a @p stride
+ * greater than one interleaves several channels, and the indices wrap
+ * around the end of the data so that frames can be appended to a ring
+ * buffer.  The metadata of the series are set to those of the channel;
+ * the epoch is the time of the sample stored at index @p offset.
+ * @{
+ */
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #INT2TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadINT2TimeSeriesInto(INT2TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #INT4TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadINT4TimeSeriesInto(INT4TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #INT8TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadINT8TimeSeriesInto(INT8TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #UINT2TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadUINT2TimeSeriesInto(UINT2TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #UINT4TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadUINT4TimeSeriesInto(UINT4TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #UINT8TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadUINT8TimeSeriesInto(UINT8TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #REAL4TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadREAL4TimeSeriesInto(REAL4TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #REAL8TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadREAL8TimeSeriesInto(REAL8TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #COMPLEX8TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadCOMPLEX8TimeSeriesInto(COMPLEX8TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #COMPLEX16TimeSeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadCOMPLEX16TimeSeriesInto(COMPLEX16TimeSeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #REAL4FrequencySeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadREAL4FrequencySeriesInto(REAL4FrequencySeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #REAL8FrequencySeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadREAL8FrequencySeriesInto(REAL8FrequencySeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #COMPLEX8FrequencySeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadCOMPLEX8FrequencySeriesInto(COMPLEX8FrequencySeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/**
+ * @brief Reads data from a channel in a frame into an existing series.
+ * @param series Pointer to the #COMPLEX16FrequencySeries whose data are to be set.
+ * @param offset Index in the series data at which to store the first sample.
+ * @param stride Distance between successive samples in the series data.
+ * @param frfile Pointer to a #LALFrFile structure associated with a frame file.
+ * @param chname String containing the name of the channel.
+ * @param pos The index of the frame in the frame file.
+ * @returns The number of samples read.
+ * @retval <0 Failure, e.g., the series is too short to hold the samples.
+ */
+int XLALFrFileReadCOMPLEX16FrequencySeriesInto(COMPLEX16FrequencySeries * series, size_t offset, size_t stride, LALFrFile * frfile, const char *chname, size_t pos);
+
+/** @} */
+
 /** @} */
 
 /**
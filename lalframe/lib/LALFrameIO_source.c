@@ -30,47 +30,36 @@
 #define VTYPE CONCAT2(LAL_FRAMEU_FR_VECT_, VEXT)
 #if DOM == TDOM
 #define STYPE CONCAT2(TYPE,TimeSeries)
+#define DELTA deltaT
 #elif DOM == FDOM
 #define STYPE CONCAT2(TYPE,FrequencySeries)
+#define DELTA deltaF
 #endif
 
 #define CFUNC CONCAT2(XLALCreate,STYPE)
 #define RFUNC CONCAT2(XLALFrFileRead,STYPE)
 #define MFUNC CONCAT3(XLALFrFileRead,STYPE,Metadata)
+#define IFUNC CONCAT3(XLALFrFileRead,STYPE,Into)
 #define FUNC_ CONCAT3(XLALFrFileRead,STYPE,_)
+#define META_ CONCAT3(XLALFrFileRead,STYPE,Meta_)
 
-static STYPE *FUNC_(LALFrFile * stream, const char *name, size_t pos,
-    int load)
+/* checks the channel and works out the metadata of the series */
+static int META_(LIGOTimeGPS * epoch, double *deltaX, LALUnit * sampleUnits,
+    LALFrFile * stream, LALFrameUFrChan * channel, size_t pos)
 {
-    STYPE *series;
-    LALFrameUFrChan *channel;
 #   if 0
     const char *unitX;
 #   endif
     const char *unitY;
-    LALUnit sampleUnits;
-    LIGOTimeGPS epoch;
-    double deltaX;
-    size_t length;
-    size_t bytes;
-    void *data;
     int errnum;
 
-    channel = XLALFrameUFrChanRead(stream->file, name, pos);
-    if (!channel)
-        XLAL_ERROR_NULL(XLAL_ENAME);
-
     /* make sure it is 1d */
-    if (XLALFrameUFrChanVectorQueryNDim(channel) != 1) {
-        XLALFrameUFrChanFree(channel);
-        XLAL_ERROR_NULL(XLAL_EDIMS);
-    }
+    if (XLALFrameUFrChanVectorQueryNDim(channel) != 1)
+        XLAL_ERROR(XLAL_EDIMS);
 
     /* check type */
-    if (XLALFrameUFrChanVectorQueryType(channel) != VTYPE) {
-        XLALFrameUFrChanFree(channel);
-        XLAL_ERROR_NULL(XLAL_ETYPE);
-    }
+    if (XLALFrameUFrChanVectorQueryType(channel) != VTYPE)
+        XLAL_ERROR(XLAL_ETYPE);
 
     /* make sure units are correct and figure out unitY */
 #   if 0
@@ -81,35 +70,57 @@ static STYPE *FUNC_(LALFrFile * stream, const char *name, size_t pos,
 #   if DOM == TDOM
     if (strcmp(unitX, "s") && strcmp(unitX, "time")) {
         /* doesn't seem to be a tseries */
-        XLALFrameUFrChanFree(channel);
-        XLAL_ERROR_NULL(XLAL_EUNIT);
+        XLAL_ERROR(XLAL_EUNIT);
     }
 #   elif DOM == FDOM
     if (strcmp(unitX, "s^-1") && strcmp(unitX, "Hz")) {
         /* doesn't seem to be a fseries */
-        XLALFrameUFrChanFree(channel);
-        XLAL_ERROR_NULL(XLAL_EUNIT);
+        XLAL_ERROR(XLAL_EUNIT);
     }
 #   endif
 #   endif
-    XLAL_TRY(XLALParseUnitString(&sampleUnits, unitY), errnum);
+    XLAL_TRY(XLALParseUnitString(sampleUnits, unitY), errnum);
     if (errnum) {
         XLAL_PRINT_WARNING("Could not parse unit string %s\n", unitY);
-        sampleUnits = lalDimensionlessUnit;
+        *sampleUnits = lalDimensionlessUnit;
     }
 
-    XLALFrFileQueryGTime(&epoch, stream, pos);
-    XLALGPSAdd(&epoch, XLALFrameUFrChanQueryTimeOffset(channel));
+    XLALFrFileQueryGTime(epoch, stream, pos);
+    XLALGPSAdd(epoch, XLALFrameUFrChanQueryTimeOffset(channel));
 #   if DOM == TDOM
-    XLALGPSAdd(&epoch, XLALFrameUFrChanVectorQueryStartX(channel, 0));
+    XLALGPSAdd(epoch, XLALFrameUFrChanVectorQueryStartX(channel, 0));
 #   endif
-    deltaX = XLALFrameUFrChanVectorQueryDx(channel, 0);
+    *deltaX = XLALFrameUFrChanVectorQueryDx(channel, 0);
+    return 0;
+}
+
+static STYPE *FUNC_(LALFrFile * stream, const char *name, size_t pos,
+    int load)
+{
+    STYPE *series;
+    LALFrameUFrChan *channel;
+    LALUnit sampleUnits;
+    LIGOTimeGPS epoch;
+    double deltaX;
+    size_t length;
+    size_t bytes;
+    void *data;
+    int borrowed;
+
+    channel = XLALFrFileChanRead(stream, name, pos, load, &borrowed);
+    if (!channel)
+        XLAL_ERROR_NULL(XLAL_ENAME);
+
+    if (META_(&epoch, &deltaX, &sampleUnits, stream, channel, pos) < 0) {
+        XLALFrFileChanRelease(channel, borrowed);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
     length = XLALFrameUFrChanVectorQueryNData(channel);
 
     if (!load) {
         /* not expected to load the data vector
          * so exit now with a zero-length vector */
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(channel, borrowed);
         series = CFUNC(name, &epoch, 0.0, deltaX, &sampleUnits, 0);
         if (!series)
             XLAL_ERROR_NULL(XLAL_EFUNC);
@@ -119,24 +130,24 @@ static STYPE *FUNC_(LALFrFile * stream, const char *name, size_t pos,
     XLALFrameUFrChanVectorExpand(channel);
     data = XLALFrameUFrChanVectorQueryData(channel);
     if (!data) {
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(channel, borrowed);
         XLAL_ERROR_NULL(XLAL_EDATA);
     }
     bytes = XLALFrameUFrChanVectorQueryNBytes(channel);
     /* make sure bytes, type, and length are sane */
     if (bytes != length * sizeof(TYPE)) {
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(channel, borrowed);
         XLAL_ERROR_NULL(XLAL_EBADLEN);
     }
 
     series = CFUNC(name, &epoch, 0.0, deltaX, &sampleUnits, length);
     if (!series) {
-        XLALFrameUFrChanFree(channel);
+        XLALFrFileChanRelease(channel, borrowed);
         XLAL_ERROR_NULL(XLAL_EFUNC);
     }
     memcpy(series->data->data, data, bytes);
 
-    XLALFrameUFrChanFree(channel);
+    XLALFrFileChanRelease(channel, borrowed);
     return series;
 }
 
@@ -150,10 +161,88 @@ STYPE *RFUNC(LALFrFile * stream, const char *chname, size_t pos)
     return FUNC_(stream, chname, pos, 1);
 }
 
+int IFUNC(STYPE * series, size_t offset, size_t stride, LALFrFile * stream,
+    const char *chname, size_t pos)
+{
+    LALFrameUFrChan *channel;
+    LALUnit sampleUnits;
+    LIGOTimeGPS epoch;
+    double deltaX;
+    const TYPE *data;
+    TYPE *dest;
+    size_t length;
+    size_t size;
+    size_t i;
+    int borrowed;
+
+    XLAL_CHECK(series && series->data, XLAL_EFAULT);
+    XLAL_CHECK(series->data->data || !series->data->length, XLAL_EFAULT);
+    XLAL_CHECK(chname, XLAL_EFAULT);
+    XLAL_CHECK(stride > 0, XLAL_EINVAL, "Stride must be positive");
+
+    channel = XLALFrFileChanRead(stream, chname, pos, 1, &borrowed);
+    if (!channel)
+        XLAL_ERROR(XLAL_ENAME);
+
+    if (META_(&epoch, &deltaX, &sampleUnits, stream, channel, pos) < 0) {
+        XLALFrFileChanRelease(channel, borrowed);
+        XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    XLALFrameUFrChanVectorExpand(channel);
+    data = XLALFrameUFrChanVectorQueryData(channel);
+    length = XLALFrameUFrChanVectorQueryNData(channel);
+    if (!data) {
+        XLALFrFileChanRelease(channel, borrowed);
+        XLAL_ERROR(XLAL_EDATA);
+    }
+    /* make sure bytes, type, and length are sane */
+    if (XLALFrameUFrChanVectorQueryNBytes(channel) != length * sizeof(TYPE)) {
+        XLALFrFileChanRelease(channel, borrowed);
+        XLAL_ERROR(XLAL_EBADLEN);
+    }
+
+    /* the samples must not overwrite one another */
+    size = series->data->length;
+    if (length * stride > size) {
+        XLALFrFileChanRelease(channel, borrowed);
+        XLAL_ERROR(XLAL_EBADLEN, "Channel %s has %zu samples but the series "
+            "only has room for %zu", chname, length, size / stride);
+    }
+
+    /* copy straight out of the frame library's vector, wrapping around the
+     * end of the series; contiguous samples take at most two memcpy()s */
+    dest = series->data->data;
+    if (size)
+        offset %= size;
+    if (stride == 1) {
+        size_t ncpy = length < size - offset ? length : size - offset;
+        memcpy(dest + offset, data, ncpy * sizeof(TYPE));
+        memcpy(dest, data + ncpy, (length - ncpy) * sizeof(TYPE));
+    } else
+        for (i = 0; i < length; ++i) {
+            dest[offset] = data[i];
+            offset += stride;
+            if (offset >= size)
+                offset -= size;
+        }
+    XLALFrFileChanRelease(channel, borrowed);
+
+    XLALStringCopy(series->name, chname, sizeof(series->name));
+    series->epoch = epoch;
+    series->f0 = 0.0;
+    series->DELTA = deltaX;
+    series->sampleUnits = sampleUnits;
+    return length;
+}
+
 #undef FUNC_
+#undef META_
+#undef IFUNC
 #undef MFUNC
 #undef RFUNC
 #undef CFUNC
+#undef DELTA
 #undef STYPE
 #undef VTYPE
 #undef CONCAT2x
@@ -24,6 +24,10 @@
 #include <lal/XLALError.h>
 #include <lal/LALFrameU.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 enum {
     LAL_FRAMEU_FRAME_LIBRARY_UNAVAILABLE,
     LAL_FRAMEU_FRAME_LIBRARY_FRAMEL,
@@ -122,6 +126,16 @@ static int XLALFrameLibrary(void)
     return lalFrameLibrary;
 }
 
+int XLALFrameUThreadSafe(void)
+{
+    switch (XLALFrameLibrary()) {
+    case LAL_FRAMEU_FRAME_LIBRARY_FRAMEC:
+        return 1;
+    default:   /* FrameL has global state */
+        return 0;
+    }
+}
+
 void XLALFrameUFrFileClose(LALFrameUFrFile * stream)
 {
     FRAME_LIBRARY_SELECT_VOID(XLALFrameUFrFileClose, stream);
@@ -337,6 +351,33 @@ int XLALFrameUFrChanVectorExpand(LALFrameUFrChan * channel)
     FRAME_LIBRARY_SELECT(XLALFrameUFrChanVectorExpand, channel);
 }
 
+int XLALFrameUFrChanVectorExpandMulti(LALFrameUFrChan * const *channels,
+    size_t nchannel)
+{
+    size_t i;
+    int failed = 0;
+
+    if (!nchannel)
+        return 0;
+    if (!channels)
+        XLAL_ERROR(XLAL_EFAULT);
+
+    /* select the frame library before any threads are started */
+    if (XLALFrameLibrary() == LAL_FRAMEU_FRAME_LIBRARY_UNAVAILABLE)
+        XLAL_ERROR(XLAL_EFUNC);
+
+#pragma omp parallel for schedule(dynamic) if(XLALFrameUThreadSafe())
+    for (i = 0; i < nchannel; ++i)
+        if (XLALFrameUFrChanVectorExpand(channels[i]) < 0) {
+#pragma omp atomic write
+            failed = 1;
+        }
+
+    if (failed)
+        XLAL_ERROR(XLAL_EFUNC, "Could not expand channel data");
+    return 0;
+}
+
 const char *XLALFrameUFrChanVectorQueryName(const LALFrameUFrChan * channel)
 {
     FRAME_LIBRARY_SELECT_NULL(XLALFrameUFrChanVectorQueryName, channel);
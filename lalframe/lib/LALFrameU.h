@@ -242,6 +242,20 @@ enum LALFrameUFrProcDataSubType {
 int XLALFrameUFrFileIGWDVersion(LALFrameUFrFile *stream);
 */
 
+/**
+ * @brief Query whether the frame library allows distinct frame files and
+ * structures to be used concurrently from different threads.
+ * @details
+ * FrameL keeps global state and is treated as not thread safe; FrameC is
+ * thread safe.  Routines that would otherwise access frame files from
+ * several threads (e.g., the read-ahead mode of a frame stream) fall back
+ * to serial access when this returns 0.  The first call must not be made
+ * concurrently with other calls to LALFrameU routines.
+ * @retval 1 The frame library is thread safe.
+ * @retval 0 The frame library is not thread safe or none is available.
+ */
+int XLALFrameUThreadSafe(void);
+
 /**
  * @name FrFile Routines
  * @{
@@ -894,6 +908,22 @@ int XLALFrameUFrChanVectorCompress(LALFrameUFrChan * channel, int compressLevel)
  */
 int XLALFrameUFrChanVectorExpand(LALFrameUFrChan * channel);
 
+/**
+ * @brief Expands the FrVect structures within several FrChan structures.
+ * @details
+ * This is equivalent to calling XLALFrameUFrChanVectorExpand() on each
+ * channel in turn, but the channels are expanded in parallel when OpenMP
+ * is enabled and the frame library is thread safe (see
+ * XLALFrameUThreadSafe()).  The channels must be distinct and must not be
+ * in use by another thread.
+ * @param channels Array of pointers to the FrChan structures to be modified.
+ * @param nchannel Number of channels.
+ * @retval 0 Success.
+ * @retval <0 Failure: one or more of the channels could not be expanded.
+ */
+int XLALFrameUFrChanVectorExpandMulti(LALFrameUFrChan * const *channels,
+    size_t nchannel);
+
 /** @} */
 
 /**
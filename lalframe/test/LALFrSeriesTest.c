@@ -35,13 +35,21 @@
  *
  * This program reads the channels <tt>H1:LSC-AS_Q</tt> from all the fake frames
  * <tt>F-TEST-*.gwf</tt> in the directory TEST_DATA_DIR, and prints them to files.
+ * It also writes frame files <tt>X-LALFrSeriesTest-*.gwf</tt> holding two
+ * channels with different sample rates, and reads them back together.
  *
  */
 
+#include <math.h>
 #include <stdio.h>
 #include <lal/LALStdlib.h>
+#include <lal/LALStdio.h>
+#include <lal/Date.h>
 #include <lal/AVFactories.h>
 #include <lal/PrintFTSeries.h>
+#include <lal/Units.h>
+#include <lal/TimeSeries.h>
+#include <lal/LALFrameIO.h>
 #include <lal/LALFrStream.h>
 
 #define TESTSTATUS( pstat ) \
@@ -128,6 +136,189 @@ int main( void )
   LALI4DestroyVector( &status, &chan.data );
   TESTSTATUS( &status );
 
+  /* reading several channels of different sample rates in one pass must
+   * agree with reading them one at a time, across frame file boundaries */
+  {
+    const char *chnames[] = { "X1:LALFRSERIESTEST_FAST", "X1:LALFRSERIESTEST_SLOW" };
+    const REAL8 rates[] = { 1024.0, 64.0 };
+    REAL8TimeSeries *multi[2];
+    LIGOTimeGPS start = { 600000001, 300000000 };
+    UINT4 i, j, k;
+
+    /* three 4 s files; each sample holds its index from the start of the data */
+    for ( k = 0; k < 3; ++k )
+    {
+      LIGOTimeGPS t0 = { 600000000 + 4 * k, 0 };
+      LALFrameH *frame;
+      CHAR fname[256];
+      frame = XLALFrameNew( &t0, 4.0, "LALFrSeriesTest", 0, k, 0 );
+      if ( ! frame )
+        return 1;
+      for ( j = 0; j < 2; ++j )
+      {
+        REAL8TimeSeries *series = XLALCreateREAL8TimeSeries( chnames[j], &t0, 0.0, 1.0 / rates[j], &lalDimensionlessUnit, 4 * rates[j] );
+        if ( ! series )
+          return 1;
+        for ( i = 0; i < series->data->length; ++i )
+          series->data->data[i] = k * series->data->length + i;
+        if ( XLALFrameAddREAL8TimeSeriesProcData( frame, series ) < 0 )
+          return 1;
+        XLALDestroyREAL8TimeSeries( series );
+      }
+      snprintf( fname, sizeof( fname ), "X-LALFrSeriesTest-%d-4.gwf", t0.gpsSeconds );
+      if ( XLALFrameWrite( frame, fname ) < 0 )
+        return 1;
+      XLALFrameFree( frame );
+    }
+
+    stream = XLALFrStreamOpen( ".", "X-LALFrSeriesTest-*.gwf" );
+    if ( ! stream )
+      return 1;
+    if ( XLALFrStreamInputREAL8TimeSeriesMulti( multi, stream, chnames, 2, &start, 9.0, 0 ) < 0 )
+      return 1;
+    for ( j = 0; j < 2; ++j )
+    {
+      REAL8TimeSeries *single = XLALFrStreamInputREAL8TimeSeries( stream, chnames[j], &start, 9.0, 0 );
+      if ( ! single )
+        return 1;
+      if ( multi[j]->data->length != single->data->length || multi[j]->deltaT != single->deltaT || XLALGPSCmp( &multi[j]->epoch, &single->epoch ) )
+      {
+        fprintf( stderr, "Wrong series from multi-channel read!\n" );
+        return 1;
+      }
+      if ( multi[j]->data->length != 9 * rates[j] || multi[j]->deltaT != 1.0 / rates[j] || multi[j]->data->data[0] != ceil( 1.3 * rates[j] ) )
+      {
+        fprintf( stderr, "Wrong series from multi-channel read of %s!\n", chnames[j] );
+        return 1;
+      }
+      for ( i = 0; i < single->data->length; ++i )
+        if ( multi[j]->data->data[i] != single->data->data[i] || multi[j]->data->data[i] != multi[j]->data->data[0] + i )
+        {
+          fprintf( stderr, "Wrong data from multi-channel read!\n" );
+          return 1;
+        }
+      XLALDestroyREAL8TimeSeries( single );
+      XLALDestroyREAL8TimeSeries( multi[j] );
+    }
+    XLALFrStreamClose( stream );
+    for ( k = 0; k < 3; ++k )
+    {
+      CHAR fname[256];
+      snprintf( fname, sizeof( fname ), "X-LALFrSeriesTest-%d-4.gwf", 600000000 + 4 * k );
+      remove( fname );
+    }
+  }
+
+  /* reading into an existing series must agree with a normal read, also
+   * when the samples wrap around the end of the series */
+  {
+    INT4TimeSeries *series;
+    INT4TimeSeries *ring;
+    size_t offset;
+    UINT4 i;
+
+    stream = XLALFrStreamOpen( TEST_DATA_DIR, "F-TEST-*.gwf" );
+    if ( ! stream )
+      return 1;
+    series = XLALFrFileReadINT4TimeSeries( stream->file, CHANNEL, stream->pos );
+    if ( ! series )
+      return 1;
+    ring = XLALCreateINT4TimeSeries( "", &epoch, 0.0, 0.0, &lalDimensionlessUnit, 2 * series->data->length );
+    if ( ! ring )
+      return 1;
+    offset = ring->data->length - 3;
+    if ( XLALFrFileReadINT4TimeSeriesInto( ring, offset, 1, stream->file, CHANNEL, stream->pos ) != (int)series->data->length )
+      return 1;
+    if ( XLALGPSCmp( &ring->epoch, &series->epoch ) || ring->deltaT != series->deltaT )
+    {
+      fprintf( stderr, "Wrong series from read into existing series!\n" );
+      return 1;
+    }
+    for ( i = 0; i < series->data->length; ++i )
+      if ( ring->data->data[( offset + i ) % ring->data->length] != series->data->data[i] )
+      {
+        fprintf( stderr, "Wrong data from read into existing series!\n" );
+        return 1;
+      }
+    XLALDestroyINT4TimeSeries( ring );
+    XLALDestroyINT4TimeSeries( series );
+    XLALFrStreamClose( stream );
+  }
+
+  /* reading with read-ahead must agree with reading files on demand,
+   * also after seeking backwards out of the read-ahead queue */
+  {
+    LALFrStream *streams[2];
+    LALFrStreamStats stats[2];
+    LIGOTimeGPS start;
+    UINT4 i, k;
+    int n;
+
+    for ( k = 0; k < 2; ++k )
+    {
+      streams[k] = XLALFrStreamOpen( TEST_DATA_DIR, "F-TEST-*.gwf" );
+      if ( ! streams[k] )
+        return 1;
+    }
+    if ( XLALFrStreamSetMode( streams[1], LAL_FR_STREAM_DEFAULT_MODE | LAL_FR_STREAM_READAHEAD_MODE ) < 0 )
+      return 1;
+    if ( XLALFrStreamSetReadAheadDepth( streams[1], 1 ) < 0 || XLALFrStreamReadAheadAddChan( streams[1], CHANNEL ) < 0 )
+      return 1;
+
+    /* n = 9 reads through the three files, then one after a seek back */
+    for ( n = 0; n < 10; ++n )
+    {
+      INT4TimeSeries *series[2];
+      if ( n < 9 )
+        XLALGPSSet( &start, 600000000 + 20 * n, 0 );
+      else
+        start = epoch;
+      for ( k = 0; k < 2; ++k )
+      {
+        series[k] = XLALFrStreamReadINT4TimeSeries( streams[k], CHANNEL, &start, 20.0, 0 );
+        if ( ! series[k] )
+          return 1;
+      }
+      if ( series[0]->data->length != series[1]->data->length || XLALGPSCmp( &series[0]->epoch, &series[1]->epoch ) )
+      {
+        fprintf( stderr, "Wrong series from read-ahead stream!\n" );
+        return 1;
+      }
+      for ( i = 0; i < series[0]->data->length; ++i )
+        if ( series[0]->data->data[i] != series[1]->data->data[i] )
+        {
+          fprintf( stderr, "Wrong data from read-ahead stream!\n" );
+          return 1;
+        }
+      XLALDestroyINT4TimeSeries( series[1] );
+      XLALDestroyINT4TimeSeries( series[0] );
+    }
+
+    /* both readers opened the same files; only read-ahead has them ready */
+    for ( k = 0; k < 2; ++k )
+      if ( XLALFrStreamGetStats( &stats[k], streams[k] ) < 0 )
+        return 1;
+    if ( stats[1].nopen != stats[0].nopen || stats[0].nready != 0 || stats[1].nready > stats[1].nopen )
+    {
+      fprintf( stderr, "Wrong stream statistics!\n" );
+      return 1;
+    }
+    for ( k = 0; k < 2; ++k )
+      if ( stats[k].stall < 0.0 || stats[k].maxstall < 0.0 || stats[k].maxstall > stats[k].stall )
+      {
+        fprintf( stderr, "Wrong stream statistics!\n" );
+        return 1;
+      }
+    printf( "files opened: %" LAL_UINT8_FORMAT ", ready in advance: %" LAL_UINT8_FORMAT " (read-ahead) %" LAL_UINT8_FORMAT " (on demand)\n",
+            stats[1].nopen, stats[1].nready, stats[0].nready );
+
+    /* turning read-ahead off again leaves a working stream */
+    if ( XLALFrStreamSetMode( streams[1], LAL_FR_STREAM_DEFAULT_MODE ) < 0 || XLALFrStreamRewind( streams[1] ) < 0 )
+      return 1;
+    for ( k = 0; k < 2; ++k )
+      XLALFrStreamClose( streams[k] );
+  }
+
   LALCheckMemoryLeaks();
   return 0;
 }
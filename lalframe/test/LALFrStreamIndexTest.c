@@ -0,0 +1,215 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+/**
+ * \file
+ *
+ * ### Program LALFrStreamIndexTest.c ###
+ *
+ * Tests frame streams opened with a frame index.
+ *
+ * ### Description ###
+ *
+ * This program indexes the fake frames <tt>F-TEST-*.gwf</tt> in the
+ * directory TEST_DATA_DIR and checks that seeks on the indexed stream agree
+ * with seeks on a stream opened without an index, that the channels are
+ * found in the index, and that the index file is reused when nothing has
+ * changed.  It then writes a frame file of its own, indexes it, rewrites
+ * it with a different channel, and checks that the change is detected.
+ *
+ */
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALCache.h>
+#include <lal/Date.h>
+#include <lal/Units.h>
+#include <lal/TimeSeries.h>
+#include <lal/LALFrameIO.h>
+#include <lal/LALFrStream.h>
+
+#ifndef CHANNEL
+#define CHANNEL "H1:LSC-AS_Q"
+#endif
+
+#define INDEX "LALFrStreamIndexTest.idx"
+#define FRAME "X-LALFrStreamIndexTest-600000000-4.gwf"
+
+/* inode of the index file; it changes whenever the index is rewritten */
+static ino_t index_inode( void )
+{
+  struct stat st;
+  if ( stat( INDEX, &st ) )
+    return 0;
+  return st.st_ino;
+}
+
+/* seeks on an indexed stream must end up where they do without an index */
+static int test_seek( LALCache *cache )
+{
+  const REAL8 times[] = { 599999990.0, 600000000.0, 600000031.5, 600000059.999, 600000060.0, 600000125.25, 600000179.9, 600000180.0 };
+  LALFrStream *indexed;
+  LALFrStream *plain;
+  UINT4 i;
+
+  indexed = XLALFrStreamCacheOpenIndex( cache, INDEX );
+  XLAL_CHECK( indexed, XLAL_EFUNC );
+  plain = XLALFrStreamCacheOpen( cache );
+  XLAL_CHECK( plain, XLAL_EFUNC );
+  XLALFrStreamSetMode( indexed, LAL_FR_STREAM_IGNORETIME_MODE );
+  XLALFrStreamSetMode( plain, LAL_FR_STREAM_IGNORETIME_MODE );
+
+  for ( i = 0; i < sizeof( times ) / sizeof( *times ); ++i )
+  {
+    LIGOTimeGPS t;
+    int r1, r2;
+    XLALGPSSetREAL8( &t, times[i] );
+    r1 = XLALFrStreamSeek( indexed, &t );
+    r2 = XLALFrStreamSeek( plain, &t );
+    XLAL_CHECK( r1 == r2, XLAL_EFAILED, "seek to %.3f: %d with index, %d without", times[i], r1, r2 );
+    if ( r1 < 0 )
+      continue;
+    XLAL_CHECK( indexed->fnum == plain->fnum && indexed->pos == plain->pos, XLAL_EFAILED,
+                "seek to %.3f: file %u frame %d with index, file %u frame %d without", times[i], indexed->fnum, indexed->pos, plain->fnum, plain->pos );
+    XLAL_CHECK( XLALGPSCmp( &indexed->epoch, &plain->epoch ) == 0, XLAL_EFAILED, "seek to %.3f: wrong epoch", times[i] );
+  }
+
+  XLALFrStreamClose( plain );
+  XLALFrStreamClose( indexed );
+  return 0;
+}
+
+/* channel queries are answered from the index */
+static int test_query( LALCache *cache )
+{
+  LALFrStream *stream;
+  LIGOTimeGPS t;
+  int errnum;
+  int r;
+
+  stream = XLALFrStreamCacheOpenIndex( cache, INDEX );
+  XLAL_CHECK( stream, XLAL_EFUNC );
+  XLAL_CHECK( XLALFrStreamIndexQueryChan( stream, CHANNEL, XLALGPSSet( &t, 600000071, 123456789 ) ) == 1, XLAL_EFAILED, "channel " CHANNEL " not found" );
+  XLAL_CHECK( XLALFrStreamIndexQueryChan( stream, CHANNEL, XLALGPSSet( &t, 600000000, 0 ) ) == 1, XLAL_EFAILED, "channel " CHANNEL " not found at start" );
+  XLAL_CHECK( XLALFrStreamIndexQueryChan( stream, "H1:NO-SUCH_CHANNEL", &t ) == 0, XLAL_EFAILED, "missing channel found" );
+  XLAL_CHECK( XLALFrStreamIndexQueryChan( stream, CHANNEL, XLALGPSSet( &t, 600000180, 0 ) ) == 0, XLAL_EFAILED, "channel found after the end of the data" );
+  XLAL_CHECK( XLALFrStreamIndexQueryChan( stream, CHANNEL, XLALGPSSet( &t, 599999999, 0 ) ) == 0, XLAL_EFAILED, "channel found before the start of the data" );
+  XLALFrStreamClose( stream );
+
+  /* a stream without an index cannot be queried */
+  stream = XLALFrStreamCacheOpen( cache );
+  XLAL_CHECK( stream, XLAL_EFUNC );
+  XLAL_TRY_SILENT( r = XLALFrStreamIndexQueryChan( stream, CHANNEL, &t ), errnum );
+  XLAL_CHECK( r < 0 && errnum == XLAL_EINVAL, XLAL_EFAILED, "stream without an index was queried" );
+  XLALFrStreamClose( stream );
+  return 0;
+}
+
+/* write a 4 s frame file with one channel of the given sample rate */
+static int write_frame( const char *chname, REAL8 rate )
+{
+  LIGOTimeGPS epoch = { 600000000, 0 };
+  REAL8TimeSeries *series;
+  LALFrameH *frame;
+  UINT4 i;
+
+  series = XLALCreateREAL8TimeSeries( chname, &epoch, 0.0, 1.0 / rate, &lalDimensionlessUnit, 4 * rate );
+  XLAL_CHECK( series, XLAL_EFUNC );
+  for ( i = 0; i < series->data->length; ++i )
+    series->data->data[i] = i;
+  frame = XLALFrameNew( &epoch, 4.0, "LALFrStreamIndexTest", 0, 0, 0 );
+  XLAL_CHECK( frame, XLAL_EFUNC );
+  XLAL_CHECK( XLALFrameAddREAL8TimeSeriesProcData( frame, series ) == 0, XLAL_EFUNC );
+  XLAL_CHECK( XLALFrameWrite( frame, FRAME ) == 0, XLAL_EFUNC );
+  XLALFrameFree( frame );
+  XLALDestroyREAL8TimeSeries( series );
+  return 0;
+}
+
+/* a frame file that changes after it was indexed is indexed again */
+static int test_stale( void )
+{
+  LALFrStream *stream;
+  LALCache *cache;
+  LIGOTimeGPS t = { 600000001, 0 };
+  ino_t inode;
+
+  remove( INDEX );
+  XLAL_CHECK( write_frame( "X1:FIRST", 256.0 ) == 0, XLAL_EFUNC );
+  cache = XLALCacheGlob( ".", FRAME );
+  XLAL_CHECK( cache && cache->length == 1, XLAL_EFUNC );
+
+  stream = XLALFrStreamCacheOpenIndex( cache, INDEX );
+  XLAL_CHECK( stream, XLAL_EFUNC );
+  XLAL_CHECK( XLALFrStreamIndexQueryChan( stream, "X1:FIRST", &t ) == 1, XLAL_EFAILED, "channel X1:FIRST not found" );
+  XLALFrStreamClose( stream );
+  inode = index_inode();
+  XLAL_CHECK( inode, XLAL_EFAILED, "no index file written" );
+
+  /* same file, different contents and size */
+  XLAL_CHECK( write_frame( "X1:SECOND", 512.0 ) == 0, XLAL_EFUNC );
+  stream = XLALFrStreamCacheOpenIndex( cache, INDEX );
+  XLAL_CHECK( stream, XLAL_EFUNC );
+  XLAL_CHECK( XLALFrStreamIndexQueryChan( stream, "X1:SECOND", &t ) == 1, XLAL_EFAILED, "changed file was not indexed again" );
+  XLAL_CHECK( XLALFrStreamIndexQueryChan( stream, "X1:FIRST", &t ) == 0, XLAL_EFAILED, "stale channel list was used" );
+  XLALFrStreamClose( stream );
+  XLAL_CHECK( index_inode() != inode, XLAL_EFAILED, "index file was not rewritten" );
+
+  XLALDestroyCache( cache );
+  remove( FRAME );
+  remove( INDEX );
+  return 0;
+}
+
+int main( void )
+{
+  LALCache *cache;
+  ino_t inode;
+
+  remove( INDEX );
+  cache = XLALCacheGlob( TEST_DATA_DIR, "F-TEST-*.gwf" );
+  XLAL_CHECK_MAIN( cache && cache->length == 3, XLAL_EFUNC );
+
+  /* the first open builds the index */
+  XLAL_CHECK_MAIN( test_seek( cache ) == 0, XLAL_EFUNC );
+  inode = index_inode();
+  XLAL_CHECK_MAIN( inode, XLAL_EFAILED, "no index file written" );
+
+  /* later opens reuse it without rewriting it */
+  XLAL_CHECK_MAIN( test_query( cache ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_seek( cache ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( index_inode() == inode, XLAL_EFAILED, "unchanged index file was rewritten" );
+
+  /* a malformed index is rebuilt */
+  {
+    FILE *fp = fopen( INDEX, "w" );
+    XLAL_CHECK_MAIN( fp, XLAL_EIO );
+    fputs( "# LALFrStreamIndex 1\nF garbage\n", fp );
+    fclose( fp );
+  }
+  XLAL_CHECK_MAIN( test_query( cache ) == 0, XLAL_EFUNC );
+
+  XLALDestroyCache( cache );
+  remove( INDEX );
+
+  XLAL_CHECK_MAIN( test_stale() == 0, XLAL_EFUNC );
+
+  LALCheckMemoryLeaks();
+  return 0;
+}
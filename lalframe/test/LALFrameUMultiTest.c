@@ -0,0 +1,145 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+/**
+ * \file
+ *
+ * ### Program LALFrameUMultiTest.c ###
+ *
+ * Tests expanding several channels at once.
+ *
+ * ### Description ###
+ *
+ * This program makes channels of different types and lengths, compresses
+ * each with XLALFrameUFrChanVectorCompress() using a different scheme,
+ * expands them all with XLALFrameUFrChanVectorExpandMulti(), and checks
+ * that the data are unchanged and match a channel compressed and expanded
+ * on its own.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALFrameU.h>
+
+#define NCHAN 12
+
+/* a processed-data channel with reproducible contents; some channels are
+ * mostly zero so that the zero-suppression schemes have work to do */
+static LALFrameUFrChan *make_channel(size_t k)
+{
+  const int dtypes[] = { LAL_FRAMEU_FR_VECT_8R, LAL_FRAMEU_FR_VECT_4R, LAL_FRAMEU_FR_VECT_4S };
+  const int dtype = dtypes[k % 3];
+  const size_t ndata = 1000 + 997 * k;
+  LALFrameUFrChan *channel;
+  char name[32];
+  void *data;
+  size_t i;
+
+  snprintf( name, sizeof( name ), "X1:MULTI_TEST_%zu", k );
+  channel = XLALFrameUFrProcChanAlloc( name, LAL_FRAMEU_FR_PROC_TYPE_TIME_SERIES, LAL_FRAMEU_FR_PROC_SUB_TYPE_UNKNOWN, dtype, ndata );
+  XLAL_CHECK_NULL( channel, XLAL_EFUNC );
+  XLAL_CHECK_NULL( XLALFrameUFrChanVectorAlloc( channel, dtype, ndata ) == 0, XLAL_EFUNC );
+  XLALFrameUFrChanVectorSetDx( channel, 1.0 / 1024 );
+  data = XLALFrameUFrChanVectorQueryData( channel );
+  XLAL_CHECK_NULL( data, XLAL_EFUNC );
+  for ( i = 0; i < ndata; ++i )
+  {
+    const INT4 v = ( k % 2 && i % 16 ) ? 0 : ( INT4 ) ( ( i * 2654435761u + k ) % 20011 ) - 10005;
+    switch ( dtype )
+    {
+    case LAL_FRAMEU_FR_VECT_8R:
+      ( ( REAL8 * ) data )[i] = v / 7.0;
+      break;
+    case LAL_FRAMEU_FR_VECT_4R:
+      ( ( REAL4 * ) data )[i] = v / 7.0f;
+      break;
+    default:
+      ( ( INT4 * ) data )[i] = v;
+      break;
+    }
+  }
+  return channel;
+}
+
+int main( void )
+{
+  const int schemes[] = {
+    LAL_FRAMEU_FR_VECT_COMPRESS_RAW,
+    LAL_FRAMEU_FR_VECT_COMPRESS_GZIP,
+    LAL_FRAMEU_FR_VECT_COMPRESS_DIFF_GZIP,
+    LAL_FRAMEU_FR_VECT_COMPRESS_ZERO_SUPPRESS_WORD_4
+  };
+  LALFrameUFrChan *channels[NCHAN];
+  LALFrameUFrChan *single;
+  int compress[NCHAN];
+  void *orig[NCHAN];
+  size_t nbytes[NCHAN];
+  size_t k;
+  int errnum;
+  int r;
+
+  for ( k = 0; k < NCHAN; ++k )
+  {
+    channels[k] = make_channel( k );
+    XLAL_CHECK_MAIN( channels[k], XLAL_EFUNC );
+    compress[k] = schemes[k % ( sizeof( schemes ) / sizeof( *schemes ) )];
+    nbytes[k] = XLALFrameUFrChanVectorQueryNBytes( channels[k] );
+    orig[k] = LALMalloc( nbytes[k] );
+    XLAL_CHECK_MAIN( orig[k], XLAL_ENOMEM );
+    memcpy( orig[k], XLALFrameUFrChanVectorQueryData( channels[k] ), nbytes[k] );
+  }
+
+  /* round trip */
+  for ( k = 0; k < NCHAN; ++k )
+    XLAL_CHECK_MAIN( XLALFrameUFrChanVectorCompress( channels[k], compress[k] ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALFrameUFrChanVectorExpandMulti( channels, NCHAN ) == 0, XLAL_EFUNC );
+  for ( k = 0; k < NCHAN; ++k )
+  {
+    XLAL_CHECK_MAIN( XLALFrameUFrChanVectorQueryNBytes( channels[k] ) == nbytes[k], XLAL_EFAILED, "channel %zu has %zu bytes after the round trip, %zu before", k, XLALFrameUFrChanVectorQueryNBytes( channels[k] ), nbytes[k] );
+    XLAL_CHECK_MAIN( memcmp( XLALFrameUFrChanVectorQueryData( channels[k] ), orig[k], nbytes[k] ) == 0, XLAL_EFAILED, "channel %zu changed in the round trip with scheme %d", k, compress[k] );
+  }
+
+  /* the same as compressing and expanding a channel on its own */
+  single = make_channel( 1 );
+  XLAL_CHECK_MAIN( single, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALFrameUFrChanVectorCompress( single, compress[1] ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALFrameUFrChanVectorExpand( single ) == 0, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALFrameUFrChanVectorQueryNBytes( single ) == nbytes[1], XLAL_EFAILED );
+  XLAL_CHECK_MAIN( memcmp( XLALFrameUFrChanVectorQueryData( single ), XLALFrameUFrChanVectorQueryData( channels[1] ), nbytes[1] ) == 0, XLAL_EFAILED, "serial and parallel round trips differ" );
+  XLALFrameUFrChanFree( single );
+
+  /* expanding channels that are already expanded changes nothing */
+  XLAL_CHECK_MAIN( XLALFrameUFrChanVectorExpandMulti( channels, NCHAN ) == 0, XLAL_EFUNC );
+  for ( k = 0; k < NCHAN; ++k )
+    XLAL_CHECK_MAIN( memcmp( XLALFrameUFrChanVectorQueryData( channels[k] ), orig[k], nbytes[k] ) == 0, XLAL_EFAILED, "channel %zu changed by a second expansion", k );
+
+  /* no channels is fine, a missing array is not */
+  XLAL_CHECK_MAIN( XLALFrameUFrChanVectorExpandMulti( NULL, 0 ) == 0, XLAL_EFUNC );
+  XLAL_TRY_SILENT( r = XLALFrameUFrChanVectorExpandMulti( NULL, NCHAN ), errnum );
+  XLAL_CHECK_MAIN( r < 0 && errnum == XLAL_EFAULT, XLAL_EFAILED, "missing channels accepted" );
+
+  for ( k = 0; k < NCHAN; ++k )
+  {
+    XLALFrameUFrChanFree( channels[k] );
+    LALFree( orig[k] );
+  }
+
+  LALCheckMemoryLeaks();
+  return 0;
+}
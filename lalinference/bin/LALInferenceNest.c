@@ -124,8 +124,15 @@ int main(int argc, char *argv[]){
 
      }
 
-  /* Set up the threads */
-  LALInferenceInitCBCThreads(state,1);
+  /* Set up the threads, one per concurrent nested sampling walker */
+  INT4 nthreads=1;
+  if (state){
+    ProcessParamsTable *ppt=LALInferenceGetProcParamVal(state->commandLine,"--Nparallel");
+    if(!ppt) ppt=LALInferenceGetProcParamVal(state->commandLine,"--nparallel");
+    if(ppt) nthreads=atoi(ppt->value);
+    if(nthreads<1) nthreads=1;
+  }
+  LALInferenceInitCBCThreads(state,nthreads);
 
   /* Init the prior */
   LALInferenceInitCBCPrior(state);
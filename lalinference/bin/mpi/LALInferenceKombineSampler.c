@@ -152,8 +152,10 @@ void ensemble_sampler(struct tagLALInferenceRunState *run_state) {
     }
 
     /* Sampling complete, so clean up and return */
-    for (walker=0; walker<nwalkers_per_thread; walker++)
+    for (walker=0; walker<nwalkers_per_thread; walker++) {
         run_state->threads[walker].currentPropDensity = -INFINITY;
+        LALInferenceDestroyModelSplineCalibrationCaches(run_state->threads[walker].model);
+    }
 
     fclose(output);
     return;
@@ -101,6 +101,10 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     (--adapt-temps)     Adapt the spacing between temperatures for uniform swap acceptance\n\
     (--temp-skip N)     Number of steps between temperature swap proposals (100)\n\
     (--tempKill N)      Iteration number to stop temperature swapping (Niter)\n\
+    (--async-swaps)     Swap temperatures with nonblocking exchanges between neighbouring\n\
+                            MPI processes only, without global synchronisation\n\
+    (--async-sync-interval N) Number of swap rounds between global synchronisations\n\
+                            (checkpointing, ladder adaptation, stopping) with --async-swaps (10)\n\
     (--ntemps N)         Number of temperature chains in ladder (as many as needed)\n\
     (--temp-min T)      Lowest temperature for parallel tempering (1.0)\n\
     (--temp-max T)      Highest temperature for parallel tempering (50.0)\n\
@@ -127,6 +131,9 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     (--prop-track)      Output proposal parameters\n\
     (--outfile file)    Write output files <file>.<chain_number> \n\
                             (PTMCMC.output.<random_seed>.<mpi_thread>)\n\
+    (--hdf5-stream)     Append samples to compressed HDF5 tables as they are drawn, instead\n\
+                            of holding them in memory and rewriting the file at each checkpoint\n\
+    (--hdf5-buffer N)   Number of samples per chain buffered between writes with --hdf5-stream (1000)\n\
     ----------------------------------------------\n\
     --- Checkpointing-----------------------------\n\
     ----------------------------------------------\n\
@@ -165,6 +172,9 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
         //runState->parallelSwap = &LALInferenceMCMCMCswap;
         fprintf(stderr, "ERROR: MCMCMC sampling hasn't been brought up-to-date since restructuring.\n");
         return XLAL_FAILURE;
+    } else if (LALInferenceGetProcParamVal(command_line, "--async-swaps")) {
+        /* Parallel tempering swap between neighbouring processes, without global synchronisation. */
+        runState->parallelSwap = &LALInferencePTswapAsync;
     } else {
         /* Standard parallel tempering swap. */
         runState->parallelSwap = &LALInferencePTswap;
@@ -191,6 +201,18 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     if (LALInferenceGetProcParamVal(command_line, "--benchmark"))
         benchmark = 1;
 
+    /* Stream samples to the output file through bounded buffers */
+    INT4 hdf5_stream = 0;
+    if (LALInferenceGetProcParamVal(command_line, "--hdf5-stream"))
+        hdf5_stream = 1;
+
+    INT4 hdf5_buffer = 1000;
+    ppt = LALInferenceGetProcParamVal(command_line, "--hdf5-buffer");
+    if (ppt)
+        hdf5_buffer = atoi(ppt->value);
+    if (hdf5_buffer < 1)
+        hdf5_buffer = 1;
+
     /* Number of steps between ensemble updates */
     INT4 nsteps = 100000000;
     ppt = LALInferenceGetProcParamVal(command_line, "--nsteps");
@@ -224,6 +246,18 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     /* Counter for triggering PT swaps */
     INT4 nsteps_until_swap = Tskip;
 
+    /* Asynchronous temperature swaps, and rounds between global synchronisations */
+    INT4 async_swaps = 0;
+    if (LALInferenceGetProcParamVal(command_line, "--async-swaps"))
+        async_swaps = 1;
+
+    INT4 async_sync_interval = 10;
+    ppt = LALInferenceGetProcParamVal(command_line, "--async-sync-interval");
+    if (ppt)
+        async_sync_interval = atoi(ppt->value);
+    if (async_sync_interval < 1)
+        async_sync_interval = 1;
+
     /* Allow user to restrict size of temperature ladder */
     INT4 ntemps = 0;
     ppt = LALInferenceGetProcParamVal(command_line, "--ntemp");
@@ -287,11 +321,15 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     LALInferenceAddINT4Variable(algorithm_params, "prop_verbose", propVerbose, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "prop_track", propTrack, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "benchmark", benchmark, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddINT4Variable(algorithm_params, "hdf5_stream", hdf5_stream, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddINT4Variable(algorithm_params, "hdf5_buffer", hdf5_buffer, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "nsteps", nsteps, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "skip", skip, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "neff", neff, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "tskip", Tskip, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "nsteps_until_swap", nsteps_until_swap, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddINT4Variable(algorithm_params, "async_swaps", async_swaps, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddINT4Variable(algorithm_params, "async_sync_interval", async_sync_interval, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "mpirank", mpi_rank, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "mpisize", mpi_size, LALINFERENCE_PARAM_OUTPUT);
     LALInferenceAddINT4Variable(algorithm_params, "ntemps", ntemps, LALINFERENCE_PARAM_OUTPUT);
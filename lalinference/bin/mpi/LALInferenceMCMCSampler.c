@@ -92,6 +92,10 @@ thinDifferentialEvolutionPoints(LALInferenceThreadState *thread) {
     thread->differentialPointsSize = 2*newSize;
     thread->differentialPointsLength = newSize;
     thread->differentialPointsSkip *= 2;
+
+    /* Streamed copy of the buffer must be rewritten at the next flush */
+    if (LALInferenceCheckVariable(thread->algorithmParams, "de_rows_saved"))
+        LALInferenceSetINT4Variable(thread->algorithmParams, "de_rows_saved", 0);
 }
 
 static void
@@ -115,6 +119,22 @@ accumulateDifferentialEvolutionSample(LALInferenceThreadState *thread, size_t bu
     thread->differentialPointsLength += 1;
 }
 
+/* Free the DE buffer before it is replaced by one read from a file */
+static void
+freeDifferentialEvolutionPoints(LALInferenceThreadState *thread) {
+    size_t i;
+
+    for (i = 0; i < thread->differentialPointsLength; i++) {
+        LALInferenceClearVariables(thread->differentialPoints[i]);
+        XLALFree(thread->differentialPoints[i]);
+    }
+    XLALFree(thread->differentialPoints);
+
+    thread->differentialPoints = NULL;
+    thread->differentialPointsLength = 0;
+    thread->differentialPointsSize = 0;
+}
+
 static void
 resetDifferentialEvolutionBuffer(LALInferenceThreadState *thread) {
     size_t i;
@@ -129,6 +149,9 @@ resetDifferentialEvolutionBuffer(LALInferenceThreadState *thread) {
     thread->differentialPointsLength = 0;
     thread->differentialPointsSize = 1;
     thread->differentialPointsSkip = LALInferenceGetINT4Variable(thread->proposalArgs, "de_skip");
+
+    if (LALInferenceCheckVariable(thread->algorithmParams, "de_rows_saved"))
+        LALInferenceSetINT4Variable(thread->algorithmParams, "de_rows_saved", 0);
 }
 
 /* This is checked by the main loop to determine when to checkpoint */
@@ -239,6 +262,12 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     INT4 tempVerbose = LALInferenceGetINT4Variable(algorithm_params, "temp_verbose");
     INT4 adaptVerbose = LALInferenceGetINT4Variable(algorithm_params, "adapt_verbose");
     INT4 benchmark = LALInferenceGetINT4Variable(algorithm_params, "benchmark");
+    INT4 hdf5_stream = LALInferenceGetINT4Variable(algorithm_params, "hdf5_stream");
+
+    /* Asynchronous swaps only synchronise all processes every async_sync_interval rounds */
+    INT4 async_swaps = LALInferenceGetINT4Variable(algorithm_params, "async_swaps");
+    INT4 async_sync_interval = LALInferenceGetINT4Variable(algorithm_params, "async_sync_interval");
+    INT4 loop_round = 0, sync_round = 1, stop_requested = 0;
 
     /* Clustered-KDE proposal updates */
     INT4 kde_update_start = 200;  // rough number of effective samples to start KDE updates
@@ -269,7 +298,8 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
             verbose_file = fopen(verbose_filename, "w");
 
             fprintf(verbose_file,
-                "cycle\tlow_temp_idx\tlow_temp\thigh_temp_idx\thigh_temp\tlog(chain_swap)\tlow_temp_likelihood\thigh_temp_likelihood\tswap_accepted\tacceptance_fraction\n");
+                "cycle\tlow_temp_idx\tlow_temp\thigh_temp_idx\thigh_temp\tlog(chain_swap)\tlow_temp_likelihood\thigh_temp_likelihood\tswap_accepted\tacceptance_fraction%s\n",
+                async_swaps ? "\twait_time" : "");
 
             fclose(verbose_file);
         }
@@ -331,6 +361,8 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     }
     LALInferenceNameOutputs(runState);
     LALInferenceResumeMCMC(runState);
+    if (hdf5_stream)
+        LALInferenceOpenMCMCStream(runState);
     
     if (benchmark) {
         struct timeval start_tv;
@@ -374,6 +406,9 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
     // iterate:
     step_last_acl_check = runState->threads[0].step;
     while (!runComplete) {
+        sync_round = !async_swaps || (loop_round % async_sync_interval == 0);
+        loop_round++;
+
         #pragma omp parallel for private(thread)
         for (t = 0; t < n_local_threads; t++) {
             FILE *outfile = NULL;
@@ -422,7 +457,14 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 
                     //LALInferenceSaveSample(thread, resumeoutputs[t]);
                     //LALInferencePrintMCMCSample(thread, runState->data, thread->step, timestamp, threadoutputs[t]);
-                    LALInferenceLogSampleToArray(thread->algorithmParams, thread->currentParams);
+                    if (hdf5_stream) {
+                        LALInferenceH5SampleWriter *writer = *(LALInferenceH5SampleWriter **)LALInferenceGetVariable(thread->algorithmParams, "sample_writer");
+                        /* HDF5 is not thread-safe, even for separate datasets,
+                         * and a full buffer is written out by the append */
+                        #pragma omp critical (lalinference_hdf5)
+                        LALInferenceH5SampleWriterAppend(writer, thread->currentParams);
+                    } else
+                        LALInferenceLogSampleToArray(thread->algorithmParams, thread->currentParams);
 
                     if (adaptVerbose && !no_adapt) {
                         sprintf(outfilename, "PTMCMC.statistics.%u.%2.2d",
@@ -456,12 +498,14 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         }
 
 		/* Synchronise interruptions */
+        if (sync_round) {
 		if(MPIrank==0){
                     local_saveStateFlag=__master_saveStateFlag;
                     local_exitFlag=__master_exitFlag;
 		}
 		MPI_Bcast(&local_saveStateFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
 		MPI_Bcast(&local_exitFlag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        }
         INT4 saveattempts=0;
         INT4 retrydelay=5; /* 5 seconds before initial retry */
         INT4 retcode=XLAL_SUCCESS;
@@ -517,7 +561,7 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
         runState->parallelSwap(runState, verbose_file);
 
         /* Modify temperatures to strive for uniform swap acceptance rates */
-        if (adapt_temps)
+        if (adapt_temps && sync_round)
             LALInferenceAdaptLadder(runState);
 
         if (tempVerbose)
@@ -560,10 +604,29 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
             step_last_acl_check = runState->threads[0].step;
         }
 
-        /* Broadcast the root's decision on run completion */
-        MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        /* Broadcast the root's decision on run completion.  Between
+         * synchronisation rounds only the step limit, which every process
+         * reaches together, can end the run. */
+        if (sync_round) {
+            runComplete = runComplete || stop_requested;
+            MPI_Bcast(&runComplete, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        } else {
+            stop_requested = stop_requested || runComplete;
+            runComplete = (runState->threads[0].step > Niter);
+        }
     }// while (!runComplete)
-    LALInferenceWriteMCMCSamples(runState);
+
+    if (async_swaps && verbose && LALInferenceCheckVariable(algorithm_params, "swap_wait_time"))
+        printf("Process %i spent %f s waiting for temperature swap partners.\n",
+               MPIrank, LALInferenceGetREAL8Variable(algorithm_params, "swap_wait_time"));
+
+    if (hdf5_stream)
+        LALInferenceCloseMCMCStream(runState);
+    else
+        LALInferenceWriteMCMCSamples(runState);
+
+    for (t = 0; t < n_local_threads; t++)
+        LALInferenceDestroyModelSplineCalibrationCaches(runState->threads[t].model);
     MPI_Barrier(MPI_COMM_WORLD);
 }
 
@@ -962,6 +1025,203 @@ void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile) {
 }
 
 
+/* Swap the states of two chains on this process if the swap is accepted */
+static INT4 local_PTswap(LALInferenceRunState *runState, INT4 cold_ind, INT4 hot_ind, REAL8 wait_time, FILE *swapfile) {
+    INT4 n_local_threads = runState->nthreads;
+    LALInferenceThreadState *cold_thread = &runState->threads[cold_ind % n_local_threads];
+    LALInferenceThreadState *hot_thread = &runState->threads[hot_ind % n_local_threads];
+    LALInferenceVariables *temp_params;
+    REAL8 logThreadSwap, temp_prior, temp_like;
+    INT4 swapAccepted;
+
+    logThreadSwap = 1.0/cold_thread->temperature - 1.0/hot_thread->temperature;
+    logThreadSwap *= hot_thread->currentLikelihood - cold_thread->currentLikelihood;
+
+    if ((logThreadSwap > 0) || (log(gsl_rng_uniform(runState->GSLrandom)) < logThreadSwap ))
+        swapAccepted = 1;
+    else
+        swapAccepted = 0;
+    cold_thread->temp_swap_accepts[cold_thread->temp_swap_counter] = swapAccepted;
+    cold_thread->temp_swap_counter = (cold_thread->temp_swap_counter + 1) % cold_thread->temp_swap_window;
+
+    if (swapfile != NULL) {
+        REAL8 acc_frac = 0.0;
+        for (INT4 i=0; i<cold_thread->temp_swap_window; i++)
+            acc_frac += (REAL8)cold_thread->temp_swap_accepts[i] / cold_thread->temp_swap_window;
+        fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\t%f\n",
+                cold_thread->step, cold_ind, cold_thread->temperature,
+                hot_ind, hot_thread->temperature,
+                logThreadSwap, cold_thread->currentLikelihood,
+                hot_thread->currentLikelihood, swapAccepted, acc_frac, wait_time);
+    }
+
+    if (swapAccepted) {
+        temp_params = hot_thread->currentParams;
+        temp_prior = hot_thread->currentPrior;
+        temp_like = hot_thread->currentLikelihood;
+
+        hot_thread->currentParams = cold_thread->currentParams;
+        hot_thread->currentPrior = cold_thread->currentPrior;
+        hot_thread->currentLikelihood = cold_thread->currentLikelihood;
+
+        cold_thread->currentParams = temp_params;
+        cold_thread->currentPrior = temp_prior;
+        cold_thread->currentLikelihood = temp_like;
+    }
+
+    return swapAccepted;
+}
+
+/*
+ * Asynchronous parallel tempering swap.
+ *
+ * Swaps between chains on the same process are done locally.  Swaps across
+ * process boundaries are only proposed between neighbouring processes, and
+ * alternate between the even and odd boundaries on successive calls, so each
+ * process has at most one partner per call and there is no global ordering
+ * or broadcast.  Both processes post a nonblocking send of a packet holding
+ * the temperature, likelihood, prior and parameters of their boundary chain
+ * (the colder side also includes the uniform deviate for the acceptance
+ * test), do their local swaps while the messages are in flight, and then
+ * make the same accept/reject decision from the same numbers.  Local pairs
+ * involving the boundary chain sit out the rounds in which it is exchanged,
+ * so the state sent is still the one held when the decision is applied.  A process
+ * therefore only ever waits for the one neighbour it is swapping with, and
+ * the time spent waiting is accumulated in the "swap_wait_time" algorithm
+ * parameter.
+ */
+void LALInferencePTswapAsync(LALInferenceRunState *runState, FILE *swapfile) {
+    INT4 MPIrank, MPIsize;
+    INT4 n_local_threads, ntemps;
+    INT4 t, swap_round, partner = -1, cold_side = 0;
+    INT4 nPar, nPacket;
+    INT4 *local_inds = NULL;
+    REAL8 *packet = NULL, *adjPacket = NULL;
+    REAL8 wait_time = 0.0;
+    MPI_Request requests[2];
+    LALInferenceThreadState *thread = NULL;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
+    MPI_Comm_size(MPI_COMM_WORLD, &MPIsize);
+
+    n_local_threads = runState->nthreads;
+    ntemps = MPIsize*n_local_threads;
+
+    /* Return if running with only a single temperature */
+    if (ntemps == 1)
+        return;
+
+    if (!LALInferenceCheckVariable(runState->algorithmParams, "swap_round"))
+        LALInferenceAddINT4Variable(runState->algorithmParams, "swap_round", 0, LALINFERENCE_PARAM_OUTPUT);
+    if (!LALInferenceCheckVariable(runState->algorithmParams, "swap_wait_time"))
+        LALInferenceAddREAL8Variable(runState->algorithmParams, "swap_wait_time", 0.0, LALINFERENCE_PARAM_OUTPUT);
+    swap_round = LALInferenceGetINT4Variable(runState->algorithmParams, "swap_round");
+
+    /* Pick this round's partner across the even or odd process boundaries */
+    if (MPIrank % 2 == swap_round % 2 && MPIrank+1 < MPIsize) {
+        partner = MPIrank+1;
+        cold_side = 1;
+        thread = &runState->threads[n_local_threads-1];
+    } else if (MPIrank > 0 && (MPIrank-1) % 2 == swap_round % 2) {
+        partner = MPIrank-1;
+        cold_side = 0;
+        thread = &runState->threads[0];
+    }
+
+    /* Start the boundary exchange: temperature, logL, logPrior, log(u), nPar, parameters */
+    if (partner >= 0) {
+        nPar = LALInferenceGetVariableDimensionNonFixed(thread->currentParams);
+        nPacket = 5 + nPar;
+        packet = XLALMalloc(nPacket * sizeof(REAL8));
+        adjPacket = XLALMalloc(nPacket * sizeof(REAL8));
+
+        packet[0] = thread->temperature;
+        packet[1] = thread->currentLikelihood;
+        packet[2] = thread->currentPrior;
+        packet[3] = cold_side ? log(gsl_rng_uniform(runState->GSLrandom)) : 0.0;
+        packet[4] = (REAL8)nPar;
+        LALInferenceCopyVariablesToArray(thread->currentParams, &packet[5]);
+
+        MPI_Irecv(adjPacket, nPacket, MPI_DOUBLE, partner, PT_ASYNC_COM, MPI_COMM_WORLD, &requests[0]);
+        MPI_Isend(packet, nPacket, MPI_DOUBLE, partner, PT_ASYNC_COM, MPI_COMM_WORLD, &requests[1]);
+    }
+
+    /* Do the swaps local to this process while the messages are in flight.
+     * The boundary chain's state is already in the packet, so pairs that
+     * include it are skipped this round; otherwise an accepted remote swap
+     * would install a state that a local swap has since moved. */
+    if (n_local_threads > 1) {
+        INT4 n_local_swaps = 0;
+        local_inds = XLALCalloc(n_local_threads-1, sizeof(INT4));
+        for (t = 0; t < n_local_threads-1; t++) {
+            if (partner >= 0 && cold_side && t+1 == n_local_threads-1)
+                continue;
+            if (partner >= 0 && !cold_side && t == 0)
+                continue;
+            local_inds[n_local_swaps++] = MPIrank*n_local_threads + t;
+        }
+        if (n_local_swaps > 0) {
+            gsl_ran_shuffle(runState->GSLrandom, local_inds, n_local_swaps, sizeof(INT4));
+            for (t = 0; t < n_local_swaps; t++)
+                local_PTswap(runState, local_inds[t], local_inds[t]+1, 0.0, swapfile);
+        }
+        XLALFree(local_inds);
+    }
+
+    /* Finish the boundary exchange */
+    if (partner >= 0) {
+        REAL8 wait_start = MPI_Wtime();
+        MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+        wait_time = MPI_Wtime() - wait_start;
+
+        if ((INT4)adjPacket[4] != nPar) {
+            XLALPrintError("Error: chains on processes %i and %i have %i and %i parameters\n",
+                           MPIrank, partner, nPar, (INT4)adjPacket[4]);
+            XLAL_ERROR_VOID(XLAL_EFAILED);
+        }
+
+        /* Both sides evaluate the acceptance test with identical inputs */
+        REAL8 cold_temp = cold_side ? packet[0] : adjPacket[0];
+        REAL8 hot_temp = cold_side ? adjPacket[0] : packet[0];
+        REAL8 cold_like = cold_side ? packet[1] : adjPacket[1];
+        REAL8 hot_like = cold_side ? adjPacket[1] : packet[1];
+        REAL8 logu = cold_side ? packet[3] : adjPacket[3];
+        REAL8 logThreadSwap = (1.0/cold_temp - 1.0/hot_temp) * (hot_like - cold_like);
+        INT4 swapAccepted = ((logThreadSwap > 0) || (logu < logThreadSwap));
+
+        if (cold_side) {
+            thread->temp_swap_accepts[thread->temp_swap_counter] = swapAccepted;
+            thread->temp_swap_counter = (thread->temp_swap_counter + 1) % thread->temp_swap_window;
+
+            if (swapfile != NULL) {
+                REAL8 acc_frac = 0.0;
+                for (INT4 i=0; i<thread->temp_swap_window; i++)
+                    acc_frac += (REAL8)thread->temp_swap_accepts[i] / thread->temp_swap_window;
+                fprintf(swapfile, "%d\t%d\t%f\t%d\t%f\t%f\t%f\t%f\t%i\t%f\t%f\n",
+                        thread->step, (MPIrank+1)*n_local_threads-1, cold_temp,
+                        (MPIrank+1)*n_local_threads, hot_temp,
+                        logThreadSwap, cold_like, hot_like, swapAccepted, acc_frac, wait_time);
+            }
+        }
+
+        if (swapAccepted) {
+            thread->currentLikelihood = adjPacket[1];
+            thread->currentPrior = adjPacket[2];
+            LALInferenceCopyArrayToVariables(&adjPacket[5], thread->currentParams);
+        }
+
+        XLALFree(packet);
+        XLALFree(adjPacket);
+    }
+
+    REAL8 total_wait = LALInferenceGetREAL8Variable(runState->algorithmParams, "swap_wait_time") + wait_time;
+    LALInferenceSetREAL8Variable(runState->algorithmParams, "swap_wait_time", total_wait);
+    LALInferenceSetINT4Variable(runState->algorithmParams, "swap_round", swap_round+1);
+
+    return;
+}
+
+
 // UINT4 LALInferenceMCMCMCswap(LALInferenceRunState *runState, REAL8 *ladder, INT4 i, FILE *swapfile) {
 //     INT4 MPIrank;
 //     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
@@ -1302,6 +1562,183 @@ void LALInferenceResumeMCMC(LALInferenceRunState *runState) {
     return;
 }
 
+/* Open the output file for --hdf5-stream.  Each chain's samples, and a
+ * copy of its DE buffer for checkpointing, are appended to chunked,
+ * compressed tables through bounded buffers instead of being held in
+ * memory and rewritten in full at every checkpoint.  The DE buffer copies
+ * go in a checkpoint/<runID> group, so that the lalinference/<runID>
+ * group holds only posterior samples. */
+void LALInferenceOpenMCMCStream(LALInferenceRunState *runState) {
+    INT4 t, n_local_threads;
+    LALInferenceThreadState *thread;
+    LALH5File *output = NULL;
+    LALH5File *group = NULL;
+    LALH5File *checkpoint_group = NULL;
+    INT4 buffer_rows = LALInferenceGetINT4Variable(runState->algorithmParams, "hdf5_buffer");
+    INT4 resume = LALInferenceCheckVariable(runState->algorithmParams, "stream_resume");
+
+    /* Start afresh unless continuing from a checkpoint */
+    if (!resume)
+        remove(runState->outFileName);
+
+    output = XLALH5FileOpen(runState->outFileName, "a");
+    if(output == NULL){
+        XLALErrorHandler = XLALExitErrorHandler;
+        XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
+        XLAL_ERROR_VOID(XLAL_EIO);
+    }
+
+    if (resume) {
+        LALH5File *li_group = XLALH5GroupOpen(output, "lalinference");
+        group = XLALH5GroupOpen(li_group, runState->runID);
+        XLALH5FileClose(li_group);
+    } else
+        group = LALInferenceH5CreateGroupStructure(output, "lalinference", runState->runID);
+
+    LALH5File *ck_group = XLALH5GroupOpen(output, "checkpoint");
+    checkpoint_group = XLALH5GroupOpen(ck_group, runState->runID);
+    XLALH5FileClose(ck_group);
+    if (!group || !checkpoint_group)
+        XLAL_ERROR_VOID(XLAL_EFUNC, "Could not open output groups for %s", runState->runID);
+
+    n_local_threads = runState->nthreads;
+    for (t = 0; t < n_local_threads; t++) {
+        thread = &runState->threads[t];
+
+        LALInferenceH5SampleWriter *writer = LALInferenceH5SampleWriterOpen(group, thread->currentParams, thread->name, buffer_rows, 1);
+        if (!writer)
+            XLAL_ERROR_VOID(XLAL_EFUNC, "Could not open sample table for %s", thread->name);
+
+        /* Drop rows written after the checkpoint we are resuming from */
+        if (LALInferenceCheckVariable(thread->algorithmParams, "stream_rows"))
+            LALInferenceH5SampleWriterTruncate(writer, LALInferenceGetINT4Variable(thread->algorithmParams, "stream_rows"));
+        LALInferenceAddVariable(thread->algorithmParams, "sample_writer", &writer, LALINFERENCE_void_ptr_t, LALINFERENCE_PARAM_OUTPUT);
+
+        if (thread->differentialPoints == NULL)
+            continue;
+
+        char de_name[1024];
+        snprintf(de_name, sizeof(de_name), "%s-differential_points", thread->name);
+        LALInferenceH5SampleWriter *de_writer = LALInferenceH5SampleWriterOpen(checkpoint_group, thread->currentParams, de_name, buffer_rows, 1);
+        if (!de_writer)
+            XLAL_ERROR_VOID(XLAL_EFUNC, "Could not open DE buffer table for %s", thread->name);
+
+        INT4 de_rows = 0;
+        if (LALInferenceCheckVariable(thread->algorithmParams, "stream_de_rows")) {
+            de_rows = LALInferenceGetINT4Variable(thread->algorithmParams, "stream_de_rows");
+            LALInferenceH5SampleWriterTruncate(de_writer, de_rows);
+        } else
+            LALInferenceH5SampleWriterTruncate(de_writer, 0);
+
+        /* Restore the DE buffer checkpointed in the output file */
+        if (de_rows > 0) {
+            XLALH5FileFlush(checkpoint_group);
+            freeDifferentialEvolutionPoints(thread);
+            LALInferenceH5DatasetToVariablesArray(LALInferenceH5SampleWriterDataset(de_writer), &(thread->differentialPoints), (UINT4 *)&(thread->differentialPointsLength));
+            thread->differentialPointsSize = thread->differentialPointsLength;
+        }
+
+        LALInferenceAddVariable(thread->algorithmParams, "de_writer", &de_writer, LALINFERENCE_void_ptr_t, LALINFERENCE_PARAM_OUTPUT);
+        LALInferenceAddINT4Variable(thread->algorithmParams, "de_rows_saved", de_rows, LALINFERENCE_PARAM_OUTPUT);
+    }
+
+    LALInferenceAddVariable(runState->algorithmParams, "stream_file", &output, LALINFERENCE_void_ptr_t, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddVariable(runState->algorithmParams, "stream_group", &group, LALINFERENCE_void_ptr_t, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddVariable(runState->algorithmParams, "stream_checkpoint_group", &checkpoint_group, LALINFERENCE_void_ptr_t, LALINFERENCE_PARAM_OUTPUT);
+
+    return;
+}
+
+/* Write out buffered samples and the part of each DE buffer not yet on disk,
+ * leaving a consistent output file for checkpointing */
+void LALInferenceFlushMCMCStream(LALInferenceRunState *runState) {
+    INT4 t, n_local_threads;
+    size_t i;
+    LALInferenceThreadState *thread;
+
+    n_local_threads = runState->nthreads;
+    for (t = 0; t < n_local_threads; t++) {
+        thread = &runState->threads[t];
+
+        LALInferenceH5SampleWriter *writer = *(LALInferenceH5SampleWriter **)LALInferenceGetVariable(thread->algorithmParams, "sample_writer");
+        if (LALInferenceH5SampleWriterFlush(writer) != XLAL_SUCCESS)
+            XLAL_ERROR_VOID(XLAL_EFUNC);
+
+        if (!LALInferenceCheckVariable(thread->algorithmParams, "de_writer"))
+            continue;
+
+        /* Only points added since the last flush are appended, unless
+         * the buffer has been thinned or reset in the meantime */
+        LALInferenceH5SampleWriter *de_writer = *(LALInferenceH5SampleWriter **)LALInferenceGetVariable(thread->algorithmParams, "de_writer");
+        size_t de_rows = LALInferenceGetINT4Variable(thread->algorithmParams, "de_rows_saved");
+        if (LALInferenceH5SampleWriterLength(de_writer) != de_rows)
+            LALInferenceH5SampleWriterTruncate(de_writer, de_rows);
+        for (i = de_rows; i < thread->differentialPointsLength; i++)
+            LALInferenceH5SampleWriterAppend(de_writer, thread->differentialPoints[i]);
+        if (LALInferenceH5SampleWriterFlush(de_writer) != XLAL_SUCCESS)
+            XLAL_ERROR_VOID(XLAL_EFUNC);
+        LALInferenceSetINT4Variable(thread->algorithmParams, "de_rows_saved", thread->differentialPointsLength);
+    }
+
+    LALH5File *group = *(LALH5File **)LALInferenceGetVariable(runState->algorithmParams, "stream_group");
+    if (XLALH5FileFlush(group) < 0)
+        XLAL_ERROR_VOID(XLAL_EFUNC);
+
+    return;
+}
+
+/* Finish the streamed output file at the end of the run */
+void LALInferenceCloseMCMCStream(LALInferenceRunState *runState) {
+    INT4 t, n_local_threads;
+    LALInferenceThreadState *thread;
+
+    LALInferenceFlushMCMCStream(runState);
+
+    LALH5File *output = *(LALH5File **)LALInferenceGetVariable(runState->algorithmParams, "stream_file");
+    LALH5File *group = *(LALH5File **)LALInferenceGetVariable(runState->algorithmParams, "stream_group");
+    LALH5File *checkpoint_group = *(LALH5File **)LALInferenceGetVariable(runState->algorithmParams, "stream_checkpoint_group");
+
+    n_local_threads = runState->nthreads;
+    for (t = 0; t < n_local_threads; t++) {
+        thread = &runState->threads[t];
+
+        LALInferenceH5SampleWriterClose(*(LALInferenceH5SampleWriter **)LALInferenceGetVariable(thread->algorithmParams, "sample_writer"));
+        LALInferenceRemoveVariable(thread->algorithmParams, "sample_writer");
+        if (LALInferenceCheckVariable(thread->algorithmParams, "de_writer")) {
+            LALInferenceH5SampleWriterClose(*(LALInferenceH5SampleWriter **)LALInferenceGetVariable(thread->algorithmParams, "de_writer"));
+            LALInferenceRemoveVariable(thread->algorithmParams, "de_writer");
+            LALInferenceRemoveVariable(thread->algorithmParams, "de_rows_saved");
+        }
+    }
+
+    /* Print injection parameters if there are any */
+    LALInferenceVariables *injParams = NULL;
+    if ( !XLALH5FileCheckDatasetExists(group, "injection_params")
+            && (injParams=LALInferencePrintInjectionSample(runState)) )
+    {
+        LALInferenceH5VariablesArrayToDataset(group, &injParams, 1, "injection_params");
+        LALInferenceClearVariables(injParams);
+        XLALFree(injParams);
+    }
+
+    LALH5Generic ggroup = {.file = group};
+    if (!XLALH5AttributeCheckExists(ggroup, "CommandLine")) {
+        char *cl=NULL;
+        cl=LALInferencePrintCommandLine(runState->commandLine);
+        XLALH5FileAddStringAttribute(group,"CommandLine",cl);
+        XLALFree(cl);
+    }
+
+    XLALH5FileClose(checkpoint_group);
+    XLALH5FileClose(group);
+    XLALH5FileClose(output);
+    LALInferenceRemoveVariable(runState->algorithmParams, "stream_checkpoint_group");
+    LALInferenceRemoveVariable(runState->algorithmParams, "stream_group");
+    LALInferenceRemoveVariable(runState->algorithmParams, "stream_file");
+    LALInferencePrintCheckpointFileInfo(runState->outFileName);
+    return;
+}
+
 /* Store the MCMC run state to HDF5 for use by --resume */
 void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
     //ProcessParamsTable *ppt;
@@ -1312,6 +1749,16 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
 
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
 
+    /* When streaming, samples and the DE buffer go to the output file
+     * incrementally; flush them first so the resume file never refers
+     * to rows that are not on disk. */
+    INT4 hdf5_stream = LALInferenceGetINT4Variable(runState->algorithmParams, "hdf5_stream");
+    if (hdf5_stream) {
+        LALInferenceFlushMCMCStream(runState);
+        if (xlalErrno)
+            XLAL_ERROR_VOID(XLAL_EFUNC);
+    }
+
     resume_file = XLALH5FileOpen(runState->resumeOutFileName, "w");
     if(resume_file == NULL){
         XLALErrorHandler = XLALExitErrorHandler;
@@ -1339,7 +1786,15 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
         */
 
         /* Create run identifier group */
-        LALInferenceH5VariablesArrayToDataset(chain_group, thread->differentialPoints, thread->differentialPointsLength, "differential_points");
+        if (hdf5_stream) {
+            INT4 stream_rows = LALInferenceH5SampleWriterLength(*(LALInferenceH5SampleWriter **)LALInferenceGetVariable(thread->algorithmParams, "sample_writer"));
+            XLALH5FileAddScalarAttribute(chain_group, "stream_rows", &stream_rows, LAL_I4_TYPE_CODE);
+            if (LALInferenceCheckVariable(thread->algorithmParams, "de_rows_saved")) {
+                INT4 stream_de_rows = LALInferenceGetINT4Variable(thread->algorithmParams, "de_rows_saved");
+                XLALH5FileAddScalarAttribute(chain_group, "stream_de_rows", &stream_de_rows, LAL_I4_TYPE_CODE);
+            }
+        } else
+            LALInferenceH5VariablesArrayToDataset(chain_group, thread->differentialPoints, thread->differentialPointsLength, "differential_points");
         LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->proposalArgs), 1, "proposal_arguments");
         LALInferenceH5VariablesArrayToDataset(chain_group, &(thread->currentParams), 1, "current_parameters");
         XLALH5FileAddScalarAttribute(chain_group, "temperature", &(thread->temperature), LAL_D_TYPE_CODE);
@@ -1374,6 +1829,7 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     LALH5File *resume_file = NULL;
     LALH5File *output = NULL;
     LALInferenceThreadState *thread;
+    INT4 hdf5_stream = LALInferenceGetINT4Variable(runState->algorithmParams, "hdf5_stream");
     if(! (LALInferenceCheckNonEmptyFile(runState->resumeOutFileName) &&
           LALInferenceCheckNonEmptyFile(runState->outFileName) ) )
     {
@@ -1427,10 +1883,28 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
         XLAL_TRY(de_group = XLALH5DatasetRead(chain_group, "differential_points"), retcode);
         if (retcode==XLAL_SUCCESS)
         {
+            freeDifferentialEvolutionPoints(thread);
             LALInferenceH5DatasetToVariablesArray(de_group, &(thread->differentialPoints), (UINT4 *)&(thread->differentialPointsLength));
             thread->differentialPointsSize = thread->differentialPointsLength;
         }
 
+        /* When streaming, record how much of the output file was
+         * checkpointed.  LALInferenceOpenMCMCStream() discards any later
+         * rows and reads the DE buffer back from the output file. */
+        if (hdf5_stream)
+        {
+            LALH5Generic gchain_group = {.file = chain_group};
+            INT4 stream_rows;
+            if (XLALH5AttributeCheckExists(gchain_group, "stream_rows")) {
+                XLALH5FileQueryScalarAttributeValue(&stream_rows, chain_group, "stream_rows");
+                LALInferenceAddINT4Variable(thread->algorithmParams, "stream_rows", stream_rows, LALINFERENCE_PARAM_OUTPUT);
+            }
+            if (XLALH5AttributeCheckExists(gchain_group, "stream_de_rows")) {
+                XLALH5FileQueryScalarAttributeValue(&stream_rows, chain_group, "stream_de_rows");
+                LALInferenceAddINT4Variable(thread->algorithmParams, "stream_de_rows", stream_rows, LALINFERENCE_PARAM_OUTPUT);
+            }
+        }
+
         /* Restore proposal arguments, most importantly adaptation settings */
         LALInferenceVariables **propArgs;
         LALH5Dataset *prop_arg_group = XLALH5DatasetRead(chain_group, "proposal_arguments");
@@ -1487,8 +1961,12 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     XLALH5FileClose(li_group);
     XLALH5FileClose(resume_file);
 
-    /* Read in samples collected so far */
-    
+    /* Read in samples collected so far; streamed samples stay on disk */
+    if (hdf5_stream) {
+        LALInferenceAddINT4Variable(runState->algorithmParams, "stream_resume", 1, LALINFERENCE_PARAM_OUTPUT);
+        XLALH5FileClose(output);
+        return;
+    }
 
     li_group = XLALH5GroupOpen(output, "lalinference");
     group = XLALH5GroupOpen(li_group, runState->runID);
@@ -1529,6 +2007,15 @@ void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
 
     MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
 
+    /* Streamed samples only need the new rows writing out */
+    if (LALInferenceGetINT4Variable(runState->algorithmParams, "hdf5_stream")) {
+        LALInferenceFlushMCMCStream(runState);
+        if (xlalErrno)
+            XLAL_ERROR_VOID(XLAL_EFUNC);
+        LALInferencePrintCheckpointFileInfo(runState->outFileName);
+        return;
+    }
+
     output = XLALH5FileOpen(runState->outFileName, "w");
     if(output == NULL){
         XLALErrorHandler = XLALExitErrorHandler;
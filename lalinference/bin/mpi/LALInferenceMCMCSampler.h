@@ -54,7 +54,8 @@ typedef enum {
     PT_COM,          /** Parallel tempering communications */
     LADDER_UPDATE_COM,    /** Update positions across the ladder */
     RUN_PHASE_COM,   /** runPhase passing */
-    RUN_COMPLETE       /** Run complete */
+    RUN_COMPLETE,      /** Run complete */
+    PT_ASYNC_COM       /** Asynchronous parallel tempering communications */
 } LALInferenceMPIcomm;
 
 /* Temperature ladder adaptation */
@@ -63,6 +64,9 @@ void LALInferenceAdaptLadder(LALInferenceRunState *runState);
 /* Standard parallel temperature swap proposal function */
 void LALInferencePTswap(LALInferenceRunState *runState, FILE *swapfile);
 
+/* Parallel temperature swap using nonblocking exchanges between neighbouring processes only */
+void LALInferencePTswapAsync(LALInferenceRunState *runState, FILE *swapfile);
+
 /* Metropolis-coupled MCMC swap proposal, when the likelihood is not identical between chains */
 //UINT4 LALInferenceMCMCMCswap(LALInferenceRunState *runState, REAL8 *ladder, INT4 i, FILE *swapfile);
 
@@ -85,6 +89,12 @@ void LALInferenceSaveSample(LALInferenceThreadState *thread, FILE *output);
 void LALInferencePrintAdaptationSettings(FILE *outfile, LALInferenceThreadState *thread);
 void LALInferencePrintMCMCSample(LALInferenceThreadState *thread, LALInferenceIFOData *data, INT4 iteration, REAL8 timestamp, FILE *threadoutput);
 void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState);
+/** Open the output file and per-chain sample writers for --hdf5-stream */
+void LALInferenceOpenMCMCStream(LALInferenceRunState *runState);
+/** Write buffered samples and new DE buffer points to the streamed output file */
+void LALInferenceFlushMCMCStream(LALInferenceRunState *runState);
+/** Flush and close the streamed output file at the end of the run */
+void LALInferenceCloseMCMCStream(LALInferenceRunState *runState);
 void LALInferenceNameOutputs(LALInferenceRunState *runState);
 void LALInferenceCheckpointMCMC(LALInferenceRunState *runState);
 void LALInferenceResumeMCMC(LALInferenceRunState *runState);
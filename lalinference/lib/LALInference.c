@@ -24,6 +24,7 @@
 #include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <lal/LALInference.h>
 #include <lal/Units.h>
@@ -41,6 +42,10 @@
 #include <lal/LALHashFunc.h>
 #include <lal/LALSimNeutronStar.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
 #else
@@ -4422,6 +4427,304 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
   }
 }
 
+struct tagLALInferenceSplineCalibrationCache {
+  UINT4 npts;          /* Number of spline nodes */
+  REAL8 *logfreqs;     /* Node log-frequencies the basis was built for */
+  REAL8 *curvature;    /* npts x npts map from node values to spline second derivatives */
+
+  UINT4 nfreq;         /* Number of evaluation frequencies */
+  REAL8 deltaF;        /* Grid spacing (uniform grid only) */
+  REAL8 *freqs;        /* Evaluation frequencies (arbitrary nodes only) */
+  INT4 *interval;      /* Bracketing spline interval of each frequency, -1 outside the nodes */
+  REAL8 *weights;      /* Four basis weights per frequency */
+
+  REAL8 *amps, *phases; /* Node values at the last evaluation */
+  REAL8 *ampCurv, *phaseCurv; /* Spline second derivatives at the nodes */
+  COMPLEX16 *calFactor; /* Calibration factors at the last evaluation */
+  int valid;           /* calFactor is up to date with amps and phases */
+};
+
+LALInferenceSplineCalibrationCache *LALInferenceCreateSplineCalibrationCache(void)
+{
+  LALInferenceSplineCalibrationCache *cache = XLALCalloc(1, sizeof(*cache));
+  if (cache == NULL) XLAL_ERROR_NULL(XLAL_ENOMEM);
+  return cache;
+}
+
+static void spcal_cache_free_nodes(LALInferenceSplineCalibrationCache *cache)
+{
+  XLALFree(cache->logfreqs);
+  XLALFree(cache->curvature);
+  XLALFree(cache->amps);
+  XLALFree(cache->phases);
+  XLALFree(cache->ampCurv);
+  XLALFree(cache->phaseCurv);
+  cache->logfreqs = cache->curvature = cache->amps = cache->phases = NULL;
+  cache->ampCurv = cache->phaseCurv = NULL;
+  cache->npts = 0;
+}
+
+static void spcal_cache_free_grid(LALInferenceSplineCalibrationCache *cache)
+{
+  XLALFree(cache->freqs);
+  XLALFree(cache->interval);
+  XLALFree(cache->weights);
+  XLALFree(cache->calFactor);
+  cache->freqs = cache->weights = NULL;
+  cache->interval = NULL;
+  cache->calFactor = NULL;
+  cache->nfreq = 0;
+  cache->deltaF = 0.0;
+}
+
+void LALInferenceDestroySplineCalibrationCache(LALInferenceSplineCalibrationCache *cache)
+{
+  if (cache == NULL) return;
+  spcal_cache_free_nodes(cache);
+  spcal_cache_free_grid(cache);
+  XLALFree(cache);
+}
+
+void LALInferenceDestroyModelSplineCalibrationCaches(LALInferenceModel *model)
+{
+  UINT4 k;
+  if (model == NULL) return;
+  for (k = 0; k < model->spcal_cache_length; k++)
+    LALInferenceDestroySplineCalibrationCache(model->spcal_cache[k]);
+  XLALFree(model->spcal_cache);
+  model->spcal_cache = NULL;
+  model->spcal_cache_length = 0;
+}
+
+/* Build the matrix K such that the second derivatives of the natural
+ * cubic spline through (x_j, y_j) are M = K y.  The interior rows solve
+ * the usual tridiagonal system, one right-hand side per unit vector. */
+static int spcal_cache_set_nodes(LALInferenceSplineCalibrationCache *cache, const REAL8Vector *logfreqs)
+{
+  const UINT4 n = logfreqs->length;
+  const REAL8 *x = logfreqs->data;
+
+  spcal_cache_free_nodes(cache);
+  cache->logfreqs = XLALMalloc(n * sizeof(REAL8));
+  cache->curvature = XLALCalloc(n * n, sizeof(REAL8));
+  cache->amps = XLALMalloc(n * sizeof(REAL8));
+  cache->phases = XLALMalloc(n * sizeof(REAL8));
+  cache->ampCurv = XLALMalloc(n * sizeof(REAL8));
+  cache->phaseCurv = XLALMalloc(n * sizeof(REAL8));
+  if (!cache->logfreqs || !cache->curvature || !cache->amps || !cache->phases || !cache->ampCurv || !cache->phaseCurv) {
+    spcal_cache_free_nodes(cache);
+    XLAL_ERROR(XLAL_ENOMEM);
+  }
+  memcpy(cache->logfreqs, x, n * sizeof(REAL8));
+  cache->npts = n;
+
+  for (UINT4 i = 0; i + 1 < n; i++)
+    if (!(x[i+1] > x[i])) {
+      spcal_cache_free_nodes(cache);
+      XLAL_ERROR(XLAL_EINVAL, "spline calibration nodes must be strictly increasing");
+    }
+
+  if (n < 3) return XLAL_SUCCESS;
+
+  const UINT4 m = n - 2;
+  REAL8 *diag = XLALMalloc(m * sizeof(REAL8));
+  REAL8 *rhs = XLALMalloc(m * sizeof(REAL8));
+  if (!diag || !rhs) {
+    XLALFree(diag);
+    XLALFree(rhs);
+    spcal_cache_free_nodes(cache);
+    XLAL_ERROR(XLAL_ENOMEM);
+  }
+
+  for (UINT4 k = 0; k < n; k++) {
+    /* Right-hand side for y = e_k */
+    for (UINT4 i = 0; i < m; i++) {
+      const REAL8 hl = x[i+1] - x[i], hr = x[i+2] - x[i+1];
+      REAL8 r = 0.0;
+      if (k == i) r += 6.0 / hl;
+      if (k == i + 1) r -= 6.0 / hl + 6.0 / hr;
+      if (k == i + 2) r += 6.0 / hr;
+      rhs[i] = r;
+    }
+
+    /* Thomas algorithm */
+    for (UINT4 i = 0; i < m; i++) {
+      const REAL8 hl = x[i+1] - x[i], hr = x[i+2] - x[i+1];
+      diag[i] = 2.0 * (hl + hr);
+      if (i > 0) {
+        const REAL8 w = hl / diag[i-1];
+        diag[i] -= w * hl;
+        rhs[i] -= w * rhs[i-1];
+      }
+    }
+    for (UINT4 i = m; i-- > 0;) {
+      REAL8 r = rhs[i];
+      if (i + 1 < m) r -= (x[i+2] - x[i+1]) * rhs[i+1];
+      rhs[i] = r / diag[i];
+    }
+
+    for (UINT4 i = 0; i < m; i++)
+      cache->curvature[(i + 1) * n + k] = rhs[i];
+  }
+
+  XLALFree(diag);
+  XLALFree(rhs);
+  return XLAL_SUCCESS;
+}
+
+/* Evaluate the compressed basis on the current grid: for a frequency in
+ * interval j the spline is A y_j + B y_{j+1} + C M_j + D M_{j+1}. */
+static int spcal_cache_set_grid(LALInferenceSplineCalibrationCache *cache, UINT4 nfreq, REAL8 deltaF, const REAL8 *freqs)
+{
+  const UINT4 n = cache->npts;
+  const REAL8 *x = cache->logfreqs;
+
+  spcal_cache_free_grid(cache);
+  cache->interval = XLALMalloc(nfreq * sizeof(INT4));
+  cache->weights = XLALMalloc(4 * nfreq * sizeof(REAL8));
+  cache->calFactor = XLALMalloc(nfreq * sizeof(COMPLEX16));
+  if (freqs) cache->freqs = XLALMalloc(nfreq * sizeof(REAL8));
+  if ((nfreq > 0 && (!cache->interval || !cache->weights || !cache->calFactor)) || (freqs && nfreq > 0 && !cache->freqs)) {
+    spcal_cache_free_grid(cache);
+    XLAL_ERROR(XLAL_ENOMEM);
+  }
+  if (freqs) memcpy(cache->freqs, freqs, nfreq * sizeof(REAL8));
+  cache->nfreq = nfreq;
+  cache->deltaF = deltaF;
+
+  const REAL8 lowf = exp(x[0]);
+  const REAL8 highf = exp(x[n-1]);
+  UINT4 j = 0;
+
+  for (UINT4 i = 0; i < nfreq; i++) {
+    const REAL8 f = freqs ? freqs[i] : deltaF * i;
+    REAL8 *w = cache->weights + 4 * i;
+
+    if (f < lowf || f > highf) {
+      cache->interval[i] = -1;
+      w[0] = w[1] = w[2] = w[3] = 0.0;
+      continue;
+    }
+
+    const REAL8 logf = log(f);
+    /* Grids are normally sorted, so start from the previous interval */
+    if (logf < x[j]) j = 0;
+    while (j + 2 < n && logf > x[j+1]) j++;
+
+    const REAL8 h = x[j+1] - x[j];
+    const REAL8 a = (x[j+1] - logf) / h;
+    const REAL8 b = (logf - x[j]) / h;
+    cache->interval[i] = j;
+    w[0] = a;
+    w[1] = b;
+    w[2] = (a * a * a - a) * h * h / 6.0;
+    w[3] = (b * b * b - b) * h * h / 6.0;
+  }
+
+  cache->valid = 0;
+  return XLAL_SUCCESS;
+}
+
+static const COMPLEX16 *spcal_cache_evaluate(LALInferenceSplineCalibrationCache *cache,
+                                             REAL8Vector *logfreqs,
+                                             REAL8Vector *deltaAmps,
+                                             REAL8Vector *deltaPhases,
+                                             UINT4 nfreq, REAL8 deltaF, const REAL8 *freqs)
+{
+  if (cache == NULL || logfreqs == NULL || deltaAmps == NULL || deltaPhases == NULL)
+    XLAL_ERROR_NULL(XLAL_EFAULT);
+  if (logfreqs->length != deltaAmps->length || deltaAmps->length != deltaPhases->length)
+    XLAL_ERROR_NULL(XLAL_EINVAL, "input lengths differ");
+  if (logfreqs->length < 2)
+    XLAL_ERROR_NULL(XLAL_EINVAL, "need at least two spline calibration nodes");
+
+  const UINT4 n = logfreqs->length;
+  const size_t nbytes = n * sizeof(REAL8);
+  int rebuild_grid = 0;
+
+  if (cache->npts != n || memcmp(cache->logfreqs, logfreqs->data, nbytes) != 0) {
+    if (spcal_cache_set_nodes(cache, logfreqs) != XLAL_SUCCESS)
+      XLAL_ERROR_NULL(XLAL_EFUNC);
+    rebuild_grid = 1;
+  }
+  if (!rebuild_grid && (cache->nfreq != nfreq || cache->interval == NULL || (freqs == NULL) != (cache->freqs == NULL)))
+    rebuild_grid = 1;
+  if (!rebuild_grid) {
+    if (freqs)
+      rebuild_grid = memcmp(cache->freqs, freqs, nfreq * sizeof(REAL8)) != 0;
+    else
+      rebuild_grid = cache->deltaF != deltaF;
+  }
+  if (rebuild_grid && spcal_cache_set_grid(cache, nfreq, deltaF, freqs) != XLAL_SUCCESS)
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+
+  if (cache->valid && memcmp(cache->amps, deltaAmps->data, nbytes) == 0 && memcmp(cache->phases, deltaPhases->data, nbytes) == 0)
+    return cache->calFactor;
+
+  memcpy(cache->amps, deltaAmps->data, nbytes);
+  memcpy(cache->phases, deltaPhases->data, nbytes);
+
+  /* Small dense mat-vec for the curvatures at the nodes */
+  for (UINT4 i = 0; i < n; i++) {
+    const REAL8 *row = cache->curvature + i * n;
+    REAL8 ma = 0.0, mp = 0.0;
+    for (UINT4 k = 0; k < n; k++) {
+      ma += row[k] * cache->amps[k];
+      mp += row[k] * cache->phases[k];
+    }
+    cache->ampCurv[i] = ma;
+    cache->phaseCurv[i] = mp;
+  }
+
+  const INT4 *interval = cache->interval;
+  const REAL8 *weights = cache->weights;
+  const REAL8 *ya = cache->amps, *yp = cache->phases;
+  const REAL8 *ma = cache->ampCurv, *mp = cache->phaseCurv;
+  COMPLEX16 *calFactor = cache->calFactor;
+
+  /* (2 + i dPhi)/(2 - i dPhi) = (4 - dPhi^2 + 4 i dPhi)/(4 + dPhi^2) */
+  #pragma omp simd
+  for (UINT4 i = 0; i < nfreq; i++) {
+    const INT4 j = interval[i];
+    REAL8 dA = 0.0, dPhi = 0.0;
+    if (j >= 0) {
+      const REAL8 *w = weights + 4 * i;
+      dA = w[0] * ya[j] + w[1] * ya[j+1] + w[2] * ma[j] + w[3] * ma[j+1];
+      dPhi = w[0] * yp[j] + w[1] * yp[j+1] + w[2] * mp[j] + w[3] * mp[j+1];
+    }
+    const REAL8 dPhi2 = dPhi * dPhi;
+    const REAL8 norm = (1.0 + dA) / (4.0 + dPhi2);
+    calFactor[i] = crect(norm * (4.0 - dPhi2), norm * 4.0 * dPhi);
+  }
+
+  cache->valid = 1;
+  return cache->calFactor;
+}
+
+const COMPLEX16 *LALInferenceSplineCalibrationFactorCached(LALInferenceSplineCalibrationCache *cache,
+					REAL8Vector *logfreqs,
+					REAL8Vector *deltaAmps,
+					REAL8Vector *deltaPhases,
+					REAL8 deltaF,
+					UINT4 length)
+{
+  const COMPLEX16 *calFactor = spcal_cache_evaluate(cache, logfreqs, deltaAmps, deltaPhases, length, deltaF, NULL);
+  if (calFactor == NULL) XLAL_ERROR_NULL(XLAL_EFUNC);
+  return calFactor;
+}
+
+const COMPLEX16 *LALInferenceSplineCalibrationFactorCachedNodes(LALInferenceSplineCalibrationCache *cache,
+					REAL8Vector *logfreqs,
+					REAL8Vector *deltaAmps,
+					REAL8Vector *deltaPhases,
+					REAL8Sequence *freqNodes)
+{
+  if (freqNodes == NULL) XLAL_ERROR_NULL(XLAL_EFAULT);
+  const COMPLEX16 *calFactor = spcal_cache_evaluate(cache, logfreqs, deltaAmps, deltaPhases, freqNodes->length, 0.0, freqNodes->data);
+  if (calFactor == NULL) XLAL_ERROR_NULL(XLAL_EFUNC);
+  return calFactor;
+}
+
 void LALInferenceFprintSplineCalibrationHeader(FILE *output, LALInferenceThreadState *thread) {
     INT4 i, nifo;
     char **ifo_names = NULL;
@@ -372,6 +372,52 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
 					REAL8Sequence *freqNodesQuad,
 					COMPLEX16Sequence **calFactorROQQuad);
 
+/**
+ * Cached evaluation of the spline calibration model.
+ *
+ * For fixed node log-frequencies the natural cubic spline is linear in
+ * the node values, so the spline evaluated on a fixed frequency grid
+ * can be written as a basis matrix applied to the amplitude and phase
+ * node vectors.  The cache stores that basis in compressed form (the
+ * bracketing interval and four weights per frequency, plus the small
+ * dense matrix mapping node values onto spline curvatures) and rebuilds
+ * it only when the nodes or the grid change.  The calibration factors
+ * themselves are recomputed only when the node values change.
+ */
+typedef struct tagLALInferenceSplineCalibrationCache LALInferenceSplineCalibrationCache;
+
+/** Allocate an empty spline calibration cache. */
+LALInferenceSplineCalibrationCache *LALInferenceCreateSplineCalibrationCache(void);
+
+/** Free a spline calibration cache. */
+void LALInferenceDestroySplineCalibrationCache(LALInferenceSplineCalibrationCache *cache);
+
+/**
+ * Cached equivalent of LALInferenceSplineCalibrationFactor() on the
+ * frequency grid \f$f_i = i \Delta f\f$, \f$i < \mathrm{length}\f$.
+ * Returns a pointer to \c length calibration factors owned by the
+ * cache, valid until the next call with the same cache, or NULL on
+ * error.
+ */
+const COMPLEX16 *LALInferenceSplineCalibrationFactorCached(LALInferenceSplineCalibrationCache *cache,
+					REAL8Vector *logfreqs,
+					REAL8Vector *deltaAmps,
+					REAL8Vector *deltaPhases,
+					REAL8 deltaF,
+					UINT4 length);
+
+/**
+ * Cached equivalent of LALInferenceSplineCalibrationFactor() at an
+ * arbitrary set of frequencies, such as the ROQ frequency nodes.
+ * Returns a pointer to <tt>freqNodes->length</tt> calibration factors
+ * owned by the cache, or NULL on error.
+ */
+const COMPLEX16 *LALInferenceSplineCalibrationFactorCachedNodes(LALInferenceSplineCalibrationCache *cache,
+					REAL8Vector *logfreqs,
+					REAL8Vector *deltaAmps,
+					REAL8Vector *deltaPhases,
+					REAL8Sequence *freqNodes);
+
 
 //Wrapper for template computation
 //(relies on LAL libraries for implementation) <- could be a #DEFINE ?
@@ -472,9 +518,15 @@ typedef struct tagLALInferenceModel
   struct tagLALInferenceROQModel *roq; /** ROQ data */
   int roq_flag;               /** Is ROQ enabled */
   LALSimNeutronStarFamily     *eos_fam; /** Neutron Star equation of state family */
+  LALInferenceSplineCalibrationCache **spcal_cache; /** Spline calibration caches, one per IFO (two per IFO with ROQ) */
+  UINT4                        spcal_cache_length; /** Number of entries in spcal_cache */
 
 } LALInferenceModel;
 
+/** Free the spline calibration caches of \c model, which the likelihood
+ * allocates on first use. */
+void LALInferenceDestroyModelSplineCalibrationCaches(LALInferenceModel *model);
+
 
 /**
  * Type declaration for variables init function, can be user-declared.
@@ -1236,6 +1236,27 @@ void LALInferenceKmeansBuildKDE(LALInferenceKmeans *kmeans) {
 }
 
 
+/**
+ * Build k-d trees for approximate evaluation of the cluster KDEs.
+ *
+ * Once clustering is complete, evaluations of the clustered-KDE PDF can be
+ * accelerated by approximating the sum over each cluster's kernels.
+ * @param kmeans  The kmeans whose cluster KDEs will be accelerated.
+ * @param rel_tol Relative error allowed in each cluster's kernel sum.
+ * @param cutoff  Kernel cutoff in kernel widths (INFINITY for none).
+ * \sa LALInferenceKDEBuildTree()
+ */
+void LALInferenceKmeansBuildKDETrees(LALInferenceKmeans *kmeans, REAL8 rel_tol, REAL8 cutoff) {
+    INT4 i;
+
+    if (kmeans->KDEs == NULL)
+        LALInferenceKmeansBuildKDE(kmeans);
+
+    for (i = 0; i < kmeans->k; i++)
+        LALInferenceKDEBuildTree(kmeans->KDEs[i], rel_tol, cutoff);
+}
+
+
 /**
  * Calculate max likelihood of a kmeans assuming spherical Gaussian clusters.
  *
@@ -139,6 +139,9 @@ void euclidean_centroid(gsl_vector *centroid, gsl_matrix *data, INT4 *mask);
 /* Build the kernel density estimate from a kmeans clustering. */
 void LALInferenceKmeansBuildKDE(LALInferenceKmeans *kmeans);
 
+/* Build k-d trees for approximate evaluation of the cluster KDEs. */
+void LALInferenceKmeansBuildKDETrees(LALInferenceKmeans *kmeans, REAL8 rel_tol, REAL8 cutoff);
+
 /* Calculate the maximum likelihood of a given kmeans assuming spherical Gaussian clusters. */
 REAL8 LALInferenceKmeansMaxLogL(LALInferenceKmeans *kmeans);
 
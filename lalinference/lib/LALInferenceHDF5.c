@@ -21,6 +21,7 @@
 #include <lal/LALInferenceVCSInfo.h>
 #include <lal/H5FileIO.h>
 #include <lal/LALVCSInfoType.h>
+#include <lal/LALString.h>
 #include <lal/LALInferenceHDF5.h>
 #include <assert.h>
 #include <stdlib.h>
@@ -208,30 +209,21 @@ int LALInferenceH5DatasetToVariablesArray(
 }
 
 
-int LALInferenceH5VariablesArrayToDataset(
-    LALH5File *h5file, LALInferenceVariables *const *const varsArray, UINT4 N,
-    const char *TableName)
+/* Build the list of table columns (varying and output parameters) and
+ * fixed parameters of vars, as stored by LALInferenceH5VariablesArrayToDataset.
+ * The arrays must have room for vars->dimension entries.  Returns the
+ * number of columns. */
+static UINT4 LALInferenceH5VariablesColumns(
+    LALInferenceVariables *vars, const char **column_names,
+    LALTYPECODE *column_types, size_t *column_sizes, size_t *column_offsets,
+    int *vary, size_t *type_size, char **fixed_names, UINT4 *Nfixed)
 {
-    /* Sanity check input */
-    if (!varsArray)
-        XLAL_ERROR(XLAL_EFAULT, "Received null varsArray pointer");
-    if (!h5file)
-        XLAL_ERROR(XLAL_EFAULT, "Received null h5file pointer");
-    if (N == 0)
-        return 0;
-
-    const char *column_names[varsArray[0]->dimension];
     UINT4 Nvary = 0;
-    size_t type_size = 0;
-    size_t column_offsets[varsArray[0]->dimension];
-    size_t column_sizes[varsArray[0]->dimension];
-    LALTYPECODE column_types[varsArray[0]->dimension];
-    char *fixed_names[varsArray[0]->dimension];
-    int vary[varsArray[0]->dimension];
-    UINT4 Nfixed = 0;
+    *type_size = 0;
+    *Nfixed = 0;
 
     /* Build a list of PARAM and FIELD elements */
-    for (LALInferenceVariableItem *varitem = varsArray[0]->head; varitem;
+    for (LALInferenceVariableItem *varitem = vars->head; varitem;
          varitem = varitem->next)
     {
         switch(varitem->vary)
@@ -266,18 +258,71 @@ int LALInferenceH5VariablesArrayToDataset(
                 vary[Nvary] = varitem->vary;
                 column_types[Nvary] = tp;
                 column_sizes[Nvary] = sz;
-                column_offsets[Nvary] = type_size;
-                type_size += sz;
+                column_offsets[Nvary] = *type_size;
+                *type_size += sz;
                 column_names[Nvary++] = varitem->name;
                 break;
             }
             case LALINFERENCE_PARAM_FIXED:
-                fixed_names[Nfixed++] = varitem->name;
+                fixed_names[(*Nfixed)++] = varitem->name;
                 break;
             default:
                 XLALPrintWarning("Unknown param vary type");
         }
     }
+    return Nvary;
+}
+
+
+/* Write the FIELD_%d_VARY and fixed parameter attributes of a table */
+static void LALInferenceH5WriteTableAttributes(
+    LALH5Dataset *dataset, LALInferenceVariables *vars, const int *vary,
+    UINT4 Nvary, char **fixed_names, UINT4 Nfixed)
+{
+    int ret;
+    LALH5Generic gdataset = {.dset = dataset};
+    for (UINT4 i = 0; i < Nvary; i ++)
+    {
+        INT4 value = vary[i];
+        char pname[] = "FIELD_NNN_VARY";
+        snprintf(pname, sizeof(pname), "FIELD_%d_VARY", i);
+        ret = XLALH5AttributeAddScalar(
+            gdataset, pname, &value, LAL_I4_TYPE_CODE);
+        (void) ret;
+        assert(ret == 0);
+    }
+
+    /* Write attributes, if any */
+    for (UINT4 i = 0; i < Nfixed; i++)
+        LALInferenceH5VariableToAttribute(gdataset, vars, fixed_names[i]);
+}
+
+
+int LALInferenceH5VariablesArrayToDataset(
+    LALH5File *h5file, LALInferenceVariables *const *const varsArray, UINT4 N,
+    const char *TableName)
+{
+    /* Sanity check input */
+    if (!varsArray)
+        XLAL_ERROR(XLAL_EFAULT, "Received null varsArray pointer");
+    if (!h5file)
+        XLAL_ERROR(XLAL_EFAULT, "Received null h5file pointer");
+    if (N == 0)
+        return 0;
+
+    const char *column_names[varsArray[0]->dimension];
+    UINT4 Nvary = 0;
+    size_t type_size = 0;
+    size_t column_offsets[varsArray[0]->dimension];
+    size_t column_sizes[varsArray[0]->dimension];
+    LALTYPECODE column_types[varsArray[0]->dimension];
+    char *fixed_names[varsArray[0]->dimension];
+    int vary[varsArray[0]->dimension];
+    UINT4 Nfixed = 0;
+
+    Nvary = LALInferenceH5VariablesColumns(varsArray[0], column_names,
+        column_types, column_sizes, column_offsets, vary, &type_size,
+        fixed_names, &Nfixed);
 
     /* Gather together data in one big array */
     char *data = XLALCalloc(N, type_size);
@@ -302,27 +347,212 @@ int LALInferenceH5VariablesArrayToDataset(
     assert(ret == 0);
     XLALFree(data);
 
-    LALH5Generic gdataset = {.dset = dataset};
-    for (UINT4 i = 0; i < Nvary; i ++)
+    LALInferenceH5WriteTableAttributes(
+        dataset, varsArray[0], vary, Nvary, fixed_names, Nfixed);
+
+    XLALH5DatasetFree(dataset);
+    return XLAL_SUCCESS;
+}
+
+
+struct tagLALInferenceH5SampleWriter {
+    LALH5Dataset *dataset;
+    UINT4 ncols;
+    char **column_names;
+    size_t *column_sizes;
+    size_t *column_offsets;
+    size_t type_size;
+    char *buffer;       /* packed rows not yet written */
+    UINT4 nbuffered;    /* rows in buffer */
+    UINT4 buffer_rows;  /* capacity of buffer */
+    UINT4 nwritten;     /* rows already in the dataset */
+};
+
+
+LALInferenceH5SampleWriter *LALInferenceH5SampleWriterOpen(
+    LALH5File *h5file, LALInferenceVariables *vars, const char *TableName,
+    UINT4 bufferRows, INT4 compress)
+{
+    if (!h5file)
+        XLAL_ERROR_NULL(XLAL_EFAULT, "Received null h5file pointer");
+    if (!vars || vars->dimension == 0)
+        XLAL_ERROR_NULL(XLAL_EINVAL, "Need a non-empty sample to define the table columns");
+    if (bufferRows == 0)
+        XLAL_ERROR_NULL(XLAL_EINVAL, "Buffer must hold at least one row");
+
+    const char *column_names[vars->dimension];
+    size_t column_offsets[vars->dimension];
+    size_t column_sizes[vars->dimension];
+    LALTYPECODE column_types[vars->dimension];
+    char *fixed_names[vars->dimension];
+    int vary[vars->dimension];
+    UINT4 Nfixed = 0;
+    size_t type_size = 0;
+
+    UINT4 Nvary = LALInferenceH5VariablesColumns(vars, column_names,
+        column_types, column_sizes, column_offsets, vary, &type_size,
+        fixed_names, &Nfixed);
+
+    LALInferenceH5SampleWriter *writer = XLALCalloc(1, sizeof(*writer));
+    if (!writer)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+    /* Continue an existing table, e.g. when resuming, or start a new one */
+    if (XLALH5FileCheckDatasetExists(h5file, TableName))
     {
-        INT4 value = vary[i];
-        char pname[] = "FIELD_NNN_VARY";
-        snprintf(pname, sizeof(pname), "FIELD_%d_VARY", i);
-        ret = XLALH5AttributeAddScalar(
-            gdataset, pname, &value, LAL_I4_TYPE_CODE);
-        assert(ret == 0);
+        writer->dataset = XLALH5DatasetRead(h5file, TableName);
+        if (!writer->dataset)
+        {
+            XLALFree(writer);
+            XLAL_ERROR_NULL(XLAL_EFUNC, "Could not open table %s", TableName);
+        }
+        if (XLALH5TableQueryNColumns(writer->dataset) != Nvary
+            || XLALH5TableQueryRowSize(writer->dataset) != type_size)
+        {
+            XLALH5DatasetFree(writer->dataset);
+            XLALFree(writer);
+            XLAL_ERROR_NULL(XLAL_EINVAL,
+                "Existing table %s does not match sample columns", TableName);
+        }
+        writer->nwritten = XLALH5TableQueryNRows(writer->dataset);
+    }
+    else
+    {
+        writer->dataset = XLALH5TableAllocChunked(h5file, TableName, Nvary,
+            column_names, column_types, column_offsets, type_size, bufferRows,
+            compress);
+        if (!writer->dataset)
+        {
+            XLALFree(writer);
+            XLAL_ERROR_NULL(XLAL_EFUNC, "Could not create table %s", TableName);
+        }
+        LALInferenceH5WriteTableAttributes(
+            writer->dataset, vars, vary, Nvary, fixed_names, Nfixed);
     }
 
-    /* Write attributes, if any */
-    for (UINT4 i = 0; i < Nfixed; i++)
-        LALInferenceH5VariableToAttribute(
-            gdataset, varsArray[0], fixed_names[i]);
+    writer->ncols = Nvary;
+    writer->type_size = type_size;
+    writer->buffer_rows = bufferRows;
+    writer->column_names = XLALCalloc(Nvary, sizeof(char *));
+    writer->column_sizes = XLALCalloc(Nvary, sizeof(size_t));
+    writer->column_offsets = XLALCalloc(Nvary, sizeof(size_t));
+    writer->buffer = XLALCalloc(bufferRows, type_size);
+    if (!writer->column_names || !writer->column_sizes
+        || !writer->column_offsets || !writer->buffer)
+    {
+        LALInferenceH5SampleWriterClose(writer);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    for (UINT4 j = 0; j < Nvary; j++)
+    {
+        writer->column_names[j] = XLALStringDuplicate(column_names[j]);
+        writer->column_sizes[j] = column_sizes[j];
+        writer->column_offsets[j] = column_offsets[j];
+    }
 
-    XLALH5DatasetFree(dataset);
+    return writer;
+}
+
+
+int LALInferenceH5SampleWriterAppend(
+    LALInferenceH5SampleWriter *writer, LALInferenceVariables *vars)
+{
+    if (!writer || !vars)
+        XLAL_ERROR(XLAL_EFAULT);
+
+    char *row = writer->buffer + writer->type_size * writer->nbuffered;
+    for (UINT4 j = 0; j < writer->ncols; j++)
+    {
+        void *var = LALInferenceGetVariable(vars, writer->column_names[j]);
+        if (!var)
+            XLAL_ERROR(XLAL_EINVAL, "Sample has no parameter %s",
+                writer->column_names[j]);
+        memcpy(row + writer->column_offsets[j], var, writer->column_sizes[j]);
+    }
+
+    if (++writer->nbuffered == writer->buffer_rows)
+        return LALInferenceH5SampleWriterFlush(writer);
     return XLAL_SUCCESS;
 }
 
 
+int LALInferenceH5SampleWriterFlush(LALInferenceH5SampleWriter *writer)
+{
+    if (!writer)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (writer->nbuffered == 0)
+        return XLAL_SUCCESS;
+
+    if (XLALH5TableAppend(writer->dataset, writer->column_offsets,
+            writer->column_sizes, writer->nbuffered, writer->type_size,
+            writer->buffer) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+
+    writer->nwritten += writer->nbuffered;
+    writer->nbuffered = 0;
+    return XLAL_SUCCESS;
+}
+
+
+int LALInferenceH5SampleWriterTruncate(
+    LALInferenceH5SampleWriter *writer, UINT4 N)
+{
+    if (!writer)
+        XLAL_ERROR(XLAL_EFAULT);
+
+    if (N >= writer->nwritten)
+    {
+        if (N > writer->nwritten + writer->nbuffered)
+            XLAL_ERROR(XLAL_EINVAL, "Cannot truncate %u rows to %u",
+                writer->nwritten + writer->nbuffered, N);
+        writer->nbuffered = N - writer->nwritten;
+        return XLAL_SUCCESS;
+    }
+
+    writer->nbuffered = 0;
+    if (XLALH5TableTruncate(writer->dataset, N) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    writer->nwritten = N;
+    return XLAL_SUCCESS;
+}
+
+
+UINT4 LALInferenceH5SampleWriterLength(
+    const LALInferenceH5SampleWriter *writer)
+{
+    return writer ? writer->nwritten + writer->nbuffered : 0;
+}
+
+
+LALH5Dataset *LALInferenceH5SampleWriterDataset(
+    const LALInferenceH5SampleWriter *writer)
+{
+    return writer ? writer->dataset : NULL;
+}
+
+
+int LALInferenceH5SampleWriterClose(LALInferenceH5SampleWriter *writer)
+{
+    int ret = XLAL_SUCCESS;
+    if (!writer)
+        return ret;
+
+    if (writer->dataset && writer->buffer)
+        ret = LALInferenceH5SampleWriterFlush(writer);
+
+    if (writer->column_names)
+        for (UINT4 j = 0; j < writer->ncols; j++)
+            XLALFree(writer->column_names[j]);
+    XLALFree(writer->column_names);
+    XLALFree(writer->column_sizes);
+    XLALFree(writer->column_offsets);
+    XLALFree(writer->buffer);
+    XLALH5DatasetFree(writer->dataset);
+    XLALFree(writer);
+    return ret;
+}
+
+
 static void LALInferenceH5VariableToAttribute(
     LALH5Generic gdataset, LALInferenceVariables *vars, char *name)
 {
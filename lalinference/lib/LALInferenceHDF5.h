@@ -40,6 +40,48 @@ int LALInferenceH5VariablesArrayToDataset(
 int LALInferenceH5DatasetToVariablesArray(
     LALH5Dataset *dataset, LALInferenceVariables ***varsArray, UINT4 *N);
 
+/**
+ * Buffered writer that streams samples into a HDF5 table.
+ *
+ * Rows are packed into a buffer of bufferRows samples, which is appended
+ * to a chunked (and optionally compressed) table each time it fills, so
+ * memory use does not grow with the length of the run.  The columns are
+ * those that LALInferenceH5VariablesArrayToDataset() would write for the
+ * sample used to open the writer.
+ */
+typedef struct tagLALInferenceH5SampleWriter LALInferenceH5SampleWriter;
+
+/**
+ * Open a writer for table TableName in h5file, with columns taken from
+ * vars.  If the table already exists (h5file opened for appending) new
+ * rows are appended after the existing ones.
+ */
+LALInferenceH5SampleWriter *LALInferenceH5SampleWriterOpen(
+    LALH5File *h5file, LALInferenceVariables *vars, const char *TableName,
+    UINT4 bufferRows, INT4 compress);
+
+/** Add one sample to the writer, writing the buffer out if it is full */
+int LALInferenceH5SampleWriterAppend(
+    LALInferenceH5SampleWriter *writer, LALInferenceVariables *vars);
+
+/** Write all buffered samples to the table */
+int LALInferenceH5SampleWriterFlush(LALInferenceH5SampleWriter *writer);
+
+/** Discard all but the first N samples (written or buffered) */
+int LALInferenceH5SampleWriterTruncate(
+    LALInferenceH5SampleWriter *writer, UINT4 N);
+
+/** Number of samples written or buffered */
+UINT4 LALInferenceH5SampleWriterLength(
+    const LALInferenceH5SampleWriter *writer);
+
+/** The table written to, e.g. for reading back flushed samples */
+LALH5Dataset *LALInferenceH5SampleWriterDataset(
+    const LALInferenceH5SampleWriter *writer);
+
+/** Flush and free the writer, leaving the table in its file */
+int LALInferenceH5SampleWriterClose(LALInferenceH5SampleWriter *writer);
+
 /**
  * Create a HDF5 heirarchy in the given LALH5File reference
  * /codename/runID/
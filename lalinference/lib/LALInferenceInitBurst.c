@@ -240,6 +240,8 @@ LALInferenceModel * LALInferenceInitBurstModel(LALInferenceRunState *state)
   LALInferenceModel *model = XLALMalloc(sizeof(LALInferenceModel));
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
+  model->spcal_cache = NULL;
+  model->spcal_cache_length = 0;
   LALInferenceVariables *currentParams=model->params;
 
   UINT4 signal_flag=1;
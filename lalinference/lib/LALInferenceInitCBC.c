@@ -750,6 +750,7 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
     (--tidalOrder PNorder)          Specify twice the PN order (e.g. 10 <==> 5PN) of tidal effects to use, only for LALSimulation (default: -1 <==> Use all tidal effects).\n\
     (--numreldata FileName)         Location of NR data file for NR waveforms (with NR_hdf5 approx).\n\
     (--modeldomain)                 domain the waveform template will be computed in (\"time\" or \"frequency\"). If not given will use LALSim to decide\n\
+    (--waveform-cache-size N)       Keep the N most recently used waveforms for reuse under extrinsic-only changes (default 1).\n\
     (--spinAligned or --aligned-spin)  template will assume spins aligned with the orbital angular momentum.\n\
     (--singleSpin)                  template will assume only the spin of the most massive binary component exists.\n\
     (--noSpin, --disable-spin)      template will assume no spins (giving this will void spinOrder!=0) \n\
@@ -930,6 +931,8 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
   model->eos_fam = NULL;
+  model->spcal_cache = NULL;
+  model->spcal_cache_length = 0;
 
   UINT4 signal_flag=1;
   ppt = LALInferenceGetProcParamVal(commandLine, "--noiseonly");
@@ -1640,7 +1643,17 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   model->freqToTimeFFTPlan = state->data->freqToTimeFFTPlan;
 
   /* Initialize waveform cache */
-  model->waveformCache = XLALCreateSimInspiralWaveformCache();
+  ppt=LALInferenceGetProcParamVal(commandLine,"--waveform-cache-size");
+  if(ppt){
+    INT4 cache_size=atoi(ppt->value);
+    if(cache_size<1){
+      fprintf(stderr,"ERROR: --waveform-cache-size must be at least 1\n");
+      exit(1);
+    }
+    model->waveformCache = XLALCreateSimInspiralWaveformCacheLRU(cache_size, 0);
+  }
+  else
+    model->waveformCache = XLALCreateSimInspiralWaveformCache();
 
   return(model);
 }
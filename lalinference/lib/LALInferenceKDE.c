@@ -41,6 +41,31 @@
 #define omp ignore
 #endif
 
+/* Number of kernel centres in the leaves of a KDE k-d tree */
+#define KDE_TREE_LEAF_SIZE 16
+
+
+/*
+ * k-d tree over the points of a KDE after whitening by the Cholesky factor
+ * of the kernel covariance, so that each kernel is exp(-|y - y_i|^2 / 2).
+ * Nodes are stored in arrays, and the points are reordered so that each
+ * node covers the contiguous range [lo, hi).
+ */
+struct tagLALInferenceKDETree {
+    INT4 dim;
+    INT4 npts;
+    INT4 nnodes;
+    REAL8 rel_tol;      /* Relative error allowed in the kernel sum */
+    REAL8 max_energy;   /* Kernels with |y - y_i|^2/2 beyond this are ignored */
+    REAL8 *pts;         /* Whitened points, in tree order */
+    INT4 *lo;           /* First point of each node */
+    INT4 *hi;           /* One past the last point of each node */
+    INT4 *left;         /* Children of each node, -1 for leaves */
+    INT4 *right;
+    REAL8 *bbox_min;    /* Bounding box of each node */
+    REAL8 *bbox_max;
+};
+
 
 
 /**
@@ -200,6 +225,8 @@ void LALInferenceDestroyKDE(LALInferenceKDE *kde) {
         XLALFree(kde->lower_bounds);
         XLALFree(kde->upper_bounds);
 
+        LALInferenceKDEDestroyTree(kde);
+
         XLALFree(kde);
     }
 }
@@ -250,6 +277,9 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
     INT4 i, j;
     INT4 status;
 
+    /* Any tree was built for the old bandwidth */
+    LALInferenceKDEDestroyTree(kde);
+
     /* If data set is empty, set the normalization to infinity */
     if (kde->npts == 0) {
         kde->log_norm_factor = INFINITY;
@@ -288,11 +318,272 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
 }
 
 
+/* log(exp(a) + exp(b)), allowing for -INFINITY */
+static REAL8 kde_log_add(REAL8 a, REAL8 b) {
+    if (a < b) {
+        REAL8 tmp = a;
+        a = b;
+        b = tmp;
+    }
+    if (isinf(b))
+        return a;
+    return a + log1p(exp(b - a));
+}
+
+
+/* Partially sort the points in [lo, hi) along dimension p, so that the
+ * point at index mid has the median coordinate (quickselect) */
+static void kde_tree_select(REAL8 *pts, INT4 dim, INT4 lo, INT4 hi, INT4 mid, INT4 p) {
+    INT4 i, j, k;
+    REAL8 pivot, tmp;
+
+    hi--;
+    while (lo < hi) {
+        pivot = pts[((lo + hi)/2)*dim + p];
+        i = lo;
+        j = hi;
+        while (i <= j) {
+            while (pts[i*dim + p] < pivot) i++;
+            while (pts[j*dim + p] > pivot) j--;
+            if (i <= j) {
+                for (k = 0; k < dim; k++) {
+                    tmp = pts[i*dim + k];
+                    pts[i*dim + k] = pts[j*dim + k];
+                    pts[j*dim + k] = tmp;
+                }
+                i++;
+                j--;
+            }
+        }
+        if (mid <= j)
+            hi = j;
+        else if (mid >= i)
+            lo = i;
+        else
+            break;
+    }
+}
+
+
+/* Recursively build the node covering points [lo, hi), returning its index */
+static INT4 kde_tree_build_node(LALInferenceKDETree *tree, INT4 lo, INT4 hi) {
+    INT4 dim = tree->dim;
+    INT4 node = tree->nnodes++;
+    INT4 i, p, split = 0;
+    REAL8 *bmin = tree->bbox_min + node*dim;
+    REAL8 *bmax = tree->bbox_max + node*dim;
+    REAL8 width = -1.;
+
+    tree->lo[node] = lo;
+    tree->hi[node] = hi;
+    tree->left[node] = tree->right[node] = -1;
+
+    for (p = 0; p < dim; p++) {
+        bmin[p] = bmax[p] = tree->pts[lo*dim + p];
+        for (i = lo + 1; i < hi; i++) {
+            REAL8 val = tree->pts[i*dim + p];
+            if (val < bmin[p]) bmin[p] = val;
+            if (val > bmax[p]) bmax[p] = val;
+        }
+        if (bmax[p] - bmin[p] > width) {
+            width = bmax[p] - bmin[p];
+            split = p;
+        }
+    }
+
+    /* Split along the widest dimension at the median */
+    if (hi - lo > KDE_TREE_LEAF_SIZE && width > 0.) {
+        INT4 mid = lo + (hi - lo)/2;
+        kde_tree_select(tree->pts, dim, lo, hi, mid, split);
+        tree->left[node] = kde_tree_build_node(tree, lo, mid);
+        tree->right[node] = kde_tree_build_node(tree, mid, hi);
+    }
+
+    return node;
+}
+
+
+/* Smallest and largest kernel energies |y - y_i|^2/2 over a node */
+static void kde_tree_node_energies(const LALInferenceKDETree *tree, INT4 node,
+                                   const REAL8 *y, REAL8 *emin, REAL8 *emax) {
+    INT4 p;
+    INT4 dim = tree->dim;
+    const REAL8 *bmin = tree->bbox_min + node*dim;
+    const REAL8 *bmax = tree->bbox_max + node*dim;
+    REAL8 near, far;
+
+    *emin = 0.;
+    *emax = 0.;
+    for (p = 0; p < dim; p++) {
+        REAL8 dlo = y[p] - bmin[p];
+        REAL8 dhi = bmax[p] - y[p];
+
+        if (dlo < 0.)
+            near = -dlo;
+        else if (dhi < 0.)
+            near = -dhi;
+        else
+            near = 0.;
+        far = fabs(dlo) > fabs(dhi) ? fabs(dlo) : fabs(dhi);
+
+        *emin += near*near;
+        *emax += far*far;
+    }
+    *emin /= 2.;
+    *emax /= 2.;
+}
+
+
+/*
+ * Accumulate log(sum_i exp(-|y - y_i|^2/2)) over the points of a node into
+ * logsum.  A node is replaced by the midpoint of its kernel bounds when the
+ * resulting error is within its share (by number of points) of rel_tol times
+ * the sum accumulated so far, which is a lower bound on the total.  Nodes
+ * beyond the kernel cutoff are skipped.
+ */
+static void kde_tree_accumulate(const LALInferenceKDETree *tree, INT4 node,
+                                const REAL8 *y, REAL8 *logsum) {
+    INT4 i, p;
+    INT4 dim = tree->dim;
+    INT4 count = tree->hi[node] - tree->lo[node];
+    REAL8 emin, emax;
+
+    kde_tree_node_energies(tree, node, y, &emin, &emax);
+    if (emin > tree->max_energy)
+        return;
+
+    if (tree->rel_tol > 0.) {
+        REAL8 log_count = log((REAL8)count);
+        REAL8 log_err = -emin + log1p(-exp(emin - emax)) - LAL_LN2;
+        REAL8 log_allowed = log(tree->rel_tol) - log((REAL8)tree->npts) +
+                            kde_log_add(*logsum, log_count - emax);
+        if (emax == emin || log_err <= log_allowed) {
+            *logsum = kde_log_add(*logsum, log_count - emin +
+                                  log1p(exp(emin - emax)) - LAL_LN2);
+            return;
+        }
+    }
+
+    if (tree->left[node] < 0) {
+        for (i = tree->lo[node]; i < tree->hi[node]; i++) {
+            REAL8 energy = 0.;
+            for (p = 0; p < dim; p++) {
+                REAL8 d = tree->pts[i*dim + p] - y[p];
+                energy += d*d;
+            }
+            energy /= 2.;
+            if (energy <= tree->max_energy)
+                *logsum = kde_log_add(*logsum, -energy);
+        }
+        return;
+    }
+
+    /* Visit the nearer child first, so the lower bound grows quickly */
+    REAL8 lmin, lmax, rmin, rmax;
+    kde_tree_node_energies(tree, tree->left[node], y, &lmin, &lmax);
+    kde_tree_node_energies(tree, tree->right[node], y, &rmin, &rmax);
+    if (lmin <= rmin) {
+        kde_tree_accumulate(tree, tree->left[node], y, logsum);
+        kde_tree_accumulate(tree, tree->right[node], y, logsum);
+    } else {
+        kde_tree_accumulate(tree, tree->right[node], y, logsum);
+        kde_tree_accumulate(tree, tree->left[node], y, logsum);
+    }
+}
+
+
+/**
+ * Build a k-d tree for approximate evaluation of a KDE.
+ *
+ * Evaluating a KDE exactly sums over every kernel, which is costly for large
+ * data sets such as differential evolution buffers.  Once a tree is built,
+ * LALInferenceKDEEvaluatePoint() sums over groups of distant kernels at once,
+ * approximating each group's contribution from the range of kernel values
+ * across its bounding box.  The error in the kernel sum is at most
+ * \a rel_tol times its value.  Kernels whose centres lie more than \a cutoff
+ * kernel widths (Mahalanobis distance using the kernel covariance) from the
+ * point are ignored, which changes the estimated PDF by at most
+ * exp(-cutoff^2/2) times the peak kernel height.
+ *
+ * The tree is discarded if the bandwidth is recalculated.
+ * @param kde     The kernel density estimate to build the tree for.
+ * @param rel_tol Relative error allowed in evaluations (0 for exact sums).
+ * @param cutoff  Kernel cutoff in kernel widths (INFINITY for none).
+ * \sa LALInferenceKDEDestroyTree()
+ */
+void LALInferenceKDEBuildTree(LALInferenceKDE *kde, REAL8 rel_tol, REAL8 cutoff) {
+    INT4 i;
+    INT4 dim = kde->dim;
+    INT4 npts = kde->npts;
+
+    LALInferenceKDEDestroyTree(kde);
+
+    /* Nothing to accelerate if the KDE can't be evaluated */
+    if (npts == 0 || isinf(kde->log_norm_factor))
+        return;
+
+    if (rel_tol < 0. || !(cutoff > 0.))
+        XLAL_ERROR_VOID(XLAL_EINVAL, "Invalid KDE tree tolerance %g or cutoff %g", rel_tol, cutoff);
+
+    LALInferenceKDETree *tree = XLALCalloc(1, sizeof(LALInferenceKDETree));
+    tree->dim = dim;
+    tree->npts = npts;
+    tree->rel_tol = rel_tol;
+    tree->max_energy = isinf(cutoff) ? INFINITY : cutoff*cutoff/2.;
+
+    /* A binary tree with at most npts leaves has fewer than 2*npts nodes */
+    tree->pts = XLALMalloc(npts * dim * sizeof(REAL8));
+    tree->lo = XLALMalloc(2 * npts * sizeof(INT4));
+    tree->hi = XLALMalloc(2 * npts * sizeof(INT4));
+    tree->left = XLALMalloc(2 * npts * sizeof(INT4));
+    tree->right = XLALMalloc(2 * npts * sizeof(INT4));
+    tree->bbox_min = XLALMalloc(2 * npts * dim * sizeof(REAL8));
+    tree->bbox_max = XLALMalloc(2 * npts * dim * sizeof(REAL8));
+
+    /* Whiten the points with the Cholesky factor of the kernel covariance */
+    for (i = 0; i < npts; i++) {
+        gsl_vector_view y = gsl_vector_view_array(tree->pts + i*dim, dim);
+        gsl_vector_view d = gsl_matrix_row(kde->data, i);
+        gsl_vector_memcpy(&y.vector, &d.vector);
+        gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit,
+                        kde->cholesky_decomp_cov_lower, &y.vector);
+    }
+
+    kde_tree_build_node(tree, 0, npts);
+    kde->tree = tree;
+}
+
+
+/**
+ * Free the k-d tree of a KDE.
+ *
+ * Subsequent evaluations of the KDE sum over every kernel exactly.
+ * @param kde The kernel density estimate to free the tree of.
+ * \sa LALInferenceKDEBuildTree()
+ */
+void LALInferenceKDEDestroyTree(LALInferenceKDE *kde) {
+    LALInferenceKDETree *tree = kde->tree;
+    if (tree) {
+        XLALFree(tree->pts);
+        XLALFree(tree->lo);
+        XLALFree(tree->hi);
+        XLALFree(tree->left);
+        XLALFree(tree->right);
+        XLALFree(tree->bbox_min);
+        XLALFree(tree->bbox_max);
+        XLALFree(tree);
+        kde->tree = NULL;
+    }
+}
+
+
 /**
  * Evaluate the (log) PDF from a KDE at a single point.
  *
  * Calculate the (log) value of the probability density function estimate from
- * a kernel density estimate at a single point.
+ * a kernel density estimate at a single point.  If a tree has been built with
+ * LALInferenceKDEBuildTree() the sum over kernels is approximated to within
+ * its tolerance.
  * @param[in] kde   The kernel density estimate to evaluate.
  * @param[in] point An array containing the point to evaluate the PDF at.
  * @return The value of the estimated probability density function at \a point.
@@ -369,13 +660,23 @@ REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
     }
 
     /* Loop over list of reflected and cycled points */
-    REAL8* results = XLALMalloc(npts * sizeof(REAL8));
+    REAL8* results = kde->tree ? NULL : XLALMalloc(npts * sizeof(REAL8));
     REAL8* eval_results = XLALMalloc(n_evals * sizeof(REAL8));
 
     /* Loop over reflected and cycled set of points */
     for (i = 0; i < n_evals; i++) {
         gsl_vector_view pt = gsl_matrix_row(points, i);
 
+        /* Whiten the point and sum over the tree */
+        if (kde->tree) {
+            REAL8 logsum = -INFINITY;
+            gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit,
+                            kde->cholesky_decomp_cov_lower, &pt.vector);
+            kde_tree_accumulate(kde->tree, 0, pt.vector.data, &logsum);
+            eval_results[i] = logsum - kde->log_norm_factor;
+            continue;
+        }
+
         /* Loop over points in KDE dataset, using the Cholesky decomposition
          * of the covariance to avoid ever inverting the covariance matrix */
         #pragma omp parallel
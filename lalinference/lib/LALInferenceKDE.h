@@ -29,6 +29,12 @@
 
 struct tagkmeans;
 
+/**
+ * k-d tree over the whitened points of a KDE, used for approximate
+ * evaluation of the density.  See LALInferenceKDEBuildTree().
+ */
+typedef struct tagLALInferenceKDETree LALInferenceKDETree;
+
 /**
  * Structure containing the Guassian kernel density of a set of samples.
  */
@@ -51,6 +57,8 @@ tagKDE
     LALInferenceParamVaryType * upper_bound_types; /**< Array of param boundary types */
     REAL8 * lower_bounds;              /**< Lower param bounds */
     REAL8 * upper_bounds;              /**< Upper param bounds */
+
+    LALInferenceKDETree * tree;        /**< Optional k-d tree for approximate evaluation */
 } LALInferenceKDE;
 
 /* Allocate, fill, and tune a Gaussian kernel density estimate given an array of points. */
@@ -68,6 +76,12 @@ void LALInferenceDestroyKDE(LALInferenceKDE *kde);
 /* Calculate the bandwidth and normalization factor for a KDE. */
 void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde);
 
+/* Build a k-d tree for approximate evaluation of a KDE. */
+void LALInferenceKDEBuildTree(LALInferenceKDE *kde, REAL8 rel_tol, REAL8 cutoff);
+
+/* Free the k-d tree of a KDE, returning to exact evaluation. */
+void LALInferenceKDEDestroyTree(LALInferenceKDE *kde);
+
 /* Evaluate the (log) PDF from a KDE at a single point. */
 REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point);
 
@@ -23,6 +23,7 @@
 
 #include <complex.h>
 #include <assert.h>
+#include <string.h>
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferencePrior.h>
 #include <lal/LALInference.h>
@@ -357,7 +358,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   /* Burst templates are generated at hrss=1, thus need to rescale amplitude */
   double amp_prefactor=1.0;
 
-  COMPLEX16FrequencySeries *calFactor = NULL;
+  const COMPLEX16 *calFactor = NULL;
   COMPLEX16 calF = 0.0;
 
   REAL8Vector *logfreqs = NULL;
@@ -687,24 +688,30 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
           phases = NULL;
 	  /* get_calib_spline creates and fills the logfreqs, amps, phases arrays */
 	  get_calib_spline(currentParams, dataPtr->name, &logfreqs, &amps, &phases);
+	  UINT4 ncache = model->roq_flag ? 2 * (ifo + 1) : ifo + 1;
+	  if (model->spcal_cache_length < ncache) {
+	    model->spcal_cache = XLALRealloc(model->spcal_cache, ncache * sizeof(*model->spcal_cache));
+	    for (UINT4 k = model->spcal_cache_length; k < ncache; k++)
+	      model->spcal_cache[k] = LALInferenceCreateSplineCalibrationCache();
+	    model->spcal_cache_length = ncache;
+	  }
 	  if (model->roq_flag) {
-
-             LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases,
-						model->roq->frequencyNodesLinear,
-						&(model->roq->calFactorLinear),
-						model->roq->frequencyNodesQuadratic,
-						&(model->roq->calFactorQuadratic));
+	    const COMPLEX16 *calLin = LALInferenceSplineCalibrationFactorCachedNodes(model->spcal_cache[2*ifo],
+						logfreqs, amps, phases, model->roq->frequencyNodesLinear);
+	    const COMPLEX16 *calQuad = LALInferenceSplineCalibrationFactorCachedNodes(model->spcal_cache[2*ifo+1],
+						logfreqs, amps, phases, model->roq->frequencyNodesQuadratic);
+	    if (calLin == NULL || calQuad == NULL)
+	      XLAL_ERROR_REAL8(XLAL_EFUNC, "Failed to evaluate spline calibration at ROQ nodes");
+	    memcpy(model->roq->calFactorLinear->data, calLin, model->roq->calFactorLinear->length * sizeof(COMPLEX16));
+	    memcpy(model->roq->calFactorQuadratic->data, calQuad, model->roq->calFactorQuadratic->length * sizeof(COMPLEX16));
 	  }
 
 	  else{
-	    if (calFactor == NULL) {
-	      calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors",
-                       &(dataPtr->freqData->epoch),
-                       0, dataPtr->freqData->deltaF,
-                       &lalDimensionlessUnit,
-                       dataPtr->freqData->data->length);
-	    }
-          LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+	    calFactor = LALInferenceSplineCalibrationFactorCached(model->spcal_cache[ifo],
+						logfreqs, amps, phases,
+						dataPtr->freqData->deltaF, dataPtr->freqData->data->length);
+	    if (calFactor == NULL)
+	      XLAL_ERROR_REAL8(XLAL_EFUNC, "Failed to evaluate spline calibration");
 	}
 	if(logfreqs) XLALDestroyREAL8Vector(logfreqs);
 	if(amps) XLALDestroyREAL8Vector(amps);
@@ -948,7 +955,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       template = plainTemplate * (re + I*im);
 
       if (spcal_active) {
-          calF = calFactor->data->data[i];
+          calF = calFactor[i];
           template = template*calF;
       }
 
@@ -1079,7 +1086,6 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
             switch(errnum)
             {
               case XLAL_ERANGE: /* The SNR input was outside the interpolation range */
-		if(calFactor) {XLALDestroyCOMPLEX16FrequencySeries(calFactor); calFactor=NULL;}
                 return (-INFINITY);
                 break;
               default: /* Panic! */
@@ -1090,11 +1096,6 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
             }
           }
       }
-   /* Clean up calibration if necessary */
-    if (!(calFactor == NULL)) {
-      XLALDestroyCOMPLEX16FrequencySeries(calFactor);
-      calFactor = NULL;
-    }
   } /* end loop over detectors */
 
   }
@@ -1432,7 +1433,6 @@ double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_ma
                 log_norm = log_radial_integrator_eval(integrator, 0, 0, -INFINITY, -INFINITY);
             }
         }
-        #pragma omp barrier
         if (!integrator) XLAL_ERROR(XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
         
         if (isnan(OptimalSNR) || isnan(d_inner_h) || pmax<OptimalSNR)
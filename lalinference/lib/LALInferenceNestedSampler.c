@@ -43,6 +43,10 @@
 #define UNUSED
 #endif
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 static int __chainfile_iter;
 
 /**
@@ -287,6 +291,9 @@ static void install_resume_handler(int checkpoint_exit)
 static UINT4 UpdateNMCMC(LALInferenceRunState *runState);
 /* Prototypes for private "helper" functions. */
 
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *rng, REAL8 logLmin, UINT4 Nmcmc, REAL8 *sloppyfrac, REAL8 *accept_rate_out, REAL8 *sub_accept_rate_out);
+static UINT4 NestedSamplingParallelReplace(LALInferenceRunState *runState, NSintegralState *s, UINT4 Nparallel, UINT4 samplePrior, REAL8 *logLmin, REAL8 *logLmax, REAL8 *logLnew);
+
 static REAL8 LALInferenceNSSample_logt(int Nlive,gsl_rng *RNG);
 
 //static void SamplePriorDiscardAcceptance(LALInferenceRunState *runState);
@@ -435,9 +442,9 @@ static UINT4 UpdateNMCMC(LALInferenceRunState *runState){
         }
         LALInferenceSetVariable(runState->algorithmParams,"Nmcmc",&max);
     }
-    /* Single threaded here */
     if (LALInferenceGetProcParamVal(runState->commandLine,"--proposal-kde"))
-        LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[0]);
+        for(INT4 t=0;t<runState->nthreads;t++)
+            LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[t]);
     return(max);
 }
 
@@ -586,6 +593,8 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
     (--sloppyratio S)                Number of sub-samples of the prior for every sample from the\n\
                                      limited prior\n\
     (--Nruns R)                      Number of parallel samples from logt to use(1)\n\
+    (--Nparallel K)                  Replace the K lowest-likelihood live points at each iteration\n\
+                                     using K concurrent MCMC walkers (OpenMP threads) (1)\n\
     (--tolerance dZ)                 Tolerance of nested sampling algorithm (0.1)\n\
     (--randomseed seed)              Random seed of sampling distribution\n\
     (--prior )                       Set the prior to use (InspiralNormalised,SkyLoc,malmquist)\n\
@@ -640,15 +649,13 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
   INT4 tmpi=0;
   REAL8 tmp=0;
 
-  /* Single thread only */
-  LALInferenceThreadState *threadState = &runState->threads[0];
-
   /* Set up the appropriate functions for the nested sampling algorithm */
   runState->algorithm=&LALInferenceNestedSamplingAlgorithm;
   runState->evolve=&LALInferenceNestedSamplingOneStep;
 
-  /* use the ptmcmc proposal to sample prior */
-  threadState->proposal=&LALInferenceCyclicProposal;
+  /* use the ptmcmc proposal to sample prior, on every walker thread */
+  for(INT4 t=0;t<runState->nthreads;t++)
+    runState->threads[t].proposal=&LALInferenceCyclicProposal;
   REAL8 temp=1.0;
   LALInferenceAddVariable(runState->proposalArgs,"temperature",&temp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_FIXED);
 
@@ -697,6 +704,23 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
     LALInferenceAddVariable(runState->algorithmParams,"Nruns",&tmpi,LALINFERENCE_INT4_t,LALINFERENCE_PARAM_FIXED);
   }
 
+  /* Optionally replace several live points per iteration with concurrent walkers */
+  ppt=LALInferenceGetProcParamVal(commandLine,"--Nparallel");
+  if(!ppt) ppt=LALInferenceGetProcParamVal(commandLine,"--nparallel");
+  tmpi=1;
+  if(ppt) tmpi=atoi(ppt->value);
+  if(tmpi<1 || tmpi>runState->nthreads)
+  {
+    fprintf(stderr,"Error: --Nparallel %i requires between 1 and %i walker threads\n",tmpi,runState->nthreads);
+    exit(1);
+  }
+  if(2*tmpi > *(INT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive"))
+  {
+    fprintf(stderr,"Error: --Nparallel must be at most half the number of live points\n");
+    exit(1);
+  }
+  LALInferenceAddVariable(runState->algorithmParams,"Nparallel",&tmpi,LALINFERENCE_INT4_t,LALINFERENCE_PARAM_FIXED);
+
   printf("set tolerance.\n");
   /* Tolerance of the Nested sampling integrator */
   ppt=LALInferenceGetProcParamVal(commandLine,"--tolerance");
@@ -713,6 +737,104 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
 }
 
 
+/* Replace the Nparallel lowest-likelihood live points at once.
+ The removed points are passed to the integrator in increasing order of logL,
+ the j-th of them seeing Nlive-j remaining live points (as in the final
+ correction at the end of the run), so the prior volume shrinks by the
+ product of the Nparallel order statistics. Each replacement is then drawn
+ independently above the highest removed logL by its own walker, using the
+ model, proposal cycle and random number generator of runState->threads[t].
+ Returns the number of points replaced. */
+static UINT4 NestedSamplingParallelReplace(LALInferenceRunState *runState, NSintegralState *s, UINT4 Nparallel, UINT4 samplePrior, REAL8 *logLmin, REAL8 *logLmax, REAL8 *logLnew)
+{
+  UINT4 Nlive=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive");
+  UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
+  REAL8 *logLikelihoods=(REAL8 *)(*(REAL8Vector **)LALInferenceGetVariable(runState->algorithmParams,"logLikelihoods"))->data;
+  REAL8 sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+  UINT4 *minpos=XLALCalloc(Nparallel,sizeof(UINT4));
+  UINT4 *startpos=XLALCalloc(Nparallel,sizeof(UINT4));
+  UINT4 *iters=XLALCalloc(Nparallel,sizeof(UINT4));
+  REAL8 *sloppy=XLALCalloc(Nparallel,sizeof(REAL8));
+  REAL8 *accept=XLALCalloc(Nparallel,sizeof(REAL8));
+  REAL8 *sub_accept=XLALCalloc(Nparallel,sizeof(REAL8));
+  UINT4 *removed=XLALCalloc(Nlive,sizeof(UINT4));
+  UINT4 i,j,t;
+  INT4 k;
+
+  /* Find the Nparallel lowest points, in increasing order of logL */
+  for(j=0;j<Nparallel;j++)
+  {
+    UINT4 pos=Nlive;
+    for(i=0;i<Nlive;i++)
+      if(!removed[i] && (pos==Nlive || logLikelihoods[i]<logLikelihoods[pos])) pos=i;
+    removed[pos]=1;
+    minpos[j]=pos;
+  }
+
+  /* Remove them from the live set one at a time */
+  for(j=0;j<Nparallel;j++)
+  {
+    incrementEvidenceSamples(runState->GSLrandom, Nlive-j, logLikelihoods[minpos[j]], s);
+    if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos[j]]);
+  }
+  *logLmin=samplePrior ? -INFINITY : logLikelihoods[minpos[Nparallel-1]];
+  LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)logLmin);
+
+  /* Choose a surviving live point as the starting point of each walker */
+  for(t=0;t<Nparallel;t++)
+    while(removed[(startpos[t]=gsl_rng_uniform_int(runState->GSLrandom,Nlive))]){};
+
+  /* Evolve the walkers concurrently. Each thread only touches its own thread
+   * state; the live points are read-only until all walkers have finished. */
+  #pragma omp parallel for schedule(dynamic,1)
+  for(k=0;k<(INT4)Nparallel;k++)
+  {
+    LALInferenceThreadState *thread=&runState->threads[k];
+    UINT4 start=startpos[k];
+    do{
+      LALInferenceCopyVariables(runState->livePoints[start],thread->currentParams);
+      thread->currentLikelihood=logLikelihoods[start];
+      sloppy[k]=sloppyfraction;
+      NestedSamplingSloppySampleThread(runState,thread,thread->GSLrandom,*logLmin,Nmcmc,&sloppy[k],&accept[k],&sub_accept[k]);
+      iters[k]++;
+      while(removed[(start=gsl_rng_uniform_int(thread->GSLrandom,Nlive))]){};
+    }while(thread->currentLikelihood<=*logLmin || accept[k]==0.0);
+  }
+
+  /* Insert the new points, and combine the walker statistics */
+  REAL8 mean_accept=0.0,mean_sub_accept=0.0,mean_sloppy=0.0;
+  REAL8 logw=mean(s->logwarray->data,s->size);
+  for(t=0;t<Nparallel;t++)
+  {
+    LALInferenceThreadState *thread=&runState->threads[t];
+    LALInferenceCopyVariables(thread->currentParams,runState->livePoints[minpos[t]]);
+    logLikelihoods[minpos[t]]=thread->currentLikelihood;
+    LALInferenceAddVariable(runState->livePoints[minpos[t]],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    if(thread->currentLikelihood>*logLmax) *logLmax=thread->currentLikelihood;
+    mean_accept+=accept[t]/(REAL8)iters[t];
+    mean_sub_accept+=sub_accept[t];
+    mean_sloppy+=sloppy[t];
+  }
+  /* Report the point that replaced the lowest of the removed points */
+  *logLnew=logLikelihoods[minpos[0]];
+  mean_accept/=Nparallel;
+  mean_sub_accept/=Nparallel;
+  mean_sloppy/=Nparallel;
+  LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&mean_accept);
+  LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&mean_sub_accept);
+  if(isfinite(*logLmin))
+    LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&mean_sloppy);
+
+  XLALFree(minpos);
+  XLALFree(startpos);
+  XLALFree(iters);
+  XLALFree(sloppy);
+  XLALFree(accept);
+  XLALFree(sub_accept);
+  XLALFree(removed);
+  return(Nparallel);
+}
+
 /* NestedSamplingAlgorithm implements the nested sampling algorithm,
  see e.g. Sivia & Skilling "Data Analysis: A Bayesian Tutorial, 2nd edition.
  REQUIREMENTS:
@@ -731,9 +853,10 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   UINT4 HDFOUTPUT=1;
   UINT4 Nlive=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive");
   UINT4 Nruns=100;
+  UINT4 Nparallel=1,Nreplaced=1;
   REAL8 *logZarray,*Harray,*logwarray,*logtarray;
   REAL8 TOLERANCE=0.1;
-  REAL8 logZ,logZnew,logLmin,logLmax=-INFINITY,logLtmp,logw,H,logZnoise,dZ=0;
+  REAL8 logZ,logZnew,logLmin,logLmax=-INFINITY,logLnew=-INFINITY,logLtmp,logw,H,logZnoise,dZ=0;
   LALInferenceVariables *temp;
   FILE *fpout=NULL;
   REAL8 neginfty=-INFINITY;
@@ -777,6 +900,10 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   if(LALInferenceCheckVariable(runState->algorithmParams,"Nruns"))
     Nruns = *(UINT4 *) LALInferenceGetVariable(runState->algorithmParams,"Nruns");
 
+  /* Replace several points per iteration if requested */
+  if(LALInferenceCheckVariable(runState->algorithmParams,"Nparallel"))
+    Nparallel = *(UINT4 *) LALInferenceGetVariable(runState->algorithmParams,"Nparallel");
+
   /* Create workspace for arrays */
   NSintegralState *s=NULL;
 
@@ -834,9 +961,11 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   SetupEigenProposals(runState);
 
   /* Use the live points as differential evolution points */
-  /* Single thread here */
-  syncLivePointsDifferentialPoints(runState,threadState);
-  threadState->differentialPointsSkip=1;
+  for(i=0;i<(UINT4)runState->nthreads;i++)
+  {
+    syncLivePointsDifferentialPoints(runState,&runState->threads[i]);
+    runState->threads[i].differentialPointsSkip=1;
+  }
 
   if(!LALInferenceCheckVariable(runState->algorithmParams,"Nmcmc")){
     INT4 tmp=MAX_MCMC;
@@ -945,6 +1074,17 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   /* Iterate until termination condition is met */
   do {
+    UINT4 itercounter=0;
+    if(Nparallel>1)
+    {
+      /* Replace the Nparallel lowest points with concurrent walkers */
+      Nreplaced=NestedSamplingParallelReplace(runState, s, Nparallel, samplePrior, &logLmin, &logLmax, &logLnew);
+      logZ=mean(logZarray,Nruns);
+      H=mean(Harray,Nruns);
+      itercounter=1;
+    }
+    else
+    {
     /* Find minimum likelihood sample to replace */
     minpos=0;
     for(i=1;i<Nlive;i++){
@@ -959,7 +1099,6 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     H=mean(Harray,Nruns);
     logZ=logZnew;
     if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
-    UINT4 itercounter=0;
 
     /* Generate a new live point */
     do{ /* This loop is here in case it is necessary to find a different sample */
@@ -974,12 +1113,14 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 
     LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
     logLikelihoods[minpos]=threadState->currentLikelihood;
+    logLnew=threadState->currentLikelihood;
 
   if (threadState->currentLikelihood>logLmax)
     logLmax=threadState->currentLikelihood;
 
   logw=mean(logwarray,Nruns);
   LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    }
   dZ=logaddexp(logZ,logLmax-((double) iter)/((double)Nlive))-logZ;
   sloppyfrac=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
   if(displayprogress) fprintf(stderr,"%i: accpt: %1.3f Nmcmc: %i sub_accpt: %1.3f slpy: %2.1f%% H: %3.2lf nats logL:%.3lf ->%.3lf logZ: %.3lf deltalogLmax: %.2lf dZ: %.3lf Zratio: %.3lf \n",\
@@ -990,13 +1131,13 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     100.0*sloppyfrac,\
     H,\
     logLmin,\
-    threadState->currentLikelihood,\
+    logLnew,\
     logZ,\
     (logLmax - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise")), \
     dZ,\
     ( logZ - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise"))\
   );
-  iter++;
+  iter+=Nreplaced;
 
   /* Save progress */
   if(__ns_saveStateFlag!=0)
@@ -1012,7 +1153,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
 
   /* Update the proposal */
-  if(!(iter%(Nlive/10))) {
+  if(iter/(Nlive/10) != (iter-Nreplaced)/(Nlive/10)) {
     /* Update the covariance matrix */
     if ( LALInferenceCheckVariable( threadState->proposalArgs,"covarianceMatrix" ) ){
       SetupEigenProposals(runState);
@@ -1022,7 +1163,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     UpdateNMCMC(runState);
 
     /* Sync the live points to differential points */
-    syncLivePointsDifferentialPoints(runState,threadState);
+    for(i=0;i<(UINT4)runState->nthreads;i++)
+      syncLivePointsDifferentialPoints(runState,&runState->threads[i]);
 
     /* Output some information */
     if(verbose){
@@ -1150,6 +1292,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   
   /* Free memory */
   XLALFree(logtarray); XLALFree(logwarray); XLALFree(logZarray);
+  for(i=0;i<(UINT4)runState->nthreads;i++)
+    LALInferenceDestroyModelSplineCalibrationCaches(runState->threads[i].model);
 }
 
 /* Calculate the autocorrelation function of the sampler (runState->evolve) for each parameter
@@ -1334,11 +1478,11 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
   return(acls);
 }
 
-/* Perform one MCMC iteration on runState->currentParams. Return 1 if accepted or 0 if not */
-UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
+/* Perform one MCMC iteration on threadState->currentParams using the random
+ * number generator rng. Return 1 if accepted or 0 if not */
+static UINT4 MCMCSamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *rng, REAL8 logLmin);
+static UINT4 MCMCSamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *rng, REAL8 logLmin)
 {
-    /* Single threaded here */
-    LALInferenceThreadState * threadState=&runState->threads[0];
     UINT4 outOfBounds=0;
     UINT4 adaptProp=0;
     //LALInferenceVariables tempParams;
@@ -1346,7 +1490,6 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     //LALInferenceVariables *oldParams=&tempParams;
     LALInferenceVariables proposedParams;
     memset(&proposedParams,0,sizeof(proposedParams));
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
     REAL8 thislogL=-INFINITY;
     UINT4 accepted=0;
 
@@ -1360,7 +1503,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 
     logProposalRatio = threadState->proposal(threadState,threadState->currentParams,&proposedParams);
     REAL8 logPriorNew=runState->prior(runState, &proposedParams, threadState->model);
-    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(runState->GSLrandom)) > (logPriorNew-logPriorOld) + logProposalRatio)
+    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(rng)) > (logPriorNew-logPriorOld) + logProposalRatio)
     {
 	/* Reject - don't need to copy new params back to currentParams */
         /*LALInferenceCopyVariables(oldParams,runState->currentParams); */
@@ -1387,6 +1530,15 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     return(accepted);
 }
 
+/* Perform one MCMC iteration on runState->currentParams. Return 1 if accepted or 0 if not */
+UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
+{
+    /* Single threaded here */
+    LALInferenceThreadState * threadState=&runState->threads[0];
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
+    return(MCMCSamplePriorThread(runState,threadState,runState->GSLrandom,logLmin));
+}
+
 /* Sample the prior N times, returns number of acceptances */
 UINT4 LALInferenceMCMCSamplePriorNTimes(LALInferenceRunState *runState, UINT4 N)
 {
@@ -1482,11 +1634,10 @@ INT4 LALInferenceNestedSamplingCachedSampler(LALInferenceRunState *runState)
    x=LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction")
    */
 
-INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *rng, REAL8 logLmin, UINT4 Nmcmc, REAL8 *sloppyfrac, REAL8 *accept_rate_out, REAL8 *sub_accept_rate_out);
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *rng, REAL8 logLmin, UINT4 Nmcmc, REAL8 *sloppyfrac, REAL8 *accept_rate_out, REAL8 *sub_accept_rate_out)
 {
     LALInferenceVariables oldParams;
-    /* Single thread here */
-    LALInferenceThreadState *threadState = &runState->threads[0];
     LALInferenceIFOData *data=runState->data;
     REAL8 tmp;
     REAL8 Target=0.3;
@@ -1494,14 +1645,12 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     REAL8 logLold=*(REAL8 *)LALInferenceGetVariable(threadState->currentParams,"logL");
     memset(&oldParams,0,sizeof(oldParams));
     LALInferenceCopyVariables(threadState->currentParams,&oldParams);
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
-    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
     REAL8 maxsloppyfraction=((REAL8)Nmcmc-1)/(REAL8)Nmcmc ;
     REAL8 sloppyfraction=maxsloppyfraction/2.0;
     REAL8 minsloppyfraction=0.;
     if(Nmcmc==1) maxsloppyfraction=minsloppyfraction=0.0;
-    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
-      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+    if (sloppyfrac)
+      sloppyfraction=*sloppyfrac;
     UINT4 mcmc_iter=0,Naccepted=0,sub_accepted=0;
     UINT4 sloppynumber=(UINT4) (sloppyfraction*(REAL8)Nmcmc);
     UINT4 testnumber=Nmcmc-sloppynumber;
@@ -1527,7 +1676,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         /* Draw an independent sample from the prior */
         do{
 
-            sub_accepted+=LALInferenceMCMCSamplePrior(runState);
+            sub_accepted+=MCMCSamplePriorThread(runState,threadState,rng,logLmin);
             subchain_length++;
             counter+=(1.-sloppyfraction);
         }while(counter<1);
@@ -1599,8 +1748,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     /* Compute some statistics for information */
     REAL8 sub_accept_rate=(REAL8)sub_accepted/(REAL8)sub_iter;
     REAL8 accept_rate=(REAL8)Naccepted/(REAL8)testnumber;
-    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
-    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    if(accept_rate_out) *accept_rate_out=accept_rate;
+    if(sub_accept_rate_out) *sub_accept_rate_out=sub_accept_rate;
     /* Adapt the sloppy fraction toward target acceptance of outer chain */
     if(isfinite(logLmin)){
         if((REAL8)accept_rate>Target) { sloppyfraction+=5.0/(REAL8)Nmcmc;}
@@ -1608,7 +1757,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         if(sloppyfraction>maxsloppyfraction) sloppyfraction=maxsloppyfraction;
 	if(sloppyfraction<minsloppyfraction) sloppyfraction=minsloppyfraction;
 
-	LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+	if(sloppyfrac) *sloppyfrac=sloppyfraction;
     }
     /* Cleanup */
     LALInferenceClearVariables(&oldParams);
@@ -1616,6 +1765,28 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     return Naccepted;
 }
 
+INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
+{
+    /* Single thread here */
+    LALInferenceThreadState *threadState = &runState->threads[0];
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
+    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
+    REAL8 accept_rate=0.0,sub_accept_rate=0.0;
+    REAL8 sloppyfraction=0.0;
+    REAL8 *sloppyfrac=NULL;
+    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
+    {
+      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+      sloppyfrac=&sloppyfraction;
+    }
+    INT4 Naccepted=NestedSamplingSloppySampleThread(runState,threadState,runState->GSLrandom,logLmin,Nmcmc,sloppyfrac,&accept_rate,&sub_accept_rate);
+    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
+    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    if(sloppyfrac && isfinite(logLmin))
+      LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+    return Naccepted;
+}
+
 
 /* Evolve nested sampling algorithm by one step, i.e.
  evolve runState->currentParams to a new point with higher
@@ -1678,16 +1849,11 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 
 static void SetupEigenProposals(LALInferenceRunState *runState)
 {
-  /* Single thread here */
-  LALInferenceThreadState *threadState = &runState->threads[0];
   gsl_matrix *eVectors=NULL;
   gsl_vector *eValues =NULL;
   REAL8Vector *eigenValues=NULL;
   /* Check for existing covariance matrix */
   gsl_matrix **cvm=NULL;
-  if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceMatrix"))
-    LALInferenceRemoveVariable(threadState->proposalArgs,"covarianceMatrix");
-//    cvm=(gsl_matrix **)LALInferenceGetVariable(threadState->proposalArgs,"covarianceMatrix");
   cvm=XLALCalloc(1,sizeof(gsl_matrix *));
 
   /* Add the covariance matrix for proposal distribution */
@@ -1697,41 +1863,57 @@ static void SetupEigenProposals(LALInferenceRunState *runState)
   LALInferenceNScalcCVM(cvm,runState->livePoints,*Nlive);
   UINT4 N=(*cvm)->size1;
 
-
-  /* Check for the eigenvectors and values */
-  if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvectors"))
-    eVectors=*(gsl_matrix **)LALInferenceGetVariable(threadState->proposalArgs,"covarianceEigenvectors");
-  else
-    eVectors=gsl_matrix_alloc(N,N);
-
-  if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvalues"))
-    eigenValues=*(REAL8Vector **)LALInferenceGetVariable(threadState->proposalArgs,"covarianceEigenvalues");
-  else
-    eigenValues=XLALCreateREAL8Vector(N);
-
   /* Set up eigenvectors and eigenvalues. */
   gsl_matrix *covCopy = gsl_matrix_alloc(N,N);
+  gsl_matrix *eVectorsTmp = gsl_matrix_alloc(N,N);
   eValues = gsl_vector_alloc(N);
   gsl_eigen_symmv_workspace *ws = gsl_eigen_symmv_alloc(N);
   int gsl_status;
   gsl_matrix_memcpy(covCopy, *cvm);
 
-  if ((gsl_status = gsl_eigen_symmv(covCopy, eValues, eVectors, ws)) != GSL_SUCCESS) {
+  if ((gsl_status = gsl_eigen_symmv(covCopy, eValues, eVectorsTmp, ws)) != GSL_SUCCESS) {
     XLALPrintError("Error in gsl_eigen_symmv (in %s, line %d): %d: %s\n", __FILE__, __LINE__, gsl_status, gsl_strerror(gsl_status));
     XLAL_ERROR_VOID(XLAL_EFAILED);
   }
 
-  for (UINT4 i = 0; i < N; i++) {
-    eigenValues->data[i] = gsl_vector_get(eValues,i);
-  }
+  /* Every walker thread gets its own copy of the proposal matrices */
+  for(INT4 t=0;t<runState->nthreads;t++)
+  {
+    LALInferenceThreadState *threadState = &runState->threads[t];
+    if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceMatrix"))
+      LALInferenceRemoveVariable(threadState->proposalArgs,"covarianceMatrix");
+
+    /* Check for the eigenvectors and values */
+    if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvectors"))
+      eVectors=*(gsl_matrix **)LALInferenceGetVariable(threadState->proposalArgs,"covarianceEigenvectors");
+    else
+      eVectors=gsl_matrix_alloc(N,N);
+
+    if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvalues"))
+      eigenValues=*(REAL8Vector **)LALInferenceGetVariable(threadState->proposalArgs,"covarianceEigenvalues");
+    else
+      eigenValues=XLALCreateREAL8Vector(N);
 
-  if(!LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvectors"))
-    LALInferenceAddVariable(threadState->proposalArgs, "covarianceEigenvectors", &eVectors, LALINFERENCE_gslMatrix_t, LALINFERENCE_PARAM_FIXED);
-  if(!LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvalues"))
-    LALInferenceAddVariable(threadState->proposalArgs, "covarianceEigenvalues", &eigenValues, LALINFERENCE_REAL8Vector_t, LALINFERENCE_PARAM_FIXED);
-  LALInferenceAddVariable(threadState->proposalArgs,"covarianceMatrix",cvm,LALINFERENCE_gslMatrix_t,LALINFERENCE_PARAM_OUTPUT);
+    gsl_matrix_memcpy(eVectors, eVectorsTmp);
+    for (UINT4 i = 0; i < N; i++) {
+      eigenValues->data[i] = gsl_vector_get(eValues,i);
+    }
+
+    if(!LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvectors"))
+      LALInferenceAddVariable(threadState->proposalArgs, "covarianceEigenvectors", &eVectors, LALINFERENCE_gslMatrix_t, LALINFERENCE_PARAM_FIXED);
+    if(!LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvalues"))
+      LALInferenceAddVariable(threadState->proposalArgs, "covarianceEigenvalues", &eigenValues, LALINFERENCE_REAL8Vector_t, LALINFERENCE_PARAM_FIXED);
+    gsl_matrix *cvmThread=*cvm;
+    if(t>0)
+    {
+      cvmThread=gsl_matrix_alloc(N,N);
+      gsl_matrix_memcpy(cvmThread,*cvm);
+    }
+    LALInferenceAddVariable(threadState->proposalArgs,"covarianceMatrix",&cvmThread,LALINFERENCE_gslMatrix_t,LALINFERENCE_PARAM_OUTPUT);
+  }
 
   gsl_matrix_free(covCopy);
+  gsl_matrix_free(eVectorsTmp);
   gsl_vector_free(eValues);
   gsl_eigen_symmv_free(ws);
   XLALFree(cvm);
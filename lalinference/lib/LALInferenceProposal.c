@@ -401,6 +401,23 @@ LALInferenceVariables *LALInferenceParseProposalArgs(LALInferenceRunState *runSt
         cyclic_reflective_kde = 1;
     LALInferenceAddINT4Variable(propArgs, "cyclic_reflective_kde", cyclic_reflective_kde, LALINFERENCE_PARAM_FIXED);
 
+    /* Error bound and kernel cutoff (in kernel widths) for tree-accelerated
+     * KDE evaluations.  The approximate density is not the one jumps are
+     * drawn from, so the Hastings ratio is only approximately correct and
+     * the tree is used only if asked for; a negative tolerance (the default)
+     * evaluates KDEs exactly */
+    REAL8 kde_tree_tol = -1.;
+    ppt = LALInferenceGetProcParamVal(command_line, "--kde-tree-tol");
+    if (ppt)
+        kde_tree_tol = atof(ppt->value);
+    LALInferenceAddREAL8Variable(propArgs, "kde_tree_tol", kde_tree_tol, LALINFERENCE_PARAM_FIXED);
+
+    REAL8 kde_tree_cutoff = INFINITY;
+    ppt = LALInferenceGetProcParamVal(command_line, "--kde-tree-cutoff");
+    if (ppt)
+        kde_tree_cutoff = atof(ppt->value);
+    LALInferenceAddREAL8Variable(propArgs, "kde_tree_cutoff", kde_tree_cutoff, LALINFERENCE_PARAM_FIXED);
+
     if (LALInferenceGetProcParamVal(command_line, "--noiseonly"))
         noise_only = 1;
     LALInferenceAddINT4Variable(propArgs, "noiseonly", noise_only, LALINFERENCE_PARAM_FIXED);
@@ -3140,6 +3157,14 @@ void LALInferenceInitClusteredKDEProposal(LALInferenceThreadState *thread,
     /* Selectivey impose bounds on KDEs */
     LALInferenceKmeansImposeBounds(kde->kmeans, params, thread->priorArgs, cyclic_reflective);
 
+    /* Approximate PDF evaluations with k-d trees, unless disabled (negative tolerance) */
+    if (LALInferenceCheckVariable(thread->proposalArgs, "kde_tree_tol")) {
+        REAL8 tree_tol = LALInferenceGetREAL8Variable(thread->proposalArgs, "kde_tree_tol");
+        REAL8 tree_cutoff = LALInferenceGetREAL8Variable(thread->proposalArgs, "kde_tree_cutoff");
+        if (tree_tol >= 0.)
+            LALInferenceKmeansBuildKDETrees(kde->kmeans, tree_tol, tree_cutoff);
+    }
+
     /* Print out clustered samples, assignments, and PDF values if requested */
     if (LALInferenceGetINT4Variable(thread->proposalArgs, "verbose")) {
         printf("Thread %i found %i clusters.\n", thread->id, kde->kmeans->k);
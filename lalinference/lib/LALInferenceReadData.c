@@ -2339,6 +2339,7 @@ LALInferenceVariables *LALInferencePrintInjectionSample(LALInferenceRunState *ru
         }
     }
     LALInferenceAddVariable(injparams, "logL", (void *)&injL,LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceDestroyModelSplineCalibrationCaches(model);
 	REAL8 logZnoise=LALInferenceNullLogLikelihood(runState->data);
     REAL8 tmp2=injL-logZnoise;
     LALInferenceAddVariable(injparams,"deltalogL",(void *)&tmp2,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
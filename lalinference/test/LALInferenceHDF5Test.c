@@ -113,6 +113,86 @@ int main(int argc, char **argv)
   /* Close file. */
   XLALH5FileClose(file);
 
+  /* Stream samples through a writer whose buffer is smaller than the
+   * number of samples, so that rows reach the file in several appends. */
+  LALInferenceVariables sample = {0};
+  LALInferenceAddREAL8Variable(&sample, "abc", 0, LALINFERENCE_PARAM_LINEAR);
+  LALInferenceAddINT4Variable (&sample, "lmn", 0, LALINFERENCE_PARAM_LINEAR);
+  LALInferenceAddREAL8Variable(&sample, "ghi", 5, LALINFERENCE_PARAM_FIXED);
+
+  file = XLALH5FileOpen("test.hdf5", "w");
+  group = LALInferenceH5CreateGroupStructure(
+    file, "lalinference", "lalinference_mcmc");
+  LALInferenceH5SampleWriter *writer = LALInferenceH5SampleWriterOpen(
+    group, &sample, "stream", 4, 1);
+  for (UINT4 i = 0; i < 10; i ++)
+  {
+    LALInferenceSetREAL8Variable(&sample, "abc", i);
+    LALInferenceSetINT4Variable (&sample, "lmn", i);
+    LALInferenceH5SampleWriterAppend(writer, &sample);
+  }
+  gsl_test_int(LALInferenceH5SampleWriterLength(writer), 10,
+    "number of rows streamed");
+  gsl_test_int(XLALH5TableQueryNRows(LALInferenceH5SampleWriterDataset(writer)),
+    8, "number of rows written before flushing");
+  gsl_test_int(LALInferenceH5SampleWriterFlush(writer), XLAL_SUCCESS,
+    "flush sample writer");
+  gsl_test_int(XLALH5FileFlush(file), XLAL_SUCCESS, "flush file");
+  gsl_test_int(XLALH5TableQueryNRows(LALInferenceH5SampleWriterDataset(writer)),
+    10, "number of rows written after flushing");
+  LALInferenceH5SampleWriterClose(writer);
+  XLALH5FileClose(group);
+  XLALH5FileClose(file);
+
+  /* Reopen for appending, as when resuming from a checkpoint: drop rows
+   * written after the checkpoint, then continue the table. */
+  file = XLALH5FileOpen("test.hdf5", "a");
+  group = XLALH5GroupOpen(file, "lalinference/lalinference_mcmc");
+  writer = LALInferenceH5SampleWriterOpen(group, &sample, "stream", 4, 1);
+  gsl_test_int(LALInferenceH5SampleWriterLength(writer), 10,
+    "number of rows on reopening");
+  LALInferenceH5SampleWriterTruncate(writer, 6);
+  gsl_test_int(LALInferenceH5SampleWriterLength(writer), 6,
+    "number of rows after truncating the table");
+  for (UINT4 i = 6; i < 9; i ++)
+  {
+    LALInferenceSetREAL8Variable(&sample, "abc", i);
+    LALInferenceSetINT4Variable (&sample, "lmn", i);
+    LALInferenceH5SampleWriterAppend(writer, &sample);
+  }
+  LALInferenceH5SampleWriterTruncate(writer, 8);
+  gsl_test_int(LALInferenceH5SampleWriterLength(writer), 8,
+    "number of rows after truncating the buffer");
+  LALInferenceH5SampleWriterClose(writer);
+  XLALH5FileClose(group);
+  XLALH5FileClose(file);
+  LALInferenceClearVariables(&sample);
+
+  /* Read the streamed table back. */
+  file = XLALH5FileOpen("test.hdf5", "r");
+  dataset = XLALH5DatasetRead(file, "lalinference/lalinference_mcmc/stream");
+  N = 0;
+  vars_array = NULL;
+  LALInferenceH5DatasetToVariablesArray(dataset, &vars_array, &N);
+  gsl_test_int(N, 8, "number of streamed rows read back");
+  for (UINT4 i = 0; i < N; i ++)
+  {
+    LALInferenceVariables *vars = vars_array[i];
+    gsl_test_abs(LALInferenceGetREAL8Variable(vars, "abc"), i, 0,
+      "value of streamed column abc");
+    gsl_test_int(LALInferenceGetINT4Variable (vars, "lmn"), i,
+      "value of streamed column lmn");
+    gsl_test_abs(LALInferenceGetREAL8Variable(vars, "ghi"), 5, 0,
+      "value of streamed column ghi");
+    gsl_test_int(LALInferenceGetVariableVaryType(vars, "ghi"),
+      LALINFERENCE_PARAM_FIXED, "vary type of streamed column ghi");
+    LALInferenceClearVariables(vars);
+    XLALFree(vars);
+  }
+  XLALFree(vars_array);
+  XLALH5DatasetFree(dataset);
+  XLALH5FileClose(file);
+
   /* Check for memory leaks. */
   LALCheckMemoryLeaks();
 
@@ -21,6 +21,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
 #include <lal/LALInference.h>
 #include <lal/Units.h>
 #include <lal/FrequencySeries.h>
@@ -37,6 +40,9 @@
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferenceTemplate.h>
 #include <lal/LALInferencePrior.h>
+#include <lal/LALInferenceClusteredKDE.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
 
 #include "LALInferenceTest.h"
 
@@ -59,6 +65,12 @@ int LALInferenceProcessParamLine_TEST_CHARFILE(void);
 /*  LALInferenceExecuteFT tests */
 int LALInferenceExecuteFTTEST_NULLPLAN(void);
 
+/*  LALInferenceKmeansPDF tests */
+int LALInferenceKmeansPDFTEST_TREE(void);
+
+/*  LALInferenceSplineCalibrationFactorCached tests */
+int LALInferenceSplineCalibrationFactorCachedTEST(void);
+
 int main(void){
     
 	int failureCount = 0;
@@ -77,6 +89,10 @@ int main(void){
 	printf("\n");
 	failureCount += LALInferenceExecuteFTTEST_NULLPLAN();
 	printf("\n");
+	failureCount += LALInferenceKmeansPDFTEST_TREE();
+	printf("\n");
+	failureCount += LALInferenceSplineCalibrationFactorCachedTEST();
+	printf("\n");
 	printf("Test results: %i failure(s).\n", failureCount);
 
 	return failureCount;
@@ -357,6 +373,172 @@ int LALInferenceExecuteFTTEST_NULLPLAN(void){
 }
 
 
+/*****************     TEST CODE for LALInferenceKmeansPDF     *****************/
+/* Test that the clustered-KDE PDF evaluated with k-d trees agrees with the
+ * exact evaluation to within the tree tolerance. */
+
+int LALInferenceKmeansPDFTEST_TREE(void){
+
+    TEST_HEADER();
+
+    const INT4 npts = 2000, dim = 3, ntest = 300;
+    const REAL8 tols[] = {1e-2, 1e-3, 0.};
+    INT4 i, j, t;
+
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, 20111);
+
+    /* Two separated, correlated clusters */
+    gsl_matrix *samples = gsl_matrix_alloc(npts, dim);
+    for (i = 0; i < npts; i++) {
+        REAL8 x0 = gsl_ran_gaussian(rng, 1.) + (i % 2 ? 5. : -5.);
+        gsl_matrix_set(samples, i, 0, x0);
+        gsl_matrix_set(samples, i, 1, 0.5*x0 + gsl_ran_gaussian(rng, 0.3));
+        gsl_matrix_set(samples, i, 2, gsl_ran_gaussian(rng, 2.));
+    }
+
+    LALInferenceKmeans *kmeans = LALInferenceOptimizedKmeans(samples, 5, rng);
+    if (kmeans == NULL) {
+        TEST_FAIL("Could not cluster the samples.");
+    } else {
+        /* Points drawn from the KDE, and points in its tails */
+        REAL8 *pts = XLALCalloc(ntest * dim, sizeof(REAL8));
+        REAL8 *exact = XLALCalloc(ntest, sizeof(REAL8));
+        for (j = 0; j < ntest; j++) {
+            if (j % 3) {
+                REAL8 *draw = LALInferenceKmeansDraw(kmeans);
+                memcpy(pts + j*dim, draw, dim * sizeof(REAL8));
+                XLALFree(draw);
+            } else {
+                for (i = 0; i < dim; i++)
+                    pts[j*dim + i] = gsl_ran_flat(rng, -15., 15.);
+            }
+            exact[j] = LALInferenceKmeansPDF(kmeans, pts + j*dim);
+        }
+
+        for (t = 0; t < (INT4)(sizeof(tols)/sizeof(*tols)); t++) {
+            LALInferenceKmeansBuildKDETrees(kmeans, tols[t], INFINITY);
+            for (j = 0; j < ntest; j++) {
+                REAL8 approx = LALInferenceKmeansPDF(kmeans, pts + j*dim);
+                if (!(fabs(approx - exact[j]) <= -log1p(-tols[t]) + 1e-12))
+                    TEST_FAIL("Tree PDF %g differs from exact PDF %g by more than the tolerance %g at point %d.", approx, exact[j], tols[t], j);
+            }
+        }
+
+        XLALFree(exact);
+        XLALFree(pts);
+        LALInferenceKmeansDestroy(kmeans);
+    }
+
+    gsl_matrix_free(samples);
+    gsl_rng_free(rng);
+
+    TEST_FOOTER();
+
+}
+
+
+/*****************     TEST CODE for LALInferenceSplineCalibrationFactorCached     *****************/
+/* Test that the cached spline calibration agrees with
+ * LALInferenceSplineCalibrationFactor() on a frequency grid and with
+ * LALInferenceSplineCalibrationFactorROQ() at ROQ nodes, also after the
+ * node values, the node frequencies and the grid change. */
+
+int LALInferenceSplineCalibrationFactorCachedTEST(void){
+
+    TEST_HEADER();
+
+    const UINT4 nnodes = 10, nlin = 400, nquad = 150;
+    const REAL8 tol = 1e-12;
+    LIGOTimeGPS epoch = {0, 0};
+    UINT4 i, trial;
+
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, 4253);
+
+    REAL8Vector *logfreqs = XLALCreateREAL8Vector(nnodes);
+    REAL8Vector *amps = XLALCreateREAL8Vector(nnodes);
+    REAL8Vector *phases = XLALCreateREAL8Vector(nnodes);
+    REAL8Sequence *nodesLin = XLALCreateREAL8Sequence(nlin);
+    REAL8Sequence *nodesQuad = XLALCreateREAL8Sequence(nquad);
+    COMPLEX16Sequence *calLin = XLALCreateCOMPLEX16Sequence(nlin);
+    COMPLEX16Sequence *calQuad = XLALCreateCOMPLEX16Sequence(nquad);
+    LALInferenceSplineCalibrationCache *cache = LALInferenceCreateSplineCalibrationCache();
+    LALInferenceSplineCalibrationCache *cacheLin = LALInferenceCreateSplineCalibrationCache();
+    LALInferenceSplineCalibrationCache *cacheQuad = LALInferenceCreateSplineCalibrationCache();
+
+    /* ROQ nodes, some of them outside the spline */
+    for (i = 0; i < nlin; i++)
+        nodesLin->data[i] = 10. + 1990. * i / (nlin - 1);
+    for (i = 0; i < nquad; i++)
+        nodesQuad->data[i] = 10. + 1990. * i / (nquad - 1);
+
+    /* 0: first evaluation; 1: new node values; 2: same node values again;
+     * 3: new node frequencies; 4: new grid */
+    for (trial = 0; trial < 5; trial++) {
+        REAL8 deltaF = trial < 4 ? 0.25 : 0.125;
+        UINT4 length = trial < 4 ? 8193 : 12289;
+        REAL8 flow = trial < 3 ? 20. : 30.;
+        REAL8 fhigh = trial < 3 ? 1024. : 1500.;
+
+        for (i = 0; i < nnodes; i++) {
+            logfreqs->data[i] = log(flow) + (log(fhigh) - log(flow)) * i / (nnodes - 1);
+            if (trial != 2) {
+                amps->data[i] = gsl_ran_gaussian(rng, 0.1);
+                phases->data[i] = gsl_ran_gaussian(rng, 0.1);
+            }
+        }
+
+        COMPLEX16FrequencySeries *calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors", &epoch, 0, deltaF, &lalDimensionlessUnit, length);
+        LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+        const COMPLEX16 *cached = LALInferenceSplineCalibrationFactorCached(cache, logfreqs, amps, phases, deltaF, length);
+        if (cached == NULL) {
+            TEST_FAIL("Cached spline calibration failed in trial %u.", trial);
+        } else {
+            for (i = 0; i < length; i++)
+                if (!(cabs(cached[i] - calFactor->data->data[i]) <= tol)) {
+                    TEST_FAIL("Cached spline calibration differs at f = %g Hz in trial %u.", i * deltaF, trial);
+                    break;
+                }
+        }
+        XLALDestroyCOMPLEX16FrequencySeries(calFactor);
+
+        LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases, nodesLin, &calLin, nodesQuad, &calQuad);
+        const COMPLEX16 *cachedLin = LALInferenceSplineCalibrationFactorCachedNodes(cacheLin, logfreqs, amps, phases, nodesLin);
+        const COMPLEX16 *cachedQuad = LALInferenceSplineCalibrationFactorCachedNodes(cacheQuad, logfreqs, amps, phases, nodesQuad);
+        if (cachedLin == NULL || cachedQuad == NULL) {
+            TEST_FAIL("Cached spline calibration at ROQ nodes failed in trial %u.", trial);
+        } else {
+            for (i = 0; i < nlin; i++)
+                if (!(cabs(cachedLin[i] - calLin->data[i]) <= tol)) {
+                    TEST_FAIL("Cached spline calibration differs at linear ROQ node %g Hz in trial %u.", nodesLin->data[i], trial);
+                    break;
+                }
+            for (i = 0; i < nquad; i++)
+                if (!(cabs(cachedQuad[i] - calQuad->data[i]) <= tol)) {
+                    TEST_FAIL("Cached spline calibration differs at quadratic ROQ node %g Hz in trial %u.", nodesQuad->data[i], trial);
+                    break;
+                }
+        }
+    }
+
+    LALInferenceDestroySplineCalibrationCache(cacheQuad);
+    LALInferenceDestroySplineCalibrationCache(cacheLin);
+    LALInferenceDestroySplineCalibrationCache(cache);
+    XLALDestroyCOMPLEX16Sequence(calQuad);
+    XLALDestroyCOMPLEX16Sequence(calLin);
+    XLALDestroyREAL8Sequence(nodesQuad);
+    XLALDestroyREAL8Sequence(nodesLin);
+    XLALDestroyREAL8Vector(phases);
+    XLALDestroyREAL8Vector(amps);
+    XLALDestroyREAL8Vector(logfreqs);
+    gsl_rng_free(rng);
+
+    TEST_FOOTER();
+
+}
+
+
 /******************************************
  * 
  * Old tests
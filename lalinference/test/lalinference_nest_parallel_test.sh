@@ -0,0 +1,23 @@
+#!/usr/bin/env bash
+
+# Run the nested sampler with several concurrent walkers on the analytic
+# correlated Gaussian likelihood and check the evidence, Z=-21.3
+
+set -e
+
+nest="${LALINFERENCE_NEST:-../bin/lalinference_nest}"
+export OMP_NUM_THREADS=2
+
+rm -f nest_parallel.dat nest_parallel.dat_B.txt
+
+"${nest}" --correlatedGaussianLikelihood \
+    --ifo H1 --H1-cache LALSimAdLIGO --H1-channel LALSimAdLIGO \
+    --dataseed 1234 --randomseed 5678 \
+    --psdstart 1 --psdlength 256 --seglen 8 --srate 1024 --trigtime 20 \
+    --Nlive 128 --Nmcmc 100 --Nparallel 2 \
+    --outfile nest_parallel.dat
+
+test -s nest_parallel.dat_B.txt
+awk '{ d = $2 + 21.3; if (d < 0) d = -d;
+       printf "logZ = %g (expected -21.3)\n", $2;
+       exit (d < 1.0 ? 0 : 1) }' nest_parallel.dat_B.txt
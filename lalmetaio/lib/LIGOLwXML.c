@@ -52,6 +52,11 @@
  */
 
 
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
 #include <lal/FileIO.h>
 #include <lal/LALMalloc.h>
 #include <lal/LALVCSInfo.h>
@@ -60,6 +65,350 @@
 #include <lal/XLALError.h>
 #include <LIGOLwXMLHeaders.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
+
+/*
+ * ============================================================================
+ *
+ *                          Parallel gzip compression
+ *
+ * ============================================================================
+ */
+
+
+/* number of bytes of the document compressed into each gzip member */
+#define LIGOLW_XML_GZIP_BLOCK_SIZE 1048576
+
+
+/*
+ * The document is collected in blocks which, once all of them are full,
+ * are compressed in parallel into independent gzip members and written
+ * to the file in order.  A file made of several gzip members is a valid
+ * gzip file, and is read by gzip, zlib and therefore XLALFileOpenRead().
+ */
+
+struct tagLIGOLwXMLGzipWriter {
+	LALFILE *fp;
+	size_t nblocks;
+	size_t nfull;
+	struct {
+		char *data;
+		size_t len;
+		unsigned char *out;
+		size_t outlen;
+		int status;
+	} *block;
+};
+
+
+static void XLALDestroyLIGOLwXMLGzipWriter(LIGOLwXMLGzipWriter *writer)
+{
+	if(writer) {
+		size_t i;
+		if(writer->block)
+			for(i = 0; i < writer->nblocks; i++) {
+				LALFree(writer->block[i].data);
+				LALFree(writer->block[i].out);
+			}
+		LALFree(writer->block);
+		LALFree(writer);
+	}
+}
+
+
+static LIGOLwXMLGzipWriter *XLALCreateLIGOLwXMLGzipWriter(LALFILE *fp)
+{
+	/* a deflate stream with a gzip wrapper is never longer than this */
+	size_t outsize = compressBound(LIGOLW_XML_GZIP_BLOCK_SIZE) + 18;
+	LIGOLwXMLGzipWriter *writer;
+	size_t i;
+
+	writer = LALCalloc(1, sizeof(*writer));
+	if(!writer)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	writer->fp = fp;
+#ifdef _OPENMP
+	writer->nblocks = omp_get_max_threads();
+#else
+	writer->nblocks = 1;
+#endif
+	writer->block = LALCalloc(writer->nblocks, sizeof(*writer->block));
+	if(!writer->block) {
+		XLALDestroyLIGOLwXMLGzipWriter(writer);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	for(i = 0; i < writer->nblocks; i++) {
+		writer->block[i].data = LALMalloc(LIGOLW_XML_GZIP_BLOCK_SIZE);
+		writer->block[i].out = LALMalloc(outsize);
+		if(!writer->block[i].data || !writer->block[i].out) {
+			XLALDestroyLIGOLwXMLGzipWriter(writer);
+			XLAL_ERROR_NULL(XLAL_ENOMEM);
+		}
+	}
+
+	return writer;
+}
+
+
+/*
+ * compresses the blocks that hold data, and writes them to the file
+ */
+
+static int XLALLIGOLwXMLGzipWriterFlush(LIGOLwXMLGzipWriter *writer)
+{
+	size_t outsize = compressBound(LIGOLW_XML_GZIP_BLOCK_SIZE) + 18;
+	size_t n = writer->nfull;
+	int i;
+
+	if(n < writer->nblocks && writer->block[n].len)
+		n++;
+
+#pragma omp parallel for schedule(static, 1)
+	for(i = 0; i < (int) n; i++) {
+		z_stream strm;
+		memset(&strm, 0, sizeof(strm));
+		writer->block[i].status = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+		if(writer->block[i].status != Z_OK)
+			continue;
+		strm.next_in = (unsigned char *) writer->block[i].data;
+		strm.avail_in = writer->block[i].len;
+		strm.next_out = writer->block[i].out;
+		strm.avail_out = outsize;
+		writer->block[i].status = deflate(&strm, Z_FINISH);
+		writer->block[i].outlen = outsize - strm.avail_out;
+		deflateEnd(&strm);
+	}
+
+	for(i = 0; i < (int) n; i++) {
+		if(writer->block[i].status != Z_STREAM_END)
+			XLAL_ERROR(XLAL_EFAILED, "zlib error %d", writer->block[i].status);
+		if(XLALFileWrite(writer->block[i].out, 1, writer->block[i].outlen, writer->fp) != writer->block[i].outlen)
+			XLAL_ERROR(XLAL_EIO);
+		writer->block[i].len = 0;
+	}
+	writer->nfull = 0;
+
+	return 0;
+}
+
+
+static int XLALLIGOLwXMLGzipWriterWrite(LIGOLwXMLGzipWriter *writer, const char *data, size_t len)
+{
+	while(len) {
+		size_t n = LIGOLW_XML_GZIP_BLOCK_SIZE - writer->block[writer->nfull].len;
+		if(n > len)
+			n = len;
+		memcpy(writer->block[writer->nfull].data + writer->block[writer->nfull].len, data, n);
+		writer->block[writer->nfull].len += n;
+		data += n;
+		len -= n;
+		if(writer->block[writer->nfull].len == LIGOLW_XML_GZIP_BLOCK_SIZE && ++writer->nfull == writer->nblocks)
+			if(XLALLIGOLwXMLGzipWriterFlush(writer) < 0)
+				XLAL_ERROR(XLAL_EFUNC);
+	}
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                Output
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * all of the document goes through these, so that streams opened with
+ * XLALOpenLIGOLwXMLFileParallel() can collect it for compression.  on
+ * other streams they write to xml->fp as they always have.
+ */
+
+static int XLALLIGOLwXMLWrite(LIGOLwXMLStream *xml, const char *data, size_t len)
+{
+	if(xml->gzip) {
+		if(XLALLIGOLwXMLGzipWriterWrite(xml->gzip, data, len) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+	} else if(len && XLALFileWrite(data, 1, len, xml->fp) != len)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+static int XLALLIGOLwXMLPuts(LIGOLwXMLStream *xml, const char *s)
+{
+	if(xml->gzip)
+		return XLALLIGOLwXMLWrite(xml, s, strlen(s));
+	return XLALFilePuts(s, xml->fp);
+}
+
+
+static int XLALLIGOLwXMLPrintf(LIGOLwXMLStream *xml, const char *fmt, ...)
+{
+	char buf[32768];
+	char *s = buf;
+	va_list ap;
+	int len;
+
+	va_start(ap, fmt);
+	if(!xml->gzip) {
+		len = XLALFileVPrintf(xml->fp, fmt, ap);
+		va_end(ap);
+		return len;
+	}
+	len = vsnprintf(buf, sizeof(buf), fmt, ap);
+	va_end(ap);
+	if(len < 0)
+		XLAL_ERROR(XLAL_EFAILED);
+	if(len >= (int) sizeof(buf)) {
+		s = LALMalloc(len + 1);
+		if(!s)
+			XLAL_ERROR(XLAL_ENOMEM);
+		va_start(ap, fmt);
+		vsnprintf(s, len + 1, fmt, ap);
+		va_end(ap);
+	}
+	if(XLALLIGOLwXMLWrite(xml, s, len) < 0)
+		len = -1;
+	if(s != buf)
+		LALFree(s);
+	if(len < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return len;
+}
+
+
+/*
+ * rows of the large tables are formatted in parallel:  each thread formats
+ * a chunk of consecutive rows into its own buffer with the table's row
+ * formatting function, and the chunks are then written in order, one
+ * write per chunk.  a formatting function behaves like snprintf().
+ */
+
+/* number of rows in a chunk */
+#define LIGOLW_XML_ROWS_PER_CHUNK 1024
+
+typedef int (*LIGOLwXMLRowFormatter)(char *buf, size_t size, const void *row);
+
+/* the rows of a table are a linked list;  next_offset is the offset of
+ * the next pointer in a row */
+
+#define LIGOLW_XML_NEXT(row, next_offset) (*(const void *const *) ((const char *) (row) + (next_offset)))
+
+static int XLALLIGOLwXMLWriteRows(LIGOLwXMLStream *xml, const void *head, size_t next_offset, LIGOLwXMLRowFormatter format)
+{
+	const void **rows;
+	const void *row;
+	size_t nrows = 0;
+	struct {
+		char *data;
+		size_t len;
+		size_t size;
+		int failed;
+	} *chunk;
+	size_t nchunks;
+	size_t first;
+	int failed = 0;
+	int i;
+
+	/* the threads need random access to the rows */
+	for(row = head; row; row = LIGOLW_XML_NEXT(row, next_offset))
+		nrows++;
+	if(!nrows)
+		return 0;
+	rows = LALMalloc(nrows * sizeof(*rows));
+	if(!rows)
+		XLAL_ERROR(XLAL_ENOMEM);
+	for(row = head, nrows = 0; row; row = LIGOLW_XML_NEXT(row, next_offset))
+		rows[nrows++] = row;
+
+#ifdef _OPENMP
+	nchunks = 4 * omp_get_max_threads();
+#else
+	nchunks = 1;
+#endif
+	chunk = LALCalloc(nchunks, sizeof(*chunk));
+	if(!chunk) {
+		LALFree(rows);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+
+	/* the rows are formatted nchunks chunks at a time */
+	for(first = 0; first < nrows && !failed; first += nchunks * LIGOLW_XML_ROWS_PER_CHUNK) {
+		size_t n = (nrows - first + LIGOLW_XML_ROWS_PER_CHUNK - 1) / LIGOLW_XML_ROWS_PER_CHUNK;
+		if(n > nchunks)
+			n = nchunks;
+
+#pragma omp parallel for schedule(dynamic)
+		for(i = 0; i < (int) n; i++) {
+			size_t start = first + i * LIGOLW_XML_ROWS_PER_CHUNK;
+			size_t end = start + LIGOLW_XML_ROWS_PER_CHUNK < nrows ? start + LIGOLW_XML_ROWS_PER_CHUNK : nrows;
+			size_t j;
+			chunk[i].len = 0;
+			for(j = start; j < end && !chunk[i].failed; j++) {
+				const char *row_head = j ? ",\n\t\t\t" : "\n\t\t\t";
+				size_t headlen = strlen(row_head);
+				int len = 0;
+				for(;;) {
+					size_t avail = chunk[i].size - chunk[i].len;
+					size_t size;
+					char *data;
+					if(avail > headlen) {
+						len = format(chunk[i].data + chunk[i].len + headlen, avail - headlen, rows[j]);
+						if(len < 0) {
+							chunk[i].failed = 1;
+							break;
+						}
+						if((size_t) len < avail - headlen) {
+							memcpy(chunk[i].data + chunk[i].len, row_head, headlen);
+							chunk[i].len += headlen + len;
+							break;
+						}
+					}
+					/* make room for the row and try again */
+					size = 2 * chunk[i].size + headlen + len + 1;
+					data = LALRealloc(chunk[i].data, size);
+					if(!data) {
+						chunk[i].failed = 1;
+						break;
+					}
+					chunk[i].data = data;
+					chunk[i].size = size;
+				}
+			}
+		}
+
+		for(i = 0; i < (int) n; i++)
+			if(chunk[i].failed || XLALLIGOLwXMLWrite(xml, chunk[i].data, chunk[i].len) < 0) {
+				failed = 1;
+				break;
+			}
+	}
+
+	for(i = 0; i < (int) nchunks; i++)
+		LALFree(chunk[i].data);
+	LALFree(chunk);
+	LALFree(rows);
+	if(failed)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                                  Files
+ *
+ * ============================================================================
+ */
+
 
 /**
  * Open an XML file for writing.  The return value is a pointer to a new
@@ -86,6 +435,7 @@ XLALOpenLIGOLwXMLFile (
     XLALFree(new);
     XLAL_ERROR_NULL( XLAL_EFUNC );
   }
+  new->gzip = NULL;
 
   /* initialize the table flag */
 
@@ -93,7 +443,7 @@ XLALOpenLIGOLwXMLFile (
 
   /* write the XML header */
 
-  if ( PRINT_LIGOLW_XML_HEADER( new->fp ) < 0 )
+  if ( XLALLIGOLwXMLPuts( new, LIGOLW_XML_HEADER ) < 0 )
   {
     XLALFileClose( new->fp );
     XLALFree( new );
@@ -106,6 +456,72 @@ XLALOpenLIGOLwXMLFile (
 }
 
 
+/**
+ * Open an XML file for writing, like XLALOpenLIGOLwXMLFile(), but if the
+ * name ends in ".gz" the document is compressed in parallel:  it is
+ * written as a sequence of gzip members, each compressed by its own
+ * thread, which any gzip reader reads as one file.  The document of such
+ * a stream is only written by the XLALWriteLIGOLwXML...() functions and
+ * XLALCloseLIGOLwXMLFile();  its fp is NULL, so that the document cannot
+ * be corrupted by writing to the file directly.  Returns NULL on failure.
+ */
+LIGOLwXMLStream *
+XLALOpenLIGOLwXMLFileParallel (
+    const char *path
+)
+{
+  LIGOLwXMLStream *new;
+  const char *ext;
+  LALFILE *fp;
+
+  XLAL_CHECK_NULL( path, XLAL_EFAULT );
+
+  /* without compression there is nothing to do in parallel */
+
+  ext = strrchr( path, '.' );
+  if ( ! ext || strcmp( ext, ".gz" ) )
+  {
+    new = XLALOpenLIGOLwXMLFile( path );
+    if ( ! new )
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    return new;
+  }
+
+  /* the file itself is not compressed:  the members are */
+
+  new = XLALMalloc( sizeof( *new ) );
+  if ( ! new )
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  fp = XLALFileOpenWrite( path, 0 );
+  if ( ! fp )
+  {
+    XLALFree( new );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  new->fp = NULL;
+  new->gzip = XLALCreateLIGOLwXMLGzipWriter( fp );
+  if ( ! new->gzip )
+  {
+    XLALFileClose( fp );
+    XLALFree( new );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  new->table = no_table;
+
+  /* write the XML header */
+
+  if ( XLALLIGOLwXMLPuts( new, LIGOLW_XML_HEADER ) < 0 )
+  {
+    XLALDestroyLIGOLwXMLGzipWriter( new->gzip );
+    XLALFileClose( fp );
+    XLALFree( new );
+    XLAL_ERROR_NULL( XLAL_EIO );
+  }
+
+  return new;
+}
+
+
 /**
  * Close an XML stream.  On failure the stream is left in an undefined
  * state, and has not been free()'ed.  Sorry.
@@ -121,10 +537,19 @@ XLALCloseLIGOLwXMLFile (
     if ( xml->table != no_table)
       /* trying to close the file in the middle of a table */
       XLAL_ERROR(XLAL_EFAILED);
-    if ( PRINT_LIGOLW_XML_FOOTER( xml->fp ) < 0 )
+    if ( XLALLIGOLwXMLPuts( xml, LIGOLW_XML_FOOTER ) < 0 )
       /* can't write XML footer */
       XLAL_ERROR( XLAL_EIO );
-    if ( XLALFileClose( xml->fp ) )
+    if ( xml->gzip )
+    {
+      /* compress and write what is left of the document */
+      if ( XLALLIGOLwXMLGzipWriterFlush( xml->gzip ) < 0 )
+        XLAL_ERROR( XLAL_EFUNC );
+      if ( XLALFileClose( xml->gzip->fp ) )
+        XLAL_ERROR( XLAL_EFUNC );
+      XLALDestroyLIGOLwXMLGzipWriter( xml->gzip );
+    }
+    else if ( XLALFileClose( xml->fp ) )
       /* fclose() on the underlying C file failed */
       XLAL_ERROR( XLAL_EFUNC );
   }
@@ -155,30 +580,30 @@ int XLALWriteLIGOLwXMLProcessTable(
 	/* table header */
 
 	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"process:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:program\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:version\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:cvs_repository\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:cvs_entry_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:comment\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:is_online\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:node\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:username\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:unix_procid\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:start_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:end_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:jobid\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:domain\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:ifos\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"process:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	XLALLIGOLwXMLPuts(xml, "\t<Table Name=\"process:table\">\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:program\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:version\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:cvs_repository\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:cvs_entry_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:comment\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:is_online\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:node\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:username\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:unix_procid\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:start_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:end_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:jobid\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:domain\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:ifos\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Stream Name=\"process:table\" Type=\"Local\" Delimiter=\",\">");
 	if(XLALGetBaseErrno())
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* rows */
 
 	for(; process; process = process->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"%s\",\"%s\",\"%s\",%d,\"%s\",%d,\"%s\",\"%s\",%d,%d,%d,%d,\"%s\",\"%s\",%ld",
+		if(XLALLIGOLwXMLPrintf(xml, "%s\"%s\",\"%s\",\"%s\",%d,\"%s\",%d,\"%s\",\"%s\",%d,%d,%d,%d,\"%s\",\"%s\",%ld",
 			row_head,
 			process->program,
 			process->version,
@@ -202,7 +627,7 @@ int XLALWriteLIGOLwXMLProcessTable(
 
 	/* table footer */
 
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(XLALLIGOLwXMLPuts(xml, "\n\t\t</Stream>\n\t</Table>\n") < 0)
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* done */
@@ -231,20 +656,20 @@ int XLALWriteLIGOLwXMLProcessParamsTable(
 	/* table header */
 
 	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"process_params:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process_params:program\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process_params:param\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process_params:type\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process_params:value\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"process_params:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	XLALLIGOLwXMLPuts(xml, "\t<Table Name=\"process_params:table\">\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process_params:program\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process_params:param\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process_params:type\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process_params:value\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Stream Name=\"process_params:table\" Type=\"Local\" Delimiter=\",\">");
 	if(XLALGetBaseErrno())
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* rows */
 
 	for(; process_params; process_params = process_params->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"%s\",%ld,\"%s\",\"%s\",\"%s\"",
+		if(XLALLIGOLwXMLPrintf(xml, "%s\"%s\",%ld,\"%s\",\"%s\",\"%s\"",
 			row_head,
 			process_params->program,
 			process_params->process_id,
@@ -258,7 +683,7 @@ int XLALWriteLIGOLwXMLProcessParamsTable(
 
 	/* table footer */
 
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(XLALLIGOLwXMLPuts(xml, "\n\t\t</Stream>\n\t</Table>\n") < 0)
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* done */
@@ -287,31 +712,31 @@ int XLALWriteLIGOLwXMLSearchSummaryTable(
 	/* table header */
 
 	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"search_summary:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:shared_object\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:lalwrapper_cvs_tag\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:lal_cvs_tag\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:comment\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:ifos\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:in_start_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:in_start_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:in_end_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:in_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:out_start_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:out_start_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:out_end_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:out_end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:nevents\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"search_summary:nnodes\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"search_summary:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	XLALLIGOLwXMLPuts(xml, "\t<Table Name=\"search_summary:table\">\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:shared_object\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:lalwrapper_cvs_tag\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:lal_cvs_tag\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:comment\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:ifos\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:in_start_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:in_start_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:in_end_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:in_end_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:out_start_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:out_start_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:out_end_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:out_end_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:nevents\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"search_summary:nnodes\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Stream Name=\"search_summary:table\" Type=\"Local\" Delimiter=\",\">");
 	if(XLALGetBaseErrno())
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* rows */
 
 	for(; search_summary; search_summary = search_summary->next) {
-		if(XLALFilePrintf(xml->fp, "%s%ld,\"standalone\",\"\",\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%d,%d,%d,%d,%d,%d",
+		if(XLALLIGOLwXMLPrintf(xml, "%s%ld,\"standalone\",\"\",\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%d,%d,%d,%d,%d,%d",
 			row_head,
 			search_summary->process_id,
 			lalVCSInfo.vcsTag,
@@ -334,7 +759,7 @@ int XLALWriteLIGOLwXMLSearchSummaryTable(
 
 	/* table footer */
 
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(XLALLIGOLwXMLPuts(xml, "\n\t\t</Stream>\n\t</Table>\n") < 0)
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* done */
@@ -343,6 +768,37 @@ int XLALWriteLIGOLwXMLSearchSummaryTable(
 }
 
 
+/*
+ * formats a sngl_burst row for XLALLIGOLwXMLWriteRows()
+ */
+
+
+static int XLALLIGOLwXMLFormatSnglBurst(char *buf, size_t size, const void *row)
+{
+	const SnglBurst *sngl_burst = row;
+
+	return snprintf(buf, size, "%ld,\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.16g,%.16g,%ld",
+		sngl_burst->process_id,
+		sngl_burst->ifo,
+		sngl_burst->search,
+		sngl_burst->channel,
+		sngl_burst->start_time.gpsSeconds,
+		sngl_burst->start_time.gpsNanoSeconds,
+		sngl_burst->peak_time.gpsSeconds,
+		sngl_burst->peak_time.gpsNanoSeconds,
+		sngl_burst->duration,
+		sngl_burst->central_freq,
+		sngl_burst->bandwidth,
+		sngl_burst->amplitude,
+		sngl_burst->snr,
+		sngl_burst->confidence,
+		sngl_burst->chisq,
+		sngl_burst->chisq_dof,
+		sngl_burst->event_id
+	);
+}
+
+
 /**
  * Write a sngl_burst table to an XML file.
  */
@@ -353,8 +809,6 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 	const SnglBurst *sngl_burst
 )
 {
-	const char *row_head = "\n\t\t\t";
-
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
 		XLAL_ERROR(XLAL_EFAILED);
@@ -363,58 +817,36 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 	/* table header */
 
 	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"sngl_burst:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:ifo\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:search\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:channel\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:duration\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:central_freq\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:bandwidth\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:amplitude\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:snr\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:confidence\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq_dof\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:event_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"sngl_burst:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	XLALLIGOLwXMLPuts(xml, "\t<Table Name=\"sngl_burst:table\">\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:ifo\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:search\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:channel\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:start_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:start_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:peak_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:peak_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:duration\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:central_freq\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:bandwidth\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:amplitude\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:snr\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:confidence\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:chisq\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:chisq_dof\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_burst:event_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Stream Name=\"sngl_burst:table\" Type=\"Local\" Delimiter=\",\">");
 	if(XLALGetBaseErrno())
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* rows */
 
-	for(; sngl_burst; sngl_burst = sngl_burst->next) {
-		if(XLALFilePrintf(xml->fp, "%s%ld,\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.16g,%.16g,%ld",
-			row_head,
-			sngl_burst->process_id,
-			sngl_burst->ifo,
-			sngl_burst->search,
-			sngl_burst->channel,
-			sngl_burst->start_time.gpsSeconds,
-			sngl_burst->start_time.gpsNanoSeconds,
-			sngl_burst->peak_time.gpsSeconds,
-			sngl_burst->peak_time.gpsNanoSeconds,
-			sngl_burst->duration,
-			sngl_burst->central_freq,
-			sngl_burst->bandwidth,
-			sngl_burst->amplitude,
-			sngl_burst->snr,
-			sngl_burst->confidence,
-			sngl_burst->chisq,
-			sngl_burst->chisq_dof,
-			sngl_burst->event_id
-		) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
+	if(XLALLIGOLwXMLWriteRows(xml, sngl_burst, offsetof(SnglBurst, next), XLALLIGOLwXMLFormatSnglBurst) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
 
 	/* table footer */
 
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(XLALLIGOLwXMLPuts(xml, "\n\t\t</Stream>\n\t</Table>\n") < 0)
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* done */
@@ -422,13 +854,90 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 	return 0;
 }
 
+
+/*
+ * formats a sngl_inspiral row for XLALLIGOLwXMLWriteRows()
+ */
+
+
+static int XLALLIGOLwXMLFormatSnglInspiral(char *buf, size_t size, const void *row)
+{
+	const SnglInspiralTable *sngl_inspiral = row;
+
+	return snprintf(buf, size, "%ld,\"%s\",\"%s\",\"%s\",%d,%d,%.16g,%d,%d,%.16g,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%u,%.8g,%u,%.8g,%u,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%ld",
+		sngl_inspiral->process_id,
+		sngl_inspiral->ifo,
+		sngl_inspiral->search,
+		sngl_inspiral->channel,
+		sngl_inspiral->end.gpsSeconds,
+		sngl_inspiral->end.gpsNanoSeconds,
+		sngl_inspiral->end_time_gmst,
+		sngl_inspiral->impulse_time.gpsSeconds,
+		sngl_inspiral->impulse_time.gpsNanoSeconds,
+		sngl_inspiral->template_duration,
+		sngl_inspiral->event_duration,
+		sngl_inspiral->amplitude,
+		sngl_inspiral->eff_distance,
+		sngl_inspiral->coa_phase,
+		sngl_inspiral->mass1,
+		sngl_inspiral->mass2,
+		sngl_inspiral->mchirp,
+		sngl_inspiral->mtotal,
+		sngl_inspiral->eta,
+		sngl_inspiral->kappa,
+		sngl_inspiral->chi,
+		sngl_inspiral->tau0,
+		sngl_inspiral->tau2,
+		sngl_inspiral->tau3,
+		sngl_inspiral->tau4,
+		sngl_inspiral->tau5,
+		sngl_inspiral->ttotal,
+		sngl_inspiral->psi0,
+		sngl_inspiral->psi3,
+		sngl_inspiral->alpha,
+		sngl_inspiral->alpha1,
+		sngl_inspiral->alpha2,
+		sngl_inspiral->alpha3,
+		sngl_inspiral->alpha4,
+		sngl_inspiral->alpha5,
+		sngl_inspiral->alpha6,
+		sngl_inspiral->beta,
+		sngl_inspiral->f_final,
+		sngl_inspiral->snr,
+		sngl_inspiral->chisq,
+		sngl_inspiral->chisq_dof,
+		sngl_inspiral->bank_chisq,
+		sngl_inspiral->bank_chisq_dof,
+		sngl_inspiral->cont_chisq,
+		sngl_inspiral->cont_chisq_dof,
+		sngl_inspiral->sigmasq,
+		sngl_inspiral->rsqveto_duration,
+		sngl_inspiral->Gamma[0],
+		sngl_inspiral->Gamma[1],
+		sngl_inspiral->Gamma[2],
+		sngl_inspiral->Gamma[3],
+		sngl_inspiral->Gamma[4],
+		sngl_inspiral->Gamma[5],
+		sngl_inspiral->Gamma[6],
+		sngl_inspiral->Gamma[7],
+		sngl_inspiral->Gamma[8],
+		sngl_inspiral->Gamma[9],
+		sngl_inspiral->spin1x,
+		sngl_inspiral->spin1y,
+		sngl_inspiral->spin1z,
+		sngl_inspiral->spin2x,
+		sngl_inspiral->spin2y,
+		sngl_inspiral->spin2z,
+		sngl_inspiral->event_id
+	);
+}
+
+
 int XLALWriteLIGOLwXMLSnglInspiralTable(
 	LIGOLwXMLStream *xml,
 	const SnglInspiralTable *sngl_inspiral
 )
 {
-	const char *row_head = "\n\t\t\t";
-
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
 		XLAL_ERROR(XLAL_EFAILED);
@@ -437,150 +946,82 @@ int XLALWriteLIGOLwXMLSnglInspiralTable(
 	/* table header */
 
 	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"sngl_inspiral:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:ifo\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:search\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:channel\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:end_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:end_time_gmst\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:impulse_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:impulse_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:template_duration\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:event_duration\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:amplitude\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:eff_distance\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:coa_phase\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mass1\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mass2\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mchirp\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mtotal\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:eta\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:kappa\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:chi\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau0\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau2\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau3\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau4\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau5\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:ttotal\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:psi0\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:psi3\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha1\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha2\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha3\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha4\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha5\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha6\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:beta\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:f_final\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:snr\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:chisq\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:chisq_dof\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:bank_chisq\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:bank_chisq_dof\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:cont_chisq\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:cont_chisq_dof\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:sigmasq\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:rsqveto_duration\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma0\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma1\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma2\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma3\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma4\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma5\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma6\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma7\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma8\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma9\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin1x\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin1y\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin1z\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin2x\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin2y\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin2z\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:event_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"sngl_inspiral:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	XLALLIGOLwXMLPuts(xml, "\t<Table Name=\"sngl_inspiral:table\">\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:ifo\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:search\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:channel\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:end_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:end_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:end_time_gmst\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:impulse_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:impulse_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:template_duration\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:event_duration\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:amplitude\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:eff_distance\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:coa_phase\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:mass1\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:mass2\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:mchirp\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:mtotal\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:eta\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:kappa\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:chi\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:tau0\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:tau2\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:tau3\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:tau4\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:tau5\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:ttotal\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:psi0\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:psi3\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:alpha\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:alpha1\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:alpha2\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:alpha3\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:alpha4\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:alpha5\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:alpha6\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:beta\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:f_final\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:snr\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:chisq\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:chisq_dof\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:bank_chisq\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:bank_chisq_dof\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:cont_chisq\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:cont_chisq_dof\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:sigmasq\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:rsqveto_duration\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma0\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma1\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma2\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma3\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma4\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma5\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma6\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma7\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma8\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:Gamma9\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:spin1x\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:spin1y\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:spin1z\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:spin2x\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:spin2y\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:spin2z\" Type=\"real_4\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sngl_inspiral:event_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Stream Name=\"sngl_inspiral:table\" Type=\"Local\" Delimiter=\",\">");
 	if(XLALGetBaseErrno())
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* rows */
 
-	for(; sngl_inspiral; sngl_inspiral = sngl_inspiral->next) {
-		if( XLALFilePrintf(xml->fp,"%s%ld,\"%s\",\"%s\",\"%s\",%d,%d,%.16g,%d,%d,%.16g,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%u,%.8g,%u,%.8g,%u,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%ld",
-			   row_head,
-			   sngl_inspiral->process_id,
-			   sngl_inspiral->ifo,
-			   sngl_inspiral->search,
-			   sngl_inspiral->channel,
-			   sngl_inspiral->end.gpsSeconds,
-			   sngl_inspiral->end.gpsNanoSeconds,
-			   sngl_inspiral->end_time_gmst,
-			   sngl_inspiral->impulse_time.gpsSeconds,
-			   sngl_inspiral->impulse_time.gpsNanoSeconds,
-			   sngl_inspiral->template_duration,
-			   sngl_inspiral->event_duration,
-			   sngl_inspiral->amplitude,
-			   sngl_inspiral->eff_distance,
-			   sngl_inspiral->coa_phase,
-			   sngl_inspiral->mass1,
-			   sngl_inspiral->mass2,
-			   sngl_inspiral->mchirp,
-			   sngl_inspiral->mtotal,
-			   sngl_inspiral->eta,
-			   sngl_inspiral->kappa,
-			   sngl_inspiral->chi,
-			   sngl_inspiral->tau0,
-			   sngl_inspiral->tau2,
-			   sngl_inspiral->tau3,
-			   sngl_inspiral->tau4,
-			   sngl_inspiral->tau5,
-			   sngl_inspiral->ttotal,
-			   sngl_inspiral->psi0,
-			   sngl_inspiral->psi3,
-			   sngl_inspiral->alpha,
-			   sngl_inspiral->alpha1,
-			   sngl_inspiral->alpha2,
-			   sngl_inspiral->alpha3,
-			   sngl_inspiral->alpha4,
-			   sngl_inspiral->alpha5,
-			   sngl_inspiral->alpha6,
-			   sngl_inspiral->beta,
-			   sngl_inspiral->f_final,
-			   sngl_inspiral->snr,
-			   sngl_inspiral->chisq,
-			   sngl_inspiral->chisq_dof,
-			   sngl_inspiral->bank_chisq,
-			   sngl_inspiral->bank_chisq_dof,
-			   sngl_inspiral->cont_chisq,
-			   sngl_inspiral->cont_chisq_dof,
-			   sngl_inspiral->sigmasq,
-			   sngl_inspiral->rsqveto_duration,
-			   sngl_inspiral->Gamma[0],
-			   sngl_inspiral->Gamma[1],
-			   sngl_inspiral->Gamma[2],
-			   sngl_inspiral->Gamma[3],
-			   sngl_inspiral->Gamma[4],
-			   sngl_inspiral->Gamma[5],
-			   sngl_inspiral->Gamma[6],
-			   sngl_inspiral->Gamma[7],
-			   sngl_inspiral->Gamma[8],
-			   sngl_inspiral->Gamma[9],
-			   sngl_inspiral->spin1x,  
-			   sngl_inspiral->spin1y,
-			   sngl_inspiral->spin1z,
-			   sngl_inspiral->spin2x,
-			   sngl_inspiral->spin2y,
-			   sngl_inspiral->spin2z,
-			   sngl_inspiral->event_id ) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
+	if(XLALLIGOLwXMLWriteRows(xml, sngl_inspiral, offsetof(SnglInspiralTable, next), XLALLIGOLwXMLFormatSnglInspiral) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
 
 	/* table footer */
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(XLALLIGOLwXMLPuts(xml, "\n\t\t</Stream>\n\t</Table>\n") < 0)
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* done */
@@ -590,6 +1031,40 @@ int XLALWriteLIGOLwXMLSnglInspiralTable(
 
 
 
+/*
+ * formats a sim_burst row for XLALLIGOLwXMLWriteRows()
+ */
+
+
+static int XLALLIGOLwXMLFormatSimBurst(char *buf, size_t size, const void *row)
+{
+	const SimBurst *sim_burst = row;
+
+	return snprintf(buf, size, "%ld,\"%s\",%.16g,%.16g,%.16g,%d,%d,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%lu,%ld,%ld",
+		sim_burst->process_id,
+		sim_burst->waveform,
+		sim_burst->ra,
+		sim_burst->dec,
+		sim_burst->psi,
+		sim_burst->time_geocent_gps.gpsSeconds,
+		sim_burst->time_geocent_gps.gpsNanoSeconds,
+		sim_burst->time_geocent_gmst,
+		sim_burst->duration,
+		sim_burst->frequency,
+		sim_burst->bandwidth,
+		sim_burst->q,
+		sim_burst->pol_ellipse_angle,
+		sim_burst->pol_ellipse_e,
+		sim_burst->amplitude,
+		sim_burst->hrss,
+		sim_burst->egw_over_rsquared,
+		sim_burst->waveform_number,
+		sim_burst->time_slide_id,
+		sim_burst->simulation_id
+	);
+}
+
+
 /**
  * Write a sim_burst table to an XML file.
  */
@@ -600,8 +1075,6 @@ int XLALWriteLIGOLwXMLSimBurstTable(
 	const SimBurst *sim_burst
 )
 {
-	const char *row_head = "\n\t\t\t";
-
 	if(xml->table != no_table) {
 		XLALPrintError("a table is still open");
 		XLAL_ERROR(XLAL_EFAILED);
@@ -610,64 +1083,39 @@ int XLALWriteLIGOLwXMLSimBurstTable(
 	/* table header */
 
 	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"sim_burst:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:waveform\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:ra\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:dec\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:psi\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gps\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gps_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gmst\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:duration\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:frequency\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:bandwidth\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:q\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:pol_ellipse_angle\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:pol_ellipse_e\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:amplitude\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:hrss\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:egw_over_rsquared\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:waveform_number\" Type=\"int_8u\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide:time_slide_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:simulation_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"sim_burst:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	XLALLIGOLwXMLPuts(xml, "\t<Table Name=\"sim_burst:table\">\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:waveform\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:ra\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:dec\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:psi\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:time_geocent_gps\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:time_geocent_gps_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:time_geocent_gmst\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:duration\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:frequency\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:bandwidth\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:q\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:pol_ellipse_angle\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:pol_ellipse_e\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:amplitude\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:hrss\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:egw_over_rsquared\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:waveform_number\" Type=\"int_8u\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"time_slide:time_slide_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"sim_burst:simulation_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Stream Name=\"sim_burst:table\" Type=\"Local\" Delimiter=\",\">");
 	if(XLALGetBaseErrno())
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* rows */
 
-	for(; sim_burst; sim_burst = sim_burst->next) {
-		if(XLALFilePrintf(xml->fp, "%s%ld,\"%s\",%.16g,%.16g,%.16g,%d,%d,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%lu,%ld,%ld",
-			row_head,
-			sim_burst->process_id,
-			sim_burst->waveform,
-			sim_burst->ra,
-			sim_burst->dec,
-			sim_burst->psi,
-			sim_burst->time_geocent_gps.gpsSeconds,
-			sim_burst->time_geocent_gps.gpsNanoSeconds,
-			sim_burst->time_geocent_gmst,
-			sim_burst->duration,
-			sim_burst->frequency,
-			sim_burst->bandwidth,
-			sim_burst->q,
-			sim_burst->pol_ellipse_angle,
-			sim_burst->pol_ellipse_e,
-			sim_burst->amplitude,
-			sim_burst->hrss,
-			sim_burst->egw_over_rsquared,
-			sim_burst->waveform_number,
-			sim_burst->time_slide_id,
-			sim_burst->simulation_id
-		) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
+	if(XLALLIGOLwXMLWriteRows(xml, sim_burst, offsetof(SimBurst, next), XLALLIGOLwXMLFormatSimBurst) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
 
 	/* table footer */
 
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(XLALLIGOLwXMLPuts(xml, "\n\t\t</Stream>\n\t</Table>\n") < 0)
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* done */
@@ -696,19 +1144,19 @@ int XLALWriteLIGOLwXMLTimeSlideTable(
 	/* table header */
 
 	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"time_slide:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide:time_slide_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide:instrument\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide:offset\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"time_slide:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	XLALLIGOLwXMLPuts(xml, "\t<Table Name=\"time_slide:table\">\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"time_slide:time_slide_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"time_slide:instrument\" Type=\"lstring\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"time_slide:offset\" Type=\"real_8\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Stream Name=\"time_slide:table\" Type=\"Local\" Delimiter=\",\">");
 	if(XLALGetBaseErrno())
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* rows */
 
 	for(; time_slide; time_slide = time_slide->next) {
-		if(XLALFilePrintf(xml->fp, "%s%ld,%ld,\"%s\",%.16g",
+		if(XLALLIGOLwXMLPrintf(xml, "%s%ld,%ld,\"%s\",%.16g",
 			row_head,
 			time_slide->process_id,
 			time_slide->time_slide_id,
@@ -721,7 +1169,7 @@ int XLALWriteLIGOLwXMLTimeSlideTable(
 
 	/* table footer */
 
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(XLALLIGOLwXMLPuts(xml, "\n\t\t</Stream>\n\t</Table>\n") < 0)
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* done */
@@ -749,24 +1197,24 @@ int XLALWriteLIGOLwXMLSegmentTable(
 	/* table header */
 
 	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"segment:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:creator_db\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:segment_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:start_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:start_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:end_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment_definer:segment_def_id\" Type=\"int_8s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:segment_def_cdb\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"segment:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
+	XLALLIGOLwXMLPuts(xml, "\t<Table Name=\"segment:table\">\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"segment:creator_db\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"process:process_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"segment:segment_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"segment:start_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"segment:start_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"segment:end_time\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"segment:end_time_ns\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"segment_definer:segment_def_id\" Type=\"int_8s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Column Name=\"segment:segment_def_cdb\" Type=\"int_4s\"/>\n");
+	XLALLIGOLwXMLPuts(xml, "\t\t<Stream Name=\"segment:table\" Type=\"Local\" Delimiter=\",\">");
 	if(XLALGetBaseErrno())
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* rows */
 
 	for(; segment_table; segment_table = segment_table->next) {
-		if(XLALFilePrintf(xml->fp, "%s%d,%ld,%ld,%d,%d,%d,%d,%ld,%d",
+		if(XLALLIGOLwXMLPrintf(xml, "%s%d,%ld,%ld,%d,%d,%d,%d,%ld,%d",
 			row_head,
 			segment_table->creator_db,
 			segment_table->process_id,
@@ -784,7 +1232,7 @@ int XLALWriteLIGOLwXMLSegmentTable(
 
 	/* table footer */
 
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(XLALLIGOLwXMLPuts(xml, "\n\t\t</Stream>\n\t</Table>\n") < 0)
 		XLAL_ERROR(XLAL_EFUNC);
 
 	/* done */
@@ -63,9 +63,13 @@ extern "C" {
  * <dt>first</dt><dd> Is this the first entry in the table.</dd>
  * <dt>rowCount</dt><dd> Counter for the number of rows in the current table.</dd>
  * <dt>table</dt><dd> The database table currently open.</dd>
+ * <dt>gzip</dt><dd> The parallel compressor of a stream opened with
+ * \c XLALOpenLIGOLwXMLFileParallel(), or NULL.</dd>
  * </dl>
  *
  */
+typedef struct tagLIGOLwXMLGzipWriter LIGOLwXMLGzipWriter;
+
 typedef struct
 tagLIGOLwXMLStream
 {
@@ -73,6 +77,7 @@ tagLIGOLwXMLStream
   INT4                  first;
   UINT8                 rowCount;
   MetadataTableType     table;
+  LIGOLwXMLGzipWriter  *gzip;
 }
 LIGOLwXMLStream;
 
@@ -82,6 +87,11 @@ XLALOpenLIGOLwXMLFile (
     const char *path
     );
 
+LIGOLwXMLStream *
+XLALOpenLIGOLwXMLFileParallel (
+    const char *path
+    );
+
 int
 XLALCloseLIGOLwXMLFile (
     LIGOLwXMLStream *xml
@@ -61,14 +61,19 @@ extern "C" {
 } /* so that editors will match preceding brace */
 #endif
 
-#define PRINT_LIGOLW_XML_HEADER(fp) (( \
-XLALFilePuts( "<?xml version='1.0' encoding='utf-8' ?>\n", fp) == EOF || \
-XLALFilePuts( "<!DOCTYPE LIGO_LW SYSTEM \"http://ldas-sw.ligo.caltech.edu/doc/ligolwAPI/html/ligolw_dtd.txt\">", fp ) == EOF || \
-XLALFilePuts( "<LIGO_LW>\n", fp ) == EOF ) ? EOF : 0)
+#define LIGOLW_XML_HEADER \
+"<?xml version='1.0' encoding='utf-8' ?>\n" \
+"<!DOCTYPE LIGO_LW SYSTEM \"http://ldas-sw.ligo.caltech.edu/doc/ligolwAPI/html/ligolw_dtd.txt\">" \
+"<LIGO_LW>\n"
 
+#define LIGOLW_XML_FOOTER \
+"</LIGO_LW>"
+
+#define PRINT_LIGOLW_XML_HEADER(fp) \
+XLALFilePuts( LIGOLW_XML_HEADER, fp )
 
 #define PRINT_LIGOLW_XML_FOOTER(fp) \
-XLALFilePuts( "</LIGO_LW>", fp )
+XLALFilePuts( LIGOLW_XML_FOOTER, fp )
 
 #define PRINT_LIGOLW_XML_TABLE_FOOTER(fp) ( \
 XLALFilePuts( "\n", fp ) == EOF || \
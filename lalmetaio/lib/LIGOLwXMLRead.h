@@ -98,6 +98,61 @@ XLALSearchSummaryTableFromLIGOLw (
     const char *fileName
     );
 
+/* streaming table reader:  see LIGOLwXMLStreamRead.c */
+
+/** Type in which the values of a column are returned by the table reader */
+typedef enum tagLIGOLwXMLColumnType {
+    LIGOLW_XML_TYPE_INT_8S,	/**< integer columns, returned as INT8 */
+    LIGOLW_XML_TYPE_REAL_8,	/**< floating-point columns, returned as REAL8 */
+    LIGOLW_XML_TYPE_LSTRING	/**< all other columns, returned as strings */
+} LIGOLwXMLColumnType;
+
+/** A value of a column returned by the table reader */
+typedef union tagLIGOLwXMLValue {
+    INT8 int_8s;
+    REAL8 real_8;
+    const char *lstring;
+} LIGOLwXMLValue;
+
+/** Opaque type of the streaming reader of a LIGO Light Weight XML table */
+typedef struct tagLIGOLwXMLTableReader LIGOLwXMLTableReader;
+
+#ifndef SWIG   // exclude from SWIG interface
+
+LIGOLwXMLTableReader *
+XLALLIGOLwXMLTableReaderOpen(
+    const char *filename,
+    const char *table_name,
+    const char *const *columns,
+    size_t ncolumns
+);
+
+void
+XLALLIGOLwXMLTableReaderClose(
+    LIGOLwXMLTableReader *reader
+);
+
+int
+XLALLIGOLwXMLTableReaderColumnType(
+    const LIGOLwXMLTableReader *reader,
+    size_t column
+);
+
+int
+XLALLIGOLwXMLTableReaderNext(
+    LIGOLwXMLTableReader *reader,
+    const LIGOLwXMLValue **row
+);
+
+long
+XLALLIGOLwXMLTableReaderForEach(
+    LIGOLwXMLTableReader *reader,
+    int (*func)(const LIGOLwXMLValue *row, void *data),
+    void *data
+);
+
+#endif /* SWIG */
+
 #ifdef  __cplusplus
 }
 #endif
@@ -0,0 +1,670 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ * 02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalmetaio_general
+ *
+ * \brief Streaming reader for the rows of a table in a LIGO Light Weight
+ * XML file.
+ *
+ * ### Description ###
+ *
+ * The routines in LIGOLwXMLRead.c read a whole table through libmetaio and
+ * convert every column of every row into a linked list of row structures.
+ * For large trigger files most of that work is wasted when only a few
+ * columns are wanted.  The reader here scans the document itself: it finds
+ * the requested table, maps the requested columns (the "projection") onto
+ * the columns of the table, and then tokenizes the table's Stream,
+ * converting only the projected values.  Rows are returned one at a time,
+ * either with XLALLIGOLwXMLTableReaderNext() or through a callback with
+ * XLALLIGOLwXMLTableReaderForEach(), so memory use does not grow with the
+ * size of the table.  The file is read through LALFILE, so gzip-compressed
+ * files are read transparently.
+ *
+ * Values are converted according to the Type attribute of their column:
+ * integer types are returned as INT8, floating-point types as REAL8 and
+ * everything else (lstring, char_s, ilwd:char, ...) as a string.  Empty
+ * (null) values are returned as 0, NaN and NULL respectively.
+ *
+ * ### Example ###
+ *
+ * \code
+ * static const char *columns[] = {"end_time", "end_time_ns", "snr"};
+ * LIGOLwXMLTableReader *reader;
+ * const LIGOLwXMLValue *row;
+ *
+ * reader = XLALLIGOLwXMLTableReaderOpen("triggers.xml.gz", "sngl_inspiral", columns, 3);
+ * while(XLALLIGOLwXMLTableReaderNext(reader, &row) > 0)
+ * 	printf("%lld.%09lld %g\n", row[0].int_8s, row[1].int_8s, row[2].real_8);
+ * XLALLIGOLwXMLTableReaderClose(reader);
+ * \endcode
+ */
+
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/FileIO.h>
+#include <lal/LALMalloc.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALString.h>
+#include <lal/LIGOLwXMLRead.h>
+#include <lal/XLALError.h>
+
+/* number of bytes read from the file at a time */
+#define LIGOLW_XML_READ_SIZE 1048576
+
+struct tagLIGOLwXMLTableReader {
+	LALFILE *fp;
+	/* file data: buf[pos, len) has not been examined yet; buf[len] is
+	 * always a nul so that tags can be parsed as strings */
+	char *buf;
+	size_t size;
+	size_t len;
+	size_t pos;
+	int eof;
+	int done;
+	char delimiter;
+	/* for each column of the table, the index of the projected column
+	 * it supplies, or -1 */
+	size_t ncolumn;
+	int *project;
+	/* the projected columns */
+	size_t nproject;
+	LIGOLwXMLColumnType *type;
+	LIGOLwXMLValue *row;
+	/* storage for the string values of the current row */
+	char *strbuf;
+	size_t strsize;
+	size_t *stroff;
+};
+
+
+/*
+ * reads more of the file, keeping the data that have not been examined;
+ * returns the number of bytes read, 0 at the end of the file
+ */
+
+static long XLALLIGOLwXMLTableReaderFill(LIGOLwXMLTableReader *reader)
+{
+	size_t n;
+
+	if(reader->eof)
+		return 0;
+
+	if(reader->pos) {
+		memmove(reader->buf, reader->buf + reader->pos, reader->len - reader->pos);
+		reader->len -= reader->pos;
+		reader->pos = 0;
+	}
+	if(reader->len == reader->size) {
+		char *buf = LALRealloc(reader->buf, 2 * reader->size + 1);
+		if(!buf)
+			XLAL_ERROR(XLAL_ENOMEM);
+		reader->buf = buf;
+		reader->size *= 2;
+	}
+
+	n = XLALFileRead(reader->buf + reader->len, 1, reader->size - reader->len, reader->fp);
+	if(!n)
+		reader->eof = 1;
+	reader->len += n;
+	reader->buf[reader->len] = '\0';
+	return n;
+}
+
+
+/*
+ * finds the next tag and returns the text between "<" and ">"; the text is
+ * valid until the next read from the file.  returns NULL at the end of the
+ * file.
+ */
+
+static const char *XLALLIGOLwXMLTableReaderTag(LIGOLwXMLTableReader *reader)
+{
+	const char *p;
+	size_t start;
+	long n;
+
+	/* skip to the next "<"; text between tags is not needed */
+	while(!(p = memchr(reader->buf + reader->pos, '<', reader->len - reader->pos))) {
+		reader->pos = reader->len;
+		if((n = XLALLIGOLwXMLTableReaderFill(reader)) <= 0) {
+			if(n < 0)
+				XLAL_ERROR_NULL(XLAL_EFUNC);
+			return NULL;
+		}
+	}
+	reader->pos = p - reader->buf;
+
+	/* find the end of the tag */
+	while(!(p = memchr(reader->buf + reader->pos, '>', reader->len - reader->pos)))
+		if(XLALLIGOLwXMLTableReaderFill(reader) <= 0)
+			XLAL_ERROR_NULL(XLAL_EIO, "unterminated tag");
+	start = reader->pos + 1;
+	reader->pos = p - reader->buf + 1;
+	reader->buf[reader->pos - 1] = '\0';
+	return reader->buf + start;
+}
+
+
+/*
+ * tests whether a tag is an element of the given name
+ */
+
+static int XLALLIGOLwXMLTagIs(const char *tag, const char *name)
+{
+	size_t n = strlen(name);
+	return !strncmp(tag, name, n) && (isspace((unsigned char) tag[n]) || tag[n] == '/' || tag[n] == '\0');
+}
+
+
+/*
+ * copies the value of an attribute of a tag to value; returns 0 if the tag
+ * has no such attribute
+ */
+
+static int XLALLIGOLwXMLTagAttribute(char *value, size_t size, const char *tag, const char *name)
+{
+	size_t n = strlen(name);
+	const char *p;
+
+	for(p = tag; (p = strstr(p, name)); p += n) {
+		const char *q;
+		size_t len;
+		/* must be a whole word followed by =" */
+		if(p > tag && !isspace((unsigned char) p[-1]))
+			continue;
+		q = p + n;
+		while(isspace((unsigned char) *q))
+			q++;
+		if(*q++ != '=')
+			continue;
+		while(isspace((unsigned char) *q))
+			q++;
+		if(*q != '"' && *q != '\'')
+			continue;
+		len = strcspn(q + 1, *q == '"' ? "\"" : "'");
+		if(len >= size)
+			len = size - 1;
+		memcpy(value, q + 1, len);
+		value[len] = '\0';
+		return 1;
+	}
+	return 0;
+}
+
+
+/*
+ * strips the decorations from a table or column name:
+ * "group:name:table" -> "name", "table:name" -> "name"
+ */
+
+static const char *XLALLIGOLwXMLBareName(char *name)
+{
+	char *p;
+	size_t n = strlen(name);
+	if(n > 6 && !strcmp(name + n - 6, ":table"))
+		name[n - 6] = '\0';
+	p = strrchr(name, ':');
+	return p ? p + 1 : name;
+}
+
+
+static LIGOLwXMLColumnType XLALLIGOLwXMLColumnTypeFromString(const char *type)
+{
+	static const char *const ints[] = {"int_2s", "int_4s", "int_8s", "int_2u", "int_4u", "int_8u", "int", "long", "short"};
+	static const char *const reals[] = {"real_4", "real_8", "float", "double"};
+	size_t i;
+
+	for(i = 0; i < sizeof(ints) / sizeof(*ints); i++)
+		if(!strcmp(type, ints[i]))
+			return LIGOLW_XML_TYPE_INT_8S;
+	for(i = 0; i < sizeof(reals) / sizeof(*reals); i++)
+		if(!strcmp(type, reals[i]))
+			return LIGOLW_XML_TYPE_REAL_8;
+	return LIGOLW_XML_TYPE_LSTRING;
+}
+
+
+/*
+ * reads the header of the table: its columns and the start of its stream
+ */
+
+static int XLALLIGOLwXMLTableReaderHeader(LIGOLwXMLTableReader *reader, const char *table_name, const char *const *columns)
+{
+	char bare_table[256];
+	char value[256];
+	const char *tag;
+	size_t nfound = 0;
+	size_t j;
+
+	XLALStringCopy(bare_table, table_name, sizeof(bare_table));
+	table_name = XLALLIGOLwXMLBareName(bare_table);
+
+	/* find the table */
+	for(;;) {
+		tag = XLALLIGOLwXMLTableReaderTag(reader);
+		if(!tag) {
+			if(xlalErrno)
+				XLAL_ERROR(XLAL_EFUNC);
+			XLAL_ERROR(XLAL_EDATA, "cannot find %s table", table_name);
+		}
+		if(XLALLIGOLwXMLTagIs(tag, "Table") && XLALLIGOLwXMLTagAttribute(value, sizeof(value), tag, "Name") && !strcmp(XLALLIGOLwXMLBareName(value), table_name))
+			break;
+	}
+
+	/* read its columns up to the stream */
+	for(;;) {
+		tag = XLALLIGOLwXMLTableReaderTag(reader);
+		if(!tag)
+			XLAL_ERROR(xlalErrno ? XLAL_EFUNC : XLAL_EIO, "unexpected end of document in %s table", table_name);
+		if(XLALLIGOLwXMLTagIs(tag, "Column")) {
+			int *project = LALRealloc(reader->project, (reader->ncolumn + 1) * sizeof(*project));
+			const char *name;
+			if(!project)
+				XLAL_ERROR(XLAL_ENOMEM);
+			reader->project = project;
+			project[reader->ncolumn] = -1;
+			if(!XLALLIGOLwXMLTagAttribute(value, sizeof(value), tag, "Name"))
+				XLAL_ERROR(XLAL_EDATA, "column %zu of %s table has no name", reader->ncolumn, table_name);
+			name = XLALLIGOLwXMLBareName(value);
+			for(j = 0; j < reader->nproject; j++)
+				if(reader->type[j] == (LIGOLwXMLColumnType) -1 && !strcmp(name, columns[j]))
+					break;
+			if(j < reader->nproject) {
+				project[reader->ncolumn] = j;
+				reader->type[j] = XLALLIGOLwXMLTagAttribute(value, sizeof(value), tag, "Type") ? XLALLIGOLwXMLColumnTypeFromString(value) : LIGOLW_XML_TYPE_LSTRING;
+				nfound++;
+			}
+			reader->ncolumn++;
+		} else if(XLALLIGOLwXMLTagIs(tag, "Stream")) {
+			if(XLALLIGOLwXMLTagAttribute(value, sizeof(value), tag, "Delimiter") && value[0])
+				reader->delimiter = value[0];
+			/* an empty element <Stream .../> has no rows */
+			if(tag[strlen(tag) - 1] == '/')
+				reader->done = 1;
+			break;
+		} else if(XLALLIGOLwXMLTagIs(tag, "/Table")) {
+			/* a table without a stream has no rows */
+			reader->done = 1;
+			break;
+		}
+	}
+
+	/* make sure all the projected columns were found */
+	if(nfound < reader->nproject)
+		for(j = 0; j < reader->nproject; j++)
+			if(reader->type[j] == (LIGOLwXMLColumnType) -1)
+				XLAL_ERROR(XLAL_EDATA, "%s table has no column %s", table_name, columns[j]);
+	return 0;
+}
+
+
+/**
+ * Opens a LIGO Light Weight XML file (which may be gzip-compressed) and
+ * prepares to read the columns listed in columns (without the table name
+ * prefix) from the rows of the table table_name.  Each column may be listed
+ * only once.  Returns NULL on failure, e.g., if the table or one of the
+ * columns cannot be found.
+ */
+LIGOLwXMLTableReader *XLALLIGOLwXMLTableReaderOpen(
+	const char *filename,
+	const char *table_name,
+	const char *const *columns,
+	size_t ncolumns
+)
+{
+	LIGOLwXMLTableReader *reader;
+	size_t j;
+
+	XLAL_CHECK_NULL(filename, XLAL_EFAULT);
+	XLAL_CHECK_NULL(table_name, XLAL_EFAULT);
+	XLAL_CHECK_NULL(columns || !ncolumns, XLAL_EFAULT);
+	for(j = 0; j < ncolumns; j++)
+		XLAL_CHECK_NULL(columns[j], XLAL_EFAULT);
+
+	reader = LALCalloc(1, sizeof(*reader));
+	if(!reader)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	reader->delimiter = ',';
+	reader->nproject = ncolumns;
+	reader->size = LIGOLW_XML_READ_SIZE;
+	reader->buf = LALMalloc(reader->size + 1);
+	reader->type = LALMalloc((ncolumns + 1) * sizeof(*reader->type));
+	reader->row = LALCalloc(ncolumns + 1, sizeof(*reader->row));
+	reader->stroff = LALCalloc(ncolumns + 1, sizeof(*reader->stroff));
+	if(!reader->buf || !reader->type || !reader->row || !reader->stroff) {
+		XLALLIGOLwXMLTableReaderClose(reader);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	reader->buf[0] = '\0';
+	for(j = 0; j < ncolumns; j++)
+		reader->type[j] = (LIGOLwXMLColumnType) -1;
+
+	reader->fp = XLALFileOpenRead(filename);
+	if(!reader->fp) {
+		XLALLIGOLwXMLTableReaderClose(reader);
+		XLAL_ERROR_NULL(XLAL_EIO, "error opening \"%s\"", filename);
+	}
+
+	XLALClearErrno();
+	if(XLALLIGOLwXMLTableReaderHeader(reader, table_name, columns) < 0) {
+		XLALLIGOLwXMLTableReaderClose(reader);
+		XLAL_ERROR_NULL(XLAL_EFUNC, "error reading \"%s\"", filename);
+	}
+
+	return reader;
+}
+
+
+/**
+ * Closes the file and frees the reader.  Does nothing if reader is NULL.
+ */
+void XLALLIGOLwXMLTableReaderClose(
+	LIGOLwXMLTableReader *reader
+)
+{
+	if(reader) {
+		if(reader->fp)
+			XLALFileClose(reader->fp);
+		LALFree(reader->buf);
+		LALFree(reader->project);
+		LALFree(reader->type);
+		LALFree(reader->row);
+		LALFree(reader->strbuf);
+		LALFree(reader->stroff);
+		LALFree(reader);
+	}
+}
+
+
+/**
+ * Returns the type in which the values of projected column column are
+ * returned, or -1 on failure.
+ */
+int XLALLIGOLwXMLTableReaderColumnType(
+	const LIGOLwXMLTableReader *reader,
+	size_t column
+)
+{
+	XLAL_CHECK(reader, XLAL_EFAULT);
+	XLAL_CHECK(column < reader->nproject, XLAL_EINVAL);
+	return reader->type[column];
+}
+
+
+/*
+ * finds the next value in the stream; buf[*begin, *end) is the value with
+ * surrounding white space removed.  returns 0 at the end of the stream.
+ */
+
+static int XLALLIGOLwXMLTableReaderToken(LIGOLwXMLTableReader *reader, size_t *begin, size_t *end)
+{
+	size_t i;
+	int quoted;
+
+	/* skip white space */
+	for(;;) {
+		while(reader->pos < reader->len && isspace((unsigned char) reader->buf[reader->pos]))
+			reader->pos++;
+		if(reader->pos < reader->len)
+			break;
+		if(XLALLIGOLwXMLTableReaderFill(reader) <= 0)
+			XLAL_ERROR(XLAL_EIO, "unexpected end of file in stream");
+	}
+	if(reader->buf[reader->pos] == '<')
+		return 0;
+
+	/* find the delimiter (or the end of the stream) that ends the value;
+	 * rescan if more of the file has to be read */
+	for(;;) {
+		quoted = 0;
+		for(i = reader->pos; i < reader->len; i++) {
+			char c = reader->buf[i];
+			if(quoted) {
+				if(c == '\\')
+					i++;
+				else if(c == '"')
+					quoted = 0;
+			} else if(c == '"')
+				quoted = 1;
+			else if(c == reader->delimiter || c == '<')
+				break;
+		}
+		if(i < reader->len)
+			break;
+		if(XLALLIGOLwXMLTableReaderFill(reader) <= 0)
+			XLAL_ERROR(XLAL_EIO, "unexpected end of file in stream");
+	}
+
+	*begin = reader->pos;
+	reader->pos = reader->buf[i] == '<' ? i : i + 1;
+	while(i > *begin && isspace((unsigned char) reader->buf[i - 1]))
+		i--;
+	*end = i;
+	return 1;
+}
+
+
+/*
+ * integers are parsed by hand; anything unusual is left to strtoll()
+ */
+
+static int XLALLIGOLwXMLParseInt(INT8 *value, char *s, char *end)
+{
+	char *p = s;
+	int neg = 0;
+	UINT8 u = 0;
+
+	if(p < end && (*p == '-' || *p == '+'))
+		neg = *p++ == '-';
+	if(p < end && end - p < 19) {
+		while(p < end && *p >= '0' && *p <= '9')
+			u = 10 * u + (*p++ - '0');
+		if(p == end) {
+			*value = neg ? -(INT8) u : (INT8) u;
+			return 0;
+		}
+	}
+
+	{
+		char save = *end;
+		char *e;
+		*end = '\0';
+		*value = strtoll(s, &e, 0);
+		*end = save;
+		if(e != end)
+			XLAL_ERROR(XLAL_EDATA, "invalid integer");
+	}
+	return 0;
+}
+
+
+static int XLALLIGOLwXMLParseReal(REAL8 *value, char *s, char *end)
+{
+	char save = *end;
+	char *e;
+	*end = '\0';
+	*value = strtod(s, &e);
+	*end = save;
+	if(e != end)
+		XLAL_ERROR(XLAL_EDATA, "invalid floating-point number");
+	return 0;
+}
+
+
+/*
+ * appends the unquoted, unescaped string s to the string storage of the
+ * row and returns its offset
+ */
+
+static long XLALLIGOLwXMLParseString(LIGOLwXMLTableReader *reader, size_t *used, const char *s, const char *end)
+{
+	static const struct {
+		const char *entity;
+		char c;
+	} entities[] = {{"&lt;", '<'}, {"&gt;", '>'}, {"&amp;", '&'}, {"&quot;", '"'}, {"&apos;", '\''}};
+	size_t offset = *used;
+	char *d;
+
+	if(end - s >= 2 && *s == '"' && end[-1] == '"') {
+		s++;
+		end--;
+	}
+
+	/* the string cannot get longer */
+	if(*used + (end - s) + 1 > reader->strsize) {
+		size_t size = 2 * (*used + (end - s) + 1);
+		char *strbuf = LALRealloc(reader->strbuf, size);
+		if(!strbuf)
+			XLAL_ERROR(XLAL_ENOMEM);
+		reader->strbuf = strbuf;
+		reader->strsize = size;
+	}
+
+	d = reader->strbuf + *used;
+	while(s < end) {
+		if(*s == '\\' && s + 1 < end) {
+			*d++ = s[1];
+			s += 2;
+		} else if(*s == '&') {
+			size_t i;
+			for(i = 0; i < sizeof(entities) / sizeof(*entities); i++) {
+				size_t n = strlen(entities[i].entity);
+				if((size_t) (end - s) >= n && !strncmp(s, entities[i].entity, n)) {
+					*d++ = entities[i].c;
+					s += n;
+					break;
+				}
+			}
+			if(i == sizeof(entities) / sizeof(*entities))
+				*d++ = *s++;
+		} else
+			*d++ = *s++;
+	}
+	*d++ = '\0';
+	*used = d - reader->strbuf;
+	return offset;
+}
+
+
+/**
+ * Reads the next row of the table.  On success *row points to an array
+ * holding the values of the projected columns in the order in which they
+ * were requested; the array and the strings it points to are valid until
+ * the next call.  Returns 1 if a row was read, 0 at the end of the table
+ * and < 0 on failure.
+ */
+int XLALLIGOLwXMLTableReaderNext(
+	LIGOLwXMLTableReader *reader,
+	const LIGOLwXMLValue **row
+)
+{
+	size_t used = 0;
+	size_t column;
+	size_t j;
+
+	XLAL_CHECK(reader, XLAL_EFAULT);
+	XLAL_CHECK(row, XLAL_EFAULT);
+
+	*row = NULL;
+	if(reader->done)
+		return 0;
+
+	for(column = 0; column < reader->ncolumn; column++) {
+		size_t begin, end;
+		int status = XLALLIGOLwXMLTableReaderToken(reader, &begin, &end);
+		int k = reader->project[column];
+
+		if(status < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		if(status == 0) {
+			if(column)
+				XLAL_ERROR(XLAL_EDATA, "incomplete row in stream");
+			reader->done = 1;
+			return 0;
+		}
+		if(k < 0)
+			continue;
+
+		switch(reader->type[k]) {
+		case LIGOLW_XML_TYPE_INT_8S:
+			if(begin == end)
+				reader->row[k].int_8s = 0;
+			else if(XLALLIGOLwXMLParseInt(&reader->row[k].int_8s, reader->buf + begin, reader->buf + end) < 0)
+				XLAL_ERROR(XLAL_EFUNC);
+			break;
+		case LIGOLW_XML_TYPE_REAL_8:
+			if(begin == end)
+				reader->row[k].real_8 = NAN;
+			else if(XLALLIGOLwXMLParseReal(&reader->row[k].real_8, reader->buf + begin, reader->buf + end) < 0)
+				XLAL_ERROR(XLAL_EFUNC);
+			break;
+		default:
+			if(begin == end)
+				reader->stroff[k] = (size_t) -1;
+			else {
+				long offset = XLALLIGOLwXMLParseString(reader, &used, reader->buf + begin, reader->buf + end);
+				if(offset < 0)
+					XLAL_ERROR(XLAL_EFUNC);
+				reader->stroff[k] = offset;
+			}
+			break;
+		}
+	}
+
+	/* the string storage may have moved while the row was read */
+	for(j = 0; j < reader->nproject; j++)
+		if(reader->type[j] == LIGOLW_XML_TYPE_LSTRING)
+			reader->row[j].lstring = reader->stroff[j] == (size_t) -1 ? NULL : reader->strbuf + reader->stroff[j];
+
+	*row = reader->row;
+	return 1;
+}
+
+
+/**
+ * Calls func for each of the remaining rows of the table, passing it the
+ * values of the projected columns as XLALLIGOLwXMLTableReaderNext() does,
+ * and data.  Stops early if func returns non-zero.  Returns the number of
+ * rows passed to func, or < 0 on failure.
+ */
+long XLALLIGOLwXMLTableReaderForEach(
+	LIGOLwXMLTableReader *reader,
+	int (*func)(const LIGOLwXMLValue *row, void *data),
+	void *data
+)
+{
+	const LIGOLwXMLValue *row;
+	long nrows = 0;
+	int status;
+
+	XLAL_CHECK(reader, XLAL_EFAULT);
+	XLAL_CHECK(func, XLAL_EFAULT);
+
+	while((status = XLALLIGOLwXMLTableReaderNext(reader, &row)) > 0) {
+		nrows++;
+		if(func(row, data))
+			break;
+	}
+	if(status < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return nrows;
+}
@@ -0,0 +1,412 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ * 02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalmetaio_general
+ *
+ * \brief Columnar tables of triggers.
+ *
+ * ### Description ###
+ *
+ * XLALTriggerTableFromSnglInspiral(), XLALTriggerTableFromSnglBurst() and
+ * XLALTriggerTableFromSimInspiral() make a \c LIGOTriggerTable from a
+ * linked list; the list is not modified.  The columns of the table are
+ * allocated together in one block.  XLALTriggerTableToSnglInspiral(),
+ * XLALTriggerTableToSnglBurst() and XLALTriggerTableToSimInspiral() link
+ * the rows of the table in the table's order and return the head of the
+ * new list;  the rows of the list the table was made from that are no
+ * longer in the table (e.g. because they were clustered away) are linked
+ * into a second list, returned in *discarded, for the caller to free.
+ *
+ * XLALTriggerTableSortByTime() sorts the table by time with a stable
+ * radix sort of the time column, and then reorders the columns one after
+ * another, so no row of the linked list is visited.
+ *
+ * XLALTriggerTableClusterByTime() keeps the loudest entry of each cluster.
+ * The table is walked in time order keeping the loudest entry of the
+ * current cluster;  an entry within window of it joins the cluster (and
+ * replaces it if louder), otherwise it starts a new cluster.
+ *
+ * XLALTriggerTableCoinc() finds the pairs of entries of two tables whose
+ * times differ by no more than window after each of the time-slide
+ * offsets has been added to the times of the second table.  Both tables
+ * are swept together in time order, so the cost is proportional to the
+ * number of entries plus the number of coincidences for each offset.
+ *
+ * ### Example ###
+ *
+ * \code
+ * LIGOTriggerTable *table = XLALTriggerTableFromSnglInspiral(head);
+ * SnglInspiralTable *discarded;
+ * XLALTriggerTableClusterByTime(table, 10 * XLAL_BILLION_INT8);
+ * head = XLALTriggerTableToSnglInspiral(table, head, &discarded);
+ * XLALDestroyTriggerTable(table);
+ * \endcode
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/Date.h>
+#include <lal/LALMalloc.h>
+#include <lal/LALStdlib.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOTriggerTable.h>
+#include <lal/XLALError.h>
+
+/*
+ * allocates a table of length entries, with the columns in one block
+ */
+
+static LIGOTriggerTable *XLALCreateTriggerTable(LIGOTriggerTableType type, size_t length)
+{
+	LIGOTriggerTable *table = LALCalloc(1, sizeof(*table));
+	if(!table)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	table->type = type;
+	table->length = length;
+	/* all the columns are 8 bytes wide, so they stay aligned */
+	table->arena = LALMalloc((length ? length : 1) * (sizeof(*table->time) + sizeof(*table->snr) + sizeof(*table->row)));
+	if(!table->arena) {
+		LALFree(table);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	table->time = table->arena;
+	table->snr = (REAL8 *) (table->time + length);
+	table->row = (void **) (table->snr + length);
+	return table;
+}
+
+
+/**
+ * Frees the table.  The rows of the linked list it was made from are not
+ * freed.  Does nothing if table is NULL.
+ */
+void XLALDestroyTriggerTable(LIGOTriggerTable *table)
+{
+	if(table) {
+		LALFree(table->arena);
+		LALFree(table);
+	}
+}
+
+
+/*
+ * sorting of the row pointers, for finding the rows that are no longer in
+ * a table
+ */
+
+static int XLALTriggerTableComparePointers(const void *a, const void *b)
+{
+	uintptr_t x = (uintptr_t) *(void *const *) a;
+	uintptr_t y = (uintptr_t) *(void *const *) b;
+	return x > y ? 1 : x < y ? -1 : 0;
+}
+
+
+static void **XLALTriggerTableSortedRows(const LIGOTriggerTable *table)
+{
+	void **rows = LALMalloc((table->length ? table->length : 1) * sizeof(*rows));
+	if(!rows)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	if(table->length) {
+		memcpy(rows, table->row, table->length * sizeof(*rows));
+		qsort(rows, table->length, sizeof(*rows), XLALTriggerTableComparePointers);
+	}
+	return rows;
+}
+
+
+/*
+ * conversions to and from the linked lists.  the three row types differ
+ * only in their names and in the columns that supply the time and the SNR.
+ */
+
+#define DEFINE_TRIGGER_TABLE_CONVERSIONS(TYPE, NAME, TABLETYPE, TIME, SNR) \
+LIGOTriggerTable *XLALTriggerTableFrom ## NAME(const TYPE *head) \
+{ \
+	LIGOTriggerTable *table; \
+	const TYPE *row; \
+	size_t length = 0; \
+	size_t i; \
+ \
+	for(row = head; row; row = row->next) \
+		length++; \
+	table = XLALCreateTriggerTable(TABLETYPE, length); \
+	if(!table) \
+		XLAL_ERROR_NULL(XLAL_EFUNC); \
+	for(row = head, i = 0; row; row = row->next, i++) { \
+		table->time[i] = XLALGPSToINT8NS(&row->TIME); \
+		table->snr[i] = SNR; \
+		table->row[i] = (void *) (uintptr_t) row; \
+	} \
+	return table; \
+} \
+ \
+TYPE *XLALTriggerTableTo ## NAME(const LIGOTriggerTable *table, TYPE *head, TYPE **discarded) \
+{ \
+	TYPE **tail; \
+	void **rows; \
+	size_t i; \
+ \
+	XLAL_CHECK_NULL(table, XLAL_EFAULT); \
+	XLAL_CHECK_NULL(discarded || !head, XLAL_EFAULT); \
+	XLAL_CHECK_NULL(table->type == TABLETYPE, XLAL_ETYPE, "trigger table does not hold " #TYPE " rows"); \
+ \
+	/* collect the rows of the old list that are not in the table */ \
+	if(head) { \
+		rows = XLALTriggerTableSortedRows(table); \
+		if(!rows) \
+			XLAL_ERROR_NULL(XLAL_EFUNC); \
+		*discarded = NULL; \
+		tail = discarded; \
+		while(head) { \
+			TYPE *next = head->next; \
+			void *key = head; \
+			if(!table->length || !bsearch(&key, rows, table->length, sizeof(*rows), XLALTriggerTableComparePointers)) { \
+				*tail = head; \
+				tail = &head->next; \
+			} \
+			head = next; \
+		} \
+		*tail = NULL; \
+		LALFree(rows); \
+	} else if(discarded) \
+		*discarded = NULL; \
+ \
+	/* link the rows of the table in order */ \
+	if(!table->length) \
+		return NULL; \
+	for(i = 1; i < table->length; i++) \
+		((TYPE *) table->row[i - 1])->next = table->row[i]; \
+	((TYPE *) table->row[table->length - 1])->next = NULL; \
+	return table->row[0]; \
+}
+
+/** \cond DONT_DOXYGEN */
+DEFINE_TRIGGER_TABLE_CONVERSIONS(SnglInspiralTable, SnglInspiral, LIGO_TRIGGER_TABLE_SNGL_INSPIRAL, end, row->snr)
+DEFINE_TRIGGER_TABLE_CONVERSIONS(SnglBurst, SnglBurst, LIGO_TRIGGER_TABLE_SNGL_BURST, peak_time, row->snr)
+DEFINE_TRIGGER_TABLE_CONVERSIONS(SimInspiralTable, SimInspiral, LIGO_TRIGGER_TABLE_SIM_INSPIRAL, geocent_end_time, 0)
+/** \endcond */
+
+#undef DEFINE_TRIGGER_TABLE_CONVERSIONS
+
+
+/*
+ * is the table in time order?
+ */
+
+static int XLALTriggerTableIsSorted(const LIGOTriggerTable *table)
+{
+	size_t i;
+	for(i = 1; i < table->length; i++)
+		if(table->time[i] < table->time[i - 1])
+			return 0;
+	return 1;
+}
+
+
+/**
+ * Sorts the table by time.  Entries with equal times keep their order.
+ * Returns 0 on success, < 0 on failure.
+ */
+int XLALTriggerTableSortByTime(LIGOTriggerTable *table)
+{
+	/* counts of each value of each of the 8 bytes of the keys */
+	size_t count[8][256];
+	UINT8 *key, *keytmp;
+	size_t *order, *ordertmp;
+	LIGOTriggerTable *sorted;
+	size_t n;
+	size_t i;
+	int byte;
+
+	XLAL_CHECK(table, XLAL_EFAULT);
+	n = table->length;
+	if(XLALTriggerTableIsSorted(table))
+		return 0;
+
+	key = LALMalloc(2 * n * sizeof(*key));
+	order = LALMalloc(2 * n * sizeof(*order));
+	sorted = XLALCreateTriggerTable(table->type, n);
+	if(!key || !order || !sorted) {
+		LALFree(key);
+		LALFree(order);
+		XLALDestroyTriggerTable(sorted);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+	keytmp = key + n;
+	ordertmp = order + n;
+
+	/* flipping the sign bit makes the unsigned order of the keys the
+	 * signed order of the times */
+	memset(count, 0, sizeof(count));
+	for(i = 0; i < n; i++) {
+		key[i] = (UINT8) table->time[i] ^ ((UINT8) 1 << 63);
+		order[i] = i;
+		for(byte = 0; byte < 8; byte++)
+			count[byte][(key[i] >> (8 * byte)) & 0xff]++;
+	}
+
+	/* least significant byte first;  bytes that are the same in all the
+	 * keys, usually the high bytes of GPS times, are skipped */
+	for(byte = 0; byte < 8; byte++) {
+		size_t offset[256];
+		size_t sum = 0;
+		unsigned b;
+		for(b = 0; b < 256; b++) {
+			offset[b] = sum;
+			sum += count[byte][b];
+		}
+		if(count[byte][(key[0] >> (8 * byte)) & 0xff] == n)
+			continue;
+		for(i = 0; i < n; i++) {
+			size_t j = offset[(key[i] >> (8 * byte)) & 0xff]++;
+			keytmp[j] = key[i];
+			ordertmp[j] = order[i];
+		}
+		{
+			UINT8 *k = key;
+			size_t *o = order;
+			key = keytmp;
+			keytmp = k;
+			order = ordertmp;
+			ordertmp = o;
+		}
+	}
+
+	/* reorder the columns */
+	for(i = 0; i < n; i++)
+		sorted->time[i] = table->time[order[i]];
+	for(i = 0; i < n; i++)
+		sorted->snr[i] = table->snr[order[i]];
+	for(i = 0; i < n; i++)
+		sorted->row[i] = table->row[order[i]];
+
+	/* key and order may point to either half of their blocks */
+	LALFree(key < keytmp ? key : keytmp);
+	LALFree(order < ordertmp ? order : ordertmp);
+
+	LALFree(table->arena);
+	*table = *sorted;
+	LALFree(sorted);
+
+	return 0;
+}
+
+
+/**
+ * Clusters the entries of the table by time, keeping the loudest (highest
+ * SNR) entry of each cluster.  An entry joins the current cluster if it is
+ * within window (in ns) of the cluster's loudest entry.  The table is
+ * sorted first if necessary.  Returns the new length of the table, or < 0
+ * on failure.
+ */
+long XLALTriggerTableClusterByTime(LIGOTriggerTable *table, INT8 window)
+{
+	size_t loudest = 0;
+	size_t i;
+
+	XLAL_CHECK(table, XLAL_EFAULT);
+	XLAL_CHECK(window >= 0, XLAL_EINVAL);
+	if(XLALTriggerTableSortByTime(table) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	if(!table->length)
+		return 0;
+
+	/* entries [0, loudest) are the loudest entries of the finished
+	 * clusters;  entry loudest is that of the current cluster */
+	for(i = 1; i < table->length; i++) {
+		if(table->time[i] - table->time[loudest] <= window) {
+			if(table->snr[i] > table->snr[loudest]) {
+				table->time[loudest] = table->time[i];
+				table->snr[loudest] = table->snr[i];
+				table->row[loudest] = table->row[i];
+			}
+		} else {
+			loudest++;
+			table->time[loudest] = table->time[i];
+			table->snr[loudest] = table->snr[i];
+			table->row[loudest] = table->row[i];
+		}
+	}
+	table->length = loudest + 1;
+
+	return table->length;
+}
+
+
+/**
+ * Finds the coincidences between the entries of tables a and b:  for each
+ * time-slide offset k, the pairs of entries i of a and j of b for which
+ * |a->time[i] - (b->time[j] + offsets[k])| <= window (times in ns).  Both
+ * tables must be sorted by time.  On success *coincs is set to a newly
+ * allocated array of the coincidences, in order of offset and then of the
+ * entries of a and b, which the caller must free with LALFree(), and the
+ * number of coincidences is returned.  Returns < 0 on failure.
+ */
+long XLALTriggerTableCoinc(LIGOTriggerCoinc **coincs, const LIGOTriggerTable *a, const LIGOTriggerTable *b, const INT8 *offsets, size_t noffsets, INT8 window)
+{
+	LIGOTriggerCoinc *list = NULL;
+	size_t size = 0;
+	size_t n = 0;
+	size_t k;
+
+	XLAL_CHECK(coincs, XLAL_EFAULT);
+	XLAL_CHECK(a, XLAL_EFAULT);
+	XLAL_CHECK(b, XLAL_EFAULT);
+	XLAL_CHECK(offsets || !noffsets, XLAL_EFAULT);
+	XLAL_CHECK(window >= 0, XLAL_EINVAL);
+	XLAL_CHECK(XLALTriggerTableIsSorted(a) && XLALTriggerTableIsSorted(b), XLAL_EINVAL, "trigger tables are not sorted by time");
+	XLAL_CHECK(a->length <= UINT32_MAX && b->length <= UINT32_MAX && noffsets <= UINT32_MAX, XLAL_EBADLEN);
+
+	*coincs = NULL;
+
+	for(k = 0; k < noffsets; k++) {
+		/* entries of b before first are too early for all the
+		 * remaining entries of a */
+		size_t first = 0;
+		size_t i;
+		for(i = 0; i < a->length; i++) {
+			INT8 start = a->time[i] - offsets[k] - window;
+			INT8 end = a->time[i] - offsets[k] + window;
+			size_t j;
+			while(first < b->length && b->time[first] < start)
+				first++;
+			for(j = first; j < b->length && b->time[j] <= end; j++) {
+				if(n == size) {
+					LIGOTriggerCoinc *grown = LALRealloc(list, (size ? 2 * size : 256) * sizeof(*list));
+					if(!grown) {
+						LALFree(list);
+						XLAL_ERROR(XLAL_ENOMEM);
+					}
+					list = grown;
+					size = size ? 2 * size : 256;
+				}
+				list[n].slide = k;
+				list[n].a = i;
+				list[n].b = j;
+				n++;
+			}
+		}
+	}
+
+	*coincs = list;
+	return n;
+}
@@ -0,0 +1,105 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ * 02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup lalmetaio_general
+ * \brief Columnar tables of triggers for sorting, clustering and
+ * coincidence.
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/LIGOTriggerTable.h>
+ * \endcode
+ *
+ * The trigger tables of \ref LIGOMetadataTables.h are linked lists with
+ * one allocation per row.  A \c LIGOTriggerTable holds the columns needed
+ * to sort, cluster and find coincidences between triggers (the time and the
+ * SNR) as contiguous arrays in a single allocation, together with a pointer
+ * to the row of the linked list each entry came from.  Tables are made from
+ * \c SnglInspiralTable, \c SnglBurst and \c SimInspiralTable lists, and the
+ * rows that remain in a table after it has been sorted or clustered can be
+ * linked back into a list in the table's order.
+ */
+
+#ifndef _LIGOTRIGGERTABLE_H
+#define _LIGOTRIGGERTABLE_H
+
+#include <stddef.h>
+#include <lal/LALAtomicDatatypes.h>
+#include <lal/LIGOMetadataTables.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/** The type of the rows a \c LIGOTriggerTable was made from */
+typedef enum tagLIGOTriggerTableType {
+	LIGO_TRIGGER_TABLE_SNGL_INSPIRAL,	/**< \c SnglInspiralTable rows */
+	LIGO_TRIGGER_TABLE_SNGL_BURST,	/**< \c SnglBurst rows */
+	LIGO_TRIGGER_TABLE_SIM_INSPIRAL	/**< \c SimInspiralTable rows */
+} LIGOTriggerTableType;
+
+/**
+ * A columnar table of triggers.  Entry i of the table is made of time[i],
+ * snr[i] and row[i]; the columns are snapshots of the rows taken when the
+ * table was made.
+ */
+typedef struct tagLIGOTriggerTable {
+	LIGOTriggerTableType type;	/**< type of the rows */
+	size_t length;	/**< number of entries */
+	INT8 *time;	/**< end time (\c SnglInspiralTable), peak time (\c SnglBurst) or geocentre end time (\c SimInspiralTable), in ns */
+	REAL8 *snr;	/**< SNR; 0 for \c SimInspiralTable */
+	void **row;	/**< the rows the entries were made from */
+	void *arena;	/**< private: the storage of the columns */
+} LIGOTriggerTable;
+
+/** A coincidence found by XLALTriggerTableCoinc() */
+typedef struct tagLIGOTriggerCoinc {
+	UINT4 slide;	/**< index of the time-slide offset */
+	UINT4 a;	/**< index of the entry in the first table */
+	UINT4 b;	/**< index of the entry in the second table */
+} LIGOTriggerCoinc;
+
+#ifndef SWIG   // exclude from SWIG interface
+
+LIGOTriggerTable *XLALTriggerTableFromSnglInspiral(const SnglInspiralTable *head);
+LIGOTriggerTable *XLALTriggerTableFromSnglBurst(const SnglBurst *head);
+LIGOTriggerTable *XLALTriggerTableFromSimInspiral(const SimInspiralTable *head);
+
+SnglInspiralTable *XLALTriggerTableToSnglInspiral(const LIGOTriggerTable *table, SnglInspiralTable *head, SnglInspiralTable **discarded);
+SnglBurst *XLALTriggerTableToSnglBurst(const LIGOTriggerTable *table, SnglBurst *head, SnglBurst **discarded);
+SimInspiralTable *XLALTriggerTableToSimInspiral(const LIGOTriggerTable *table, SimInspiralTable *head, SimInspiralTable **discarded);
+
+void XLALDestroyTriggerTable(LIGOTriggerTable *table);
+
+int XLALTriggerTableSortByTime(LIGOTriggerTable *table);
+long XLALTriggerTableClusterByTime(LIGOTriggerTable *table, INT8 window);
+long XLALTriggerTableCoinc(LIGOTriggerCoinc **coincs, const LIGOTriggerTable *a, const LIGOTriggerTable *b, const INT8 *offsets, size_t noffsets, INT8 window);
+
+#endif /* SWIG */
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _LIGOTRIGGERTABLE_H */
@@ -0,0 +1,324 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ * 02111-1307  USA
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/FileIO.h>
+#include <lal/LALStdlib.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOLwXMLRead.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOMetadataUtils.h>
+#include <lal/LogPrintf.h>
+#include <lal/XLALError.h>
+
+#define DOC_HEAD \
+	"<?xml version='1.0' encoding='utf-8'?>\n" \
+	"<!DOCTYPE LIGO_LW SYSTEM \"http://ldas-sw.ligo.caltech.edu/doc/ligolwAPI/html/ligolw_dtd.txt\">\n" \
+	"<LIGO_LW>\n"
+
+#define DOC_TAIL "</LIGO_LW>\n"
+
+/* a table with the same column names, which must be skipped */
+#define OTHER_TABLE \
+	"\t<Table Name=\"other:table\">\n" \
+	"\t\t<Column Name=\"other:name\" Type=\"lstring\"/>\n" \
+	"\t\t<Column Name=\"other:id\" Type=\"int_4s\"/>\n" \
+	"\t\t<Stream Name=\"other:table\" Type=\"Local\" Delimiter=\",\">\n" \
+	"\t\t\t\"wrong\",99\n" \
+	"\t\t</Stream>\n" \
+	"\t</Table>\n"
+
+#define TEST_COLUMNS \
+	"\t<Table Name=\"test:table\">\n" \
+	"\t\t<Column Name=\"test:id\" Type=\"int_4s\"/>\n" \
+	"\t\t<Column Name=\"test:time\" Type=\"int_8s\"/>\n" \
+	"\t\t<Column Name=\"test:snr\" Type=\"real_4\"/>\n" \
+	"\t\t<Column Name=\"test:name\" Type=\"lstring\"/>\n" \
+	"\t\t<Column Name=\"test:ifo\" Type=\"lstring\"/>\n" \
+	"\t\t<Column Name=\"process:process_id\" Type=\"ilwd:char\"/>\n" \
+	"\t\t<Stream Name=\"test:table\" Type=\"Local\" Delimiter=\",\">"
+
+/* quoted delimiters, escaped quotes and backslashes, entities, empty
+ * (null) values and values surrounded by white space */
+#define TEST_ROWS \
+	"\n\t\t\t0,1000000000,5.5,\"plain\",\"H1\",\"process:process_id:0\"," \
+	"\n\t\t\t1,-5,-1.25e-3,\"with \\\"quotes\\\", and a comma\",\"L1\",\"process:process_id:1\"," \
+	"\n\t\t\t2,7,,\"&lt;tag&gt; &amp; \\\\ back\",\"V1\",\"\"," \
+	"\n\t\t\t 3 , ,  3 ,,\"K1\",\"process:process_id:3\""
+
+#define TEST_TABLE TEST_COLUMNS TEST_ROWS "\n\t\t</Stream>\n\t</Table>\n"
+
+#define NROWS 4
+
+static const struct {
+	INT8 id;
+	INT8 time;
+	REAL8 snr;	/* NaN for null */
+	const char *name;	/* NULL for null */
+	const char *ifo;
+	const char *pid;
+} expected[NROWS] = {
+	{0, 1000000000, 5.5, "plain", "H1", "process:process_id:0"},
+	{1, -5, -1.25e-3, "with \"quotes\", and a comma", "L1", "process:process_id:1"},
+	{2, 7, NAN, "<tag> & \\ back", "V1", ""},
+	{3, 0, 3.0, NULL, "K1", "process:process_id:3"},
+};
+
+
+static int write_file(const char *path, const char *contents)
+{
+	int compression = strlen(path) > 3 && !strcmp(path + strlen(path) - 3, ".gz");
+	LALFILE *fp = XLALFileOpenWrite(path, compression);
+	XLAL_CHECK(fp, XLAL_EFUNC);
+	XLAL_CHECK(XLALFilePuts(contents, fp) >= 0, XLAL_EFUNC);
+	XLALFileClose(fp);
+	return 0;
+}
+
+
+static int same_string(const char *a, const char *b)
+{
+	return a == b || (a && b && !strcmp(a, b));
+}
+
+
+/* read the test table with columns projected in an order different from
+ * that of the file */
+static int test_projection(const char *path)
+{
+	static const char *const columns[] = {"name", "snr", "id", "process_id", "time"};
+	LIGOLwXMLTableReader *reader;
+	const LIGOLwXMLValue *row;
+	int nrows = 0;
+	int status;
+
+	reader = XLALLIGOLwXMLTableReaderOpen(path, "test:table", columns, 5);
+	XLAL_CHECK(reader, XLAL_EFUNC, "cannot open %s", path);
+	XLAL_CHECK(XLALLIGOLwXMLTableReaderColumnType(reader, 0) == LIGOLW_XML_TYPE_LSTRING, XLAL_EFAILED);
+	XLAL_CHECK(XLALLIGOLwXMLTableReaderColumnType(reader, 1) == LIGOLW_XML_TYPE_REAL_8, XLAL_EFAILED);
+	XLAL_CHECK(XLALLIGOLwXMLTableReaderColumnType(reader, 2) == LIGOLW_XML_TYPE_INT_8S, XLAL_EFAILED);
+	XLAL_CHECK(XLALLIGOLwXMLTableReaderColumnType(reader, 3) == LIGOLW_XML_TYPE_LSTRING, XLAL_EFAILED);
+	XLAL_CHECK(XLALLIGOLwXMLTableReaderColumnType(reader, 4) == LIGOLW_XML_TYPE_INT_8S, XLAL_EFAILED);
+
+	while((status = XLALLIGOLwXMLTableReaderNext(reader, &row)) > 0) {
+		XLAL_CHECK(nrows < NROWS, XLAL_EFAILED, "%s: too many rows", path);
+		XLAL_CHECK(same_string(row[0].lstring, expected[nrows].name), XLAL_EFAILED, "%s row %d: name \"%s\"", path, nrows, row[0].lstring ? row[0].lstring : "(null)");
+		XLAL_CHECK(isnan(expected[nrows].snr) ? isnan(row[1].real_8) : row[1].real_8 == expected[nrows].snr, XLAL_EFAILED, "%s row %d: snr %g", path, nrows, row[1].real_8);
+		XLAL_CHECK(row[2].int_8s == expected[nrows].id, XLAL_EFAILED, "%s row %d: id %lld", path, nrows, (long long) row[2].int_8s);
+		XLAL_CHECK(same_string(row[3].lstring, expected[nrows].pid), XLAL_EFAILED, "%s row %d: process_id \"%s\"", path, nrows, row[3].lstring ? row[3].lstring : "(null)");
+		XLAL_CHECK(row[4].int_8s == expected[nrows].time, XLAL_EFAILED, "%s row %d: time %lld", path, nrows, (long long) row[4].int_8s);
+		nrows++;
+	}
+	XLAL_CHECK(status == 0, XLAL_EFUNC, "%s: read failed", path);
+	XLAL_CHECK(nrows == NROWS, XLAL_EFAILED, "%s: read %d rows, expected %d", path, nrows, NROWS);
+	/* stays at the end of the table */
+	XLAL_CHECK(XLALLIGOLwXMLTableReaderNext(reader, &row) == 0 && row == NULL, XLAL_EFAILED);
+	XLALLIGOLwXMLTableReaderClose(reader);
+	return 0;
+}
+
+
+static int count_ifo(const LIGOLwXMLValue *row, void *data)
+{
+	int *count = data;
+	XLAL_CHECK(same_string(row[0].lstring, expected[*count].ifo), XLAL_EFAILED, "row %d: ifo \"%s\"", *count, row[0].lstring);
+	return ++*count == 2;
+}
+
+
+/* a single column, and stopping the callback early */
+static int test_for_each(const char *path)
+{
+	static const char *const columns[] = {"test:ifo"};
+	LIGOLwXMLTableReader *reader;
+	int count = 0;
+	long n;
+
+	reader = XLALLIGOLwXMLTableReaderOpen(path, "test", columns, 1);
+	XLAL_CHECK(reader, XLAL_EFUNC);
+	n = XLALLIGOLwXMLTableReaderForEach(reader, count_ifo, &count);
+	XLAL_CHECK(n == 2 && count == 2, XLAL_EFAILED, "callback stopped after %ld rows", n);
+	n = XLALLIGOLwXMLTableReaderForEach(reader, count_ifo, &count);
+	XLAL_CHECK(n == 2 && count == 4, XLAL_EFAILED, "callback read %ld more rows", n);
+	XLALLIGOLwXMLTableReaderClose(reader);
+	return 0;
+}
+
+
+/* documents the reader must reject, either when opened or when read */
+static int test_malformed(const char *path)
+{
+	static const char *const columns[] = {"id", "name"};
+	static const char *const all_columns[] = {"id", "name", "snr"};
+	static const char *const missing[] = {"id", "no_such_column"};
+	static const char *const bad_open[] = {
+		/* no such table */
+		DOC_HEAD OTHER_TABLE DOC_TAIL,
+		/* document ends inside the table header */
+		DOC_HEAD "\t<Table Name=\"test:table\">\n\t\t<Column Name=\"test:id\" Type=\"int_4s\"/>\n",
+		/* unnamed column */
+		DOC_HEAD "\t<Table Name=\"test:table\">\n\t\t<Column Type=\"int_4s\"/>\n\t\t<Stream Name=\"test:table\" Type=\"Local\" Delimiter=\",\">\n\t\t</Stream>\n\t</Table>\n" DOC_TAIL,
+	};
+	static const char *const bad_rows[] = {
+		/* stream ends in the middle of a row */
+		DOC_HEAD TEST_COLUMNS "\n\t\t\t0,1,2.0,\"a\"\n\t\t</Stream>\n\t</Table>\n" DOC_TAIL,
+		/* invalid integer */
+		DOC_HEAD TEST_COLUMNS "\n\t\t\t0x1g,1,2.0,\"a\",\"H1\",\"p\"\n\t\t</Stream>\n\t</Table>\n" DOC_TAIL,
+		/* invalid real */
+		DOC_HEAD TEST_COLUMNS "\n\t\t\t0,1,2.0.0,\"a\",\"H1\",\"p\"\n\t\t</Stream>\n\t</Table>\n" DOC_TAIL,
+		/* file truncated in the stream */
+		DOC_HEAD TEST_COLUMNS "\n\t\t\t0,1,2.0,\"a\",\"H1\",\"p\",\n\t\t\t1,2,3.0,\"unterminated",
+	};
+	LIGOLwXMLTableReader *reader;
+	const LIGOLwXMLValue *row;
+	size_t i;
+	int status;
+	int errnum;
+
+	/* missing file and missing column */
+	XLAL_TRY_SILENT(reader = XLALLIGOLwXMLTableReaderOpen("no_such_file.xml", "test", columns, 2), status);
+	XLAL_CHECK(!reader && status, XLAL_EFAILED, "opened a missing file");
+	XLAL_CHECK(write_file(path, DOC_HEAD TEST_TABLE DOC_TAIL) == 0, XLAL_EFUNC);
+	XLAL_TRY_SILENT(reader = XLALLIGOLwXMLTableReaderOpen(path, "test", missing, 2), status);
+	XLAL_CHECK(!reader && status, XLAL_EFAILED, "opened a table with a missing column");
+
+	for(i = 0; i < sizeof(bad_open) / sizeof(*bad_open); i++) {
+		XLAL_CHECK(write_file(path, bad_open[i]) == 0, XLAL_EFUNC);
+		XLAL_TRY_SILENT(reader = XLALLIGOLwXMLTableReaderOpen(path, "test", columns, 2), status);
+		XLAL_CHECK(!reader && status, XLAL_EFAILED, "malformed document %zu was opened", i);
+	}
+
+	for(i = 0; i < sizeof(bad_rows) / sizeof(*bad_rows); i++) {
+		XLAL_CHECK(write_file(path, bad_rows[i]) == 0, XLAL_EFUNC);
+		reader = XLALLIGOLwXMLTableReaderOpen(path, "test", all_columns, 3);
+		XLAL_CHECK(reader, XLAL_EFUNC, "cannot open document %zu", i);
+		do
+			XLAL_TRY_SILENT(status = XLALLIGOLwXMLTableReaderNext(reader, &row), errnum);
+		while(status > 0);
+		XLAL_CHECK(status < 0 && errnum, XLAL_EFAILED, "malformed rows %zu were read", i);
+		XLALLIGOLwXMLTableReaderClose(reader);
+	}
+
+	/* an empty stream has no rows */
+	XLAL_CHECK(write_file(path, DOC_HEAD TEST_COLUMNS "\n\t\t</Stream>\n\t</Table>\n" DOC_TAIL) == 0, XLAL_EFUNC);
+	reader = XLALLIGOLwXMLTableReaderOpen(path, "test", columns, 2);
+	XLAL_CHECK(reader, XLAL_EFUNC);
+	XLAL_CHECK(XLALLIGOLwXMLTableReaderNext(reader, &row) == 0, XLAL_EFAILED, "rows read from an empty stream");
+	XLALLIGOLwXMLTableReaderClose(reader);
+
+	return 0;
+}
+
+
+struct bench_data {
+	const ProcessParamsTable *row;
+	long mismatches;
+};
+
+
+static int compare_param(const LIGOLwXMLValue *row, void *data)
+{
+	struct bench_data *bench = data;
+	if(!bench->row || strcmp(row[0].lstring, bench->row->param) || strcmp(row[1].lstring, bench->row->value))
+		bench->mismatches++;
+	if(bench->row)
+		bench->row = bench->row->next;
+	return 0;
+}
+
+
+/* read a large gzip-compressed process_params table with the existing
+ * reader and with the streaming reader, and compare */
+static int test_benchmark(const char *path, int nrows)
+{
+	static const char *const columns[] = {"param", "value"};
+	ProcessParamsTable *head = NULL, **next = &head, *table;
+	LIGOLwXMLStream *xml;
+	LIGOLwXMLTableReader *reader;
+	struct bench_data bench;
+	REAL8 t0, t1, t2;
+	long n;
+	int i;
+
+	for(i = 0; i < nrows; i++) {
+		*next = XLALCreateProcessParamsTableRow(NULL);
+		XLAL_CHECK(*next, XLAL_EFUNC);
+		snprintf((*next)->program, sizeof((*next)->program), "bench");
+		snprintf((*next)->param, sizeof((*next)->param), "--param-%d", i);
+		snprintf((*next)->type, sizeof((*next)->type), "lstring");
+		snprintf((*next)->value, sizeof((*next)->value), "value \"%d\", %g", i, i * 0.5);
+		next = &(*next)->next;
+	}
+	xml = XLALOpenLIGOLwXMLFile(path);
+	XLAL_CHECK(xml, XLAL_EFUNC);
+	XLAL_CHECK(XLALWriteLIGOLwXMLProcessParamsTable(xml, head) == 0, XLAL_EFUNC);
+	XLAL_CHECK(XLALCloseLIGOLwXMLFile(xml) == 0, XLAL_EFUNC);
+
+	t0 = XLALGetTimeOfDay();
+	table = XLALProcessParamsTableFromLIGOLw(path);
+	t1 = XLALGetTimeOfDay();
+	XLAL_CHECK(table, XLAL_EFUNC);
+	XLAL_CHECK(XLALCountProcessParamsTable(table) == nrows, XLAL_EFAILED);
+
+	bench.row = table;
+	bench.mismatches = 0;
+	reader = XLALLIGOLwXMLTableReaderOpen(path, "process_params", columns, 2);
+	XLAL_CHECK(reader, XLAL_EFUNC);
+	n = XLALLIGOLwXMLTableReaderForEach(reader, compare_param, &bench);
+	XLALLIGOLwXMLTableReaderClose(reader);
+	t2 = XLALGetTimeOfDay();
+	XLAL_CHECK(n == nrows, XLAL_EFAILED, "streaming reader read %ld rows, expected %d", n, nrows);
+	XLAL_CHECK(bench.mismatches == 0, XLAL_EFAILED, "%ld rows differ from XLALProcessParamsTableFromLIGOLw()", bench.mismatches);
+
+	printf("%d gzip-compressed process_params rows: XLALProcessParamsTableFromLIGOLw() %.3f s, streaming reader (2 columns) %.3f s\n", nrows, t1 - t0, t2 - t1);
+
+	XLALDestroyProcessParamsTable(table);
+	XLALDestroyProcessParamsTable(head);
+	return 0;
+}
+
+
+int main(void)
+{
+	const char *plain = "LIGOLwXMLStreamReadTest.xml";
+	const char *gzipped = "LIGOLwXMLStreamReadTest.xml.gz";
+	const char *bad = "LIGOLwXMLStreamReadTest_bad.xml";
+	const char *bench = "LIGOLwXMLStreamReadTest_bench.xml.gz";
+
+	/* the same document, plain and gzip-compressed */
+	XLAL_CHECK_MAIN(write_file(plain, DOC_HEAD OTHER_TABLE TEST_TABLE DOC_TAIL) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(write_file(gzipped, DOC_HEAD OTHER_TABLE TEST_TABLE DOC_TAIL) == 0, XLAL_EFUNC);
+
+	XLAL_CHECK_MAIN(test_projection(plain) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_projection(gzipped) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_for_each(plain) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_for_each(gzipped) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_malformed(bad) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_benchmark(bench, 100000) == 0, XLAL_EFUNC);
+
+	remove(plain);
+	remove(gzipped);
+	remove(bad);
+	remove(bench);
+
+	LALCheckMemoryLeaks();
+	return 0;
+}
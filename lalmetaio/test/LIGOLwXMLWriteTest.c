@@ -0,0 +1,367 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ * 02111-1307  USA
+ */
+
+/*
+ * Writes the same tables serially, with the rows formatted in parallel,
+ * gzip-compressed, and with the parallel gzip writer, and checks that all
+ * of them hold the same document, that the parallel gzip file is made of
+ * several gzip members, and that its tables can be read back.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#include <lal/Date.h>
+#include <lal/FileIO.h>
+#include <lal/LALStdlib.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOLwXMLRead.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOMetadataUtils.h>
+#include <lal/XLALError.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define SERIAL "LIGOLwXMLWriteTest_serial.xml"
+#define THREADED "LIGOLwXMLWriteTest_threaded.xml"
+#define GZIPPED "LIGOLwXMLWriteTest_serial.xml.gz"
+#define PARALLEL "LIGOLwXMLWriteTest_parallel.xml.gz"
+#define SMALL "LIGOLwXMLWriteTest_small.xml"
+#define SMALL_PARALLEL "LIGOLwXMLWriteTest_small.xml.gz"
+
+/* enough rows for several chunks and several 1 MiB gzip members */
+#define N_PARAMS 3000
+#define N_SNGL_BURST 20011
+#define N_SNGL_INSPIRAL 4001
+#define N_SIM_BURST 2003
+
+
+struct tables {
+	ProcessTable *process;
+	ProcessParamsTable *process_params;
+	SnglBurst *sngl_burst;
+	SnglInspiralTable *sngl_inspiral;
+	SimBurst *sim_burst;
+};
+
+
+/* reproducible values with a mix of magnitudes and signs */
+static double value(int i, int k)
+{
+	return ((i * 2654435761u + k * 40503u) % 1000003 - 500000) * (k % 2 ? 1.25e-7 : 3.5e3);
+}
+
+
+static int make_tables(struct tables *t, int full)
+{
+	SnglBurst **sngl_burst = &t->sngl_burst;
+	SnglInspiralTable **sngl_inspiral = &t->sngl_inspiral;
+	SimBurst **sim_burst = &t->sim_burst;
+	ProcessParamsTable **param = &t->process_params;
+	int i;
+
+	memset(t, 0, sizeof(*t));
+	t->process = XLALCreateProcessTableRow();
+	XLAL_CHECK(t->process, XLAL_EFUNC);
+	snprintf(t->process->program, sizeof(t->process->program), "LIGOLwXMLWriteTest");
+	snprintf(t->process->comment, sizeof(t->process->comment), "quotes \" and <tags> & ampersands");
+	if(!full)
+		return 0;
+
+	for(i = 0; i < N_PARAMS; i++) {
+		*param = XLALCreateProcessParamsTableRow(t->process);
+		XLAL_CHECK(*param, XLAL_EFUNC);
+		snprintf((*param)->param, sizeof((*param)->param), "--param-%d", i);
+		snprintf((*param)->type, sizeof((*param)->type), "real_8");
+		snprintf((*param)->value, sizeof((*param)->value), "%.17g", value(i, 0));
+		param = &(*param)->next;
+	}
+
+	for(i = 0; i < N_SNGL_BURST; i++) {
+		*sngl_burst = LALCalloc(1, sizeof(**sngl_burst));
+		XLAL_CHECK(*sngl_burst, XLAL_ENOMEM);
+		snprintf((*sngl_burst)->ifo, sizeof((*sngl_burst)->ifo), "%s", i % 3 ? "H1" : "L1");
+		snprintf((*sngl_burst)->search, sizeof((*sngl_burst)->search), "excesspower");
+		snprintf((*sngl_burst)->channel, sizeof((*sngl_burst)->channel), "GDS-CALIB_STRAIN_%d", i % 7);
+		XLALGPSSet(&(*sngl_burst)->start_time, 1000000000 + i, (i * 7919LL) % 1000000000);
+		XLALGPSSet(&(*sngl_burst)->peak_time, 1000000000 + i, (i * 104729LL) % 1000000000);
+		(*sngl_burst)->duration = value(i, 1);
+		(*sngl_burst)->central_freq = value(i, 2);
+		(*sngl_burst)->bandwidth = value(i, 3);
+		(*sngl_burst)->amplitude = value(i, 5);
+		(*sngl_burst)->snr = value(i, 6);
+		(*sngl_burst)->confidence = value(i, 7);
+		(*sngl_burst)->chisq = value(i, 8);
+		(*sngl_burst)->chisq_dof = value(i, 9);
+		(*sngl_burst)->event_id = i;
+		sngl_burst = &(*sngl_burst)->next;
+	}
+
+	for(i = 0; i < N_SNGL_INSPIRAL; i++) {
+		int k;
+		*sngl_inspiral = LALCalloc(1, sizeof(**sngl_inspiral));
+		XLAL_CHECK(*sngl_inspiral, XLAL_ENOMEM);
+		snprintf((*sngl_inspiral)->ifo, sizeof((*sngl_inspiral)->ifo), "V1");
+		snprintf((*sngl_inspiral)->search, sizeof((*sngl_inspiral)->search), "FindChirp");
+		XLALGPSSet(&(*sngl_inspiral)->end, 1100000000 + i, (i * 15485863LL) % 1000000000);
+		(*sngl_inspiral)->end_time_gmst = value(i, 10);
+		(*sngl_inspiral)->template_duration = value(i, 11);
+		(*sngl_inspiral)->mass1 = value(i, 12);
+		(*sngl_inspiral)->mass2 = value(i, 13);
+		(*sngl_inspiral)->snr = value(i, 14);
+		(*sngl_inspiral)->chisq_dof = i % 17;
+		(*sngl_inspiral)->sigmasq = value(i, 15);
+		for(k = 0; k < 10; k++)
+			(*sngl_inspiral)->Gamma[k] = value(i, 16 + k);
+		(*sngl_inspiral)->spin1z = value(i, 27);
+		(*sngl_inspiral)->event_id = i;
+		sngl_inspiral = &(*sngl_inspiral)->next;
+	}
+
+	for(i = 0; i < N_SIM_BURST; i++) {
+		*sim_burst = LALCalloc(1, sizeof(**sim_burst));
+		XLAL_CHECK(*sim_burst, XLAL_ENOMEM);
+		snprintf((*sim_burst)->waveform, sizeof((*sim_burst)->waveform), "SineGaussian");
+		XLALGPSSet(&(*sim_burst)->time_geocent_gps, 1200000000 + i, (i * 32452843LL) % 1000000000);
+		(*sim_burst)->ra = value(i, 30);
+		(*sim_burst)->dec = value(i, 31);
+		(*sim_burst)->frequency = value(i, 32);
+		(*sim_burst)->q = value(i, 33);
+		(*sim_burst)->hrss = value(i, 34);
+		(*sim_burst)->simulation_id = i;
+		sim_burst = &(*sim_burst)->next;
+	}
+
+	return 0;
+}
+
+
+static void destroy_tables(struct tables *t)
+{
+	while(t->sngl_burst) {
+		SnglBurst *next = t->sngl_burst->next;
+		LALFree(t->sngl_burst);
+		t->sngl_burst = next;
+	}
+	while(t->sngl_inspiral) {
+		SnglInspiralTable *next = t->sngl_inspiral->next;
+		LALFree(t->sngl_inspiral);
+		t->sngl_inspiral = next;
+	}
+	while(t->sim_burst) {
+		SimBurst *next = t->sim_burst->next;
+		LALFree(t->sim_burst);
+		t->sim_burst = next;
+	}
+	XLALDestroyProcessParamsTable(t->process_params);
+	XLALDestroyProcessTable(t->process);
+}
+
+
+static int write_tables(LIGOLwXMLStream *xml, const struct tables *t)
+{
+	XLAL_CHECK(xml, XLAL_EFUNC);
+	XLAL_CHECK(XLALWriteLIGOLwXMLProcessTable(xml, t->process) == 0, XLAL_EFUNC);
+	if(t->process_params)
+		XLAL_CHECK(XLALWriteLIGOLwXMLProcessParamsTable(xml, t->process_params) == 0, XLAL_EFUNC);
+	if(t->sngl_burst)
+		XLAL_CHECK(XLALWriteLIGOLwXMLSnglBurstTable(xml, t->sngl_burst) == 0, XLAL_EFUNC);
+	if(t->sngl_inspiral)
+		XLAL_CHECK(XLALWriteLIGOLwXMLSnglInspiralTable(xml, t->sngl_inspiral) == 0, XLAL_EFUNC);
+	if(t->sim_burst)
+		XLAL_CHECK(XLALWriteLIGOLwXMLSimBurstTable(xml, t->sim_burst) == 0, XLAL_EFUNC);
+	XLAL_CHECK(XLALCloseLIGOLwXMLFile(xml) == 0, XLAL_EFUNC);
+	return 0;
+}
+
+
+/* the (decompressed) contents of a file */
+static char *read_file(const char *path, size_t *size)
+{
+	LALFILE *fp;
+	char *buf = NULL;
+	size_t nalloc = 0;
+	size_t n;
+
+	*size = 0;
+	fp = XLALFileOpenRead(path);
+	XLAL_CHECK_NULL(fp, XLAL_EFUNC);
+	do {
+		if(*size == nalloc) {
+			nalloc = nalloc ? 2 * nalloc : 1048576;
+			buf = LALRealloc(buf, nalloc);
+			XLAL_CHECK_NULL(buf, XLAL_ENOMEM);
+		}
+		n = XLALFileRead(buf + *size, 1, nalloc - *size, fp);
+		*size += n;
+	} while(n > 0);
+	XLALFileClose(fp);
+	return buf;
+}
+
+
+static int compare_files(const char *path1, const char *path2)
+{
+	size_t size1, size2, i;
+	char *buf1, *buf2;
+
+	buf1 = read_file(path1, &size1);
+	XLAL_CHECK(buf1, XLAL_EFUNC);
+	buf2 = read_file(path2, &size2);
+	XLAL_CHECK(buf2, XLAL_EFUNC);
+	for(i = 0; i < size1 && i < size2 && buf1[i] == buf2[i]; i++);
+	XLAL_CHECK(size1 == size2 && i == size1, XLAL_EFAILED, "%s (%zu bytes) and %s (%zu bytes) differ at byte %zu", path1, size1, path2, size2, i);
+	LALFree(buf1);
+	LALFree(buf2);
+	return 0;
+}
+
+
+/* number of gzip members in a file, found by decompressing them one at a
+ * time with zlib */
+static int count_gzip_members(const char *path)
+{
+	static unsigned char in[65536], out[65536];
+	z_stream strm;
+	FILE *fp;
+	int members = 0;
+	int ret = Z_OK;
+
+	fp = fopen(path, "rb");
+	XLAL_CHECK(fp, XLAL_EIO, "cannot open %s", path);
+	memset(&strm, 0, sizeof(strm));
+	XLAL_CHECK(inflateInit2(&strm, 16 + MAX_WBITS) == Z_OK, XLAL_EFAILED);
+	for(;;) {
+		if(strm.avail_in == 0) {
+			strm.avail_in = fread(in, 1, sizeof(in), fp);
+			strm.next_in = in;
+			if(strm.avail_in == 0)
+				break;
+		}
+		strm.next_out = out;
+		strm.avail_out = sizeof(out);
+		ret = inflate(&strm, Z_NO_FLUSH);
+		if(ret == Z_STREAM_END) {
+			members++;
+			inflateReset(&strm);
+		} else if(ret != Z_OK)
+			break;
+	}
+	inflateEnd(&strm);
+	fclose(fp);
+	XLAL_CHECK(ret == Z_OK || ret == Z_STREAM_END, XLAL_EFAILED, "%s: corrupt gzip member %d", path, members + 1);
+	return members;
+}
+
+
+/* the process_params table read back from a file is the one written */
+static int check_process_params(const char *path, const ProcessParamsTable *written)
+{
+	ProcessParamsTable *table, *row;
+
+	table = XLALProcessParamsTableFromLIGOLw(path);
+	XLAL_CHECK(table, XLAL_EFUNC);
+	for(row = table; row && written; row = row->next, written = written->next)
+		XLAL_CHECK(!strcmp(row->param, written->param) && !strcmp(row->value, written->value), XLAL_EFAILED, "%s: process_params %s = %s read back as %s = %s", path, written->param, written->value, row->param, row->value);
+	XLAL_CHECK(!row && !written, XLAL_EFAILED, "%s: wrong number of process_params rows", path);
+	XLALDestroyProcessParamsTable(table);
+	return 0;
+}
+
+
+/* the sngl_burst table read back from a file with the streaming reader */
+static int check_sngl_burst(const char *path, const SnglBurst *written)
+{
+	static const char *const columns[] = {"event_id", "peak_time", "peak_time_ns", "chisq", "channel"};
+	LIGOLwXMLTableReader *reader;
+	const LIGOLwXMLValue *row;
+	long n = 0;
+	int r;
+	char buf[32];
+
+	reader = XLALLIGOLwXMLTableReaderOpen(path, "sngl_burst", columns, 5);
+	XLAL_CHECK(reader, XLAL_EFUNC);
+	while((r = XLALLIGOLwXMLTableReaderNext(reader, &row)) > 0 && written) {
+		XLAL_CHECK(row[0].int_8s == written->event_id && row[1].int_8s == written->peak_time.gpsSeconds && row[2].int_8s == written->peak_time.gpsNanoSeconds, XLAL_EFAILED, "%s: sngl_burst row %ld is wrong", path, n);
+		/* chisq is written with 16 significant digits */
+		snprintf(buf, sizeof(buf), "%.16g", written->chisq);
+		XLAL_CHECK(row[3].real_8 == strtod(buf, NULL), XLAL_EFAILED, "%s: sngl_burst row %ld: chisq %s read back as %.17g", path, n, buf, row[3].real_8);
+		XLAL_CHECK(!strcmp(row[4].lstring, written->channel), XLAL_EFAILED, "%s: sngl_burst row %ld: channel %s read back as %s", path, n, written->channel, row[4].lstring);
+		written = written->next;
+		n++;
+	}
+	XLALLIGOLwXMLTableReaderClose(reader);
+	XLAL_CHECK(r == 0 && !written, XLAL_EFAILED, "%s: read %ld sngl_burst rows", path, n);
+	return 0;
+}
+
+
+int main(void)
+{
+	struct tables t;
+	int members;
+
+	/* a document with only a short table */
+	XLAL_CHECK_MAIN(make_tables(&t, 0) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(write_tables(XLALOpenLIGOLwXMLFile(SMALL), &t) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(write_tables(XLALOpenLIGOLwXMLFileParallel(SMALL_PARALLEL), &t) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(compare_files(SMALL, SMALL_PARALLEL) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(count_gzip_members(SMALL_PARALLEL) == 1, XLAL_EFAILED, "short document is not one gzip member");
+	destroy_tables(&t);
+
+	XLAL_CHECK_MAIN(make_tables(&t, 1) == 0, XLAL_EFUNC);
+
+	/* rows formatted by one thread and by several */
+#ifdef _OPENMP
+	omp_set_num_threads(1);
+#endif
+	XLAL_CHECK_MAIN(write_tables(XLALOpenLIGOLwXMLFile(SERIAL), &t) == 0, XLAL_EFUNC);
+#ifdef _OPENMP
+	omp_set_num_threads(4);
+#endif
+	XLAL_CHECK_MAIN(write_tables(XLALOpenLIGOLwXMLFile(THREADED), &t) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(compare_files(SERIAL, THREADED) == 0, XLAL_EFUNC);
+
+	/* compressed by the file layer and by the parallel gzip writer */
+	XLAL_CHECK_MAIN(write_tables(XLALOpenLIGOLwXMLFile(GZIPPED), &t) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(compare_files(SERIAL, GZIPPED) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(write_tables(XLALOpenLIGOLwXMLFileParallel(PARALLEL), &t) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(compare_files(SERIAL, PARALLEL) == 0, XLAL_EFUNC);
+	members = count_gzip_members(PARALLEL);
+	XLAL_CHECK_MAIN(members > 1, XLAL_EFAILED, "%s has %d gzip members", PARALLEL, members);
+
+	/* the multi-member file reads back */
+	XLAL_CHECK_MAIN(check_process_params(PARALLEL, t.process_params) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(check_sngl_burst(PARALLEL, t.sngl_burst) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(check_sngl_burst(SERIAL, t.sngl_burst) == 0, XLAL_EFUNC);
+
+	destroy_tables(&t);
+
+	remove(SERIAL);
+	remove(THREADED);
+	remove(GZIPPED);
+	remove(PARALLEL);
+	remove(SMALL);
+	remove(SMALL_PARALLEL);
+
+	LALCheckMemoryLeaks();
+	return 0;
+}
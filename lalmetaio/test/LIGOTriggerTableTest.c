@@ -0,0 +1,303 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with with program; see the file COPYING. If not, write to the Free
+ * Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ * 02111-1307  USA
+ */
+
+/*
+ * Makes trigger tables from lists of random triggers and checks that
+ * sorting them agrees with a stable qsort(), that clustering them agrees
+ * with a direct implementation of the clustering rule, that the
+ * coincidences between two tables agree with a search of all the pairs,
+ * and that the rows are linked back into lists correctly.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/Date.h>
+#include <lal/LALStdlib.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOTriggerTable.h>
+#include <lal/XLALError.h>
+
+
+struct entry {
+	INT8 time;
+	REAL8 snr;
+	void *row;
+	size_t index;
+};
+
+
+static int compare_entries(const void *a, const void *b)
+{
+	const struct entry *x = a;
+	const struct entry *y = b;
+	if(x->time != y->time)
+		return x->time > y->time ? 1 : -1;
+	return x->index > y->index ? 1 : x->index < y->index ? -1 : 0;
+}
+
+
+static INT8 random_int8(INT8 range)
+{
+	UINT8 r = ((UINT8) rand() << 42) ^ ((UINT8) rand() << 21) ^ (UINT8) rand();
+	return (INT8) (r % (UINT8) range);
+}
+
+
+/*
+ * a list of n triggers in random order.  the times are start plus a
+ * multiple of step less than range, so there are ties when step is large,
+ * and the SNRs take few values so that they tie too
+ */
+
+static SnglBurst *make_triggers(size_t n, INT8 start, INT8 range, INT8 step)
+{
+	SnglBurst *head = NULL;
+	SnglBurst **next = &head;
+	size_t i;
+
+	for(i = 0; i < n; i++) {
+		*next = LALCalloc(1, sizeof(**next));
+		XLAL_CHECK_NULL(*next, XLAL_ENOMEM);
+		XLALINT8NSToGPS(&(*next)->peak_time, start + random_int8(range / step) * step);
+		(*next)->snr = 5 + rand() % 20;
+		(*next)->event_id = i;
+		next = &(*next)->next;
+	}
+
+	return head;
+}
+
+
+static void destroy_triggers(SnglBurst *head)
+{
+	while(head) {
+		SnglBurst *next = head->next;
+		LALFree(head);
+		head = next;
+	}
+}
+
+
+/*
+ * the entries of the list, in the order of the table when it has been
+ * sorted by time
+ */
+
+static struct entry *sorted_entries(SnglBurst *head, size_t n)
+{
+	struct entry *entries = LALMalloc((n ? n : 1) * sizeof(*entries));
+	size_t i;
+
+	XLAL_CHECK_NULL(entries, XLAL_ENOMEM);
+	for(i = 0; i < n; i++, head = head->next) {
+		entries[i].time = XLALGPSToINT8NS(&head->peak_time);
+		entries[i].snr = head->snr;
+		entries[i].row = head;
+		entries[i].index = i;
+	}
+	qsort(entries, n, sizeof(*entries), compare_entries);
+
+	return entries;
+}
+
+
+static int check_table(const LIGOTriggerTable *table, const struct entry *entries, size_t n, const char *what)
+{
+	size_t i;
+
+	XLAL_CHECK(table->length == n, XLAL_EFAILED, "%s: table has %zu entries, expected %zu", what, table->length, n);
+	for(i = 0; i < n; i++)
+		XLAL_CHECK(table->time[i] == entries[i].time && table->snr[i] == entries[i].snr && table->row[i] == entries[i].row, XLAL_EFAILED, "%s: entry %zu differs", what, i);
+
+	return 0;
+}
+
+
+/*
+ * the rows are linked in the table's order, and the discarded rows are
+ * all the other rows of the original list
+ */
+
+static int check_relink(LIGOTriggerTable *table, SnglBurst **head, size_t n)
+{
+	SnglBurst *discarded;
+	SnglBurst *row;
+	char *seen = LALCalloc(n ? n : 1, 1);
+	size_t i;
+
+	XLAL_CHECK(seen, XLAL_ENOMEM);
+	*head = XLALTriggerTableToSnglBurst(table, *head, &discarded);
+	XLAL_CHECK(*head || !table->length, XLAL_EFUNC);
+	for(row = *head, i = 0; row; row = row->next, i++) {
+		XLAL_CHECK(i < table->length && row == table->row[i], XLAL_EFAILED, "row %zu of the list is not entry %zu of the table", i, i);
+		seen[row->event_id]++;
+	}
+	XLAL_CHECK(i == table->length, XLAL_EFAILED, "list has %zu rows, table has %zu entries", i, table->length);
+	for(row = discarded; row; row = row->next, i++)
+		seen[row->event_id]++;
+	XLAL_CHECK(i == n, XLAL_EFAILED, "%zu rows in the two lists, expected %zu", i, n);
+	for(i = 0; i < n; i++)
+		XLAL_CHECK(seen[i] == 1, XLAL_EFAILED, "row %zu is in the lists %d times", i, seen[i]);
+
+	LALFree(seen);
+	destroy_triggers(discarded);
+	return 0;
+}
+
+
+static int test_sort_and_cluster(size_t n, INT8 start, INT8 range, INT8 step, INT8 window)
+{
+	SnglBurst *head = make_triggers(n, start, range, step);
+	LIGOTriggerTable *table;
+	struct entry *entries;
+	size_t length;
+	size_t i;
+	long r;
+
+	XLAL_CHECK(head || !n, XLAL_EFUNC);
+	entries = sorted_entries(head, n);
+	XLAL_CHECK(entries, XLAL_EFUNC);
+	table = XLALTriggerTableFromSnglBurst(head);
+	XLAL_CHECK(table, XLAL_EFUNC);
+
+	/* sorting, twice, since a sorted table is left alone */
+	XLAL_CHECK(XLALTriggerTableSortByTime(table) == 0, XLAL_EFUNC);
+	XLAL_CHECK(check_table(table, entries, n, "sort") == 0, XLAL_EFUNC);
+	XLAL_CHECK(XLALTriggerTableSortByTime(table) == 0, XLAL_EFUNC);
+	XLAL_CHECK(check_table(table, entries, n, "second sort") == 0, XLAL_EFUNC);
+	XLAL_CHECK(check_relink(table, &head, n) == 0, XLAL_EFUNC);
+
+	/* clustering:  the first of the loudest entries of each cluster is
+	 * kept, and an entry more than window after the current loudest one
+	 * starts a new cluster */
+	length = 0;
+	for(i = 0; i < n; i++) {
+		if(length && entries[i].time - entries[length - 1].time <= window) {
+			if(entries[i].snr > entries[length - 1].snr)
+				entries[length - 1] = entries[i];
+		} else
+			entries[length++] = entries[i];
+	}
+	r = XLALTriggerTableClusterByTime(table, window);
+	XLAL_CHECK(r >= 0, XLAL_EFUNC);
+	XLAL_CHECK((size_t) r == length, XLAL_EFAILED, "clustering returned %ld, expected %zu", r, length);
+	XLAL_CHECK(check_table(table, entries, length, "cluster") == 0, XLAL_EFUNC);
+	XLAL_CHECK(check_relink(table, &head, n) == 0, XLAL_EFUNC);
+
+	XLALDestroyTriggerTable(table);
+	LALFree(entries);
+	destroy_triggers(head);
+	return 0;
+}
+
+
+static int test_coinc(size_t na, size_t nb, INT8 window)
+{
+	const INT8 offsets[] = { 0, 5 * XLAL_BILLION_INT8, -5 * XLAL_BILLION_INT8, 1234567891, 2000 * XLAL_BILLION_INT8 };
+	const size_t noffsets = sizeof(offsets) / sizeof(*offsets);
+	SnglBurst *a = make_triggers(na, 1000000000 * XLAL_BILLION_INT8, 1000 * XLAL_BILLION_INT8, 1000);
+	SnglBurst *b = make_triggers(nb, 1000000000 * XLAL_BILLION_INT8, 1000 * XLAL_BILLION_INT8, 1000);
+	LIGOTriggerTable *ta, *tb;
+	LIGOTriggerCoinc *coincs;
+	size_t n = 0;
+	size_t i, j, k;
+	long r;
+	int errnum;
+
+	XLAL_CHECK((a || !na) && (b || !nb), XLAL_EFUNC);
+	ta = XLALTriggerTableFromSnglBurst(a);
+	tb = XLALTriggerTableFromSnglBurst(b);
+	XLAL_CHECK(ta && tb, XLAL_EFUNC);
+
+	/* the tables must be sorted */
+	XLAL_TRY_SILENT(r = XLALTriggerTableCoinc(&coincs, ta, tb, offsets, noffsets, window), errnum);
+	XLAL_CHECK(r < 0 && errnum == XLAL_EINVAL, XLAL_EFAILED, "unsorted tables accepted");
+	XLAL_CHECK(XLALTriggerTableSortByTime(ta) == 0 && XLALTriggerTableSortByTime(tb) == 0, XLAL_EFUNC);
+	XLAL_TRY_SILENT(r = XLALTriggerTableCoinc(&coincs, ta, tb, offsets, noffsets, -1), errnum);
+	XLAL_CHECK(r < 0 && errnum == XLAL_EINVAL, XLAL_EFAILED, "negative window accepted");
+
+	r = XLALTriggerTableCoinc(&coincs, ta, tb, offsets, noffsets, window);
+	XLAL_CHECK(r >= 0, XLAL_EFUNC);
+	XLAL_CHECK(r > 0 || !coincs, XLAL_EFAILED, "no coincidences, but a list was returned");
+
+	/* all the pairs, in the order of offset and then of the entries */
+	for(k = 0; k < noffsets; k++)
+		for(i = 0; i < ta->length; i++)
+			for(j = 0; j < tb->length; j++) {
+				INT8 dt = ta->time[i] - (tb->time[j] + offsets[k]);
+				if(dt < -window || dt > window)
+					continue;
+				XLAL_CHECK(n < (size_t) r, XLAL_EFAILED, "coincidence %zu not found", n);
+				XLAL_CHECK(coincs[n].slide == k && coincs[n].a == i && coincs[n].b == j, XLAL_EFAILED, "coincidence %zu is (%u, %u, %u), expected (%zu, %zu, %zu)", n, coincs[n].slide, coincs[n].a, coincs[n].b, k, i, j);
+				n++;
+			}
+	XLAL_CHECK(n == (size_t) r, XLAL_EFAILED, "%ld coincidences found, expected %zu", r, n);
+	LALFree(coincs);
+
+	/* no offsets, no coincidences */
+	XLAL_CHECK(XLALTriggerTableCoinc(&coincs, ta, tb, NULL, 0, window) == 0 && !coincs, XLAL_EFUNC);
+
+	XLALDestroyTriggerTable(ta);
+	XLALDestroyTriggerTable(tb);
+	destroy_triggers(a);
+	destroy_triggers(b);
+	return 0;
+}
+
+
+int main(void)
+{
+	SnglBurst *head;
+	SnglBurst *discarded;
+	LIGOTriggerTable *table;
+	void *r;
+	int errnum;
+
+	srand(2718);
+
+	/* the high bytes of the times are all the same, vary, or have the
+	 * sign bit set;  few distinct times gives many ties */
+	XLAL_CHECK_MAIN(test_sort_and_cluster(0, 1000000000 * XLAL_BILLION_INT8, XLAL_BILLION_INT8, 1, 0) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_sort_and_cluster(1, 1000000000 * XLAL_BILLION_INT8, XLAL_BILLION_INT8, 1, 0) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_sort_and_cluster(2, 1000000000 * XLAL_BILLION_INT8, XLAL_BILLION_INT8, 1, XLAL_BILLION_INT8) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_sort_and_cluster(1000, 1000000000 * XLAL_BILLION_INT8, XLAL_BILLION_INT8, 1, 0) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_sort_and_cluster(20011, 1000000000 * XLAL_BILLION_INT8, 10000 * XLAL_BILLION_INT8, 1, XLAL_BILLION_INT8) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_sort_and_cluster(20011, 1000000000 * XLAL_BILLION_INT8, 100 * XLAL_BILLION_INT8, XLAL_BILLION_INT8 / 4, XLAL_BILLION_INT8 / 4) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_sort_and_cluster(20011, -1000 * XLAL_BILLION_INT8, 2000 * XLAL_BILLION_INT8, 1, 0) == 0, XLAL_EFUNC);
+
+	XLAL_CHECK_MAIN(test_coinc(0, 100, XLAL_BILLION_INT8) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_coinc(2000, 3000, XLAL_BILLION_INT8 / 20) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_coinc(3000, 2000, 0) == 0, XLAL_EFUNC);
+
+	/* a table can only be linked into a list of its own row type */
+	head = make_triggers(10, 0, XLAL_BILLION_INT8, 1);
+	XLAL_CHECK_MAIN(head, XLAL_EFUNC);
+	table = XLALTriggerTableFromSnglBurst(head);
+	XLAL_CHECK_MAIN(table, XLAL_EFUNC);
+	XLAL_TRY_SILENT(r = XLALTriggerTableToSnglInspiral(table, NULL, NULL), errnum);
+	XLAL_CHECK_MAIN(!r && errnum == XLAL_ETYPE, XLAL_EFAILED, "sngl_burst table linked into a sngl_inspiral list");
+	XLAL_TRY_SILENT(r = XLALTriggerTableToSnglBurst(table, head, NULL), errnum);
+	XLAL_CHECK_MAIN(!r && errnum == XLAL_EFAULT, XLAL_EFAILED, "discarded rows were not asked for");
+	head = XLALTriggerTableToSnglBurst(table, head, &discarded);
+	XLAL_CHECK_MAIN(head && !discarded, XLAL_EFUNC);
+	XLALDestroyTriggerTable(table);
+	destroy_triggers(head);
+
+	LALCheckMemoryLeaks();
+	return 0;
+}
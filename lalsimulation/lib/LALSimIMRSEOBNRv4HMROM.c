@@ -1460,18 +1460,9 @@ static int SEOBROMComputehplushcrossFromhlm(
     REAL8 inc,  /**<< Input: inclination */
     UNUSED REAL8 phi   /**<< Input: phase */
 ) {
-  /* Loop over modes */
-  SphHarmFrequencySeries *hlms_temp = hlm;
-  while ( hlms_temp ) {
-    if (XLALSimInspiralModeArrayIsModeActive(ModeArray, hlms_temp->l, hlms_temp->m) == 1){
-      /*Here we check if the mode generated is in the ModeArray structure
-      */
-        XLALSimAddModeFD(hplusFS, hcrossFS, hlms_temp->mode, inc, LAL_PI/2. - phi, hlms_temp->l, hlms_temp->m, 1);
-        //XLALSimAddModeFD(hplusFS, hcrossFS, hlms_temp->mode, inc, 0., hlms_temp->l, hlms_temp->m, 1);
-      }
-      hlms_temp = hlms_temp->next;
-
-  }
+  /* Add all the modes in the ModeArray structure in a single pass */
+  if (XLALSimAddSphHarmFrequencySeries(hplusFS, hcrossFS, hlm, inc, LAL_PI/2. - phi, ModeArray, 1) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
 
   return XLAL_SUCCESS;
 }
@@ -64,12 +64,17 @@ static const INT4 ROMDataHDF5_VERSION_MICRO = 0;
 #include <lal/LALSimIMR.h>
 
 #include "LALSimIMRSEOBNRROMUtilities.c"
+#include "LALSimROMDataStore.h"
 
 #include <lal/LALConfig.h>
 #ifdef LAL_PTHREAD_LOCK
 #include <pthread.h>
 #endif
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 
 
 #ifdef LAL_PTHREAD_LOCK
@@ -417,25 +422,34 @@ UNUSED static int SEOBNRROMdataDS_Init_submodel(
   char *path = XLALMalloc(size);
   snprintf(path, size, "%s/%s", dir, ROMDataHDF5);
 
-  LALH5File *file = XLALH5FileOpen(path, "r");
-  LALH5File *sub = XLALH5GroupOpen(file, grp_name);
+  // The data store maps preconverted cache files of the datasets when
+  // they exist, so pages are only read in when first used and are shared
+  // between processes; otherwise it reads from the HDF5 file.
+  ROMDataStore *store = ROMDataStore_Open(path);
+  XLALFree(path);
+  XLAL_CHECK(store != NULL, XLAL_EFUNC, "Could not open ROM data file %s in %s", ROMDataHDF5, dir);
 
+  int status = XLAL_SUCCESS;
   // Read ROM coefficients
-  ReadHDF5RealVectorDataset(sub, "Amp_ciall", & (*submodel)->cvec_amp);
-  ReadHDF5RealVectorDataset(sub, "Phase_ciall", & (*submodel)->cvec_phi);
+  status |= ROMDataStore_ReadRealVector(store, grp_name, "Amp_ciall", & (*submodel)->cvec_amp);
+  status |= ROMDataStore_ReadRealVector(store, grp_name, "Phase_ciall", & (*submodel)->cvec_phi);
 
   // Read ROM basis functions
-  ReadHDF5RealMatrixDataset(sub, "Bamp", & (*submodel)->Bamp);
-  ReadHDF5RealMatrixDataset(sub, "Bphase", & (*submodel)->Bphi);
+  status |= ROMDataStore_ReadRealMatrix(store, grp_name, "Bamp", & (*submodel)->Bamp);
+  status |= ROMDataStore_ReadRealMatrix(store, grp_name, "Bphase", & (*submodel)->Bphi);
 
   // Read sparse frequency points
-  ReadHDF5RealVectorDataset(sub, "Mf_grid_Amp", & (*submodel)->gA);
-  ReadHDF5RealVectorDataset(sub, "Mf_grid_Phi", & (*submodel)->gPhi);
+  status |= ROMDataStore_ReadRealVector(store, grp_name, "Mf_grid_Amp", & (*submodel)->gA);
+  status |= ROMDataStore_ReadRealVector(store, grp_name, "Mf_grid_Phi", & (*submodel)->gPhi);
 
   // Read parameter space nodes
-  ReadHDF5RealVectorDataset(sub, "etavec", & (*submodel)->etavec);
-  ReadHDF5RealVectorDataset(sub, "chi1vec", & (*submodel)->chi1vec);
-  ReadHDF5RealVectorDataset(sub, "chi2vec", & (*submodel)->chi2vec);
+  status |= ROMDataStore_ReadRealVector(store, grp_name, "etavec", & (*submodel)->etavec);
+  status |= ROMDataStore_ReadRealVector(store, grp_name, "chi1vec", & (*submodel)->chi1vec);
+  status |= ROMDataStore_ReadRealVector(store, grp_name, "chi2vec", & (*submodel)->chi2vec);
+  if (status != XLAL_SUCCESS) {
+    ROMDataStore_Close(store);
+    XLAL_ERROR(XLAL_EFUNC, "Could not read ROM data for %s", grp_name);
+  }
 
   // Initialize other members
   (*submodel)->nk_amp = (*submodel)->gA->size;
@@ -452,8 +466,7 @@ UNUSED static int SEOBNRROMdataDS_Init_submodel(
   (*submodel)->chi2_bounds[0] = gsl_vector_get((*submodel)->chi2vec, 0);
   (*submodel)->chi2_bounds[1] = gsl_vector_get((*submodel)->chi2vec, (*submodel)->chi2vec->size - 1);
 
-  XLALFree(path);
-  XLALH5FileClose(file);
+  ROMDataStore_Close(store);
   ret = XLAL_SUCCESS;
 #else
   XLAL_ERROR(XLAL_EFAILED, "HDF5 support not enabled");
@@ -1102,6 +1115,405 @@ static int SEOBNRv4ROMCore(
   return(XLAL_SUCCESS);
 }
 
+/*************** Batched evaluation ******************/
+
+// Natural cubic spline on a fixed set of nodes, equivalent to gsl_interp_cspline.
+// The tridiagonal system for the spline's second derivatives depends only
+// on the nodes, so it is factorised once and each set of data on the same
+// nodes is splined in O(n) without allocating.
+typedef struct tagROMSplineNodes
+{
+  size_t n;          // Number of nodes
+  const double *x;   // Nodes (not owned)
+  double *h;         // Node spacings x[i+1] - x[i]
+  double *pivot;     // Pivots of the factorised tridiagonal system
+  double *mult;      // Multipliers of the factorised tridiagonal system
+} ROMSplineNodes;
+
+static int ROMSplineNodes_Init(ROMSplineNodes *nodes, const double *x, size_t n) {
+  if (n < 3)
+    XLAL_ERROR(XLAL_EINVAL, "Need at least 3 spline nodes, got %zu", n);
+  nodes->n = n;
+  nodes->x = x;
+  nodes->h = XLALMalloc(3 * n * sizeof(double));
+  if (!nodes->h)
+    XLAL_ERROR(XLAL_ENOMEM);
+  nodes->pivot = nodes->h + n;
+  nodes->mult = nodes->h + 2*n;
+
+  for (size_t i=0; i<n-1; i++)
+    nodes->h[i] = x[i+1] - x[i];
+  // Rows 1..n-2 of the system; c[0] = c[n-1] = 0 for a natural spline
+  nodes->pivot[1] = 2.0 * (nodes->h[0] + nodes->h[1]);
+  for (size_t i=2; i<n-1; i++) {
+    nodes->mult[i] = nodes->h[i-1] / nodes->pivot[i-1];
+    nodes->pivot[i] = 2.0 * (nodes->h[i-1] + nodes->h[i]) - nodes->mult[i] * nodes->h[i-1];
+  }
+  return XLAL_SUCCESS;
+}
+
+static void ROMSplineNodes_Cleanup(ROMSplineNodes *nodes) {
+  XLALFree(nodes->h);
+  nodes->h = nodes->pivot = nodes->mult = NULL;
+}
+
+// Fill coef[0..4n) with the polynomial coefficients y, b, c, d of the spline
+// through (x[i], y[i]) so that y(x) = y[i] + dx*(b[i] + dx*(c[i] + dx*d[i]))
+// on [x[i], x[i+1]] with dx = x - x[i].
+static void ROMSpline_Init(double *coef, const ROMSplineNodes *nodes, const double *y) {
+  const size_t n = nodes->n;
+  const double *h = nodes->h;
+  double *a = coef, *b = coef + n, *c = coef + 2*n, *d = coef + 3*n;
+
+  // y may alias the tail of coef, so work from the copy in a from here on
+  memmove(a, y, n * sizeof(double));
+  // Forward substitution, using d as scratch space
+  d[1] = 3.0 * ((a[2] - a[1]) / h[1] - (a[1] - a[0]) / h[0]);
+  for (size_t i=2; i<n-1; i++)
+    d[i] = 3.0 * ((a[i+1] - a[i]) / h[i] - (a[i] - a[i-1]) / h[i-1]) - nodes->mult[i] * d[i-1];
+  // Back substitution
+  c[0] = c[n-1] = 0.0;
+  c[n-2] = d[n-2] / nodes->pivot[n-2];
+  for (size_t i=n-2; i-- > 1; )
+    c[i] = (d[i] - h[i] * c[i+1]) / nodes->pivot[i];
+  for (size_t i=0; i<n-1; i++) {
+    b[i] = (a[i+1] - a[i]) / h[i] - h[i] * (c[i+1] + 2.0 * c[i]) / 3.0;
+    d[i] = (c[i+1] - c[i]) / (3.0 * h[i]);
+  }
+  b[n-1] = d[n-1] = 0.0;
+}
+
+// Index i of the interval [x[i], x[i+1]) containing x, clamped to [0, n-2].
+// The search starts from guess, which makes ordered lookups O(1).
+static size_t ROMSpline_Find(const ROMSplineNodes *nodes, double x, size_t guess) {
+  const double *xa = nodes->x;
+  size_t lo = 0, hi = nodes->n - 1;
+  if (guess < hi && xa[guess] <= x) {
+    if (guess + 1 == hi || x < xa[guess+1])
+      return guess;
+    if (guess + 2 == hi || x < xa[guess+2])
+      return guess + 1;
+    lo = guess + 1;
+  }
+  while (hi > lo + 1) {
+    size_t i = (lo + hi) / 2;
+    if (xa[i] > x)
+      hi = i;
+    else
+      lo = i;
+  }
+  return lo;
+}
+
+static double ROMSpline_Eval(const double *coef, const ROMSplineNodes *nodes, double x) {
+  const size_t n = nodes->n;
+  const size_t i = ROMSpline_Find(nodes, x, 0);
+  const double dx = x - nodes->x[i];
+  return coef[i] + dx * (coef[n+i] + dx * (coef[2*n+i] + dx * coef[3*n+i]));
+}
+
+static double ROMSpline_EvalDeriv(const double *coef, const ROMSplineNodes *nodes, double x) {
+  const size_t n = nodes->n;
+  const size_t i = ROMSpline_Find(nodes, x, 0);
+  const double dx = x - nodes->x[i];
+  return coef[n+i] + dx * (2.0 * coef[2*n+i] + 3.0 * dx * coef[3*n+i]);
+}
+
+// Evaluate the projection coefficients of a submodel at m points in
+// (eta, chi1, chi2) and project them onto the sparse frequency nodes.
+// The B-spline basis is evaluated once per point and shared by all SVD
+// modes; the projections for all points are a single dgemm each for
+// amplitude and phase: amp_f = c_amp . Bamp, phi_f = c_phi . Bphi.
+static int SEOBNRROMdataDS_submodel_NodesBatch(
+  SEOBNRROMdataDS_submodel *submodel,  // Input: ROM submodel
+  size_t m,                            // Input: number of parameter points
+  const size_t *idx,                   // Input: indices of the points in eta, chi1, chi2
+  const double *eta,                   // Input: eta-values
+  const double *chi1,                  // Input: chi1-values
+  const double *chi2,                  // Input: chi2-values
+  int nk_max,                          // Input: truncate at SVD mode nk_max; don't truncate if nk_max == -1
+  gsl_matrix *amp_f,                   // Output: m x nk_amp amplitudes on the sparse frequency nodes
+  gsl_matrix *phi_f                    // Output: m x nk_phi phases on the sparse frequency nodes
+) {
+  const int ncx = submodel->ncx, ncy = submodel->ncy, ncz = submodel->ncz;
+  const int N = ncx*ncy*ncz;  // Size of the data matrix for one SVD-mode
+  int nk_amp = submodel->Bamp->size1;
+  int nk_phi = submodel->Bphi->size1;
+  if (nk_max != -1) {
+    if (nk_max > nk_amp || nk_max > nk_phi)
+      XLAL_ERROR(XLAL_EDOM, "Truncation parameter nk_max %d must be smaller or equal to nk_amp %d and nk_phi %d", nk_max, nk_amp, nk_phi);
+    nk_amp = nk_phi = nk_max;
+  }
+
+  // Truncated modes keep zero coefficients
+  gsl_matrix *c_amp = gsl_matrix_calloc(m, submodel->Bamp->size1);
+  gsl_matrix *c_phi = gsl_matrix_calloc(m, submodel->Bphi->size1);
+  if (!c_amp || !c_phi) {
+    if (c_amp) gsl_matrix_free(c_amp);
+    if (c_phi) gsl_matrix_free(c_phi);
+    XLAL_ERROR(XLAL_ENOMEM);
+  }
+
+  int failed = 0;
+  #pragma omp parallel
+  {
+    // gsl_bspline workspaces are not thread-safe, so each thread has its own
+    SplineData *splinedata = NULL;
+    SplineData_Init(&splinedata, ncx, ncy, ncz,
+                    gsl_vector_const_ptr(submodel->etavec, 0),
+                    gsl_vector_const_ptr(submodel->chi1vec, 0),
+                    gsl_vector_const_ptr(submodel->chi2vec, 0));
+    gsl_vector *Bx4 = gsl_vector_alloc(4);
+    gsl_vector *By4 = gsl_vector_alloc(4);
+    gsl_vector *Bz4 = gsl_vector_alloc(4);
+    if (!splinedata || !Bx4 || !By4 || !Bz4) {
+      #pragma omp atomic write
+      failed = 1;
+    }
+
+    #pragma omp for schedule(static)
+    for (size_t p=0; p<m; p++) {
+      int stop;
+      #pragma omp atomic read
+      stop = failed;
+      if (stop) continue;
+
+      const size_t q = idx[p];
+      size_t isx, isy, isz, iex, iey, iez;
+      gsl_bspline_eval_nonzero(eta[q],  Bx4, &isx, &iex, splinedata->bwx);
+      gsl_bspline_eval_nonzero(chi1[q], By4, &isy, &iey, splinedata->bwy);
+      gsl_bspline_eval_nonzero(chi2[q], Bz4, &isz, &iez, splinedata->bwz);
+
+      // The 64 nonzero tensor-product weights and their offsets in the coefficient tensor
+      double w[64];
+      int off[64];
+      for (int i=0; i<4; i++)
+        for (int j=0; j<4; j++)
+          for (int k=0; k<4; k++) {
+            w[(i*4 + j)*4 + k] = gsl_vector_get(Bx4, i) * gsl_vector_get(By4, j) * gsl_vector_get(Bz4, k);
+            off[(i*4 + j)*4 + k] = ((isx + i)*ncy + isy + j)*ncz + isz + k;
+          }
+
+      for (int k=0; k<nk_amp; k++) {
+        const double *v = gsl_vector_const_ptr(submodel->cvec_amp, (size_t)k*N);
+        double sum = 0;
+        for (int l=0; l<64; l++)
+          sum += v[off[l]] * w[l];
+        gsl_matrix_set(c_amp, p, k, sum);
+      }
+      for (int k=0; k<nk_phi; k++) {
+        const double *v = gsl_vector_const_ptr(submodel->cvec_phi, (size_t)k*N);
+        double sum = 0;
+        for (int l=0; l<64; l++)
+          sum += v[off[l]] * w[l];
+        gsl_matrix_set(c_phi, p, k, sum);
+      }
+    }
+
+    if (Bx4) gsl_vector_free(Bx4);
+    if (By4) gsl_vector_free(By4);
+    if (Bz4) gsl_vector_free(Bz4);
+    SplineData_Destroy(splinedata);
+  }
+
+  if (!failed) {
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, c_amp, submodel->Bamp, 0.0, amp_f);
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, c_phi, submodel->Bphi, 0.0, phi_f);
+  }
+  gsl_matrix_free(c_amp);
+  gsl_matrix_free(c_phi);
+  if (failed)
+    XLAL_ERROR(XLAL_ENOMEM);
+  return XLAL_SUCCESS;
+}
+
+// Per-waveform quantities of a batch
+typedef struct tagSEOBNRv4ROMBatchPoint
+{
+  double Mtot_sec;    // Total mass in seconds
+  double phiRef;      // Orbital reference phase
+  double fRef_geom;   // Geometric reference frequency
+  double Mf_final;    // Geometric ringdown frequency
+  double amp0;        // Overall amplitude
+  double pcoef;       // Plus polarization inclination factor
+  double ccoef;       // Cross polarization inclination factor
+  int hi;             // High frequency submodel: 2 or 3
+  size_t row_hi;      // Row of the point in the high frequency submodel's node values
+} SEOBNRv4ROMBatchPoint;
+
+// Glued sparse frequency grids of the low frequency submodel and one high
+// frequency submodel, as set up by GlueAmplitude() and GluePhasing()
+typedef struct tagSEOBNRv4ROMGlue
+{
+  SEOBNRROMdataDS_submodel *lo, *hi;
+  int jA_lo, jA_hi, nA;
+  int jP_lo, jP_hi, nP;
+  double *gAU, *gPU;                         // Glued frequency grids
+  ROMSplineNodes nodes_amp, nodes_phi, nodes_phi_lo;
+  gsl_vector_const_view gP_hi_data;          // Frequencies of the phase fit across the gluing frequency
+} SEOBNRv4ROMGlue;
+
+#define SEOBNRv4ROM_GLUE_NN 15 // Number of points either side of the gluing frequency used by GluePhasing()
+
+static void SEOBNRv4ROMGlue_Cleanup(SEOBNRv4ROMGlue *glue) {
+  ROMSplineNodes_Cleanup(&glue->nodes_amp);
+  ROMSplineNodes_Cleanup(&glue->nodes_phi);
+  ROMSplineNodes_Cleanup(&glue->nodes_phi_lo);
+  XLALFree(glue->gAU);
+  glue->gAU = glue->gPU = NULL;
+}
+
+static int SEOBNRv4ROMGlue_Init(SEOBNRv4ROMGlue *glue, SEOBNRROMdataDS_submodel *lo, SEOBNRROMdataDS_submodel *hi, const double Mfm) {
+  memset(glue, 0, sizeof(*glue));
+  glue->lo = lo;
+  glue->hi = hi;
+
+  // Same index bookkeeping as GlueAmplitude() and GluePhasing()
+  for (glue->jA_lo=0; glue->jA_lo < lo->nk_amp; glue->jA_lo++)
+    if (gsl_vector_get(lo->gA, glue->jA_lo) > Mfm) {
+      glue->jA_lo--;
+      break;
+    }
+  for (glue->jA_hi=0; glue->jA_hi < hi->nk_amp; glue->jA_hi++)
+    if (gsl_vector_get(hi->gA, glue->jA_hi) > Mfm)
+      break;
+  glue->nA = 1 + glue->jA_lo + (hi->nk_amp - glue->jA_hi);
+
+  for (glue->jP_lo=0; glue->jP_lo < lo->nk_phi; glue->jP_lo++)
+    if (gsl_vector_get(lo->gPhi, glue->jP_lo) > Mfm) {
+      glue->jP_lo--;
+      break;
+    }
+  for (glue->jP_hi=0; glue->jP_hi < hi->nk_phi; glue->jP_hi++)
+    if (gsl_vector_get(hi->gPhi, glue->jP_hi) > Mfm)
+      break;
+  glue->nP = 1 + glue->jP_lo + (hi->nk_phi - glue->jP_hi);
+
+  glue->gAU = XLALMalloc((glue->nA + glue->nP) * sizeof(double));
+  if (!glue->gAU)
+    XLAL_ERROR(XLAL_ENOMEM);
+  glue->gPU = glue->gAU + glue->nA;
+  for (int i=0; i<glue->nA; i++)
+    glue->gAU[i] = i <= glue->jA_lo ? gsl_vector_get(lo->gA, i)
+                                    : gsl_vector_get(hi->gA, glue->jA_hi - (glue->jA_lo+1) + i);
+  for (int i=0; i<glue->nP; i++)
+    glue->gPU[i] = i <= glue->jP_lo ? gsl_vector_get(lo->gPhi, i)
+                                    : gsl_vector_get(hi->gPhi, glue->jP_hi - (glue->jP_lo+1) + i);
+
+  glue->gP_hi_data = gsl_vector_const_subvector(hi->gPhi, glue->jP_hi - SEOBNRv4ROM_GLUE_NN, 2*SEOBNRv4ROM_GLUE_NN+1);
+
+  if (ROMSplineNodes_Init(&glue->nodes_amp, glue->gAU, glue->nA) != XLAL_SUCCESS
+      || ROMSplineNodes_Init(&glue->nodes_phi, glue->gPU, glue->nP) != XLAL_SUCCESS
+      || ROMSplineNodes_Init(&glue->nodes_phi_lo, gsl_vector_const_ptr(lo->gPhi, 0), lo->nk_phi) != XLAL_SUCCESS) {
+    SEOBNRv4ROMGlue_Cleanup(glue);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
+  return XLAL_SUCCESS;
+}
+
+// Glue the node values of one waveform and set up its amplitude and phase
+// splines, as GlueAmplitude() and GluePhasing().  coef_amp holds 4*nA
+// doubles, coef_phi 4*nP and coef_lo 4*lo->nk_phi doubles of scratch space.
+static void SEOBNRv4ROMGlue_Splines(
+  const SEOBNRv4ROMGlue *glue,
+  const double *amp_f_lo, const double *phi_f_lo,
+  const double *amp_f_hi, const double *phi_f_hi,
+  const double Mfm,
+  double *coef_amp, double *coef_phi, double *coef_lo
+) {
+  const int nn = SEOBNRv4ROM_GLUE_NN;
+  double *ampU = coef_amp + 3*glue->nA; // Free until ROMSpline_Init overwrites it
+  double *phiU = coef_phi + 3*glue->nP;
+  double P_lo[2*SEOBNRv4ROM_GLUE_NN+1];
+
+  for (int i=0; i<glue->nA; i++)
+    ampU[i] = i <= glue->jA_lo ? amp_f_lo[i] : amp_f_hi[glue->jA_hi - (glue->jA_lo+1) + i];
+  ROMSpline_Init(coef_amp, &glue->nodes_amp, ampU);
+
+  // Low frequency phase spline evaluated at the high frequency nodes next to Mfm
+  ROMSpline_Init(coef_lo, &glue->nodes_phi_lo, phi_f_lo);
+  for (int i=0; i<2*nn+1; i++)
+    P_lo[i] = ROMSpline_Eval(coef_lo, &glue->nodes_phi_lo, gsl_vector_get(&glue->gP_hi_data.vector, i));
+
+  // Fit phase data to cubic polynomial in frequency
+  gsl_vector_const_view P_lo_data = gsl_vector_const_view_array(P_lo, 2*nn+1);
+  gsl_vector_const_view P_hi_data = gsl_vector_const_view_array(phi_f_hi + glue->jP_hi - nn, 2*nn+1);
+  gsl_vector *cP_lo = Fit_cubic(&glue->gP_hi_data.vector, &P_lo_data.vector);
+  gsl_vector *cP_hi = Fit_cubic(&glue->gP_hi_data.vector, &P_hi_data.vector);
+
+  double P_lo_derivs[2];
+  double P_hi_derivs[2];
+  gsl_poly_eval_derivs(cP_lo->data, 4, Mfm, P_lo_derivs, 2);
+  gsl_poly_eval_derivs(cP_hi->data, 4, Mfm, P_hi_derivs, 2);
+  gsl_vector_free(cP_lo);
+  gsl_vector_free(cP_hi);
+
+  double delta_omega = P_hi_derivs[1] - P_lo_derivs[1];
+  double delta_phi   = P_hi_derivs[0] - P_lo_derivs[0] - delta_omega * Mfm;
+
+  for (int i=0; i<glue->nP; i++) {
+    if (i <= glue->jP_lo)
+      phiU[i] = phi_f_lo[i];
+    else {
+      int k = glue->jP_hi - (glue->jP_lo+1) + i;
+      phiU[i] = phi_f_hi[k] - delta_omega * glue->gPU[i] - delta_phi; // Now correct phase of high frequency submodel
+    }
+  }
+  ROMSpline_Init(coef_phi, &glue->nodes_phi, phiU);
+}
+
+// Assemble one waveform on the frequency grid from its amplitude and phase
+// splines, as the final loops of SEOBNRv4ROMCore().  The interval lookups
+// are done first so that the spline and trigonometric evaluations form a
+// flat loop over frequencies that the compiler can vectorise.
+static void SEOBNRv4ROM_AssembleBatchPoint(
+  COMPLEX16 *hp,                        // Output: h+ on the frequency grid
+  COMPLEX16 *hc,                        // Output: hx on the frequency grid
+  const double *freqs,                  // Input: frequency grid (Hz)
+  size_t nfreq,                         // Input: number of frequencies
+  const SEOBNRv4ROMBatchPoint *pt,      // Input: per-waveform quantities
+  const SEOBNRv4ROMGlue *glue,          // Input: glued frequency grids
+  const double *coef_amp,               // Input: amplitude spline
+  const double *coef_phi,               // Input: phase spline
+  double Mf_ROM_max,                    // Input: highest allowed geometric frequency
+  size_t *ia,                           // Scratch: nfreq amplitude interval indices
+  size_t *ip                            // Scratch: nfreq phase interval indices
+) {
+  const ROMSplineNodes *na = &glue->nodes_amp;
+  const ROMSplineNodes *np = &glue->nodes_phi;
+  const size_t nA = na->n, nP = np->n;
+  const double s = 0.5; // Scale polarization amplitude so that strain agrees with FFT of SEOBNRv4
+
+  // Evaluate reference phase for setting phiRef correctly
+  const double phase_change = ROMSpline_Eval(coef_phi, np, pt->fRef_geom) - 2*pt->phiRef;
+  // Time correction is t(f_final) = 1/(2pi) dphi/df (f_final)
+  const double t_corr = ROMSpline_EvalDeriv(coef_phi, np, pt->Mf_final) / (2*LAL_PI);
+
+  size_t ja = 0, jp = 0;
+  for (size_t i=0; i<nfreq; i++) {
+    const double f = freqs[i] * pt->Mtot_sec;
+    ia[i] = ja = ROMSpline_Find(na, f, ja);
+    ip[i] = jp = ROMSpline_Find(np, f, jp);
+  }
+
+  #pragma omp simd
+  for (size_t i=0; i<nfreq; i++) {
+    const double f = freqs[i] * pt->Mtot_sec;
+    const size_t ka = ia[i], kp = ip[i];
+    const double dxa = f - na->x[ka];
+    const double dxp = f - np->x[kp];
+    const double A = coef_amp[ka] + dxa * (coef_amp[nA+ka] + dxa * (coef_amp[2*nA+ka] + dxa * coef_amp[3*nA+ka]));
+    const double P = coef_phi[kp] + dxp * (coef_phi[nP+kp] + dxp * (coef_phi[2*nP+kp] + dxp * coef_phi[3*nP+kp]));
+    // Frequencies beyond the highest allowed frequency are left at zero
+    const double amp = f > Mf_ROM_max ? 0.0 : s * pt->amp0 * A;
+    const double phase = P - phase_change - 2*LAL_PI * (f - pt->fRef_geom) * t_corr;
+    const double re = amp * cos(phase);
+    const double im = amp * sin(phase);
+    hp[i] = pt->pcoef * re + I * (pt->pcoef * im);
+    hc[i] = pt->ccoef * im - I * (pt->ccoef * re);
+  }
+}
+
 /**
  * @addtogroup LALSimIMRSEOBNRROM_c
  *
@@ -1211,6 +1623,264 @@ int XLALSimIMRSEOBNRv4ROMFrequencySequence(
   return(retcode);
 }
 
+/**
+ * Compute SEOBNRv4_ROM waveforms for many parameter sets at the same frequencies.
+ *
+ * Row n of hptilde and hctilde is filled with the waveform that
+ * XLALSimIMRSEOBNRv4ROMFrequencySequence() returns for params[n] (with
+ * the aligned spins S1z, S2z; transverse spins are ignored), so both must
+ * have nparams rows of freqs->length points.
+ *
+ * Rather than evaluating each waveform separately, the projection
+ * coefficients of all parameter sets are interpolated together and
+ * projected onto the sparse frequency nodes with one matrix-matrix product
+ * per submodel.  The amplitude and phase splines share their node layout
+ * across the batch, so each waveform's splines cost O(n) without
+ * allocation, and are evaluated on the frequency grid in a vectorisable
+ * loop.  Waveforms are assembled in parallel with OpenMP.
+ */
+int XLALSimIMRSEOBNRv4ROMFrequencySequenceBatch(
+  COMPLEX16VectorSequence *hptilde,              /**< Output: Frequency-domain waveforms h+, one row per parameter set */
+  COMPLEX16VectorSequence *hctilde,              /**< Output: Frequency-domain waveforms hx, one row per parameter set */
+  const REAL8Sequence *freqs,                    /**< Frequency points at which to evaluate the waveforms (Hz) */
+  const LALSimInspiralBatchParams *params,       /**< Parameter sets */
+  UINT4 nparams,                                 /**< Number of parameter sets */
+  REAL8 fRef,                                    /**< Reference frequency (Hz); 0 defaults to fLow */
+  INT4 nk_max                                    /**< Truncate interpolants at SVD mode nk_max; don't truncate if nk_max == -1 */
+)
+{
+  if (!hptilde || !hctilde || !freqs || !params)
+    XLAL_ERROR(XLAL_EFAULT);
+  if (nparams == 0 || freqs->length == 0)
+    XLAL_ERROR(XLAL_EINVAL, "Empty batch of parameters or frequencies");
+  const size_t nfreq = freqs->length;
+  if (hptilde->length != nparams || hptilde->vectorLength != nfreq
+      || hctilde->length != nparams || hctilde->vectorLength != nfreq)
+    XLAL_ERROR(XLAL_EBADLEN, "Output sequences must have %u rows of %zu points", nparams, nfreq);
+
+  // Load ROM data if not loaded already
+#ifdef LAL_PTHREAD_LOCK
+  (void) pthread_once(&SEOBNRv4ROM_is_initialized, SEOBNRv4ROM_Init_LALDATA);
+#else
+  SEOBNRv4ROM_Init_LALDATA();
+#endif
+
+  if(!SEOBNRv4ROM_IsSetup()) {
+    XLAL_ERROR(XLAL_EFAILED,
+               "Error setting up SEOBNRv4ROM data - check your $LAL_DATA_PATH\\n");
+  }
+
+  SEOBNRROMdataDS *romdata=&__lalsim_SEOBNRv4ROMDS_data;
+  SEOBNRROMdataDS_submodel *submodel_lo = romdata->sub1;
+  SEOBNRROMdataDS_submodel *submodel_hi[2] = {romdata->sub2, romdata->sub3};
+  const double Mfm = 0.01; // Gluing frequency: the low and high frequency ROMs overlap here; this is used both for amplitude and phase.
+
+  int errnum = 0;
+  SEOBNRv4ROMBatchPoint *points = XLALCalloc(nparams, sizeof(*points));
+  double *eta = XLALMalloc(3 * nparams * sizeof(double));
+  size_t *idx = XLALMalloc(3 * nparams * sizeof(size_t));
+  size_t m_hi[2] = {0, 0};
+  SEOBNRv4ROMGlue glue[2];
+  gsl_matrix *amp_lo = NULL, *phi_lo = NULL;
+  gsl_matrix *amp_hi[2] = {NULL, NULL}, *phi_hi[2] = {NULL, NULL};
+  memset(glue, 0, sizeof(glue));
+  if (!points || !eta || !idx) {
+    errnum = XLAL_ENOMEM;
+    goto done;
+  }
+  double *chi1 = eta + nparams;
+  double *chi2 = eta + 2*nparams;
+  size_t *idx_hi[2] = {idx + nparams, idx + 2*nparams};
+
+  /* Find frequency bounds */
+  double fLow  = freqs->data[0];
+  double fHigh = freqs->data[nfreq - 1];
+  if(fRef==0.0)
+    fRef=fLow;
+
+  // lowest allowed geometric frequency for ROM
+  double Mf_ROM_min = fmax(gsl_vector_get(submodel_lo->gA, 0),
+                           gsl_vector_get(submodel_lo->gPhi,0));
+  double Mf_ROM_max[2];
+  for (int g=0; g<2; g++)
+    Mf_ROM_max[g] = fmin(gsl_vector_get(submodel_hi[g]->gA, submodel_hi[g]->nk_amp-1),
+                         gsl_vector_get(submodel_hi[g]->gPhi, submodel_hi[g]->nk_phi-1));
+
+  // Per-waveform setup and checks, as XLALSimIMRSEOBNRv4ROMFrequencySequence() and SEOBNRv4ROMCore()
+  for (UINT4 n=0; n<nparams; n++) {
+    SEOBNRv4ROMBatchPoint *pt = &points[n];
+    double m1SI = params[n].m1, m2SI = params[n].m2;
+    chi1[n] = params[n].S1z;
+    chi2[n] = params[n].S2z;
+    /* Internally we need m1 > m2, so change around if this is not the case */
+    if (m1SI < m2SI) {
+      double tmp = m1SI; m1SI = m2SI; m2SI = tmp;
+      tmp = chi1[n]; chi1[n] = chi2[n]; chi2[n] = tmp;
+    }
+    double mass1 = m1SI / LAL_MSUN_SI;
+    double mass2 = m2SI / LAL_MSUN_SI;
+    double Mtot = mass1+mass2;
+    eta[n] = mass1 * mass2 / (Mtot*Mtot);
+    pt->Mtot_sec = Mtot * LAL_MTSUN_SI;
+
+    // 'Nudge' parameter values to allowed boundary values if close by
+    if (eta[n] > 0.25)     nudge(&eta[n], 0.25, 1e-6);
+    if (eta[n] < 0.01)     nudge(&eta[n], 0.01, 1e-6);
+
+    if (chi1[n] < -1.0 || chi2[n] < -1.0 || chi1[n] > 1.0 || chi2[n] > 1.0) {
+      XLALPrintError("XLAL Error - %s: chi1 or chi2 smaller than -1.0 or larger than 1.0!\\n"
+                     "SEOBNRv4ROM is only available for spins in the range -1 <= a/M <= 1.0.\\n",
+                     __func__);
+      errnum = XLAL_EDOM;
+      goto done;
+    }
+    if (eta[n] < 0.01 || eta[n] > 0.25) {
+      XLALPrintError("XLAL Error - %s: eta (%f) smaller than 0.01 or unphysical!\\n"
+                     "SEOBNRv4ROM is only available for eta in the range 0.01 <= eta <= 0.25.\\n",
+                     __func__, eta[n]);
+      errnum = XLAL_EDOM;
+      goto done;
+    }
+
+    /* Select high frequency ROM submodel */
+    int g = (chi1[n] < romdata->sub3->chi1_bounds[0] || eta[n] > romdata->sub3->eta_bounds[1]) ? 0 : 1;
+    pt->hi = g + 2;
+    pt->row_hi = m_hi[g];
+    idx_hi[g][m_hi[g]++] = n;
+    idx[n] = n;
+
+    double fLow_geom = fLow * pt->Mtot_sec;
+    double fHigh_geom = fHigh * pt->Mtot_sec;
+    pt->fRef_geom = fRef * pt->Mtot_sec;
+    if (fLow_geom < Mf_ROM_min) {
+      XLALPrintError("XLAL Error - %s: Starting frequency Mflow=%g is smaller than lowest frequency in ROM Mf=%g.\\n", __func__, fLow_geom, Mf_ROM_min);
+      errnum = XLAL_EDOM;
+      goto done;
+    }
+    if (fHigh_geom == 0 || fHigh_geom > Mf_ROM_max[g])
+      fHigh_geom = Mf_ROM_max[g];
+    else if (fHigh_geom < Mf_ROM_min) {
+      XLALPrintError("XLAL Error - %s: End frequency %g is smaller than ROM starting frequency %g!\\n", __func__, fHigh_geom, Mf_ROM_min);
+      errnum = XLAL_EDOM;
+      goto done;
+    }
+    if (fHigh_geom <= fLow_geom) {
+      XLALPrintError("XLAL Error - %s: End frequency %g is smaller than (or equal to) starting frequency %g!\\n", __func__, fHigh_geom, fLow_geom);
+      errnum = XLAL_EDOM;
+      goto done;
+    }
+    if (pt->fRef_geom > Mf_ROM_max[g]) {
+      XLALPrintWarning("Reference frequency Mf_ref=%g is greater than maximal frequency in ROM Mf=%g. Starting at maximal frequency in ROM.\\n", pt->fRef_geom, Mf_ROM_max[g]);
+      pt->fRef_geom = Mf_ROM_max[g];
+    }
+    if (pt->fRef_geom < Mf_ROM_min) {
+      XLALPrintWarning("Reference frequency Mf_ref=%g is smaller than lowest frequency in ROM Mf=%g. Starting at lowest frequency in ROM.\\n", fLow_geom, Mf_ROM_min);
+      pt->fRef_geom = Mf_ROM_min;
+    }
+    if (Mtot > 500.0)
+      XLALPrintWarning("Total mass=%gMsun > 500Msun. SEOBNRv4ROM disagrees with SEOBNRv4 for high total masses.\\n", Mtot);
+
+    // Get SEOBNRv4 ringdown frequency for 22 mode
+    pt->Mf_final = SEOBNRROM_Ringdown_Mf_From_Mtot_Eta(pt->Mtot_sec, eta[n], chi1[n], chi2[n], SEOBNRv4);
+    if (pt->Mf_final > Mf_ROM_max[g])
+      pt->Mf_final = Mf_ROM_max[g];
+    if (pt->Mf_final < Mf_ROM_min) {
+      XLALPrintError("XLAL Error - %s: f_ringdown < f_min\\n", __func__);
+      errnum = XLAL_EDOM;
+      goto done;
+    }
+
+    REAL8 cosi = cos(params[n].inclination);
+    pt->pcoef = 0.5*(1.0 + cosi*cosi);
+    pt->ccoef = cosi;
+    pt->amp0 = Mtot * pt->Mtot_sec * LAL_MRSUN_SI / (params[n].distance); // Correct overall amplitude to undo mass-dependent scaling used in ROM
+    pt->phiRef = params[n].phiRef;
+  }
+
+  /* Amplitude and phase on the sparse frequency nodes of each submodel */
+  amp_lo = gsl_matrix_alloc(nparams, submodel_lo->Bamp->size2);
+  phi_lo = gsl_matrix_alloc(nparams, submodel_lo->Bphi->size2);
+  if (!amp_lo || !phi_lo) {
+    errnum = XLAL_ENOMEM;
+    goto done;
+  }
+  if (SEOBNRROMdataDS_submodel_NodesBatch(submodel_lo, nparams, idx, eta, chi1, chi2, nk_max, amp_lo, phi_lo) != XLAL_SUCCESS) {
+    errnum = XLAL_EFUNC;
+    goto done;
+  }
+  for (int g=0; g<2; g++) {
+    if (m_hi[g] == 0)
+      continue;
+    amp_hi[g] = gsl_matrix_alloc(m_hi[g], submodel_hi[g]->Bamp->size2);
+    phi_hi[g] = gsl_matrix_alloc(m_hi[g], submodel_hi[g]->Bphi->size2);
+    if (!amp_hi[g] || !phi_hi[g]) {
+      errnum = XLAL_ENOMEM;
+      goto done;
+    }
+    if (SEOBNRROMdataDS_submodel_NodesBatch(submodel_hi[g], m_hi[g], idx_hi[g], eta, chi1, chi2, nk_max, amp_hi[g], phi_hi[g]) != XLAL_SUCCESS
+        || SEOBNRv4ROMGlue_Init(&glue[g], submodel_lo, submodel_hi[g], Mfm) != XLAL_SUCCESS) {
+      errnum = XLAL_EFUNC;
+      goto done;
+    }
+  }
+
+  /* Glue and assemble the waveforms */
+  size_t ncoef = 4 * submodel_lo->nk_phi;
+  for (int g=0; g<2; g++)
+    if (m_hi[g])
+      ncoef += 4 * (glue[g].nA + glue[g].nP);
+  int failed = 0;
+  #pragma omp parallel
+  {
+    double *coef = XLALMalloc(ncoef * sizeof(double));
+    size_t *ia = XLALMalloc(2 * nfreq * sizeof(size_t));
+    if (!coef || !ia) {
+      #pragma omp atomic write
+      failed = 1;
+    }
+
+    #pragma omp for schedule(dynamic)
+    for (UINT4 n=0; n<nparams; n++) {
+      int stop;
+      #pragma omp atomic read
+      stop = failed;
+      if (stop) continue;
+
+      const SEOBNRv4ROMBatchPoint *pt = &points[n];
+      const int g = pt->hi - 2;
+      double *coef_amp = coef;
+      double *coef_phi = coef_amp + 4 * glue[g].nA;
+      double *coef_lo = coef_phi + 4 * glue[g].nP;
+      SEOBNRv4ROMGlue_Splines(&glue[g],
+        gsl_matrix_const_ptr(amp_lo, n, 0), gsl_matrix_const_ptr(phi_lo, n, 0),
+        gsl_matrix_const_ptr(amp_hi[g], pt->row_hi, 0), gsl_matrix_const_ptr(phi_hi[g], pt->row_hi, 0),
+        Mfm, coef_amp, coef_phi, coef_lo);
+      SEOBNRv4ROM_AssembleBatchPoint(hptilde->data + (size_t)n * nfreq, hctilde->data + (size_t)n * nfreq,
+        freqs->data, nfreq, pt, &glue[g], coef_amp, coef_phi, Mf_ROM_max[g], ia, ia + nfreq);
+    }
+
+    XLALFree(coef);
+    XLALFree(ia);
+  }
+  if (failed)
+    errnum = XLAL_ENOMEM;
+
+done:
+  for (int g=0; g<2; g++) {
+    SEOBNRv4ROMGlue_Cleanup(&glue[g]);
+    if (amp_hi[g]) gsl_matrix_free(amp_hi[g]);
+    if (phi_hi[g]) gsl_matrix_free(phi_hi[g]);
+  }
+  if (amp_lo) gsl_matrix_free(amp_lo);
+  if (phi_lo) gsl_matrix_free(phi_lo);
+  XLALFree(idx);
+  XLALFree(eta);
+  XLALFree(points);
+  if (errnum)
+    XLAL_ERROR(errnum);
+  return XLAL_SUCCESS;
+}
+
 /**
  * Compute waveform in LAL format for the SEOBNRv4_ROM model.
  *
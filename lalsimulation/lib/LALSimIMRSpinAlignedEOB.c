@@ -69,6 +69,8 @@
 #define UNUSED
 #endif
 
+static int SpinAlignedEOBWaveformAll(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, const REAL8 phiC, REAL8 deltaT, const REAL8 m1SI, const REAL8 m2SI, const REAL8 fMin, const REAL8 r, const REAL8 inc, const REAL8 spin1z, const REAL8 spin2z, UINT4 SpinAlignedEOBversion, const REAL8 lambda2Tidal1, const REAL8 lambda2Tidal2, const REAL8 omega02Tidal1, const REAL8 omega02Tidal2, const REAL8 lambda3Tidal1, const REAL8 lambda3Tidal2, const REAL8 omega03Tidal1, const REAL8 omega03Tidal2, const REAL8 quadparam1, const REAL8 quadparam2, REAL8Vector *nqcCoeffsInput, const INT4 nqcFlag, LALValue *ModeArray, const INT4 useDenseOutput);
+
 
 /**
  * ModeArray is a structure which allows to select the modes to include
@@ -576,6 +578,9 @@ XLALSimIMRSpinAlignedEOBWaveform (REAL8TimeSeries ** hplus,	     /**<< OUTPUT, +
   quadparam1 = 1. + XLALSimInspiralWaveformParamsLookupdQuadMon1(LALParams);
   quadparam2 = 1. + XLALSimInspiralWaveformParamsLookupdQuadMon2(LALParams);
 
+  /* SEOBNRv4 can optionally be integrated with a dense-output stepper */
+  INT4 useDenseOutput = XLALSimInspiralWaveformParamsLookupEOBUseDenseOutput(LALParams);
+
   LALValue *ModeArray = XLALSimInspiralWaveformParamsLookupModeArray(LALParams);
   /*ModeArray includes the modes chosen by the user
   */
@@ -606,8 +611,8 @@ XLALSimIMRSpinAlignedEOBWaveform (REAL8TimeSeries ** hplus,	     /**<< OUTPUT, +
 #if debugOutput
       printf("First run SEOBNRv4 to compute NQCs\n");
 #endif
-      ret = XLALSimIMRSpinAlignedEOBWaveformAll (hplus, hcross, phiC, 1./32768, m1BH, m2BH, 2*pow(10.,-1.5)/(2.*LAL_PI)/((m1BH + m2BH)*LAL_MTSUN_SI/LAL_MSUN_SI), r, inc, spin1z, spin2z, 400,
-					 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, nqcCoeffsInput, nqcFlag, ModeArray);
+      ret = SpinAlignedEOBWaveformAll (hplus, hcross, phiC, 1./32768, m1BH, m2BH, 2*pow(10.,-1.5)/(2.*LAL_PI)/((m1BH + m2BH)*LAL_MTSUN_SI/LAL_MSUN_SI), r, inc, spin1z, spin2z, 400,
+					 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, nqcCoeffsInput, nqcFlag, ModeArray, 0);
       if (ret == XLAL_FAILURE){
         if ( nqcCoeffsInput ) XLALDestroyREAL8Vector( nqcCoeffsInput );
         if(ModeArray) XLALDestroyValue(ModeArray);
@@ -621,14 +626,14 @@ XLALSimIMRSpinAlignedEOBWaveform (REAL8TimeSeries ** hplus,	     /**<< OUTPUT, +
     {
       //REAL8Vector *nqcCoeffsInput = XLALCreateREAL8Vector(10);
       //INT4 nqcFlag = 0;
-      ret = XLALSimIMRSpinAlignedEOBWaveformAll (hplus, hcross,
+      ret = SpinAlignedEOBWaveformAll (hplus, hcross,
                                                  phiC, deltaT, m1SI, m2SI, fMin, r, inc, spin1z, spin2z, SpinAlignedEOBversion,
                                                  lambda2Tidal1, lambda2Tidal2,
                                                  omega02Tidal1, omega02Tidal2,
                                                  lambda3Tidal1, lambda3Tidal2,
                                                  omega03Tidal1, omega03Tidal2,
                                                  quadparam1, quadparam2,
-                                                 nqcCoeffsInput, nqcFlag, ModeArray);
+                                                 nqcCoeffsInput, nqcFlag, ModeArray, useDenseOutput);
      if (ret == XLAL_FAILURE){
        if ( nqcCoeffsInput ) XLALDestroyREAL8Vector( nqcCoeffsInput );
        if (ModeArray) XLALDestroyValue(ModeArray);
@@ -668,9 +673,12 @@ XLALSimIMRSpinAlignedEOBWaveform (REAL8TimeSeries ** hplus,	     /**<< OUTPUT, +
  * will not fail on Sz=[-0.7,0.7], but with possibly stronger unwanted features.
  * The initial conditions solver can also fail for low starting frequencies,
  * with a failure rate of ~0.3% at fmin=10Hz for M=3Msol.
+ * If useDenseOutput is non-zero, SEOBNRv4 samples its dynamics with the
+ * continuous extension of a Dormand-Prince stepper instead of
+ * interpolating the adaptive Runge-Kutta steps.
  */
-int
-XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
+static int
+SpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
 				     /**<< OUTPUT, mode hlm */
              //SM
              REAL8Vector ** dynamics_out, /**<< OUTPUT, low-sampling dynamics */
@@ -714,8 +722,10 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
                      /**<< parameter kappa_2 of the spin-induced quadrupole for body 2, quadrupole is Q_A = -kappa_A m_A^3 chi_A^2 */
                      REAL8Vector *nqcCoeffsInput,
                      /**<< Input NQC coeffs */
-                     const INT4 nqcFlag
+                     const INT4 nqcFlag,
                      /**<< Flag to tell the code to use the NQC coeffs input thorugh nqcCoeffsInput */
+                     const INT4 useDenseOutput
+                     /**<< Flag to integrate SEOBNRv4 with dense output */
   )
 {
   REAL8 STEP_SIZE = STEP_SIZE_CALCOMEGA;
@@ -758,6 +768,7 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
           SpinAlignedEOBversion=4;
     }
   INT4 use_optimized_v2_or_v4 = 0;
+  INT4 use_dense_output = 0;
   /* If we want SEOBNRv2_opt, then reset SpinAlignedEOBversion=2 and set use_optimized_v2_or_v4=1 */
   if (SpinAlignedEOBversion == 200)
     {
@@ -1462,6 +1473,22 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
                 XLAL_ERROR (XLAL_EFUNC);
             }
         }
+        else if (SpinAlignedEOBversion == 4 && !use_hm && useDenseOutput)
+        {
+            /* On request, SEOBNRv4 samples the dynamics directly from the
+             * continuous extension of a Dormand-Prince stepper, see below.
+             * This is not the reviewed integrator, so it is opt-in only. */
+            if (!
+                (integrator =
+                 XLALAdaptiveRungeKuttaDormandPrinceInit (4, XLALSpinAlignedHcapDerivative,
+					XLALEOBSpinAlignedStopCondition,
+					EPS_ABS, EPS_REL)))
+            {
+                XLALDestroyREAL8Vector (values);
+                XLAL_ERROR (XLAL_EFUNC);
+            }
+            use_dense_output = 1;
+        }
         else
         {
             if (!
@@ -1499,6 +1526,13 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
 						 &dynamics);
       /* END OPTIMIZED */
     }
+  else if (use_dense_output)
+    {
+      retLen =
+	XLALAdaptiveRungeKuttaDenseOutput (integrator, &seobParams, values->data, 0.,
+					   20. / mTScaled, deltaT / mTScaled,
+					   &dynamics);
+    }
   else
     {
       retLen =
@@ -1597,6 +1631,13 @@ XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode,
 						 &dynamicsHi);
       /* END OPTIMIZED */
     }
+  else if (use_dense_output)
+    {
+      retLen =
+	XLALAdaptiveRungeKuttaDenseOutput (integrator, &seobParams, values->data, 0.,
+					   20. / mTScaled, deltaTHigh / mTScaled,
+					   &dynamicsHi);
+    }
   else
     {
       retLen =
@@ -3134,11 +3175,11 @@ for ( UINT4 k = 0; k<nModes; k++) {
     }
 
 /**
- * This function takes the modes from the function XLALSimIMRSpinAlignedEOBModes and combine them into h+ and hx
+ * This function takes the modes from the function SpinAlignedEOBModes and combine them into h+ and hx
  */
 
-int
-XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
+static int
+SpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
 				     /**<< OUTPUT, real part of the modes */
 				     REAL8TimeSeries ** hcross,
 				     /**<< OUTPUT, complex part of the modes */
@@ -3186,8 +3227,10 @@ XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
                      /**<< Input NQC coeffs */
                      const INT4 nqcFlag,
                      /**<< Flag to tell the code to use the NQC coeffs input thorugh nqcCoeffsInput */
-            LALValue *ModeArray
+            LALValue *ModeArray,
             /**<< Structure containing the modes to use in the waveform */
+            const INT4 useDenseOutput
+            /**<< Flag to integrate SEOBNRv4 with dense output */
   )
   {
 
@@ -3199,9 +3242,9 @@ XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
     REAL8Vector *dynamicsHi = NULL;
     //SM
 
-    //RC: XLALSimIMRSpinAlignedEOBModes computes the modes and put them into hlm
+    //RC: SpinAlignedEOBModes computes the modes and put them into hlm
 
-    if(XLALSimIMRSpinAlignedEOBModes (&hlms,
+    if(SpinAlignedEOBModes (&hlms,
                                    //SM
                                    &dynamics, &dynamicsHi,
                                    //SM
@@ -3211,7 +3254,7 @@ XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
                                                lambda3Tidal1, lambda3Tidal2,
                                                omega03Tidal1, omega03Tidal2,
                                                quadparam1, quadparam2,
-                                               nqcCoeffsInput, nqcFlag) == XLAL_FAILURE){
+                                               nqcCoeffsInput, nqcFlag, useDenseOutput) == XLAL_FAILURE){
                                                  if(dynamics) XLALDestroyREAL8Vector(dynamics);
                                                  if(dynamicsHi) XLALDestroyREAL8Vector(dynamicsHi);
                                                  XLAL_ERROR (XLAL_EFUNC);
@@ -3272,4 +3315,24 @@ XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus,
     return XLAL_SUCCESS;
   }
 
+/**
+ * This function generates the spin-aligned SEOBNR complex modes hlm and
+ * the dynamics as described for SpinAlignedEOBModes(), integrating
+ * SEOBNRv4 with the reviewed adaptive Runge-Kutta integrator.
+ */
+int
+XLALSimIMRSpinAlignedEOBModes (SphHarmTimeSeries ** hlmmode, REAL8Vector ** dynamics_out, REAL8Vector ** dynamicsHi_out, REAL8 deltaT, const REAL8 m1SI, const REAL8 m2SI, const REAL8 fMin, const REAL8 r, const REAL8 spin1z, const REAL8 spin2z, UINT4 SpinAlignedEOBversion, const REAL8 lambda2Tidal1, const REAL8 lambda2Tidal2, const REAL8 omega02Tidal1, const REAL8 omega02Tidal2, const REAL8 lambda3Tidal1, const REAL8 lambda3Tidal2, const REAL8 omega03Tidal1, const REAL8 omega03Tidal2, const REAL8 quadparam1, const REAL8 quadparam2, REAL8Vector *nqcCoeffsInput, const INT4 nqcFlag)
+{
+  return SpinAlignedEOBModes (hlmmode, dynamics_out, dynamicsHi_out, deltaT, m1SI, m2SI, fMin, r, spin1z, spin2z, SpinAlignedEOBversion, lambda2Tidal1, lambda2Tidal2, omega02Tidal1, omega02Tidal2, lambda3Tidal1, lambda3Tidal2, omega03Tidal1, omega03Tidal2, quadparam1, quadparam2, nqcCoeffsInput, nqcFlag, 0);
+}
+
+/**
+ * This function takes the modes from the function XLALSimIMRSpinAlignedEOBModes and combine them into h+ and hx
+ */
+int
+XLALSimIMRSpinAlignedEOBWaveformAll (REAL8TimeSeries ** hplus, REAL8TimeSeries ** hcross, const REAL8 phiC, REAL8 deltaT, const REAL8 m1SI, const REAL8 m2SI, const REAL8 fMin, const REAL8 r, const REAL8 inc, const REAL8 spin1z, const REAL8 spin2z, UINT4 SpinAlignedEOBversion, const REAL8 lambda2Tidal1, const REAL8 lambda2Tidal2, const REAL8 omega02Tidal1, const REAL8 omega02Tidal2, const REAL8 lambda3Tidal1, const REAL8 lambda3Tidal2, const REAL8 omega03Tidal1, const REAL8 omega03Tidal2, const REAL8 quadparam1, const REAL8 quadparam2, REAL8Vector *nqcCoeffsInput, const INT4 nqcFlag, LALValue *ModeArray)
+{
+  return SpinAlignedEOBWaveformAll (hplus, hcross, phiC, deltaT, m1SI, m2SI, fMin, r, inc, spin1z, spin2z, SpinAlignedEOBversion, lambda2Tidal1, lambda2Tidal2, omega02Tidal1, omega02Tidal2, lambda3Tidal1, lambda3Tidal2, omega03Tidal1, omega03Tidal2, quadparam1, quadparam2, nqcCoeffsInput, nqcFlag, ModeArray, 0);
+}
+
 /** @} */
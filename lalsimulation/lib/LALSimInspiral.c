@@ -4025,12 +4025,9 @@ int XLALSimInspiralPolarizationsFromSphHarmTimeSeries(
                 ts->mode->deltaT, &lalStrainUnit, length);
     memset( (*hp)->data->data, 0, (*hp)->data->length*sizeof(REAL8) );
     memset( (*hc)->data->data, 0, (*hc)->data->length*sizeof(REAL8) );
-    while (ts) { // Add the contribution from the current mode to hp, hx...
-        // This function adds hlm(t) * Y_lm(incl,phiRef) to (h+ - i hx)(t)
-        ret = XLALSimAddMode(*hp, *hc, ts->mode, iota, phiRef, ts->l, ts->m, 0);
-        if( ret != XLAL_SUCCESS ) XLAL_ERROR(XLAL_EFUNC);
-        ts = ts->next;
-    }
+    // Add hlm(t) * Y_lm(incl,phiRef) of all modes to (h+ - i hx)(t) in one pass
+    ret = XLALSimAddSphHarmTimeSeries(*hp, *hc, hlms, iota, phiRef, NULL, 0);
+    if( ret != XLAL_SUCCESS ) XLAL_ERROR(XLAL_EFUNC);
 
     return XLAL_SUCCESS;
 }
@@ -521,6 +521,28 @@ typedef struct tagPNPhasingSeries
 }
 PNPhasingSeries;
 
+/**
+ * Per-waveform parameters for the batched frequency-domain interface
+ * XLALSimInspiralChooseFDWaveformSequenceBatch().  Masses are in kg and
+ * the distance in m; all other flags and parameters are shared by the
+ * batch and passed through a single LALDict.
+ */
+typedef struct tagLALSimInspiralBatchParams
+{
+    REAL8 phiRef;       /**< reference orbital phase (rad) */
+    REAL8 m1;           /**< mass of companion 1 (kg) */
+    REAL8 m2;           /**< mass of companion 2 (kg) */
+    REAL8 S1x;          /**< x-component of the dimensionless spin of object 1 */
+    REAL8 S1y;          /**< y-component of the dimensionless spin of object 1 */
+    REAL8 S1z;          /**< z-component of the dimensionless spin of object 1 */
+    REAL8 S2x;          /**< x-component of the dimensionless spin of object 2 */
+    REAL8 S2y;          /**< y-component of the dimensionless spin of object 2 */
+    REAL8 S2z;          /**< z-component of the dimensionless spin of object 2 */
+    REAL8 distance;     /**< distance of source (m) */
+    REAL8 inclination;  /**< inclination of source (rad) */
+}
+LALSimInspiralBatchParams;
+
 /** @} */
 
 /* general waveform switching generation routines  */
@@ -698,6 +720,7 @@ int XLALHGimriGenerator(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, REAL8
 int XLALSimInspiralTaylorF2AlignedPhasing(PNPhasingSeries **pfa, const REAL8 m1, const REAL8 m2, const REAL8 chi1, const REAL8 chi2, LALDict *extraPars);
 int XLALSimInspiralTaylorF2AlignedPhasingArray(REAL8Vector **phasingvals, REAL8Vector mass1, REAL8Vector mass2, REAL8Vector chi1, REAL8Vector chi2, REAL8Vector lambda1, REAL8Vector lambda2, REAL8Vector dquadmon1, REAL8Vector dquadmon2);
 int XLALSimInspiralTaylorF2Core(COMPLEX16FrequencySeries **htilde, const REAL8Sequence *freqs, const REAL8 phi_ref, const REAL8 m1_SI, const REAL8 m2_SI, const REAL8 f_ref, const REAL8 shft, const REAL8 r, LALDict *LALparams, PNPhasingSeries *pfaP);
+int XLALSimInspiralTaylorF2CoreBatch(COMPLEX16VectorSequence *htilde, const REAL8Sequence *freqs, const LALSimInspiralBatchParams *params, const PNPhasingSeries *pfa, const UINT4 nparams, const REAL8 f_ref, const REAL8 shft, LALDict *LALparams);
 
 int XLALSimInspiralTaylorF2(COMPLEX16FrequencySeries **htilde, const REAL8 phi_ref, const REAL8 deltaF, const REAL8 m1_SI, const REAL8 m2_SI, const REAL8 S1z, const REAL8 S2z, const REAL8 fStart, const REAL8 fEnd, const REAL8 f_ref, const REAL8 r, LALDict *LALpars);
 
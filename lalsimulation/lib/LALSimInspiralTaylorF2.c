@@ -484,6 +484,161 @@ int XLALSimInspiralTaylorF2Core(
     return XLAL_SUCCESS;
 }
 
+/**
+ * Batched version of XLALSimInspiralTaylorF2Core() for several parameter
+ * sets sharing one frequency grid.
+ *
+ * Row n of htilde (which must have nparams rows of freqs->length points)
+ * receives the optimally-oriented waveform for params[n] with phasing
+ * coefficients pfa[n].  The PN order selection and the powers and
+ * logarithms of the frequency grid are computed once for the batch, so
+ * the per-point work is reduced to the phasing polynomial and one
+ * sine/cosine pair.  Parameter sets are distributed over OpenMP threads
+ * and the frequency loop is vectorised.  The spins enter only through
+ * pfa, and the inclination-dependent polarisation factors are left to
+ * the caller.
+ */
+int XLALSimInspiralTaylorF2CoreBatch(
+        COMPLEX16VectorSequence *htilde,       /**< FD waveforms, one row per parameter set */
+        const REAL8Sequence *freqs,            /**< frequency points at which to evaluate the waveforms (Hz) */
+        const LALSimInspiralBatchParams *params, /**< parameter sets */
+        const PNPhasingSeries *pfa,            /**< phasing coefficients, one per parameter set */
+        const UINT4 nparams,                   /**< number of parameter sets */
+        const REAL8 f_ref,                     /**< Reference GW frequency (Hz) - if 0 reference point is coalescence */
+        const REAL8 shft,                      /**< time shift to be applied to frequency-domain phase (sec)*/
+        LALDict *p                             /**< Linked list containing the extra testing GR parameters >*/
+        )
+{
+    if (!htilde || !freqs || !params || !pfa) XLAL_ERROR(XLAL_EFAULT);
+    if (htilde->length != nparams || htilde->vectorLength != freqs->length)
+        XLAL_ERROR(XLAL_EBADLEN, "Output has %u x %u points, expected %u x %u", htilde->length, htilde->vectorLength, nparams, freqs->length);
+    if (f_ref < 0) XLAL_ERROR(XLAL_EDOM);
+
+    /* Highest phasing and tidal orders retained, as in XLALSimInspiralTaylorF2Core() */
+    INT4 phaseO = XLALSimInspiralWaveformParamsLookupPNPhaseOrder(p);
+    if (phaseO == -1) phaseO = 7;
+    if (phaseO < 0 || phaseO > 7)
+        XLAL_ERROR(XLAL_ETYPE, "Invalid phase PN order %d", phaseO);
+
+    INT4 amplitudeO = XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(p);
+    if (amplitudeO == -1) amplitudeO = 0;
+    if (amplitudeO < 0 || amplitudeO == 1 || amplitudeO > 7)
+        XLAL_ERROR(XLAL_ETYPE, "Invalid amplitude PN order %d", amplitudeO);
+
+    INT4 tidalO = XLALSimInspiralWaveformParamsLookupPNTidalOrder(p);
+    switch (tidalO)
+    {
+        case LAL_SIM_INSPIRAL_TIDAL_ORDER_DEFAULT:
+            tidalO = LAL_SIM_INSPIRAL_TIDAL_ORDER_7PN;
+            break;
+        case LAL_SIM_INSPIRAL_TIDAL_ORDER_75PN:
+        case LAL_SIM_INSPIRAL_TIDAL_ORDER_7PN:
+        case LAL_SIM_INSPIRAL_TIDAL_ORDER_65PN:
+        case LAL_SIM_INSPIRAL_TIDAL_ORDER_6PN:
+        case LAL_SIM_INSPIRAL_TIDAL_ORDER_5PN:
+        case LAL_SIM_INSPIRAL_TIDAL_ORDER_0PN:
+            break;
+        default:
+            XLAL_ERROR(XLAL_EINVAL, "Invalid tidal PN order %d", tidalO);
+    }
+
+    for (UINT4 n = 0; n < nparams; n++) {
+        if (params[n].m1 <= 0) XLAL_ERROR(XLAL_EDOM);
+        if (params[n].m2 <= 0) XLAL_ERROR(XLAL_EDOM);
+        if (params[n].distance <= 0) XLAL_ERROR(XLAL_EDOM);
+    }
+
+    /* Quantities shared by the whole batch: v = (pi M)^(1/3) f^(1/3) */
+    const UINT4 nfreq = freqs->length;
+    REAL8 *cbrtf = XLALMalloc(nfreq * sizeof(REAL8));
+    REAL8 *logf3 = XLALMalloc(nfreq * sizeof(REAL8));
+    if (nfreq && (!cbrtf || !logf3)) {
+        XLALFree(cbrtf);
+        XLALFree(logf3);
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+    for (UINT4 i = 0; i < nfreq; i++) {
+        cbrtf[i] = cbrt(freqs->data[i]);
+        logf3[i] = log(freqs->data[i]) / 3.;
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for (UINT4 n = 0; n < nparams; n++) {
+        const REAL8 m1 = params[n].m1 / LAL_MSUN_SI;
+        const REAL8 m2 = params[n].m2 / LAL_MSUN_SI;
+        const REAL8 m = m1 + m2;
+        const REAL8 eta = m1 * m2 / (m * m);
+        const REAL8 piM = LAL_PI * m * LAL_MTSUN_SI;
+        const REAL8 cbrtpiM = cbrt(piM);
+        const REAL8 logcbrtpiM = log(cbrtpiM);
+        const REAL8 amp0 = -4. * m1 * m2 / params[n].distance * LAL_MRSUN_SI * LAL_MTSUN_SI * sqrt(LAL_PI/12.L);
+
+        /* Truncated phasing coefficients */
+        REAL8 a[16] = {0.}, l5 = 0., l6 = 0.;
+        for (INT4 k = 0; k <= phaseO; k++)
+            a[k] = pfa[n].v[k];
+        if (phaseO >= 5) l5 = pfa[n].vlogv[5];
+        if (phaseO >= 6) l6 = pfa[n].vlogv[6];
+        for (INT4 k = 10; k <= 15; k++)
+            if (k != 11 && k <= tidalO)
+                a[k] = pfa[n].v[k];
+
+        /* Truncated SPA amplitude coefficients */
+        const REAL8 FTaN = XLALSimInspiralPNFlux_0PNCoeff(eta);
+        const REAL8 FTa2 = amplitudeO >= 2 ? XLALSimInspiralPNFlux_2PNCoeff(eta) : 0.;
+        const REAL8 FTa3 = amplitudeO >= 3 ? XLALSimInspiralPNFlux_3PNCoeff(eta) : 0.;
+        const REAL8 FTa4 = amplitudeO >= 4 ? XLALSimInspiralPNFlux_4PNCoeff(eta) : 0.;
+        const REAL8 FTa5 = amplitudeO >= 5 ? XLALSimInspiralPNFlux_5PNCoeff(eta) : 0.;
+        const REAL8 FTl6 = amplitudeO >= 6 ? XLALSimInspiralPNFlux_6PNLogCoeff(eta) : 0.;
+        const REAL8 FTa6 = amplitudeO >= 6 ? XLALSimInspiralPNFlux_6PNCoeff(eta) : 0.;
+        const REAL8 FTa7 = amplitudeO >= 7 ? XLALSimInspiralPNFlux_7PNCoeff(eta) : 0.;
+        const REAL8 dETaN = 2. * XLALSimInspiralPNEnergy_0PNCoeff(eta);
+        const REAL8 dETa1 = amplitudeO >= 2 ? 2. * XLALSimInspiralPNEnergy_2PNCoeff(eta) : 0.;
+        const REAL8 dETa2 = amplitudeO >= 4 ? 3. * XLALSimInspiralPNEnergy_4PNCoeff(eta) : 0.;
+        const REAL8 dETa3 = amplitudeO >= 6 ? 4. * XLALSimInspiralPNEnergy_6PNCoeff(eta) : 0.;
+
+        REAL8 ref_phasing = 0.;
+        if (f_ref != 0.) {
+            const REAL8 v = cbrt(piM*f_ref);
+            const REAL8 logv = log(v);
+            const REAL8 v2 = v * v, v3 = v * v2, v4 = v * v3, v5 = v * v4;
+            const REAL8 v6 = v * v5, v7 = v * v6, v10 = v5 * v5;
+            ref_phasing = a[0] + a[1] * v + a[2] * v2 + a[3] * v3 + a[4] * v4
+                + (a[5] + l5 * logv) * v5 + (a[6] + l6 * logv) * v6 + a[7] * v7
+                + v10 * (a[10] + v2 * (a[12] + v * (a[13] + v * (a[14] + v * a[15]))));
+            ref_phasing /= v5;
+        }
+        const REAL8 phase0 = - 2.*params[n].phiRef - ref_phasing - LAL_PI_4;
+
+        COMPLEX16 *data = htilde->data + (size_t) n * nfreq;
+
+        #pragma omp simd
+        for (UINT4 i = 0; i < nfreq; i++) {
+            const REAL8 v = cbrtpiM * cbrtf[i];
+            const REAL8 logv = logcbrtpiM + logf3[i];
+            const REAL8 v2 = v * v, v3 = v * v2, v4 = v * v3, v5 = v * v4;
+            const REAL8 v6 = v * v5, v7 = v * v6, v10 = v5 * v5;
+
+            REAL8 phasing = a[0] + a[1] * v + a[2] * v2 + a[3] * v3 + a[4] * v4
+                + (a[5] + l5 * logv) * v5 + (a[6] + l6 * logv) * v6 + a[7] * v7
+                + v10 * (a[10] + v2 * (a[12] + v * (a[13] + v * (a[14] + v * a[15]))));
+            phasing /= v5;
+            // Note the factor of 2 b/c phi_ref is orbital phase
+            phasing += shft * freqs->data[i] + phase0;
+
+            const REAL8 flux = FTaN * v10 * (1. + FTa2 * v2 + FTa3 * v3 + FTa4 * v4
+                + FTa5 * v5 + (FTa6 + FTl6 * logv) * v6 + FTa7 * v7);
+            const REAL8 dEnergy = dETaN * v * (1. + dETa1 * v2 + dETa2 * v4 + dETa3 * v6);
+            const REAL8 amp = amp0 * sqrt(-dEnergy/flux) * v;
+            data[i] = crect(amp * cos(phasing), - amp * sin(phasing));
+        }
+    }
+
+    XLALFree(cbrtf);
+    XLALFree(logf3);
+    return XLAL_SUCCESS;
+}
+
 /**
  * Computes the stationary phase approximation to the Fourier transform of
  * a chirp waveform. The amplitude is given by expanding \f$1/\sqrt{\dot{F}}\f$.
@@ -18,17 +18,25 @@
  */
 
 #include <math.h>
+#include <string.h>
 #include <LALSimInspiralWaveformCache.h>
 #include <lal/LALSimInspiral.h>
 #include <lal/LALSimIMR.h>
 #include <lal/FrequencySeries.h>
 #include <lal/Sequence.h>
+#include <lal/SeqFactories.h>
+#include <lal/LALDict.h>
+#include <lal/LALHashFunc.h>
 #include <lal/LALConstants.h>
 #include <lal/LALSimInspiralEOS.h>
 
 #include "check_waveform_macros.h"
 #include "LALSimInspiralPNCoefficients.c"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 /**
  * Bitmask enumerating which parameters have changed, to determine
  * if the requested waveform can be transformed from a cached waveform
@@ -61,6 +69,35 @@ static int FrequenciesAreDifferent(
         REAL8Sequence *newFrequencies,
         REAL8Sequence *cachedFrequencies);
 
+static UINT8 CacheKey(
+        REAL8 deltaTF,
+        REAL8 m1,
+        REAL8 m2,
+        REAL8 S1x, REAL8 S1y, REAL8 S1z,
+        REAL8 S2x, REAL8 S2y, REAL8 S2z,
+        REAL8 f_min, REAL8 f_ref, REAL8 f_max,
+        LALDict *LALpars,
+        Approximant approximant,
+        REAL8Sequence *frequencies);
+
+static CacheVariableDiffersBitmask CacheLookup(
+        LALSimInspiralWaveformCache *cache,
+        CacheVariableDiffersBitmask changedParams,
+        REAL8 phiRef,
+        REAL8 deltaTF,
+        REAL8 m1,
+        REAL8 m2,
+        REAL8 S1x, REAL8 S1y, REAL8 S1z,
+        REAL8 S2x, REAL8 S2y, REAL8 S2z,
+        REAL8 f_min, REAL8 f_ref, REAL8 f_max,
+        REAL8 r,
+        REAL8 i,
+        LALDict *LALpars,
+        Approximant approximant,
+        REAL8Sequence *frequencies);
+
+static void CacheEvict(LALSimInspiralWaveformCache *cache);
+
 static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
         REAL8TimeSeries *hplus,
         REAL8TimeSeries *hcross,
@@ -105,6 +142,9 @@ static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
  * waveform and its parameters are stored. If the next call requests a waveform
  * that can be obtained by a simple transformation, then it is done.
  * This bypasses the waveform generation and speeds up the code.
+ * Caches created with XLALCreateSimInspiralWaveformCacheLRU() also keep
+ * older waveforms and reuse whichever matches the requested intrinsic
+ * parameters.
  */
 int XLALSimInspiralChooseTDWaveformFromCache(
         REAL8TimeSeries **hplus,                /**< +-polarization waveform */
@@ -146,6 +186,11 @@ int XLALSimInspiralChooseTDWaveformFromCache(
             m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, 0., r, i,
             LALpars, approximant, NULL);
 
+    // Look for a stored waveform with the same intrinsic parameters
+    changedParams = CacheLookup(cache, changedParams, phiRef, deltaT,
+            m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, 0., r, i,
+            LALpars, approximant, NULL);
+
     // No parameters have changed! Copy the cached polarizations
     if( changedParams == NO_DIFFERENCE ) {
         *hplus = XLALCutREAL8TimeSeries(cache->hplus, 0,
@@ -421,6 +466,9 @@ int XLALSimInspiralChooseTDWaveformFromCache(
  * waveform and its parameters are stored. If the next call requests a waveform
  * that can be obtained by a simple transformation, then it is done.
  * This bypasses the waveform generation and speeds up the code.
+ * Caches created with XLALCreateSimInspiralWaveformCacheLRU() also keep
+ * older waveforms and reuse whichever matches the requested intrinsic
+ * parameters.
  */
 int XLALSimInspiralChooseFDWaveformFromCache(
         COMPLEX16FrequencySeries **hptilde,     /**< +-polarization waveform */
@@ -473,6 +521,11 @@ int XLALSimInspiralChooseFDWaveformFromCache(
             m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i,
 	    LALpars, approximant, frequencies);
 
+    // Look for a stored waveform with the same intrinsic parameters
+    changedParams = CacheLookup(cache, changedParams, phiRef, deltaF,
+            m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i,
+            LALpars, approximant, frequencies);
+
     // No parameters have changed! Copy the cached polarizations
     if( changedParams == NO_DIFFERENCE ) {
         *hptilde = XLALCutCOMPLEX16FrequencySeries(cache->hptilde, 0,
@@ -621,25 +674,108 @@ LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCache()
 {
     LALSimInspiralWaveformCache *cache = XLALCalloc(1,
             sizeof(LALSimInspiralWaveformCache));
+    if (cache) cache->capacity = 1;
 
     return cache;
 }
 
+/**
+ * Construct a waveform cache holding up to capacity waveforms.
+ *
+ * When the intrinsic parameters of a request do not match the most
+ * recent waveform, the older waveforms are searched (by a hash of the
+ * approximant, intrinsic parameters, flags and frequency grid, then by
+ * full comparison) and a match is reused, with the usual extrinsic
+ * transformations.  Otherwise a new waveform is generated and the least
+ * recently used waveforms are discarded until at most capacity remain
+ * and, if max_bytes is non-zero, they occupy at most max_bytes.  The
+ * most recent waveform is always kept.
+ */
+LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCacheLRU(
+        UINT4 capacity,         /**< maximum number of stored waveforms */
+        size_t max_bytes        /**< maximum memory used by stored waveforms, 0 for no limit */
+        )
+{
+    if (capacity < 1) XLAL_ERROR_NULL(XLAL_EINVAL, "Cache capacity must be at least 1");
+    LALSimInspiralWaveformCache *cache = XLALCreateSimInspiralWaveformCache();
+    if (!cache) XLAL_ERROR_NULL(XLAL_ENOMEM);
+    cache->capacity = capacity;
+    cache->max_bytes = max_bytes;
+    return cache;
+}
+
+/* Free the waveform and parameters held by one cache entry */
+static void ClearCacheEntry(LALSimInspiralWaveformCache *entry)
+{
+    XLALDestroyREAL8TimeSeries(entry->hplus);
+    XLALDestroyREAL8TimeSeries(entry->hcross);
+    XLALDestroyCOMPLEX16FrequencySeries(entry->hptilde);
+    XLALDestroyCOMPLEX16FrequencySeries(entry->hctilde);
+    XLALDestroyREAL8Sequence(entry->frequencies);
+    if(entry->LALpars) XLALDestroyDict(entry->LALpars);
+    entry->hplus = entry->hcross = NULL;
+    entry->hptilde = entry->hctilde = NULL;
+    entry->frequencies = NULL;
+    entry->LALpars = NULL;
+}
+
 /**
  * Destroy a waveform cache.
  */
 void XLALDestroySimInspiralWaveformCache(LALSimInspiralWaveformCache *cache)
 {
-    if (cache != NULL) {
-        XLALDestroyREAL8TimeSeries(cache->hplus);
-        XLALDestroyREAL8TimeSeries(cache->hcross);
-        XLALDestroyCOMPLEX16FrequencySeries(cache->hptilde);
-        XLALDestroyCOMPLEX16FrequencySeries(cache->hctilde);
-        if(cache->LALpars) XLALDestroyDict(cache->LALpars);
+    while (cache != NULL) {
+        LALSimInspiralWaveformCache *next = cache->next;
+        ClearCacheEntry(cache);
         XLALFree(cache);
+        cache = next;
     }
 }
 
+/* Memory held by one cache entry */
+static size_t CacheEntryBytes(const LALSimInspiralWaveformCache *entry)
+{
+    size_t bytes = sizeof(*entry);
+    if (entry->hplus) bytes += entry->hplus->data->length * sizeof(REAL8);
+    if (entry->hcross) bytes += entry->hcross->data->length * sizeof(REAL8);
+    if (entry->hptilde) bytes += entry->hptilde->data->length * sizeof(COMPLEX16);
+    if (entry->hctilde) bytes += entry->hctilde->data->length * sizeof(COMPLEX16);
+    if (entry->frequencies) bytes += entry->frequencies->length * sizeof(REAL8);
+    return bytes;
+}
+
+/**
+ * Report the hit, miss and eviction counts of a waveform cache, with
+ * the number of waveforms and bytes it currently holds.  Any of the
+ * output pointers may be NULL.
+ */
+int XLALSimInspiralWaveformCacheGetStats(
+        const LALSimInspiralWaveformCache *cache,  /**< waveform cache */
+        UINT8 *hits,            /**< requests that found matching intrinsic parameters */
+        UINT8 *misses,          /**< requests that generated a new waveform */
+        UINT8 *evictions,       /**< waveforms discarded */
+        UINT4 *entries,         /**< waveforms currently stored */
+        size_t *bytes           /**< memory currently held */
+        )
+{
+    const LALSimInspiralWaveformCache *entry;
+    UINT4 n = 0;
+    size_t b = 0;
+
+    if (!cache) XLAL_ERROR(XLAL_EFAULT);
+    for (entry = cache; entry; entry = entry->next) {
+        if (entry->hplus || entry->hptilde) n++;
+        b += CacheEntryBytes(entry);
+    }
+
+    if (hits) *hits = cache->hits;
+    if (misses) *misses = cache->misses;
+    if (evictions) *evictions = cache->evictions;
+    if (entries) *entries = n;
+    if (bytes) *bytes = b;
+    return XLAL_SUCCESS;
+}
+
 /** @} */
 
 /**
@@ -685,12 +821,12 @@ static CacheVariableDiffersBitmask CacheArgsDifferenceBitmask(
     if ( XLALSimInspiralWaveformParamsLookupTidalOctupolarLambda1(LALpars) != XLALSimInspiralWaveformParamsLookupTidalOctupolarLambda1(cache->LALpars)) return INTRINSIC;
     if ( XLALSimInspiralWaveformParamsLookupTidalOctupolarLambda2(LALpars) != XLALSimInspiralWaveformParamsLookupTidalOctupolarLambda2(cache->LALpars)) return INTRINSIC;
     if ( XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda1(LALpars) != XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda1(cache->LALpars)) return INTRINSIC;
-    if ( XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda2(LALpars) != XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda1(cache->LALpars)) return INTRINSIC;
+    if ( XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda2(LALpars) != XLALSimInspiralWaveformParamsLookupTidalHexadecapolarLambda2(cache->LALpars)) return INTRINSIC;
     if ( XLALSimInspiralWaveformParamsLookupdQuadMon1(LALpars) != XLALSimInspiralWaveformParamsLookupdQuadMon1(cache->LALpars)) return INTRINSIC;
     if ( XLALSimInspiralWaveformParamsLookupdQuadMon2(LALpars) != XLALSimInspiralWaveformParamsLookupdQuadMon2(cache->LALpars)) return INTRINSIC;
     
     if ( XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(LALpars) != XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(cache->LALpars)) return INTRINSIC;
-    if ( XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(LALpars) != XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(cache->LALpars)) return INTRINSIC;
+    if ( XLALSimInspiralWaveformParamsLookupPNPhaseOrder(LALpars) != XLALSimInspiralWaveformParamsLookupPNPhaseOrder(cache->LALpars)) return INTRINSIC;
 
     if ( approximant != cache->approximant) return INTRINSIC;
 
@@ -723,6 +859,166 @@ static int FrequenciesAreDifferent(
     return 0;
 }
 
+/**
+ * Hash of the parameters that identify a waveform up to extrinsic
+ * transformations, used to skip non-matching cache entries quickly.
+ * Equal keys are confirmed with CacheArgsDifferenceBitmask().
+ */
+static UINT8 CacheKey(
+        REAL8 deltaTF,
+        REAL8 m1,
+        REAL8 m2,
+        REAL8 S1x, REAL8 S1y, REAL8 S1z,
+        REAL8 S2x, REAL8 S2y, REAL8 S2z,
+        REAL8 f_min, REAL8 f_ref, REAL8 f_max,
+        LALDict *LALpars,
+        Approximant approximant,
+        REAL8Sequence *frequencies
+        )
+{
+    const REAL8 buf[] = {
+        deltaTF, m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max,
+        XLALSimInspiralWaveformParamsLookupTidalLambda1(LALpars),
+        XLALSimInspiralWaveformParamsLookupTidalLambda2(LALpars),
+        XLALSimInspiralWaveformParamsLookupdQuadMon1(LALpars),
+        XLALSimInspiralWaveformParamsLookupdQuadMon2(LALpars),
+        XLALSimInspiralWaveformParamsLookupPNPhaseOrder(LALpars),
+        XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(LALpars),
+        XLALSimInspiralWaveformParamsLookupPNSpinOrder(LALpars),
+        XLALSimInspiralWaveformParamsLookupPNTidalOrder(LALpars),
+        approximant
+    };
+    UINT8 key = XLALCityHash64((const char *) buf, sizeof(buf));
+    if (frequencies != NULL)
+        key = XLALCityHash64WithSeed((const char *) frequencies->data,
+                frequencies->length * sizeof(REAL8), key);
+    return key;
+}
+
+/* Exchange the stored waveforms and parameters of two cache entries,
+ * leaving the list links and statistics in place. */
+static void SwapCacheEntries(LALSimInspiralWaveformCache *a,
+        LALSimInspiralWaveformCache *b)
+{
+    LALSimInspiralWaveformCache tmp = *a;
+    *a = *b;
+    *b = tmp;
+
+    b->next = a->next;
+    b->capacity = a->capacity;
+    b->max_bytes = a->max_bytes;
+    b->hits = a->hits;
+    b->misses = a->misses;
+    b->evictions = a->evictions;
+    a->next = tmp.next;
+    a->capacity = tmp.capacity;
+    a->max_bytes = tmp.max_bytes;
+    a->hits = tmp.hits;
+    a->misses = tmp.misses;
+    a->evictions = tmp.evictions;
+}
+
+/**
+ * If the intrinsic parameters differ from the most recent waveform,
+ * search the older waveforms of a multi-entry cache for a match and
+ * make it the most recent one.  On a miss, the most recent waveform
+ * is moved into the list so that the new waveform can be stored.
+ * Returns the difference bitmask with respect to the (new) most recent
+ * waveform and updates the hit/miss statistics.
+ */
+static CacheVariableDiffersBitmask CacheLookup(
+        LALSimInspiralWaveformCache *cache,
+        CacheVariableDiffersBitmask changedParams,
+        REAL8 phiRef,
+        REAL8 deltaTF,
+        REAL8 m1,
+        REAL8 m2,
+        REAL8 S1x, REAL8 S1y, REAL8 S1z,
+        REAL8 S2x, REAL8 S2y, REAL8 S2z,
+        REAL8 f_min, REAL8 f_ref, REAL8 f_max,
+        REAL8 r,
+        REAL8 i,
+        LALDict *LALpars,
+        Approximant approximant,
+        REAL8Sequence *frequencies
+        )
+{
+    LALSimInspiralWaveformCache *prev, *entry;
+
+    if( (changedParams & INTRINSIC) == 0 ) {
+        cache->hits++;
+        return changedParams;
+    }
+
+    if (cache->capacity > 1) {
+        UINT8 key = CacheKey(deltaTF, m1, m2, S1x, S1y, S1z, S2x, S2y, S2z,
+                f_min, f_ref, f_max, LALpars, approximant, frequencies);
+
+        for (prev = cache, entry = cache->next; entry != NULL; prev = entry, entry = entry->next) {
+            CacheVariableDiffersBitmask difference;
+            if (entry->key != key) continue;
+            difference = CacheArgsDifferenceBitmask(entry, phiRef, deltaTF,
+                    m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max,
+                    r, i, LALpars, approximant, frequencies);
+            if ( (difference & INTRINSIC) != 0 ) continue;
+
+            // Promote the match; the previous most recent waveform
+            // becomes the head of the list
+            prev->next = entry->next;
+            SwapCacheEntries(cache, entry);
+            if (entry->hplus != NULL || entry->hptilde != NULL) {
+                entry->next = cache->next;
+                cache->next = entry;
+            } else {
+                ClearCacheEntry(entry);
+                XLALFree(entry);
+            }
+            cache->hits++;
+            return difference;
+        }
+
+        // Miss: keep the most recent waveform
+        if (cache->hplus != NULL || cache->hptilde != NULL) {
+            entry = XLALCalloc(1, sizeof(*entry));
+            if (entry != NULL) {
+                SwapCacheEntries(cache, entry);
+                entry->next = cache->next;
+                cache->next = entry;
+            }
+        }
+    }
+
+    cache->misses++;
+    return changedParams;
+}
+
+/* Discard the least recently used waveforms until the cache respects
+ * its capacity and memory limit; the most recent one is always kept. */
+static void CacheEvict(LALSimInspiralWaveformCache *cache)
+{
+    for (;;) {
+        LALSimInspiralWaveformCache *prev = cache, *entry;
+        UINT4 n = 1;
+        size_t bytes = CacheEntryBytes(cache);
+
+        if (cache->next == NULL) return;
+        for (entry = cache->next; entry->next != NULL; prev = entry, entry = entry->next) {
+            n++;
+            bytes += CacheEntryBytes(entry);
+        }
+        n++;
+        bytes += CacheEntryBytes(entry);
+
+        if (n <= cache->capacity && (cache->max_bytes == 0 || bytes <= cache->max_bytes))
+            return;
+
+        prev->next = NULL;
+        ClearCacheEntry(entry);
+        XLALFree(entry);
+        cache->evictions++;
+    }
+}
+
 /** Store the output TD hplus and hcross in the cache. */
 static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
         REAL8TimeSeries *hplus,
@@ -768,7 +1064,11 @@ static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
     if(cache->LALpars) XLALDestroyDict(cache->LALpars);
     cache->LALpars = XLALDictDuplicate(LALpars);
     cache->approximant = approximant;
+    cache->f_max = 0.;
+    XLALDestroyREAL8Sequence(cache->frequencies);
     cache->frequencies = NULL;
+    cache->key = CacheKey(deltaT, m1, m2, S1x, S1y, S1z, S2x, S2y, S2z,
+            f_min, f_ref, 0., LALpars, approximant, NULL);
 
     // Copy over the waveforms
     // NB: XLALCut... creates a new Series object and copies data and metadata
@@ -789,6 +1089,7 @@ static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
         return XLAL_ENOMEM;
     }
 
+    CacheEvict(cache);
     return XLAL_SUCCESS;
 }
 
@@ -845,6 +1146,8 @@ static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
     if (frequencies != NULL){
         cache->frequencies = XLALCopyREAL8Sequence(frequencies);
     }
+    cache->key = CacheKey(deltaT, m1, m2, S1x, S1y, S1z, S2x, S2y, S2z,
+            f_min, f_ref, f_max, LALpars, approximant, frequencies);
 
     // Copy over the waveforms
     // NB: XLALCut... creates a new Series object and copies data and metadata
@@ -861,6 +1164,7 @@ static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
         return XLAL_ENOMEM;
     }
 
+    CacheEvict(cache);
     return XLAL_SUCCESS;
 }
 
@@ -1491,3 +1795,194 @@ int XLALSimInspiralChooseFDWaveformSequence(
 
     return ret;
 }
+
+/**
+ * Batched version of XLALSimInspiralChooseFDWaveformSequence() for
+ * nparams parameter sets sharing one frequency grid and one set of
+ * flags and non-GR / tidal parameters in LALpars.
+ *
+ * Row n of hptilde and hctilde holds the polarisations for params[n] at
+ * the frequencies in frequencies.  If *hptilde and *hctilde are NULL
+ * they are allocated here, otherwise they must already have nparams
+ * rows of frequencies->length points and are overwritten, so repeated
+ * calls need not allocate.
+ *
+ * TaylorF2 uses XLALSimInspiralTaylorF2CoreBatch(), which shares the
+ * frequency-grid setup across the batch.  IMRPhenomD and IMRPhenomXAS
+ * check and parse LALpars once and then generate the parameter sets in
+ * parallel with OpenMP, each thread working on its own copy of LALpars.
+ * SEOBNRv4_ROM uses XLALSimIMRSEOBNRv4ROMFrequencySequenceBatch(), which
+ * evaluates the reduced-order model for the whole batch at once.
+ * All other approximants fall back to calling
+ * XLALSimInspiralChooseFDWaveformSequence() for each parameter set in
+ * turn.
+ */
+int XLALSimInspiralChooseFDWaveformSequenceBatch(
+    COMPLEX16VectorSequence **hptilde,      /**< FD plus polarizations, one row per parameter set */
+    COMPLEX16VectorSequence **hctilde,      /**< FD cross polarizations, one row per parameter set */
+    const LALSimInspiralBatchParams *params, /**< parameter sets */
+    UINT4 nparams,                          /**< number of parameter sets */
+    REAL8 f_ref,                            /**< Reference frequency (Hz) */
+    LALDict *LALpars,                       /**< LALDictionary containing non-mandatory variables/flags */
+    Approximant approximant,                /**< post-Newtonian approximant to use for waveform production */
+    REAL8Sequence *frequencies              /**< sequence of frequencies for which the waveforms will be computed */
+)
+{
+    UINT4 n, j;
+    int ret;
+    int failed = 0;
+    COMPLEX16 Ylmfactor = 1.0;
+
+    if (!hptilde || !hctilde || !params || !frequencies) XLAL_ERROR(XLAL_EFAULT);
+    if (nparams == 0) XLAL_ERROR(XLAL_EINVAL, "Empty batch of parameters");
+    if ( !XLALSimInspiralWaveformParamsNonGRAreDefault(LALpars) && XLALSimInspiralApproximantAcceptTestGRParams(approximant) != LAL_SIM_INSPIRAL_TESTGR_PARAMS ) {
+        XLALPrintError("XLAL Error - %s: Passed in non-NULL testGRparams for an approximant that does not use them\n", __func__);
+        XLAL_ERROR(XLAL_EINVAL);
+    }
+
+    const UINT4 nfreq = frequencies->length;
+    if (*hptilde == NULL) *hptilde = XLALCreateCOMPLEX16VectorSequence(nparams, nfreq);
+    if (*hctilde == NULL) *hctilde = XLALCreateCOMPLEX16VectorSequence(nparams, nfreq);
+    if (!*hptilde || !*hctilde) XLAL_ERROR(XLAL_EFUNC);
+    if ((*hptilde)->length != nparams || (*hptilde)->vectorLength != nfreq || (*hctilde)->length != nparams || (*hctilde)->vectorLength != nfreq)
+        XLAL_ERROR(XLAL_EBADLEN, "Output sequences must have %u rows of %u points", nparams, nfreq);
+
+    REAL8 lambda1 = XLALSimInspiralWaveformParamsLookupTidalLambda1(LALpars);
+    REAL8 lambda2 = XLALSimInspiralWaveformParamsLookupTidalLambda2(LALpars);
+
+    switch (approximant)
+    {
+        case TaylorF2:
+        {
+            if( !XLALSimInspiralWaveformParamsFrameAxisIsDefault(LALpars) )
+                XLAL_ERROR(XLAL_EINVAL, "Non-default LALSimInspiralFrameAxis provided, but this approximant does not use that flag.");
+            if( !XLALSimInspiralWaveformParamsModesChoiceIsDefault(LALpars) )
+                XLAL_ERROR(XLAL_EINVAL, "Non-default LALSimInspiralModesChoice provided, but this approximant does not use that flag.");
+            for (n = 0; n < nparams; n++)
+                if( !checkTransverseSpinsZero(params[n].S1x, params[n].S1y, params[n].S2x, params[n].S2y) )
+                    XLAL_ERROR(XLAL_EINVAL, "Non-zero transverse spins were given, but this is a non-precessing approximant.");
+
+            LALDict *pars = LALpars ? XLALDictDuplicate(LALpars) : XLALCreateDict();
+            PNPhasingSeries *pfa = XLALMalloc(nparams * sizeof(*pfa));
+            if (!pars || !pfa) {
+                XLALDestroyDict(pars);
+                XLALFree(pfa);
+                XLAL_ERROR(XLAL_ENOMEM);
+            }
+            ret = XLALSimInspiralSetQuadMonParamsFromLambdas(pars);
+            for (n = 0; ret == XLAL_SUCCESS && n < nparams; n++)
+                XLALSimInspiralPNPhasing_F2(&pfa[n], params[n].m1/LAL_MSUN_SI, params[n].m2/LAL_MSUN_SI,
+                                            params[n].S1z, params[n].S2z, params[n].S1z*params[n].S1z,
+                                            params[n].S2z*params[n].S2z, params[n].S1z*params[n].S2z, pars);
+            if (ret == XLAL_SUCCESS)
+                ret = XLALSimInspiralTaylorF2CoreBatch(*hptilde, frequencies, params, pfa, nparams, f_ref, 0., pars);
+            XLALDestroyDict(pars);
+            XLALFree(pfa);
+            if (ret != XLAL_SUCCESS) XLAL_ERROR(XLAL_EFUNC);
+            break;
+        }
+
+        case IMRPhenomD:
+        case IMRPhenomXAS:
+            if( !XLALSimInspiralWaveformParamsFlagsAreDefault(LALpars) )
+                XLAL_ERROR(XLAL_EINVAL, "Non-default flags given, but this approximant does not support this case.");
+            if( !checkTidesZero(lambda1, lambda2) )
+                XLAL_ERROR(XLAL_EINVAL, "Non-zero tidal parameters were given, but this is approximant doe not have tidal corrections.");
+            for (n = 0; n < nparams; n++)
+                if( !checkTransverseSpinsZero(params[n].S1x, params[n].S1y, params[n].S2x, params[n].S2y) )
+                    XLAL_ERROR(XLAL_EINVAL, "Non-zero transverse spins were given, but this is a non-precessing approximant.");
+
+            /* See XLALSimInspiralChooseFDWaveformSequence() */
+            if (approximant == IMRPhenomXAS)
+                Ylmfactor = 2.0*sqrt(5.0 / (64.0 * LAL_PI)) * cexp(-I*2*(LAL_PI/2 ));
+
+            #pragma omp parallel private(n, j, ret)
+            {
+                /* Both models insert defaults into their LALDict */
+                LALDict *pars = LALpars ? XLALDictDuplicate(LALpars) : XLALCreateDict();
+                if (!pars) {
+                    #pragma omp atomic write
+                    failed = 1;
+                }
+
+                #pragma omp for schedule(dynamic)
+                for (n = 0; n < nparams; n++) {
+                    COMPLEX16FrequencySeries *htilde = NULL;
+                    int stop;
+                    #pragma omp atomic read
+                    stop = failed;
+                    if (stop) continue;
+                    if (approximant == IMRPhenomD)
+                        ret = XLALSimIMRPhenomDFrequencySequence(&htilde, frequencies,
+                            params[n].phiRef, f_ref, params[n].m1, params[n].m2,
+                            params[n].S1z, params[n].S2z, params[n].distance, pars, NoNRT_V);
+                    else
+                        ret = XLALSimIMRPhenomXASFrequencySequence(&htilde, frequencies,
+                            params[n].m1, params[n].m2, params[n].S1z, params[n].S2z,
+                            params[n].distance, params[n].phiRef, f_ref, pars);
+                    if (ret != XLAL_SUCCESS || htilde->data->length != nfreq) {
+                        #pragma omp atomic write
+                        failed = 1;
+                    } else {
+                        memcpy((*hptilde)->data + (size_t) n * nfreq, htilde->data->data, nfreq * sizeof(COMPLEX16));
+                    }
+                    XLALDestroyCOMPLEX16FrequencySeries(htilde);
+                }
+
+                XLALDestroyDict(pars);
+            }
+            if (failed) XLAL_ERROR(XLAL_EFUNC);
+            break;
+
+        case SEOBNRv4_ROM:
+            if( !XLALSimInspiralWaveformParamsFlagsAreDefault(LALpars) )
+                XLAL_ERROR(XLAL_EINVAL, "Non-default flags given, but this approximant does not support this case.");
+            if( !checkTidesZero(lambda1, lambda2) )
+                XLAL_ERROR(XLAL_EINVAL, "Non-zero tidal parameters were given, but this is approximant doe not have tidal corrections.");
+            for (n = 0; n < nparams; n++)
+                if( !checkTransverseSpinsZero(params[n].S1x, params[n].S1y, params[n].S2x, params[n].S2y) )
+                    XLAL_ERROR(XLAL_EINVAL, "Non-zero transverse spins were given, but this is a non-precessing approximant.");
+
+            /* Returns both polarizations, including the inclination */
+            ret = XLALSimIMRSEOBNRv4ROMFrequencySequenceBatch(*hptilde, *hctilde, frequencies, params, nparams, f_ref, -1);
+            if (ret != XLAL_SUCCESS) XLAL_ERROR(XLAL_EFUNC);
+            return XLAL_SUCCESS;
+
+        default:
+            for (n = 0; n < nparams; n++) {
+                COMPLEX16FrequencySeries *hp = NULL, *hc = NULL;
+                ret = XLALSimInspiralChooseFDWaveformSequence(&hp, &hc, params[n].phiRef,
+                    params[n].m1, params[n].m2, params[n].S1x, params[n].S1y, params[n].S1z,
+                    params[n].S2x, params[n].S2y, params[n].S2z, f_ref, params[n].distance,
+                    params[n].inclination, LALpars, approximant, frequencies);
+                if (ret == XLAL_SUCCESS && (hp->data->length != nfreq || hc->data->length != nfreq))
+                    ret = XLAL_EBADLEN;
+                if (ret == XLAL_SUCCESS) {
+                    memcpy((*hptilde)->data + (size_t) n * nfreq, hp->data->data, nfreq * sizeof(COMPLEX16));
+                    memcpy((*hctilde)->data + (size_t) n * nfreq, hc->data->data, nfreq * sizeof(COMPLEX16));
+                }
+                XLALDestroyCOMPLEX16FrequencySeries(hp);
+                XLALDestroyCOMPLEX16FrequencySeries(hc);
+                if (ret != XLAL_SUCCESS) XLAL_ERROR(XLAL_EFUNC);
+            }
+            return XLAL_SUCCESS;
+    }
+
+    /* The non-precessing fast paths return h(f) for optimal orientation;
+     * multiply hp by pfac, hc by -I*cfac as in the single-waveform case */
+    #pragma omp parallel for private(j)
+    for (n = 0; n < nparams; n++) {
+        const REAL8 cfac = cos(params[n].inclination);
+        const COMPLEX16 pfac = 0.5 * (1. + cfac*cfac) * Ylmfactor;
+        const COMPLEX16 cfacY = -I * cfac * Ylmfactor;
+        COMPLEX16 *hp = (*hptilde)->data + (size_t) n * nfreq;
+        COMPLEX16 *hc = (*hctilde)->data + (size_t) n * nfreq;
+        #pragma omp simd
+        for (j = 0; j < nfreq; j++) {
+            hc[j] = cfacY * hp[j];
+            hp[j] *= pfac;
+        }
+    }
+
+    return XLAL_SUCCESS;
+}
@@ -97,20 +97,33 @@ tagLALSimInspiralWaveformCache {
     LALDict *LALpars;
     Approximant approximant;
     REAL8Sequence *frequencies;
+    UINT8 key;                  /**< Hash of the intrinsic parameters of the stored waveform */
+    struct tagLALSimInspiralWaveformCache *next; /**< Less recently used waveforms, most recent first */
+    UINT4 capacity;             /**< Maximum number of waveforms held, including the one above */
+    size_t max_bytes;           /**< Maximum memory held by stored waveforms, 0 for no limit */
+    UINT8 hits;                 /**< Requests that found a waveform with matching intrinsic parameters */
+    UINT8 misses;               /**< Requests that had to generate a new waveform */
+    UINT8 evictions;            /**< Waveforms discarded to respect capacity or max_bytes */
 } LALSimInspiralWaveformCache;
 
 /** @} */
 
 LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCache(void);
 
+LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCacheLRU(UINT4 capacity, size_t max_bytes);
+
 void XLALDestroySimInspiralWaveformCache(LALSimInspiralWaveformCache *cache);
 
+int XLALSimInspiralWaveformCacheGetStats(const LALSimInspiralWaveformCache *cache, UINT8 *hits, UINT8 *misses, UINT8 *evictions, UINT4 *entries, size_t *bytes);
+
 int XLALSimInspiralChooseTDWaveformFromCache(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, REAL8 phiRef, REAL8 deltaT, REAL8 m1, REAL8 m2, REAL8 s1x, REAL8 s1y, REAL8 s1z, REAL8 s2x, REAL8 s2y, REAL8 s2z, REAL8 f_min, REAL8 f_ref, REAL8 r, REAL8 i, LALDict *LALpars, Approximant approximant, LALSimInspiralWaveformCache *cache);
 
 int XLALSimInspiralChooseFDWaveformFromCache(COMPLEX16FrequencySeries **hptilde, COMPLEX16FrequencySeries **hctilde, REAL8 phiRef, REAL8 deltaF, REAL8 m1, REAL8 m2, REAL8 S1x, REAL8 S1y, REAL8 S1z, REAL8 S2x, REAL8 S2y, REAL8 S2z, REAL8 f_min, REAL8 f_max, REAL8 f_ref, REAL8 r, REAL8 i, LALDict *LALpars, Approximant approximant, LALSimInspiralWaveformCache *cache, REAL8Sequence *frequencies);
 
 int XLALSimInspiralChooseFDWaveformSequence(COMPLEX16FrequencySeries **hptilde, COMPLEX16FrequencySeries **hctilde, REAL8 phiRef, REAL8 m1, REAL8 m2, REAL8 S1x, REAL8 S1y, REAL8 S1z, REAL8 S2x, REAL8 S2y, REAL8 S2z, REAL8 f_ref, REAL8 r, REAL8 i, LALDict *LALpars, Approximant approximant, REAL8Sequence *frequencies);
 
+int XLALSimInspiralChooseFDWaveformSequenceBatch(COMPLEX16VectorSequence **hptilde, COMPLEX16VectorSequence **hctilde, const LALSimInspiralBatchParams *params, UINT4 nparams, REAL8 f_ref, LALDict *LALpars, Approximant approximant, REAL8Sequence *frequencies);
+
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
@@ -144,6 +144,9 @@ int XLALSimInspiralWaveformParamsInsertNLTidesF2(LALDict *params, REAL8 value);
 INT4 XLALSimInspiralWaveformParamsInsertEOBChooseNumOrAnalHamDer(LALDict *params, INT4 value);
 INT4 XLALSimInspiralWaveformParamsInsertEOBEllMaxForNyquistCheck(LALDict *params, INT4 value);
 
+/* SEOBNRv4 */
+int XLALSimInspiralWaveformParamsInsertEOBUseDenseOutput(LALDict *params, INT4 value);
+
 INT4 XLALSimInspiralWaveformParamsLookupModesChoice(LALDict *params);
 INT4 XLALSimInspiralWaveformParamsLookupFrameAxis(LALDict *params);
 INT4 XLALSimInspiralWaveformParamsLookupSideband(LALDict *params);
@@ -277,6 +280,9 @@ REAL8 XLALSimInspiralWaveformParamsLookupNLTidesF2(LALDict *params);
 INT4 XLALSimInspiralWaveformParamsLookupEOBChooseNumOrAnalHamDer(LALDict *params);
 INT4 XLALSimInspiralWaveformParamsLookupEOBEllMaxForNyquistCheck(LALDict *params);
 
+/* SEOBNRv4 */
+INT4 XLALSimInspiralWaveformParamsLookupEOBUseDenseOutput(LALDict *params);
+
 int XLALSimInspiralWaveformParamsModesChoiceIsDefault(LALDict *params);
 int XLALSimInspiralWaveformParamsFrameAxisIsDefault(LALDict *params);
 int XLALSimInspiralWaveformParamsSidebandIsDefault(LALDict *params);
@@ -398,6 +404,8 @@ int XLALSimInspiralWaveformParamsNonGRLIVAlphaIsDefault(LALDict *params);
 /* SEOBNRv4P */
 INT4 XLALSimInspiralWaveformParamsEOBChooseNumOrAnalHamDerIsDefault(LALDict *params);
 INT4 XLALSimInspiralWaveformParamsEOBEllMaxForNyquistCheckIsDefault(LALDict *params);
+/* SEOBNRv4 */
+int XLALSimInspiralWaveformParamsEOBUseDenseOutputIsDefault(LALDict *params);
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
@@ -32,6 +32,7 @@
 #ifndef _LALSIMNEUTRONSTAR_H
 #define _LALSIMNEUTRONSTAR_H
 
+#include <lal/LALAtomicDatatypes.h>
 #include <lal/LALConstants.h>
 
 
@@ -61,8 +62,15 @@ extern const char * const lalSimNeutronStarEOSNames[65];
 /** Incomplete type for a neutron star family having a particular EOS. */
 typedef struct tagLALSimNeutronStarFamily LALSimNeutronStarFamily;
 
+/** Incomplete type for reusable TOV integration workspace. */
+typedef struct tagLALSimNeutronStarTOVWorkspace LALSimNeutronStarTOVWorkspace;
+
 void XLALDestroySimNeutronStarEOS(LALSimNeutronStarEOS * eos);
 char *XLALSimNeutronStarEOSName(LALSimNeutronStarEOS * eos);
+UINT8 XLALSimNeutronStarEOSHash(LALSimNeutronStarEOS * eos);
+#ifndef SWIG /* exclude from SWIG interface */
+void *XLALSimNeutronStarEOSKey(size_t *size, LALSimNeutronStarEOS * eos);
+#endif
 
 LALSimNeutronStarEOS *XLALSimNeutronStarEOSByName(const char *name);
 LALSimNeutronStarEOS *XLALSimNeutronStarEOSFromFile(const char *fname);
@@ -114,15 +122,22 @@ double XLALSimNeutronStarEOSSpeedOfSoundGeometerized(double h,
 
 /* TOV ROUTINES */
 
+LALSimNeutronStarTOVWorkspace *XLALCreateSimNeutronStarTOVWorkspace(void);
+void XLALDestroySimNeutronStarTOVWorkspace(LALSimNeutronStarTOVWorkspace *
+    work);
 int XLALSimNeutronStarTOVODEIntegrate(double *radius, double *mass,
     double *love_number_k2, double central_pressure_si,
     LALSimNeutronStarEOS * eos);
+int XLALSimNeutronStarTOVODEIntegrateWithWorkspace(double *radius,
+    double *mass, double *love_number_k2, double central_pressure_si,
+    LALSimNeutronStarEOS * eos, LALSimNeutronStarTOVWorkspace * work);
 
 /* MASS-RADIUS TYPE RELATIONSHIP ROUTINES */
 
 void XLALDestroySimNeutronStarFamily(LALSimNeutronStarFamily * fam);
 LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
     LALSimNeutronStarEOS * eos);
+void XLALSimNeutronStarFamilyCacheClear(void);
 
 double XLALSimNeutronStarFamMinimumMass(LALSimNeutronStarFamily * fam);
 double XLALSimNeutronStarMaximumMass(LALSimNeutronStarFamily * fam);
@@ -30,6 +30,7 @@
 
 #include <lal/LALStdlib.h>
 #include <lal/LALString.h>
+#include <lal/LALHashFunc.h>
 #include <lal/FileIO.h>
 #include <lal/LALSimNeutronStar.h>
 #include <lal/LALSimReadData.h>
@@ -147,6 +148,101 @@ char *XLALSimNeutronStarEOSName(LALSimNeutronStarEOS * eos)
     return eos->name;
 }
 
+/** @cond */
+
+/* Append size bytes at src to the key buffer, advancing the offset. */
+static void eos_key_append(char *key, size_t *offset, const void *src,
+    size_t size)
+{
+    if (key)
+        memcpy(key + *offset, src, size);
+    *offset += size;
+    return;
+}
+
+/* Write the data defining the EOS to key, which may be NULL; returns the
+ * number of bytes in the key. */
+static size_t eos_key_fill(char *key, LALSimNeutronStarEOS * eos)
+{
+    size_t offset = 0;
+    eos_key_append(key, &offset, &eos->datatype, sizeof(eos->datatype));
+    eos_key_append(key, &offset, &eos->pmax, sizeof(eos->pmax));
+    eos_key_append(key, &offset, &eos->hmax, sizeof(eos->hmax));
+    switch (eos->datatype) {
+    case LALSIM_NEUTRON_STAR_EOS_DATA_TYPE_TABULAR:
+        {
+            LALSimNeutronStarEOSDataTabular *data = eos->data.tabular;
+            eos_key_append(key, &offset, &data->ndat, sizeof(data->ndat));
+            eos_key_append(key, &offset, data->log_pdat,
+                data->ndat * sizeof(*data->log_pdat));
+            eos_key_append(key, &offset, data->log_edat,
+                data->ndat * sizeof(*data->log_edat));
+        }
+        break;
+    case LALSIM_NEUTRON_STAR_EOS_DATA_TYPE_PIECEWISE_POLYTROPE:
+        {
+            LALSimNeutronStarEOSDataPiecewisePolytrope *data =
+                eos->data.piecewisePolytrope;
+            size_t n = data->nPoly * sizeof(double);
+            eos_key_append(key, &offset, &data->nPoly, sizeof(data->nPoly));
+            eos_key_append(key, &offset, data->rhoTab, n);
+            eos_key_append(key, &offset, data->epsilonTab, n);
+            eos_key_append(key, &offset, data->pTab, n);
+            eos_key_append(key, &offset, data->kTab, n);
+            eos_key_append(key, &offset, data->gammaTab, n);
+        }
+        break;
+    default:
+        /* unknown EOS data: use the name so that distinct EOSs differ */
+        eos_key_append(key, &offset, eos->name, strlen(eos->name));
+        break;
+    }
+    return offset;
+}
+
+/** @endcond */
+
+/**
+ * @brief The data defining the equation of state, as a sequence of bytes.
+ * @details Two EOS structures constructed from the same data, e.g. the same
+ * spectral decomposition or piecewise-polytrope parameters, have identical
+ * keys, so the key can be compared to confirm a match found through
+ * XLALSimNeutronStarEOSHash().  The name of the EOS is not part of the key.
+ * @param[out] size Number of bytes in the key.
+ * @param[in] eos Pointer to the EOS structure.
+ * @return Pointer to the key, which must be freed with XLALFree().
+ */
+void *XLALSimNeutronStarEOSKey(size_t *size, LALSimNeutronStarEOS * eos)
+{
+    char *key;
+    XLAL_CHECK_NULL(size && eos, XLAL_EFAULT);
+    *size = eos_key_fill(NULL, eos);
+    key = LALMalloc(*size);
+    XLAL_CHECK_NULL(key, XLAL_ENOMEM);
+    eos_key_fill(key, eos);
+    return key;
+}
+
+/**
+ * @brief A 64-bit hash of the data defining the equation of state.
+ * @details This is the hash of XLALSimNeutronStarEOSKey().  It is used as
+ * the key for caching derived quantities such as neutron star families;
+ * since distinct EOSs may collide, a match should be confirmed by comparing
+ * the keys.  The name of the EOS is not part of the hash.
+ * @param[in] eos Pointer to the EOS structure.
+ * @return The hash of the equation of state data, or 0 on failure.
+ */
+UINT8 XLALSimNeutronStarEOSHash(LALSimNeutronStarEOS * eos)
+{
+    size_t size;
+    UINT8 hash;
+    void *key = XLALSimNeutronStarEOSKey(&size, eos);
+    XLAL_CHECK_VAL(0, key, XLAL_EFUNC);
+    hash = XLALCityHash64(key, size);
+    XLALFree(key);
+    return hash;
+}
+
 /**
  * @brief Returns the maximum pressure of the EOS in geometrized units m^-2.
  * @param eos Pointer to the EOS structure.
@@ -43,13 +43,12 @@ struct tagLALSimNeutronStarEOSDataTabular {
     gsl_interp *log_e_of_log_h_interp;
     gsl_interp *log_p_of_log_h_interp;
     gsl_interp *log_rho_of_log_h_interp;
-    gsl_interp_accel *log_e_of_log_p_acc;
-    gsl_interp_accel *log_h_of_log_p_acc;
-    gsl_interp_accel *log_e_of_log_h_acc;
-    gsl_interp_accel *log_p_of_log_h_acc;
-    gsl_interp_accel *log_rho_of_log_h_acc;
 };
 
+/* Note: the interpolants are evaluated without gsl_interp_accel objects so
+ * that a tabular EOS has no mutable state and can be evaluated from several
+ * threads at once (e.g. by the parallel neutron star family builder). */
+
 static double eos_e_of_p_tabular(double p, LALSimNeutronStarEOS * eos)
 {
 	double log_p;
@@ -62,7 +61,7 @@ static double eos_e_of_p_tabular(double p, LALSimNeutronStarEOS * eos)
 		return exp(eos->data.tabular->log_edat[0] + (3.0 / 5.0) * (log_p - eos->data.tabular->log_pdat[0]));
     log_e = gsl_interp_eval(eos->data.tabular->log_e_of_log_p_interp,
         eos->data.tabular->log_pdat, eos->data.tabular->log_edat, log_p,
-        eos->data.tabular->log_e_of_log_p_acc);
+        NULL);
     return exp(log_e);
 }
 
@@ -78,7 +77,7 @@ static double eos_e_of_h_tabular(double h, LALSimNeutronStarEOS * eos)
 		return exp(eos->data.tabular->log_edat[0] + 1.5 * (log_h - eos->data.tabular->log_hdat[0]));
     log_e = gsl_interp_eval(eos->data.tabular->log_e_of_log_h_interp,
         eos->data.tabular->log_hdat, eos->data.tabular->log_edat, log_h,
-        eos->data.tabular->log_e_of_log_h_acc);
+        NULL);
     return exp(log_e);
 }
 
@@ -94,7 +93,7 @@ static double eos_p_of_h_tabular(double h, LALSimNeutronStarEOS * eos)
 		return exp(eos->data.tabular->log_pdat[0] + 2.5 * (log_h - eos->data.tabular->log_hdat[0]));
     log_p = gsl_interp_eval(eos->data.tabular->log_p_of_log_h_interp,
         eos->data.tabular->log_hdat, eos->data.tabular->log_pdat, log_h,
-        eos->data.tabular->log_p_of_log_h_acc);
+        NULL);
     return exp(log_p);
 }
 
@@ -111,7 +110,7 @@ static double eos_rho_of_h_tabular(double h, LALSimNeutronStarEOS * eos)
     log_rho =
         gsl_interp_eval(eos->data.tabular->log_rho_of_log_h_interp,
         eos->data.tabular->log_hdat, eos->data.tabular->log_rhodat, log_h,
-        eos->data.tabular->log_rho_of_log_h_acc);
+        NULL);
     return exp(log_rho);
 }
 
@@ -127,7 +126,7 @@ static double eos_h_of_p_tabular(double p, LALSimNeutronStarEOS * eos)
 		return exp(eos->data.tabular->log_hdat[0] + 0.4 * (log_p - eos->data.tabular->log_pdat[0]));
     log_h = gsl_interp_eval(eos->data.tabular->log_h_of_log_p_interp,
         eos->data.tabular->log_pdat, eos->data.tabular->log_hdat, log_p,
-        eos->data.tabular->log_h_of_log_p_acc);
+        NULL);
     return exp(log_h);
 }
 
@@ -141,11 +140,11 @@ static double eos_dedp_of_p_tabular(double p, LALSimNeutronStarEOS * eos)
 		return (3.0 / 5.0) * exp(eos->data.tabular->log_edat[0] - eos->data.tabular->log_pdat[0]);
     log_e = gsl_interp_eval(eos->data.tabular->log_e_of_log_p_interp,
         eos->data.tabular->log_pdat, eos->data.tabular->log_edat, log_p,
-        eos->data.tabular->log_e_of_log_p_acc);
+        NULL);
     d_log_e_d_log_p =
         gsl_interp_eval_deriv(eos->data.tabular->log_e_of_log_p_interp,
         eos->data.tabular->log_pdat, eos->data.tabular->log_edat, log_p,
-        eos->data.tabular->log_e_of_log_p_acc);
+        NULL);
     return d_log_e_d_log_p * exp(log_e - log_p);
 }
 
@@ -175,11 +174,6 @@ static void eos_free_tabular_data(LALSimNeutronStarEOSDataTabular * data)
         gsl_interp_free(data->log_p_of_log_h_interp);
         gsl_interp_free(data->log_h_of_log_p_interp);
         gsl_interp_free(data->log_rho_of_log_h_interp);
-        gsl_interp_accel_free(data->log_e_of_log_p_acc);
-        gsl_interp_accel_free(data->log_e_of_log_h_acc);
-        gsl_interp_accel_free(data->log_p_of_log_h_acc);
-        gsl_interp_accel_free(data->log_h_of_log_p_acc);
-        gsl_interp_accel_free(data->log_rho_of_log_h_acc);
         LALFree(data->log_edat);
         LALFree(data->log_pdat);
         LALFree(data->log_hdat);
@@ -313,12 +307,6 @@ static LALSimNeutronStarEOS *eos_alloc_tabular(double *pdat, double *edat,
 
     /* setup interpolation tables */
 
-    data->log_e_of_log_p_acc = gsl_interp_accel_alloc();
-    data->log_h_of_log_p_acc = gsl_interp_accel_alloc();
-    data->log_e_of_log_h_acc = gsl_interp_accel_alloc();
-    data->log_p_of_log_h_acc = gsl_interp_accel_alloc();
-    data->log_rho_of_log_h_acc = gsl_interp_accel_alloc();
-
     data->log_e_of_log_p_interp = gsl_interp_alloc(gsl_interp_cspline, ndat);
     data->log_h_of_log_p_interp = gsl_interp_alloc(gsl_interp_cspline, ndat);
     data->log_e_of_log_h_interp = gsl_interp_alloc(gsl_interp_cspline, ndat);
@@ -25,14 +25,26 @@
  */
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_interp.h>
 #include <gsl/gsl_min.h>
 GSL_VAR const gsl_interp_type * lal_gsl_interp_steffen;
 
 #include <lal/LALStdlib.h>
+#include <lal/LALConfig.h>
+#include <lal/LALHashFunc.h>
 #include <lal/LALSimNeutronStar.h>
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 /** @cond */
 
 /* Contents of the neutron star family structure. */
@@ -51,15 +63,200 @@ struct tagLALSimNeutronStarFamily {
 };
 
 /* gsl function for use in finding the maximum neutron star mass */
+struct fminimizer_params {
+    LALSimNeutronStarEOS *eos;
+    LALSimNeutronStarTOVWorkspace *work;
+};
 static double fminimizer_gslfunction(double x, void * params);
 static double fminimizer_gslfunction(double x, void * params)
 {
-    LALSimNeutronStarEOS * eos = params;
+    struct fminimizer_params *fp = params;
     double r, m, k;
-    XLALSimNeutronStarTOVODEIntegrate(&r, &m, &k, x, eos);
+    XLALSimNeutronStarTOVODEIntegrateWithWorkspace(&r, &m, &k, x, fp->eos,
+        fp->work);
     return -m; /* maximum mass is minimum negative mass */
 }
 
+/* Integrate the TOV equations for the central pressures pdat[0..n-1],
+ * distributing the stars over the available threads.  Each thread uses its
+ * own ODE workspace; the EOS is only read. */
+static int family_integrate(double *rdat, double *mdat, double *kdat,
+    const double *pdat, size_t n, LALSimNeutronStarEOS * eos)
+{
+    int failed = 0;
+
+    #pragma omp parallel
+    {
+        LALSimNeutronStarTOVWorkspace *work;
+        long i;
+
+        work = XLALCreateSimNeutronStarTOVWorkspace();
+        if (!work) {
+            #pragma omp atomic write
+            failed = 1;
+        }
+
+        #pragma omp for schedule(dynamic, 1)
+        for (i = 0; i < (long)n; ++i) {
+            int fail;
+            #pragma omp atomic read
+            fail = failed;
+            if (fail)
+                continue;
+            if (XLALSimNeutronStarTOVODEIntegrateWithWorkspace(&rdat[i],
+                    &mdat[i], &kdat[i], pdat[i], eos, work) < 0) {
+                #pragma omp atomic write
+                failed = 1;
+            }
+        }
+
+        XLALDestroySimNeutronStarTOVWorkspace(work);
+    }
+
+    if (failed)
+        XLAL_ERROR(XLAL_EFUNC, "TOV integration failed");
+    return 0;
+}
+
+/* Index of the first star whose mass does not exceed that of the previous
+ * star, i.e. the first star past the maximum mass, or n if there is none. */
+static size_t family_turnover(const double *mdat, size_t n)
+{
+    size_t i;
+    for (i = 1; i < n; ++i)
+        if (mdat[i] <= mdat[i - 1])
+            break;
+    return i;
+}
+
+/* Does the interval between stars i and i + 1 need to be refined?  The
+ * tolerances are relative to the mass scale of the family and to the local
+ * radius and Love number. */
+static int family_needs_refinement(const LALSimNeutronStarFamily * fam,
+    size_t i, double mscale)
+{
+    const double mtol = 0.01, rtol = 0.005, ktol = 0.01;
+    double dm = fabs(fam->mdat[i + 1] - fam->mdat[i]);
+    double dr = fabs(fam->rdat[i + 1] - fam->rdat[i]);
+    double dk = fabs(fam->kdat[i + 1] - fam->kdat[i]);
+    return dm > mtol * mscale || dr > rtol * fmin(fam->rdat[i], fam->rdat[i + 1])
+        || dk > ktol * fmax(fam->kdat[i], fam->kdat[i + 1]);
+}
+
+/* Cache of neutron star family tables keyed on the EOS hash.  EOS sampling
+ * codes typically rebuild the same EOS many times (e.g. for the prior and
+ * the likelihood of a sample, or when only the non-EOS parameters of a
+ * sample change), so a small most-recently-used list is enough.  Each entry
+ * keeps the full EOS key as well, and a hash match is only a hit if the keys
+ * are identical.  The entries are allocated with malloc() as they live for
+ * the duration of the process. */
+enum { FAMILY_CACHE_SIZE = 16 };
+
+struct family_cache_entry {
+    UINT8 hash;
+    size_t keysize;
+    char *key;          /* XLALSimNeutronStarEOSKey() of the EOS */
+    size_t ndat;
+    double *data;       /* pdat, mdat, rdat, kdat concatenated */
+};
+
+static struct family_cache_entry family_cache[FAMILY_CACHE_SIZE];
+static size_t family_cache_len;
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t family_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void family_cache_lock_acquire(void)
+{
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&family_cache_lock);
+#endif
+}
+
+static void family_cache_lock_release(void)
+{
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_unlock(&family_cache_lock);
+#endif
+}
+
+/* Free the storage of a cache entry. */
+static void family_cache_entry_free(struct family_cache_entry *entry)
+{
+    free(entry->key);
+    free(entry->data);
+    return;
+}
+
+/* Copy the tables for an EOS into fam if they are in the cache; the entry
+ * is moved to the front of the list.  Returns the number of points, or 0 if
+ * the EOS is not in the cache. */
+static size_t family_cache_lookup(LALSimNeutronStarFamily * fam, UINT8 hash,
+    const char *key, size_t keysize)
+{
+    size_t ndat = 0;
+    size_t i;
+
+    family_cache_lock_acquire();
+    for (i = 0; i < family_cache_len; ++i)
+        if (family_cache[i].hash == hash && family_cache[i].keysize == keysize
+            && memcmp(family_cache[i].key, key, keysize) == 0)
+            break;
+    if (i < family_cache_len) {
+        struct family_cache_entry entry = family_cache[i];
+        fam->pdat = LALMalloc(entry.ndat * sizeof(*fam->pdat));
+        fam->mdat = LALMalloc(entry.ndat * sizeof(*fam->mdat));
+        fam->rdat = LALMalloc(entry.ndat * sizeof(*fam->rdat));
+        fam->kdat = LALMalloc(entry.ndat * sizeof(*fam->kdat));
+        if (fam->pdat && fam->mdat && fam->rdat && fam->kdat) {
+            ndat = entry.ndat;
+            memcpy(fam->pdat, entry.data, ndat * sizeof(double));
+            memcpy(fam->mdat, entry.data + ndat, ndat * sizeof(double));
+            memcpy(fam->rdat, entry.data + 2 * ndat, ndat * sizeof(double));
+            memcpy(fam->kdat, entry.data + 3 * ndat, ndat * sizeof(double));
+        }
+        memmove(family_cache + 1, family_cache, i * sizeof(*family_cache));
+        family_cache[0] = entry;
+    }
+    family_cache_lock_release();
+    return ndat;
+}
+
+/* Insert the tables of fam at the front of the cache, evicting the least
+ * recently used entry if the cache is full. */
+static void family_cache_insert(const LALSimNeutronStarFamily * fam,
+    UINT8 hash, const char *key, size_t keysize)
+{
+    size_t ndat = fam->ndat;
+    double *data = malloc(4 * ndat * sizeof(*data));
+    char *keycopy = malloc(keysize);
+    if (!data || !keycopy) {
+        /* not fatal: the family is simply not cached */
+        free(keycopy);
+        free(data);
+        return;
+    }
+    memcpy(keycopy, key, keysize);
+    memcpy(data, fam->pdat, ndat * sizeof(double));
+    memcpy(data + ndat, fam->mdat, ndat * sizeof(double));
+    memcpy(data + 2 * ndat, fam->rdat, ndat * sizeof(double));
+    memcpy(data + 3 * ndat, fam->kdat, ndat * sizeof(double));
+
+    family_cache_lock_acquire();
+    if (family_cache_len == FAMILY_CACHE_SIZE)
+        family_cache_entry_free(&family_cache[--family_cache_len]);
+    memmove(family_cache + 1, family_cache,
+        family_cache_len * sizeof(*family_cache));
+    family_cache[0].hash = hash;
+    family_cache[0].keysize = keysize;
+    family_cache[0].key = keycopy;
+    family_cache[0].ndat = ndat;
+    family_cache[0].data = data;
+    ++family_cache_len;
+    family_cache_lock_release();
+    return;
+}
+
 /** @endcond */
 
 /**
@@ -75,15 +272,33 @@ void XLALDestroySimNeutronStarFamily(LALSimNeutronStarFamily * fam)
         gsl_interp_free(fam->k_of_m_interp);
         gsl_interp_free(fam->r_of_m_interp);
         gsl_interp_free(fam->p_of_m_interp);
-        LALFree(fam->kdat);
-        LALFree(fam->rdat);
-        LALFree(fam->mdat);
-        LALFree(fam->pdat);
-        LALFree(fam);
+        XLALFree(fam->kdat);
+        XLALFree(fam->rdat);
+        XLALFree(fam->mdat);
+        XLALFree(fam->pdat);
+        XLALFree(fam);
     }
     return;
 }
 
+/**
+ * @brief Empties the cache of neutron star families.
+ * @details
+ * XLALCreateSimNeutronStarFamily() keeps the tables of the most recently
+ * created families, keyed on the EOS data (see XLALSimNeutronStarEOSKey()),
+ * so that building
+ * the family of an EOS that has been seen before does not require any TOV
+ * integrations.  This routine releases the cached tables.
+ */
+void XLALSimNeutronStarFamilyCacheClear(void)
+{
+    family_cache_lock_acquire();
+    while (family_cache_len > 0)
+        family_cache_entry_free(&family_cache[--family_cache_len]);
+    family_cache_lock_release();
+    return;
+}
+
 /**
  * @brief Creates a neutron star family structure for a given equation of state.
  * @details
@@ -92,6 +307,14 @@ void XLALDestroySimNeutronStarFamily(LALSimNeutronStarFamily * fam)
  * pressure, or, equivalently, the mass of the neutron star.  The family
  * is terminated at the maximum neutron star mass for the specified equation
  * of state, so the mass can be used as the family parameter.
+ *
+ * The stars are first computed on a coarse grid of central pressures,
+ * which is then refined by bisection in log pressure wherever the mass,
+ * radius or Love number changes too much between neighbouring stars.  The
+ * TOV integrations of each pass are done in parallel when OpenMP is
+ * available.  The resulting tables are cached (see
+ * XLALSimNeutronStarFamilyCacheClear()), so creating the family of an EOS
+ * with the same data again is cheap.
  * @param eos Pointer to the Equation of State structure.
  * @return A pointer to the neutron star family structure.
  */
@@ -99,36 +322,119 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
     LALSimNeutronStarEOS * eos)
 {
     LALSimNeutronStarFamily * fam;
-    const size_t ndatmax = 100;
+    const size_t ncoarse = 32;
+    const size_t ndatmax = 512;
+    const int nrefine = 4;
     const double logpmin = 75.5;
     double logpmax;
     double dlogp;
-    size_t ndat = ndatmax;
-    size_t i;
+    double *pnew = NULL;
+    double *rnew = NULL;
+    double *mnew = NULL;
+    double *knew = NULL;
+    size_t *inew = NULL;
+    size_t ndat;
+    size_t nnew;
+    size_t i, j;
+    UINT8 hash;
+    char *key;
+    size_t keysize;
+    int errnum = XLAL_EFUNC;
+    int level;
 
     /* allocate memory */
-    fam = LALMalloc(sizeof(*fam));
+    fam = LALCalloc(1, sizeof(*fam));
     if (!fam)
         XLAL_ERROR_NULL(XLAL_ENOMEM);
-    fam->pdat = LALMalloc(ndat * sizeof(*fam->pdat));
-    fam->mdat = LALMalloc(ndat * sizeof(*fam->mdat));
-    fam->rdat = LALMalloc(ndat * sizeof(*fam->rdat));
-    fam->kdat = LALMalloc(ndat * sizeof(*fam->kdat));
-    if (!fam->mdat || !fam->rdat || !fam->kdat)
-        XLAL_ERROR_NULL(XLAL_ENOMEM);
 
-    /* compute data tables */
+    key = XLALSimNeutronStarEOSKey(&keysize, eos);
+    if (!key) {
+        LALFree(fam);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    hash = XLALCityHash64(key, keysize);
+    ndat = family_cache_lookup(fam, hash, key, keysize);
+    if (ndat > 0) {
+        LALFree(key);
+        fam->ndat = ndat;
+        goto setup;
+    }
+
+    ndat = ncoarse;
+    fam->pdat = LALMalloc(ndatmax * sizeof(*fam->pdat));
+    fam->mdat = LALMalloc(ndatmax * sizeof(*fam->mdat));
+    fam->rdat = LALMalloc(ndatmax * sizeof(*fam->rdat));
+    fam->kdat = LALMalloc(ndatmax * sizeof(*fam->kdat));
+    pnew = LALMalloc(ndatmax * sizeof(*pnew));
+    mnew = LALMalloc(ndatmax * sizeof(*mnew));
+    rnew = LALMalloc(ndatmax * sizeof(*rnew));
+    knew = LALMalloc(ndatmax * sizeof(*knew));
+    inew = LALMalloc(ndatmax * sizeof(*inew));
+    if (!fam->pdat || !fam->mdat || !fam->rdat || !fam->kdat || !pnew
+        || !mnew || !rnew || !knew || !inew)
+        goto nomem;
+
+    /* compute data tables on the coarse grid */
     logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
     dlogp = (logpmax - logpmin) / ndat;
-    for (i = 0; i < ndat; ++i) {
+    for (i = 0; i < ndat; ++i)
         fam->pdat[i] = exp(logpmin + i * dlogp);
-        XLALSimNeutronStarTOVODEIntegrate(&fam->rdat[i], &fam->mdat[i],
-            &fam->kdat[i], fam->pdat[i], eos);
-        /* determine if maximum mass has been found */
-        if (i > 0 && fam->mdat[i] <= fam->mdat[i-1])
+    if (family_integrate(fam->rdat, fam->mdat, fam->kdat, fam->pdat, ndat,
+            eos) < 0)
+        goto failure;
+
+    /* keep the first star past the maximum mass to bracket the maximum */
+    i = family_turnover(fam->mdat, ndat);
+    ndat = i < ndat ? i + 1 : ndat;
+
+    /* refine intervals that are not resolved by bisection in log p */
+    for (level = 0; level < nrefine; ++level) {
+        double mscale = 0.0;
+        size_t k;
+        for (i = 0; i < ndat; ++i)
+            mscale = fmax(mscale, fam->mdat[i]);
+        for (nnew = 0, i = 0; i + 1 < ndat && ndat + nnew < ndatmax; ++i)
+            if (family_needs_refinement(fam, i, mscale)) {
+                inew[nnew] = i;
+                pnew[nnew] = sqrt(fam->pdat[i] * fam->pdat[i + 1]);
+                ++nnew;
+            }
+        if (nnew == 0)
             break;
+        if (family_integrate(rnew, mnew, knew, pnew, nnew, eos) < 0)
+            goto failure;
+
+        /* merge the new stars into the tables, working backwards */
+        k = nnew;
+        j = ndat + nnew;
+        for (i = ndat; i-- > 0;) {
+            if (k > 0 && inew[k - 1] == i) {
+                --k;
+                --j;
+                fam->pdat[j] = pnew[k];
+                fam->mdat[j] = mnew[k];
+                fam->rdat[j] = rnew[k];
+                fam->kdat[j] = knew[k];
+            }
+            --j;
+            fam->pdat[j] = fam->pdat[i];
+            fam->mdat[j] = fam->mdat[i];
+            fam->rdat[j] = fam->rdat[i];
+            fam->kdat[j] = fam->kdat[i];
+        }
+        ndat += nnew;
+
+        /* the maximum may now be found earlier */
+        i = family_turnover(fam->mdat, ndat);
+        ndat = i < ndat ? i + 1 : ndat;
     }
 
+    i = family_turnover(fam->mdat, ndat);
+    if (i == 1) {
+        XLAL_PRINT_ERROR("Maximum mass reached at the minimum central pressure");
+        errnum = XLAL_EDOM;
+        goto failure;
+    }
     if (i < ndat) {
         /* replace the ith point with the maximum mass */
         const double epsabs = 0.0, epsrel = 1e-6;
@@ -139,10 +445,15 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
         double fx = -fam->mdat[i - 1];
         double fb = -fam->mdat[i];
         int status;
+        struct fminimizer_params params;
         gsl_function F;
         gsl_min_fminimizer * s;
+        params.eos = eos;
+        params.work = XLALCreateSimNeutronStarTOVWorkspace();
+        if (!params.work)
+            goto failure;
         F.function = &fminimizer_gslfunction;
-        F.params = eos;
+        F.params = &params;
         s = gsl_min_fminimizer_alloc(gsl_min_fminimizer_brent);
         gsl_min_fminimizer_set_with_values(s, &F, x, fx, a, fa, b, fb);
         do {
@@ -154,24 +465,38 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
         } while (status == GSL_CONTINUE);
         gsl_min_fminimizer_free(s);
         fam->pdat[i] = x;
-        XLALSimNeutronStarTOVODEIntegrate(&fam->rdat[i], &fam->mdat[i],
-            &fam->kdat[i], fam->pdat[i], eos);
+        XLALSimNeutronStarTOVODEIntegrateWithWorkspace(&fam->rdat[i],
+            &fam->mdat[i], &fam->kdat[i], fam->pdat[i], eos, params.work);
+        XLALDestroySimNeutronStarTOVWorkspace(params.work);
 
         /* resize arrays */
         if(fam->pdat[i] <= fam->pdat[i-1]){
             fam->pdat[i-1] = fam->pdat[i];
+            fam->mdat[i-1] = fam->mdat[i];
+            fam->rdat[i-1] = fam->rdat[i];
+            fam->kdat[i-1] = fam->kdat[i];
             ndat = i;
         }
         else{
             ndat = i + 1;
         }
-
-        fam->pdat = LALRealloc(fam->pdat, ndat * sizeof(*fam->pdat));
-        fam->mdat = LALRealloc(fam->mdat, ndat * sizeof(*fam->mdat));
-        fam->rdat = LALRealloc(fam->rdat, ndat * sizeof(*fam->rdat));
-        fam->kdat = LALRealloc(fam->kdat, ndat * sizeof(*fam->kdat));
     }
+
+    LALFree(inew);
+    LALFree(knew);
+    LALFree(rnew);
+    LALFree(mnew);
+    LALFree(pnew);
+
+    fam->pdat = LALRealloc(fam->pdat, ndat * sizeof(*fam->pdat));
+    fam->mdat = LALRealloc(fam->mdat, ndat * sizeof(*fam->mdat));
+    fam->rdat = LALRealloc(fam->rdat, ndat * sizeof(*fam->rdat));
+    fam->kdat = LALRealloc(fam->kdat, ndat * sizeof(*fam->kdat));
     fam->ndat = ndat;
+    family_cache_insert(fam, hash, key, keysize);
+    LALFree(key);
+
+setup:
 
     /* setup interpolators */
 
@@ -188,6 +513,18 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
     gsl_interp_init(fam->k_of_m_interp, fam->mdat, fam->kdat, ndat);
 
     return fam;
+
+nomem:
+    errnum = XLAL_ENOMEM;
+failure:
+    XLALFree(key);
+    XLALFree(inew);
+    XLALFree(knew);
+    XLALFree(rnew);
+    XLALFree(mnew);
+    XLALFree(pnew);
+    XLALDestroySimNeutronStarFamily(fam);
+    XLAL_ERROR_NULL(errnum);
 }
 
 /**
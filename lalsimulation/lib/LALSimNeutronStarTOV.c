@@ -116,8 +116,61 @@ static int tov_ode(double h, const double *y, double *dy, void *params)
     return 0;
 }
 
+/* Contents of the TOV integration workspace. */
+struct tagLALSimNeutronStarTOVWorkspace {
+    gsl_odeiv_step *step;
+    gsl_odeiv_control *ctrl;
+    gsl_odeiv_evolve *evolv;
+};
+
 /** @endcond */
 
+/**
+ * @brief Allocates a workspace for repeated TOV integrations.
+ * @details
+ * The workspace holds the GSL ODE stepper, step-size control and evolution
+ * objects so that they need not be reallocated for every star when a whole
+ * family of stars is computed.  A workspace must only be used by one thread
+ * at a time.
+ * @return A pointer to the workspace, or NULL on failure.
+ */
+LALSimNeutronStarTOVWorkspace *XLALCreateSimNeutronStarTOVWorkspace(void)
+{
+    const double epsabs = 0.0, epsrel = 1e-6;
+    LALSimNeutronStarTOVWorkspace *work;
+
+    work = LALCalloc(1, sizeof(*work));
+    if (!work)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    work->step = gsl_odeiv_step_alloc(gsl_odeiv_step_rk8pd, TOV_ODE_VARS_DIM);
+    work->ctrl = gsl_odeiv_control_y_new(epsabs, epsrel);
+    work->evolv = gsl_odeiv_evolve_alloc(TOV_ODE_VARS_DIM);
+    if (!work->step || !work->ctrl || !work->evolv) {
+        XLALDestroySimNeutronStarTOVWorkspace(work);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    return work;
+}
+
+/**
+ * @brief Frees a TOV integration workspace.
+ * @param work Pointer to the workspace to be freed.
+ */
+void XLALDestroySimNeutronStarTOVWorkspace(LALSimNeutronStarTOVWorkspace *
+    work)
+{
+    if (work) {
+        if (work->evolv)
+            gsl_odeiv_evolve_free(work->evolv);
+        if (work->ctrl)
+            gsl_odeiv_control_free(work->ctrl);
+        if (work->step)
+            gsl_odeiv_step_free(work->step);
+        LALFree(work);
+    }
+    return;
+}
+
 /**
  * @brief Integrates the Tolman-Oppenheimer-Volkov stellar structure equations.
  * @details
@@ -136,17 +189,45 @@ static int tov_ode(double h, const double *y, double *dy, void *params)
 int XLALSimNeutronStarTOVODEIntegrate(double *radius, double *mass,
     double *love_number_k2, double central_pressure_si,
     LALSimNeutronStarEOS * eos)
+{
+    LALSimNeutronStarTOVWorkspace *work;
+    int status;
+
+    work = XLALCreateSimNeutronStarTOVWorkspace();
+    if (!work)
+        XLAL_ERROR(XLAL_EFUNC);
+    status = XLALSimNeutronStarTOVODEIntegrateWithWorkspace(radius, mass,
+        love_number_k2, central_pressure_si, eos, work);
+    XLALDestroySimNeutronStarTOVWorkspace(work);
+    if (status < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    return 0;
+}
+
+/**
+ * @brief Integrates the Tolman-Oppenheimer-Volkov stellar structure equations
+ * using a preallocated workspace.
+ * @details
+ * Identical to XLALSimNeutronStarTOVODEIntegrate() but reuses the ODE
+ * objects in @a work, which is reset before the integration.
+ * @param[out] radius The radius of the star in m.
+ * @param[out] mass The mass of the star in kg.
+ * @param[out] love_number_k2 The k_2 tidal love number of the star.
+ * @param[in] central_pressure_si The central pressure of the star in Pa.
+ * @param eos Pointer to the Equation of State structure.
+ * @param work Pointer to the TOV integration workspace.
+ * @retval 0 Success.
+ * @retval <0 Failure.
+ */
+int XLALSimNeutronStarTOVODEIntegrateWithWorkspace(double *radius,
+    double *mass, double *love_number_k2, double central_pressure_si,
+    LALSimNeutronStarEOS * eos, LALSimNeutronStarTOVWorkspace * work)
 {
     /* ode integration variables */
-    const double epsabs = 0.0, epsrel = 1e-6;
     double y[TOV_ODE_VARS_DIM];
     double dy[TOV_ODE_VARS_DIM];
     struct tov_ode_vars *vars = tov_ode_vars_cast(y);
     gsl_odeiv_system sys = { tov_ode, NULL, TOV_ODE_VARS_DIM, eos };
-    gsl_odeiv_step *step =
-        gsl_odeiv_step_alloc(gsl_odeiv_step_rk8pd, TOV_ODE_VARS_DIM);
-    gsl_odeiv_control *ctrl = gsl_odeiv_control_y_new(epsabs, epsrel);
-    gsl_odeiv_evolve *evolv = gsl_odeiv_evolve_alloc(TOV_ODE_VARS_DIM);
 
     /* central values */
     /* note: will be updated with Lindblom's series expansion */
@@ -180,6 +261,10 @@ int XLALSimNeutronStarTOVODEIntegrate(double *radius, double *mass,
     /* second factor of Eq. (8) of Lindblom (1992) */
     m0 *= 1.0 + 0.6 * dh * dedh_c / ec;
 
+    XLAL_CHECK(work, XLAL_EFAULT);
+    gsl_odeiv_step_reset(work->step);
+    gsl_odeiv_evolve_reset(work->evolv);
+
     /* perform integration */
     vars->r = r0;
     vars->m = m0;
@@ -188,7 +273,8 @@ int XLALSimNeutronStarTOVODEIntegrate(double *radius, double *mass,
     h = h0;
     while (h > h1) {
         int s =
-            gsl_odeiv_evolve_apply(evolv, ctrl, step, &sys, &h, h1, &dh, y);
+            gsl_odeiv_evolve_apply(work->evolv, work->ctrl, work->step, &sys,
+            &h, h1, &dh, y);
         if (s != GSL_SUCCESS)
             XLAL_ERROR(XLAL_EERR,
                 "Error encountered in GSL's ODE integrator\n");
@@ -207,11 +293,6 @@ int XLALSimNeutronStarTOVODEIntegrate(double *radius, double *mass,
     *radius = vars->r;
     *mass = vars->m * LAL_MSUN_SI / LAL_MRSUN_SI;
     *love_number_k2 = tidal_Love_number_k2(c, yy);
-
-    /* free ode memory */
-    gsl_odeiv_evolve_free(evolv);
-    gsl_odeiv_control_free(ctrl);
-    gsl_odeiv_step_free(step);
     return 0;
 }
 
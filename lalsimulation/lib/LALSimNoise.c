@@ -19,6 +19,7 @@
 
 #include <complex.h>
 #include <math.h>
+#include <stdint.h>
 #include <string.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_randist.h>
@@ -27,12 +28,18 @@
 #include <lal/LALConstants.h>
 #include <lal/LALStdlib.h>
 #include <lal/FrequencySeries.h>
+#include <lal/LogPrintf.h>
+#include <lal/RealFFT.h>
 #include <lal/Sequence.h>
 #include <lal/TimeSeries.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/Units.h>
 #include <lal/LALSimNoise.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 
 /* 
  * This routine generates a single segment of data.  Note that this segment is
@@ -197,6 +204,302 @@ int XLALSimNoise(
 	return 0;
 }
 
+/*
+ * Counter-based random numbers for the noise streams: the Philox4x32-10
+ * generator of J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+ * "Parallel random numbers: as easy as 1, 2, 3", Proc. SC11 (2011).  Each
+ * output is a function of a counter and a key only, so any part of a
+ * stream can be generated on its own, in any order and on any thread.
+ */
+#define PHILOX_M0 UINT32_C(0xD2511F53)
+#define PHILOX_M1 UINT32_C(0xCD9E8D57)
+#define PHILOX_W0 UINT32_C(0x9E3779B9)
+#define PHILOX_W1 UINT32_C(0xBB67AE85)
+
+static void philox4x32_10(uint32_t ctr[4], const uint32_t key[2])
+{
+	uint32_t k0 = key[0];
+	uint32_t k1 = key[1];
+	int r;
+	for (r = 0; r < 10; ++r) {
+		uint64_t p0 = (uint64_t)PHILOX_M0 * ctr[0];
+		uint64_t p1 = (uint64_t)PHILOX_M1 * ctr[2];
+		uint32_t c1 = ctr[1];
+		uint32_t c3 = ctr[3];
+		ctr[0] = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+		ctr[1] = (uint32_t)p1;
+		ctr[2] = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+		ctr[3] = (uint32_t)p0;
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+	}
+	return;
+}
+
+/* uniform deviate in (0,1) from two 32-bit words, with 53 random bits */
+static double philox_uniform(uint32_t a, uint32_t b)
+{
+	return ((a >> 5) * 67108864.0 + (b >> 6) + 0.5) / 9007199254740992.0;
+}
+
+/* number of output blocks generated in sequence by one thread */
+#define SIMNOISE_STREAM_CHUNK 16
+
+struct tagLALSimNoiseStream {
+	LIGOTimeGPS epoch;	/* time of sample zero of the stream */
+	REAL8 deltaT;		/* sample interval */
+	LALUnit sampleUnits;	/* units of the noise */
+	size_t length;		/* length of a segment */
+	size_t stride;		/* stride between segments, length / 2 */
+	uint32_t key[2];	/* random number key, from the seed */
+	REAL8 *amp;		/* rms of the Fourier components of a segment */
+	REAL8 *x;		/* feathering window of the earlier segment */
+	REAL8 *y;		/* feathering window of the later segment */
+	REAL8FFTPlan *plan;	/* reverse FFT plan, shared by all threads */
+	UINT8 nsamples;		/* samples generated so far */
+	REAL8 elapsed;		/* wall clock time spent generating them */
+};
+
+/*
+ * This routine generates segment k of a noise stream: the Fourier
+ * components are complex Gaussian deviates, found by the Box-Muller method
+ * from the random numbers with counter (bin, k) so that the segment does
+ * not depend on which other segments have been generated.
+ */
+static int XLALSimNoiseStreamSegment(REAL8Vector *seg, COMPLEX16Vector *stilde, const LALSimNoiseStream *stream, UINT8 k)
+{
+	size_t i;
+	for (i = 0; i < stilde->length; ++i) {
+		uint32_t ctr[4] = { (uint32_t)i, (uint32_t)k, (uint32_t)(k >> 32), 0 };
+		double r, phi;
+		philox4x32_10(ctr, stream->key);
+		r = stream->amp[i] * sqrt(-2.0 * log(philox_uniform(ctr[0], ctr[1])));
+		phi = LAL_TWOPI * philox_uniform(ctr[2], ctr[3]);
+		stilde->data[i] = r * cos(phi) + I * r * sin(phi);
+	}
+	if (XLALREAL8ReverseFFT(seg, stilde, stream->plan) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+/**
+ * @brief Creates a stream of simulated noise with a specified power spectrum.
+ *
+ * The stream is an infinite sequence of samples, starting at epoch, with the
+ * same statistics as the output of XLALSimNoise() with a stride of half the
+ * segment length: segments of length 2 * (psd->data->length - 1) are
+ * generated in the frequency domain, with sampling interval
+ * 1 / (length * psd->deltaF), and feathered together with half overlap.
+ * Unlike XLALSimNoise(), the random numbers of segment k are produced by a
+ * counter-based generator keyed by seed and indexed by k, so every stretch
+ * of the stream can be generated independently, in parallel and in any
+ * order, with XLALSimNoiseStreamGenerate(), and the result depends only on
+ * the seed.  Different detectors should use different seeds.
+ *
+ * The reverse FFT plan and the spectrum are cached in the stream.
+ */
+LALSimNoiseStream *XLALSimNoiseStreamCreate(
+	const REAL8FrequencySeries *psd,	/**< [in] power spectrum frequency series */
+	const LIGOTimeGPS *epoch,		/**< [in] time of sample zero of the stream */
+	UINT8 seed				/**< [in] random number seed */
+)
+{
+	LALSimNoiseStream *stream;
+	size_t j;
+
+	if (!psd || !psd->data || !epoch)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if (psd->data->length < 2 || !(psd->deltaF > 0.0))
+		XLAL_ERROR_NULL(XLAL_EINVAL);
+
+	stream = XLALCalloc(1, sizeof(*stream));
+	if (!stream)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+	stream->epoch = *epoch;
+	stream->length = 2 * (psd->data->length - 1);
+	stream->stride = stream->length / 2;
+	stream->deltaT = 1.0 / (stream->length * psd->deltaF);
+	stream->key[0] = (uint32_t)seed;
+	stream->key[1] = (uint32_t)(seed >> 32);
+
+	/* correct units: [s] = sqrt([psd] * seconds) * Hertz */
+	XLALUnitMultiply(&stream->sampleUnits, &psd->sampleUnits, &lalSecondUnit);
+	XLALUnitSqrt(&stream->sampleUnits, &stream->sampleUnits);
+	XLALUnitMultiply(&stream->sampleUnits, &stream->sampleUnits, &lalHertzUnit);
+
+	stream->amp = XLALMalloc(psd->data->length * sizeof(*stream->amp));
+	stream->x = XLALMalloc(stream->stride * sizeof(*stream->x));
+	stream->y = XLALMalloc(stream->stride * sizeof(*stream->y));
+	stream->plan = XLALCreateReverseREAL8FFTPlan(stream->length, 1);
+	if (!stream->amp || !stream->x || !stream->y || !stream->plan) {
+		XLALSimNoiseStreamDestroy(stream);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	/* rms of each quadrature of the Fourier components, including the
+	 * deltaF normalization of the reverse FFT */
+	for (j = 0; j < psd->data->length; ++j)
+		stream->amp[j] = 0.5 * sqrt(psd->data->data[j] * psd->deltaF);
+
+	for (j = 0; j < stream->stride; ++j) {
+		stream->x[j] = cos(LAL_PI*j/(2.0 * stream->stride));
+		stream->y[j] = sin(LAL_PI*j/(2.0 * stream->stride));
+	}
+
+	return stream;
+}
+
+/**
+ * @brief Destroys a noise stream created by XLALSimNoiseStreamCreate().
+ */
+void XLALSimNoiseStreamDestroy(LALSimNoiseStream *stream)
+{
+	if (stream) {
+		XLALDestroyREAL8FFTPlan(stream->plan);
+		XLALFree(stream->y);
+		XLALFree(stream->x);
+		XLALFree(stream->amp);
+		XLALFree(stream);
+	}
+	return;
+}
+
+/**
+ * @brief Generates the samples offset, offset + 1, ... of a noise stream
+ * into the preallocated time series s.
+ *
+ * The whole length of s is filled, and its epoch, sample interval and units
+ * are set.  Runs of consecutive blocks of the output are generated in
+ * parallel, each thread reusing its own segment buffers, and the output is
+ * identical whatever the number of threads and however a stretch of the
+ * stream is split between calls.  Throughput is reported with
+ * XLALPrintInfo() and accumulated in the stream, see
+ * XLALSimNoiseStreamThroughput().
+ *
+ * For example, the following generates a month of Advanced LIGO noise in
+ * one hour long pieces, which could equally be generated on different
+ * machines:
+ *
+ * @code
+ * const double srate = 16384.0, duration = 16.0;
+ * size_t length = duration * srate, n = 3600 * srate, k;
+ * LIGOTimeGPS epoch = { 1000000000, 0 };
+ * REAL8FrequencySeries *psd;
+ * REAL8TimeSeries *seg;
+ * LALSimNoiseStream *stream;
+ * psd = XLALCreateREAL8FrequencySeries("PSD", &epoch, 0.0, 1.0/duration, &lalSecondUnit, length/2 + 1);
+ * XLALSimNoisePSD(psd, 10.0, XLALSimNoisePSDaLIGOZeroDetHighPower);
+ * stream = XLALSimNoiseStreamCreate(psd, &epoch, 1234);
+ * seg = XLALCreateREAL8TimeSeries("STRAIN", &epoch, 0.0, 1.0/srate, &lalStrainUnit, n);
+ * for (k = 0; k < 30 * 24; ++k) {
+ * 	XLALSimNoiseStreamGenerate(seg, stream, k * n);
+ * 	// ... write out seg ...
+ * }
+ * @endcode
+ */
+int XLALSimNoiseStreamGenerate(
+	REAL8TimeSeries *s,		/**< [out] noise time series */
+	LALSimNoiseStream *stream,	/**< [in] noise stream */
+	UINT8 offset			/**< [in] index of the first sample of s in the stream */
+)
+{
+	const size_t length = stream ? stream->length : 0;
+	const size_t stride = stream ? stream->stride : 0;
+	UINT8 first, end, b0, nblocks, nchunks;
+	REAL8 t0, elapsed;
+	int failed = 0;
+
+	if (!s || !s->data || !stream)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	t0 = XLALGetTimeOfDay();
+
+	first = offset;
+	end = offset + s->data->length;
+	b0 = first / stride;
+	nblocks = s->data->length ? (end - 1) / stride - b0 + 1 : 0;
+	nchunks = (nblocks + SIMNOISE_STREAM_CHUNK - 1) / SIMNOISE_STREAM_CHUNK;
+
+	#pragma omp parallel
+	{
+		REAL8Vector *seg0 = XLALCreateREAL8Vector(length);
+		REAL8Vector *seg1 = XLALCreateREAL8Vector(length);
+		COMPLEX16Vector *stilde = XLALCreateCOMPLEX16Vector(length/2 + 1);
+		UINT8 c;
+		if (!seg0 || !seg1 || !stilde) {
+			#pragma omp atomic write
+			failed = 1;
+		}
+
+		/* block b of the output is the feathering of the second half of
+		 * segment b with the first half of segment b + 1 */
+		#pragma omp for schedule(dynamic)
+		for (c = 0; c < nchunks; ++c) {
+			UINT8 b = b0 + c * SIMNOISE_STREAM_CHUNK;
+			UINT8 bend = b + SIMNOISE_STREAM_CHUNK < b0 + nblocks ? b + SIMNOISE_STREAM_CHUNK : b0 + nblocks;
+			int stop;
+			#pragma omp atomic read
+			stop = failed;
+			if (stop)
+				continue;
+
+			if (XLALSimNoiseStreamSegment(seg0, stilde, stream, b) < 0) {
+				#pragma omp atomic write
+				failed = 1;
+				continue;
+			}
+			for (; b < bend; ++b) {
+				REAL8Vector *tmp;
+				UINT8 lo = b * stride > first ? b * stride : first;
+				UINT8 hi = (b + 1) * stride < end ? (b + 1) * stride : end;
+				UINT8 t;
+				if (XLALSimNoiseStreamSegment(seg1, stilde, stream, b + 1) < 0) {
+					#pragma omp atomic write
+					failed = 1;
+					break;
+				}
+				for (t = lo; t < hi; ++t) {
+					size_t j = t - b * stride;
+					s->data->data[t - first] = stream->x[j] * seg0->data[stride + j] + stream->y[j] * seg1->data[j];
+				}
+				tmp = seg0;
+				seg0 = seg1;
+				seg1 = tmp;
+			}
+		}
+
+		XLALDestroyCOMPLEX16Vector(stilde);
+		XLALDestroyREAL8Vector(seg1);
+		XLALDestroyREAL8Vector(seg0);
+	}
+	if (failed)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	s->epoch = stream->epoch;
+	XLALGPSAdd(&s->epoch, offset * stream->deltaT);
+	s->deltaT = stream->deltaT;
+	s->f0 = 0.0;
+	s->sampleUnits = stream->sampleUnits;
+
+	elapsed = XLALGetTimeOfDay() - t0;
+	stream->nsamples += s->data->length;
+	stream->elapsed += elapsed;
+	XLALPrintInfo("%s: generated %u samples in %g s (%g samples/s)\n", __func__, s->data->length, elapsed, elapsed > 0.0 ? s->data->length / elapsed : 0.0);
+	return 0;
+}
+
+/**
+ * @brief Returns the average rate, in samples per second of wall clock time,
+ * at which XLALSimNoiseStreamGenerate() has generated samples of the stream.
+ */
+REAL8 XLALSimNoiseStreamThroughput(const LALSimNoiseStream *stream)
+{
+	if (!stream)
+		XLAL_ERROR_REAL8(XLAL_EFAULT);
+	return stream->elapsed > 0.0 ? stream->nsamples / stream->elapsed : 0.0;
+}
+
 /** @} */
 
 /*
@@ -70,6 +70,12 @@ SWIGLAL(FUNCTION_POINTER(aLIGOQuantumHighFrequency, XLALSimNoisePSDAdvVirgo,
 
 int XLALSimNoise(REAL8TimeSeries *s, size_t stride, REAL8FrequencySeries *psd, gsl_rng *rng);
 
+typedef struct tagLALSimNoiseStream LALSimNoiseStream;
+LALSimNoiseStream *XLALSimNoiseStreamCreate(const REAL8FrequencySeries *psd, const LIGOTimeGPS *epoch, UINT8 seed);
+void XLALSimNoiseStreamDestroy(LALSimNoiseStream *stream);
+int XLALSimNoiseStreamGenerate(REAL8TimeSeries *s, LALSimNoiseStream *stream, UINT8 offset);
+REAL8 XLALSimNoiseStreamThroughput(const LALSimNoiseStream *stream);
+
 
 /*
  * PSD GENERATION FUNCTIONS
@@ -0,0 +1,547 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <libgen.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALString.h>
+#include <lal/XLALError.h>
+#include <lal/AVFactories.h>
+#include <lal/LALHashFunc.h>
+
+#ifdef LAL_HDF5_ENABLED
+#include <lal/H5FileIO.h>
+#endif
+
+#include "LALSimROMDataStore.h"
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+/* layout of a cache file: a fixed header padded to ROM_CACHE_DATA_OFFSET
+ * bytes followed by the dataset as contiguous native-endian doubles in
+ * row-major order */
+#define ROM_CACHE_MAGIC "LALROMC"
+#define ROM_CACHE_VERSION 1
+#define ROM_CACHE_BYTEORDER 0x01020304
+#define ROM_CACHE_DATA_OFFSET 64
+#define ROM_CACHE_SUFFIX ".romcache"
+
+struct rom_cache_header {
+  char magic[8];
+  UINT4 version;
+  UINT4 byteorder;
+  UINT4 ndim;
+  UINT4 pad;
+  UINT8 dims[2];
+  INT8 source_size;
+  INT8 source_mtime;
+};
+
+struct tagROMDataStore {
+  char *path;           /* HDF5 data file */
+  char *cachedir;       /* directory for cache files; NULL disables the cache */
+  char *prefix;         /* file name of path and hash of its location,
+                         * used to name cache files */
+  INT8 source_size;     /* size and modification time of the HDF5 file; */
+  INT8 source_mtime;    /* cache files made from other versions are stale */
+#ifdef LAL_HDF5_ENABLED
+  LALH5File *file;      /* opened on the first cache miss */
+#endif
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_t lock;
+#endif
+};
+
+/* Open a store for the HDF5 ROM data file at path */
+ROMDataStore *ROMDataStore_Open(const char *path)
+{
+  ROMDataStore *store;
+  struct stat st;
+  const char *env;
+  const char *xdg;
+  const char *home;
+  char *tmp;
+
+  if (path == NULL)
+    XLAL_ERROR_NULL(XLAL_EFAULT);
+  if (stat(path, &st) < 0)
+    XLAL_ERROR_NULL(XLAL_EIO, "Could not stat ROM data file `%s'", path);
+
+  store = XLALCalloc(1, sizeof(*store));
+  if (store == NULL)
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_init(&store->lock, NULL);
+#endif
+  store->source_size = st.st_size;
+  store->source_mtime = st.st_mtime;
+
+  /* cache files are named after the data file and its location, so that
+   * different installations sharing a cache directory do not collide;
+   * basename() may modify its argument */
+  store->path = XLALStringDuplicate(path);
+  if (store->path == NULL)
+    goto failure;
+  tmp = XLALStringDuplicate(path);
+  if (tmp == NULL)
+    goto failure;
+  {
+    char resolved[PATH_MAX];
+    const char *where = realpath(path, resolved) ? resolved : path;
+    store->prefix = XLALStringAppendFmt(NULL, "%s.%016llx", basename(tmp), (unsigned long long)XLALCityHash64(where, strlen(where)));
+  }
+  XLALFree(tmp);
+  if (store->prefix == NULL)
+    goto failure;
+
+  /* cache files go in LAL_ROM_CACHE_DIR if it is set, where an empty value
+   * disables the cache, and otherwise in the user's cache directory */
+  env = getenv("LAL_ROM_CACHE_DIR");
+  xdg = getenv("XDG_CACHE_HOME");
+  home = getenv("HOME");
+  if (env) {
+    if (*env && (store->cachedir = XLALStringDuplicate(env)) == NULL)
+      goto failure;
+  } else if (xdg && *xdg == '/') {      /* relative paths are to be ignored */
+    if ((store->cachedir = XLALStringAppendFmt(NULL, "%s/lalsimulation", xdg)) == NULL)
+      goto failure;
+  } else if (home && *home) {
+    if ((store->cachedir = XLALStringAppendFmt(NULL, "%s/.cache/lalsimulation", home)) == NULL)
+      goto failure;
+  }
+
+  return store;
+
+failure:
+  ROMDataStore_Close(store);
+  XLAL_ERROR_NULL(XLAL_EFUNC);
+}
+
+/* Close the store; data already handed out remains valid */
+void ROMDataStore_Close(ROMDataStore *store)
+{
+  if (store == NULL)
+    return;
+#ifdef LAL_HDF5_ENABLED
+  if (store->file)
+    XLALH5FileClose(store->file);
+#endif
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_destroy(&store->lock);
+#endif
+  XLALFree(store->cachedir);
+  XLALFree(store->prefix);
+  XLALFree(store->path);
+  XLALFree(store);
+}
+
+/* Name of the cache file for dataset group/name, or NULL if caching is
+ * disabled for this store */
+static char *rom_cache_filename(const ROMDataStore *store, const char *group, const char *name)
+{
+  char *fname;
+  size_t i, n;
+
+  if (store->cachedir == NULL)
+    return NULL;
+  if (group)
+    fname = XLALStringAppendFmt(NULL, "%s/%s.%s/%s" ROM_CACHE_SUFFIX, store->cachedir, store->prefix, group, name);
+  else
+    fname = XLALStringAppendFmt(NULL, "%s/%s.%s" ROM_CACHE_SUFFIX, store->cachedir, store->prefix, name);
+  if (fname == NULL)
+    return NULL;
+
+  /* flatten the HDF5 path so that every cache file is in cachedir */
+  n = strlen(store->cachedir) + 1;
+  for (i = n; fname[i]; ++i)
+    if (fname[i] == '/')
+      fname[i] = '.';
+  return fname;
+}
+
+/* Map a cache file and check it against the store and the expected rank.
+ * Returns a pointer to the data, or NULL (without raising an error) if the
+ * cache file is missing, stale or corrupt.  The mapping is private and
+ * writable so that callers may modify their copy; untouched pages stay
+ * shared with every other process mapping the same file. */
+static double *rom_cache_map(const ROMDataStore *store, const char *fname, UINT4 ndim, size_t dims[2])
+{
+  struct rom_cache_header hdr;
+  struct stat st;
+  void *base;
+  size_t n;
+  UINT4 i;
+  int fd;
+
+  fd = open(fname, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+  if (fstat(fd, &st) < 0 || st.st_size < ROM_CACHE_DATA_OFFSET) {
+    close(fd);
+    return NULL;
+  }
+  base = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return NULL;
+
+  memcpy(&hdr, base, sizeof(hdr));
+  for (n = 1, i = 0; i < ndim && i < 2; ++i)
+    n *= hdr.dims[i];
+  if (memcmp(hdr.magic, ROM_CACHE_MAGIC, sizeof(ROM_CACHE_MAGIC)) != 0
+      || hdr.version != ROM_CACHE_VERSION
+      || hdr.byteorder != ROM_CACHE_BYTEORDER
+      || hdr.ndim != ndim
+      || hdr.source_size != store->source_size
+      || hdr.source_mtime != store->source_mtime
+      || (size_t)st.st_size != ROM_CACHE_DATA_OFFSET + n * sizeof(double)) {
+    munmap(base, st.st_size);
+    return NULL;
+  }
+
+  for (i = 0; i < ndim; ++i)
+    dims[i] = hdr.dims[i];
+  return (double *)((char *)base + ROM_CACHE_DATA_OFFSET);
+}
+
+/* Create directory dir and any missing parents */
+static int rom_cache_mkdir(const char *dir)
+{
+  char *tmp, *p;
+  int ret = 0;
+
+  tmp = XLALStringDuplicate(dir);
+  if (tmp == NULL)
+    return -1;
+  for (p = tmp + 1; ret == 0; ++p)
+    if (*p == '/' || *p == '\0') {
+      const char c = *p;
+      *p = '\0';
+      if (mkdir(tmp, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) < 0 && errno != EEXIST)
+        ret = -1;
+      *p = c;
+      if (c == '\0')
+        break;
+    }
+  XLALFree(tmp);
+  return ret;
+}
+
+/* Write a cache file.  The file is written under a temporary name and
+ * renamed into place so that concurrent readers in other processes only
+ * ever see complete files.  Failure is not an error: the caller falls back
+ * to the data it already has on the heap. */
+static int rom_cache_write(const ROMDataStore *store, const char *fname, UINT4 ndim, const size_t dims[2], const double *data)
+{
+  char header[ROM_CACHE_DATA_OFFSET];
+  struct rom_cache_header hdr;
+  const char *p;
+  char *tmpname;
+  size_t n, len;
+  UINT4 i;
+  int fd;
+
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, ROM_CACHE_MAGIC, sizeof(ROM_CACHE_MAGIC));
+  hdr.version = ROM_CACHE_VERSION;
+  hdr.byteorder = ROM_CACHE_BYTEORDER;
+  hdr.ndim = ndim;
+  for (n = 1, i = 0; i < ndim; ++i)
+    n *= hdr.dims[i] = dims[i];
+  hdr.source_size = store->source_size;
+  hdr.source_mtime = store->source_mtime;
+  memset(header, 0, sizeof(header));
+  memcpy(header, &hdr, sizeof(hdr));
+
+  tmpname = XLALStringAppendFmt(NULL, "%s.XXXXXX", fname);
+  if (tmpname == NULL)
+    return -1;
+  fd = rom_cache_mkdir(store->cachedir) == 0 ? mkstemp(tmpname) : -1;
+  if (fd < 0) {
+    XLALPrintInfo("%s: cannot create ROM cache file `%s'; reading data onto the heap\n", __func__, fname);
+    XLALFree(tmpname);
+    return -1;
+  }
+  /* a cache directory given by LAL_ROM_CACHE_DIR may be shared */
+  fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+  if (write(fd, header, sizeof(header)) != (ssize_t)sizeof(header))
+    goto failure;
+  for (p = (const char *)data, len = n * sizeof(double); len > 0; ) {
+    ssize_t c = write(fd, p, len);
+    if (c <= 0)
+      goto failure;
+    p += c;
+    len -= c;
+  }
+  if (close(fd) < 0) {
+    fd = -1;
+    goto failure;
+  }
+  if (rename(tmpname, fname) < 0) {
+    fd = -1;
+    goto failure;
+  }
+  XLALFree(tmpname);
+  return 0;
+
+failure:
+  XLALPrintInfo("%s: failed to write ROM cache file `%s'\n", __func__, fname);
+  if (fd >= 0)
+    close(fd);
+  unlink(tmpname);
+  XLALFree(tmpname);
+  return -1;
+}
+
+/* Read dataset group/name of rank ndim from the HDF5 file onto the heap */
+static double *rom_hdf5_read(ROMDataStore UNUSED *store, const char UNUSED *group, const char UNUSED *name, UINT4 UNUSED ndim, size_t UNUSED dims[2])
+{
+#ifdef LAL_HDF5_ENABLED
+  LALH5Dataset *dset = NULL;
+  UINT4Vector *dimLength = NULL;
+  double *data = NULL;
+  char *dname;
+  size_t n;
+  UINT4 i;
+
+  dname = group ? XLALStringAppendFmt(NULL, "%s/%s", group, name) : XLALStringDuplicate(name);
+  if (dname == NULL)
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_lock(&store->lock);
+#endif
+  if (store->file == NULL)
+    store->file = XLALH5FileOpen(store->path, "r");
+  if (store->file)
+    dset = XLALH5DatasetRead(store->file, dname);
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_unlock(&store->lock);
+#endif
+  if (dset == NULL) {
+    XLALFree(dname);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+
+  if (XLALH5DatasetQueryType(dset) != LAL_D_TYPE_CODE) {
+    XLALPrintError("Dataset `%s' is wrong type\n", dname);
+    XLALH5DatasetFree(dset);
+    XLALFree(dname);
+    XLAL_ERROR_NULL(XLAL_ETYPE);
+  }
+
+  dimLength = XLALH5DatasetQueryDims(dset);
+  if (dimLength == NULL) {
+    XLALH5DatasetFree(dset);
+    XLALFree(dname);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+  if (dimLength->length != ndim) {
+    XLALPrintError("Dataset `%s' must be %u-dimensional\n", dname, ndim);
+    XLALDestroyUINT4Vector(dimLength);
+    XLALH5DatasetFree(dset);
+    XLALFree(dname);
+    XLAL_ERROR_NULL(XLAL_EDIMS);
+  }
+  for (n = 1, i = 0; i < ndim; ++i)
+    n *= dims[i] = dimLength->data[i];
+  XLALDestroyUINT4Vector(dimLength);
+  XLALFree(dname);
+
+  data = XLALMalloc(n * sizeof(*data));
+  if (data == NULL) {
+    XLALH5DatasetFree(dset);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+  if (XLALH5DatasetQueryData(data, dset) < 0) {
+    XLALFree(data);
+    XLALH5DatasetFree(dset);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+
+  XLALH5DatasetFree(dset);
+  return data;
+#else
+  XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 support not enabled");
+#endif
+}
+
+/* Get dataset group/name of rank ndim.  On return *mapped says whether the
+ * data lives in a cache file mapping or was allocated with XLALMalloc. */
+static double *rom_data_get(ROMDataStore *store, const char *group, const char *name, UINT4 ndim, size_t dims[2], int *mapped)
+{
+  char *fname;
+  double *data;
+
+  if (store == NULL || name == NULL)
+    XLAL_ERROR_NULL(XLAL_EFAULT);
+
+  fname = rom_cache_filename(store, group, name);
+  if (fname && (data = rom_cache_map(store, fname, ndim, dims))) {
+    XLALFree(fname);
+    *mapped = 1;
+    return data;
+  }
+
+  data = rom_hdf5_read(store, group, name, ndim, dims);
+  if (data == NULL) {
+    XLALFree(fname);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+
+  if (fname && rom_cache_write(store, fname, ndim, dims, data) == 0) {
+    double *mdata = rom_cache_map(store, fname, ndim, dims);
+    if (mdata) {
+      XLALFree(fname);
+      XLALFree(data);
+      *mapped = 1;
+      return mdata;
+    }
+  }
+
+  XLALFree(fname);
+  *mapped = 0;
+  return data;
+}
+
+/* Release data of n elements obtained from rom_data_get() */
+static void rom_data_release(double *data, size_t n, int mapped)
+{
+  if (mapped)
+    munmap((char *)data - ROM_CACHE_DATA_OFFSET, ROM_CACHE_DATA_OFFSET + n * sizeof(double));
+  else
+    XLALFree(data);
+}
+
+/* Read a 1-dimensional dataset.  If *data is NULL a new gsl_vector is
+ * returned that views the mapped cache file; otherwise the dataset is
+ * copied into the existing vector, which must have the right size. */
+int ROMDataStore_ReadRealVector(ROMDataStore *store, const char *group, const char *name, gsl_vector **data)
+{
+  size_t dims[2];
+  double *d;
+  int mapped;
+
+  if (data == NULL)
+    XLAL_ERROR(XLAL_EFAULT);
+
+  d = rom_data_get(store, group, name, 1, dims, &mapped);
+  if (d == NULL)
+    XLAL_ERROR(XLAL_EFUNC);
+
+  if (*data == NULL && mapped) {
+    /* gsl_vector_free() releases the header with free() */
+    gsl_vector *v = malloc(sizeof(*v));
+    if (v == NULL) {
+      rom_data_release(d, dims[0], mapped);
+      XLAL_ERROR(XLAL_ENOMEM);
+    }
+    v->size = dims[0];
+    v->stride = 1;
+    v->data = d;
+    v->block = NULL;
+    v->owner = 0;
+    *data = v;
+    return XLAL_SUCCESS;
+  }
+
+  if (*data == NULL) {
+    *data = gsl_vector_alloc(dims[0]);
+    if (*data == NULL) {
+      XLALFree(d);
+      XLAL_ERROR(XLAL_ENOMEM, "gsl_vector_alloc(%zu) failed", dims[0]);
+    }
+  } else if ((*data)->size != dims[0]) {
+    rom_data_release(d, dims[0], mapped);
+    XLAL_ERROR(XLAL_EINVAL, "Expected gsl_vector `%s' of size %zu", name, dims[0]);
+  }
+  for (size_t i = 0; i < dims[0]; ++i)
+    gsl_vector_set(*data, i, d[i]);
+  rom_data_release(d, dims[0], mapped);
+  return XLAL_SUCCESS;
+}
+
+/* Read a 2-dimensional dataset; as ROMDataStore_ReadRealVector() */
+int ROMDataStore_ReadRealMatrix(ROMDataStore *store, const char *group, const char *name, gsl_matrix **data)
+{
+  size_t dims[2];
+  double *d;
+  int mapped;
+
+  if (data == NULL)
+    XLAL_ERROR(XLAL_EFAULT);
+
+  d = rom_data_get(store, group, name, 2, dims, &mapped);
+  if (d == NULL)
+    XLAL_ERROR(XLAL_EFUNC);
+
+  if (*data == NULL && mapped) {
+    /* gsl_matrix_free() releases the header with free() */
+    gsl_matrix *m = malloc(sizeof(*m));
+    if (m == NULL) {
+      rom_data_release(d, dims[0] * dims[1], mapped);
+      XLAL_ERROR(XLAL_ENOMEM);
+    }
+    m->size1 = dims[0];
+    m->size2 = dims[1];
+    m->tda = dims[1];
+    m->data = d;
+    m->block = NULL;
+    m->owner = 0;
+    *data = m;
+    return XLAL_SUCCESS;
+  }
+
+  if (*data == NULL) {
+    *data = gsl_matrix_alloc(dims[0], dims[1]);
+    if (*data == NULL) {
+      XLALFree(d);
+      XLAL_ERROR(XLAL_ENOMEM, "gsl_matrix_alloc(%zu, %zu) failed", dims[0], dims[1]);
+    }
+  } else if ((*data)->size1 != dims[0] || (*data)->size2 != dims[1]) {
+    rom_data_release(d, dims[0] * dims[1], mapped);
+    XLAL_ERROR(XLAL_EINVAL, "Expected gsl_matrix `%s' of size %zu x %zu", name, dims[0], dims[1]);
+  }
+  for (size_t i = 0; i < dims[0]; ++i)
+    for (size_t j = 0; j < dims[1]; ++j)
+      gsl_matrix_set(*data, i, j, d[i * dims[1] + j]);
+  rom_data_release(d, dims[0] * dims[1], mapped);
+  return XLAL_SUCCESS;
+}
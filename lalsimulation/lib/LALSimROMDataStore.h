@@ -0,0 +1,63 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#ifndef _LALSIMROMDATASTORE_H
+#define _LALSIMROMDATASTORE_H
+
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+}       /* so that editors will match preceding brace */
+#endif
+
+/*
+ * Memory-mapped store for ROM and surrogate data.
+ *
+ * The first time a dataset of an HDF5 ROM file is requested it is read
+ * with the H5FileIO routines and written out as a contiguous binary cache
+ * file in the directory named by the environment variable
+ * LAL_ROM_CACHE_DIR or, if that is not set, in $XDG_CACHE_HOME/lalsimulation
+ * or ~/.cache/lalsimulation.  Later requests, from this or any other
+ * process, map the cache file instead of reading the HDF5 file, so pages
+ * are only loaded when they are first touched and are shared between all
+ * processes on a node through the page cache.  If the cache cannot be
+ * written (e.g. no writable cache directory) the dataset is read onto the
+ * heap exactly as before.  Setting LAL_ROM_CACHE_DIR to the empty string
+ * disables the cache.
+ *
+ * The gsl objects returned by the store may be released with
+ * gsl_vector_free() and gsl_matrix_free() as usual; mapped data remains
+ * mapped for the lifetime of the process.
+ */
+
+typedef struct tagROMDataStore ROMDataStore;
+
+ROMDataStore *ROMDataStore_Open(const char *path);
+void ROMDataStore_Close(ROMDataStore *store);
+int ROMDataStore_ReadRealVector(ROMDataStore *store, const char *group, const char *name, gsl_vector **data);
+int ROMDataStore_ReadRealMatrix(ROMDataStore *store, const char *group, const char *name, gsl_matrix **data);
+
+#if 0
+{       /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _LALSIMROMDATASTORE_H */
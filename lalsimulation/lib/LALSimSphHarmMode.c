@@ -19,10 +19,16 @@
 
 #include <lal/LALStdlib.h>
 #include <lal/LALSimSphHarmMode.h>
+#include <lal/LALSimInspiralWaveformParams.h>
 #include <lal/SphericalHarmonics.h>
 #include <lal/TimeSeries.h>
+#include <lal/Date.h>
 #include "check_series_macros.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 
 /**
  * @addtogroup LALSimSphHarmMode_h
@@ -344,4 +350,237 @@ int XLALSimNewTimeSeriesFromModesAngleTimeSeries(
 	return 0;
 }
 
+/*
+ * Fused mode sums.  Every mode contributes to the polarizations through a
+ * fixed real-linear map of the real and imaginary parts of its samples, so
+ * the maps of all modes are set up first and then applied in a single pass
+ * over the output, one cache-sized block of samples at a time, with a
+ * vectorisable loop over the samples of each mode.
+ */
+
+/* number of samples per block of the fused mode sums */
+#define SPHHARM_SUM_BLOCK 512
+
+/* one mode of a fused mode sum */
+typedef struct tagSphHarmSumTerm {
+	const REAL8 *h;   /* interleaved real and imaginary parts of the mode */
+	size_t length;    /* number of samples of the mode */
+	REAL8 a, b, c, d; /* map applied to (Re h, Im h), see below */
+} SphHarmSumTerm;
+
+/*
+ * hplus += a Re(h) + b Im(h), hcross += c Re(h) + d Im(h)
+ */
+static void SphHarmSumTD(REAL8 *hplus, REAL8 *hcross, const SphHarmSumTerm *terms, size_t nterms, size_t length)
+{
+	size_t j0, k;
+	for ( j0 = 0; j0 < length; j0 += SPHHARM_SUM_BLOCK ) {
+		const size_t nj = length - j0 < SPHHARM_SUM_BLOCK ? length - j0 : SPHHARM_SUM_BLOCK;
+		REAL8 *restrict hp = hplus + j0;
+		REAL8 *restrict hc = hcross + j0;
+		for ( k = 0; k < nterms; ++k ) {
+			const REAL8 *restrict h = terms[k].h + 2 * j0;
+			const REAL8 a = terms[k].a, b = terms[k].b, c = terms[k].c, d = terms[k].d;
+			size_t njk, j;
+			if ( terms[k].length <= j0 ) /* mode is shorter than the output */
+				continue;
+			njk = terms[k].length - j0 < nj ? terms[k].length - j0 : nj;
+#pragma omp simd
+			for ( j = 0; j < njk; ++j ) {
+				const REAL8 re = h[2 * j], im = h[2 * j + 1];
+				hp[j] += a * re + b * im;
+				hc[j] += c * re + d * im;
+			}
+		}
+	}
+	return;
+}
+
+/*
+ * hptilde += (a + i b) h, hctilde += (c + i d) h
+ */
+static void SphHarmSumFD(REAL8 *hptilde, REAL8 *hctilde, const SphHarmSumTerm *terms, size_t nterms, size_t length)
+{
+	size_t j0, k;
+	for ( j0 = 0; j0 < length; j0 += SPHHARM_SUM_BLOCK ) {
+		const size_t nj = length - j0 < SPHHARM_SUM_BLOCK ? length - j0 : SPHHARM_SUM_BLOCK;
+		REAL8 *restrict hp = hptilde + 2 * j0;
+		REAL8 *restrict hc = hctilde + 2 * j0;
+		for ( k = 0; k < nterms; ++k ) {
+			const REAL8 *restrict h = terms[k].h + 2 * j0;
+			const REAL8 a = terms[k].a, b = terms[k].b, c = terms[k].c, d = terms[k].d;
+			size_t njk, j;
+			if ( terms[k].length <= j0 ) /* mode is shorter than the output */
+				continue;
+			njk = terms[k].length - j0 < nj ? terms[k].length - j0 : nj;
+#pragma omp simd
+			for ( j = 0; j < njk; ++j ) {
+				const REAL8 re = h[2 * j], im = h[2 * j + 1];
+				hp[2 * j] += a * re - b * im;
+				hp[2 * j + 1] += a * im + b * re;
+				hc[2 * j] += c * re - d * im;
+				hc[2 * j + 1] += c * im + d * re;
+			}
+		}
+	}
+	return;
+}
+
+/**
+ * Adds all modes h(l,m) in the list hlms, multiplied by the spin-2 weighted
+ * spherical harmonics, to hplus - i hcross.  This gives the same result
+ * as calling XLALSimAddMode() for every mode, but the spherical harmonics
+ * are evaluated once and all modes are summed in a single vectorised pass
+ * over the output, which is considerably faster for models with many
+ * modes.
+ *
+ * If ModeArray is not NULL only the modes active in it are added.  If sym
+ * is non-zero, the -m modes are added as well assuming that
+ * \f$h(l,-m) = (-1)^l h(l,m)*\f$, as for XLALSimAddMode().
+ *
+ * Every mode to be added is checked as by XLALSimAddMode(), before any of
+ * them is added.  A mode may be shorter than the output series, but it is
+ * an error for it to be longer.
+ */
+int XLALSimAddSphHarmTimeSeries(
+		REAL8TimeSeries *hplus,      /**< +-polarization waveform */
+		REAL8TimeSeries *hcross,     /**< x-polarization waveform */
+		SphHarmTimeSeries *hlms,     /**< linked list of modes h(l,m) */
+		REAL8 theta,                 /**< polar angle (rad) */
+		REAL8 phi,                   /**< azimuthal angle (rad) */
+		LALValue *ModeArray,         /**< modes to add, or NULL for all */
+		int sym                      /**< flag to add -m modes too */
+		)
+{
+	SphHarmTimeSeries *this;
+	SphHarmSumTerm *terms;
+	size_t nterms = 0;
+
+	LAL_CHECK_VALID_SERIES(hplus, XLAL_FAILURE);
+	LAL_CHECK_VALID_SERIES(hcross, XLAL_FAILURE);
+
+	for ( this = hlms; this; this = this->next ) {
+		if ( ModeArray && XLALSimInspiralModeArrayIsModeActive(ModeArray, this->l, this->m) != 1 )
+			continue;
+		LAL_CHECK_VALID_SERIES(this->mode, XLAL_FAILURE);
+		LAL_CHECK_CONSISTENT_TIME_SERIES(hplus, this->mode, XLAL_FAILURE);
+		LAL_CHECK_CONSISTENT_TIME_SERIES(hcross, this->mode, XLAL_FAILURE);
+		if ( this->mode->data->length > hplus->data->length || this->mode->data->length > hcross->data->length )
+			XLAL_ERROR(XLAL_EBADLEN, "Mode (%u,%d) is longer than the output series", this->l, this->m);
+		++nterms;
+	}
+	if ( nterms == 0 )
+		return XLAL_SUCCESS;
+	terms = XLALMalloc(nterms * sizeof(*terms));
+	if ( ! terms )
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	nterms = 0;
+	for ( this = hlms; this; this = this->next ) {
+		COMPLEX16 Y;
+		SphHarmSumTerm *term = terms + nterms;
+		if ( ModeArray && XLALSimInspiralModeArrayIsModeActive(ModeArray, this->l, this->m) != 1 )
+			continue;
+		/* Re(Y h) and -Im(Y h) */
+		Y = XLALSpinWeightedSphericalHarmonic(theta, phi, -2, this->l, this->m);
+		term->h = (const REAL8 *) this->mode->data->data;
+		term->length = this->mode->data->length;
+		term->a = creal(Y);
+		term->b = -cimag(Y);
+		term->c = -cimag(Y);
+		term->d = -creal(Y);
+		if ( sym ) { /* equatorial symmetry: Re(Y h*) and -Im(Y h*) of the -m mode */
+			Y = XLALSpinWeightedSphericalHarmonic(theta, phi, -2, this->l, -this->m);
+			if ( this->l % 2 ) /* l is odd */
+				Y = -Y;
+			term->a += creal(Y);
+			term->b += cimag(Y);
+			term->c -= cimag(Y);
+			term->d += creal(Y);
+		}
+		++nterms;
+	}
+
+	SphHarmSumTD(hplus->data->data, hcross->data->data, terms, nterms, hplus->data->length);
+
+	XLALFree(terms);
+	return XLAL_SUCCESS;
+}
+
+/**
+ * Fourier domain version of XLALSimAddSphHarmTimeSeries(): adds all modes
+ * in the list hlms to hptilde and hctilde, with the same result as calling
+ * XLALSimAddModeFD() for every mode but in a single vectorised pass over
+ * the output.
+ *
+ * If ModeArray is not NULL only the modes active in it are added.  The
+ * meaning of sym is the same as for XLALSimAddModeFD().
+ *
+ * As for XLALSimAddModeFD(), the epoch, f0 and units of the modes are not
+ * checked against the output series.  A mode that is NULL or empty, or
+ * longer than the output series, is an error.
+ */
+int XLALSimAddSphHarmFrequencySeries(
+		COMPLEX16FrequencySeries *hptilde, /**< +-polarization waveform */
+		COMPLEX16FrequencySeries *hctilde, /**< x-polarization waveform */
+		SphHarmFrequencySeries *hlms,      /**< linked list of modes h(l,m) */
+		REAL8 theta,                       /**< polar angle (rad) */
+		REAL8 phi,                         /**< azimuthal angle (rad) */
+		LALValue *ModeArray,               /**< modes to add, or NULL for all */
+		INT4 sym                           /**< flag to add -m modes too */
+		)
+{
+	SphHarmFrequencySeries *this;
+	SphHarmSumTerm *terms;
+	size_t nterms = 0;
+
+	LAL_CHECK_VALID_SERIES(hptilde, XLAL_FAILURE);
+	LAL_CHECK_VALID_SERIES(hctilde, XLAL_FAILURE);
+
+	for ( this = hlms; this; this = this->next ) {
+		if ( ModeArray && XLALSimInspiralModeArrayIsModeActive(ModeArray, this->l, this->m) != 1 )
+			continue;
+		LAL_CHECK_VALID_SERIES(this->mode, XLAL_FAILURE);
+		if ( this->mode->data->length > hptilde->data->length || this->mode->data->length > hctilde->data->length )
+			XLAL_ERROR(XLAL_EBADLEN, "Mode (%u,%d) is longer than the output series", this->l, this->m);
+		++nterms;
+	}
+	if ( nterms == 0 )
+		return XLAL_SUCCESS;
+	terms = XLALMalloc(nterms * sizeof(*terms));
+	if ( ! terms )
+		XLAL_ERROR(XLAL_ENOMEM);
+
+	nterms = 0;
+	for ( this = hlms; this; this = this->next ) {
+		COMPLEX16 Y, factorp, factorc;
+		SphHarmSumTerm *term = terms + nterms;
+		if ( ModeArray && XLALSimInspiralModeArrayIsModeActive(ModeArray, this->l, this->m) != 1 )
+			continue;
+		Y = XLALSpinWeightedSphericalHarmonic(theta, phi, -2, this->l, this->m);
+		if ( sym ) { /* equatorial symmetry: add in -m mode */
+			COMPLEX16 Ymstar = conj(XLALSpinWeightedSphericalHarmonic(theta, phi, -2, this->l, -this->m));
+			if ( this->l % 2 ) /* l is odd */
+				Ymstar = -Ymstar;
+			factorp = 0.5 * (Y + Ymstar);
+			factorc = I * 0.5 * (Y - Ymstar);
+		} else {
+			factorp = 0.5 * Y;
+			factorc = I * factorp;
+		}
+		term->h = (const REAL8 *) this->mode->data->data;
+		term->length = this->mode->data->length;
+		term->a = creal(factorp);
+		term->b = cimag(factorp);
+		term->c = creal(factorc);
+		term->d = cimag(factorc);
+		++nterms;
+	}
+
+	SphHarmSumFD((REAL8 *) hptilde->data->data, (REAL8 *) hctilde->data->data, terms, nterms, hptilde->data->length);
+
+	XLALFree(terms);
+	return XLAL_SUCCESS;
+}
+
 /** @} */
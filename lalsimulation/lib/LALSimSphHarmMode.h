@@ -21,6 +21,7 @@
 #define _LALSIMSPHHARMMODE_H
 
 #include <lal/LALDatatypes.h>
+#include <lal/LALValue.h>
 #include <lal/LALSimSphHarmSeries.h>
 
 #if defined(__cplusplus)
@@ -52,6 +53,8 @@ int XLALSimAddModeFromModes(REAL8TimeSeries *hplus, REAL8TimeSeries *hcross, Sph
 int XLALSimAddModeFromModesAngleTimeSeries(REAL8TimeSeries *hplus, REAL8TimeSeries *hcross, SphHarmTimeSeries *hmode, REAL8TimeSeries *theta, REAL8TimeSeries *phi);
 int XLALSimNewTimeSeriesFromModes(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, SphHarmTimeSeries *hmode, REAL8 theta, REAL8 phi);
 int XLALSimNewTimeSeriesFromModesAngleTimeSeries(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, SphHarmTimeSeries *hmode, REAL8TimeSeries *theta, REAL8TimeSeries *phi);
+int XLALSimAddSphHarmTimeSeries(REAL8TimeSeries *hplus, REAL8TimeSeries *hcross, SphHarmTimeSeries *hlms, REAL8 theta, REAL8 phi, LALValue *ModeArray, int sym);
+int XLALSimAddSphHarmFrequencySeries(COMPLEX16FrequencySeries *hptilde, COMPLEX16FrequencySeries *hctilde, SphHarmFrequencySeries *hlms, REAL8 theta, REAL8 phi, LALValue *ModeArray, INT4 sym);
 
 #if 0
 { /* so that editors will match succeeding brace */
@@ -27,6 +27,7 @@
 
 
 #include <math.h>
+#include <string.h>
 #include <gsl/gsl_sf_expint.h>
 #include <lal/LALSimulation.h>
 #include <lal/LALDetectors.h>
@@ -35,6 +36,8 @@
 #include <lal/Units.h>
 #include <lal/TimeDelay.h>
 #include <lal/SkyCoordinates.h>
+#include <lal/AVFactories.h>
+#include <lal/Sequence.h>
 #include <lal/TimeSeries.h>
 #include <lal/TimeSeriesInterp.h>
 #include <lal/FrequencySeries.h>
@@ -42,6 +45,10 @@
 #include <lal/Window.h>
 #include "check_series_macros.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 /*
  * ============================================================================
  *
@@ -198,6 +205,91 @@ static void highfreq_kernel(double *cached_kernel, int kernel_length, double res
 };
 
 
+/*
+ * Allocate the output time series for
+ * XLALSimDetectorStrainREAL8TimeSeries() and
+ * XLALSimDetectorStrainREAL8TimeSeriesFast(), and set its epoch.  The
+ * input series are assumed to have been checked by the caller.
+ */
+static REAL8TimeSeries *detector_strain_create_series(
+	const REAL8TimeSeries *hplus,
+	REAL8 right_ascension,
+	REAL8 declination,
+	const LALDetector *detector,
+	int kernel_length,
+	double arm_length_samples
+)
+{
+	double geometric_delay;
+	LIGOTimeGPS t;	/* a time */
+	double dt;	/* an offset */
+	char *name;
+	REAL8TimeSeries *h;
+
+	/* generate name */
+
+	name = XLALMalloc(strlen(detector->frDetector.prefix) + 11);
+	if(!name)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	sprintf(name, "%s injection", detector->frDetector.prefix);
+
+	/* allocate output time series.  the time series' duration is
+	 * adjusted to account for Doppler-induced dilation of the
+	 * waveform, and is padded to accomodate ringing of the
+	 * interpolation kernel.  the sign of dt follows from the
+	 * observation that time stamps in the output time series are
+	 * mapped to time stamps in the input time series by adding the
+	 * output of XLALTimeDelayFromEarthCenter(), so if that number is
+	 * larger at the start of the waveform than at the end then the
+	 * output time series must be longer than the input.  (the Earth's
+	 * rotation is not super-luminal so we don't have to account for
+	 * time reversals in the mapping) */
+
+	/* time (at geocentre) of end of waveform */
+	t = hplus->epoch;
+	if(!XLALGPSAdd(&t, hplus->data->length * hplus->deltaT)) {
+		XLALFree(name);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+	/* change in geometric delay from start to end */
+	dt = XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &hplus->epoch) - XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
+	/* allocate, lengthen sequence to incorporate time delay caused by
+	 * beyond-long-wavelength effect */
+	h = XLALCreateREAL8TimeSeries(name, &hplus->epoch, hplus->f0, hplus->deltaT, &hplus->sampleUnits, (int) hplus->data->length + kernel_length - 1 + ceil(dt / hplus->deltaT) + lround(4.0 * arm_length_samples));
+	XLALFree(name);
+	if(!h)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+
+	/* shift the epoch so that the start of the input time series
+	 * passes through this detector at the time of the sample at offset
+	 * (kernel_length-1)/2   we assume the kernel is sufficiently short
+	 * that it doesn't matter whether we compute the geometric delay at
+	 * the start or middle of the kernel. */
+
+	geometric_delay = XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &h->epoch);
+	if(XLAL_IS_REAL8_FAIL_NAN(geometric_delay) || !XLALGPSAdd(&h->epoch, geometric_delay - (kernel_length - 1) / 2 * h->deltaT)) {
+		XLALDestroyREAL8TimeSeries(h);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	/* round epoch to an integer sample boundary so that
+	 * XLALSimAddInjectionREAL8TimeSeries() can use no-op code path.
+	 * note:  we assume a sample boundary occurs on the integer second.
+	 * if this isn't the case (e.g, time-shifted injections or some GEO
+	 * data) that's OK, but we might end up paying for a second
+	 * sub-sample time shift when adding the the time series into the
+	 * target data stream in XLALSimAddInjectionREAL8TimeSeries().
+	 * don't bother checking for errors, this is changing the timestamp
+	 * by less than 1 sample, if we're that close to overflowing it'll
+	 * be caught by the caller. */
+
+	dt = XLALGPSModf(&dt, &h->epoch);
+	XLALGPSAdd(&h->epoch, round(dt / h->deltaT) * h->deltaT - dt);
+
+	return h;
+}
+
+
 /**
  * @brief Transforms the waveform polarizations into a detector strain
  * @details
@@ -279,8 +371,6 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 	double fycross = XLAL_REAL8_FAIL_NAN;
 	double geometric_delay = XLAL_REAL8_FAIL_NAN;
 	LIGOTimeGPS t;	/* a time */
-	double dt;	/* an offset */
-	char *name;
 	REAL8TimeSeries *h = NULL;
 	unsigned i;
 
@@ -297,66 +387,12 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 		XLAL_ERROR_NULL(XLAL_EBADLEN);
 	}
 
-	/* generate name */
-
-	name = XLALMalloc(strlen(detector->frDetector.prefix) + 11);
-	if(!name)
-		goto error;
-	sprintf(name, "%s injection", detector->frDetector.prefix);
-
-	/* allocate output time series.  the time series' duration is
-	 * adjusted to account for Doppler-induced dilation of the
-	 * waveform, and is padded to accomodate ringing of the
-	 * interpolation kernel.  the sign of dt follows from the
-	 * observation that time stamps in the output time series are
-	 * mapped to time stamps in the input time series by adding the
-	 * output of XLALTimeDelayFromEarthCenter(), so if that number is
-	 * larger at the start of the waveform than at the end then the
-	 * output time series must be longer than the input.  (the Earth's
-	 * rotation is not super-luminal so we don't have to account for
-	 * time reversals in the mapping) */
+	/* allocate output time series */
 
-	/* time (at geocentre) of end of waveform */
-	t = hplus->epoch;
-	if(!XLALGPSAdd(&t, hplus->data->length * hplus->deltaT)) {
-		XLALFree(name);
-		goto error;
-	}
-	/* change in geometric delay from start to end */
-	dt = XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &hplus->epoch) - XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
-	/* allocate, lengthen sequence to incorporate time delay caused by
-	 * beyond-long-wavelength effect */
-	h = XLALCreateREAL8TimeSeries(name, &hplus->epoch, hplus->f0, hplus->deltaT, &hplus->sampleUnits, (int) hplus->data->length + kernel_length - 1 + ceil(dt / hplus->deltaT) + lround(4.0 * arm_length_samples));
-	XLALFree(name);
+	h = detector_strain_create_series(hplus, right_ascension, declination, detector, kernel_length, arm_length_samples);
 	if(!h)
 		goto error;
 
-	/* shift the epoch so that the start of the input time series
-	 * passes through this detector at the time of the sample at offset
-	 * (kernel_length-1)/2   we assume the kernel is sufficiently short
-	 * that it doesn't matter whether we compute the geometric delay at
-	 * the start or middle of the kernel. */
-
-	geometric_delay = XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &h->epoch);
-	if(XLAL_IS_REAL8_FAIL_NAN(geometric_delay))
-		goto error;
-	if(!XLALGPSAdd(&h->epoch, geometric_delay - (kernel_length - 1) / 2 * h->deltaT))
-		goto error;
-
-	/* round epoch to an integer sample boundary so that
-	 * XLALSimAddInjectionREAL8TimeSeries() can use no-op code path.
-	 * note:  we assume a sample boundary occurs on the integer second.
-	 * if this isn't the case (e.g, time-shifted injections or some GEO
-	 * data) that's OK, but we might end up paying for a second
-	 * sub-sample time shift when adding the the time series into the
-	 * target data stream in XLALSimAddInjectionREAL8TimeSeries().
-	 * don't bother checking for errors, this is changing the timestamp
-	 * by less than 1 sample, if we're that close to overflowing it'll
-	 * be caught in the loop below. */
-
-	dt = XLALGPSModf(&dt, &h->epoch);
-	XLALGPSAdd(&h->epoch, round(dt / h->deltaT) * h->deltaT - dt);
-
 	/* Compute signals at the times of samples in hplus in advance.
 	 * It reduces the computational cost for interpolation */
 
@@ -446,6 +482,633 @@ error:
 }
 
 
+/*
+ * Support code for XLALSimDetectorStrainREAL8TimeSeriesFast()
+ */
+
+
+/* number of sub-sample phases at which the interpolating kernel is
+ * tabulated.  kernels at intermediate phases are obtained by linear
+ * interpolation between adjacent phases */
+#define FAST_PROJECTION_PHASES 512
+
+
+/* geometric delay and antenna response parts sampled on a regular grid
+ * of times.  times are in seconds relative to the epoch of the input
+ * series */
+struct detector_response_grid {
+	double t0;
+	double delta;
+	int length;
+	double armlen;
+	double *delay;
+	double *xcos;
+	double *ycos;
+	double *fxplus;
+	double *fxcross;
+	double *fyplus;
+	double *fycross;
+};
+
+
+static void detector_response_grid_free(struct detector_response_grid *grid)
+{
+	/* all arrays share one allocation */
+	XLALFree(grid->delay);
+	grid->delay = NULL;
+}
+
+
+/*
+ * Evaluate the geometric delay and antenna response parts on a grid of
+ * times covering [tmin, tmax] with spacing delta.  One node of padding is
+ * added before tmin and two after tmax so that the four-point
+ * interpolator below never extrapolates.  The caller must free the grid
+ * with detector_response_grid_free() on both success and failure.
+ */
+static int detector_response_grid_init(struct detector_response_grid *grid, const LIGOTimeGPS *epoch, double tmin, double tmax, double delta, REAL8 right_ascension, REAL8 declination, REAL8 psi, const LALDetector *detector)
+{
+	int k;
+
+	grid->t0 = tmin - delta;
+	grid->delta = delta;
+	grid->length = ceil((tmax - tmin) / delta) + 4;
+	grid->delay = XLALMalloc(7 * grid->length * sizeof(*grid->delay));
+	if(!grid->delay)
+		XLAL_ERROR(XLAL_EFUNC);
+	grid->xcos = grid->delay + grid->length;
+	grid->ycos = grid->xcos + grid->length;
+	grid->fxplus = grid->ycos + grid->length;
+	grid->fxcross = grid->fxplus + grid->length;
+	grid->fyplus = grid->fxcross + grid->length;
+	grid->fycross = grid->fyplus + grid->length;
+
+	for(k = 0; k < grid->length; k++) {
+		LIGOTimeGPS t = *epoch;
+		if(!XLALGPSAdd(&t, grid->t0 + k * delta))
+			XLAL_ERROR(XLAL_EFUNC);
+		grid->armlen = XLAL_REAL8_FAIL_NAN;
+		XLALComputeDetAMResponseParts(&grid->armlen, &grid->xcos[k], &grid->ycos[k], &grid->fxplus[k], &grid->fyplus[k], &grid->fxcross[k], &grid->fycross[k], detector, right_ascension, declination, psi, XLALGreenwichMeanSiderealTime(&t));
+		grid->delay[k] = -XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
+		if(XLAL_IS_REAL8_FAIL_NAN(grid->armlen) || XLAL_IS_REAL8_FAIL_NAN(grid->delay[k]) || isnan(grid->xcos[k]) || isnan(grid->ycos[k]) || isnan(grid->fxplus[k]) || isnan(grid->fxcross[k]) || isnan(grid->fyplus[k]) || isnan(grid->fycross[k]))
+			XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	return 0;
+}
+
+
+/*
+ * Interpolate one of the grid quantities to time t using a four-point
+ * (Catmull-Rom) cubic spline.  The quantities vary on the time scale of
+ * the Earth's rotation so with 250 ms node spacing the interpolation
+ * error is far below double precision round-off in the result.
+ */
+static double detector_response_grid_eval(const struct detector_response_grid *grid, const double *y, double t)
+{
+	double u = (t - grid->t0) / grid->delta;
+	int k = floor(u);
+
+	if(k < 1)
+		k = 1;
+	else if(k > grid->length - 3)
+		k = grid->length - 3;
+	u -= k;
+
+	return y[k] + 0.5 * u * (y[k + 1] - y[k - 1] + u * (2. * y[k - 1] - 5. * y[k] + 4. * y[k + 1] - y[k + 2] + u * (3. * (y[k] - y[k + 1]) + y[k + 2] - y[k - 1])));
+}
+
+
+/* highfreq_kernel() tabulated at FAST_PROJECTION_PHASES + 1 residuals
+ * equally spaced in [-0.5, +0.5].  rows are computed on first use, and
+ * are discarded when the kernel parameters are changed */
+struct polyphase_kernel {
+	int kernel_length;
+	struct highfreq_kernel_data data;
+	double *rows;
+	unsigned char *valid;
+};
+
+
+static int polyphase_kernel_init(struct polyphase_kernel *kern, int kernel_length)
+{
+	kern->kernel_length = kernel_length;
+	kern->data.welch_factor = 1.0 / ((kernel_length - 1.) / 2. + 1.);
+	kern->data.T = kern->data.armcos = XLAL_REAL8_FAIL_NAN;
+	kern->rows = XLALMalloc((FAST_PROJECTION_PHASES + 1) * kernel_length * sizeof(*kern->rows));
+	kern->valid = XLALCalloc(FAST_PROJECTION_PHASES + 1, sizeof(*kern->valid));
+	if(!kern->rows || !kern->valid)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+static void polyphase_kernel_free(struct polyphase_kernel *kern)
+{
+	XLALFree(kern->rows);
+	XLALFree(kern->valid);
+	kern->rows = NULL;
+	kern->valid = NULL;
+}
+
+
+static void polyphase_kernel_set(struct polyphase_kernel *kern, double T, double armcos)
+{
+	if(T != kern->data.T || armcos != kern->data.armcos) {
+		kern->data.T = T;
+		kern->data.armcos = armcos;
+		memset(kern->valid, 0, FAST_PROJECTION_PHASES + 1);
+	}
+}
+
+
+static const double *polyphase_kernel_row(struct polyphase_kernel *kern, int p)
+{
+	double *row = kern->rows + (size_t) p * kern->kernel_length;
+
+	if(!kern->valid[p]) {
+		highfreq_kernel(row, kern->kernel_length, -0.5 + (double) p / FAST_PROJECTION_PHASES, &kern->data);
+		kern->valid[p] = 1;
+	}
+
+	return row;
+}
+
+
+/*
+ * Evaluate the sequence at the real-valued sample index x.  Same
+ * conventions as XLALREAL8SequenceInterpEval():  the data beyond the ends
+ * of the sequence are taken to be 0.  The kernel for the residual is
+ * linearly interpolated between the two bracketing tabulated phases.
+ */
+static double polyphase_kernel_eval(struct polyphase_kernel *kern, const REAL8Sequence *s, double x)
+{
+	const int length = s->length;
+	int start = lround(x);
+	double u = (start - x + 0.5) * FAST_PROJECTION_PHASES;
+	int p = floor(u);
+	const double *a;
+	const double *b;
+	const double *data;
+	int k, kmin, kmax;
+	double val = 0.;
+
+	if(p < 0)
+		p = 0;
+	else if(p > FAST_PROJECTION_PHASES - 1)
+		p = FAST_PROJECTION_PHASES - 1;
+	u -= p;
+	a = polyphase_kernel_row(kern, p);
+	b = polyphase_kernel_row(kern, p + 1);
+
+	/* clip the kernel to the sequence */
+	start -= (kern->kernel_length - 1) / 2;
+	kmin = start < 0 ? -start : 0;
+	kmax = start + kern->kernel_length > length ? length - start : kern->kernel_length;
+	if(kmin >= kmax)
+		return 0.;
+	data = s->data + start + kmin;
+	a += kmin;
+	b += kmin;
+	kmax -= kmin;
+
+#pragma omp simd reduction(+:val)
+	for(k = 0; k < kmax; k++)
+		val += data[k] * (a[k] + u * (b[k] - a[k]));
+
+	return val;
+}
+
+
+/**
+ * @brief Transforms the waveform polarizations into a detector strain
+ * using a faster approximation to XLALSimDetectorStrainREAL8TimeSeries()
+ * @details
+ * Computes the same quantity as XLALSimDetectorStrainREAL8TimeSeries(),
+ * with the same arguments, output length, epoch, and interpolating
+ * kernel, but organized for speed when projecting long waveforms:
+ *
+ * - The geometric delay and antenna response are evaluated only on a
+ * grid with 250 ms spacing, and are interpolated to each sample with a
+ * cubic spline.  There is no per-sample GPS time arithmetic.
+ * - The beyond-long-wavelength kernel is tabulated at 512 sub-sample
+ * phases (a polyphase filter bank), and each output sample is an inner
+ * product of the input with the kernel linearly interpolated between the
+ * two nearest phases.  Kernel tables are rebuilt every 250 ms using the
+ * arm direction cosines at the middle of the interval.
+ * - The output is computed in 250 ms blocks in parallel when OpenMP is
+ * enabled.
+ *
+ * @param[in] hplus Pointer to a REAL8TimeSeries containing the plus polarization waveform
+ * @param[in] hcross Pointer to a REAL8TimeSeries containing the cross polarization waveform
+ * @param[in] right_ascension The right ascension of the source in radians
+ * @param[in] declination The declination of the source in radians
+ * @param[in] psi The polarization angle giving the orientation of the wave co-ordinate system in radians
+ * @param[in] detector Pointer to a LALDetector structure for the detector into which the injection is destined to be injected
+ *
+ * @returns
+ * The strain time series as seen in the detector, with the same length
+ * and epoch as the series returned by
+ * XLALSimDetectorStrainREAL8TimeSeries().
+ *
+ * @retval NULL Failure
+ *
+ * @note
+ * Accuracy.  Linear interpolation between kernel phases spaced 1/512
+ * sample apart introduces a relative error of at most about
+ * \f$\pi^2/(8 \cdot 512^2) \approx 5 \times 10^{-6}\f$ for signal content
+ * near the Nyquist frequency, falling as the square of frequency below
+ * that.  The cubic spline interpolation of the delay and antenna response
+ * is exact to round-off.  XLALSimDetectorStrainREAL8TimeSeries() holds
+ * the geometric delay and antenna response fixed for 250 ms at a time
+ * (about +/- 300 ns of delay error) and only recomputes its kernel when
+ * the residual moves by 1/(4 kernel_length) sample, so the two functions
+ * differ by up to about \f$2 \pi f \times 300\,\mathrm{ns}\f$ plus
+ * \f$2 \pi f \Delta t / (4 \times \mathrm{kernel\_length})\f$ relative to
+ * the amplitude of a component at frequency \f$f\f$ (about
+ * \f$10^{-3}\f$ at 100 Hz for 4096 Hz sampling), and this function is
+ * the closer of the two to the exact response.
+ */
+REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeriesFast(
+	const REAL8TimeSeries *hplus,
+	const REAL8TimeSeries *hcross,
+	REAL8 right_ascension,
+	REAL8 declination,
+	REAL8 psi,
+	const LALDetector *detector
+)
+{
+	/* mean arm length in samples */
+	const double arm_length_samples = (detector->frDetector.xArmMidpoint + detector->frDetector.yArmMidpoint) / (LAL_C_SI * hplus->deltaT);
+	/* must match XLALSimDetectorStrainREAL8TimeSeries() */
+	const int kernel_length = 67 + 48 * lround(2.0 * arm_length_samples);
+	/* 0.25 s or 1 sample whichever is larger */
+	const int det_resp_interval = round(0.25 / hplus->deltaT) < 1 ? 1 : round(0.25 / hplus->deltaT);
+	struct detector_response_grid grid = {.delay = NULL};
+	REAL8Sequence *xsignal = NULL;
+	REAL8Sequence *ysignal = NULL;
+	REAL8TimeSeries *h = NULL;
+	double t_out;	/* output epoch relative to input epoch */
+	double T;	/* arm length in samples */
+	int nblocks;
+	int failed = 0;
+	int i;
+
+	/* check input */
+
+	LAL_CHECK_VALID_SERIES(hplus, NULL);
+	LAL_CHECK_VALID_SERIES(hcross, NULL);
+	LAL_CHECK_CONSISTENT_TIME_SERIES(hplus, hcross, NULL);
+	if((int) hplus->data->length < 0 || (int) (hplus->data->length + kernel_length + 2.0 * LAL_REARTH_SI / LAL_C_SI / hplus->deltaT) < 0) {
+		XLALPrintError("%s(): error: input series too long\n", __func__);
+		XLAL_ERROR_NULL(XLAL_EBADLEN);
+	}
+
+	/* allocate output time series */
+
+	h = detector_strain_create_series(hplus, right_ascension, declination, detector, kernel_length, arm_length_samples);
+	if(!h)
+		goto error;
+	t_out = XLALGPSDiff(&h->epoch, &hplus->epoch);
+
+	/* sample the geometric delay and antenna response on a grid
+	 * covering both the input and output series */
+
+	if(detector_response_grid_init(&grid, &hplus->epoch, t_out < 0. ? t_out : 0., fmax(hplus->data->length * hplus->deltaT, t_out + h->data->length * h->deltaT), det_resp_interval * hplus->deltaT, right_ascension, declination, psi, detector) < 0)
+		goto error;
+	T = grid.armlen / (LAL_C_SI * hplus->deltaT);
+
+	/* project the polarizations onto the arms at the times of the
+	 * input samples.  as in XLALSimDetectorStrainREAL8TimeSeries(), the
+	 * geometric delay from the geocentre is neglected here */
+
+	xsignal = XLALCreateREAL8Sequence(hplus->data->length);
+	ysignal = XLALCreateREAL8Sequence(hplus->data->length);
+	if(!xsignal || !ysignal)
+		goto error;
+#pragma omp parallel for
+	for(i = 0; i < (int) hplus->data->length; i++) {
+		double t = i * hplus->deltaT;
+		xsignal->data[i] = detector_response_grid_eval(&grid, grid.fxplus, t) * hplus->data->data[i] + detector_response_grid_eval(&grid, grid.fxcross, t) * hcross->data->data[i];
+		ysignal->data[i] = detector_response_grid_eval(&grid, grid.fyplus, t) * hplus->data->data[i] + detector_response_grid_eval(&grid, grid.fycross, t) * hcross->data->data[i];
+	}
+
+	/* compute the output in blocks of det_resp_interval samples.  each
+	 * thread owns a pair of kernel tables */
+
+	nblocks = (h->data->length + det_resp_interval - 1) / det_resp_interval;
+#pragma omp parallel
+	{
+		struct polyphase_kernel xkern = {.rows = NULL, .valid = NULL};
+		struct polyphase_kernel ykern = {.rows = NULL, .valid = NULL};
+		int ok = polyphase_kernel_init(&xkern, kernel_length) == 0 && polyphase_kernel_init(&ykern, kernel_length) == 0;
+		int b;
+
+		if(!ok) {
+#pragma omp atomic write
+			failed = 1;
+		}
+
+#pragma omp for schedule(static)
+		for(b = 0; b < nblocks; b++) {
+			int j = b * det_resp_interval;
+			int stop = j + det_resp_interval < (int) h->data->length ? j + det_resp_interval : (int) h->data->length;
+			double tmid = t_out + 0.5 * (j + stop - 1) * h->deltaT;
+
+			if(!ok)
+				continue;
+
+			polyphase_kernel_set(&xkern, T, detector_response_grid_eval(&grid, grid.xcos, tmid));
+			polyphase_kernel_set(&ykern, T, detector_response_grid_eval(&grid, grid.ycos, tmid));
+
+			for(; j < stop; j++) {
+				/* time of sample in detector */
+				double t = t_out + j * h->deltaT;
+				/* sample index of that time at the geocentre */
+				double x = (t + detector_response_grid_eval(&grid, grid.delay, t)) / hplus->deltaT;
+
+				h->data->data[j] = polyphase_kernel_eval(&xkern, xsignal, x) + polyphase_kernel_eval(&ykern, ysignal, x);
+			}
+		}
+
+		polyphase_kernel_free(&xkern);
+		polyphase_kernel_free(&ykern);
+	}
+	if(failed)
+		goto error;
+
+	/* done */
+	detector_response_grid_free(&grid);
+	XLALDestroyREAL8Sequence(xsignal);
+	XLALDestroyREAL8Sequence(ysignal);
+	return h;
+
+error:
+	detector_response_grid_free(&grid);
+	XLALDestroyREAL8Sequence(xsignal);
+	XLALDestroyREAL8Sequence(ysignal);
+	XLALDestroyREAL8TimeSeries(h);
+	XLAL_ERROR_NULL(XLAL_EFUNC);
+}
+
+
+/*
+ * FFT plans reused across injections by
+ * XLALSimAddInjectionsREAL8TimeSeries().  Injections are padded to a
+ * power of two in length, so a handful of entries covers most workloads.
+ */
+
+
+#define INJECTION_PLAN_CACHE_SIZE 8
+/* number of injections re-interpolated together before being added */
+#define INJECTION_BATCH_SIZE 64
+
+
+struct injection_plan_cache {
+	unsigned n;
+	struct {
+		UINT4 length;
+		int forward;
+		REAL8FFTPlan *plan;
+	} entry[INJECTION_PLAN_CACHE_SIZE];
+};
+
+
+static void injection_plan_cache_free(struct injection_plan_cache *cache)
+{
+	while(cache->n)
+		XLALDestroyREAL8FFTPlan(cache->entry[--cache->n].plan);
+}
+
+
+/*
+ * Retrieve a plan from the cache, creating it if needed.  When the cache
+ * is full the oldest entry is replaced.  With a NULL cache a new plan is
+ * created.  Either way, pass the plan to injection_plan_cache_release()
+ * when done with it.
+ */
+static REAL8FFTPlan *injection_plan_cache_get(struct injection_plan_cache *cache, UINT4 length, int forward)
+{
+	REAL8FFTPlan *plan;
+	unsigned i;
+
+	if(cache)
+		for(i = 0; i < cache->n; i++)
+			if(cache->entry[i].length == length && cache->entry[i].forward == forward)
+				return cache->entry[i].plan;
+
+	plan = forward ? XLALCreateForwardREAL8FFTPlan(length, 0) : XLALCreateReverseREAL8FFTPlan(length, 0);
+	if(!plan)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+
+	if(cache) {
+		if(cache->n == INJECTION_PLAN_CACHE_SIZE) {
+			XLALDestroyREAL8FFTPlan(cache->entry[0].plan);
+			memmove(&cache->entry[0], &cache->entry[1], (cache->n - 1) * sizeof(*cache->entry));
+			cache->n--;
+		}
+		cache->entry[cache->n].length = length;
+		cache->entry[cache->n].forward = forward;
+		cache->entry[cache->n].plan = plan;
+		cache->n++;
+	}
+
+	return plan;
+}
+
+
+static void injection_plan_cache_release(struct injection_plan_cache *cache, REAL8FFTPlan *plan)
+{
+	if(!cache)
+		XLALDestroyREAL8FFTPlan(plan);
+}
+
+
+/*
+ * The frequency-domain part of XLALSimAddInjectionREAL8TimeSeries():  pad
+ * the source time series, re-interpolate it by start_sample_frac samples,
+ * optionally divide it by the response function, and set its epoch to lie
+ * on a sample boundary of the target time series.  The source time series
+ * is modified in place.  FFT plans are taken from cache if it is not
+ * NULL.
+ */
+static int reinterpolate_injection(
+	REAL8TimeSeries *h,
+	const REAL8TimeSeries *target,
+	double start_sample_int,
+	double start_sample_frac,
+	const COMPLEX16FrequencySeries *response,
+	struct injection_plan_cache *cache
+)
+{
+	/* the source time series is padded with at least this many 0's at
+	 * the start and end before re-interpolation in an attempt to
+	 * suppress aperiodicity artifacts, and 1/2 this many samples is
+	 * clipped from the start and end afterwards */
+	const unsigned aperiodicity_suppression_buffer = 32768;
+	COMPLEX16FrequencySeries *tilde_h;
+	REAL8FFTPlan *plan;
+	REAL8Window *window;
+	unsigned i;
+
+	/* extend the source time series by adding the
+	 * "aperiodicity padding" to the start and end.  for
+	 * efficiency's sake, make sure the new length is a power
+	 * of two, and don't forget to adjust the start index in
+	 * the target time series. */
+
+	i = round_up_to_power_of_two(h->data->length + 2 * aperiodicity_suppression_buffer);
+	if(i < h->data->length) {
+		/* integer overflow */
+		XLALPrintError("%s(): error: source time series too long\n", __func__);
+		XLAL_ERROR(XLAL_EBADLEN);
+	}
+	start_sample_int -= (i - h->data->length) / 2;
+	if(!XLALResizeREAL8TimeSeries(h, -(int) (i - h->data->length) / 2, i))
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* transform source time series to frequency domain.  the
+	 * FFT function populates the frequency series' metadata
+	 * with the appropriate values. */
+
+	tilde_h = XLALCreateCOMPLEX16FrequencySeries(NULL, &h->epoch, 0, 0, &lalDimensionlessUnit, h->data->length / 2 + 1);
+	plan = injection_plan_cache_get(cache, h->data->length, 1);
+	if(!tilde_h || !plan) {
+		XLALDestroyCOMPLEX16FrequencySeries(tilde_h);
+		injection_plan_cache_release(cache, plan);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	i = XLALREAL8TimeFreqFFT(tilde_h, h, plan);
+	injection_plan_cache_release(cache, plan);
+	if(i) {
+		XLALDestroyCOMPLEX16FrequencySeries(tilde_h);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	/* apply sub-sample time correction and optional response
+	 * function */
+
+	for(i = 0; i < tilde_h->data->length; i++) {
+		const double f = tilde_h->f0 + i * tilde_h->deltaF;
+		COMPLEX16 fac;
+
+		/* phase for sub-sample time correction */
+
+		fac = cexp(-I * LAL_TWOPI * f * start_sample_frac * target->deltaT);
+
+		/* divide the source by the response function.  if
+		 * a frequency is required that lies outside the
+		 * domain of definition of the response function,
+		 * then the response is assumed equal to its value
+		 * at the nearest edge of the domain of definition.
+		 * within the domain of definition, frequencies are
+		 * rounded to the nearest bin.  if the response
+		 * function is zero in some bin, then the source
+		 * data is zeroed in that bin (instead of dividing
+		 * by 0).  */
+
+		/* FIXME:  should we use GSL to construct an
+		 * interpolator for the modulus and phase as
+		 * functions of frequency, and use that to evaluate
+		 * the response?  instead of rounding to nearest
+		 * bin? */
+
+		if(response) {
+			int j = floor((f - response->f0) / response->deltaF + 0.5);
+			if(j < 0)
+				j = 0;
+			else if((unsigned) j > response->data->length - 1)
+				j = response->data->length - 1;
+			if(response->data->data[j] == 0.0)
+				fac = 0.0;
+			else
+				fac /= response->data->data[j];
+		}
+
+		/* apply factor */
+
+		tilde_h->data->data[i] *= fac;
+	}
+
+	/* adjust DC and Nyquist components.  the DC component must
+	 * always be real-valued.  because we have adjusted the
+	 * source time series to have a length that is an even
+	 * integer (we've made it a power of 2) the Nyquist
+	 * component must also be real valued. */
+
+	if(response) {
+		/* a response function has been provided.  zero the
+		 * DC and Nyquist components */
+		if(tilde_h->f0 == 0.0)
+			tilde_h->data->data[0] = 0.0;
+		tilde_h->data->data[tilde_h->data->length - 1] = 0.0;
+	} else {
+		/* no response has been provided.  set the phase of
+		 * the DC component to 0, set the imaginary
+		 * component of the Nyquist to 0 */
+		if(tilde_h->f0 == 0.0)
+			tilde_h->data->data[0] = cabs(tilde_h->data->data[0]);
+		tilde_h->data->data[tilde_h->data->length - 1] = creal(tilde_h->data->data[tilde_h->data->length - 1]);
+	}
+
+	/* return to time domain */
+
+	plan = injection_plan_cache_get(cache, h->data->length, 0);
+	if(!plan) {
+		XLALDestroyCOMPLEX16FrequencySeries(tilde_h);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	i = XLALREAL8FreqTimeFFT(h, tilde_h, plan);
+	injection_plan_cache_release(cache, plan);
+	XLALDestroyCOMPLEX16FrequencySeries(tilde_h);
+	if(i)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* the deltaT can get "corrupted" by floating point
+	 * round-off during its trip through the frequency domain.
+	 * since this function starts by confirming that the sample
+	 * rate of the source matches that of the target time
+	 * series, we can use the target series' sample rate to
+	 * reset the source's sample rate to its original value.
+	 * but we do a check to make sure we're not masking a real
+	 * bug */
+
+	if(fabs(h->deltaT - target->deltaT) / target->deltaT > 1e-12) {
+		XLALPrintError("%s(): error: oops, internal sample rate mismatch\n", __func__);
+		XLAL_ERROR(XLAL_EERR);
+	}
+	h->deltaT = target->deltaT;
+
+	/* set source epoch from target epoch and integer sample
+	 * offset */
+
+	h->epoch = target->epoch;
+	XLALGPSAdd(&h->epoch, start_sample_int * target->deltaT);
+
+	/* clip half of the "aperiodicity padding" from the start
+	 * and end of the source time series in a continuing effort
+	 * to suppress aperiodicity artifacts. */
+
+	if(!XLALResizeREAL8TimeSeries(h, aperiodicity_suppression_buffer / 2, h->data->length - aperiodicity_suppression_buffer))
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* apply a Tukey window whose tapers lie within the
+	 * remaining aperiodicity padding. leaving one sample of
+	 * the aperiodicty padding untouched on each side of the
+	 * original time series because the data might have been
+	 * shifted into it */
+
+	window = XLALCreateTukeyREAL8Window(h->data->length, (double) (aperiodicity_suppression_buffer - 2) / h->data->length);
+	if(!window)
+		XLAL_ERROR(XLAL_EFUNC);
+	for(i = 0; i < h->data->length; i++)
+		h->data->data[i] *= window->data->data[i];
+	XLALDestroyREAL8Window(window);
+
+	return 0;
+}
+
+
 /**
  * @brief Adds a detector strain time series to detector data.
  * @details
@@ -484,11 +1147,6 @@ int XLALSimAddInjectionREAL8TimeSeries(
 {
 	/* 1 ns is about 10^-5 samples at 16384 Hz */
 	const double noop_threshold = 1e-4;	/* samples */
-	/* the source time series is padded with at least this many 0's at
-	 * the start and end before re-interpolation in an attempt to
-	 * suppress aperiodicity artifacts, and 1/2 this many samples is
-	 * clipped from the start and end afterwards */
-	const unsigned aperiodicity_suppression_buffer = 32768;
 	double start_sample_int;
 	double start_sample_frac;
 
@@ -524,174 +1182,150 @@ int XLALSimAddInjectionREAL8TimeSeries(
 
 	/* perform sub-sample interpolation if needed */
 
-	if(fabs(start_sample_frac) > noop_threshold || response) {
-		COMPLEX16FrequencySeries *tilde_h;
-		REAL8FFTPlan *plan;
-		REAL8Window *window;
-		unsigned i;
-
-		/* extend the source time series by adding the
-		 * "aperiodicity padding" to the start and end.  for
-		 * efficiency's sake, make sure the new length is a power
-		 * of two, and don't forget to adjust the start index in
-		 * the target time series. */
-
-		i = round_up_to_power_of_two(h->data->length + 2 * aperiodicity_suppression_buffer);
-		if(i < h->data->length) {
-			/* integer overflow */
-			XLALPrintError("%s(): error: source time series too long\n", __func__);
-			XLAL_ERROR(XLAL_EBADLEN);
-		}
-		start_sample_int -= (i - h->data->length) / 2;
-		if(!XLALResizeREAL8TimeSeries(h, -(int) (i - h->data->length) / 2, i))
-			XLAL_ERROR(XLAL_EFUNC);
-
-		/* transform source time series to frequency domain.  the
-		 * FFT function populates the frequency series' metadata
-		 * with the appropriate values. */
-
-		tilde_h = XLALCreateCOMPLEX16FrequencySeries(NULL, &h->epoch, 0, 0, &lalDimensionlessUnit, h->data->length / 2 + 1);
-		plan = XLALCreateForwardREAL8FFTPlan(h->data->length, 0);
-		if(!tilde_h || !plan) {
-			XLALDestroyCOMPLEX16FrequencySeries(tilde_h);
-			XLALDestroyREAL8FFTPlan(plan);
+	if(fabs(start_sample_frac) > noop_threshold || response)
+		if(reinterpolate_injection(h, target, start_sample_int, start_sample_frac, response, NULL) < 0)
 			XLAL_ERROR(XLAL_EFUNC);
-		}
-		i = XLALREAL8TimeFreqFFT(tilde_h, h, plan);
-		XLALDestroyREAL8FFTPlan(plan);
-		if(i) {
-			XLALDestroyCOMPLEX16FrequencySeries(tilde_h);
-			XLAL_ERROR(XLAL_EFUNC);
-		}
-
-		/* apply sub-sample time correction and optional response
-		 * function */
 
-		for(i = 0; i < tilde_h->data->length; i++) {
-			const double f = tilde_h->f0 + i * tilde_h->deltaF;
-			COMPLEX16 fac;
-
-			/* phase for sub-sample time correction */
-
-			fac = cexp(-I * LAL_TWOPI * f * start_sample_frac * target->deltaT);
-
-			/* divide the source by the response function.  if
-			 * a frequency is required that lies outside the
-			 * domain of definition of the response function,
-			 * then the response is assumed equal to its value
-			 * at the nearest edge of the domain of definition.
-			 * within the domain of definition, frequencies are
-			 * rounded to the nearest bin.  if the response
-			 * function is zero in some bin, then the source
-			 * data is zeroed in that bin (instead of dividing
-			 * by 0).  */
-
-			/* FIXME:  should we use GSL to construct an
-			 * interpolator for the modulus and phase as
-			 * functions of frequency, and use that to evaluate
-			 * the response?  instead of rounding to nearest
-			 * bin? */
+	/* add source time series to target time series */
 
-			if(response) {
-				int j = floor((f - response->f0) / response->deltaF + 0.5);
-				if(j < 0)
-					j = 0;
-				else if((unsigned) j > response->data->length - 1)
-					j = response->data->length - 1;
-				if(response->data->data[j] == 0.0)
-					fac = 0.0;
-				else
-					fac /= response->data->data[j];
-			}
+	if(!XLALAddREAL8TimeSeries(target, h))
+		XLAL_ERROR(XLAL_EFUNC);
 
-			/* apply factor */
+	/* done */
 
-			tilde_h->data->data[i] *= fac;
-		}
+	return 0;
+}
 
-		/* adjust DC and Nyquist components.  the DC component must
-		 * always be real-valued.  because we have adjusted the
-		 * source time series to have a length that is an even
-		 * integer (we've made it a power of 2) the Nyquist
-		 * component must also be real valued. */
 
-		if(response) {
-			/* a response function has been provided.  zero the
-			 * DC and Nyquist components */
-			if(tilde_h->f0 == 0.0)
-				tilde_h->data->data[0] = 0.0;
-			tilde_h->data->data[tilde_h->data->length - 1] = 0.0;
-		} else {
-			/* no response has been provided.  set the phase of
-			 * the DC component to 0, set the imaginary
-			 * component of the Nyquist to 0 */
-			if(tilde_h->f0 == 0.0)
-				tilde_h->data->data[0] = cabs(tilde_h->data->data[0]);
-			tilde_h->data->data[tilde_h->data->length - 1] = creal(tilde_h->data->data[tilde_h->data->length - 1]);
-		}
+/**
+ * @brief Adds many detector strain time series to detector data.
+ * @details
+ * Equivalent to calling XLALSimAddInjectionREAL8TimeSeries() once for
+ * each injection, but organized for adding large numbers of injections
+ * to long time series:
+ *
+ * - Injections whose start times lie on sample boundaries of the target
+ * are added directly when there is no response function.
+ * - The others are re-interpolated, and have the response function
+ * applied, individually as in XLALSimAddInjectionREAL8TimeSeries(),
+ * including its padding, clipping and tapering.  This is done in parallel
+ * when OpenMP is enabled, and each thread reuses its FFT plans from one
+ * injection to the next.
+ *
+ * The injections are not summed in the frequency domain first:  the
+ * clipping and tapering are applied to each injection after its inverse
+ * transform, so they cannot be applied to a sum, and each injection
+ * therefore costs its own pair of FFTs.
+ *
+ * The injections are re-interpolated in batches, and each batch is added
+ * to the target in the order of h.  The result is the same as calling
+ * XLALSimAddInjectionREAL8TimeSeries() for each injection in turn, and
+ * does not depend on the number of threads.
+ *
+ * Unlike XLALSimAddInjectionREAL8TimeSeries(), the injection time series
+ * are not modified.
+ *
+ * @param[in,out] target Pointer to the time series into which the strain
+ * will be added
+ *
+ * @param[in] h Array of pointers to the time series containing the
+ * detector strains
+ *
+ * @param[in] n Number of time series in h
+ *
+ * @param[in] response Pointer to the response function transforming strain
+ * to detector output units, or NULL for unit response.
+ *
+ * @retval 0 Success
+ * @retval <0 Failure
+ */
+int XLALSimAddInjectionsREAL8TimeSeries(
+	REAL8TimeSeries *target,
+	REAL8TimeSeries **h,
+	UINT4 n,
+	const COMPLEX16FrequencySeries *response
+)
+{
+	/* see XLALSimAddInjectionREAL8TimeSeries() */
+	const double noop_threshold = 1e-4;	/* samples */
+	REAL8TimeSeries *batch[INJECTION_BATCH_SIZE];
+	int failed = 0;
+	int i;
 
-		/* return to time domain */
+	/* check input */
 
-		plan = XLALCreateReverseREAL8FFTPlan(h->data->length, 0);
-		if(!plan) {
-			XLALDestroyCOMPLEX16FrequencySeries(tilde_h);
-			XLAL_ERROR(XLAL_EFUNC);
+	if(!target || (n && !h))
+		XLAL_ERROR(XLAL_EFAULT);
+	if((int) n < 0) {
+		XLALPrintError("%s(): error: too many injections\n", __func__);
+		XLAL_ERROR(XLAL_EBADLEN);
+	}
+	for(i = 0; i < (int) n; i++) {
+		if(!h[i])
+			XLAL_ERROR(XLAL_EFAULT);
+		if(h[i]->deltaT != target->deltaT || h[i]->f0 != target->f0) {
+			XLALPrintError("%s(): error: input sample rates or heterodyne frequencies do not match\n", __func__);
+			XLAL_ERROR(XLAL_EINVAL);
 		}
-		i = XLALREAL8FreqTimeFFT(h, tilde_h, plan);
-		XLALDestroyREAL8FFTPlan(plan);
-		XLALDestroyCOMPLEX16FrequencySeries(tilde_h);
-		if(i)
-			XLAL_ERROR(XLAL_EFUNC);
+	}
 
-		/* the deltaT can get "corrupted" by floating point
-		 * round-off during its trip through the frequency domain.
-		 * since this function starts by confirming that the sample
-		 * rate of the source matches that of the target time
-		 * series, we can use the target series' sample rate to
-		 * reset the source's sample rate to its original value.
-		 * but we do a check to make sure we're not masking a real
-		 * bug */
+	/* re-interpolate a batch of injections in parallel, then add them
+	 * to the target in order so that the sum does not depend on the
+	 * scheduling of the threads.  each thread keeps its own FFT plans */
+
+#pragma omp parallel
+	{
+		struct injection_plan_cache cache = {.n = 0};
+		int k0;
+
+		for(k0 = 0; k0 < (int) n; k0 += INJECTION_BATCH_SIZE) {
+			const int k1 = (int) n - k0 < INJECTION_BATCH_SIZE ? (int) n : k0 + INJECTION_BATCH_SIZE;
+			int k;
+
+#pragma omp for schedule(dynamic)
+			for(k = k0; k < k1; k++) {
+				REAL8TimeSeries *copy = NULL;
+				double start_sample_int;
+				double start_sample_frac;
+				int ok;
+
+				/* see XLALSimAddInjectionREAL8TimeSeries() */
+				start_sample_frac = modf(XLALGPSDiff(&h[k]->epoch, &target->epoch) / target->deltaT, &start_sample_int);
+				if(start_sample_frac < -0.5) {
+					start_sample_frac += 1.0;
+					start_sample_int -= 1.0;
+				} else if(start_sample_frac > +0.5) {
+					start_sample_frac -= 1.0;
+					start_sample_int += 1.0;
+				}
+
+				if(fabs(start_sample_frac) > noop_threshold || response) {
+					copy = XLALCutREAL8TimeSeries(h[k], 0, h[k]->data->length);
+					ok = copy && reinterpolate_injection(copy, target, start_sample_int, start_sample_frac, response, &cache) == 0;
+				} else
+					ok = 1;
+
+				batch[k - k0] = copy;
+				if(!ok) {
+#pragma omp atomic write
+					failed = 1;
+				}
+			}
 
-		if(fabs(h->deltaT - target->deltaT) / target->deltaT > 1e-12) {
-			XLALPrintError("%s(): error: oops, internal sample rate mismatch\n", __func__);
-			XLAL_ERROR(XLAL_EERR);
+#pragma omp single
+			for(k = k0; k < k1; k++) {
+				if(!failed && !XLALAddREAL8TimeSeries(target, batch[k - k0] ? batch[k - k0] : h[k]))
+					failed = 1;
+				XLALDestroyREAL8TimeSeries(batch[k - k0]);
+				batch[k - k0] = NULL;
+			}
 		}
-		h->deltaT = target->deltaT;
-
-		/* set source epoch from target epoch and integer sample
-		 * offset */
-
-		h->epoch = target->epoch;
-		XLALGPSAdd(&h->epoch, start_sample_int * target->deltaT);
 
-		/* clip half of the "aperiodicity padding" from the start
-		 * and end of the source time series in a continuing effort
-		 * to suppress aperiodicity artifacts. */
-
-		if(!XLALResizeREAL8TimeSeries(h, aperiodicity_suppression_buffer / 2, h->data->length - aperiodicity_suppression_buffer))
-			XLAL_ERROR(XLAL_EFUNC);
-
-		/* apply a Tukey window whose tapers lie within the
-		 * remaining aperiodicity padding. leaving one sample of
-		 * the aperiodicty padding untouched on each side of the
-		 * original time series because the data might have been
-		 * shifted into it */
-
-		window = XLALCreateTukeyREAL8Window(h->data->length, (double) (aperiodicity_suppression_buffer - 2) / h->data->length);
-		if(!window)
-			XLAL_ERROR(XLAL_EFUNC);
-		for(i = 0; i < h->data->length; i++)
-			h->data->data[i] *= window->data->data[i];
-		XLALDestroyREAL8Window(window);
+		injection_plan_cache_free(&cache);
 	}
-
-	/* add source time series to target time series */
-
-	if(!XLALAddREAL8TimeSeries(target, h))
+	if(failed)
 		XLAL_ERROR(XLAL_EFUNC);
 
-	/* done */
-
 	return 0;
 }
 
@@ -154,12 +154,28 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 	const LALDetector *detector
 );
 
+REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeriesFast(
+	const REAL8TimeSeries *hplus,
+	const REAL8TimeSeries *hcross,
+	REAL8 right_ascension,
+	REAL8 declination,
+	REAL8 psi,
+	const LALDetector *detector
+);
+
 int XLALSimAddInjectionREAL8TimeSeries(
 	REAL8TimeSeries *target,
 	REAL8TimeSeries *h,
 	const COMPLEX16FrequencySeries *response
 );
 
+int XLALSimAddInjectionsREAL8TimeSeries(
+	REAL8TimeSeries *target,
+	REAL8TimeSeries **h,
+	UINT4 n,
+	const COMPLEX16FrequencySeries *response
+);
+
 int XLALSimAddInjectionREAL4TimeSeries(
 	REAL4TimeSeries *target,
 	REAL4TimeSeries *h,
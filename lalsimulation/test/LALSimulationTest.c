@@ -3,6 +3,7 @@
 
 #include <lal/Date.h>
 #include <lal/LALDatatypes.h>
+#include <lal/LogPrintf.h>
 #include <lal/LALDetectors.h>
 #include <lal/DetResponse.h>
 #include <lal/TimeSeries.h>
@@ -140,6 +141,58 @@ static void check_result(const REAL8TimeSeries *model, const REAL8TimeSeries *re
 }
 
 
+/* time both projections of a 128 s, 4096 Hz signal into three detectors,
+ * and check that they agree to within the error budget documented for
+ * XLALSimDetectorStrainREAL8TimeSeriesFast() */
+static void benchmark(void)
+{
+	const LALDetector detectors[] = {
+		lalCachedDetectors[LAL_LHO_4K_DETECTOR],
+		lalCachedDetectors[LAL_LLO_4K_DETECTOR],
+		lalCachedDetectors[LAL_VIRGO_DETECTOR]
+	};
+	REAL8TimeSeries *hplus = new_series(1.0 / 4096, 128 * 4096, 0.0);
+	REAL8TimeSeries *hcross = copy_series(hplus);
+	double t_slow = 0., t_fast = 0.;
+	unsigned i, j;
+
+	add_circular_polarized_sine(hplus, hcross, hplus->epoch, 1.0, 100.0);
+
+	for(i = 0; i < sizeof(detectors) / sizeof(*detectors); i++) {
+		REAL8TimeSeries *slow, *fast;
+		double start, maxdiff = 0.;
+
+		start = XLALGetTimeOfDay();
+		slow = XLALSimDetectorStrainREAL8TimeSeries(hplus, hcross, 1.0, 0.5, 0.3, &detectors[i]);
+		t_slow += XLALGetTimeOfDay() - start;
+		start = XLALGetTimeOfDay();
+		fast = XLALSimDetectorStrainREAL8TimeSeriesFast(hplus, hcross, 1.0, 0.5, 0.3, &detectors[i]);
+		t_fast += XLALGetTimeOfDay() - start;
+
+		if(!slow || !fast || slow->data->length != fast->data->length || XLALGPSCmp(&slow->epoch, &fast->epoch)) {
+			fprintf(stderr, "fast and standard projections are incompatible\n");
+			exit(1);
+		}
+		for(j = 0; j < slow->data->length; j++)
+			if(fabs(slow->data->data[j] - fast->data->data[j]) > maxdiff)
+				maxdiff = fabs(slow->data->data[j] - fast->data->data[j]);
+		fprintf(stderr, "%s: max |standard - fast| = %g\n", detectors[i].frDetector.prefix, maxdiff);
+		if(maxdiff > 0.005) {
+			fprintf(stderr, "fast projection differs from standard projection by more than allowed\n");
+			exit(1);
+		}
+
+		XLALDestroyREAL8TimeSeries(slow);
+		XLALDestroyREAL8TimeSeries(fast);
+	}
+
+	fprintf(stderr, "projection of 128 s into 3 detectors: standard %.3f s, fast %.3f s\n", t_slow, t_fast);
+
+	XLALDestroyREAL8TimeSeries(hplus);
+	XLALDestroyREAL8TimeSeries(hcross);
+}
+
+
 int main(void)
 {
 	REAL8TimeSeries *hplus, *hcross, *dst, *short_dst, *mdl;
@@ -169,6 +222,14 @@ int main(void)
 
 	check_result(mdl, short_dst, 0.0012, -0.0016, 0.0016);
 
+	/* the fast projection must be at least as accurate */
+	XLALDestroyREAL8TimeSeries(dst);
+	XLALDestroyREAL8TimeSeries(short_dst);
+	dst = XLALSimDetectorStrainREAL8TimeSeriesFast(hplus, hcross, right_ascension, declination, psi, &detector);
+	short_dst = XLALCutREAL8TimeSeries(dst, start_mdl, length_mdl);
+	fprintf(stderr, "fast projection into LHO data\n");
+	check_result(mdl, short_dst, 0.0012, -0.0016, 0.0016);
+
 	XLALDestroyREAL8TimeSeries(hplus);
 	XLALDestroyREAL8TimeSeries(hcross);
 	XLALDestroyREAL8TimeSeries(dst);
@@ -196,11 +257,21 @@ int main(void)
 
 	check_result(mdl, short_dst, 0.0004, -0.0006, 0.0006);
 
+	/* the fast projection must be at least as accurate */
+	XLALDestroyREAL8TimeSeries(dst);
+	XLALDestroyREAL8TimeSeries(short_dst);
+	dst = XLALSimDetectorStrainREAL8TimeSeriesFast(hplus, hcross, right_ascension, declination, psi, &detector);
+	short_dst = XLALCutREAL8TimeSeries(dst, start_mdl, length_mdl);
+	fprintf(stderr, "fast projection into ET data\n");
+	check_result(mdl, short_dst, 0.0004, -0.0006, 0.0006);
+
 	XLALDestroyREAL8TimeSeries(hplus);
 	XLALDestroyREAL8TimeSeries(hcross);
 	XLALDestroyREAL8TimeSeries(dst);
 	XLALDestroyREAL8TimeSeries(short_dst);
 	XLALDestroyREAL8TimeSeries(mdl);
 
+	benchmark();
+
 	exit(0);
 }
@@ -0,0 +1,158 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/LALSimNeutronStar.h>
+
+/* Compare a neutron star family with the stars of the uniform grid of 100
+ * central pressures that XLALCreateSimNeutronStarFamily() used to tabulate.
+ * Each reference star is integrated directly, so the family interpolated at
+ * its mass must reproduce its radius, Love number and central pressure. */
+static int test_family_against_uniform_grid(LALSimNeutronStarEOS * eos)
+{
+    const size_t nref = 100;
+    const double logpmin = 75.5;
+    const double rtol = 1e-2, ktol = 3e-2, ptol = 3e-2;
+    double logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
+    double dlogp = (logpmax - logpmin) / nref;
+    double mref_max = 0.0, mfam_max;
+    double rerr = 0.0, kerr = 0.0, perr = 0.0;
+    double mprev = 0.0;
+    LALSimNeutronStarFamily *fam;
+    size_t i;
+
+    XLALSimNeutronStarFamilyCacheClear();
+    fam = XLALCreateSimNeutronStarFamily(eos);
+    XLAL_CHECK(fam, XLAL_EFUNC);
+    mfam_max = XLALSimNeutronStarMaximumMass(fam);
+
+    for (i = 0; i < nref; ++i) {
+        double p = exp(logpmin + i * dlogp);
+        double r, m, k;
+        XLAL_CHECK(XLALSimNeutronStarTOVODEIntegrate(&r, &m, &k, p, eos) == 0,
+            XLAL_EFUNC);
+        if (m <= mprev)
+            break; /* past the maximum mass */
+        mprev = m;
+        mref_max = m;
+        /* the family is ill-conditioned in mass close to the maximum */
+        if (m < XLALSimNeutronStarFamMinimumMass(fam) || m > 0.98 * mfam_max)
+            continue;
+        rerr = fmax(rerr, fabs(XLALSimNeutronStarRadius(m, fam) / r - 1.0));
+        kerr = fmax(kerr, fabs(XLALSimNeutronStarLoveNumberK2(m, fam) / k - 1.0));
+        perr = fmax(perr, fabs(XLALSimNeutronStarCentralPressure(m, fam) / p - 1.0));
+    }
+
+    printf("%s: maximum mass %g (uniform grid %g) Msun, relative errors radius %g, k2 %g, central pressure %g\n",
+        XLALSimNeutronStarEOSName(eos), mfam_max / LAL_MSUN_SI,
+        mref_max / LAL_MSUN_SI, rerr, kerr, perr);
+
+    XLAL_CHECK(mfam_max >= mref_max * (1.0 - 1e-6), XLAL_EFAILED,
+        "maximum mass %g below uniform grid star %g", mfam_max, mref_max);
+    XLAL_CHECK(mfam_max <= mref_max * (1.0 + 1e-2), XLAL_EFAILED,
+        "maximum mass %g too far above uniform grid star %g", mfam_max, mref_max);
+    XLAL_CHECK(rerr < rtol, XLAL_EFAILED, "radius error %g", rerr);
+    XLAL_CHECK(kerr < ktol, XLAL_EFAILED, "Love number error %g", kerr);
+    XLAL_CHECK(perr < ptol, XLAL_EFAILED, "central pressure error %g", perr);
+
+    XLALDestroySimNeutronStarFamily(fam);
+    return 0;
+}
+
+/* The family of an EOS built again from the same data comes from the cache
+ * and is identical; a different EOS does not pick up a cached family. */
+static int test_family_cache(void)
+{
+    LALSimNeutronStarEOS *eos1, *eos2, *eos3;
+    LALSimNeutronStarFamily *fam1, *fam2, *fam3;
+    void *key1, *key2, *key3;
+    size_t size1, size2, size3;
+    double m;
+
+    eos1 = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(33.384, 3.005, 2.988, 2.851);
+    eos2 = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(33.384, 3.005, 2.988, 2.851);
+    eos3 = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(33.384, 3.005, 2.988, 2.852);
+    XLAL_CHECK(eos1 && eos2 && eos3, XLAL_EFUNC);
+
+    key1 = XLALSimNeutronStarEOSKey(&size1, eos1);
+    key2 = XLALSimNeutronStarEOSKey(&size2, eos2);
+    key3 = XLALSimNeutronStarEOSKey(&size3, eos3);
+    XLAL_CHECK(key1 && key2 && key3, XLAL_EFUNC);
+    XLAL_CHECK(size1 == size2 && memcmp(key1, key2, size1) == 0, XLAL_EFAILED,
+        "same EOS data gives different keys");
+    XLAL_CHECK(size1 != size3 || memcmp(key1, key3, size1) != 0, XLAL_EFAILED,
+        "different EOS data gives the same key");
+    XLAL_CHECK(XLALSimNeutronStarEOSHash(eos1) == XLALSimNeutronStarEOSHash(eos2),
+        XLAL_EFAILED, "same EOS data gives different hashes");
+    XLALFree(key1);
+    XLALFree(key2);
+    XLALFree(key3);
+
+    XLALSimNeutronStarFamilyCacheClear();
+    fam1 = XLALCreateSimNeutronStarFamily(eos1);
+    fam2 = XLALCreateSimNeutronStarFamily(eos2);
+    fam3 = XLALCreateSimNeutronStarFamily(eos3);
+    XLAL_CHECK(fam1 && fam2 && fam3, XLAL_EFUNC);
+
+    XLAL_CHECK(XLALSimNeutronStarMaximumMass(fam1) == XLALSimNeutronStarMaximumMass(fam2),
+        XLAL_EFAILED, "cached family differs");
+    for (m = 1.0; m < 1.9; m += 0.1) {
+        XLAL_CHECK(XLALSimNeutronStarRadius(m * LAL_MSUN_SI, fam1) == XLALSimNeutronStarRadius(m * LAL_MSUN_SI, fam2),
+            XLAL_EFAILED, "cached family differs at %g Msun", m);
+        XLAL_CHECK(XLALSimNeutronStarLoveNumberK2(m * LAL_MSUN_SI, fam1) == XLALSimNeutronStarLoveNumberK2(m * LAL_MSUN_SI, fam2),
+            XLAL_EFAILED, "cached family differs at %g Msun", m);
+    }
+    XLAL_CHECK(XLALSimNeutronStarMaximumMass(fam1) != XLALSimNeutronStarMaximumMass(fam3),
+        XLAL_EFAILED, "different EOS gave the cached family");
+
+    XLALDestroySimNeutronStarFamily(fam3);
+    XLALDestroySimNeutronStarFamily(fam2);
+    XLALDestroySimNeutronStarFamily(fam1);
+    XLALDestroySimNeutronStarEOS(eos3);
+    XLALDestroySimNeutronStarEOS(eos2);
+    XLALDestroySimNeutronStarEOS(eos1);
+    XLALSimNeutronStarFamilyCacheClear();
+    return 0;
+}
+
+int main(void)
+{
+    LALSimNeutronStarEOS *eos;
+
+    /* piecewise polytrope fit to SLy */
+    eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(33.384, 3.005, 2.988, 2.851);
+    XLAL_CHECK_MAIN(eos, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_family_against_uniform_grid(eos) == 0, XLAL_EFUNC);
+    XLALDestroySimNeutronStarEOS(eos);
+
+    /* spectral decomposition, which is evaluated as a tabular EOS */
+    eos = XLALSimNeutronStarEOS4ParameterSpectralDecomposition(0.8651, 0.1548, -0.0151, -0.0002);
+    XLAL_CHECK_MAIN(eos, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_family_against_uniform_grid(eos) == 0, XLAL_EFUNC);
+    XLALDestroySimNeutronStarEOS(eos);
+
+    XLAL_CHECK_MAIN(test_family_cache() == 0, XLAL_EFUNC);
+
+    XLALSimNeutronStarFamilyCacheClear();
+    LALCheckMemoryLeaks();
+    return 0;
+}
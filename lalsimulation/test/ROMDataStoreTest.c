@@ -0,0 +1,301 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <lal/LALConfig.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALString.h>
+#include <lal/AVFactories.h>
+#include <lal/H5FileIO.h>
+
+#include "LALSimROMDataStore.h"
+
+#ifdef LAL_HDF5_ENABLED
+
+#define DATAFILE "ROMDataStoreTest.h5"
+#define CACHEDIR "ROMDataStoreTest.cache"
+#define XDGDIR "ROMDataStoreTest.xdg"
+#define HOMEDIR "ROMDataStoreTest.home"
+
+#define NROW 3
+#define NCOL 5
+
+/* value of element i of the test vector, or of element (i, j) of the test
+ * matrix; shift changes the data when the file is rewritten */
+static double value(size_t i, size_t j, double shift)
+{
+    return shift + 10.0 * i + j + 0.25;
+}
+
+/* write the test file with a vector sub/v of length n and a matrix sub/m */
+static int write_datafile(size_t n, double shift)
+{
+    LALH5File *file, *group;
+    REAL8Vector *v;
+    REAL8Array *m;
+    size_t i, j;
+
+    v = XLALCreateREAL8Vector(n);
+    m = XLALCreateREAL8ArrayL(2, NROW, NCOL);
+    XLAL_CHECK(v && m, XLAL_EFUNC);
+    for (i = 0; i < n; ++i)
+        v->data[i] = value(i, 0, shift);
+    for (i = 0; i < NROW; ++i)
+        for (j = 0; j < NCOL; ++j)
+            m->data[i * NCOL + j] = value(i, j, shift);
+
+    remove(DATAFILE);
+    file = XLALH5FileOpen(DATAFILE, "w");
+    XLAL_CHECK(file, XLAL_EFUNC);
+    group = XLALH5GroupOpen(file, "sub");
+    XLAL_CHECK(group, XLAL_EFUNC);
+    XLAL_CHECK(XLALH5FileWriteREAL8Vector(group, "v", v) == 0, XLAL_EFUNC);
+    XLAL_CHECK(XLALH5FileWriteREAL8Array(group, "m", m) == 0, XLAL_EFUNC);
+    XLALH5FileClose(group);
+    XLALH5FileClose(file);
+
+    XLALDestroyREAL8Array(m);
+    XLALDestroyREAL8Vector(v);
+    return 0;
+}
+
+/* read both datasets from a new store and compare them with the file */
+static int check_read(size_t n, double shift)
+{
+    ROMDataStore *store;
+    gsl_vector *v = NULL;
+    gsl_matrix *m = NULL;
+    size_t i, j;
+
+    store = ROMDataStore_Open(DATAFILE);
+    XLAL_CHECK(store, XLAL_EFUNC);
+    XLAL_CHECK(ROMDataStore_ReadRealVector(store, "sub", "v", &v) == 0, XLAL_EFUNC);
+    XLAL_CHECK(ROMDataStore_ReadRealMatrix(store, "sub", "m", &m) == 0, XLAL_EFUNC);
+    ROMDataStore_Close(store);
+
+    XLAL_CHECK(v->size == n, XLAL_EFAILED, "vector has length %zu, expected %zu", v->size, n);
+    for (i = 0; i < n; ++i)
+        XLAL_CHECK(gsl_vector_get(v, i) == value(i, 0, shift), XLAL_EFAILED, "vector element %zu is %g", i, gsl_vector_get(v, i));
+    XLAL_CHECK(m->size1 == NROW && m->size2 == NCOL, XLAL_EFAILED, "matrix is %zu x %zu", m->size1, m->size2);
+    for (i = 0; i < NROW; ++i)
+        for (j = 0; j < NCOL; ++j)
+            XLAL_CHECK(gsl_matrix_get(m, i, j) == value(i, j, shift), XLAL_EFAILED, "matrix element (%zu, %zu) is %g", i, j, gsl_matrix_get(m, i, j));
+
+    /* the data may be modified by the caller */
+    gsl_vector_set(v, 0, -1.0);
+    gsl_matrix_set(m, 0, 0, -1.0);
+
+    gsl_matrix_free(m);
+    gsl_vector_free(v);
+    return 0;
+}
+
+/* name of the cache file in dir whose name ends with suffix, or NULL */
+static char *find_cachefile(const char *dir, const char *suffix)
+{
+    char *fname = NULL;
+    struct dirent *ent;
+    DIR *d;
+
+    d = opendir(dir);
+    if (d == NULL)
+        return NULL;
+    while (fname == NULL && (ent = readdir(d)) != NULL) {
+        size_t len = strlen(ent->d_name);
+        if (len > strlen(suffix) && strcmp(ent->d_name + len - strlen(suffix), suffix) == 0)
+            fname = XLALStringAppendFmt(NULL, "%s/%s", dir, ent->d_name);
+    }
+    closedir(d);
+    return fname;
+}
+
+/* remove the cache files in dir and then dir itself */
+static void remove_cachedir(const char *dir)
+{
+    char *fname;
+    while ((fname = find_cachefile(dir, ".romcache")) != NULL) {
+        remove(fname);
+        XLALFree(fname);
+    }
+    remove(dir);
+}
+
+/* data are read through a cache file, which is used while it is current */
+static int test_cache(void)
+{
+    char *fname;
+    FILE *fp;
+    double x;
+    gsl_vector *v = NULL;
+    ROMDataStore *store;
+
+    setenv("LAL_ROM_CACHE_DIR", CACHEDIR, 1);
+    remove_cachedir(CACHEDIR);
+
+    /* the first read writes the cache files, the second maps them */
+    XLAL_CHECK(write_datafile(7, 0.0) == 0, XLAL_EFUNC);
+    XLAL_CHECK(check_read(7, 0.0) == 0, XLAL_EFUNC);
+    fname = find_cachefile(CACHEDIR, ".sub.m.romcache");
+    XLAL_CHECK(fname, XLAL_EFAILED, "no cache file written for sub/m");
+    XLALFree(fname);
+    fname = find_cachefile(CACHEDIR, ".sub.v.romcache");
+    XLAL_CHECK(fname, XLAL_EFAILED, "no cache file written for sub/v");
+    XLAL_CHECK(check_read(7, 0.0) == 0, XLAL_EFUNC);
+
+    /* changing the data in the cache file shows that it is read */
+    fp = fopen(fname, "r+b");
+    XLAL_CHECK(fp, XLAL_EIO, "could not open %s", fname);
+    XLAL_CHECK(fseek(fp, -(long)sizeof(x), SEEK_END) == 0, XLAL_EIO);
+    x = 1234.5;
+    XLAL_CHECK(fwrite(&x, sizeof(x), 1, fp) == 1, XLAL_EIO);
+    fclose(fp);
+    store = ROMDataStore_Open(DATAFILE);
+    XLAL_CHECK(store, XLAL_EFUNC);
+    XLAL_CHECK(ROMDataStore_ReadRealVector(store, "sub", "v", &v) == 0, XLAL_EFUNC);
+    ROMDataStore_Close(store);
+    XLAL_CHECK(gsl_vector_get(v, 6) == 1234.5, XLAL_EFAILED, "cache file was not used");
+    gsl_vector_free(v);
+    XLALFree(fname);
+
+    /* a cache file made from another version of the data file is stale */
+    XLAL_CHECK(write_datafile(9, 100.0) == 0, XLAL_EFUNC);
+    XLAL_CHECK(check_read(9, 100.0) == 0, XLAL_EFUNC);
+    XLAL_CHECK(check_read(9, 100.0) == 0, XLAL_EFUNC);
+
+    remove_cachedir(CACHEDIR);
+    return 0;
+}
+
+/* existing objects are filled in and must have the right size */
+static int test_read_into(void)
+{
+    ROMDataStore *store;
+    gsl_vector *v;
+    gsl_matrix *m;
+    int errnum;
+    int r;
+    size_t i;
+
+    store = ROMDataStore_Open(DATAFILE);
+    XLAL_CHECK(store, XLAL_EFUNC);
+
+    v = gsl_vector_alloc(9);
+    XLAL_CHECK(ROMDataStore_ReadRealVector(store, "sub", "v", &v) == 0, XLAL_EFUNC);
+    for (i = 0; i < v->size; ++i)
+        XLAL_CHECK(gsl_vector_get(v, i) == value(i, 0, 100.0), XLAL_EFAILED, "vector element %zu is %g", i, gsl_vector_get(v, i));
+    gsl_vector_free(v);
+
+    v = gsl_vector_alloc(8);
+    XLAL_TRY_SILENT(r = ROMDataStore_ReadRealVector(store, "sub", "v", &v), errnum);
+    XLAL_CHECK(r < 0 && errnum == XLAL_EINVAL, XLAL_EFAILED, "vector of the wrong size accepted");
+    gsl_vector_free(v);
+
+    m = gsl_matrix_alloc(NCOL, NROW);
+    XLAL_TRY_SILENT(r = ROMDataStore_ReadRealMatrix(store, "sub", "m", &m), errnum);
+    XLAL_CHECK(r < 0 && errnum == XLAL_EINVAL, XLAL_EFAILED, "matrix of the wrong shape accepted");
+    gsl_matrix_free(m);
+
+    /* missing datasets are errors */
+    v = NULL;
+    XLAL_TRY_SILENT(r = ROMDataStore_ReadRealVector(store, "sub", "nothing", &v), errnum);
+    XLAL_CHECK(r < 0 && v == NULL, XLAL_EFAILED, "missing dataset read");
+
+    ROMDataStore_Close(store);
+    return 0;
+}
+
+/* without a usable cache directory the data are read onto the heap */
+static int test_no_cache(void)
+{
+    int errnum;
+    ROMDataStore *store;
+
+    setenv("LAL_ROM_CACHE_DIR", "/dev/null/nowhere", 1);
+    XLAL_CHECK(check_read(9, 100.0) == 0, XLAL_EFUNC);
+
+    setenv("LAL_ROM_CACHE_DIR", "", 1);
+    XLAL_CHECK(check_read(9, 100.0) == 0, XLAL_EFUNC);
+
+    /* a missing data file cannot be opened */
+    XLAL_TRY_SILENT(store = ROMDataStore_Open("ROMDataStoreTest.missing.h5"), errnum);
+    XLAL_CHECK(store == NULL && errnum != 0, XLAL_EFAILED, "missing data file opened");
+    return 0;
+}
+
+/* by default cache files go in the user's cache directory */
+static int test_default_dir(void)
+{
+    char cwd[4096];
+    char *dir;
+    char *fname;
+
+    XLAL_CHECK(getcwd(cwd, sizeof(cwd)), XLAL_ESYS);
+    unsetenv("LAL_ROM_CACHE_DIR");
+
+    /* $XDG_CACHE_HOME/lalsimulation, created if needed */
+    dir = XLALStringAppendFmt(NULL, "%s/" XDGDIR, cwd);
+    XLAL_CHECK(dir, XLAL_EFUNC);
+    setenv("XDG_CACHE_HOME", dir, 1);
+    XLALFree(dir);
+    XLAL_CHECK(check_read(9, 100.0) == 0, XLAL_EFUNC);
+    fname = find_cachefile(XDGDIR "/lalsimulation", ".sub.v.romcache");
+    XLAL_CHECK(fname, XLAL_EFAILED, "no cache file written in $XDG_CACHE_HOME/lalsimulation");
+    XLALFree(fname);
+    remove_cachedir(XDGDIR "/lalsimulation");
+    remove(XDGDIR);
+
+    /* ~/.cache/lalsimulation, also if $XDG_CACHE_HOME is relative */
+    dir = XLALStringAppendFmt(NULL, "%s/" HOMEDIR, cwd);
+    XLAL_CHECK(dir, XLAL_EFUNC);
+    setenv("HOME", dir, 1);
+    XLALFree(dir);
+    setenv("XDG_CACHE_HOME", XDGDIR, 1);
+    XLAL_CHECK(check_read(9, 100.0) == 0, XLAL_EFUNC);
+    fname = find_cachefile(HOMEDIR "/.cache/lalsimulation", ".sub.v.romcache");
+    XLAL_CHECK(fname, XLAL_EFAILED, "no cache file written in ~/.cache/lalsimulation");
+    XLALFree(fname);
+    XLAL_CHECK(find_cachefile(XDGDIR "/lalsimulation", ".romcache") == NULL, XLAL_EFAILED, "relative $XDG_CACHE_HOME was used");
+    remove_cachedir(HOMEDIR "/.cache/lalsimulation");
+    remove(HOMEDIR "/.cache");
+    remove(HOMEDIR);
+    return 0;
+}
+
+#endif /* LAL_HDF5_ENABLED */
+
+int main(void)
+{
+#ifndef LAL_HDF5_ENABLED
+    fprintf(stderr, "HDF5 support not enabled; skipping test\n");
+    return 77;
+#else
+    XLAL_CHECK_MAIN(test_cache() == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_read_into() == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_no_cache() == 0, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_default_dir() == 0, XLAL_EFUNC);
+    remove(DATAFILE);
+    LALCheckMemoryLeaks();
+    return 0;
+#endif
+}
@@ -0,0 +1,86 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/Date.h>
+#include <lal/FrequencySeries.h>
+#include <lal/LALSimNoise.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+
+#define SRATE		1024.0		/* Hz */
+#define SEGLENGTH	1024		/* samples */
+#define LENGTH		(1024 * 256)	/* samples */
+#define PIECE		3001		/* samples */
+#define OFFSET		12345		/* samples */
+#define VARTHRESH	0.02
+
+
+/* generating a stretch of the stream in one go or in pieces must give
+ * identical results */
+static int TestSimNoiseStreamSplit(LALSimNoiseStream *stream)
+{
+	LIGOTimeGPS epoch = {0, 0};
+	REAL8TimeSeries *whole = XLALCreateREAL8TimeSeries(NULL, &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+	REAL8TimeSeries *piece = XLALCreateREAL8TimeSeries(NULL, &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, PIECE);
+	size_t i, j, ndiff = 0;
+
+	XLALSimNoiseStreamGenerate(whole, stream, OFFSET);
+	for (i = 0; i + PIECE <= LENGTH; i += PIECE) {
+		XLALSimNoiseStreamGenerate(piece, stream, OFFSET + i);
+		for (j = 0; j < PIECE; j++)
+			ndiff += piece->data->data[j] != whole->data->data[i + j];
+	}
+
+	fprintf(stderr, "%s(): %zu samples differ\n", __func__, ndiff);
+	XLALDestroyREAL8TimeSeries(piece);
+	XLALDestroyREAL8TimeSeries(whole);
+	return ndiff != 0;
+}
+
+
+/* the variance of white noise with a one-sided PSD of 1 above DC */
+static int TestSimNoiseStreamVariance(LALSimNoiseStream *stream)
+{
+	LIGOTimeGPS epoch = {0, 0};
+	REAL8TimeSeries *s = XLALCreateREAL8TimeSeries(NULL, &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+	const double deltaF = SRATE / SEGLENGTH;
+	const double expected = deltaF * (SEGLENGTH / 2 - 0.75);
+	double var = 0.0;
+	size_t j;
+
+	XLALSimNoiseStreamGenerate(s, stream, 0);
+	for (j = 0; j < s->data->length; j++)
+		var += s->data->data[j] * s->data->data[j];
+	var /= s->data->length;
+
+	fprintf(stderr, "%s(): variance = %g, expected = %g, fractional difference = %g, throughput = %g samples/s\n", __func__, var, expected, fabs(var - expected) / expected, XLALSimNoiseStreamThroughput(stream));
+	XLALDestroyREAL8TimeSeries(s);
+	return fabs(var - expected) / expected > VARTHRESH;
+}
+
+
+int main(void)
+{
+	LIGOTimeGPS epoch = {0, 0};
+	REAL8FrequencySeries *psd = XLALCreateREAL8FrequencySeries(NULL, &epoch, 0.0, SRATE / SEGLENGTH, &lalSecondUnit, SEGLENGTH / 2 + 1);
+	LALSimNoiseStream *stream;
+	size_t k;
+	int result = 0;
+
+	psd->data->data[0] = 0.0;
+	for (k = 1; k < psd->data->length; k++)
+		psd->data->data[k] = 1.0;
+
+	stream = XLALSimNoiseStreamCreate(psd, &epoch, 20200229);
+	if (!stream)
+		return 1;
+
+	result |= TestSimNoiseStreamSplit(stream);
+	result |= TestSimNoiseStreamVariance(stream);
+
+	XLALSimNoiseStreamDestroy(stream);
+	XLALDestroyREAL8FrequencySeries(psd);
+	return result;
+}
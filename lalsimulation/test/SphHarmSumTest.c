@@ -0,0 +1,302 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Tests XLALSimAddSphHarmTimeSeries() and
+ * XLALSimAddSphHarmFrequencySeries() against adding the same modes one at
+ * a time with XLALSimAddMode() and XLALSimAddModeFD().
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/Date.h>
+#include <lal/Units.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/LALSimSphHarmMode.h>
+#include <lal/LALSimInspiralWaveformFlags.h>
+
+#define LMAX		4
+#define LENGTH		2000	/* samples; not a multiple of the block size */
+#define SHORT_LENGTH	1500	/* samples of the one shorter mode */
+#define THETA		0.7
+#define PHI		2.1
+#define TOLERANCE	1e-12	/* relative to the largest output sample */
+
+static UINT8 rngstate = 20191028;
+
+/* reproducible uniform deviates in [-1, 1) */
+static REAL8 uniform(void)
+{
+	rngstate = rngstate * 6364136223846793005ULL + 1442695040888963407ULL;
+	return (rngstate >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+static void fill(COMPLEX16 *data, size_t length)
+{
+	size_t j;
+	for (j = 0; j < length; ++j)
+		data[j] = uniform() + I * uniform();
+}
+
+/* the modes to add: every (l,m) up to LMAX, one of them shorter than the
+ * output */
+static SphHarmTimeSeries *make_td_modes(void)
+{
+	LIGOTimeGPS epoch = {1000000000, 0};
+	SphHarmTimeSeries *hlms = NULL;
+	int l, m;
+	for (l = 2; l <= LMAX; ++l)
+		for (m = -l; m <= l; ++m) {
+			size_t length = (l == 3 && m == 1) ? SHORT_LENGTH : LENGTH;
+			COMPLEX16TimeSeries *h = XLALCreateCOMPLEX16TimeSeries("hlm", &epoch, 0.0, 1.0 / 4096, &lalStrainUnit, length);
+			fill(h->data->data, length);
+			hlms = XLALSphHarmTimeSeriesAddMode(hlms, h, l, m);
+			XLALDestroyCOMPLEX16TimeSeries(h);
+		}
+	return hlms;
+}
+
+static SphHarmFrequencySeries *make_fd_modes(void)
+{
+	LIGOTimeGPS epoch = {1000000000, 0};
+	SphHarmFrequencySeries *hlms = NULL;
+	int l, m;
+	for (l = 2; l <= LMAX; ++l)
+		for (m = -l; m <= l; ++m) {
+			size_t length = (l == 3 && m == 1) ? SHORT_LENGTH : LENGTH;
+			COMPLEX16FrequencySeries *h = XLALCreateCOMPLEX16FrequencySeries("hlm", &epoch, 0.0, 0.25, &lalStrainUnit, length);
+			fill(h->data->data, length);
+			hlms = XLALSphHarmFrequencySeriesAddMode(hlms, h, l, m);
+			XLALDestroyCOMPLEX16FrequencySeries(h);
+		}
+	return hlms;
+}
+
+/* a few modes, including one with m < 0 and both (3,3) and (3,-3) */
+static LALValue *make_mode_array(void)
+{
+	LALValue *ModeArray = XLALSimInspiralCreateModeArray();
+	XLALSimInspiralModeArrayActivateMode(ModeArray, 2, 2);
+	XLALSimInspiralModeArrayActivateMode(ModeArray, 2, -1);
+	XLALSimInspiralModeArrayActivateMode(ModeArray, 3, 3);
+	XLALSimInspiralModeArrayActivateMode(ModeArray, 3, -3);
+	XLALSimInspiralModeArrayActivateMode(ModeArray, 3, 1);
+	XLALSimInspiralModeArrayActivateMode(ModeArray, 4, 0);
+	return ModeArray;
+}
+
+static REAL8 max_abs_diff(const REAL8 *a, const REAL8 *b, size_t n, REAL8 *scale)
+{
+	REAL8 diff = 0.0;
+	size_t j;
+	for (j = 0; j < n; ++j) {
+		diff = fmax(diff, fabs(a[j] - b[j]));
+		*scale = fmax(*scale, fabs(b[j]));
+	}
+	return diff;
+}
+
+/* both functions add to the polarizations, so start from non-zero output */
+static int TestAddSphHarmTimeSeries(LALValue *ModeArray, int sym)
+{
+	LIGOTimeGPS epoch = {1000000000, 0};
+	SphHarmTimeSeries *hlms = make_td_modes();
+	SphHarmTimeSeries *this;
+	REAL8TimeSeries *hp = XLALCreateREAL8TimeSeries("hplus", &epoch, 0.0, 1.0 / 4096, &lalStrainUnit, LENGTH);
+	REAL8TimeSeries *hc = XLALCreateREAL8TimeSeries("hcross", &epoch, 0.0, 1.0 / 4096, &lalStrainUnit, LENGTH);
+	REAL8TimeSeries *hpref = XLALCreateREAL8TimeSeries("hplus", &epoch, 0.0, 1.0 / 4096, &lalStrainUnit, LENGTH);
+	REAL8TimeSeries *hcref = XLALCreateREAL8TimeSeries("hcross", &epoch, 0.0, 1.0 / 4096, &lalStrainUnit, LENGTH);
+	REAL8 diff, scale = 0.0;
+	size_t j;
+	int result;
+
+	for (j = 0; j < LENGTH; ++j) {
+		hp->data->data[j] = hpref->data->data[j] = uniform();
+		hc->data->data[j] = hcref->data->data[j] = uniform();
+	}
+
+	for (this = hlms; this; this = this->next)
+		if (!ModeArray || XLALSimInspiralModeArrayIsModeActive(ModeArray, this->l, this->m) == 1)
+			XLALSimAddMode(hpref, hcref, this->mode, THETA, PHI, this->l, this->m, sym);
+	result = XLALSimAddSphHarmTimeSeries(hp, hc, hlms, THETA, PHI, ModeArray, sym) != XLAL_SUCCESS;
+
+	diff = max_abs_diff(hp->data->data, hpref->data->data, LENGTH, &scale);
+	diff = fmax(diff, max_abs_diff(hc->data->data, hcref->data->data, LENGTH, &scale));
+	result |= !(diff <= TOLERANCE * scale);
+	fprintf(stderr, "%s(%s, sym=%d): largest difference %g of %g\n", __func__, ModeArray ? "ModeArray" : "NULL", sym, diff, scale);
+
+	XLALDestroyREAL8TimeSeries(hcref);
+	XLALDestroyREAL8TimeSeries(hpref);
+	XLALDestroyREAL8TimeSeries(hc);
+	XLALDestroyREAL8TimeSeries(hp);
+	XLALDestroySphHarmTimeSeries(hlms);
+	return result;
+}
+
+static int TestAddSphHarmFrequencySeries(LALValue *ModeArray, int sym)
+{
+	LIGOTimeGPS epoch = {1000000000, 0};
+	SphHarmFrequencySeries *hlms = make_fd_modes();
+	SphHarmFrequencySeries *this;
+	COMPLEX16FrequencySeries *hp = XLALCreateCOMPLEX16FrequencySeries("hptilde", &epoch, 0.0, 0.25, &lalStrainUnit, LENGTH);
+	COMPLEX16FrequencySeries *hc = XLALCreateCOMPLEX16FrequencySeries("hctilde", &epoch, 0.0, 0.25, &lalStrainUnit, LENGTH);
+	COMPLEX16FrequencySeries *hpref = XLALCreateCOMPLEX16FrequencySeries("hptilde", &epoch, 0.0, 0.25, &lalStrainUnit, LENGTH);
+	COMPLEX16FrequencySeries *hcref = XLALCreateCOMPLEX16FrequencySeries("hctilde", &epoch, 0.0, 0.25, &lalStrainUnit, LENGTH);
+	REAL8 diff, scale = 0.0;
+	int result;
+
+	fill(hp->data->data, LENGTH);
+	fill(hc->data->data, LENGTH);
+	memcpy(hpref->data->data, hp->data->data, LENGTH * sizeof(*hp->data->data));
+	memcpy(hcref->data->data, hc->data->data, LENGTH * sizeof(*hc->data->data));
+
+	for (this = hlms; this; this = this->next)
+		if (!ModeArray || XLALSimInspiralModeArrayIsModeActive(ModeArray, this->l, this->m) == 1)
+			XLALSimAddModeFD(hpref, hcref, this->mode, THETA, PHI, this->l, this->m, sym);
+	result = XLALSimAddSphHarmFrequencySeries(hp, hc, hlms, THETA, PHI, ModeArray, sym) != XLAL_SUCCESS;
+
+	diff = max_abs_diff((REAL8 *) hp->data->data, (REAL8 *) hpref->data->data, 2 * LENGTH, &scale);
+	diff = fmax(diff, max_abs_diff((REAL8 *) hc->data->data, (REAL8 *) hcref->data->data, 2 * LENGTH, &scale));
+	result |= !(diff <= TOLERANCE * scale);
+	fprintf(stderr, "%s(%s, sym=%d): largest difference %g of %g\n", __func__, ModeArray ? "ModeArray" : "NULL", sym, diff, scale);
+
+	XLALDestroyCOMPLEX16FrequencySeries(hcref);
+	XLALDestroyCOMPLEX16FrequencySeries(hpref);
+	XLALDestroyCOMPLEX16FrequencySeries(hc);
+	XLALDestroyCOMPLEX16FrequencySeries(hp);
+	XLALDestroySphHarmFrequencySeries(hlms);
+	return result;
+}
+
+/* modes are checked as by XLALSimAddMode(), and nothing is added if any
+ * of them is bad */
+static int TestAddSphHarmErrors(void)
+{
+	LIGOTimeGPS epoch = {1000000000, 0};
+	REAL8TimeSeries *hp = XLALCreateREAL8TimeSeries("hplus", &epoch, 0.0, 1.0 / 4096, &lalStrainUnit, LENGTH);
+	REAL8TimeSeries *hc = XLALCreateREAL8TimeSeries("hcross", &epoch, 0.0, 1.0 / 4096, &lalStrainUnit, LENGTH);
+	COMPLEX16FrequencySeries *hptilde = XLALCreateCOMPLEX16FrequencySeries("hptilde", &epoch, 0.0, 0.25, &lalStrainUnit, LENGTH);
+	COMPLEX16FrequencySeries *hctilde = XLALCreateCOMPLEX16FrequencySeries("hctilde", &epoch, 0.0, 0.25, &lalStrainUnit, LENGTH);
+	COMPLEX16TimeSeries *h;
+	COMPLEX16FrequencySeries *htilde;
+	SphHarmTimeSeries *hlms;
+	SphHarmFrequencySeries *hlmtildes;
+	LALValue *ModeArray = XLALSimInspiralCreateModeArray();
+	size_t j;
+	int errnum, ret, result = 0;
+
+	memset(hp->data->data, 0, LENGTH * sizeof(*hp->data->data));
+	memset(hc->data->data, 0, LENGTH * sizeof(*hc->data->data));
+	memset(hptilde->data->data, 0, LENGTH * sizeof(*hptilde->data->data));
+	memset(hctilde->data->data, 0, LENGTH * sizeof(*hctilde->data->data));
+
+	/* a missing mode is an error unless it is not selected */
+	hlms = make_td_modes();
+	hlms = XLALSphHarmTimeSeriesAddMode(hlms, NULL, 5, 5);
+	XLAL_TRY_SILENT(ret = XLALSimAddSphHarmTimeSeries(hp, hc, hlms, THETA, PHI, NULL, 1), errnum);
+	result |= !(ret == XLAL_FAILURE && errnum == XLAL_EFAULT);
+	XLALSimInspiralModeArrayActivateMode(ModeArray, 2, 2);
+	result |= XLALSimAddSphHarmTimeSeries(hp, hc, hlms, THETA, PHI, ModeArray, 1) != XLAL_SUCCESS;
+	XLALDestroySphHarmTimeSeries(hlms);
+	for (j = 0; j < LENGTH; ++j)
+		hp->data->data[j] = hc->data->data[j] = 0.0;
+
+	hlmtildes = make_fd_modes();
+	hlmtildes = XLALSphHarmFrequencySeriesAddMode(hlmtildes, NULL, 5, 5);
+	XLAL_TRY_SILENT(ret = XLALSimAddSphHarmFrequencySeries(hptilde, hctilde, hlmtildes, THETA, PHI, NULL, 1), errnum);
+	result |= !(ret == XLAL_FAILURE && errnum == XLAL_EFAULT);
+	result |= XLALSimAddSphHarmFrequencySeries(hptilde, hctilde, hlmtildes, THETA, PHI, ModeArray, 1) != XLAL_SUCCESS;
+	XLALDestroySphHarmFrequencySeries(hlmtildes);
+	for (j = 0; j < LENGTH; ++j)
+		hptilde->data->data[j] = hctilde->data->data[j] = 0.0;
+
+	/* inconsistent units and heterodyne frequency */
+	hlms = make_td_modes();
+	h = XLALCreateCOMPLEX16TimeSeries("hlm", &epoch, 0.0, 1.0 / 4096, &lalDimensionlessUnit, LENGTH);
+	fill(h->data->data, LENGTH);
+	hlms = XLALSphHarmTimeSeriesAddMode(hlms, h, 5, 5);
+	XLAL_TRY_SILENT(ret = XLALSimAddSphHarmTimeSeries(hp, hc, hlms, THETA, PHI, NULL, 1), errnum);
+	result |= !(ret == XLAL_FAILURE && errnum == XLAL_EUNIT);
+	XLALDestroyCOMPLEX16TimeSeries(h);
+	XLALDestroySphHarmTimeSeries(hlms);
+
+	hlms = make_td_modes();
+	h = XLALCreateCOMPLEX16TimeSeries("hlm", &epoch, 10.0, 1.0 / 4096, &lalStrainUnit, LENGTH);
+	fill(h->data->data, LENGTH);
+	hlms = XLALSphHarmTimeSeriesAddMode(hlms, h, 5, 5);
+	XLAL_TRY_SILENT(ret = XLALSimAddSphHarmTimeSeries(hp, hc, hlms, THETA, PHI, NULL, 1), errnum);
+	result |= !(ret == XLAL_FAILURE && errnum == XLAL_EFREQ);
+	XLALDestroyCOMPLEX16TimeSeries(h);
+	XLALDestroySphHarmTimeSeries(hlms);
+
+	/* modes longer than the output */
+	hlms = make_td_modes();
+	h = XLALCreateCOMPLEX16TimeSeries("hlm", &epoch, 0.0, 1.0 / 4096, &lalStrainUnit, LENGTH + 1);
+	fill(h->data->data, LENGTH + 1);
+	hlms = XLALSphHarmTimeSeriesAddMode(hlms, h, 5, 5);
+	XLAL_TRY_SILENT(ret = XLALSimAddSphHarmTimeSeries(hp, hc, hlms, THETA, PHI, NULL, 1), errnum);
+	result |= !(ret == XLAL_FAILURE && errnum == XLAL_EBADLEN);
+	XLALDestroyCOMPLEX16TimeSeries(h);
+	XLALDestroySphHarmTimeSeries(hlms);
+
+	hlmtildes = make_fd_modes();
+	htilde = XLALCreateCOMPLEX16FrequencySeries("hlm", &epoch, 0.0, 0.25, &lalStrainUnit, LENGTH + 1);
+	fill(htilde->data->data, LENGTH + 1);
+	hlmtildes = XLALSphHarmFrequencySeriesAddMode(hlmtildes, htilde, 5, 5);
+	XLAL_TRY_SILENT(ret = XLALSimAddSphHarmFrequencySeries(hptilde, hctilde, hlmtildes, THETA, PHI, NULL, 1), errnum);
+	result |= !(ret == XLAL_FAILURE && errnum == XLAL_EBADLEN);
+	XLALDestroyCOMPLEX16FrequencySeries(htilde);
+	XLALDestroySphHarmFrequencySeries(hlmtildes);
+
+	/* none of the failed calls added anything */
+	for (j = 0; j < LENGTH; ++j)
+		result |= hp->data->data[j] != 0.0 || hc->data->data[j] != 0.0 || hptilde->data->data[j] != 0.0 || hctilde->data->data[j] != 0.0;
+
+	fprintf(stderr, "%s(): %s\n", __func__, result ? "FAIL" : "PASS");
+	XLALDestroyValue(ModeArray);
+	XLALDestroyCOMPLEX16FrequencySeries(hctilde);
+	XLALDestroyCOMPLEX16FrequencySeries(hptilde);
+	XLALDestroyREAL8TimeSeries(hc);
+	XLALDestroyREAL8TimeSeries(hp);
+	return result;
+}
+
+
+int main(void)
+{
+	LALValue *ModeArray = make_mode_array();
+	int sym;
+	int result = 0;
+
+	for (sym = 0; sym <= 1; ++sym) {
+		result |= TestAddSphHarmTimeSeries(NULL, sym);
+		result |= TestAddSphHarmTimeSeries(ModeArray, sym);
+		result |= TestAddSphHarmFrequencySeries(NULL, sym);
+		result |= TestAddSphHarmFrequencySeries(ModeArray, sym);
+	}
+	result |= TestAddSphHarmErrors();
+
+	XLALDestroyValue(ModeArray);
+	LALCheckMemoryLeaks();
+	return result;
+}
@@ -0,0 +1,124 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Check ChooseFDWaveformSequenceBatch is consistent with ChooseFDWaveformSequence
+ */
+
+#include <math.h>
+#include <complex.h>
+#include <stdio.h>
+#include <time.h>
+#include <lal/LALSimInspiralWaveformCache.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Sequence.h>
+#include <lal/SeqFactories.h>
+#include <lal/LALConstants.h>
+#include <lal/FileIO.h>
+
+#define NPARAMS 8
+#define NFREQ 4000
+#define TOLERANCE 1e-9
+
+static int check_batch(Approximant approx, const LALSimInspiralBatchParams *params, REAL8Sequence *freqs, LALDict *LALpars)
+{
+    COMPLEX16VectorSequence *hpB = NULL, *hcB = NULL;
+    clock_t s1, e1, s2, e2;
+    REAL8 maxdiff = 0., maxamp = 0.;
+    int ret;
+
+    s1 = clock();
+    ret = XLALSimInspiralChooseFDWaveformSequenceBatch(&hpB, &hcB, params, NPARAMS, 20., LALpars, approx, freqs);
+    e1 = clock();
+    if (ret == XLAL_FAILURE)
+        return 1;
+
+    s2 = clock();
+    for (UINT4 n = 0; n < NPARAMS; n++) {
+        COMPLEX16FrequencySeries *hp = NULL, *hc = NULL;
+        ret = XLALSimInspiralChooseFDWaveformSequence(&hp, &hc, params[n].phiRef,
+            params[n].m1, params[n].m2, params[n].S1x, params[n].S1y, params[n].S1z,
+            params[n].S2x, params[n].S2y, params[n].S2z, 20., params[n].distance,
+            params[n].inclination, LALpars, approx, freqs);
+        if (ret == XLAL_FAILURE)
+            return 1;
+        for (UINT4 i = 0; i < NFREQ; i++) {
+            const COMPLEX16 *rowp = hpB->data + n * NFREQ, *rowc = hcB->data + n * NFREQ;
+            maxamp = fmax(maxamp, cabs(hp->data->data[i]));
+            maxdiff = fmax(maxdiff, cabs(hp->data->data[i] - rowp[i]));
+            maxdiff = fmax(maxdiff, cabs(hc->data->data[i] - rowc[i]));
+        }
+        XLALDestroyCOMPLEX16FrequencySeries(hp);
+        XLALDestroyCOMPLEX16FrequencySeries(hc);
+    }
+    e2 = clock();
+
+    printf("%s: batch took %f seconds, sequential took %f seconds, largest relative difference %.3g\n",
+        XLALSimInspiralGetStringFromApproximant(approx),
+        (double) (e1 - s1) / CLOCKS_PER_SEC, (double) (e2 - s2) / CLOCKS_PER_SEC, maxdiff / maxamp);
+
+    XLALDestroyCOMPLEX16VectorSequence(hpB);
+    XLALDestroyCOMPLEX16VectorSequence(hcB);
+    return maxdiff > TOLERANCE * maxamp;
+}
+
+int main(void)
+{
+    LALSimInspiralBatchParams params[NPARAMS];
+    REAL8Sequence *freqs = XLALCreateREAL8Sequence(NFREQ);
+    LALDict *LALpars = XLALCreateDict();
+    int errors = 0;
+
+    for (UINT4 i = 0; i < NFREQ; i++)
+        freqs->data[i] = 20. + 0.25 * i;
+
+    for (UINT4 n = 0; n < NPARAMS; n++) {
+        params[n].phiRef = 0.3 * n;
+        params[n].m1 = (1.4 + 2.5 * n) * LAL_MSUN_SI;
+        params[n].m2 = (1.2 + 1.5 * n) * LAL_MSUN_SI;
+        params[n].S1x = params[n].S1y = params[n].S2x = params[n].S2y = 0.;
+        params[n].S1z = 0.1 * n - 0.3;
+        params[n].S2z = 0.4 - 0.05 * n;
+        params[n].distance = (100. + 20. * n) * 1.e6 * LAL_PC_SI;
+        params[n].inclination = 0.2 * n;
+    }
+
+    errors += check_batch(TaylorF2, params, freqs, LALpars);
+    errors += check_batch(IMRPhenomD, params, freqs, LALpars);
+    errors += check_batch(IMRPhenomXAS, params, freqs, LALpars);
+    /* Needs the ROM data file in $LAL_DATA_PATH */
+    char *romfile = XLALFileResolvePath("SEOBNRv4ROM_v2.0.hdf5");
+    if (romfile)
+        errors += check_batch(SEOBNRv4_ROM, params, freqs, LALpars);
+    else
+        printf("SEOBNRv4_ROM: data file not found, skipping\n");
+    XLALFree(romfile);
+    /* Generic fallback */
+    errors += check_batch(IMRPhenomPv2, params, freqs, LALpars);
+
+    XLALDestroyDict(LALpars);
+    XLALDestroyREAL8Sequence(freqs);
+    LALCheckMemoryLeaks();
+
+    if (errors) {
+        fprintf(stderr, "Batched and single waveforms disagree\n");
+        return 1;
+    }
+    return 0;
+}
@@ -250,6 +250,57 @@ int main(void) {
     hptilde = hctilde = hptildeC = hctildeC = NULL;
 
     XLALDestroySimInspiralWaveformCache(cache);
+
+    //
+    // Test multi-entry cache alternating between two intrinsic points
+    //
+    LALSimInspiralWaveformCache *lru = XLALCreateSimInspiralWaveformCacheLRU(2, 0);
+    UINT8 hits, misses, evictions;
+    UINT4 entries;
+    REAL8 masses1[4] = {m1, 15. * LAL_MSUN_SI, m1, 15. * LAL_MSUN_SI};
+    REAL8 dists[4] = {dist1, dist1, dist2, dist2};
+    LALpars = XLALCreateDict();
+    XLALSimInspiralWaveformParamsInsertPNPhaseOrder(LALpars,phaseO);
+    XLALSimInspiralWaveformParamsInsertPNAmplitudeOrder(LALpars,ampO);
+    plusdiff = crossdiff = 0.;
+    for (int k = 0; k < 4; k++) {
+        ret = XLALSimInspiralChooseFDWaveform(&hptilde, &hctilde,
+                masses1[k], m2, s1x, s1y, s1z, s2x, s2y, s2z,
+                dists[k], inc1, phiref1, 0., 0., 0.,
+                df, f_min, f_max, f_ref, LALpars, approxFD);
+        if( ret == XLAL_FAILURE )
+            XLAL_ERROR(XLAL_EFUNC);
+        ret = XLALSimInspiralChooseFDWaveformFromCache(&hptildeC, &hctildeC,
+                phiref1, df, masses1[k], m2, s1x, s1y, s1z, s2x, s2y, s2z,
+                f_min, f_max, f_ref, dists[k], inc1, LALpars, approxFD, lru, NULL);
+        if( ret == XLAL_FAILURE )
+            XLAL_ERROR(XLAL_EFUNC);
+        for(i=0; i < hptilde->data->length; i++)
+        {
+            temp = cabs(hptilde->data->data[i] - hptildeC->data->data[i]);
+            if(temp > plusdiff) plusdiff = temp;
+            temp = cabs(hctilde->data->data[i] - hctildeC->data->data[i]);
+            if(temp > crossdiff) crossdiff = temp;
+        }
+        XLALDestroyCOMPLEX16FrequencySeries(hptilde);
+        XLALDestroyCOMPLEX16FrequencySeries(hctilde);
+        XLALDestroyCOMPLEX16FrequencySeries(hptildeC);
+        XLALDestroyCOMPLEX16FrequencySeries(hctildeC);
+        hptilde = hctilde = hptildeC = hctildeC = NULL;
+    }
+    XLALDestroyDict(LALpars);
+    XLALSimInspiralWaveformCacheGetStats(lru, &hits, &misses, &evictions, &entries, NULL);
+    printf("Comparing waveforms from ChooseFDWaveform and a two-entry cache\n");
+    printf("alternating between two sets of intrinsic parameters...\n");
+    printf("Cache hits %llu, misses %llu, evictions %llu, entries %u\n",
+            (unsigned long long) hits, (unsigned long long) misses,
+            (unsigned long long) evictions, entries);
+    printf("Largest difference in plus polarization is: %.16g\n", plusdiff);
+    printf("Largest difference in cross polarization is: %.16g\n\n", crossdiff);
+    XLALDestroySimInspiralWaveformCache(lru);
+    if (hits != 2 || misses != 2 || entries != 2)
+        return 1;
+
     LALCheckMemoryLeaks();
 
     return 0;
@@ -1,9 +1,11 @@
+#include <complex.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <lal/Date.h>
+#include <lal/FrequencySeries.h>
 #include <lal/LALSimulation.h>
 #include <lal/LALSimBurst.h>
 #include <lal/TimeSeries.h>
@@ -15,6 +17,7 @@
 #define OFFSET		86.332874431	/* seconds */
 #define REAL4THRESH	.5e-6
 #define REAL8THRESH	1e-12
+#define NINJECTIONS	80
 
 
 static int TestXLALSimAddInjectionREAL4TimeSeries(void)
@@ -98,9 +101,109 @@ static int TestXLALSimAddInjectionREAL8TimeSeries(void)
 }
 
 
+/* sine-Gaussian injection centred on its middle sample */
+static REAL8TimeSeries *sine_gaussian(double t, double f, double q)
+{
+	LIGOTimeGPS epoch = {0, 0};
+	REAL8TimeSeries *h = XLALCreateREAL8TimeSeries(NULL, &epoch, 0.0, DELTA_T, &lalDimensionlessUnit, 16384);
+	double sigma = q / (LAL_SQRT2 * LAL_PI * f);
+	unsigned i;
+
+	for(i = 0; i < h->data->length; i++) {
+		double x = (i - h->data->length / 2.0) * DELTA_T;
+		h->data->data[i] = exp(-x * x / (2 * sigma * sigma)) * sin(LAL_TWOPI * f * x);
+	}
+	XLALGPSAdd(&h->epoch, t);
+
+	return h;
+}
+
+
+static int TestXLALSimAddInjectionsREAL8TimeSeries(void)
+{
+	/* injection times.  one is on a sample boundary, one straddles the
+	 * start of the target, the rest need sub-sample re-interpolation.
+	 * they are followed by more, overlapping, injections than are
+	 * re-interpolated in one batch, so that the order in which they are
+	 * added matters */
+	const double first_times[] = {3.0, 17.25 + 0.3 * DELTA_T, 40.0 + 0.77 * DELTA_T, 63.5 - 0.4 * DELTA_T, 101.125 + 0.51 * DELTA_T, -0.4 + 0.2 * DELTA_T};
+	const unsigned nfirst = sizeof(first_times) / sizeof(*first_times);
+	double times[NINJECTIONS];
+	const unsigned n = NINJECTIONS;
+	LIGOTimeGPS epoch = {0, 0};
+	REAL8TimeSeries *h[NINJECTIONS];
+	REAL8TimeSeries *serial = XLALCreateREAL8TimeSeries(NULL, &epoch, 0.0, DELTA_T, &lalDimensionlessUnit, DSTLENGTH);
+	REAL8TimeSeries *batched = XLALCreateREAL8TimeSeries(NULL, &epoch, 0.0, DELTA_T, &lalDimensionlessUnit, DSTLENGTH);
+	COMPLEX16FrequencySeries *flat = XLALCreateCOMPLEX16FrequencySeries(NULL, &epoch, 0.0, 1.0, &lalDimensionlessUnit, 8193);
+	COMPLEX16FrequencySeries *shaped = XLALCreateCOMPLEX16FrequencySeries(NULL, &epoch, 10.0, 0.5, &lalDimensionlessUnit, 8000);
+	const COMPLEX16FrequencySeries *responses[] = {NULL, flat, shaped};
+	double maxdiff[3] = {0., 0., 0.};
+	double maxval[3] = {0., 0., 0.};
+	unsigned i, j, k;
+
+	for(i = 0; i < n; i++)
+		times[i] = i < nfirst ? first_times[i] : 1.5 + 1.3 * (i - nfirst) + 0.23 * (i % 4) * DELTA_T;
+
+	/* a flat response */
+	for(i = 0; i < flat->data->length; i++)
+		flat->data->data[i] = 2.0;
+
+	/* a response with frequency-dependent magnitude and phase, a
+	 * resonance, a delay and a notch, defined on a band that does not
+	 * cover DC or Nyquist */
+	for(i = 0; i < shaped->data->length; i++) {
+		const double f = shaped->f0 + i * shaped->deltaF;
+		shaped->data->data[i] = (1.0 + f * f / (300.0 * 300.0)) / (1.0 + I * 0.05 * (f / 150.0 - 150.0 / f)) * cexp(-I * LAL_TWOPI * f * 0.003);
+	}
+	shaped->data->data[(unsigned) ((60.0 - shaped->f0) / shaped->deltaF)] = 0.0;
+
+	for(k = 0; k < 3; k++) {
+		const COMPLEX16FrequencySeries *r = responses[k];
+
+		memset(serial->data->data, 0, serial->data->length * sizeof(*serial->data->data));
+		memset(batched->data->data, 0, batched->data->length * sizeof(*batched->data->data));
+
+		for(i = 0; i < n; i++)
+			h[i] = sine_gaussian(times[i], 100.0 + 50.0 * (i % 60), 9.0);
+		if(XLALSimAddInjectionsREAL8TimeSeries(batched, h, n, r)) {
+			fprintf(stderr, "%s(): XLALSimAddInjectionsREAL8TimeSeries() failed\n", __func__);
+			return 1;
+		}
+		/* XLALSimAddInjectionREAL8TimeSeries() modifies the
+		 * injections, so this has to come second */
+		for(i = 0; i < n; i++) {
+			XLALSimAddInjectionREAL8TimeSeries(serial, h[i], r);
+			XLALDestroyREAL8TimeSeries(h[i]);
+		}
+
+		for(j = 0; j < serial->data->length; j++) {
+			if(fabs(serial->data->data[j] - batched->data->data[j]) > maxdiff[k])
+				maxdiff[k] = fabs(serial->data->data[j] - batched->data->data[j]);
+			if(fabs(serial->data->data[j]) > maxval[k])
+				maxval[k] = fabs(serial->data->data[j]);
+		}
+	}
+
+	XLALDestroyREAL8TimeSeries(serial);
+	XLALDestroyREAL8TimeSeries(batched);
+	XLALDestroyCOMPLEX16FrequencySeries(flat);
+	XLALDestroyCOMPLEX16FrequencySeries(shaped);
+
+	fprintf(stderr, "%s(): max |serial - batched| = %g without response, %g with flat response, %g with shaped response\n", __func__, maxdiff[0], maxdiff[1], maxdiff[2]);
+	/* make sure the responses did something */
+	if(fabs(maxval[1] - maxval[0] / 2.0) > 1e-3 * maxval[0] || fabs(maxval[2] - maxval[0]) < 1e-2 * maxval[0]) {
+		fprintf(stderr, "%s(): unexpected peak amplitudes %g, %g, %g\n", __func__, maxval[0], maxval[1], maxval[2]);
+		return 1;
+	}
+	/* the injections are added in the same order as by the serial
+	 * function, so the results must be identical */
+	return maxdiff[0] != 0.0 || maxdiff[1] != 0.0 || maxdiff[2] != 0.0;
+}
+
+
 int main(int argc, char *argv[])
 {
 	(void) argc;	/* silence unused parameter warning */
 	(void) argv;	/* silence unused parameter warning */
-	return TestXLALSimAddInjectionREAL4TimeSeries() || TestXLALSimAddInjectionREAL8TimeSeries();
+	return TestXLALSimAddInjectionREAL4TimeSeries() || TestXLALSimAddInjectionREAL8TimeSeries() || TestXLALSimAddInjectionsREAL8TimeSeries();
 }